@@ -278,7 +278,6 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
     uint32      loop_cnt;
     uint32      i;
     uint32      j;
-    uint32      k;
     uint32      p;
     uint32      N_sfr;
     uint32      last_prb;
@@ -325,11 +324,7 @@ int32 LTE_fdd_dl_fg_samp_buf::work(int32                      noutput_items,
                 {
                     for(j=0; j<16; j++)
                     {
-                        for(k=0; k<LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP; k++)
-                        {
-                            subframe.tx_symb_re[p][j][k] = 0;
-                            subframe.tx_symb_im[p][j][k] = 0;
-                        }
+                        liblte_phy_clear_tx_symb(&subframe, p, j, LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
                     }
                 }
                 subframe.num = N_sfr;
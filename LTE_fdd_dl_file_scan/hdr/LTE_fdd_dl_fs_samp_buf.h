@@ -130,6 +130,8 @@ private:
     float  *q_buf;
     uint32  samp_buf_w_idx;
     uint32  samp_buf_r_idx;
+    float   samp_buf_freq_offset;
+    double  samp_buf_phase;
     bool    last_samp_was_i;
 
     // Variables
@@ -167,7 +169,7 @@ private:
     // Helpers
     void init(void);
     void copy_input_to_samp_buf(gr_vector_const_void_star &input_items, int32 ninput_items);
-    void freq_shift(uint32 start_idx, uint32 num_samps, float freq_offset);
+    void update_freq_correction(void);
     void print_mib(LIBLTE_RRC_MIB_STRUCT *mib);
     void print_sib1(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT *sib1);
     void print_sib2(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT *sib2);
@@ -60,6 +60,7 @@
 #include "LTE_fdd_dl_fs_samp_buf.h"
 #include "liblte_mac.h"
 #include "liblte_mcc_mnc_list.h"
+#include "libtools_helpers.h"
 #include <gnuradio/io_signature.h>
 
 /*******************************************************************************
@@ -124,9 +125,11 @@ LTE_fdd_dl_fs_samp_buf::LTE_fdd_dl_fs_samp_buf(size_t in_size_val)
     // Initialize the sample buffer
     i_buf           = (float *)malloc(LTE_FDD_DL_FS_SAMP_BUF_SIZE*sizeof(float));
     q_buf           = (float *)malloc(LTE_FDD_DL_FS_SAMP_BUF_SIZE*sizeof(float));
-    samp_buf_w_idx  = 0;
-    samp_buf_r_idx  = 0;
-    last_samp_was_i = false;
+    samp_buf_w_idx       = 0;
+    samp_buf_r_idx       = 0;
+    samp_buf_freq_offset = 0;
+    samp_buf_phase       = 0;
+    last_samp_was_i      = false;
 
     // Variables
     init();
@@ -233,12 +236,6 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
 
     if(process_samples)
     {
-        if(LTE_FDD_DL_FS_SAMP_BUF_STATE_COARSE_TIMING_SEARCH != state)
-        {
-            // Correct frequency error
-            freq_shift(0, LTE_FDD_DL_FS_SAMP_BUF_SIZE, timing_struct.freq_offset[corr_peak_idx]);
-        }
-
         // Get number of samples needed for each state
         switch(state)
         {
@@ -279,6 +276,9 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
                 init();
             }
 
+            // Correct frequency error
+            update_freq_correction();
+
             switch(state)
             {
             case LTE_FDD_DL_FS_SAMP_BUF_STATE_COARSE_TIMING_SEARCH:
@@ -290,9 +290,6 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
                 {
                     if(corr_peak_idx < timing_struct.n_corr_peaks)
                     {
-                        // Correct frequency error
-                        freq_shift(0, LTE_FDD_DL_FS_SAMP_BUF_SIZE, timing_struct.freq_offset[corr_peak_idx]);
-
                         // Search for PSS and fine timing
                         state            = LTE_FDD_DL_FS_SAMP_BUF_STATE_PSS_AND_FINE_TIMING_SEARCH;
                         num_samps_needed = phy_struct->N_samps_per_subfr * PSS_AND_FINE_TIMING_SEARCH_NUM_SUBFRAMES;
@@ -318,7 +315,6 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
                 {
                     if(fabs(freq_offset) > 100)
                     {
-                        freq_shift(0, LTE_FDD_DL_FS_SAMP_BUF_SIZE, freq_offset);
                         timing_struct.freq_offset[corr_peak_idx] += freq_offset;
                     }
 
@@ -602,13 +598,13 @@ int32 LTE_fdd_dl_fs_samp_buf::work(int32                      ninput_items,
         samp_buf_r_idx -= 100;
         samps_to_copy   = samp_buf_w_idx - samp_buf_r_idx;
         samp_buf_w_idx  = 0;
-        freq_shift(samp_buf_r_idx, samps_to_copy, -timing_struct.freq_offset[corr_peak_idx]);
         for(i=0; i<samps_to_copy; i++)
         {
             i_buf[samp_buf_w_idx]   = i_buf[samp_buf_r_idx];
             q_buf[samp_buf_w_idx++] = q_buf[samp_buf_r_idx++];
         }
         samp_buf_r_idx = 100;
+        update_freq_correction();
 
         if(true == copy_input)
         {
@@ -659,6 +655,7 @@ void LTE_fdd_dl_fs_samp_buf::copy_input_to_samp_buf(gr_vector_const_void_star &i
     const gr_complex *gr_complex_in = (gr_complex *)input_items[0];
     uint32            i;
     uint32            offset;
+    uint32            start_idx     = samp_buf_w_idx;
     const int8       *int8_in = (int8 *)input_items[0];
 
     if(LTE_FDD_DL_FS_IN_SIZE_INT8 == in_size)
@@ -691,24 +688,38 @@ void LTE_fdd_dl_fs_samp_buf::copy_input_to_samp_buf(gr_vector_const_void_star &i
             q_buf[samp_buf_w_idx++] = gr_complex_in[i].imag();
         }
     }
+
+    // Correct frequency error on the way in, continuing the phase of
+    // the samples already in the buffer
+    if(0 != samp_buf_freq_offset)
+    {
+        freq_shift(&i_buf[start_idx],
+                   &q_buf[start_idx],
+                   samp_buf_w_idx - start_idx,
+                   -2*M_PI*samp_buf_freq_offset/phy_struct->fs,
+                   &samp_buf_phase);
+    }
 }
 
-void LTE_fdd_dl_fs_samp_buf::freq_shift(uint32 start_idx, uint32 num_samps, float freq_offset)
+void LTE_fdd_dl_fs_samp_buf::update_freq_correction(void)
 {
-    float  f_samp_re;
-    float  f_samp_im;
-    float  tmp_i;
-    float  tmp_q;
-    uint32 i;
+    float  freq_offset = 0;
+    double phase_inc;
+    double phase;
+
+    if(LTE_FDD_DL_FS_SAMP_BUF_STATE_COARSE_TIMING_SEARCH != state)
+    {
+        freq_offset = timing_struct.freq_offset[corr_peak_idx];
+    }
 
-    for(i=start_idx; i<(start_idx+num_samps); i++)
+    // Shift the buffered samples by the change in offset, keeping the
+    // phase at the write index so that new samples continue from it
+    if(freq_offset != samp_buf_freq_offset)
     {
-        f_samp_re = cosf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
-        f_samp_im = sinf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
-        tmp_i     = i_buf[i];
-        tmp_q     = q_buf[i];
-        i_buf[i]  = tmp_i*f_samp_re + tmp_q*f_samp_im;
-        q_buf[i]  = tmp_q*f_samp_re - tmp_i*f_samp_im;
+        phase_inc = -2*M_PI*(freq_offset - samp_buf_freq_offset)/phy_struct->fs;
+        phase     = -phase_inc*samp_buf_w_idx;
+        freq_shift(i_buf, q_buf, samp_buf_w_idx, phase_inc, &phase);
+        samp_buf_freq_offset = freq_offset;
     }
 }
 
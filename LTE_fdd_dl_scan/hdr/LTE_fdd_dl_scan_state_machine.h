@@ -102,6 +102,8 @@ private:
     float  *q_buf;
     uint32  samp_buf_w_idx;
     uint32  samp_buf_r_idx;
+    float   samp_buf_freq_offset;
+    double  samp_buf_phase;
     uint32  one_subframe_num_samps;
     uint32  one_frame_num_samps;
     uint32  freq_change_wait_num_samps;
@@ -143,7 +145,7 @@ private:
     // Helpers
     void init(void);
     void copy_input_to_samp_buf(const gr_complex *in, int32 ninput_items);
-    void freq_shift(uint32 start_idx, uint32 num_samps, float freq_offset);
+    void update_freq_correction(void);
     void channel_found(bool &switch_freq, int32 &done_flag);
     void channel_not_found(bool &switch_freq, int32 &done_flag);
 };
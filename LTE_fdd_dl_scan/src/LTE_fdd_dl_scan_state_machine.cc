@@ -42,6 +42,7 @@
 #include "LTE_fdd_dl_scan_state_machine.h"
 #include "LTE_fdd_dl_scan_flowgraph.h"
 #include "liblte_mac.h"
+#include "libtools_helpers.h"
 #include <gnuradio/io_signature.h>
 
 /*******************************************************************************
@@ -176,8 +177,10 @@ LTE_fdd_dl_scan_state_machine::LTE_fdd_dl_scan_state_machine(uint32 samp_rate)
     // Initialize the sample buffer
     i_buf          = (float *)malloc(SAMP_BUF_SIZE*sizeof(float));
     q_buf          = (float *)malloc(SAMP_BUF_SIZE*sizeof(float));
-    samp_buf_w_idx = 0;
-    samp_buf_r_idx = 0;
+    samp_buf_w_idx       = 0;
+    samp_buf_r_idx       = 0;
+    samp_buf_freq_offset = 0;
+    samp_buf_phase       = 0;
 
     // Variables
     init();
@@ -250,15 +253,12 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
 
     if(process_samples)
     {
-        if(LTE_FDD_DL_SCAN_STATE_MACHINE_STATE_COARSE_TIMING_SEARCH != state)
-        {
-            // Correct frequency error
-            freq_shift(0, SAMP_BUF_SIZE, timing_struct.freq_offset[corr_peak_idx]);
-        }
-
         while(samp_buf_r_idx < (samp_buf_w_idx - N_samps_needed) &&
               samp_buf_w_idx != 0)
         {
+            // Correct frequency error
+            update_freq_correction();
+
             switch(state)
             {
             case LTE_FDD_DL_SCAN_STATE_MACHINE_STATE_COARSE_TIMING_SEARCH:
@@ -270,9 +270,6 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
                 {
                     if(corr_peak_idx < timing_struct.n_corr_peaks)
                     {
-                        // Correct frequency error
-                        freq_shift(0, SAMP_BUF_SIZE, timing_struct.freq_offset[corr_peak_idx]);
-
                         // Search for PSS and fine timing
                         state          = LTE_FDD_DL_SCAN_STATE_MACHINE_STATE_PSS_AND_FINE_TIMING_SEARCH;
                         N_samps_needed = pss_and_fine_timing_search_num_samps;
@@ -303,7 +300,6 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
                 {
                     if(fabs(freq_offset) > 100)
                     {
-                        freq_shift(0, SAMP_BUF_SIZE, freq_offset);
                         timing_struct.freq_offset[corr_peak_idx] += freq_offset;
                     }
 
@@ -671,7 +667,6 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
             samp_buf_r_idx -= 100;
             samps_to_copy   = samp_buf_w_idx - samp_buf_r_idx;
             samp_buf_w_idx  = 0;
-            freq_shift(samp_buf_r_idx, samps_to_copy, -timing_struct.freq_offset[corr_peak_idx]);
             for(i=0; i<samps_to_copy; i++)
             {
                 i_buf[samp_buf_w_idx]   = i_buf[samp_buf_r_idx];
@@ -679,6 +674,7 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
             }
             samp_buf_r_idx = 100;
         }
+        update_freq_correction();
 
         if(true == copy_input)
         {
@@ -727,30 +723,45 @@ void LTE_fdd_dl_scan_state_machine::init(void)
 void LTE_fdd_dl_scan_state_machine::copy_input_to_samp_buf(const gr_complex *in, int32 ninput_items)
 {
     uint32 i;
+    uint32 start_idx = samp_buf_w_idx;
 
     for(i=0; i<ninput_items; i++)
     {
         i_buf[samp_buf_w_idx]   = in[i].real();
         q_buf[samp_buf_w_idx++] = in[i].imag();
     }
+
+    // Correct frequency error on the way in, continuing the phase of
+    // the samples already in the buffer
+    if(0 != samp_buf_freq_offset)
+    {
+        freq_shift(&i_buf[start_idx],
+                   &q_buf[start_idx],
+                   ninput_items,
+                   -2*M_PI*samp_buf_freq_offset/phy_struct->fs,
+                   &samp_buf_phase);
+    }
 }
 
-void LTE_fdd_dl_scan_state_machine::freq_shift(uint32 start_idx, uint32 num_samps, float freq_offset)
+void LTE_fdd_dl_scan_state_machine::update_freq_correction(void)
 {
-    float  f_samp_re;
-    float  f_samp_im;
-    float  tmp_i;
-    float  tmp_q;
-    uint32 i;
+    float  freq_offset = 0;
+    double phase_inc;
+    double phase;
+
+    if(LTE_FDD_DL_SCAN_STATE_MACHINE_STATE_COARSE_TIMING_SEARCH != state)
+    {
+        freq_offset = timing_struct.freq_offset[corr_peak_idx];
+    }
 
-    for(i=start_idx; i<(start_idx+num_samps); i++)
+    // Shift the buffered samples by the change in offset, keeping the
+    // phase at the write index so that new samples continue from it
+    if(freq_offset != samp_buf_freq_offset)
     {
-        f_samp_re = cosf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
-        f_samp_im = sinf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
-        tmp_i     = i_buf[i];
-        tmp_q     = q_buf[i];
-        i_buf[i]  = tmp_i*f_samp_re + tmp_q*f_samp_im;
-        q_buf[i]  = tmp_q*f_samp_re - tmp_i*f_samp_im;
+        phase_inc = -2*M_PI*(freq_offset - samp_buf_freq_offset)/phy_struct->fs;
+        phase     = -phase_inc*samp_buf_w_idx;
+        freq_shift(i_buf, q_buf, samp_buf_w_idx, phase_inc, &phase);
+        samp_buf_freq_offset = freq_offset;
     }
 }
 
@@ -143,9 +143,10 @@ private:
     ~LTE_fdd_enb_cnfg_db();
 
     // Parameters
-    std::map<LTE_FDD_ENB_PARAM_ENUM, double> var_map_double;
-    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>  var_map_int64;
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32> var_map_uint32;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, double>      var_map_double;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>       var_map_int64;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>      var_map_uint32;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, std::string> var_map_string;
 
     // System information
     LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
@@ -0,0 +1,169 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_debug_log.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB
+                 debug log.  Callers write binary records into a ring
+                 per thread and a writer thread formats them for the
+                 debug port and the debug file.
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_DEBUG_LOG_H__
+#define __LTE_FDD_ENB_DEBUG_LOG_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_interface.h"
+#include "typedefs.h"
+#include <semaphore.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <sys/time.h>
+#include <string>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_DEBUG_LOG_RING_SIZE     262144
+#define LTE_FDD_ENB_DEBUG_LOG_MAX_RINGS     64
+#define LTE_FDD_ENB_DEBUG_LOG_MAX_ARG_SIZE  1024
+#define LTE_FDD_ENB_DEBUG_LOG_MAX_BATCH     65536
+#define LTE_FDD_ENB_DEBUG_LOG_POLL_US       1000
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_NONE = 0,
+    LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_BITS,
+    LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_BYTES,
+}LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_ENUM;
+
+// Record header, followed by the packed arguments and the payload.  The
+// format and file name are string literals, so only their pointers are kept.
+typedef struct{
+    uint32          size;
+    uint32          wrap;
+    struct timeval  time;
+    const char     *file_name;
+    const char     *fmt;
+    int32           line;
+    uint32          N_arg_bytes;
+    uint32          N_payload;
+    uint8           type;
+    uint8           level;
+    uint8           payload_type;
+}LTE_FDD_ENB_DEBUG_RECORD_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+// Single producer, single consumer ring of variable length records
+class LTE_fdd_enb_debug_ring
+{
+public:
+    LTE_fdd_enb_debug_ring(uint32 _size);
+    ~LTE_fdd_enb_debug_ring();
+
+    // Producer
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT* claim(uint32 N_bytes);
+    void publish(void);
+
+    // Consumer
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT* front(void);
+    void release(void);
+    bool is_empty(void);
+
+    // Written by the producer only
+    uint32 N_dropped;
+    bool   owner_exited;
+
+private:
+    uint8  *buf;
+    uint32  size;
+    uint32  mask;
+    uint32  next_head;
+    uint32  head __attribute__((aligned(64)));
+    uint32  tail __attribute__((aligned(64)));
+};
+
+class LTE_fdd_enb_debug_log
+{
+public:
+    LTE_fdd_enb_debug_log(LTE_fdd_enb_interface *_interface);
+    ~LTE_fdd_enb_debug_log();
+
+    // Producers
+    void log(LTE_FDD_ENB_DEBUG_TYPE_ENUM         type,
+             LTE_FDD_ENB_DEBUG_LEVEL_ENUM        level,
+             const char                         *file_name,
+             int32                               line,
+             LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_ENUM  payload_type,
+             uint8                              *payload,
+             uint32                              N_payload,
+             const char                         *fmt,
+             va_list                             args);
+
+    // Debug file
+    LTE_FDD_ENB_ERROR_ENUM set_file(std::string file_name);
+    bool is_file_open(void);
+
+    // Statistics
+    uint32 get_N_dropped(void);
+
+private:
+    // Producers
+    LTE_fdd_enb_debug_ring* get_thread_ring(void);
+    static void handle_thread_exit(void *ring);
+
+    // Writer
+    static void* writer_thread(void *inputs);
+    uint32 write_records(void);
+    void format_record(LTE_FDD_ENB_DEBUG_RECORD_STRUCT *rec, std::string &out);
+    void write_batch(std::string &batch);
+
+    // Variables
+    LTE_fdd_enb_interface  *interface;
+    LTE_fdd_enb_debug_ring *rings[LTE_FDD_ENB_DEBUG_LOG_MAX_RINGS];
+    FILE                   *file;
+    sem_t                   ring_sem;
+    sem_t                   file_sem;
+    pthread_key_t           ring_key;
+    pthread_t               thread;
+    uint32                  generation;
+    uint32                  N_rings;
+    uint32                  N_dropped_no_ring;
+    uint32                  N_dropped_reported;
+    bool                    stop;
+};
+
+#endif /* __LTE_FDD_ENB_DEBUG_LOG_H__ */
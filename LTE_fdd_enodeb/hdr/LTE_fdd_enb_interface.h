@@ -72,6 +72,22 @@
 
 #define LTE_FDD_ENB_DEFAULT_CTRL_PORT 30000
 #define LTE_FDD_ENB_DEBUG_PORT_OFFSET 1
+#ifdef OPENLTE_FFTW_WISDOM_FILE
+#define LTE_FDD_ENB_DEFAULT_FFTW_WISDOM_FILE OPENLTE_FFTW_WISDOM_FILE
+#else
+#define LTE_FDD_ENB_DEFAULT_FFTW_WISDOM_FILE "/var/lib/openlte/fftw_wisdom"
+#endif
+#define LTE_FDD_ENB_DEFAULT_DEBUG_FILE "none"
+
+// Sends a debug message, the message arguments are only evaluated
+// when the type and level are enabled
+#define LTE_FDD_ENB_DEBUG(iface, type, level, ...)                                      \
+    do{                                                                                 \
+        if((iface)->debug_enabled(type, level))                                         \
+        {                                                                               \
+            (iface)->send_debug_msg(type, level, __FILE__, __LINE__, __VA_ARGS__);      \
+        }                                                                               \
+    }while(0)
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -80,6 +96,8 @@
 class LTE_fdd_enb_pdcp;
 class LTE_fdd_enb_mme;
 class LTE_fdd_enb_gw;
+class LTE_fdd_enb_debug_log;
+class LTE_fdd_enb_pcap;
 
 /*******************************************************************************
                               TYPEDEFS
@@ -140,6 +158,7 @@ typedef enum{
     LTE_FDD_ENB_VAR_TYPE_INT64,
     LTE_FDD_ENB_VAR_TYPE_HEX,
     LTE_FDD_ENB_VAR_TYPE_UINT32,
+    LTE_FDD_ENB_VAR_TYPE_STRING,
 }LTE_FDD_ENB_VAR_TYPE_ENUM;
 
 typedef enum{
@@ -190,6 +209,12 @@ typedef enum{
     LTE_FDD_ENB_PARAM_USE_USER_FILE,
     LTE_FDD_ENB_PARAM_TX_GAIN,
     LTE_FDD_ENB_PARAM_RX_GAIN,
+    LTE_FDD_ENB_PARAM_FFTW_WISDOM_FILE,
+    LTE_FDD_ENB_PARAM_DEBUG_FILE,
+    LTE_FDD_ENB_PARAM_PCAP_FORMAT,
+    LTE_FDD_ENB_PARAM_PCAP_SNAPLEN,
+    LTE_FDD_ENB_PARAM_PCAP_ROTATE_SIZE,
+    LTE_FDD_ENB_PARAM_PCAP_ROTATE_TIME,
 
     // Radio parameters managed by LTE_fdd_enb_radio
     LTE_FDD_ENB_PARAM_AVAILABLE_RADIOS,
@@ -245,6 +270,12 @@ static const char LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ITEMS][100] = {"ban
                                                                             "use_user_file",
                                                                             "tx_gain",
                                                                             "rx_gain",
+                                                                            "fftw_wisdom_file",
+                                                                            "debug_file",
+                                                                            "pcap_format",
+                                                                            "pcap_snaplen",
+                                                                            "pcap_rotate_size",
+                                                                            "pcap_rotate_time",
                                                                             "available_radios",
                                                                             "selected_radio_name",
                                                                             "selected_radio_idx",
@@ -280,11 +311,16 @@ public:
     void send_ctrl_msg(std::string msg);
     void send_ctrl_info_msg(std::string msg, ...);
     void send_ctrl_error_msg(LTE_FDD_ENB_ERROR_ENUM error, std::string msg);
-    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, std::string file_name, int32 line, std::string msg, ...);
-    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, std::string file_name, int32 line, LIBLTE_BIT_MSG_STRUCT *lte_msg, std::string msg, ...);
-    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, std::string file_name, int32 line, LIBLTE_BYTE_MSG_STRUCT *lte_msg, std::string msg, ...);
-    void open_lte_pcap_fd(void);
-    void open_ip_pcap_fd(void);
+    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, const char *file_name, int32 line, const char *msg, ...);
+    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, const char *file_name, int32 line, LIBLTE_BIT_MSG_STRUCT *lte_msg, const char *msg, ...);
+    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, const char *file_name, int32 line, LIBLTE_BYTE_MSG_STRUCT *lte_msg, const char *msg, ...);
+    void send_debug_lines(std::string &lines);
+    bool debug_enabled(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level)
+    {
+        uint64 mask = __atomic_load_n(&debug_mask, __ATOMIC_RELAXED);
+
+        return(0 != ((mask >> type) & (mask >> (32 + level)) & 1));
+    }
     void send_lte_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_ENUM dir, uint32 rnti, uint32 current_tti, uint8 *msg, uint32 N_bits);
     void send_ip_pcap_msg(uint8 *msg, uint32 N_bytes);
     static void handle_ctrl_msg(std::string msg);
@@ -297,8 +333,6 @@ public:
     static void handle_debug_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err);
     sem_t                 ctrl_sem;
     sem_t                 debug_sem;
-    FILE                 *lte_pcap_fd;
-    FILE                 *ip_pcap_fd;
     libtools_socket_wrap *ctrl_socket;
     libtools_socket_wrap *debug_socket;
     int16                 ctrl_port;
@@ -335,6 +369,10 @@ private:
     LTE_fdd_enb_mme                               *mme;
     LTE_fdd_enb_gw                                *gw;
     sem_t                                          start_sem;
+    LTE_fdd_enb_debug_log                         *debug_log;
+    LTE_fdd_enb_pcap                              *lte_pcap;
+    LTE_fdd_enb_pcap                              *ip_pcap;
+    uint64                                         debug_mask;
     uint32                                         debug_type_mask;
     uint32                                         debug_level_mask;
     bool                                           shutdown;
@@ -345,6 +383,8 @@ private:
     LTE_FDD_ENB_ERROR_ENUM write_value(LTE_FDD_ENB_VAR_STRUCT *var, int64 value);
     LTE_FDD_ENB_ERROR_ENUM write_value(LTE_FDD_ENB_VAR_STRUCT *var, std::string value);
     LTE_FDD_ENB_ERROR_ENUM write_value(LTE_FDD_ENB_VAR_STRUCT *var, uint32 value);
+    void update_debug_mask(void);
+    void update_pcap_cnfg(void);
 
     // Inter-stack communication
     LTE_fdd_enb_msgq *phy_to_mac_comm;
@@ -175,8 +175,8 @@ private:
     std::list<LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT*>    dl_sched_queue;
     std::list<LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT*>    ul_sched_queue;
     std::list<LTE_FDD_ENB_UL_SR_SCHED_QUEUE_STRUCT*> ul_sr_sched_queue;
-    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT               sched_dl_subfr[10];
-    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT               sched_ul_subfr[10];
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT              *sched_dl_subfr[10];
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT              *sched_ul_subfr[10];
     uint8                                            sched_cur_dl_subfn;
     uint8                                            sched_cur_ul_subfn;
 
@@ -58,7 +58,7 @@
 #include "LTE_fdd_enb_user.h"
 #include "liblte_rrc.h"
 #include "liblte_phy.h"
-#include <boost/circular_buffer.hpp>
+#include <unistd.h>
 #include <string>
 
 /*******************************************************************************
@@ -67,6 +67,7 @@
 
 #define LTE_FDD_ENB_N_SIB_ALLOCS      7
 #define LTE_FDD_ENB_N_PUCCH_PER_SUBFR 12
+#define LTE_FDD_ENB_MSGQ_SIZE         128
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -201,9 +202,11 @@ typedef struct{
     uint32                   N_pucch;
     uint8                    next_prb;
 }LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT;
+// The schedules are pooled buffers owned by the PHY, so only pointers are
+// passed, the PHY returns the buffers to its pool when it is done with them
 typedef struct{
-    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT dl_sched;
-    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT ul_sched;
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched;
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched;
 }LTE_FDD_ENB_PHY_SCHEDULE_MSG_STRUCT;
 
 // PHY -> MAC Messages
@@ -375,10 +378,180 @@ typedef struct{
     LTE_FDD_ENB_MESSAGE_UNION     msg;
 }LTE_FDD_ENB_MESSAGE_STRUCT;
 
+// BLOCK waits for the receive thread to free a cell, it must not be used by
+// real time senders or on both queues of a layer pair
+typedef enum{
+    LTE_FDD_ENB_MSGQ_OVERFLOW_BLOCK = 0,
+    LTE_FDD_ENB_MSGQ_OVERFLOW_DROP_NEWEST,
+    LTE_FDD_ENB_MSGQ_OVERFLOW_N_ITEMS,
+}LTE_FDD_ENB_MSGQ_OVERFLOW_ENUM;
+static const char LTE_fdd_enb_msgq_overflow_text[LTE_FDD_ENB_MSGQ_OVERFLOW_N_ITEMS][100] = {"BLOCK",
+                                                                                            "DROP_NEWEST"};
+
+typedef struct{
+    uint32 N_sent;
+    uint32 N_dropped;
+    uint32 N_received;
+    uint32 max_depth;
+}LTE_FDD_ENB_MSGQ_STATS_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
 
+// Bounded lock free ring, any number of producers and a single consumer.
+// Producers claim a cell, fill it in place, and publish it.  The consumer
+// reads the published cells in place, one at a time or a batch with peek,
+// and releases them.  Single producer
+// rings skip the compare and swap on the head.
+template<class T> class LTE_fdd_enb_ring
+{
+public:
+    LTE_fdd_enb_ring(uint32 _size, bool _single_producer)
+    {
+        uint32 i;
+
+        size = 1;
+        while(size < _size)
+        {
+            size <<= 1;
+        }
+        mask            = size - 1;
+        cells           = new LTE_FDD_ENB_RING_CELL_STRUCT[size];
+        head            = 0;
+        tail            = 0;
+        single_producer = _single_producer;
+        for(i=0; i<size; i++)
+        {
+            cells[i].seq = i;
+        }
+    }
+    ~LTE_fdd_enb_ring()
+    {
+        delete [] cells;
+    }
+
+    // Producers
+    T* claim(uint32 *pos)
+    {
+        LTE_FDD_ENB_RING_CELL_STRUCT *cell;
+        uint32                        p = __atomic_load_n(&head, __ATOMIC_RELAXED);
+        int32                         diff;
+
+        while(1)
+        {
+            cell = &cells[p & mask];
+            diff = (int32)(__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - p);
+            if(0 == diff)
+            {
+                if(single_producer)
+                {
+                    __atomic_store_n(&head, p + 1, __ATOMIC_RELAXED);
+                    break;
+                }
+                if(__atomic_compare_exchange_n(&head, &p, p + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                {
+                    break;
+                }
+            }else if(0 > diff){
+                // Full
+                return(NULL);
+            }else{
+                p = __atomic_load_n(&head, __ATOMIC_RELAXED);
+            }
+        }
+        *pos = p;
+
+        return(&cell->data);
+    }
+    void publish(uint32 pos)
+    {
+        __atomic_store_n(&cells[pos & mask].seq, pos + 1, __ATOMIC_RELEASE);
+    }
+    bool push(const T &item)
+    {
+        T      *data;
+        uint32  pos;
+
+        data = claim(&pos);
+        if(NULL == data)
+        {
+            return(false);
+        }
+        *data = item;
+        publish(pos);
+
+        return(true);
+    }
+
+    // Consumer
+    T* front(void)
+    {
+        if(__atomic_load_n(&cells[tail & mask].seq, __ATOMIC_ACQUIRE) != (tail + 1))
+        {
+            return(NULL);
+        }
+
+        return(&cells[tail & mask].data);
+    }
+    void release(void)
+    {
+        __atomic_store_n(&cells[tail & mask].seq, tail + size, __ATOMIC_RELEASE);
+        tail++;
+    }
+    T* peek(uint32 n)
+    {
+        uint32 pos = tail + n;
+
+        if(__atomic_load_n(&cells[pos & mask].seq, __ATOMIC_ACQUIRE) != (pos + 1))
+        {
+            return(NULL);
+        }
+
+        return(&cells[pos & mask].data);
+    }
+    void release(uint32 N)
+    {
+        uint32 i;
+
+        for(i=0; i<N; i++)
+        {
+            release();
+        }
+    }
+    bool pop(T *item)
+    {
+        T *data = front();
+
+        if(NULL == data)
+        {
+            return(false);
+        }
+        *item = *data;
+        release();
+
+        return(true);
+    }
+    uint32 depth(void)
+    {
+        return(__atomic_load_n(&head, __ATOMIC_RELAXED) - tail);
+    }
+
+private:
+    typedef struct{
+        uint32 seq;
+        T      data;
+    }LTE_FDD_ENB_RING_CELL_STRUCT;
+
+    // Producer and consumer indices on separate cache lines
+    LTE_FDD_ENB_RING_CELL_STRUCT *cells;
+    uint32                        size;
+    uint32                        mask;
+    bool                          single_producer;
+    uint32                        head __attribute__((aligned(64)));
+    uint32                        tail __attribute__((aligned(64)));
+};
+
 // Message queue callback
 class LTE_fdd_enb_msgq_cb
 {
@@ -401,6 +574,9 @@ class LTE_fdd_enb_msgq
 {
 public:
     LTE_fdd_enb_msgq(std::string _msgq_name);
+    LTE_fdd_enb_msgq(std::string                    _msgq_name,
+                     LTE_FDD_ENB_MSGQ_OVERFLOW_ENUM _overflow,
+                     bool                           _single_producer);
     ~LTE_fdd_enb_msgq();
 
     // Setup
@@ -412,24 +588,36 @@ public:
               LTE_FDD_ENB_DEST_LAYER_ENUM    dest_layer,
               LTE_FDD_ENB_MESSAGE_UNION     *msg_content,
               uint32                         msg_content_size);
-    void send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM       type,
+    bool send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM       type,
               LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched,
               LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched);
     void send(LTE_FDD_ENB_MESSAGE_STRUCT &msg);
 
+    // Statistics
+    void get_stats(LTE_FDD_ENB_MSGQ_STATS_STRUCT *_stats);
+
 private:
     // Send/Receive
+    LTE_FDD_ENB_MESSAGE_STRUCT* claim(uint32 *pos);
+    void publish(uint32 pos);
+    void kill(void);
+    void wake_senders(void);
     static void* receive_thread(void *inputs);
 
     // Variables
-    LTE_fdd_enb_msgq_cb                                 callback;
-    sem_t                                               sync_sem;
-    sem_t                                               msg_sem;
-    boost::circular_buffer<LTE_FDD_ENB_MESSAGE_STRUCT> *circ_buf;
-    std::string                                         msgq_name;
-    pthread_t                                           rx_thread;
-    uint32                                              prio;
-    bool                                                rx_setup;
+    LTE_fdd_enb_msgq_cb                          callback;
+    sem_t                                        msg_sem;
+    sem_t                                        space_sem;
+    LTE_fdd_enb_ring<LTE_FDD_ENB_MESSAGE_STRUCT> *ring;
+    LTE_FDD_ENB_MSGQ_OVERFLOW_ENUM               overflow;
+    LTE_FDD_ENB_MSGQ_STATS_STRUCT                stats;
+    std::string                                  msgq_name;
+    pthread_t                                    rx_thread;
+    uint32                                       prio;
+    uint32                                       N_tx_waiting;
+    bool                                         rx_setup;
+    bool                                         rx_waiting;
+    bool                                         killed;
 };
 
 #endif /* __LTE_FDD_ENB_MSGQ_H__ */
@@ -0,0 +1,147 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_pcap.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB
+                 packet capture.  Callers fill records in a preallocated
+                 ring and a writer thread writes them to the capture
+                 file in batches.
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_PCAP_H__
+#define __LTE_FDD_ENB_PCAP_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_msgq.h"
+#include "liblte_common.h"
+#include "typedefs.h"
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <string>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_PCAP_N_RECORDS       1024
+#define LTE_FDD_ENB_PCAP_MAX_RECORD_SIZE LIBLTE_MAX_MSG_SIZE
+#define LTE_FDD_ENB_PCAP_MAX_BATCH       256
+#define LTE_FDD_ENB_PCAP_POLL_US         1000
+#define LTE_FDD_ENB_PCAP_LINK_TYPE_LTE   147
+#define LTE_FDD_ENB_PCAP_LINK_TYPE_IP    228
+#define LTE_FDD_ENB_DEFAULT_PCAP_SNAPLEN 65535
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_enb_interface;
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    LTE_FDD_ENB_PCAP_FORMAT_PCAP = 0,
+    LTE_FDD_ENB_PCAP_FORMAT_PCAPNG,
+    LTE_FDD_ENB_PCAP_FORMAT_N_ITEMS,
+}LTE_FDD_ENB_PCAP_FORMAT_ENUM;
+static const char LTE_fdd_enb_pcap_format_text[LTE_FDD_ENB_PCAP_FORMAT_N_ITEMS][20] = {"pcap",
+                                                                                       "pcapng"};
+
+typedef struct{
+    struct timeval time;
+    uint32         N_bytes;
+    uint32         N_captured;
+    uint8          msg[LTE_FDD_ENB_PCAP_MAX_RECORD_SIZE];
+}LTE_FDD_ENB_PCAP_RECORD_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_enb_pcap
+{
+public:
+    LTE_fdd_enb_pcap(LTE_fdd_enb_interface *_interface, std::string _file_name, uint32 _link_type);
+    ~LTE_fdd_enb_pcap();
+
+    // Producers
+    bool is_enabled(void)
+    {
+        return(__atomic_load_n(&enabled, __ATOMIC_RELAXED));
+    }
+    uint32 get_snaplen(void)
+    {
+        return(__atomic_load_n(&snaplen, __ATOMIC_RELAXED));
+    }
+    LTE_FDD_ENB_PCAP_RECORD_STRUCT* claim(uint32 *pos);
+    void publish(uint32 pos);
+
+    // Configuration
+    void set_cnfg(bool                         _enabled,
+                  LTE_FDD_ENB_PCAP_FORMAT_ENUM _format,
+                  uint32                       _snaplen,
+                  uint64                       _rotate_size,
+                  uint32                       _rotate_time);
+
+    // Statistics
+    uint32 get_N_dropped(void);
+
+private:
+    // Writer
+    static void* writer_thread(void *inputs);
+    uint32 write_records(void);
+    bool open_file(void);
+    void close_file(void);
+    void rotate_file(void);
+    bool write_iov(struct iovec *iov, uint32 N_iov);
+
+    // Variables
+    LTE_fdd_enb_interface                            *interface;
+    LTE_fdd_enb_ring<LTE_FDD_ENB_PCAP_RECORD_STRUCT> *ring;
+    std::string                                       file_name;
+    pthread_t                                         thread;
+    uint64                                            file_size;
+    uint64                                            rotate_size;
+    time_t                                            file_open_time;
+    uint32                                            link_type;
+    uint32                                            file_idx;
+    uint32                                            file_N_records;
+    uint32                                            rotate_time;
+    uint32                                            snaplen;
+    uint32                                            file_snaplen;
+    uint32                                            N_dropped;
+    uint32                                            N_dropped_reported;
+    uint32                                            cnfg_gen;
+    uint32                                            file_cnfg_gen;
+    int32                                             fd;
+    LTE_FDD_ENB_PCAP_FORMAT_ENUM                      format;
+    LTE_FDD_ENB_PCAP_FORMAT_ENUM                      file_format;
+    bool                                              enabled;
+    bool                                              stop;
+};
+
+#endif /* __LTE_FDD_ENB_PCAP_H__ */
@@ -58,6 +58,7 @@
 *******************************************************************************/
 
 #define LTE_FDD_ENB_CURRENT_TTI_MAX (LIBLTE_PHY_SFN_MAX*10 + 9)
+#define LTE_FDD_ENB_N_SCHED_BUFS    32
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -88,6 +89,9 @@ public:
     void update_sys_info(void);
     uint32 get_n_cce(void);
     void get_current_ttis(uint32 *dl_tti, uint32 *ul_tti);
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT* get_dl_sched_buf(void);
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT* get_ul_sched_buf(void);
+    void free_sched_bufs(LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched, LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched);
 
     // Radio interface
     void radio_interface(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf, LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf);
@@ -116,20 +120,26 @@ private:
     // Downlink
     void handle_phy_schedule(LTE_FDD_ENB_PHY_SCHEDULE_MSG_STRUCT *phy_sched);
     void process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf);
-    sem_t                              sys_info_sem;
-    sem_t                              dl_sched_sem;
-    sem_t                              ul_sched_sem;
-    LTE_FDD_ENB_SYS_INFO_STRUCT        sys_info;
-    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT dl_schedule[10];
-    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT ul_schedule[10];
-    LIBLTE_PHY_PCFICH_STRUCT           pcfich;
-    LIBLTE_PHY_PHICH_STRUCT            phich[10];
-    LIBLTE_PHY_PDCCH_STRUCT            pdcch;
-    LIBLTE_PHY_SUBFRAME_STRUCT         dl_subframe;
-    LIBLTE_BIT_MSG_STRUCT              dl_rrc_msg;
-    uint32                             dl_current_tti;
-    uint32                             last_rts_current_tti;
-    bool                               late_subfr;
+    void build_dl_templates(void);
+    sem_t                                                 sys_info_sem;
+    sem_t                                                 dl_sched_sem;
+    sem_t                                                 ul_sched_sem;
+    LTE_FDD_ENB_SYS_INFO_STRUCT                           sys_info;
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT                    dl_sched_pool[LTE_FDD_ENB_N_SCHED_BUFS];
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT                    ul_sched_pool[LTE_FDD_ENB_N_SCHED_BUFS];
+    LTE_fdd_enb_ring<LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT*> *dl_sched_free;
+    LTE_fdd_enb_ring<LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT*> *ul_sched_free;
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT                    *dl_schedule[10];
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT                    *ul_schedule[10];
+    LIBLTE_PHY_PCFICH_STRUCT                              pcfich;
+    LIBLTE_PHY_PHICH_STRUCT                               phich[10];
+    LIBLTE_PHY_PDCCH_STRUCT                               pdcch;
+    LIBLTE_PHY_SUBFRAME_STRUCT                            dl_subframe;
+    float                                                 *dl_template;
+    LIBLTE_BIT_MSG_STRUCT                                 dl_rrc_msg;
+    uint32                                                dl_current_tti;
+    uint32                                                last_rts_current_tti;
+    bool                                                  late_subfr;
 
     // Uplink
     void process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf);
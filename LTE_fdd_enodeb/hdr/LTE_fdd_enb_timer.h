@@ -54,6 +54,11 @@
                               TYPEDEFS
 *******************************************************************************/
 
+typedef enum{
+    LTE_FDD_ENB_TIMER_STATE_FREE = 0,
+    LTE_FDD_ENB_TIMER_STATE_ARMED,
+    LTE_FDD_ENB_TIMER_STATE_FIRING,
+}LTE_FDD_ENB_TIMER_STATE_ENUM;
 
 /*******************************************************************************
                               CLASS DECLARATIONS
@@ -77,25 +82,31 @@ template<class class_type, void (class_type::*Func)(uint32)>
     return (static_cast<class_type*>(o)->*Func)(id);
 }
 
+// Timer wheel node, pooled and linked into the wheel by the timer manager
 class LTE_fdd_enb_timer
 {
 public:
     // Constructor/Destructor
-    LTE_fdd_enb_timer(uint32 m_seconds, uint32 _id, LTE_fdd_enb_timer_cb _cb);
+    LTE_fdd_enb_timer();
     ~LTE_fdd_enb_timer();
 
     // External interface
-    void reset(void);
-    void increment(void);
-    bool expired(void);
-    void call_callback(void);
+    void setup(uint32 m_seconds, LTE_fdd_enb_timer_cb _cb);
 
 private:
+    friend class LTE_fdd_enb_timer_mgr;
+
     // Identity
     LTE_fdd_enb_timer_cb cb;
     uint32               id;
     uint32               expiry_m_seconds;
-    uint32               current_m_seconds;
+
+    // Timer wheel
+    LTE_fdd_enb_timer            **slot;
+    LTE_fdd_enb_timer             *prev;
+    LTE_fdd_enb_timer             *next;
+    uint32                         expiry_tick;
+    LTE_FDD_ENB_TIMER_STATE_ENUM   state;
 };
 
 #endif /* __LTE_FDD_ENB_TIMER_H__ */
@@ -43,6 +43,7 @@
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_timer.h"
 #include "LTE_fdd_enb_msgq.h"
+#include <vector>
 
 /*******************************************************************************
                               DEFINES
@@ -50,6 +51,21 @@
 
 #define LTE_FDD_ENB_INVALID_TIMER_ID 0xFFFFFFFF
 
+// Timer wheel, 5 levels of 64 slots cover 2^30 ms
+#define LTE_FDD_ENB_TIMER_WHEEL_N_LEVELS    5
+#define LTE_FDD_ENB_TIMER_WHEEL_SLOT_BITS   6
+#define LTE_FDD_ENB_TIMER_WHEEL_N_SLOTS     (1 << LTE_FDD_ENB_TIMER_WHEEL_SLOT_BITS)
+#define LTE_FDD_ENB_TIMER_WHEEL_SLOT_MASK   (LTE_FDD_ENB_TIMER_WHEEL_N_SLOTS - 1)
+
+// Timer pool, timer ids are the pool index plus a generation count in
+// the upper bits so that stale ids are not found after reuse
+#define LTE_FDD_ENB_TIMER_POOL_CHUNK_SIZE   256
+#define LTE_FDD_ENB_TIMER_ID_INDEX_BITS     20
+#define LTE_FDD_ENB_TIMER_ID_INDEX_MASK     ((1 << LTE_FDD_ENB_TIMER_ID_INDEX_BITS) - 1)
+#define LTE_FDD_ENB_TIMER_POOL_MAX_SIZE     LTE_FDD_ENB_TIMER_ID_INDEX_MASK
+
+#define LTE_FDD_ENB_TIMER_TICK_HIST_N_BINS  16
+
 /*******************************************************************************
                               FORWARD DECLARATIONS
 *******************************************************************************/
@@ -59,6 +75,13 @@
                               TYPEDEFS
 *******************************************************************************/
 
+// Tick processing time, bin 0 counts ticks under 1 us and bin N counts
+// ticks from 2^(N-1) us to 2^N us, the last bin counts everything longer
+typedef struct{
+    uint32 N_ticks;
+    uint32 max_us;
+    uint32 bins[LTE_FDD_ENB_TIMER_TICK_HIST_N_BINS];
+}LTE_FDD_ENB_TIMER_TICK_HIST_STRUCT;
 
 /*******************************************************************************
                               CLASS DECLARATIONS
@@ -79,6 +102,7 @@ public:
     LTE_FDD_ENB_ERROR_ENUM start_timer(uint32 m_seconds, LTE_fdd_enb_timer_cb cb, uint32 *timer_id);
     LTE_FDD_ENB_ERROR_ENUM stop_timer(uint32 timer_id);
     LTE_FDD_ENB_ERROR_ENUM reset_timer(uint32 timer_id);
+    void get_tick_hist(LTE_FDD_ENB_TIMER_TICK_HIST_STRUCT *hist);
 
 private:
     // Singleton
@@ -97,9 +121,21 @@ private:
     LTE_fdd_enb_msgq *msgq_from_mac;
 
     // Timer Storage
-    sem_t                                timer_sem;
-    std::map<uint32, LTE_fdd_enb_timer*> timer_map;
-    uint32                               next_timer_id;
+    LTE_fdd_enb_timer* alloc_timer(void);
+    void free_timer(LTE_fdd_enb_timer *timer);
+    LTE_fdd_enb_timer* find_timer(uint32 timer_id);
+    void insert_timer(LTE_fdd_enb_timer *timer);
+    void remove_timer(LTE_fdd_enb_timer *timer);
+    void cascade(uint32 level);
+    sem_t                              timer_sem;
+    std::vector<LTE_fdd_enb_timer*>    timer_pool;
+    LTE_fdd_enb_timer                 *free_timers;
+    LTE_fdd_enb_timer                 *wheel[LTE_FDD_ENB_TIMER_WHEEL_N_LEVELS][LTE_FDD_ENB_TIMER_WHEEL_N_SLOTS];
+    std::vector<LTE_fdd_enb_timer*>    expired_timers;
+    std::vector<uint32>                expired_ids;
+    uint32                             N_timers;
+    uint32                             current_tick;
+    LTE_FDD_ENB_TIMER_TICK_HIST_STRUCT tick_hist;
 };
 
 #endif /* __LTE_FDD_ENB_TIMER_MGR_H__ */
@@ -48,6 +48,8 @@
 
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_user.h"
+#include <boost/unordered_map.hpp>
+#include <pthread.h>
 #include <string>
 
 /*******************************************************************************
@@ -64,6 +66,23 @@
                               TYPEDEFS
 *******************************************************************************/
 
+// Identities a user is indexed by, as of its last update_user
+typedef struct{
+    LTE_fdd_enb_user                      *user;
+    std::list<LTE_fdd_enb_user*>::iterator list_iter;
+    LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT   guti;
+    uint64                                 imsi;
+    uint32                                 ip_addr;
+    uint32                                 seq;
+    uint16                                 c_rnti;
+    bool                                   imsi_set;
+    bool                                   guti_set;
+    bool                                   ip_addr_set;
+    bool                                   c_rnti_set;
+}LTE_FDD_ENB_USER_KEYS_STRUCT;
+
+// Identity to user index, allows duplicate identities
+typedef boost::unordered_multimap<uint64, LTE_FDD_ENB_USER_KEYS_STRUCT*> LTE_FDD_ENB_USER_INDEX;
 
 /*******************************************************************************
                               CLASS DECLARATIONS
@@ -92,6 +111,7 @@ public:
     LTE_FDD_ENB_ERROR_ENUM del_user(std::string imsi);
     LTE_FDD_ENB_ERROR_ENUM del_user(uint16 c_rnti);
     LTE_FDD_ENB_ERROR_ENUM del_user(LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT *guti);
+    void update_user(LTE_fdd_enb_user *user);
     std::string print_all_users(void);
 
 private:
@@ -103,17 +123,30 @@ private:
     // C-RNTI Timer
     void handle_c_rnti_timer_expiry(uint32 timer_id);
 
+    // User indexes, user_lock must be held for writing
+    void index_user(LTE_FDD_ENB_USER_KEYS_STRUCT *keys);
+    void unindex_user(LTE_FDD_ENB_USER_KEYS_STRUCT *keys);
+    void erase_index_entry(LTE_FDD_ENB_USER_INDEX *index, uint64 key, LTE_FDD_ENB_USER_KEYS_STRUCT *keys);
+    LTE_FDD_ENB_USER_KEYS_STRUCT* find_oldest(LTE_FDD_ENB_USER_INDEX *index, uint64 key);
+    void remove_user(LTE_FDD_ENB_USER_KEYS_STRUCT *keys);
+
     // User storage
-    std::list<LTE_fdd_enb_user*>        user_list;
-    std::list<LTE_fdd_enb_user*>        delayed_del_user_list;
-    std::map<uint16, LTE_fdd_enb_user*> c_rnti_map;
-    std::map<uint32, uint16>            timer_id_map_forward;
-    std::map<uint16, uint32>            timer_id_map_reverse;
-    sem_t                               user_sem;
-    sem_t                               c_rnti_sem;
-    sem_t                               timer_id_sem;
-    uint32                              next_m_tmsi;
-    uint16                              next_c_rnti;
+    std::list<LTE_fdd_enb_user*>                                          user_list;
+    std::list<LTE_fdd_enb_user*>                                          delayed_del_user_list;
+    boost::unordered_map<LTE_fdd_enb_user*, LTE_FDD_ENB_USER_KEYS_STRUCT> user_keys;
+    LTE_FDD_ENB_USER_INDEX                                                imsi_index;
+    LTE_FDD_ENB_USER_INDEX                                                c_rnti_index;
+    LTE_FDD_ENB_USER_INDEX                                                m_tmsi_index;
+    LTE_FDD_ENB_USER_INDEX                                                ip_addr_index;
+    std::map<uint16, LTE_fdd_enb_user*>                                   c_rnti_map;
+    std::map<uint32, uint16>                                              timer_id_map_forward;
+    std::map<uint16, uint32>                                              timer_id_map_reverse;
+    pthread_rwlock_t                                                      user_lock;
+    sem_t                                                                 c_rnti_sem;
+    sem_t                                                                 timer_id_sem;
+    uint32                                                                next_m_tmsi;
+    uint32                                                                next_user_seq;
+    uint16                                                                next_c_rnti;
 };
 
 #endif /* __LTE_FDD_ENB_USER_MGR_H__ */
@@ -0,0 +1,273 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+/*********************************************************************
+    Name: debug_log_test.cc
+
+    Description: checks that the debug log, which copies the printf
+                 arguments on the calling thread and formats them on
+                 the writer thread, gives the same text as vsnprintf
+                 for the conversions used by the eNodeB.  Also logs
+                 from several threads at once and checks that every
+                 message is either written, in order per thread, or
+                 counted as dropped, and reports the time per message
+                 on the calling threads.  The debug port is stubbed
+                 out.
+    compile:     make debug_log_test
+    run:         ./debug_log_test [N_threads] [N_msgs]
+
+*********************************************************************/
+
+#include "LTE_fdd_enb_debug_log.h"
+#include "LTE_fdd_enb_interface.h"
+#include "libtools_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+#define FILE_NAME   "debug_log_test.cc"
+#define LINE        7
+#define MAX_THREADS 16
+
+/*******************************************************************************
+                              STUBS
+*******************************************************************************/
+
+static std::string     lines;
+static pthread_mutex_t lines_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void LTE_fdd_enb_interface::send_debug_lines(std::string &new_lines)
+{
+    pthread_mutex_lock(&lines_mutex);
+    lines += new_lines;
+    pthread_mutex_unlock(&lines_mutex);
+}
+
+/*******************************************************************************
+                              HELPERS
+*******************************************************************************/
+
+static LTE_fdd_enb_debug_log *debug_log;
+static std::string            expected[32];
+static uint32                 N_expected = 0;
+static uint32                 N_msgs     = 100000;
+
+static void log_and_expect(const char *fmt,
+                           ...)
+{
+    va_list args;
+    char    tmp[1024];
+
+    va_start(args, fmt);
+    debug_log->log(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                   LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                   FILE_NAME,
+                   LINE,
+                   LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_NONE,
+                   NULL,
+                   0,
+                   fmt,
+                   args);
+    va_end(args);
+
+    va_start(args, fmt);
+    vsnprintf(tmp, sizeof(tmp), fmt, args);
+    va_end(args);
+    expected[N_expected++] = tmp;
+}
+
+static void log_msg(const char *fmt,
+                    ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    debug_log->log(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                   LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                   FILE_NAME,
+                   LINE,
+                   LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_NONE,
+                   NULL,
+                   0,
+                   fmt,
+                   args);
+    va_end(args);
+}
+
+static void* producer_thread(void *inputs)
+{
+    long   id = (long)inputs;
+    uint32 i;
+
+    for(i=0; i<N_msgs; i++)
+    {
+        log_msg("Thread %ld msg %u", id, i);
+    }
+
+    return(NULL);
+}
+
+// Returns the message part of a formatted line
+static std::string get_msg(std::string &line)
+{
+    std::string prefix = std::string(FILE_NAME) + " " + to_string(LINE) + " ";
+    size_t      pos    = line.find(prefix);
+
+    if(std::string::npos == pos)
+    {
+        return("");
+    }
+    return(line.substr(pos + prefix.size()));
+}
+
+static uint64 elapsed_ns(struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return((uint64)(end.tv_sec - start->tv_sec)*1000000000 + (end.tv_nsec - start->tv_nsec));
+}
+
+/*******************************************************************************
+                              MAIN
+*******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    pthread_t       threads[MAX_THREADS];
+    struct timespec start;
+    std::string     line;
+    std::string     msg;
+    size_t          pos;
+    size_t          end;
+    uint64          N_ns;
+    uint32          N_threads = 4;
+    uint32          N_errors  = 0;
+    uint32          N_written = 0;
+    uint32          N_dropped = 0;
+    uint32          i;
+    int32           last[MAX_THREADS];
+    long            id;
+    uint32          msg_idx;
+
+    if(argc > 1)
+    {
+        N_threads = atoi(argv[1]);
+    }
+    if(argc > 2)
+    {
+        N_msgs = atoi(argv[2]);
+    }
+    if(N_threads < 1 || N_threads > MAX_THREADS)
+    {
+        printf("N_threads must be between 1 and %u\n", MAX_THREADS);
+        return(1);
+    }
+
+    // Formatting, the log is flushed when it is deleted
+    debug_log = new LTE_fdd_enb_debug_log(NULL);
+    log_and_expect("No arguments");
+    log_and_expect("Percent %% sign");
+    log_and_expect("Unsigned %u %u", 0, 4294967295U);
+    log_and_expect("Signed %d %d %d", 0, -17, 2147483647);
+    log_and_expect("String %s and %s", "abc", "");
+    log_and_expect("Long long %lld %lld", -3LL, 9223372036854775807LL);
+    log_and_expect("IMSI %015llu %015llu", 1234567ULL, 310260123456789ULL);
+    log_and_expect("Hex %02X %02X %04X %04X", 0xAB, 0x5, 0x1F, 0xBEEF);
+    log_and_expect("Mixed RNTI=%u RB=%s TTI=%u (%d)", 61, "SRB1", 10239, -2);
+    log_and_expect("Width %*d|%-*.*s|%c", 6, 42, 8, 2, "hello", 'z');
+    log_and_expect("Float %5.2f %e", 3.14159, 0.00012);
+    log_and_expect("Sizes %zu %lu %hhu %hd", (size_t)99, 7UL, 300, 70000);
+    delete debug_log;
+
+    pos = 0;
+    for(i=0; i<N_expected; i++)
+    {
+        end = lines.find('\n', pos);
+        if(std::string::npos == end)
+        {
+            printf("Missing line for \"%s\"\n", expected[i].c_str());
+            N_errors++;
+            break;
+        }
+        line = lines.substr(pos, end - pos);
+        pos  = end + 1;
+        msg  = get_msg(line);
+        if(msg != expected[i])
+        {
+            printf("Mismatch: \"%s\" != \"%s\"\n", msg.c_str(), expected[i].c_str());
+            N_errors++;
+        }
+    }
+    printf("Formatting: %u cases, %u mismatches\n", N_expected, N_errors);
+
+    // Multiple producers
+    lines.clear();
+    debug_log = new LTE_fdd_enb_debug_log(NULL);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i=0; i<N_threads; i++)
+    {
+        pthread_create(&threads[i], NULL, &producer_thread, (void *)(long)i);
+    }
+    for(i=0; i<N_threads; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    N_ns = elapsed_ns(&start);
+    delete debug_log;
+
+    for(i=0; i<N_threads; i++)
+    {
+        last[i] = -1;
+    }
+    pos = 0;
+    while(std::string::npos != (end = lines.find('\n', pos)))
+    {
+        line = lines.substr(pos, end - pos);
+        pos  = end + 1;
+        msg  = get_msg(line);
+        if(2 == sscanf(msg.c_str(), "Thread %ld msg %u", &id, &msg_idx) &&
+           id < N_threads)
+        {
+            if((int32)msg_idx <= last[id])
+            {
+                printf("Thread %ld message %u out of order\n", id, msg_idx);
+                N_errors++;
+            }
+            last[id] = msg_idx;
+            N_written++;
+        }else if(std::string::npos != line.find("Dropped ")){
+            N_dropped += atoi(line.c_str() + line.find("Dropped ") + 8);
+        }
+    }
+    printf("Threads: %u written, %u dropped, %.1f ns per message\n",
+           N_written,
+           N_dropped,
+           (float)N_ns/(N_threads*N_msgs));
+    if(N_written + N_dropped != N_threads*N_msgs)
+    {
+        printf("Lost %u messages\n", N_threads*N_msgs - N_written - N_dropped);
+        N_errors++;
+    }
+
+    printf("Errors: %u\n", N_errors);
+    return(0 != N_errors);
+}
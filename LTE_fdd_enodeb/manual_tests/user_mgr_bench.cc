@@ -0,0 +1,335 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+/*********************************************************************
+    Name: user_mgr_bench.cc
+
+    Description: times the user manager lookups by IMSI, C-RNTI, GUTI,
+                 S-TMSI and IP address and a user add and delete with
+                 a large number of attached users.  Also checks that
+                 C-RNTI transfer, duplicate IMSIs (the oldest user
+                 wins) and every delete variant keep the indexes in
+                 step with the users.  The interface, timer manager,
+                 MAC, RLC and RRC are stubbed out.
+    compile:     make user_mgr_bench
+    run:         ./user_mgr_bench [N_users] [N_lookups]
+
+*********************************************************************/
+
+#include "LTE_fdd_enb_user_mgr.h"
+#include "LTE_fdd_enb_interface.h"
+#include "LTE_fdd_enb_timer_mgr.h"
+#include "LTE_fdd_enb_mac.h"
+#include "LTE_fdd_enb_rlc.h"
+#include "LTE_fdd_enb_rrc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define IMSI_BASE 310000000000000ULL
+#define IMEI_BASE 350000000000000ULL
+#define IP_BASE   0xC0A80000
+#define M_TMSI(i) (0x1000 + (i)*7)
+
+/*******************************************************************************
+                              STUBS
+*******************************************************************************/
+
+static uint32 next_timer_id = 0;
+
+// Zeroed interface storage, its debug mask enables no debug messages
+static uint64 interface_storage[(sizeof(LTE_fdd_enb_interface) + 7) / 8];
+
+LTE_fdd_enb_interface* LTE_fdd_enb_interface::get_instance(void)
+{
+    return((LTE_fdd_enb_interface *)interface_storage);
+}
+void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM  type,
+                                           LTE_FDD_ENB_DEBUG_LEVEL_ENUM level,
+                                           const char                  *file_name,
+                                           int32                        line,
+                                           const char                  *msg,
+                                           ...)
+{
+}
+LTE_fdd_enb_timer_mgr* LTE_fdd_enb_timer_mgr::get_instance(void)
+{
+    return(NULL);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::start_timer(uint32                m_seconds,
+                                                          LTE_fdd_enb_timer_cb  cb,
+                                                          uint32               *timer_id)
+{
+    *timer_id = next_timer_id++;
+    return(LTE_FDD_ENB_ERROR_NONE);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::stop_timer(uint32 timer_id)
+{
+    return(LTE_FDD_ENB_ERROR_NONE);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::reset_timer(uint32 timer_id)
+{
+    return(LTE_FDD_ENB_ERROR_NONE);
+}
+LTE_fdd_enb_mac* LTE_fdd_enb_mac::get_instance(void)
+{
+    return(NULL);
+}
+LTE_fdd_enb_rlc* LTE_fdd_enb_rlc::get_instance(void)
+{
+    return(NULL);
+}
+void LTE_fdd_enb_rlc::handle_retransmit(LIBLTE_RLC_SINGLE_AMD_PDU_STRUCT *amd,
+                                        LTE_fdd_enb_user                 *user,
+                                        LTE_fdd_enb_rb                   *rb)
+{
+}
+LTE_fdd_enb_rrc* LTE_fdd_enb_rrc::get_instance(void)
+{
+    return(NULL);
+}
+void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *msg)
+{
+}
+
+/*******************************************************************************
+                              HELPERS
+*******************************************************************************/
+
+static uint64 elapsed_ns(struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return((uint64)(end.tv_sec - start->tv_sec)*1000000000 + (end.tv_nsec - start->tv_nsec));
+}
+
+static std::string imsi_str(uint32 idx)
+{
+    char imsi[32];
+
+    snprintf(imsi, sizeof(imsi), "%015llu", IMSI_BASE + idx);
+    return(std::string(imsi));
+}
+
+static void fill_guti(uint32                                idx,
+                      LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT *guti)
+{
+    guti->m_tmsi       = M_TMSI(idx);
+    guti->mcc          = 1;
+    guti->mnc          = 2;
+    guti->mme_group_id = 3;
+    guti->mme_code     = 4;
+}
+
+/*******************************************************************************
+                              MAIN
+*******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    LTE_fdd_enb_user_mgr                 *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_user                    **users;
+    LTE_fdd_enb_user                     *user;
+    LTE_fdd_enb_user                     *dup_user;
+    LTE_FDD_ENB_USER_ID_STRUCT            id;
+    LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT  guti;
+    LIBLTE_RRC_S_TMSI_STRUCT              s_tmsi;
+    struct timespec                       start;
+    uint32                                N_users   = 10000;
+    uint32                                N_lookups = 200000;
+    uint32                                N_errors  = 0;
+    uint32                                i;
+    uint32                                idx;
+    uint16                                c_rnti_0;
+    uint16                                c_rnti_1;
+
+    if(argc > 1)
+    {
+        N_users = atoi(argv[1]);
+    }
+    if(argc > 2)
+    {
+        N_lookups = atoi(argv[2]);
+    }
+    if(N_users < 16 || N_lookups < 10)
+    {
+        printf("N_users must be at least 16 and N_lookups at least 10\n");
+        return(1);
+    }
+
+    // Attach the users
+    users = (LTE_fdd_enb_user **)malloc(N_users*sizeof(LTE_fdd_enb_user *));
+    for(i=0; i<N_users; i++)
+    {
+        user_mgr->add_user(&users[i]);
+        id.imsi = IMSI_BASE + i;
+        id.imei = IMEI_BASE + i;
+        users[i]->set_id(&id);
+        fill_guti(i, &guti);
+        users[i]->set_guti(&guti);
+        users[i]->set_ip_addr(IP_BASE + i);
+    }
+    printf("Users: %u\n", N_users);
+
+    // Lookups
+    srand(1);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i=0; i<N_lookups; i++)
+    {
+        idx = rand() % N_users;
+        if(LTE_FDD_ENB_ERROR_NONE != user_mgr->find_user((uint32)(IP_BASE + idx), &user) ||
+           user                   != users[idx])
+        {
+            N_errors++;
+        }
+    }
+    printf("IP address lookup: %8.1f ns\n", (float)elapsed_ns(&start)/N_lookups);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i=0; i<N_lookups; i++)
+    {
+        idx = rand() % N_users;
+        if(LTE_FDD_ENB_ERROR_NONE != user_mgr->find_user(users[idx]->get_c_rnti(), &user) ||
+           user                   != users[idx])
+        {
+            N_errors++;
+        }
+    }
+    printf("C-RNTI lookup:     %8.1f ns\n", (float)elapsed_ns(&start)/N_lookups);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i=0; i<N_lookups; i++)
+    {
+        idx = rand() % N_users;
+        fill_guti(idx, &guti);
+        if(LTE_FDD_ENB_ERROR_NONE != user_mgr->find_user(&guti, &user) ||
+           user                   != users[idx])
+        {
+            N_errors++;
+        }
+    }
+    printf("GUTI lookup:       %8.1f ns\n", (float)elapsed_ns(&start)/N_lookups);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i=0; i<N_lookups; i++)
+    {
+        idx           = rand() % N_users;
+        s_tmsi.m_tmsi = M_TMSI(idx);
+        s_tmsi.mmec   = 4;
+        if(LTE_FDD_ENB_ERROR_NONE != user_mgr->find_user(&s_tmsi, &user) ||
+           user                   != users[idx])
+        {
+            N_errors++;
+        }
+    }
+    printf("S-TMSI lookup:     %8.1f ns\n", (float)elapsed_ns(&start)/N_lookups);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i=0; i<N_lookups/10; i++)
+    {
+        idx = rand() % N_users;
+        if(LTE_FDD_ENB_ERROR_NONE != user_mgr->find_user(imsi_str(idx), &user) ||
+           user                   != users[idx])
+        {
+            N_errors++;
+        }
+    }
+    printf("IMSI lookup:       %8.1f ns\n", (float)elapsed_ns(&start)/(N_lookups/10));
+
+    // Unknown keys
+    if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user((uint32)1, &user))
+    {
+        N_errors++;
+    }
+    fill_guti(0, &guti);
+    guti.mme_code = 5;
+    if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(&guti, &user))
+    {
+        N_errors++;
+    }
+
+    // C-RNTI transfer, the old C-RNTI must no longer be found
+    c_rnti_0 = users[0]->get_c_rnti();
+    c_rnti_1 = users[1]->get_c_rnti();
+    user_mgr->transfer_c_rnti(users[1], users[0]);
+    if(LTE_FDD_ENB_ERROR_NONE != user_mgr->find_user(c_rnti_1, &user) ||
+       user                   != users[0] ||
+       LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(c_rnti_0, &user))
+    {
+        printf("C-RNTI transfer mismatch\n");
+        N_errors++;
+    }
+
+    // Duplicate IMSI, the oldest user is found until it is deleted
+    user_mgr->add_user(&dup_user);
+    dup_user->set_id(users[5]->get_id());
+    if(LTE_FDD_ENB_ERROR_NONE != user_mgr->find_user(imsi_str(5), &user) ||
+       user                   != users[5])
+    {
+        printf("Duplicate IMSI did not find the oldest user\n");
+        N_errors++;
+    }
+    user_mgr->del_user(users[5]);
+    if(LTE_FDD_ENB_ERROR_NONE != user_mgr->find_user(imsi_str(5), &user) ||
+       user                   != dup_user ||
+       LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user((uint32)(IP_BASE + 5), &user))
+    {
+        printf("Duplicate IMSI not found after deleting the oldest user\n");
+        N_errors++;
+    }
+
+    // Every delete variant removes the user from every index
+    fill_guti(7, &guti);
+    if(LTE_FDD_ENB_ERROR_NONE != user_mgr->del_user(&guti) ||
+       LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user((uint32)(IP_BASE + 7), &user))
+    {
+        printf("Delete by GUTI mismatch\n");
+        N_errors++;
+    }
+    if(LTE_FDD_ENB_ERROR_NONE != user_mgr->del_user(users[8]->get_c_rnti()) ||
+       LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user((uint32)(IP_BASE + 8), &user))
+    {
+        printf("Delete by C-RNTI mismatch\n");
+        N_errors++;
+    }
+    if(LTE_FDD_ENB_ERROR_NONE != user_mgr->del_user(imsi_str(9)) ||
+       LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user((uint32)(IP_BASE + 9), &user))
+    {
+        printf("Delete by IMSI mismatch\n");
+        N_errors++;
+    }
+
+    // A user prepared for deletion is no longer found by IMSI
+    users[10]->prepare_for_deletion();
+    if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(imsi_str(10), &user))
+    {
+        printf("Prepared for deletion user still found by IMSI\n");
+        N_errors++;
+    }
+
+    // Add and delete
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i=0; i<1000; i++)
+    {
+        user_mgr->add_user(&user);
+        user_mgr->del_user(user);
+    }
+    printf("Add and delete:    %8.1f ns\n", (float)elapsed_ns(&start)/1000);
+
+    printf("Errors: %u\n", N_errors);
+    free(users);
+    return(0 != N_errors);
+}
@@ -68,6 +68,7 @@
 #include "LTE_fdd_enb_pdcp.h"
 #include "LTE_fdd_enb_rrc.h"
 #include "LTE_fdd_enb_mme.h"
+#include "LTE_fdd_enb_pcap.h"
 #include "liblte_mac.h"
 #include "liblte_interface.h"
 #include "libtools_scoped_lock.h"
@@ -171,6 +172,12 @@ LTE_fdd_enb_cnfg_db::LTE_fdd_enb_cnfg_db()
     var_map_int64[LTE_FDD_ENB_PARAM_USE_USER_FILE]             = 0;
     var_map_int64[LTE_FDD_ENB_PARAM_TX_GAIN]                   = 0;
     var_map_int64[LTE_FDD_ENB_PARAM_RX_GAIN]                   = 0;
+    var_map_string[LTE_FDD_ENB_PARAM_FFTW_WISDOM_FILE]         = LTE_FDD_ENB_DEFAULT_FFTW_WISDOM_FILE;
+    var_map_string[LTE_FDD_ENB_PARAM_DEBUG_FILE]               = LTE_FDD_ENB_DEFAULT_DEBUG_FILE;
+    var_map_string[LTE_FDD_ENB_PARAM_PCAP_FORMAT]              = LTE_fdd_enb_pcap_format_text[LTE_FDD_ENB_PCAP_FORMAT_PCAP];
+    var_map_int64[LTE_FDD_ENB_PARAM_PCAP_SNAPLEN]              = LTE_FDD_ENB_DEFAULT_PCAP_SNAPLEN;
+    var_map_int64[LTE_FDD_ENB_PARAM_PCAP_ROTATE_SIZE]          = 0;
+    var_map_int64[LTE_FDD_ENB_PARAM_PCAP_ROTATE_TIME]          = 0;
     use_cnfg_file                                              = false;
 }
 LTE_fdd_enb_cnfg_db::~LTE_fdd_enb_cnfg_db()
@@ -284,13 +291,22 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM par
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM param,
                                                       std::string            value)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator  iter = var_map_uint32.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                              err  = LTE_FDD_ENB_ERROR_INVALID_PARAM;
-    uint32                                              i;
-    const char                                         *v_str = value.c_str();
+    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator       iter     = var_map_uint32.find(param);
+    std::map<LTE_FDD_ENB_PARAM_ENUM, std::string>::iterator  str_iter = var_map_string.find(param);
+    LTE_FDD_ENB_ERROR_ENUM                                   err      = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    uint32                                                   i;
+    const char                                              *v_str    = value.c_str();
 
-    if(var_map_uint32.end() != iter)
+    if(var_map_string.end() != str_iter)
     {
+        (*str_iter).second = value;
+        err                = LTE_FDD_ENB_ERROR_NONE;
+
+        if(use_cnfg_file)
+        {
+            write_cnfg_file();
+        }
+    }else if(var_map_uint32.end() != iter){
         (*iter).second = 0xFFFFFFFF;
         for(i=0; i<value.length(); i++)
         {
@@ -366,13 +382,17 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::get_param(LTE_FDD_ENB_PARAM_ENUM  pa
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::get_param(LTE_FDD_ENB_PARAM_ENUM  param,
                                                       std::string            &value)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator iter = var_map_uint32.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                             err  = LTE_FDD_ENB_ERROR_INVALID_PARAM;
-    uint32                                             i;
-    uint32                                             hex_val;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator      iter     = var_map_uint32.find(param);
+    std::map<LTE_FDD_ENB_PARAM_ENUM, std::string>::iterator str_iter = var_map_string.find(param);
+    LTE_FDD_ENB_ERROR_ENUM                                  err      = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    uint32                                                  i;
+    uint32                                                  hex_val;
 
-    if(var_map_uint32.end() != iter)
+    if(var_map_string.end() != str_iter)
     {
+        value = (*str_iter).second;
+        err   = LTE_FDD_ENB_ERROR_NONE;
+    }else if(var_map_uint32.end() != iter){
         try
         {
             if(LTE_FDD_ENB_PARAM_IP_ADDR_START == param ||
@@ -979,11 +999,12 @@ void LTE_fdd_enb_cnfg_db::read_cnfg_file(void)
 }
 void LTE_fdd_enb_cnfg_db::write_cnfg_file(void)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, double>::iterator  iter_d;
-    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator   iter_i64;
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator  iter_u32;
-    FILE                                               *cnfg_file = NULL;
-    uint32                                              i;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, double>::iterator       iter_d;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator        iter_i64;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator       iter_u32;
+    std::map<LTE_FDD_ENB_PARAM_ENUM, std::string>::iterator  iter_str;
+    FILE                                                    *cnfg_file = NULL;
+    uint32                                                   i;
 
     cnfg_file = fopen("/tmp/LTE_fdd_enodeb.cnfg_db", "w");
 
@@ -1076,6 +1097,18 @@ void LTE_fdd_enb_cnfg_db::write_cnfg_file(void)
         fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TX_GAIN], (*iter_i64).second);
         iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_RX_GAIN);
         fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RX_GAIN], (*iter_i64).second);
+        iter_str = var_map_string.find(LTE_FDD_ENB_PARAM_FFTW_WISDOM_FILE);
+        fprintf(cnfg_file, "%s %s\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_FFTW_WISDOM_FILE], (*iter_str).second.c_str());
+        iter_str = var_map_string.find(LTE_FDD_ENB_PARAM_DEBUG_FILE);
+        fprintf(cnfg_file, "%s %s\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_FILE], (*iter_str).second.c_str());
+        iter_str = var_map_string.find(LTE_FDD_ENB_PARAM_PCAP_FORMAT);
+        fprintf(cnfg_file, "%s %s\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_FORMAT], (*iter_str).second.c_str());
+        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_PCAP_SNAPLEN);
+        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_SNAPLEN], (*iter_i64).second);
+        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_PCAP_ROTATE_SIZE);
+        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_ROTATE_SIZE], (*iter_i64).second);
+        iter_i64 = var_map_int64.find(LTE_FDD_ENB_PARAM_PCAP_ROTATE_TIME);
+        fprintf(cnfg_file, "%s %lld\n", LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_ROTATE_TIME], (*iter_i64).second);
 
         fclose(cnfg_file);
     }
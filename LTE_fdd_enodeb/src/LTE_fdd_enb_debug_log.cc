@@ -0,0 +1,864 @@
+#line 2 "LTE_fdd_enb_debug_log.cc" // Make __FILE__ omit the path
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_debug_log.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 debug log.
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_debug_log.h"
+#include "libtools_scoped_lock.h"
+#include "libtools_helpers.h"
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_DEBUG_LOG_MAX_SPEC_SIZE 32
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+// Argument classes of a printf conversion, as read by va_arg
+typedef enum{
+    LTE_FDD_ENB_DEBUG_LOG_ARG_NONE = 0,
+    LTE_FDD_ENB_DEBUG_LOG_ARG_INT,
+    LTE_FDD_ENB_DEBUG_LOG_ARG_LONG,
+    LTE_FDD_ENB_DEBUG_LOG_ARG_LONG_LONG,
+    LTE_FDD_ENB_DEBUG_LOG_ARG_SIZE,
+    LTE_FDD_ENB_DEBUG_LOG_ARG_DOUBLE,
+    LTE_FDD_ENB_DEBUG_LOG_ARG_POINTER,
+    LTE_FDD_ENB_DEBUG_LOG_ARG_STRING,
+    LTE_FDD_ENB_DEBUG_LOG_ARG_INVALID,
+}LTE_FDD_ENB_DEBUG_LOG_ARG_ENUM;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+static uint32                           debug_log_generation = 0;
+static __thread uint32                  thread_generation    = 0;
+static __thread LTE_fdd_enb_debug_ring *thread_ring          = NULL;
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: parse_conversion
+
+    Description: Parses the printf conversion starting at the % of
+                 fmt, returning its length, its argument class and
+                 the number of * widths and precisions before it.
+*********************************************************************/
+static uint32 parse_conversion(const char                     *fmt,
+                               LTE_FDD_ENB_DEBUG_LOG_ARG_ENUM *arg,
+                               uint32                         *N_star)
+{
+    uint32 i      = 1;
+    uint32 length = 0;
+    bool   is_l   = false;
+
+    *N_star = 0;
+    if('%' == fmt[1])
+    {
+        *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_NONE;
+        return(2);
+    }
+
+    // Flags, width and precision
+    while('\0' != fmt[i] && NULL != strchr("-+ #0'", fmt[i]))
+    {
+        i++;
+    }
+    if('*' == fmt[i])
+    {
+        (*N_star)++;
+        i++;
+    }
+    while(fmt[i] >= '0' && fmt[i] <= '9')
+    {
+        i++;
+    }
+    if('.' == fmt[i])
+    {
+        i++;
+        if('*' == fmt[i])
+        {
+            (*N_star)++;
+            i++;
+        }
+        while(fmt[i] >= '0' && fmt[i] <= '9')
+        {
+            i++;
+        }
+    }
+
+    // Length
+    *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_INT;
+    while(NULL != strchr("hlqjztL", fmt[i]) && '\0' != fmt[i])
+    {
+        switch(fmt[i])
+        {
+        case 'l':
+            if(is_l)
+            {
+                *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_LONG_LONG;
+            }else{
+                *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_LONG;
+            }
+            is_l = true;
+            break;
+        case 'q':
+        case 'j':
+            *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_LONG_LONG;
+            break;
+        case 'z':
+        case 't':
+            *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_SIZE;
+            break;
+        case 'L':
+            *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_INVALID;
+            break;
+        default:
+            break;
+        }
+        i++;
+        length++;
+    }
+
+    // Conversion
+    switch(fmt[i])
+    {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+    case 'c':
+        break;
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        if(0 == length)
+        {
+            *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_DOUBLE;
+        }else{
+            *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_INVALID;
+        }
+        break;
+    case 's':
+        if(0 == length)
+        {
+            *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_STRING;
+        }else{
+            *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_INVALID;
+        }
+        break;
+    case 'p':
+        *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_POINTER;
+        break;
+    default:
+        *arg = LTE_FDD_ENB_DEBUG_LOG_ARG_INVALID;
+        return(i);
+    }
+
+    return(i + 1);
+}
+
+/*********************************************************************
+    Name: pack_args
+
+    Description: Copies the arguments of fmt into buf, strings by
+                 value.  Stops at the first unsupported conversion or
+                 when buf is full, format_args stops at the same
+                 place.
+*********************************************************************/
+static uint32 pack_args(const char *fmt,
+                        va_list     args,
+                        uint8      *buf)
+{
+    LTE_FDD_ENB_DEBUG_LOG_ARG_ENUM  arg;
+    const char                     *str;
+    uint64                          u64;
+    double                          d;
+    uint32                          N_star;
+    uint32                          N_bytes = 0;
+    uint32                          len;
+    uint32                          i;
+    int32                           i32;
+
+    while('\0' != *fmt)
+    {
+        if('%' != *fmt)
+        {
+            fmt++;
+            continue;
+        }
+        fmt += parse_conversion(fmt, &arg, &N_star);
+        if(LTE_FDD_ENB_DEBUG_LOG_ARG_INVALID == arg                       ||
+           (N_bytes + N_star*sizeof(int32) + sizeof(uint64)) > LTE_FDD_ENB_DEBUG_LOG_MAX_ARG_SIZE)
+        {
+            break;
+        }
+        for(i=0; i<N_star; i++)
+        {
+            i32 = va_arg(args, int32);
+            memcpy(&buf[N_bytes], &i32, sizeof(i32));
+            N_bytes += sizeof(i32);
+        }
+        switch(arg)
+        {
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_INT:
+            i32 = va_arg(args, int);
+            memcpy(&buf[N_bytes], &i32, sizeof(i32));
+            N_bytes += sizeof(i32);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_LONG:
+            u64 = va_arg(args, long);
+            memcpy(&buf[N_bytes], &u64, sizeof(u64));
+            N_bytes += sizeof(u64);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_LONG_LONG:
+            u64 = va_arg(args, long long);
+            memcpy(&buf[N_bytes], &u64, sizeof(u64));
+            N_bytes += sizeof(u64);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_SIZE:
+            u64 = va_arg(args, size_t);
+            memcpy(&buf[N_bytes], &u64, sizeof(u64));
+            N_bytes += sizeof(u64);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_DOUBLE:
+            d = va_arg(args, double);
+            memcpy(&buf[N_bytes], &d, sizeof(d));
+            N_bytes += sizeof(d);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_POINTER:
+            u64 = (uint64)va_arg(args, void*);
+            memcpy(&buf[N_bytes], &u64, sizeof(u64));
+            N_bytes += sizeof(u64);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_STRING:
+            str = va_arg(args, const char*);
+            if(NULL == str)
+            {
+                str = "(null)";
+            }
+            len = strnlen(str, LTE_FDD_ENB_DEBUG_LOG_MAX_ARG_SIZE - N_bytes - 1);
+            memcpy(&buf[N_bytes], str, len);
+            buf[N_bytes + len]  = '\0';
+            N_bytes            += len + 1;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return(N_bytes);
+}
+
+/*********************************************************************
+    Name: format_args
+
+    Description: Formats fmt with the arguments packed by pack_args.
+*********************************************************************/
+static void format_args(const char  *fmt,
+                        uint8       *buf,
+                        uint32       N_bytes,
+                        std::string &out)
+{
+    LTE_FDD_ENB_DEBUG_LOG_ARG_ENUM  arg;
+    const char                     *start;
+    const char                     *str;
+    uint64                          u64;
+    double                          d;
+    uint32                          N_star;
+    uint32                          offset = 0;
+    uint32                          len;
+    uint32                          spec_len;
+    uint32                          i;
+    uint32                          j;
+    int32                           i32;
+    char                            spec[LTE_FDD_ENB_DEBUG_LOG_MAX_SPEC_SIZE*2];
+    char                            tmp[LTE_FDD_ENB_DEBUG_LOG_MAX_ARG_SIZE + LTE_FDD_ENB_DEBUG_LOG_MAX_SPEC_SIZE*2];
+
+    while('\0' != *fmt)
+    {
+        start = fmt;
+        while('\0' != *fmt && '%' != *fmt)
+        {
+            fmt++;
+        }
+        out.append(start, fmt - start);
+        if('\0' == *fmt)
+        {
+            break;
+        }
+
+        start = fmt;
+        len   = parse_conversion(fmt, &arg, &N_star);
+        fmt  += len;
+        if(LTE_FDD_ENB_DEBUG_LOG_ARG_NONE == arg)
+        {
+            out += '%';
+            continue;
+        }
+        if(LTE_FDD_ENB_DEBUG_LOG_ARG_INVALID == arg                     ||
+           LTE_FDD_ENB_DEBUG_LOG_MAX_SPEC_SIZE <= len                   ||
+           (offset + N_star*sizeof(int32) + 1) > N_bytes                 ||
+           (LTE_FDD_ENB_DEBUG_LOG_ARG_STRING != arg                     &&
+            LTE_FDD_ENB_DEBUG_LOG_ARG_INT    != arg                     &&
+            (offset + N_star*sizeof(int32) + sizeof(uint64)) > N_bytes) ||
+           (LTE_FDD_ENB_DEBUG_LOG_ARG_INT    == arg                     &&
+            (offset + N_star*sizeof(int32) + sizeof(int32)) > N_bytes))
+        {
+            // Arguments stopped here, show the rest as is
+            out += start;
+            break;
+        }
+
+        // Substitute the * widths and precisions
+        spec_len = 0;
+        for(i=0; i<len; i++)
+        {
+            if('*' == start[i])
+            {
+                memcpy(&i32, &buf[offset], sizeof(i32));
+                offset   += sizeof(i32);
+                spec_len += snprintf(&spec[spec_len], sizeof(spec) - spec_len, "%d", i32);
+            }else{
+                spec[spec_len++] = start[i];
+            }
+        }
+        spec[spec_len] = '\0';
+
+        switch(arg)
+        {
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_INT:
+            memcpy(&i32, &buf[offset], sizeof(i32));
+            offset += sizeof(i32);
+            snprintf(tmp, sizeof(tmp), spec, i32);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_LONG:
+            memcpy(&u64, &buf[offset], sizeof(u64));
+            offset += sizeof(u64);
+            snprintf(tmp, sizeof(tmp), spec, (long)u64);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_LONG_LONG:
+            memcpy(&u64, &buf[offset], sizeof(u64));
+            offset += sizeof(u64);
+            snprintf(tmp, sizeof(tmp), spec, (long long)u64);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_SIZE:
+            memcpy(&u64, &buf[offset], sizeof(u64));
+            offset += sizeof(u64);
+            snprintf(tmp, sizeof(tmp), spec, (size_t)u64);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_DOUBLE:
+            memcpy(&d, &buf[offset], sizeof(d));
+            offset += sizeof(d);
+            snprintf(tmp, sizeof(tmp), spec, d);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_POINTER:
+            memcpy(&u64, &buf[offset], sizeof(u64));
+            offset += sizeof(u64);
+            snprintf(tmp, sizeof(tmp), spec, (void *)u64);
+            break;
+        case LTE_FDD_ENB_DEBUG_LOG_ARG_STRING:
+            str = (const char *)&buf[offset];
+            for(j=offset; j<N_bytes && '\0' != buf[j]; j++);
+            offset = j + 1;
+            snprintf(tmp, sizeof(tmp), spec, str);
+            break;
+        default:
+            tmp[0] = '\0';
+            break;
+        }
+        out += tmp;
+    }
+}
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/*****************************/
+/*    Debug Ring Producer    */
+/*****************************/
+LTE_fdd_enb_debug_ring::LTE_fdd_enb_debug_ring(uint32 _size)
+{
+    size = 1;
+    while(size < _size)
+    {
+        size <<= 1;
+    }
+    mask         = size - 1;
+    buf          = new uint8[size];
+    next_head    = 0;
+    head         = 0;
+    tail         = 0;
+    N_dropped    = 0;
+    owner_exited = false;
+}
+LTE_fdd_enb_debug_ring::~LTE_fdd_enb_debug_ring()
+{
+    delete [] buf;
+}
+LTE_FDD_ENB_DEBUG_RECORD_STRUCT* LTE_fdd_enb_debug_ring::claim(uint32 N_bytes)
+{
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT *rec;
+    uint32                           h      = head;
+    uint32                           t      = __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+    uint32                           offset = h & mask;
+    uint32                           to_end = size - offset;
+
+    N_bytes = (N_bytes + 7) & ~7;
+    if(N_bytes > size/2)
+    {
+        return(NULL);
+    }
+
+    // Records do not wrap, the space up to the end is skipped instead
+    if(to_end < N_bytes)
+    {
+        if((size - (h - t)) < (to_end + N_bytes))
+        {
+            return(NULL);
+        }
+        rec       = (LTE_FDD_ENB_DEBUG_RECORD_STRUCT *)&buf[offset];
+        rec->size = to_end;
+        rec->wrap = true;
+        h        += to_end;
+        offset    = 0;
+    }else if((size - (h - t)) < N_bytes){
+        return(NULL);
+    }
+    rec       = (LTE_FDD_ENB_DEBUG_RECORD_STRUCT *)&buf[offset];
+    rec->size = N_bytes;
+    rec->wrap = false;
+    next_head = h + N_bytes;
+
+    return(rec);
+}
+void LTE_fdd_enb_debug_ring::publish(void)
+{
+    __atomic_store_n(&head, next_head, __ATOMIC_RELEASE);
+}
+
+/*****************************/
+/*    Debug Ring Consumer    */
+/*****************************/
+LTE_FDD_ENB_DEBUG_RECORD_STRUCT* LTE_fdd_enb_debug_ring::front(void)
+{
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT *rec;
+    uint32                           h = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+
+    while(tail != h)
+    {
+        rec = (LTE_FDD_ENB_DEBUG_RECORD_STRUCT *)&buf[tail & mask];
+        if(!rec->wrap)
+        {
+            return(rec);
+        }
+        __atomic_store_n(&tail, tail + rec->size, __ATOMIC_RELEASE);
+    }
+
+    return(NULL);
+}
+void LTE_fdd_enb_debug_ring::release(void)
+{
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT *rec = (LTE_FDD_ENB_DEBUG_RECORD_STRUCT *)&buf[tail & mask];
+
+    __atomic_store_n(&tail, tail + rec->size, __ATOMIC_RELEASE);
+}
+bool LTE_fdd_enb_debug_ring::is_empty(void)
+{
+    return(__atomic_load_n(&head, __ATOMIC_ACQUIRE) == __atomic_load_n(&tail, __ATOMIC_ACQUIRE));
+}
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_debug_log::LTE_fdd_enb_debug_log(LTE_fdd_enb_interface *_interface)
+{
+    interface          = _interface;
+    file               = NULL;
+    generation         = __atomic_add_fetch(&debug_log_generation, 1, __ATOMIC_RELAXED);
+    N_rings            = 0;
+    N_dropped_no_ring  = 0;
+    N_dropped_reported = 0;
+    stop               = false;
+    sem_init(&ring_sem, 0, 1);
+    sem_init(&file_sem, 0, 1);
+    pthread_key_create(&ring_key, &handle_thread_exit);
+    pthread_create(&thread, NULL, &writer_thread, this);
+}
+LTE_fdd_enb_debug_log::~LTE_fdd_enb_debug_log()
+{
+    uint32 i;
+
+    // The writer drains every ring before it exits
+    __atomic_store_n(&stop, true, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+
+    pthread_key_delete(ring_key);
+    for(i=0; i<N_rings; i++)
+    {
+        delete rings[i];
+    }
+    if(NULL != file)
+    {
+        fclose(file);
+    }
+    sem_destroy(&file_sem);
+    sem_destroy(&ring_sem);
+}
+
+/*******************/
+/*    Producers    */
+/*******************/
+void LTE_fdd_enb_debug_log::log(LTE_FDD_ENB_DEBUG_TYPE_ENUM         type,
+                                LTE_FDD_ENB_DEBUG_LEVEL_ENUM        level,
+                                const char                         *file_name,
+                                int32                               line,
+                                LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_ENUM  payload_type,
+                                uint8                              *payload,
+                                uint32                              N_payload,
+                                const char                         *fmt,
+                                va_list                             args)
+{
+    LTE_fdd_enb_debug_ring          *ring = get_thread_ring();
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT *rec;
+    struct timeval                   time;
+    uint32                           N_arg_bytes;
+    uint8                            arg_buf[LTE_FDD_ENB_DEBUG_LOG_MAX_ARG_SIZE];
+
+    if(NULL == ring)
+    {
+        __atomic_fetch_add(&N_dropped_no_ring, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    gettimeofday(&time, NULL);
+    N_arg_bytes = pack_args(fmt, args, arg_buf);
+    rec         = ring->claim(sizeof(LTE_FDD_ENB_DEBUG_RECORD_STRUCT) + N_arg_bytes + N_payload);
+    if(NULL == rec)
+    {
+        __atomic_store_n(&ring->N_dropped, ring->N_dropped + 1, __ATOMIC_RELAXED);
+        return;
+    }
+    rec->time         = time;
+    rec->file_name    = file_name;
+    rec->fmt          = fmt;
+    rec->line         = line;
+    rec->N_arg_bytes  = N_arg_bytes;
+    rec->N_payload    = N_payload;
+    rec->type         = type;
+    rec->level        = level;
+    rec->payload_type = payload_type;
+    memcpy((uint8 *)(rec + 1), arg_buf, N_arg_bytes);
+    if(0 != N_payload)
+    {
+        memcpy((uint8 *)(rec + 1) + N_arg_bytes, payload, N_payload);
+    }
+    ring->publish();
+}
+LTE_fdd_enb_debug_ring* LTE_fdd_enb_debug_log::get_thread_ring(void)
+{
+    uint32 i;
+
+    if(generation != thread_generation)
+    {
+        libtools_scoped_lock lock(ring_sem);
+
+        // Reuse the drained ring of a thread that exited
+        thread_ring = NULL;
+        for(i=0; i<N_rings; i++)
+        {
+            if(__atomic_load_n(&rings[i]->owner_exited, __ATOMIC_ACQUIRE) &&
+               rings[i]->is_empty())
+            {
+                thread_ring               = rings[i];
+                thread_ring->owner_exited = false;
+                break;
+            }
+        }
+        if(NULL == thread_ring &&
+           LTE_FDD_ENB_DEBUG_LOG_MAX_RINGS > N_rings)
+        {
+            thread_ring      = new LTE_fdd_enb_debug_ring(LTE_FDD_ENB_DEBUG_LOG_RING_SIZE);
+            rings[N_rings]   = thread_ring;
+            __atomic_store_n(&N_rings, N_rings + 1, __ATOMIC_RELEASE);
+        }
+        if(NULL != thread_ring)
+        {
+            pthread_setspecific(ring_key, thread_ring);
+        }
+        thread_generation = generation;
+    }
+
+    return(thread_ring);
+}
+void LTE_fdd_enb_debug_log::handle_thread_exit(void *ring)
+{
+    __atomic_store_n(&((LTE_fdd_enb_debug_ring *)ring)->owner_exited, true, __ATOMIC_RELEASE);
+}
+
+/********************/
+/*    Debug File    */
+/********************/
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_debug_log::set_file(std::string file_name)
+{
+    libtools_scoped_lock   lock(file_sem);
+    LTE_FDD_ENB_ERROR_ENUM err = LTE_FDD_ENB_ERROR_NONE;
+
+    if(NULL != file)
+    {
+        fclose(file);
+        file = NULL;
+    }
+    if("none" != file_name)
+    {
+        file = fopen(file_name.c_str(), "a");
+        if(NULL == file)
+        {
+            err = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+        }
+    }
+
+    return(err);
+}
+bool LTE_fdd_enb_debug_log::is_file_open(void)
+{
+    libtools_scoped_lock lock(file_sem);
+
+    return(NULL != file);
+}
+
+/********************/
+/*    Statistics    */
+/********************/
+uint32 LTE_fdd_enb_debug_log::get_N_dropped(void)
+{
+    uint32 N_dropped = __atomic_load_n(&N_dropped_no_ring, __ATOMIC_RELAXED);
+    uint32 N         = __atomic_load_n(&N_rings, __ATOMIC_ACQUIRE);
+    uint32 i;
+
+    for(i=0; i<N; i++)
+    {
+        N_dropped += __atomic_load_n(&rings[i]->N_dropped, __ATOMIC_RELAXED);
+    }
+
+    return(N_dropped);
+}
+
+/****************/
+/*    Writer    */
+/****************/
+void* LTE_fdd_enb_debug_log::writer_thread(void *inputs)
+{
+    LTE_fdd_enb_debug_log *debug_log = (LTE_fdd_enb_debug_log *)inputs;
+    cpu_set_t              af_mask;
+
+    // Set affinity to not the last core (last core is for PHY/Radio)
+    pthread_getaffinity_np(debug_log->thread, sizeof(af_mask), &af_mask);
+    CPU_CLR(sysconf(_SC_NPROCESSORS_ONLN)-1, &af_mask);
+    pthread_setaffinity_np(debug_log->thread, sizeof(af_mask), &af_mask);
+
+    while(!__atomic_load_n(&debug_log->stop, __ATOMIC_ACQUIRE))
+    {
+        if(0 == debug_log->write_records())
+        {
+            usleep(LTE_FDD_ENB_DEBUG_LOG_POLL_US);
+        }
+    }
+    debug_log->write_records();
+
+    return(NULL);
+}
+uint32 LTE_fdd_enb_debug_log::write_records(void)
+{
+    LTE_fdd_enb_debug_ring          *ring;
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT *rec;
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT *oldest;
+    std::string                      batch;
+    uint32                           N_written = 0;
+    uint32                           N         = __atomic_load_n(&N_rings, __ATOMIC_ACQUIRE);
+    uint32                           N_dropped;
+    uint32                           i;
+    uint64                           drop_buf[sizeof(LTE_FDD_ENB_DEBUG_RECORD_STRUCT)/sizeof(uint64) + 1];
+
+    // Merge the rings in time order
+    while(1)
+    {
+        ring   = NULL;
+        oldest = NULL;
+        for(i=0; i<N; i++)
+        {
+            rec = rings[i]->front();
+            if(NULL != rec &&
+               (NULL == oldest                                ||
+                rec->time.tv_sec  <  oldest->time.tv_sec      ||
+                (rec->time.tv_sec  == oldest->time.tv_sec &&
+                 rec->time.tv_usec <  oldest->time.tv_usec)))
+            {
+                ring   = rings[i];
+                oldest = rec;
+            }
+        }
+        if(NULL == oldest)
+        {
+            break;
+        }
+
+        format_record(oldest, batch);
+        ring->release();
+        N_written++;
+        if(LTE_FDD_ENB_DEBUG_LOG_MAX_BATCH <= batch.length())
+        {
+            write_batch(batch);
+        }
+    }
+
+    // Report messages that did not fit
+    N_dropped = get_N_dropped();
+    if(N_dropped != N_dropped_reported)
+    {
+        rec = (LTE_FDD_ENB_DEBUG_RECORD_STRUCT *)drop_buf;
+        gettimeofday(&rec->time, NULL);
+        rec->file_name     = __FILE__;
+        rec->fmt           = "Dropped %u debug messages";
+        rec->line          = __LINE__;
+        rec->N_arg_bytes   = sizeof(uint32);
+        rec->N_payload     = 0;
+        rec->type          = LTE_FDD_ENB_DEBUG_TYPE_WARNING;
+        rec->level         = LTE_FDD_ENB_DEBUG_LEVEL_IFACE;
+        rec->payload_type  = LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_NONE;
+        i                  = N_dropped - N_dropped_reported;
+        memcpy(rec + 1, &i, sizeof(uint32));
+        format_record(rec, batch);
+        N_dropped_reported = N_dropped;
+        N_written++;
+    }
+
+    if(0 != batch.length())
+    {
+        write_batch(batch);
+    }
+
+    return(N_written);
+}
+void LTE_fdd_enb_debug_log::format_record(LTE_FDD_ENB_DEBUG_RECORD_STRUCT *rec,
+                                          std::string                     &out)
+{
+    struct tm  local_time;
+    uint8     *args    = (uint8 *)(rec + 1);
+    uint8     *payload = args + rec->N_arg_bytes;
+    uint32     i;
+    uint32     hex_val;
+
+    // Same layout as get_formatted_time, for the time of the call
+    localtime_r(&rec->time.tv_sec, &local_time);
+    out += to_string(local_time.tm_mon + 1, 2) + "/";
+    out += to_string(local_time.tm_mday, 2) + "/";
+    out += to_string(local_time.tm_year + 1900, 4) + " ";
+    out += to_string(local_time.tm_hour, 2) + ":";
+    out += to_string((rec->time.tv_sec / 60) % 60, 2) + ":";
+    out += to_string(rec->time.tv_sec % 60, 2) + ".";
+    out += to_string(rec->time.tv_usec, 6);
+    out += " ";
+    out += LTE_fdd_enb_debug_type_text[rec->type];
+    out += " ";
+    out += LTE_fdd_enb_debug_level_text[rec->level];
+    out += " ";
+    out += rec->file_name;
+    out += " ";
+    out += to_string(rec->line);
+    out += " ";
+    format_args(rec->fmt, args, rec->N_arg_bytes, out);
+
+    if(LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_BITS == rec->payload_type)
+    {
+        out     += " ";
+        hex_val  = 0;
+        for(i=0; i<rec->N_payload; i++)
+        {
+            hex_val <<= 1;
+            hex_val  |= payload[i];
+            if((i % 4) == 3)
+            {
+                if(hex_val < 0xA)
+                {
+                    out += (char)(hex_val + '0');
+                }else{
+                    out += (char)((hex_val-0xA) + 'A');
+                }
+                hex_val = 0;
+            }
+        }
+        if((rec->N_payload % 4) != 0)
+        {
+            for(i=0; i<4-(rec->N_payload % 4); i++)
+            {
+                hex_val <<= 1;
+            }
+            if(hex_val < 0xA)
+            {
+                out += (char)(hex_val + '0');
+            }else{
+                out += (char)((hex_val-0xA) + 'A');
+            }
+        }
+    }else if(LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_BYTES == rec->payload_type){
+        out += " " + to_string(payload, rec->N_payload);
+    }
+    out += "\n";
+}
+void LTE_fdd_enb_debug_log::write_batch(std::string &batch)
+{
+    interface->send_debug_lines(batch);
+
+    sem_wait(&file_sem);
+    if(NULL != file)
+    {
+        fwrite(batch.c_str(), 1, batch.length(), file);
+        fflush(file);
+    }
+    sem_post(&file_sem);
+
+    batch.clear();
+}
@@ -213,12 +213,11 @@ void LTE_fdd_enb_gw::handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
         handle_gw_data(&msg.msg.gw_data_ready);
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_GW,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received invalid PDCP message %s",
-                                  LTE_fdd_enb_message_type_text[msg.type]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_GW,
+                          "Received invalid PDCP message %s",
+                          LTE_fdd_enb_message_type_text[msg.type]);
         break;
     }
 }
@@ -232,23 +231,21 @@ void LTE_fdd_enb_gw::handle_gw_data(LTE_FDD_ENB_GW_DATA_READY_MSG_STRUCT *gw_dat
 
     if(LTE_FDD_ENB_ERROR_NONE == gw_data->rb->get_next_gw_data_msg(&msg))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_GW,
-                                  __FILE__,
-                                  __LINE__,
-                                  msg,
-                                  "Received GW data message for RNTI=%u and RB=%s",
-                                  gw_data->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[gw_data->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_GW,
+                          msg,
+                          "Received GW data message for RNTI=%u and RB=%s",
+                          gw_data->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[gw_data->rb->get_rb_id()]);
         interface->send_ip_pcap_msg(msg->msg, msg->N_bytes);
 
         if(msg->N_bytes != write(tun_fd, msg->msg, msg->N_bytes))
         {
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_GW,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Write failure");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_GW,
+                              "Write failure");
         }
 
         // Delete the message
@@ -291,14 +288,13 @@ void* LTE_fdd_enb_gw::receive_thread(void *inputs)
                 if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(ntohl(ip_pkt.daddr), &pdcp_data_sdu.user) &&
                    LTE_FDD_ENB_ERROR_NONE == pdcp_data_sdu.user->get_drb(LTE_FDD_ENB_RB_DRB1, &pdcp_data_sdu.rb))
                 {
-                    gw->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                                  LTE_FDD_ENB_DEBUG_LEVEL_GW,
-                                                  __FILE__,
-                                                  __LINE__,
-                                                  &msg,
-                                                  "Received IP packet for RNTI=%u and RB=%s",
-                                                  pdcp_data_sdu.user->get_c_rnti(),
-                                                  LTE_fdd_enb_rb_text[pdcp_data_sdu.rb->get_rb_id()]);
+                    LTE_FDD_ENB_DEBUG(gw->interface,
+                                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_GW,
+                                      &msg,
+                                      "Received IP packet for RNTI=%u and RB=%s",
+                                      pdcp_data_sdu.user->get_c_rnti(),
+                                      LTE_fdd_enb_rb_text[pdcp_data_sdu.rb->get_rb_id()]);
                     gw->interface->send_ip_pcap_msg(msg.msg, msg.N_bytes);
 
                     // Send message to PDCP
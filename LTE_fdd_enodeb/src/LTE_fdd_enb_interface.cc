@@ -60,6 +60,8 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_interface.h"
+#include "LTE_fdd_enb_debug_log.h"
+#include "LTE_fdd_enb_pcap.h"
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_user_mgr.h"
 #include "LTE_fdd_enb_hss.h"
@@ -121,6 +123,20 @@ LTE_fdd_enb_interface* LTE_fdd_enb_interface::get_instance(void)
 }
 void LTE_fdd_enb_interface::cleanup(void)
 {
+    LTE_fdd_enb_interface *interface;
+
+    // Stop the layers before tearing down the debug log and captures
+    // they use, the message queues look up the instance as they are
+    // deleted so the instance mutex must not be held while stopping
+    pthread_mutex_lock(&interface_instance_mutex);
+    interface = instance;
+    pthread_mutex_unlock(&interface_instance_mutex);
+    if(NULL != interface &&
+       interface->app_is_started())
+    {
+        interface->handle_stop();
+    }
+
     libtools_scoped_lock lock(interface_instance_mutex);
 
     if(NULL != instance)
@@ -186,6 +202,12 @@ LTE_fdd_enb_interface::LTE_fdd_enb_interface()
     var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_USE_USER_FILE]]      = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_USE_USER_FILE, 0, 0, 0, 1, false, true, false};
     var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_TX_GAIN]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_TX_GAIN, 0, 0, 0, 100, false, true, false};
     var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RX_GAIN]]            = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_RX_GAIN, 0, 0, 0, 100, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_FFTW_WISDOM_FILE]]   = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_STRING, LTE_FDD_ENB_PARAM_FFTW_WISDOM_FILE, 0, 0, 0, 0, true, false, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_FILE]]         = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_STRING, LTE_FDD_ENB_PARAM_DEBUG_FILE, 0, 0, 0, 0, true, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_FORMAT]]        = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_STRING, LTE_FDD_ENB_PARAM_PCAP_FORMAT, 0, 0, 0, 0, true, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_SNAPLEN]]       = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_PCAP_SNAPLEN, 0, 0, 64, 65535, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_ROTATE_SIZE]]   = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_PCAP_ROTATE_SIZE, 0, 0, 0, 1048576, false, true, false};
+    var_map[LTE_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_ROTATE_TIME]]   = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_PCAP_ROTATE_TIME, 0, 0, 0, 604800, false, true, false};
 
     debug_type_mask = 0;
     for(i=0; i<LTE_FDD_ENB_DEBUG_TYPE_N_ITEMS; i++)
@@ -197,17 +219,37 @@ LTE_fdd_enb_interface::LTE_fdd_enb_interface()
     {
         debug_level_mask |= 1 << i;
     }
-    open_lte_pcap_fd();
-    open_ip_pcap_fd();
+    debug_log = new LTE_fdd_enb_debug_log(this);
+    update_debug_mask();
+    lte_pcap = new LTE_fdd_enb_pcap(this, "/tmp/LTE_fdd_enodeb", LTE_FDD_ENB_PCAP_LINK_TYPE_LTE);
+    ip_pcap  = new LTE_fdd_enb_pcap(this, "/tmp/LTE_fdd_enodeb_ip", LTE_FDD_ENB_PCAP_LINK_TYPE_IP);
     shutdown = false;
     started  = false;
 }
 LTE_fdd_enb_interface::~LTE_fdd_enb_interface()
 {
-    stop_ports();
+    // The layers were stopped by cleanup, close the control port so
+    // that its thread stops logging before the debug log is deleted.
+    // Flush the pending captures and debug messages before the debug
+    // port closes, no new debug messages are accepted once the flush
+    // starts
+    {
+        libtools_scoped_lock c_lock(ctrl_sem);
 
-    fclose(lte_pcap_fd);
-    fclose(ip_pcap_fd);
+        if(NULL != ctrl_socket)
+        {
+            delete ctrl_socket;
+            ctrl_socket = NULL;
+        }
+    }
+    delete lte_pcap;
+    lte_pcap = NULL;
+    delete ip_pcap;
+    ip_pcap  = NULL;
+    __atomic_store_n(&debug_mask, 0, __ATOMIC_RELAXED);
+    delete debug_log;
+    debug_log = NULL;
+    stop_ports();
 
     sem_destroy(&start_sem);
     sem_destroy(&ctrl_sem);
@@ -265,12 +307,11 @@ void LTE_fdd_enb_interface::start_ports(void)
                                                &error);
         if(LIBTOOLS_SOCKET_WRAP_SUCCESS != error)
         {
-            send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                           LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
-                           __FILE__,
-                           __LINE__,
-                           "Couldn't open ctrl_socket %s",
-                           libtools_socket_wrap_error_text[error]);
+            LTE_FDD_ENB_DEBUG(this,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                              "Couldn't open ctrl_socket %s",
+                              libtools_socket_wrap_error_text[error]);
             ctrl_socket = NULL;
         }
     }
@@ -349,217 +390,89 @@ void LTE_fdd_enb_interface::send_ctrl_error_msg(LTE_FDD_ENB_ERROR_ENUM error,
         ctrl_socket->send(tmp_msg);
     }
 }
-void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM  type,
-                                           LTE_FDD_ENB_DEBUG_LEVEL_ENUM level,
-                                           std::string                  file_name,
-                                           int32                        line,
-                                           std::string                  msg,
+void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
+                                           LTE_FDD_ENB_DEBUG_LEVEL_ENUM  level,
+                                           const char                   *file_name,
+                                           int32                         line,
+                                           const char                   *msg,
                                            ...)
 {
-    libtools_scoped_lock  lock(debug_connect_mutex);
-    std::string           tmp_msg;
-    va_list               args;
-    char                 *args_msg;
+    va_list args;
 
-    if(debug_connected                 &&
-       (debug_type_mask & (1 << type)) &&
-       (debug_level_mask & (1 << level)))
+    if(debug_enabled(type, level))
     {
-        // Format the output string
-        get_formatted_time(tmp_msg);
-        tmp_msg += " ";
-        tmp_msg += LTE_fdd_enb_debug_type_text[type];
-        tmp_msg += " ";
-        tmp_msg += LTE_fdd_enb_debug_level_text[level];
-        tmp_msg += " ";
-        tmp_msg += file_name.c_str();
-        tmp_msg += " ";
-        tmp_msg += to_string(line);
-        tmp_msg += " ";
         va_start(args, msg);
-        if(-1 != vasprintf(&args_msg, msg.c_str(), args))
-        {
-            tmp_msg += args_msg;
-        }
-        tmp_msg += "\n";
-
-        // Cleanup the variable argument string
-        free(args_msg);
-
-        debug_socket->send(tmp_msg);
+        debug_log->log(type,
+                       level,
+                       file_name,
+                       line,
+                       LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_NONE,
+                       NULL,
+                       0,
+                       msg,
+                       args);
+        va_end(args);
     }
 }
 void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
                                            LTE_FDD_ENB_DEBUG_LEVEL_ENUM  level,
-                                           std::string                   file_name,
+                                           const char                   *file_name,
                                            int32                         line,
                                            LIBLTE_BIT_MSG_STRUCT        *lte_msg,
-                                           std::string                   msg,
+                                           const char                   *msg,
                                            ...)
 {
-    libtools_scoped_lock  lock(debug_connect_mutex);
-    std::string           tmp_msg;
-    va_list               args;
-    uint32                i;
-    uint32                hex_val;
-    char                 *args_msg;
+    va_list args;
 
-    if(debug_connected                 &&
-       (debug_type_mask & (1 << type)) &&
-       (debug_level_mask & (1 << level)))
+    if(debug_enabled(type, level))
     {
-        // Format the output string
-        get_formatted_time(tmp_msg);
-        tmp_msg += " ";
-        tmp_msg += LTE_fdd_enb_debug_type_text[type];
-        tmp_msg += " ";
-        tmp_msg += LTE_fdd_enb_debug_level_text[level];
-        tmp_msg += " ";
-        tmp_msg += file_name.c_str();
-        tmp_msg += " ";
-        tmp_msg += to_string(line);
-        tmp_msg += " ";
         va_start(args, msg);
-        if(-1 != vasprintf(&args_msg, msg.c_str(), args))
-        {
-            tmp_msg += args_msg;
-        }
-        tmp_msg += " ";
-        hex_val  = 0;
-        for(i=0; i<lte_msg->N_bits; i++)
-        {
-            hex_val <<= 1;
-            hex_val  |= lte_msg->msg[i];
-            if((i % 4) == 3)
-            {
-                if(hex_val < 0xA)
-                {
-                    tmp_msg += (char)(hex_val + '0');
-                }else{
-                    tmp_msg += (char)((hex_val-0xA) + 'A');
-                }
-                hex_val = 0;
-            }
-        }
-        if((lte_msg->N_bits % 4) != 0)
-        {
-            for(i=0; i<4-(lte_msg->N_bits % 4); i++)
-            {
-                hex_val <<= 1;
-            }
-            if(hex_val < 0xA)
-            {
-                tmp_msg += (char)(hex_val + '0');
-            }else{
-                tmp_msg += (char)((hex_val-0xA) + 'A');
-            }
-        }
-        tmp_msg += "\n";
-
-        // Cleanup the variable argument string
-        free(args_msg);
-
-        debug_socket->send(tmp_msg);
+        debug_log->log(type,
+                       level,
+                       file_name,
+                       line,
+                       LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_BITS,
+                       lte_msg->msg,
+                       lte_msg->N_bits,
+                       msg,
+                       args);
+        va_end(args);
     }
 }
 void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
                                            LTE_FDD_ENB_DEBUG_LEVEL_ENUM  level,
-                                           std::string                   file_name,
+                                           const char                   *file_name,
                                            int32                         line,
                                            LIBLTE_BYTE_MSG_STRUCT       *lte_msg,
-                                           std::string                   msg,
+                                           const char                   *msg,
                                            ...)
 {
-    libtools_scoped_lock  lock(debug_connect_mutex);
-    std::string           tmp_msg;
-    va_list               args;
-    char                 *args_msg;
+    va_list args;
 
-    if(debug_connected                 &&
-       (debug_type_mask & (1 << type)) &&
-       (debug_level_mask & (1 << level)))
+    if(debug_enabled(type, level))
     {
-        // Format the output string
-        get_formatted_time(tmp_msg);
-        tmp_msg += " ";
-        tmp_msg += LTE_fdd_enb_debug_type_text[type];
-        tmp_msg += " ";
-        tmp_msg += LTE_fdd_enb_debug_level_text[level];
-        tmp_msg += " ";
-        tmp_msg += file_name.c_str();
-        tmp_msg += " ";
-        tmp_msg += to_string(line);
-        tmp_msg += " ";
         va_start(args, msg);
-        if(-1 != vasprintf(&args_msg, msg.c_str(), args))
-        {
-            tmp_msg += args_msg;
-        }
-        tmp_msg += " " + to_string(lte_msg->msg, lte_msg->N_bytes) + "\n";
-
-        // Cleanup the variable argument string
-        free(args_msg);
-
-        debug_socket->send(tmp_msg);
+        debug_log->log(type,
+                       level,
+                       file_name,
+                       line,
+                       LTE_FDD_ENB_DEBUG_LOG_PAYLOAD_BYTES,
+                       lte_msg->msg,
+                       lte_msg->N_bytes,
+                       msg,
+                       args);
+        va_end(args);
     }
 }
-void LTE_fdd_enb_interface::open_lte_pcap_fd(void)
-{
-    uint32 magic_number = 0xa1b2c3d4;
-    uint32 timezone     = 0;
-    uint32 sigfigs      = 0;
-    uint32 snap_len     = 0xFFFF;
-    uint32 dlt          = 147;
-    uint32 tmp_u32;
-    uint16 major_version = 2;
-    uint16 minor_version = 4;
-    uint16 tmp_u16;
-
-    lte_pcap_fd = fopen("/tmp/LTE_fdd_enodeb.pcap", "w");
-
-    tmp_u32 = htonl(magic_number);
-    fwrite(&tmp_u32, sizeof(tmp_u32), 1, lte_pcap_fd);
-    tmp_u16 = htons(major_version);
-    fwrite(&tmp_u16, sizeof(tmp_u16), 1, lte_pcap_fd);
-    tmp_u16 = htons(minor_version);
-    fwrite(&tmp_u16, sizeof(tmp_u16), 1, lte_pcap_fd);
-    tmp_u32 = htonl(timezone);
-    fwrite(&tmp_u32, sizeof(tmp_u32), 1, lte_pcap_fd);
-    tmp_u32 = htonl(sigfigs);
-    fwrite(&tmp_u32, sizeof(tmp_u32), 1, lte_pcap_fd);
-    tmp_u32 = htonl(snap_len);
-    fwrite(&tmp_u32, sizeof(tmp_u32), 1, lte_pcap_fd);
-    tmp_u32 = htonl(dlt);
-    fwrite(&tmp_u32, sizeof(tmp_u32), 1, lte_pcap_fd);
-}
-void LTE_fdd_enb_interface::open_ip_pcap_fd(void)
+void LTE_fdd_enb_interface::send_debug_lines(std::string &lines)
 {
-    uint32 magic_number = 0xa1b2c3d4;
-    uint32 timezone     = 0;
-    uint32 sigfigs      = 0;
-    uint32 snap_len     = 0xFFFF;
-    uint32 dlt          = 228;
-    uint32 tmp_u32;
-    uint16 major_version = 2;
-    uint16 minor_version = 4;
-    uint16 tmp_u16;
-
-    ip_pcap_fd = fopen("/tmp/LTE_fdd_enodeb_ip.pcap", "w");
-
-    tmp_u32 = htonl(magic_number);
-    fwrite(&tmp_u32, sizeof(tmp_u32), 1, ip_pcap_fd);
-    tmp_u16 = htons(major_version);
-    fwrite(&tmp_u16, sizeof(tmp_u16), 1, ip_pcap_fd);
-    tmp_u16 = htons(minor_version);
-    fwrite(&tmp_u16, sizeof(tmp_u16), 1, ip_pcap_fd);
-    tmp_u32 = htonl(timezone);
-    fwrite(&tmp_u32, sizeof(tmp_u32), 1, ip_pcap_fd);
-    tmp_u32 = htonl(sigfigs);
-    fwrite(&tmp_u32, sizeof(tmp_u32), 1, ip_pcap_fd);
-    tmp_u32 = htonl(snap_len);
-    fwrite(&tmp_u32, sizeof(tmp_u32), 1, ip_pcap_fd);
-    tmp_u32 = htonl(dlt);
-    fwrite(&tmp_u32, sizeof(tmp_u32), 1, ip_pcap_fd);
+    libtools_scoped_lock lock(debug_connect_mutex);
+
+    if(debug_connected &&
+       NULL != debug_socket)
+    {
+        debug_socket->send(lines);
+    }
 }
 void LTE_fdd_enb_interface::send_lte_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_ENUM  dir,
                                               uint32                           rnti,
@@ -567,24 +480,33 @@ void LTE_fdd_enb_interface::send_lte_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_ENUM  d
                                               uint8                           *msg,
                                               uint32                           N_bits)
 {
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
-    struct timeval       time;
-    struct timezone      time_zone;
-    int64                enable_pcap;
-    uint32               i;
-    uint32               idx;
-    uint32               length;
-    uint32               tmp_u32;
-    uint16               tmp_u16;
-    uint8                pcap_c_hdr[15];
-    uint8                pcap_msg[LIBLTE_MAX_MSG_SIZE*2];
-
-    cnfg_db->get_param(LTE_FDD_ENB_PARAM_ENABLE_PCAP, enable_pcap);
-
-    if(enable_pcap)
+    LTE_FDD_ENB_PCAP_RECORD_STRUCT *rec;
+    uint32                          i;
+    uint32                          N_bytes;
+    uint32                          pos;
+    uint32                          snaplen;
+    uint16                          tmp_u16;
+    uint8                          *pcap_c_hdr;
+    uint8                          *pcap_msg;
+
+    if(NULL != lte_pcap &&
+       lte_pcap->is_enabled())
     {
+        // Records are filled in place, the writer thread does the file I/O
+        rec = lte_pcap->claim(&pos);
+        if(NULL == rec)
+        {
+            return;
+        }
+        pcap_c_hdr = rec->msg;
+        pcap_msg   = &rec->msg[15];
+        if(N_bits > (LTE_FDD_ENB_PCAP_MAX_RECORD_SIZE - 15)*8)
+        {
+            N_bits = (LTE_FDD_ENB_PCAP_MAX_RECORD_SIZE - 15)*8;
+        }
+
         // Get approximate time stamp
-        gettimeofday(&time, &time_zone);
+        gettimeofday(&rec->time, NULL);
 
         // Radio Type
         pcap_c_hdr[0] = 1;
@@ -631,60 +553,51 @@ void LTE_fdd_enb_interface::send_lte_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_ENUM  d
         // Payload Tag
         pcap_c_hdr[14] = 1;
 
-        // Payload
-        idx           = 0;
-        pcap_msg[idx] = 0;
-        for(i=0; i<N_bits; i++)
+        // Payload, whole bytes only
+        N_bytes = N_bits/8;
+        for(i=0; i<N_bytes; i++)
         {
-            pcap_msg[idx] <<= 1;
-            pcap_msg[idx]  |= msg[i];
-            if((i % 8) == 7)
-            {
-                idx++;
-                pcap_msg[idx] = 0;
-            }
+            pcap_msg[i] = ((msg[0] << 7) | (msg[1] << 6) | (msg[2] << 5) | (msg[3] << 4) |
+                           (msg[4] << 3) | (msg[5] << 2) | (msg[6] << 1) | msg[7]);
+            msg += 8;
         }
 
-        // Total Length
-        length = 15 + idx;
-
-        // Write Data
-        tmp_u32 = htonl(time.tv_sec);
-        fwrite(&tmp_u32, sizeof(uint32), 1, lte_pcap_fd);
-        tmp_u32 = htonl(time.tv_usec);
-        fwrite(&tmp_u32, sizeof(uint32), 1, lte_pcap_fd);
-        tmp_u32 = htonl(length);
-        fwrite(&tmp_u32,   sizeof(uint32), 1,   lte_pcap_fd);
-        fwrite(&tmp_u32,   sizeof(uint32), 1,   lte_pcap_fd);
-        fwrite(pcap_c_hdr, sizeof(uint8),  15,  lte_pcap_fd);
-        fwrite(pcap_msg,   sizeof(uint8),  idx, lte_pcap_fd);
+        // Total and captured length
+        snaplen         = lte_pcap->get_snaplen();
+        rec->N_bytes    = 15 + N_bytes;
+        rec->N_captured = (rec->N_bytes < snaplen) ? rec->N_bytes : snaplen;
+        lte_pcap->publish(pos);
     }
 }
 void LTE_fdd_enb_interface::send_ip_pcap_msg(uint8  *msg,
                                              uint32  N_bytes)
 {
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
-    struct timeval       time;
-    struct timezone      time_zone;
-    int64                enable_pcap;
-    uint32               tmp;
+    LTE_FDD_ENB_PCAP_RECORD_STRUCT *rec;
+    uint32                          pos;
+    uint32                          snaplen;
 
-    cnfg_db->get_param(LTE_FDD_ENB_PARAM_ENABLE_PCAP, enable_pcap);
-
-    if(enable_pcap)
+    if(NULL != ip_pcap &&
+       ip_pcap->is_enabled())
     {
+        rec = ip_pcap->claim(&pos);
+        if(NULL == rec)
+        {
+            return;
+        }
+
         // Get approximate time stamp
-        gettimeofday(&time, &time_zone);
-
-        // Write Data
-        tmp = htonl(time.tv_sec);
-        fwrite(&tmp, sizeof(uint32), 1, ip_pcap_fd);
-        tmp = htonl(time.tv_usec);
-        fwrite(&tmp, sizeof(uint32), 1, ip_pcap_fd);
-        tmp = htonl(N_bytes);
-        fwrite(&tmp, sizeof(uint32), 1,       ip_pcap_fd);
-        fwrite(&tmp, sizeof(uint32), 1,       ip_pcap_fd);
-        fwrite(msg,  sizeof(uint8),  N_bytes, ip_pcap_fd);
+        gettimeofday(&rec->time, NULL);
+
+        // Total and captured length
+        snaplen         = ip_pcap->get_snaplen();
+        rec->N_bytes    = N_bytes;
+        rec->N_captured = (N_bytes < snaplen) ? N_bytes : snaplen;
+        if(rec->N_captured > LTE_FDD_ENB_PCAP_MAX_RECORD_SIZE)
+        {
+            rec->N_captured = LTE_FDD_ENB_PCAP_MAX_RECORD_SIZE;
+        }
+        memcpy(rec->msg, msg, rec->N_captured);
+        ip_pcap->publish(pos);
     }
 }
 void LTE_fdd_enb_interface::handle_ctrl_msg(std::string msg)
@@ -703,13 +616,14 @@ void LTE_fdd_enb_interface::handle_ctrl_msg(std::string msg)
     }else if(std::string::npos != msg.find("stop")){
         interface->handle_stop();
     }else if(std::string::npos != msg.find("shutdown")){
-        interface->shutdown = true;
+        // Stop the layers before main tears the interface down
         if(radio->is_started())
         {
             interface->handle_stop();
         }else{
             interface->send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
         }
+        interface->shutdown = true;
     }else if(std::string::npos != msg.find("construct_si")){
         if(interface->app_is_started())
         {
@@ -753,12 +667,11 @@ void LTE_fdd_enb_interface::handle_ctrl_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM er
 {
     LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                              LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
-                              __FILE__,
-                              __LINE__,
-                              "ctrl_socket error %s",
-                              libtools_socket_wrap_error_text[err]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                      LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                      "ctrl_socket error %s",
+                      libtools_socket_wrap_error_text[err]);
     assert(0);
 }
 void LTE_fdd_enb_interface::handle_debug_msg(std::string msg)
@@ -773,17 +686,24 @@ void LTE_fdd_enb_interface::handle_debug_connect(void)
 
     LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
-                              __FILE__,
-                              __LINE__,
-                              "*** LTE FDD ENB DEBUG INTERFACE ***");
+    interface->update_debug_mask();
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                      "*** LTE FDD ENB DEBUG INTERFACE ***");
 }
 void LTE_fdd_enb_interface::handle_debug_disconnect(void)
 {
-    libtools_scoped_lock lock(debug_connect_mutex);
-
+    pthread_mutex_lock(&debug_connect_mutex);
     LTE_fdd_enb_interface::debug_connected = false;
+    pthread_mutex_unlock(&debug_connect_mutex);
+
+    // Not get_instance(), cleanup() holds the instance mutex while the
+    // debug port is closed
+    if(NULL != instance)
+    {
+        instance->update_debug_mask();
+    }
 }
 void LTE_fdd_enb_interface::handle_debug_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err)
 {
@@ -827,6 +747,7 @@ void LTE_fdd_enb_interface::handle_read(std::string msg)
             }
             break;
         case LTE_FDD_ENB_VAR_TYPE_HEX:
+        case LTE_FDD_ENB_VAR_TYPE_STRING:
             cnfg_db->get_param((*iter).second.param, s_value);
             send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, s_value);
             break;
@@ -912,6 +833,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::handle_write(std::string msg)
                     err     = write_value(&(*iter).second, i_value);
                     break;
                 case LTE_FDD_ENB_VAR_TYPE_HEX:
+                case LTE_FDD_ENB_VAR_TYPE_STRING:
                     err = write_value(&(*iter).second, msg.substr(msg.find(" ")+1, std::string::npos));
                     break;
                 case LTE_FDD_ENB_VAR_TYPE_UINT32:
@@ -927,6 +849,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::handle_write(std::string msg)
                         }
                         debug_type_mask = u_value;
                         err             = write_value(&(*iter).second, u_value);
+                        update_debug_mask();
                     }else if(LTE_FDD_ENB_PARAM_DEBUG_LEVEL == (*iter).second.param){
                         u_value = 0;
                         for(i=0; i<LTE_FDD_ENB_DEBUG_LEVEL_N_ITEMS; i++)
@@ -938,6 +861,7 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::handle_write(std::string msg)
                         }
                         debug_level_mask = u_value;
                         err              = write_value(&(*iter).second, u_value);
+                        update_debug_mask();
                     }else{
                         u_value = boost::lexical_cast<uint32>(msg.substr(msg.find(" ")+1, std::string::npos));
                         err     = write_value(&(*iter).second, u_value);
@@ -988,20 +912,32 @@ void LTE_fdd_enb_interface::handle_start(void)
         started = true;
         sem_post(&start_sem);
 
-        // Initialize inter-stack communication
-        phy_to_mac_comm   = new LTE_fdd_enb_msgq("phy_to_mac");
+        // Initialize inter-stack communication, queues with a single
+        // sending thread skip the multi-producer compare and swap.  No
+        // sender ever waits, a full queue drops the message and counts it.
+        phy_to_mac_comm   = new LTE_fdd_enb_msgq("phy_to_mac",
+                                                 LTE_FDD_ENB_MSGQ_OVERFLOW_DROP_NEWEST,
+                                                 true);
         mac_to_phy_comm   = new LTE_fdd_enb_msgq("mac_to_phy");
         mac_to_rlc_comm   = new LTE_fdd_enb_msgq("mac_to_rlc");
-        mac_to_timer_comm = new LTE_fdd_enb_msgq("mac_to_timer");
+        mac_to_timer_comm = new LTE_fdd_enb_msgq("mac_to_timer",
+                                                 LTE_FDD_ENB_MSGQ_OVERFLOW_DROP_NEWEST,
+                                                 true);
         rlc_to_mac_comm   = new LTE_fdd_enb_msgq("rlc_to_mac");
         rlc_to_pdcp_comm  = new LTE_fdd_enb_msgq("rlc_to_pdcp");
         pdcp_to_rlc_comm  = new LTE_fdd_enb_msgq("pdcp_to_rlc");
         pdcp_to_rrc_comm  = new LTE_fdd_enb_msgq("pdcp_to_rrc");
         rrc_to_pdcp_comm  = new LTE_fdd_enb_msgq("rrc_to_pdcp");
         rrc_to_mme_comm   = new LTE_fdd_enb_msgq("rrc_to_mme");
-        mme_to_rrc_comm   = new LTE_fdd_enb_msgq("mme_to_rrc");
-        pdcp_to_gw_comm   = new LTE_fdd_enb_msgq("pdcp_to_gw");
-        gw_to_pdcp_comm   = new LTE_fdd_enb_msgq("gw_to_pdcp");
+        mme_to_rrc_comm   = new LTE_fdd_enb_msgq("mme_to_rrc",
+                                                 LTE_FDD_ENB_MSGQ_OVERFLOW_DROP_NEWEST,
+                                                 true);
+        pdcp_to_gw_comm   = new LTE_fdd_enb_msgq("pdcp_to_gw",
+                                                 LTE_FDD_ENB_MSGQ_OVERFLOW_DROP_NEWEST,
+                                                 true);
+        gw_to_pdcp_comm   = new LTE_fdd_enb_msgq("gw_to_pdcp",
+                                                 LTE_FDD_ENB_MSGQ_OVERFLOW_DROP_NEWEST,
+                                                 true);
 
         // Construct layers
         pdcp = new LTE_fdd_enb_pdcp();
@@ -1252,6 +1188,7 @@ void LTE_fdd_enb_interface::handle_help(void)
             }
             break;
         case LTE_FDD_ENB_VAR_TYPE_HEX:
+        case LTE_FDD_ENB_VAR_TYPE_STRING:
             s_value.clear();
             cnfg_db->get_param((*iter).second.param, s_value);
             tmp_str += s_value;
@@ -1415,6 +1352,13 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::write_value(LTE_FDD_ENB_VAR_STRUCT
                value <= var->int64_u_bound)
             {
                 err = cnfg_db->set_param(var->param, value);
+                if(LTE_FDD_ENB_PARAM_ENABLE_PCAP      == var->param ||
+                   LTE_FDD_ENB_PARAM_PCAP_SNAPLEN     == var->param ||
+                   LTE_FDD_ENB_PARAM_PCAP_ROTATE_SIZE == var->param ||
+                   LTE_FDD_ENB_PARAM_PCAP_ROTATE_TIME == var->param)
+                {
+                    update_pcap_cnfg();
+                }
             }
         }else{
             if(LTE_FDD_ENB_PARAM_N_ANT == var->param &&
@@ -1494,6 +1438,29 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::write_value(LTE_FDD_ENB_VAR_STRUCT
                   LTE_FDD_ENB_PARAM_DNS_ADDR      == var->param) &&
                  value.length()                   == 8){
             err = cnfg_db->set_param(var->param, value);
+        }else if(LTE_FDD_ENB_PARAM_FFTW_WISDOM_FILE == var->param){
+            err = cnfg_db->set_param(var->param, value);
+        }else if(LTE_FDD_ENB_PARAM_DEBUG_FILE == var->param){
+            err = debug_log->set_file(value);
+            if(LTE_FDD_ENB_ERROR_NONE == err)
+            {
+                err = cnfg_db->set_param(var->param, value);
+            }
+            update_debug_mask();
+        }else if(LTE_FDD_ENB_PARAM_PCAP_FORMAT == var->param){
+            for(i=0; i<LTE_FDD_ENB_PCAP_FORMAT_N_ITEMS; i++)
+            {
+                if(value == LTE_fdd_enb_pcap_format_text[i])
+                {
+                    err = cnfg_db->set_param(var->param, value);
+                    update_pcap_cnfg();
+                    break;
+                }
+            }
+            if(LTE_FDD_ENB_PCAP_FORMAT_N_ITEMS == i)
+            {
+                err = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+            }
         }else{
             err = LTE_FDD_ENB_ERROR_INVALID_PARAM;
         }
@@ -1525,3 +1492,49 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::write_value(LTE_FDD_ENB_VAR_STRUCT
 
     return(err);
 }
+void LTE_fdd_enb_interface::update_debug_mask(void)
+{
+    libtools_scoped_lock lock(debug_connect_mutex);
+    uint64               mask = 0;
+
+    // Messages are only formatted when there is somewhere to send them
+    if(NULL != debug_log &&
+       (debug_connected ||
+        debug_log->is_file_open()))
+    {
+        mask = ((uint64)debug_level_mask << 32) | debug_type_mask;
+    }
+    __atomic_store_n(&debug_mask, mask, __ATOMIC_RELAXED);
+}
+void LTE_fdd_enb_interface::update_pcap_cnfg(void)
+{
+    LTE_fdd_enb_cnfg_db          *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
+    LTE_FDD_ENB_PCAP_FORMAT_ENUM  format  = LTE_FDD_ENB_PCAP_FORMAT_PCAP;
+    std::string                   format_str;
+    int64                         enable_pcap;
+    int64                         snaplen;
+    int64                         rotate_size;
+    int64                         rotate_time;
+    uint32                        i;
+
+    cnfg_db->get_param(LTE_FDD_ENB_PARAM_ENABLE_PCAP, enable_pcap);
+    cnfg_db->get_param(LTE_FDD_ENB_PARAM_PCAP_FORMAT, format_str);
+    cnfg_db->get_param(LTE_FDD_ENB_PARAM_PCAP_SNAPLEN, snaplen);
+    cnfg_db->get_param(LTE_FDD_ENB_PARAM_PCAP_ROTATE_SIZE, rotate_size);
+    cnfg_db->get_param(LTE_FDD_ENB_PARAM_PCAP_ROTATE_TIME, rotate_time);
+    for(i=0; i<LTE_FDD_ENB_PCAP_FORMAT_N_ITEMS; i++)
+    {
+        if(format_str == LTE_fdd_enb_pcap_format_text[i])
+        {
+            format = (LTE_FDD_ENB_PCAP_FORMAT_ENUM)i;
+        }
+    }
+
+    // Rotation size is configured in megabytes
+    if(NULL != lte_pcap &&
+       NULL != ip_pcap)
+    {
+        lte_pcap->set_cnfg(enable_pcap, format, snaplen, rotate_size*1024*1024, rotate_time);
+        ip_pcap->set_cnfg(enable_pcap, format, snaplen, rotate_size*1024*1024, rotate_time);
+    }
+}
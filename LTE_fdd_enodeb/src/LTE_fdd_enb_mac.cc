@@ -168,6 +168,7 @@ void LTE_fdd_enb_mac::start(LTE_fdd_enb_msgq      *from_phy,
     LTE_fdd_enb_msgq_cb   rlc_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_mac, &LTE_fdd_enb_mac::handle_rlc_msg>, this);
     libtools_ipc_msgq_cb  ue_cb(&libtools_ipc_msgq_cb_wrapper<LTE_fdd_enb_mac, &LTE_fdd_enb_mac::handle_ue_msg>, this);
     LTE_fdd_enb_cnfg_db  *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
+    LTE_fdd_enb_phy      *phy     = LTE_fdd_enb_phy::get_instance();
     uint32                i;
 
     if(!started)
@@ -193,24 +194,27 @@ void LTE_fdd_enb_mac::start(LTE_fdd_enb_msgq      *from_phy,
         cnfg_db->get_sys_info(sys_info);
         for(i=0; i<10; i++)
         {
-            sched_dl_subfr[i].dl_allocations.N_alloc = 0;
-            sched_dl_subfr[i].ul_allocations.N_alloc = 0;
-            sched_dl_subfr[i].N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(i);
-            sched_dl_subfr[i].N_sched_prbs           = 0;
-            sched_dl_subfr[i].current_tti            = i;
-
-            sched_ul_subfr[i].decodes.N_alloc = 0;
-            sched_ul_subfr[i].N_avail_prbs    = sys_info.N_rb_ul;
-            sched_ul_subfr[i].N_sched_prbs    = 0;
-            sched_ul_subfr[i].current_tti     = i;
-            sched_ul_subfr[i].N_pucch         = 0;
-            sched_ul_subfr[i].next_prb        = 0;
+            sched_dl_subfr[i] = phy->get_dl_sched_buf();
+            sched_ul_subfr[i] = phy->get_ul_sched_buf();
+
+            sched_dl_subfr[i]->dl_allocations.N_alloc = 0;
+            sched_dl_subfr[i]->ul_allocations.N_alloc = 0;
+            sched_dl_subfr[i]->N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(i);
+            sched_dl_subfr[i]->N_sched_prbs           = 0;
+            sched_dl_subfr[i]->current_tti            = i;
+
+            sched_ul_subfr[i]->decodes.N_alloc = 0;
+            sched_ul_subfr[i]->N_avail_prbs    = sys_info.N_rb_ul;
+            sched_ul_subfr[i]->N_sched_prbs    = 0;
+            sched_ul_subfr[i]->current_tti     = i;
+            sched_ul_subfr[i]->N_pucch         = 0;
+            sched_ul_subfr[i]->next_prb        = 0;
         }
-        sched_dl_subfr[0].current_tti = 10;
-        sched_dl_subfr[1].current_tti = 11;
-        sched_dl_subfr[2].current_tti = 12;
-        sched_cur_dl_subfn            = 3;
-        sched_cur_ul_subfn            = 0;
+        sched_dl_subfr[0]->current_tti = 10;
+        sched_dl_subfr[1]->current_tti = 11;
+        sched_dl_subfr[2]->current_tti = 12;
+        sched_cur_dl_subfn             = 3;
+        sched_cur_ul_subfn             = 0;
     }
 }
 void LTE_fdd_enb_mac::stop(void)
@@ -251,12 +255,11 @@ void LTE_fdd_enb_mac::handle_phy_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_pusch_decode(&msg.msg.pusch_decode);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid PHY message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "Received invalid PHY message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
@@ -275,12 +278,11 @@ void LTE_fdd_enb_mac::handle_rlc_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_sdu_ready(&msg.msg.mac_sdu_ready);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid RLC message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "Received invalid RLC message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
@@ -300,24 +302,23 @@ void LTE_fdd_enb_mac::handle_ue_msg(LIBTOOLS_IPC_MSGQ_MESSAGE_STRUCT *msg)
         break;
     case LIBTOOLS_IPC_MSGQ_MESSAGE_TYPE_RACH:
         prach_decode.num_preambles = 1;
-        prach_decode.current_tti   = sched_ul_subfr[sched_cur_ul_subfn].current_tti;
+        prach_decode.current_tti   = sched_ul_subfr[sched_cur_ul_subfn]->current_tti;
         prach_decode.timing_adv[0] = 0;
         prach_decode.preamble[0]   = msg->msg.rach.preamble;
         handle_prach_decode(&prach_decode);
         break;
     case LIBTOOLS_IPC_MSGQ_MESSAGE_TYPE_MAC_PDU:
         memcpy(&pusch_decode.msg, &msg->msg.mac_pdu_msg.msg, sizeof(pusch_decode.msg));
-        pusch_decode.current_tti = sched_ul_subfr[sched_cur_ul_subfn].current_tti;
+        pusch_decode.current_tti = sched_ul_subfr[sched_cur_ul_subfn]->current_tti;
         pusch_decode.rnti        = msg->msg.mac_pdu_msg.rnti;
         handle_pusch_decode(&pusch_decode);
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received invalid UE message %s",
-                                  libtools_ipc_msgq_message_type_text[msg->type]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          "Received invalid UE message %s",
+                          libtools_ipc_msgq_message_type_text[msg->type]);
         break;
     }
 }
@@ -375,12 +376,14 @@ void LTE_fdd_enb_mac::remove_periodic_sr_pucch(uint16 rnti)
 /**********************/
 void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT *rts)
 {
-    LTE_fdd_enb_phy                   *phy = LTE_fdd_enb_phy::get_instance();
-    LTE_FDD_ENB_TIMER_TICK_MSG_STRUCT  timer_tick;
-    uint32                             i;
-    uint32                             dl_tti;
-    uint32                             ul_tti;
-    int32                              num_subfrs_to_skip;
+    LTE_fdd_enb_phy                    *phy = LTE_fdd_enb_phy::get_instance();
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched;
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched;
+    LTE_FDD_ENB_TIMER_TICK_MSG_STRUCT   timer_tick;
+    uint32                              i;
+    uint32                              dl_tti;
+    uint32                              ul_tti;
+    int32                               num_subfrs_to_skip;
 
     // Send tick to timer manager
     msgq_to_timer->send(LTE_FDD_ENB_MESSAGE_TYPE_TIMER_TICK,
@@ -389,9 +392,9 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
                         sizeof(LTE_FDD_ENB_TIMER_TICK_MSG_STRUCT));
 
     phy->get_current_ttis(&dl_tti, &ul_tti);
-    if(2 != ((int32)(sched_dl_subfr[sched_cur_dl_subfn].current_tti) - (int32)(dl_tti)))
+    if(2 != ((int32)(sched_dl_subfr[sched_cur_dl_subfn]->current_tti) - (int32)(dl_tti)))
     {
-        num_subfrs_to_skip = (int32)(sched_dl_subfr[sched_cur_dl_subfn].current_tti) - (int32)(dl_tti);
+        num_subfrs_to_skip = (int32)(sched_dl_subfr[sched_cur_dl_subfn]->current_tti) - (int32)(dl_tti);
         if(1000 < fabs(num_subfrs_to_skip))
         {
             num_subfrs_to_skip = 0;
@@ -401,55 +404,74 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
         }else{
             num_subfrs_to_skip = 0;
         }
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "MAC_dl_tti - PHY_dl_tti != 2 (%d), skipping %d subframes",
-                                  (int32)(sched_dl_subfr[sched_cur_dl_subfn].current_tti) - (int32)(dl_tti),
-                                  num_subfrs_to_skip);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          "MAC_dl_tti - PHY_dl_tti != 2 (%d), skipping %d subframes",
+                          (int32)(sched_dl_subfr[sched_cur_dl_subfn]->current_tti) - (int32)(dl_tti),
+                          num_subfrs_to_skip);
         sem_wait(&sys_info_sem);
         for(i=0; i<num_subfrs_to_skip; i++)
         {
             // Advance the frame number combination
-            sched_dl_subfr[sched_cur_dl_subfn].current_tti = add_to_tti(sched_dl_subfr[sched_cur_dl_subfn].current_tti, 10);
-            sched_ul_subfr[sched_cur_ul_subfn].current_tti = add_to_tti(sched_ul_subfr[sched_cur_ul_subfn].current_tti, 10);
+            sched_dl_subfr[sched_cur_dl_subfn]->current_tti = add_to_tti(sched_dl_subfr[sched_cur_dl_subfn]->current_tti, 10);
+            sched_ul_subfr[sched_cur_ul_subfn]->current_tti = add_to_tti(sched_ul_subfr[sched_cur_ul_subfn]->current_tti, 10);
 
             // Clear the subframes
-            sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc = 0;
-            sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc = 0;
-            sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(sched_dl_subfr[sched_cur_dl_subfn].current_tti);
-            sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs           = 0;
-            sched_ul_subfr[sched_cur_ul_subfn].decodes.N_alloc        = 0;
-            sched_ul_subfr[sched_cur_ul_subfn].N_sched_prbs           = 0;
-            sched_ul_subfr[sched_cur_ul_subfn].N_pucch                = 0;
-            sched_ul_subfr[sched_cur_ul_subfn].next_prb               = 0;
+            sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc = 0;
+            sched_dl_subfr[sched_cur_dl_subfn]->ul_allocations.N_alloc = 0;
+            sched_dl_subfr[sched_cur_dl_subfn]->N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(sched_dl_subfr[sched_cur_dl_subfn]->current_tti);
+            sched_dl_subfr[sched_cur_dl_subfn]->N_sched_prbs           = 0;
+            sched_ul_subfr[sched_cur_ul_subfn]->decodes.N_alloc        = 0;
+            sched_ul_subfr[sched_cur_ul_subfn]->N_sched_prbs           = 0;
+            sched_ul_subfr[sched_cur_ul_subfn]->N_pucch                = 0;
+            sched_ul_subfr[sched_cur_ul_subfn]->next_prb               = 0;
 
             // Advance the subframe numbers
             sched_cur_dl_subfn = (sched_cur_dl_subfn + 1) % 10;
             sched_cur_ul_subfn = (sched_cur_ul_subfn + 1) % 10;
         }
         sem_post(&sys_info_sem);
-    }else if(rts->dl_current_tti == sched_dl_subfr[sched_cur_dl_subfn].current_tti &&
-             rts->ul_current_tti == sched_ul_subfr[sched_cur_ul_subfn].current_tti){
-        msgq_to_phy->send(LTE_FDD_ENB_MESSAGE_TYPE_PHY_SCHEDULE,
-                          &sched_dl_subfr[sched_cur_dl_subfn],
-                          &sched_ul_subfr[sched_cur_ul_subfn]);
+    }else if(rts->dl_current_tti == sched_dl_subfr[sched_cur_dl_subfn]->current_tti &&
+             rts->ul_current_tti == sched_ul_subfr[sched_cur_ul_subfn]->current_tti){
+        // Hand the schedules to the PHY and continue in fresh buffers
+        dl_sched = phy->get_dl_sched_buf();
+        ul_sched = phy->get_ul_sched_buf();
+        if(NULL != dl_sched &&
+           NULL != ul_sched &&
+           msgq_to_phy->send(LTE_FDD_ENB_MESSAGE_TYPE_PHY_SCHEDULE,
+                             sched_dl_subfr[sched_cur_dl_subfn],
+                             sched_ul_subfr[sched_cur_ul_subfn]))
+        {
+            dl_sched->current_tti              = sched_dl_subfr[sched_cur_dl_subfn]->current_tti;
+            ul_sched->current_tti              = sched_ul_subfr[sched_cur_ul_subfn]->current_tti;
+            ul_sched->N_avail_prbs             = sched_ul_subfr[sched_cur_ul_subfn]->N_avail_prbs;
+            sched_dl_subfr[sched_cur_dl_subfn] = dl_sched;
+            sched_ul_subfr[sched_cur_ul_subfn] = ul_sched;
+        }else{
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "No free schedule buffers or mac_to_phy full, dropping DL_TTI=%u UL_TTI=%u",
+                              sched_dl_subfr[sched_cur_dl_subfn]->current_tti,
+                              sched_ul_subfr[sched_cur_ul_subfn]->current_tti);
+            phy->free_sched_bufs(dl_sched, ul_sched);
+        }
 
         // Advance the frame number combination
-        sched_dl_subfr[sched_cur_dl_subfn].current_tti = add_to_tti(sched_dl_subfr[sched_cur_dl_subfn].current_tti, 10);
-        sched_ul_subfr[sched_cur_ul_subfn].current_tti = add_to_tti(sched_ul_subfr[sched_cur_ul_subfn].current_tti, 10);
+        sched_dl_subfr[sched_cur_dl_subfn]->current_tti = add_to_tti(sched_dl_subfr[sched_cur_dl_subfn]->current_tti, 10);
+        sched_ul_subfr[sched_cur_ul_subfn]->current_tti = add_to_tti(sched_ul_subfr[sched_cur_ul_subfn]->current_tti, 10);
 
         // Clear the subframes
         sem_wait(&sys_info_sem);
-        sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc = 0;
-        sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc = 0;
-        sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(sched_dl_subfr[sched_cur_dl_subfn].current_tti);
-        sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs           = 0;
-        sched_ul_subfr[sched_cur_ul_subfn].decodes.N_alloc        = 0;
-        sched_ul_subfr[sched_cur_ul_subfn].N_sched_prbs           = 0;
-        sched_ul_subfr[sched_cur_ul_subfn].N_pucch                = 0;
-        sched_ul_subfr[sched_cur_ul_subfn].next_prb               = 0;
+        sched_dl_subfr[sched_cur_dl_subfn]->dl_allocations.N_alloc = 0;
+        sched_dl_subfr[sched_cur_dl_subfn]->ul_allocations.N_alloc = 0;
+        sched_dl_subfr[sched_cur_dl_subfn]->N_avail_prbs           = sys_info.N_rb_dl - get_n_reserved_prbs(sched_dl_subfr[sched_cur_dl_subfn]->current_tti);
+        sched_dl_subfr[sched_cur_dl_subfn]->N_sched_prbs           = 0;
+        sched_ul_subfr[sched_cur_ul_subfn]->decodes.N_alloc        = 0;
+        sched_ul_subfr[sched_cur_ul_subfn]->N_sched_prbs           = 0;
+        sched_ul_subfr[sched_cur_ul_subfn]->N_pucch                = 0;
+        sched_ul_subfr[sched_cur_ul_subfn]->next_prb               = 0;
         sem_post(&sys_info_sem);
 
         // Advance the subframe numbers
@@ -458,15 +480,14 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
 
         scheduler();
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "RTS issue DL %u:%u, UL %u:%u",
-                                  sched_dl_subfr[sched_cur_dl_subfn].current_tti,
-                                  dl_tti,
-                                  sched_ul_subfr[sched_cur_ul_subfn].current_tti,
-                                  ul_tti);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          "RTS issue DL %u:%u, UL %u:%u",
+                          sched_dl_subfr[sched_cur_dl_subfn]->current_tti,
+                          dl_tti,
+                          sched_ul_subfr[sched_cur_ul_subfn]->current_tti,
+                          ul_tti);
     }
 }
 void LTE_fdd_enb_mac::handle_prach_decode(LTE_FDD_ENB_PRACH_DECODE_MSG_STRUCT *prach_decode)
@@ -499,13 +520,12 @@ void LTE_fdd_enb_mac::handle_pucch_decode(LTE_FDD_ENB_PUCCH_DECODE_MSG_STRUCT *p
                             &pucch_decode->msg);
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to find PUCCH user RNTI=%u TTI=%u",
-                                  pucch_decode->rnti,
-                                  pucch_decode->current_tti);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          "Failed to find PUCCH user RNTI=%u TTI=%u",
+                          pucch_decode->rnti,
+                          pucch_decode->current_tti);
     }
 }
 void LTE_fdd_enb_mac::handle_pucch_ack_nack(LTE_fdd_enb_user      *user,
@@ -515,24 +535,22 @@ void LTE_fdd_enb_mac::handle_pucch_ack_nack(LTE_fdd_enb_user      *user,
     LIBLTE_MAC_PDU_STRUCT        mac_pdu;
     LIBLTE_PHY_ALLOCATION_STRUCT alloc;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                              __FILE__,
-                              __LINE__,
-                              "PUCCH ACK/NACK received for %u RNTI=%u",
-                              current_tti,
-                              user->get_c_rnti());
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                      "PUCCH ACK/NACK received for %u RNTI=%u",
+                      current_tti,
+                      user->get_c_rnti());
 
     if(msg->msg[0])
     {
         user->clear_harq_info(current_tti);
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Clearing HARQ info RNTI=%u TTI=%u",
-                                  user->get_c_rnti(),
-                                  current_tti);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          "Clearing HARQ info RNTI=%u TTI=%u",
+                          user->get_c_rnti(),
+                          current_tti);
     }else{
         if(LTE_FDD_ENB_ERROR_NONE == user->get_harq_info(current_tti,
                                                          &mac_pdu,
@@ -540,47 +558,43 @@ void LTE_fdd_enb_mac::handle_pucch_ack_nack(LTE_fdd_enb_user      *user,
         {
             if(LTE_FDD_ENB_MAX_HARQ_RETX <= alloc.harq_retx_count)
             {
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                          __FILE__,
-                                          __LINE__,
-                                          "Not resending HARQ due to max retx RNTI=%u TTI=%u",
-                                          user->get_c_rnti(),
-                                          current_tti);
+                LTE_FDD_ENB_DEBUG(interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  "Not resending HARQ due to max retx RNTI=%u TTI=%u",
+                                  user->get_c_rnti(),
+                                  current_tti);
             }else{
                 alloc.harq_retx_count++;
                 alloc.ndi = user->get_dl_ndi();
-                if(LTE_FDD_ENB_ERROR_NONE == add_to_dl_sched_queue(add_to_tti(sched_dl_subfr[sched_cur_dl_subfn].current_tti,
+                if(LTE_FDD_ENB_ERROR_NONE == add_to_dl_sched_queue(add_to_tti(sched_dl_subfr[sched_cur_dl_subfn]->current_tti,
                                                                               4),
                                                                    &mac_pdu,
                                                                    &alloc))
                 {
-                    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                              __FILE__,
-                                              __LINE__,
-                                              "Resending HARQ info RNTI=%u TTI=%u (%u)",
-                                              user->get_c_rnti(),
-                                              current_tti,
-                                              alloc.harq_retx_count);
+                    LTE_FDD_ENB_DEBUG(interface,
+                                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      "Resending HARQ info RNTI=%u TTI=%u (%u)",
+                                      user->get_c_rnti(),
+                                      current_tti,
+                                      alloc.harq_retx_count);
                 }else{
-                    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                              __FILE__,
-                                              __LINE__,
-                                              "Failed to resend HARQ info RNTI=%u TTI=%u",
-                                              user->get_c_rnti(),
-                                              current_tti);
-                }
-            }
-        }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                    LTE_FDD_ENB_DEBUG(interface,
+                                      LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                       LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Failed to find HARQ info RNTI=%u TTI=%u",
+                                      "Failed to resend HARQ info RNTI=%u TTI=%u",
                                       user->get_c_rnti(),
                                       current_tti);
+                }
+            }
+        }else{
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "Failed to find HARQ info RNTI=%u TTI=%u",
+                              user->get_c_rnti(),
+                              current_tti);
         }
     }
 }
@@ -590,13 +604,12 @@ void LTE_fdd_enb_mac::handle_pucch_sr(LTE_fdd_enb_user      *user,
 {
     if(msg->msg[0])
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "PUCCH SR received for %u RNTI=%u",
-                                  current_tti,
-                                  user->get_c_rnti());
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          "PUCCH SR received for %u RNTI=%u",
+                          current_tti,
+                          user->get_c_rnti());
 
         // Schedule a grant big enough to at least hold long BSR
         sched_ul(user, BSR_GRANT_SIZE_BYTES*8);
@@ -618,14 +631,13 @@ void LTE_fdd_enb_mac::handle_pusch_decode(LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT *p
         // Reset the inactivity timer
         user->reset_inactivity_timer(LTE_FDD_ENB_USER_INACTIVITY_TIMER_VALUE_MS);
 
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  &pusch_decode->msg,
-                                  "PUSCH decode for RNTI=%u CURRENT_TTI=%u",
-                                  pusch_decode->rnti,
-                                  pusch_decode->current_tti);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          &pusch_decode->msg,
+                          "PUSCH decode for RNTI=%u CURRENT_TTI=%u",
+                          pusch_decode->rnti,
+                          pusch_decode->current_tti);
         interface->send_lte_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_UL,
                                      pusch_decode->rnti,
                                      pusch_decode->current_tti,
@@ -663,13 +675,12 @@ void LTE_fdd_enb_mac::handle_pusch_decode(LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT *p
             }
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  &pusch_decode->msg,
-                                  "PUSCH decode for invalid RNTI (%u)",
-                                  pusch_decode->rnti);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          &pusch_decode->msg,
+                          "PUSCH decode for invalid RNTI (%u)",
+                          pusch_decode->rnti);
     }
 }
 
@@ -687,14 +698,13 @@ void LTE_fdd_enb_mac::handle_sdu_ready(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT *sdu
     {
         user = sdu_ready->user;
 
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  sdu,
-                                  "Received SDU for RNTI=%u and RB=%s",
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          sdu,
+                          "Received SDU for RNTI=%u and RB=%s",
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
 
         // Fill in the allocation
         alloc.pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
@@ -733,35 +743,32 @@ void LTE_fdd_enb_mac::handle_sdu_ready(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT *sdu
         }
 
         // Add the PDU to the scheduling queue
-        if(LTE_FDD_ENB_ERROR_NONE != add_to_dl_sched_queue(add_to_tti(sched_dl_subfr[sched_cur_dl_subfn].current_tti,
+        if(LTE_FDD_ENB_ERROR_NONE != add_to_dl_sched_queue(add_to_tti(sched_dl_subfr[sched_cur_dl_subfn]->current_tti,
                                                                       4),
                                                            &mac_pdu,
                                                            &alloc))
         {
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Can't schedule PDU");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "Can't schedule PDU");
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      &alloc.msg[0],
-                                      "PDU scheduled for RNTI=%u, DL_QUEUE_SIZE=%u",
-                                      alloc.rnti,
-                                      dl_sched_queue.size());
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              &alloc.msg[0],
+                              "PDU scheduled for RNTI=%u, DL_QUEUE_SIZE=%u",
+                              alloc.rnti,
+                              dl_sched_queue.size());
         }
 
         // Delete the SDU
         sdu_ready->rb->delete_next_mac_sdu();
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received sdu_ready message with no SDU queued");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          "Received sdu_ready message with no SDU queued");
     }
 }
 
@@ -779,14 +786,13 @@ void LTE_fdd_enb_mac::handle_ulsch_ccch_sdu(LTE_fdd_enb_user       *user,
 
     if(LIBLTE_MAC_ULSCH_CCCH_LCID == lcid)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  sdu,
-                                  "Handling ULSCH SDU for RNTI=%u, LCID=%u",
-                                  user->get_c_rnti(),
-                                  lcid);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          sdu,
+                          "Handling ULSCH SDU for RNTI=%u, LCID=%u",
+                          user->get_c_rnti(),
+                          lcid);
 
         // Get SRB0
         user->get_srb0(&rb);
@@ -818,14 +824,13 @@ void LTE_fdd_enb_mac::handle_ulsch_ccch_sdu(LTE_fdd_enb_user       *user,
         // Schedule uplink
         sched_ul(user, user->get_ul_buffer_size()*8);
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  sdu,
-                                  "Not handling ULSCH SDU for RNTI=%u, LCID=%u",
-                                  user->get_c_rnti(),
-                                  lcid);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          sdu,
+                          "Not handling ULSCH SDU for RNTI=%u, LCID=%u",
+                          user->get_c_rnti(),
+                          lcid);
     }
 }
 void LTE_fdd_enb_mac::handle_ulsch_dcch_sdu(LTE_fdd_enb_user       *user,
@@ -838,14 +843,13 @@ void LTE_fdd_enb_mac::handle_ulsch_dcch_sdu(LTE_fdd_enb_user       *user,
     if(LIBLTE_MAC_ULSCH_DCCH_LCID_BEGIN <= lcid &&
        LIBLTE_MAC_ULSCH_DCCH_LCID_END   >= lcid)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  sdu,
-                                  "Handling ULSCH DCCH_SDU for RNTI=%u, LCID=%u",
-                                  user->get_c_rnti(),
-                                  lcid);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          sdu,
+                          "Handling ULSCH DCCH_SDU for RNTI=%u, LCID=%u",
+                          user->get_c_rnti(),
+                          lcid);
 
         // Get RB
         if(LTE_FDD_ENB_RB_SRB1 == lcid)
@@ -854,13 +858,12 @@ void LTE_fdd_enb_mac::handle_ulsch_dcch_sdu(LTE_fdd_enb_user       *user,
         }else if(LTE_FDD_ENB_RB_SRB2 == lcid){
             user->get_srb2(&rb);
         }else if(LTE_FDD_ENB_ERROR_NONE != user->get_drb((LTE_FDD_ENB_RB_ENUM)lcid, &rb)){
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling ULSCH DCCH_SDU for RNTI=%u, LCID=%u",
-                                      user->get_c_rnti(),
-                                      lcid);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "Not handling ULSCH DCCH_SDU for RNTI=%u, LCID=%u",
+                              user->get_c_rnti(),
+                              lcid);
         }
 
         // Queue the SDU for RLC
@@ -883,33 +886,30 @@ void LTE_fdd_enb_mac::handle_ulsch_dcch_sdu(LTE_fdd_enb_user       *user,
         // Schedule uplink
         sched_ul(user, user->get_ul_buffer_size()*8);
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  sdu,
-                                  "Not handling ULSCH SDU for RNTI=%u, LCID=%u",
-                                  user->get_c_rnti(),
-                                  lcid);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          sdu,
+                          "Not handling ULSCH SDU for RNTI=%u, LCID=%u",
+                          user->get_c_rnti(),
+                          lcid);
     }
 }
 void LTE_fdd_enb_mac::handle_ulsch_ext_power_headroom_report(LTE_fdd_enb_user                        *user,
                                                              LIBLTE_MAC_EXT_POWER_HEADROOM_CE_STRUCT *ext_power_headroom)
 {
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                              __FILE__,
-                              __LINE__,
-                              "Not handling ULSCH EXTENDED_POWER_HEADROOM_REPORT");
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                      "Not handling ULSCH EXTENDED_POWER_HEADROOM_REPORT");
 }
 void LTE_fdd_enb_mac::handle_ulsch_power_headroom_report(LTE_fdd_enb_user                    *user,
                                                          LIBLTE_MAC_POWER_HEADROOM_CE_STRUCT *power_headroom)
 {
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                              __FILE__,
-                              __LINE__,
-                              "Not handling ULSCH POWER_HEADROOM_REPORT");
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                      "Not handling ULSCH POWER_HEADROOM_REPORT");
 }
 void LTE_fdd_enb_mac::handle_ulsch_c_rnti(LTE_fdd_enb_user            **user,
                                           LIBLTE_MAC_C_RNTI_CE_STRUCT  *c_rnti)
@@ -917,13 +917,12 @@ void LTE_fdd_enb_mac::handle_ulsch_c_rnti(LTE_fdd_enb_user            **user,
     LTE_fdd_enb_user_mgr *user_mgr   = LTE_fdd_enb_user_mgr::get_instance();
     uint16                old_c_rnti = (*user)->get_c_rnti();
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                              __FILE__,
-                              __LINE__,
-                              "Received C_RNTI=%u for C_RNTI=%u",
-                              c_rnti->c_rnti,
-                              (*user)->get_c_rnti());
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                      "Received C_RNTI=%u for C_RNTI=%u",
+                      c_rnti->c_rnti,
+                      (*user)->get_c_rnti());
 
     if(c_rnti->c_rnti         != (*user)->get_c_rnti() &&
        LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(c_rnti->c_rnti, user))
@@ -934,15 +933,14 @@ void LTE_fdd_enb_mac::handle_ulsch_c_rnti(LTE_fdd_enb_user            **user,
 void LTE_fdd_enb_mac::handle_ulsch_truncated_bsr(LTE_fdd_enb_user                   *user,
                                                  LIBLTE_MAC_TRUNCATED_BSR_CE_STRUCT *truncated_bsr)
 {
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                              __FILE__,
-                              __LINE__,
-                              "Received truncated BSR for LCG_ID=%u (%u < Buffer Size <= %u), C_RNTI=%u",
-                              truncated_bsr->lcg_id,
-                              truncated_bsr->min_buffer_size,
-                              truncated_bsr->max_buffer_size,
-                              user->get_c_rnti());
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                      "Received truncated BSR for LCG_ID=%u (%u < Buffer Size <= %u), C_RNTI=%u",
+                      truncated_bsr->lcg_id,
+                      truncated_bsr->min_buffer_size,
+                      truncated_bsr->max_buffer_size,
+                      user->get_c_rnti());
 
     user->set_ul_buffer_size(truncated_bsr->max_buffer_size);
 
@@ -951,15 +949,14 @@ void LTE_fdd_enb_mac::handle_ulsch_truncated_bsr(LTE_fdd_enb_user
 void LTE_fdd_enb_mac::handle_ulsch_short_bsr(LTE_fdd_enb_user               *user,
                                              LIBLTE_MAC_SHORT_BSR_CE_STRUCT *short_bsr)
 {
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                              __FILE__,
-                              __LINE__,
-                              "Received short BSR for LCG_ID=%u (%u < Buffer Size <= %u), C_RNTI=%u",
-                              short_bsr->lcg_id,
-                              short_bsr->min_buffer_size,
-                              short_bsr->max_buffer_size,
-                              user->get_c_rnti());
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                      "Received short BSR for LCG_ID=%u (%u < Buffer Size <= %u), C_RNTI=%u",
+                      short_bsr->lcg_id,
+                      short_bsr->min_buffer_size,
+                      short_bsr->max_buffer_size,
+                      user->get_c_rnti());
 
     user->set_ul_buffer_size(short_bsr->max_buffer_size);
 
@@ -968,20 +965,19 @@ void LTE_fdd_enb_mac::handle_ulsch_short_bsr(LTE_fdd_enb_user               *use
 void LTE_fdd_enb_mac::handle_ulsch_long_bsr(LTE_fdd_enb_user              *user,
                                             LIBLTE_MAC_LONG_BSR_CE_STRUCT *long_bsr)
 {
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                              __FILE__,
-                              __LINE__,
-                              "Received long BSR (%u < Buffer Size 0 <= %u), (%u < Buffer Size 1 <= %u), (%u < Buffer Size 2 <= %u), (%u < Buffer Size 3 <= %u), C_RNTI=%u",
-                              long_bsr->min_buffer_size_0,
-                              long_bsr->max_buffer_size_0,
-                              long_bsr->min_buffer_size_1,
-                              long_bsr->max_buffer_size_1,
-                              long_bsr->min_buffer_size_2,
-                              long_bsr->max_buffer_size_2,
-                              long_bsr->min_buffer_size_3,
-                              long_bsr->max_buffer_size_3,
-                              user->get_c_rnti());
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                      "Received long BSR (%u < Buffer Size 0 <= %u), (%u < Buffer Size 1 <= %u), (%u < Buffer Size 2 <= %u), (%u < Buffer Size 3 <= %u), C_RNTI=%u",
+                      long_bsr->min_buffer_size_0,
+                      long_bsr->max_buffer_size_0,
+                      long_bsr->min_buffer_size_1,
+                      long_bsr->max_buffer_size_1,
+                      long_bsr->min_buffer_size_2,
+                      long_bsr->max_buffer_size_2,
+                      long_bsr->min_buffer_size_3,
+                      long_bsr->max_buffer_size_3,
+                      user->get_c_rnti());
 
     user->set_ul_buffer_size(long_bsr->max_buffer_size_0 +
                              long_bsr->max_buffer_size_1 +
@@ -1059,25 +1055,22 @@ void LTE_fdd_enb_mac::construct_random_access_response(uint8  preamble,
                                                             &ul_alloc,
                                                             &rar))
         {
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Can't schedule RAR");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "Can't schedule RAR");
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "RAR scheduled %u",
-                                      rar_sched_queue.size());
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "RAR scheduled %u",
+                              rar_sched_queue.size());
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "No free C-RNTI or add_user fail");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                          "No free C-RNTI or add_user fail");
     }
 }
 
@@ -1124,26 +1117,24 @@ void LTE_fdd_enb_mac::sched_ul(LTE_fdd_enb_user *user,
         }
 
         // Add the allocation to the scheduling queue
-        if(LTE_FDD_ENB_ERROR_NONE != add_to_ul_sched_queue(add_to_tti(sched_ul_subfr[sched_cur_ul_subfn].current_tti,
+        if(LTE_FDD_ENB_ERROR_NONE != add_to_ul_sched_queue(add_to_tti(sched_ul_subfr[sched_cur_ul_subfn]->current_tti,
                                                                       4),
                                                            &alloc))
         {
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Can't schedule UL");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "Can't schedule UL");
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "UL scheduled (mcs=%u, tbs=%u, N_prb=%u) for RNTI=%u, UL_QUEUE_SIZE=%u",
-                                      alloc.mcs,
-                                      alloc.tbs,
-                                      alloc.N_prb,
-                                      alloc.rnti,
-                                      ul_sched_queue.size());
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "UL scheduled (mcs=%u, tbs=%u, N_prb=%u) for RNTI=%u, UL_QUEUE_SIZE=%u",
+                              alloc.mcs,
+                              alloc.tbs,
+                              alloc.N_prb,
+                              alloc.rnti,
+                              ul_sched_queue.size());
         }
     }
 }
@@ -1197,22 +1188,22 @@ void LTE_fdd_enb_mac::scheduler(void)
         // Take into account the SFN wrap
         // FIXME: Test this
         if(resp_win_start                                 <  LIBLTE_PHY_SFN_MAX*10 &&
-           sched_dl_subfr[sched_cur_dl_subfn].current_tti >= LIBLTE_PHY_SFN_MAX*10)
+           sched_dl_subfr[sched_cur_dl_subfn]->current_tti >= LIBLTE_PHY_SFN_MAX*10)
         {
             resp_win_start += LIBLTE_PHY_SFN_MAX*10;
         }
         if(resp_win_stop                                  <  LIBLTE_PHY_SFN_MAX*10 &&
-           sched_dl_subfr[sched_cur_dl_subfn].current_tti >= LIBLTE_PHY_SFN_MAX*10)
+           sched_dl_subfr[sched_cur_dl_subfn]->current_tti >= LIBLTE_PHY_SFN_MAX*10)
         {
             resp_win_stop += LIBLTE_PHY_SFN_MAX*10;
         }
 
         // Check to see if this current_tti falls in the response window
-        if(resp_win_start <= sched_dl_subfr[sched_cur_dl_subfn].current_tti &&
-           resp_win_stop  >= sched_dl_subfr[sched_cur_dl_subfn].current_tti)
+        if(resp_win_start <= sched_dl_subfr[sched_cur_dl_subfn]->current_tti &&
+           resp_win_stop  >= sched_dl_subfr[sched_cur_dl_subfn]->current_tti)
         {
-            dl_subfr = &sched_dl_subfr[sched_cur_dl_subfn];
-            ul_subfr = &sched_ul_subfr[(sched_cur_dl_subfn+6)%10];
+            dl_subfr = sched_dl_subfr[sched_cur_dl_subfn];
+            ul_subfr = sched_ul_subfr[(sched_cur_dl_subfn+6)%10];
 
             // Determine how many PRBs are needed for the DL allocation, if using this subframe
             interface->send_lte_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
@@ -1268,16 +1259,15 @@ void LTE_fdd_enb_mac::scheduler(void)
                 liblte_mac_pack_random_access_response_pdu(&rar_sched->rar,
                                                            &rar_sched->dl_alloc.msg[0]);
 
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                          __FILE__,
-                                          __LINE__,
-                                          &rar_sched->dl_alloc.msg[0],
-                                          "RAR sent %u %u %u %u",
-                                          resp_win_start,
-                                          resp_win_stop,
-                                          dl_subfr->current_tti,
-                                          ul_subfr->current_tti);
+                LTE_FDD_ENB_DEBUG(interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  &rar_sched->dl_alloc.msg[0],
+                                  "RAR sent %u %u %u %u",
+                                  resp_win_start,
+                                  resp_win_stop,
+                                  dl_subfr->current_tti,
+                                  ul_subfr->current_tti);
 
                 if(NULL == msgq_to_ue)
                 {
@@ -1305,15 +1295,14 @@ void LTE_fdd_enb_mac::scheduler(void)
             }else{
                 sched_out_of_headroom = true;
             }
-        }else if(resp_win_stop < sched_dl_subfr[sched_cur_dl_subfn].current_tti){ // Check to see if the response window has passed
+        }else if(resp_win_stop < sched_dl_subfr[sched_cur_dl_subfn]->current_tti){ // Check to see if the response window has passed
             // Response window has passed, remove from queue
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "RAR outside of resp win %u %u",
-                                      resp_win_stop,
-                                      sched_dl_subfr[sched_cur_dl_subfn].current_tti);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "RAR outside of resp win %u %u",
+                              resp_win_stop,
+                              sched_dl_subfr[sched_cur_dl_subfn]->current_tti);
             rar_sched_queue.pop_front();
             delete rar_sched;
         }else{
@@ -1330,9 +1319,9 @@ void LTE_fdd_enb_mac::scheduler(void)
     {
         dl_sched = dl_sched_queue.front();
 
-        if(dl_sched->current_tti >= sched_dl_subfr[sched_cur_dl_subfn].current_tti)
+        if(dl_sched->current_tti >= sched_dl_subfr[sched_cur_dl_subfn]->current_tti)
         {
-            dl_subfr = &sched_dl_subfr[sched_cur_dl_subfn];
+            dl_subfr = sched_dl_subfr[sched_cur_dl_subfn];
 
             // Determine how many PRBs and DCIs are available in this subframe
             N_avail_dl_prbs = dl_subfr->N_avail_prbs - dl_subfr->N_sched_prbs;
@@ -1401,17 +1390,16 @@ void LTE_fdd_enb_mac::scheduler(void)
             if(dl_sched->alloc.N_prb <= N_avail_dl_prbs &&
                1                     <= N_avail_dcis)
             {
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                          __FILE__,
-                                          __LINE__,
-                                          &dl_sched->alloc.msg[0],
-                                          "DL allocation (mcs=%u, tbs=%u, N_prb=%u) sent for RNTI=%u CURRENT_TTI=%u",
-                                          dl_sched->alloc.mcs,
-                                          dl_sched->alloc.tbs,
-                                          dl_sched->alloc.N_prb,
-                                          dl_sched->alloc.rnti,
-                                          dl_subfr->current_tti);
+                LTE_FDD_ENB_DEBUG(interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  &dl_sched->alloc.msg[0],
+                                  "DL allocation (mcs=%u, tbs=%u, N_prb=%u) sent for RNTI=%u CURRENT_TTI=%u",
+                                  dl_sched->alloc.mcs,
+                                  dl_sched->alloc.tbs,
+                                  dl_sched->alloc.N_prb,
+                                  dl_sched->alloc.rnti,
+                                  dl_subfr->current_tti);
 
                 if(NULL == msgq_to_ue)
                 {
@@ -1422,7 +1410,7 @@ void LTE_fdd_enb_mac::scheduler(void)
                     dl_subfr->dl_allocations.N_alloc++;
 
                     // Schedule ACK/NACK PUCCH 4 subframes from now and store the DL allocation for potential H-ARQ retransmission
-                    ul_subfr = &sched_ul_subfr[(sched_cur_dl_subfn+4)%10];
+                    ul_subfr = sched_ul_subfr[(sched_cur_dl_subfn+4)%10];
                     ul_subfr->pucch[ul_subfr->N_pucch].type        = LTE_FDD_ENB_PUCCH_TYPE_ACK_NACK;
                     ul_subfr->pucch[ul_subfr->N_pucch].rnti        = dl_sched->alloc.rnti;
                     ul_subfr->pucch[ul_subfr->N_pucch].n_1_p_pucch = sys_info.sib2.rr_config_common_sib.pucch_cnfg.n1_pucch_an;
@@ -1442,21 +1430,20 @@ void LTE_fdd_enb_mac::scheduler(void)
                 dl_sched_queue.pop_front();
                 delete dl_sched;
             }else{
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                          __FILE__,
-                                          __LINE__,
-                                          "DISCARDING DL MESSAGE %u %u %u %u",
-                                          dl_sched->alloc.N_prb,
-                                          N_avail_dl_prbs,
-                                          1,
-                                          N_avail_dcis);
+                LTE_FDD_ENB_DEBUG(interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  "DISCARDING DL MESSAGE %u %u %u %u",
+                                  dl_sched->alloc.N_prb,
+                                  N_avail_dl_prbs,
+                                  1,
+                                  N_avail_dcis);
 
                 // Remove DL schedule from queue
                 dl_sched_queue.pop_front();
                 delete dl_sched;
             }
-        }else if(dl_sched->current_tti < sched_dl_subfr[sched_cur_dl_subfn].current_tti){
+        }else if(dl_sched->current_tti < sched_dl_subfr[sched_cur_dl_subfn]->current_tti){
             // Remove DL schedule from queue
             dl_sched_queue.pop_front();
             delete dl_sched;
@@ -1473,8 +1460,8 @@ void LTE_fdd_enb_mac::scheduler(void)
           false == sched_out_of_headroom)
     {
         ul_sched = ul_sched_queue.front();
-        dl_subfr = &sched_dl_subfr[sched_cur_dl_subfn];
-        ul_subfr = &sched_ul_subfr[(sched_cur_dl_subfn+4)%10];
+        dl_subfr = sched_dl_subfr[sched_cur_dl_subfn];
+        ul_subfr = sched_ul_subfr[(sched_cur_dl_subfn+4)%10];
 
         // Determine how many PRBs and DCIs are available in this subframe
         N_avail_ul_prbs = ul_subfr->N_avail_prbs - ul_subfr->N_sched_prbs;
@@ -1494,13 +1481,12 @@ void LTE_fdd_enb_mac::scheduler(void)
                 ul_sched->alloc.prb[1][i] = rb_start+i;
             }
 
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "UL allocation sent for RNTI=%u CURRENT_TTI=%u",
-                                      ul_sched->alloc.rnti,
-                                      ul_subfr->current_tti);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                              "UL allocation sent for RNTI=%u CURRENT_TTI=%u",
+                              ul_sched->alloc.rnti,
+                              ul_subfr->current_tti);
 
             if(NULL == msgq_to_ue)
             {
@@ -1533,7 +1519,7 @@ void LTE_fdd_enb_mac::scheduler(void)
 
     // Schedule UL SR for the next subframe
     sem_wait(&ul_sr_sched_queue_sem);
-    ul_subfr = &sched_ul_subfr[sched_cur_ul_subfn];
+    ul_subfr = sched_ul_subfr[sched_cur_ul_subfn];
     for(iter=ul_sr_sched_queue.begin(); iter!=ul_sr_sched_queue.end(); iter++)
     {
         liblte_phy_pucch_map_sr_config_idx((*iter)->i_sr, &sr_periodicity, &N_offset_sr);
@@ -153,12 +153,11 @@ void LTE_fdd_enb_mme::handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
         handle_rrc_cmd_resp(&msg.msg.mme_rrc_cmd_resp);
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received invalid RRC message %s",
-                                  LTE_fdd_enb_message_type_text[msg.type]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "Received invalid RRC message %s",
+                          LTE_fdd_enb_message_type_text[msg.type]);
         break;
     }
 }
@@ -185,14 +184,13 @@ void LTE_fdd_enb_mme::handle_nas_msg(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT *n
 
     if(LTE_FDD_ENB_ERROR_NONE == nas_msg->rb->get_next_mme_nas_msg(&msg))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  msg,
-                                  "Received NAS message for RNTI=%u and RB=%s",
-                                  nas_msg->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[nas_msg->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          msg,
+                          "Received NAS message for RNTI=%u and RB=%s",
+                          nas_msg->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[nas_msg->rb->get_rb_id()]);
 
         // Parse the message
         liblte_mme_parse_msg_header(msg, &pd, &msg_type);
@@ -214,25 +212,22 @@ void LTE_fdd_enb_mme::handle_nas_msg(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT *n
             parse_detach_request(msg, nas_msg->user, nas_msg->rb);
             break;
         case LIBLTE_MME_MSG_TYPE_EMM_STATUS:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling EMM Status");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling EMM Status");
             break;
         case LIBLTE_MME_MSG_TYPE_EXTENDED_SERVICE_REQUEST:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Extended Service Request");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Extended Service Request");
             break;
         case LIBLTE_MME_MSG_TYPE_GUTI_REALLOCATION_COMPLETE:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling GUTI Reallocation Complete");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling GUTI Reallocation Complete");
             break;
         case LIBLTE_MME_MSG_TYPE_IDENTITY_RESPONSE:
             parse_identity_response(msg, nas_msg->user, nas_msg->rb);
@@ -247,120 +242,104 @@ void LTE_fdd_enb_mme::handle_nas_msg(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT *n
             parse_service_request(msg, nas_msg->user, nas_msg->rb);
             break;
         case LIBLTE_MME_MSG_TYPE_TRACKING_AREA_UPDATE_COMPLETE:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Tracking Area Update Complete");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Tracking Area Update Complete");
             break;
         case LIBLTE_MME_MSG_TYPE_TRACKING_AREA_UPDATE_REQUEST:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Tracking Area Update Request");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Tracking Area Update Request");
             break;
         case LIBLTE_MME_MSG_TYPE_UPLINK_NAS_TRANSPORT:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Uplink NAS Transport");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Uplink NAS Transport");
             break;
         case LIBLTE_MME_MSG_TYPE_UPLINK_GENERIC_NAS_TRANSPORT:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Uplink Generic NAS Transport");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Uplink Generic NAS Transport");
             break;
         case LIBLTE_MME_MSG_TYPE_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_ACCEPT:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Activate Dedicated EPS Bearer Context Accept");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Activate Dedicated EPS Bearer Context Accept");
             break;
         case LIBLTE_MME_MSG_TYPE_ACTIVATE_DEDICATED_EPS_BEARER_CONTEXT_REJECT:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Activate Dedicated EPS Bearer Context Reject");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Activate Dedicated EPS Bearer Context Reject");
             break;
         case LIBLTE_MME_MSG_TYPE_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Activate Default EPS Bearer Context Accept");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Activate Default EPS Bearer Context Accept");
             break;
         case LIBLTE_MME_MSG_TYPE_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_REJECT:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Activate Default EPS Bearer Context Reject");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Activate Default EPS Bearer Context Reject");
             break;
         case LIBLTE_MME_MSG_TYPE_BEARER_RESOURCE_ALLOCATION_REQUEST:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Bearer Resource Allocation Request");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Bearer Resource Allocation Request");
             break;
         case LIBLTE_MME_MSG_TYPE_BEARER_RESOURCE_MODIFICATION_REQUEST:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Bearer Resource Modification Request");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Bearer Resource Modification Request");
             break;
         case LIBLTE_MME_MSG_TYPE_DEACTIVATE_EPS_BEARER_CONTEXT_ACCEPT:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Deactivate EPS Bearer Context Accept");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Deactivate EPS Bearer Context Accept");
             break;
         case LIBLTE_MME_MSG_TYPE_ESM_INFORMATION_RESPONSE:
             parse_esm_information_response(msg, nas_msg->user, nas_msg->rb);
             break;
         case LIBLTE_MME_MSG_TYPE_MODIFY_EPS_BEARER_CONTEXT_ACCEPT:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Modify EPS Bearer Context Accept");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Modify EPS Bearer Context Accept");
             break;
         case LIBLTE_MME_MSG_TYPE_MODIFY_EPS_BEARER_CONTEXT_REJECT:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling Modify EPS Bearer Context Reject");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling Modify EPS Bearer Context Reject");
             break;
         case LIBLTE_MME_MSG_TYPE_PDN_CONNECTIVITY_REQUEST:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling PDN Connectivity Request");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling PDN Connectivity Request");
             break;
         case LIBLTE_MME_MSG_TYPE_PDN_DISCONNECT_REQUEST:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling PDN Disconnect Request");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling PDN Disconnect Request");
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Not handling NAS message with MSG_TYPE=%02X",
-                                      msg_type);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Not handling NAS message with MSG_TYPE=%02X",
+                              msg_type);
             break;
         }
 
@@ -383,20 +362,18 @@ void LTE_fdd_enb_mme::handle_nas_msg(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT *n
             detach_sm(nas_msg->user, nas_msg->rb);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "MME in invalid procedure %s",
-                                      LTE_fdd_enb_mme_proc_text[nas_msg->rb->get_mme_procedure()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "MME in invalid procedure %s",
+                              LTE_fdd_enb_mme_proc_text[nas_msg->rb->get_mme_procedure()]);
             break;
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received NAS message with no message queued");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "Received NAS message with no message queued");
     }
 }
 void LTE_fdd_enb_mme::handle_rrc_cmd_resp(LTE_FDD_ENB_MME_RRC_CMD_RESP_MSG_STRUCT *rrc_cmd_resp)
@@ -421,22 +398,20 @@ void LTE_fdd_enb_mme::handle_rrc_cmd_resp(LTE_FDD_ENB_MME_RRC_CMD_RESP_MSG_STRUC
             service_req_sm(rrc_cmd_resp->user, rrc_cmd_resp->rb);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "MME in invalid procedure %s",
-                                      LTE_fdd_enb_mme_proc_text[rrc_cmd_resp->rb->get_mme_procedure()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "MME in invalid procedure %s",
+                              LTE_fdd_enb_mme_proc_text[rrc_cmd_resp->rb->get_mme_procedure()]);
             break;
         }
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received invalid RRC command response %s",
-                                  LTE_fdd_enb_mme_rrc_cmd_resp_text[rrc_cmd_resp->cmd_resp]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "Received invalid RRC command response %s",
+                          LTE_fdd_enb_mme_rrc_cmd_resp_text[rrc_cmd_resp->cmd_resp]);
         break;
     }
 }
@@ -452,13 +427,12 @@ void LTE_fdd_enb_mme::parse_attach_complete(LIBLTE_BYTE_MSG_STRUCT *msg,
     uint8                                 pd;
     uint8                                 msg_type;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received Attach Complete for RNTI=%u and RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received Attach Complete for RNTI=%u and RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_attach_complete_msg(msg, &attach_comp);
@@ -477,12 +451,11 @@ void LTE_fdd_enb_mme::parse_attach_complete(LIBLTE_BYTE_MSG_STRUCT *msg,
         parse_activate_default_eps_bearer_context_accept(&attach_comp.esm_msg, user, rb);
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Not handling NAS message with MSG_TYPE=%02X",
-                                  msg_type);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "Not handling NAS message with MSG_TYPE=%02X",
+                          msg_type);
         break;
     }
 }
@@ -500,13 +473,12 @@ void LTE_fdd_enb_mme::parse_attach_request(LIBLTE_BYTE_MSG_STRUCT  *msg,
     uint8                                 pd;
     uint8                                 msg_type;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received Attach Request for RNTI=%u and RB=%s",
-                              (*user)->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received Attach Request for RNTI=%u and RB=%s",
+                      (*user)->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_attach_request_msg(msg, &attach_req);
@@ -519,12 +491,11 @@ void LTE_fdd_enb_mme::parse_attach_request(LIBLTE_BYTE_MSG_STRUCT  *msg,
         parse_pdn_connectivity_request(&attach_req.esm_msg, (*user), (*rb));
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Not handling NAS message with MSG_TYPE=%02X",
-                                  msg_type);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "Not handling NAS message with MSG_TYPE=%02X",
+                          msg_type);
         break;
     }
 
@@ -574,14 +545,13 @@ void LTE_fdd_enb_mme::parse_attach_request(LIBLTE_BYTE_MSG_STRUCT  *msg,
                 user_mgr->transfer_c_rnti(*user, act_user);
                 *user = act_user;
             }
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "IMSI=%015llu is associated with RNTI=%u, RB=%s",
-                                      (*user)->get_id()->imsi,
-                                      (*user)->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "IMSI=%015llu is associated with RNTI=%u, RB=%s",
+                              (*user)->get_id()->imsi,
+                              (*user)->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
             (*rb)->set_mme_state(LTE_FDD_ENB_MME_STATE_AUTHENTICATE);
         }else{
             if((*user)->is_id_set())
@@ -603,14 +573,13 @@ void LTE_fdd_enb_mme::parse_attach_request(LIBLTE_BYTE_MSG_STRUCT  *msg,
             imsi_num *= 10;
             imsi_num += attach_req.eps_mobile_id.imsi[i];
         }
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "IMSI=%015llu is associated with RNTI=%u, RB=%s",
-                                  imsi_num,
-                                  (*user)->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "IMSI=%015llu is associated with RNTI=%u, RB=%s",
+                          imsi_num,
+                          (*user)->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
         if(hss->is_imsi_allowed(imsi_num))
         {
             if((*user)->get_eea_support(0) && (*user)->get_eia_support(2))
@@ -631,14 +600,13 @@ void LTE_fdd_enb_mme::parse_attach_request(LIBLTE_BYTE_MSG_STRUCT  *msg,
             imei_num *= 10;
             imei_num += attach_req.eps_mobile_id.imei[i];
         }
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "IMEI=%015llu is associated with RNTI=%u, RB=%s",
-                                  imei_num,
-                                  (*user)->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "IMEI=%015llu is associated with RNTI=%u, RB=%s",
+                          imei_num,
+                          (*user)->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
         if(hss->is_imei_allowed(imei_num))
         {
             if((*user)->get_eea_support(0) && (*user)->get_eia_support(2))
@@ -662,13 +630,12 @@ void LTE_fdd_enb_mme::parse_authentication_failure(LIBLTE_BYTE_MSG_STRUCT *msg,
     LTE_fdd_enb_hss                              *hss       = LTE_fdd_enb_hss::get_instance();
     LIBLTE_MME_AUTHENTICATION_FAILURE_MSG_STRUCT  auth_fail;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received Authentication Failure for RNTI=%u and RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received Authentication Failure for RNTI=%u and RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_authentication_failure_msg(msg, &auth_fail);
@@ -680,14 +647,13 @@ void LTE_fdd_enb_mme::parse_authentication_failure(LIBLTE_BYTE_MSG_STRUCT *msg,
         hss->security_resynch(user->get_id(), sys_info.mcc, sys_info.mnc, auth_fail.auth_fail_param);
         sem_post(&sys_info_sem);
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Authentication failure cause=%02X, RNTI=%u, RB=%s",
-                                  auth_fail.emm_cause,
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "Authentication failure cause=%02X, RNTI=%u, RB=%s",
+                          auth_fail.emm_cause,
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()]);
         rb->set_mme_state(LTE_FDD_ENB_MME_STATE_RELEASE);
     }
 }
@@ -701,13 +667,12 @@ void LTE_fdd_enb_mme::parse_authentication_response(LIBLTE_BYTE_MSG_STRUCT *msg,
     uint32                                         i;
     bool                                           res_match = true;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received Authentication Response for RNTI=%u and RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received Authentication Response for RNTI=%u and RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_authentication_response_msg(msg, &auth_resp);
@@ -731,39 +696,36 @@ void LTE_fdd_enb_mme::parse_authentication_response(LIBLTE_BYTE_MSG_STRUCT *msg,
             interface->send_ctrl_info_msg("user authentication successful imsi=%s imei=%s",
                                           user->get_imsi_str().c_str(),
                                           user->get_imei_str().c_str());
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Authentication successful for RNTI=%u and RB=%s",
-                                      user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Authentication successful for RNTI=%u and RB=%s",
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
             user->set_auth_vec(auth_vec);
             rb->set_mme_state(LTE_FDD_ENB_MME_STATE_ENABLE_SECURITY);
         }else{
             interface->send_ctrl_info_msg("user authentication rejected (RES MISMATCH) imsi=%s imei=%s",
                                           user->get_imsi_str().c_str(),
                                           user->get_imei_str().c_str());
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Authentication rejected (RES MISMATCH) for RNTI=%u and RB=%s",
-                                      user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Authentication rejected (RES MISMATCH) for RNTI=%u and RB=%s",
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
             rb->set_mme_state(LTE_FDD_ENB_MME_STATE_AUTH_REJECTED);
         }
     }else{
         interface->send_ctrl_info_msg("user authentication rejected (NO AUTH VEC) imsi=%s imei=%s",
                                       user->get_imsi_str().c_str(),
                                       user->get_imei_str().c_str());
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Authentication rejected (NO AUTH VEC) for RNTI=%u and RB=%s",
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "Authentication rejected (NO AUTH VEC) for RNTI=%u and RB=%s",
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()]);
         rb->set_mme_state(LTE_FDD_ENB_MME_STATE_AUTH_REJECTED);
     }
 }
@@ -774,13 +736,12 @@ void LTE_fdd_enb_mme::parse_detach_request(LIBLTE_BYTE_MSG_STRUCT *msg,
     LTE_fdd_enb_user_mgr                 *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
     LIBLTE_MME_DETACH_REQUEST_MSG_STRUCT  detach_req;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received Detach Request for RNTI=%u and RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received Detach Request for RNTI=%u and RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_detach_request_msg(msg, &detach_req);
@@ -802,13 +763,12 @@ void LTE_fdd_enb_mme::parse_identity_response(LIBLTE_BYTE_MSG_STRUCT *msg,
     uint64                             imei_num = 0;
     uint32                             i;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received Identity Response for RNTI=%u and RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received Identity Response for RNTI=%u and RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_identity_response_msg(msg, &id_resp);
@@ -821,14 +781,13 @@ void LTE_fdd_enb_mme::parse_identity_response(LIBLTE_BYTE_MSG_STRUCT *msg,
             imsi_num *= 10;
             imsi_num += id_resp.mobile_id.imsi[i];
         }
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "IMSI=%015llu is associated with RNTI=%u, RB=%s",
-                                  imsi_num,
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "IMSI=%015llu is associated with RNTI=%u, RB=%s",
+                          imsi_num,
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()]);
         if(hss->is_imsi_allowed(imsi_num))
         {
             if(user->get_eea_support(0) && user->get_eia_support(2))
@@ -849,14 +808,13 @@ void LTE_fdd_enb_mme::parse_identity_response(LIBLTE_BYTE_MSG_STRUCT *msg,
             imei_num *= 10;
             imei_num += id_resp.mobile_id.imei[i];
         }
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "IMEI=%015llu is associated with RNTI=%u, RB=%s",
-                                  imei_num,
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "IMEI=%015llu is associated with RNTI=%u, RB=%s",
+                          imei_num,
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()]);
         if(hss->is_imei_allowed(imei_num))
         {
             if(user->get_eea_support(0) && user->get_eia_support(2))
@@ -872,12 +830,11 @@ void LTE_fdd_enb_mme::parse_identity_response(LIBLTE_BYTE_MSG_STRUCT *msg,
             rb->set_mme_state(LTE_FDD_ENB_MME_STATE_REJECT);
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Invalid ID_TYPE=%u",
-                                  id_resp.mobile_id.type_of_id);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "Invalid ID_TYPE=%u",
+                          id_resp.mobile_id.type_of_id);
     }
 }
 void LTE_fdd_enb_mme::parse_security_mode_complete(LIBLTE_BYTE_MSG_STRUCT *msg,
@@ -888,13 +845,12 @@ void LTE_fdd_enb_mme::parse_security_mode_complete(LIBLTE_BYTE_MSG_STRUCT *msg,
     uint64                                       imei_num = 0;
     uint32                                       i;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received Security Mode Complete for RNTI=%u and RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received Security Mode Complete for RNTI=%u and RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_security_mode_complete_msg(msg, &sec_mode_comp);
@@ -910,25 +866,23 @@ void LTE_fdd_enb_mme::parse_security_mode_complete(LIBLTE_BYTE_MSG_STRUCT *msg,
             }
             if((user->get_id()->imei/10) != imei_num)
             {
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                          __FILE__,
-                                          __LINE__,
-                                          "Received IMEI (%015llu) does not match stored IMEI (%015llu), RNTI=%u, RB=%s",
-                                          imei_num*10,
-                                          (user->get_id()->imei/10)*10,
-                                          user->get_c_rnti(),
-                                          LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+                LTE_FDD_ENB_DEBUG(interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                  "Received IMEI (%015llu) does not match stored IMEI (%015llu), RNTI=%u, RB=%s",
+                                  imei_num*10,
+                                  (user->get_id()->imei/10)*10,
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
             }
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Security Mode Complete received with invalid ID type (%u), RNTI=%u, RB=%s",
-                                      sec_mode_comp.imeisv.type_of_id,
-                                      user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Security Mode Complete received with invalid ID type (%u), RNTI=%u, RB=%s",
+                              sec_mode_comp.imeisv.type_of_id,
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
         }
     }
 
@@ -940,25 +894,23 @@ void LTE_fdd_enb_mme::parse_security_mode_reject(LIBLTE_BYTE_MSG_STRUCT *msg,
 {
     LIBLTE_MME_SECURITY_MODE_REJECT_MSG_STRUCT sec_mode_rej;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received Security Mode Reject for RNTI=%u and RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received Security Mode Reject for RNTI=%u and RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_security_mode_reject_msg(msg, &sec_mode_rej);
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Security Mode Rejected cause=%02X, RNTI=%u, RB=%s",
-                              sec_mode_rej.emm_cause,
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Security Mode Rejected cause=%02X, RNTI=%u, RB=%s",
+                      sec_mode_rej.emm_cause,
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
     rb->set_mme_state(LTE_FDD_ENB_MME_STATE_RELEASE);
 }
 void LTE_fdd_enb_mme::parse_service_request(LIBLTE_BYTE_MSG_STRUCT *msg,
@@ -972,13 +924,12 @@ void LTE_fdd_enb_mme::parse_service_request(LIBLTE_BYTE_MSG_STRUCT *msg,
     LIBLTE_MME_SERVICE_REQUEST_MSG_STRUCT     service_req;
     uint32                                    i;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received Service Request for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received Service Request for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_service_request_msg(msg, &service_req);
@@ -989,14 +940,13 @@ void LTE_fdd_enb_mme::parse_service_request(LIBLTE_BYTE_MSG_STRUCT *msg,
     // Verify KSI and sequence number
     if(0 != service_req.ksi_and_seq_num.ksi)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Invalid KSI (%u) for RNTI=%u, RB=%s",
-                                  service_req.ksi_and_seq_num.ksi,
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "Invalid KSI (%u) for RNTI=%u, RB=%s",
+                          service_req.ksi_and_seq_num.ksi,
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
         send_service_reject(user, rb, LIBLTE_MME_EMM_CAUSE_IMPLICITLY_DETACHED);
 
@@ -1005,15 +955,14 @@ void LTE_fdd_enb_mme::parse_service_request(LIBLTE_BYTE_MSG_STRUCT *msg,
     }else{
         if(auth_vec->nas_count_ul != service_req.ksi_and_seq_num.seq_num)
         {
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Sequence number mismatch (rx=%u, stored=%u) for RNTI=%u, RB=%s",
-                                      service_req.ksi_and_seq_num.seq_num,
-                                      user->get_auth_vec()->nas_count_ul,
-                                      user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                              "Sequence number mismatch (rx=%u, stored=%u) for RNTI=%u, RB=%s",
+                              service_req.ksi_and_seq_num.seq_num,
+                              user->get_auth_vec()->nas_count_ul,
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
             // Resolve sequence number mismatch
             auth_vec->nas_count_ul = service_req.ksi_and_seq_num.seq_num;
@@ -1044,13 +993,12 @@ void LTE_fdd_enb_mme::parse_activate_default_eps_bearer_context_accept(LIBLTE_BY
 {
     LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_MSG_STRUCT act_def_eps_bearer_context_accept;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received Activate Default EPS Bearer Context Accept for RNTI=%u and RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received Activate Default EPS Bearer Context Accept for RNTI=%u and RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_activate_default_eps_bearer_context_accept_msg(msg, &act_def_eps_bearer_context_accept);
@@ -1065,13 +1013,12 @@ void LTE_fdd_enb_mme::parse_esm_information_response(LIBLTE_BYTE_MSG_STRUCT *msg
 {
     LIBLTE_MME_ESM_INFORMATION_RESPONSE_MSG_STRUCT esm_info_resp;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received ESM Information Response for RNTI=%u and RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received ESM Information Response for RNTI=%u and RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_esm_information_response_msg(msg, &esm_info_resp);
@@ -1088,13 +1035,12 @@ void LTE_fdd_enb_mme::parse_pdn_connectivity_request(LIBLTE_BYTE_MSG_STRUCT *msg
     LIBLTE_MME_PROTOCOL_CONFIG_OPTIONS_STRUCT      pco_resp;
     uint32                                         i;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              "Received PDN Connectivity Request for RNTI=%u and RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      "Received PDN Connectivity Request for RNTI=%u and RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Unpack the message
     liblte_mme_unpack_pdn_connectivity_request_msg(msg, &pdn_con_req);
@@ -1148,11 +1094,10 @@ void LTE_fdd_enb_mme::parse_pdn_connectivity_request(LIBLTE_BYTE_MSG_STRUCT *msg
                     pco_resp.opt[pco_resp.N_opts].contents[15] = dns_addr & 0xFF;
                     pco_resp.N_opts++;
                 }else{
-                    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                              __FILE__,
-                                              __LINE__,
-                                              "Unknown PCO");
+                    LTE_FDD_ENB_DEBUG(interface,
+                                      LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                      "Unknown PCO");
                 }
             }else if(LIBLTE_MME_ADDITIONAL_PARAMETERS_UL_DNS_SERVER_IPV4_ADDRESS_REQUEST == pdn_con_req.protocol_cnfg_opts.opt[i].id){
                 pco_resp.opt[pco_resp.N_opts].id          = LIBLTE_MME_ADDITIONAL_PARAMETERS_DL_DNS_SERVER_IPV4_ADDRESS;
@@ -1165,12 +1110,11 @@ void LTE_fdd_enb_mme::parse_pdn_connectivity_request(LIBLTE_BYTE_MSG_STRUCT *msg
             }else if(LIBLTE_MME_ADDITIONAL_PARAMETERS_UL_IP_ADDRESS_ALLOCATION_VIA_NAS_SIGNALLING == pdn_con_req.protocol_cnfg_opts.opt[i].id){
                 // Nothing to do
             }else{
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                          __FILE__,
-                                          __LINE__,
-                                          "Invalid PCO ID (%04X)",
-                                          pdn_con_req.protocol_cnfg_opts.opt[i].id);
+                LTE_FDD_ENB_DEBUG(interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                                  "Invalid PCO ID (%04X)",
+                                  pdn_con_req.protocol_cnfg_opts.opt[i].id);
             }
         }
         user->set_protocol_cnfg_opts(&pco_resp);
@@ -1220,14 +1164,13 @@ void LTE_fdd_enb_mme::attach_sm(LTE_fdd_enb_user *user,
         send_emm_information(user, rb);
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "ATTACH state machine invalid state %s, RNTI=%u and RB=%s",
-                                  LTE_fdd_enb_mme_state_text[rb->get_mme_state()],
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "ATTACH state machine invalid state %s, RNTI=%u and RB=%s",
+                          LTE_fdd_enb_mme_state_text[rb->get_mme_state()],
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()]);
         break;
     }
 }
@@ -1246,14 +1189,13 @@ void LTE_fdd_enb_mme::service_req_sm(LTE_fdd_enb_user *user,
         send_activate_dedicated_eps_bearer_context_request(user, rb);
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "SERVICE REQUEST state machine invalid state %s, RNTI=%u and RB=%s",
-                                  LTE_fdd_enb_mme_state_text[rb->get_mme_state()],
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "SERVICE REQUEST state machine invalid state %s, RNTI=%u and RB=%s",
+                          LTE_fdd_enb_mme_state_text[rb->get_mme_state()],
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()]);
         break;
     }
 }
@@ -1266,14 +1208,13 @@ void LTE_fdd_enb_mme::detach_sm(LTE_fdd_enb_user *user,
         send_detach_accept(user, rb);
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  "DETACH state machine invalid state %s, RNTI=%u and RB=%s",
-                                  LTE_fdd_enb_mme_state_text[rb->get_mme_state()],
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          "DETACH state machine invalid state %s, RNTI=%u and RB=%s",
+                          LTE_fdd_enb_mme_state_text[rb->get_mme_state()],
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()]);
         break;
     }
 }
@@ -1376,14 +1317,13 @@ void LTE_fdd_enb_mme::send_attach_accept(LTE_fdd_enb_user *user,
                                       LIBLTE_SECURITY_DIRECTION_DOWNLINK,
                                       &msg);
     user->increment_nas_count_dl();
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              &msg,
-                              "Sending Attach Accept for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      &msg,
+                      "Sending Attach Accept for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the NAS message for RRC
     rb->queue_rrc_nas_msg(&msg);
@@ -1416,15 +1356,14 @@ void LTE_fdd_enb_mme::send_attach_reject(LTE_fdd_enb_user *user,
     attach_rej.esm_msg_present     = false;
     attach_rej.t3446_value_present = false;
     liblte_mme_pack_attach_reject_msg(&attach_rej, &msg);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              &msg,
-                              "Sending Attach Reject for IMSI=%015llu, RNTI=%u, RB=%s",
-                              imsi_num,
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      &msg,
+                      "Sending Attach Reject for IMSI=%015llu, RNTI=%u, RB=%s",
+                      imsi_num,
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the NAS message for RRC
     rb->queue_rrc_nas_msg(&msg);
@@ -1447,14 +1386,13 @@ void LTE_fdd_enb_mme::send_authentication_reject(LTE_fdd_enb_user *user,
     LIBLTE_BYTE_MSG_STRUCT                      msg;
 
     liblte_mme_pack_authentication_reject_msg(&auth_rej, &msg);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              &msg,
-                              "Sending Authentication Reject for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      &msg,
+                      "Sending Authentication Reject for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the NAS message for RRC
     rb->queue_rrc_nas_msg(&msg);
@@ -1493,14 +1431,13 @@ void LTE_fdd_enb_mme::send_authentication_request(LTE_fdd_enb_user *user,
         auth_req.nas_ksi.tsc_flag = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
         auth_req.nas_ksi.nas_ksi  = 0;
         liblte_mme_pack_authentication_request_msg(&auth_req, &msg);
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                                  __FILE__,
-                                  __LINE__,
-                                  &msg,
-                                  "Sending Authentication Request for RNTI=%u, RB=%s",
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                          &msg,
+                          "Sending Authentication Request for RNTI=%u, RB=%s",
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
         // Queue the NAS message for RRC
         rb->queue_rrc_nas_msg(&msg);
@@ -1538,14 +1475,13 @@ void LTE_fdd_enb_mme::send_detach_accept(LTE_fdd_enb_user *user,
                                           0,
                                           &msg);
     }
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              &msg,
-                              "Sending Detach Accept for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      &msg,
+                      "Sending Detach Accept for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the NAS message for RRC
     rb->queue_rrc_nas_msg(&msg);
@@ -1593,14 +1529,13 @@ void LTE_fdd_enb_mme::send_emm_information(LTE_fdd_enb_user *user,
                                         LIBLTE_SECURITY_DIRECTION_DOWNLINK,
                                         &msg);
     user->increment_nas_count_dl();
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              &msg,
-                              "Sending EMM Information for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      &msg,
+                      "Sending EMM Information for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the NAS message for RRC
     rb->queue_rrc_nas_msg(&msg);
@@ -1623,14 +1558,13 @@ void LTE_fdd_enb_mme::send_identity_request(LTE_fdd_enb_user *user,
 
     id_req.id_type = id_type;
     liblte_mme_pack_identity_request_msg(&id_req, &msg);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              &msg,
-                              "Sending ID Request for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      &msg,
+                      "Sending ID Request for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the NAS message for RRC
     rb->queue_rrc_nas_msg(&msg);
@@ -1692,14 +1626,13 @@ void LTE_fdd_enb_mme::send_security_mode_command(LTE_fdd_enb_user *user,
                                               LIBLTE_SECURITY_DIRECTION_DOWNLINK,
                                               &msg);
     user->increment_nas_count_dl();
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              &msg,
-                              "Sending Security Mode Command for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      &msg,
+                      "Sending Security Mode Command for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the message for RRC
     rb->queue_rrc_nas_msg(&msg);
@@ -1729,14 +1662,13 @@ void LTE_fdd_enb_mme::send_service_reject(LTE_fdd_enb_user *user,
                                        0,
                                        0,
                                        &msg);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              &msg,
-                              "Sending Service Reject for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      &msg,
+                      "Sending Service Reject for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the NAS message for RRC
     rb->queue_rrc_nas_msg(&msg);
@@ -1803,14 +1735,13 @@ void LTE_fdd_enb_mme::send_activate_dedicated_eps_bearer_context_request(LTE_fdd
                                                user->get_auth_vec()->nas_count_dl,
                                                LIBLTE_SECURITY_DIRECTION_DOWNLINK,
                                                &sec_msg);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              &sec_msg,
-                              "Sending Activate Dedicated EPS Bearer Context Request for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      &sec_msg,
+                      "Sending Activate Dedicated EPS Bearer Context Request for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the NAS message for RRC
     rb->queue_rrc_nas_msg(&sec_msg);
@@ -1847,14 +1778,13 @@ void LTE_fdd_enb_mme::send_esm_information_request(LTE_fdd_enb_user *user,
                                                user->get_auth_vec()->nas_count_dl,
                                                LIBLTE_SECURITY_DIRECTION_DOWNLINK,
                                                &sec_msg);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_MME,
-                              __FILE__,
-                              __LINE__,
-                              &sec_msg,
-                              "Sending ESM Info Request for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MME,
+                      &sec_msg,
+                      "Sending ESM Info Request for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the NAS message for RRC
     rb->queue_rrc_nas_msg(&sec_msg);
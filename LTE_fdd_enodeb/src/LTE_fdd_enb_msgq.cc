@@ -90,29 +90,56 @@ void LTE_fdd_enb_msgq_cb::operator()(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
 /********************************/
 LTE_fdd_enb_msgq::LTE_fdd_enb_msgq(std::string _msgq_name)
 {
-    sem_init(&sync_sem, 0, 1);
-    sem_init(&msg_sem, 0, 1);
-    circ_buf  = new boost::circular_buffer<LTE_FDD_ENB_MESSAGE_STRUCT>(100);
-    msgq_name = _msgq_name;
-    rx_setup  = false;
+    sem_init(&msg_sem, 0, 0);
+    sem_init(&space_sem, 0, 0);
+    ring         = new LTE_fdd_enb_ring<LTE_FDD_ENB_MESSAGE_STRUCT>(LTE_FDD_ENB_MSGQ_SIZE, false);
+    overflow     = LTE_FDD_ENB_MSGQ_OVERFLOW_DROP_NEWEST;
+    msgq_name    = _msgq_name;
+    N_tx_waiting = 0;
+    rx_setup     = false;
+    rx_waiting   = false;
+    killed       = false;
+    memset(&stats, 0, sizeof(stats));
+}
+LTE_fdd_enb_msgq::LTE_fdd_enb_msgq(std::string                    _msgq_name,
+                                   LTE_FDD_ENB_MSGQ_OVERFLOW_ENUM _overflow,
+                                   bool                           _single_producer)
+{
+    sem_init(&msg_sem, 0, 0);
+    sem_init(&space_sem, 0, 0);
+    ring         = new LTE_fdd_enb_ring<LTE_FDD_ENB_MESSAGE_STRUCT>(LTE_FDD_ENB_MSGQ_SIZE, _single_producer);
+    overflow     = _overflow;
+    msgq_name    = _msgq_name;
+    N_tx_waiting = 0;
+    rx_setup     = false;
+    rx_waiting   = false;
+    killed       = false;
+    memset(&stats, 0, sizeof(stats));
 }
 LTE_fdd_enb_msgq::~LTE_fdd_enb_msgq()
 {
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+
     if(rx_setup)
     {
-        send(LTE_FDD_ENB_MESSAGE_TYPE_KILL,
-             LTE_FDD_ENB_DEST_LAYER_ANY,
-             NULL,
-             0);
-
-        // Cleanup thread
-        pthread_cancel(rx_thread);
+        // Wake the receive thread and let it drain the ring
+        kill();
         pthread_join(rx_thread, NULL);
         rx_setup = false;
     }
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_MSGQ,
+                      "%s sent=%u dropped=%u received=%u max_depth=%u overflow=%s",
+                      msgq_name.c_str(),
+                      stats.N_sent,
+                      stats.N_dropped,
+                      stats.N_received,
+                      stats.max_depth,
+                      LTE_fdd_enb_msgq_overflow_text[overflow]);
     sem_destroy(&msg_sem);
-    sem_destroy(&sync_sem);
-    delete circ_buf;
+    sem_destroy(&space_sem);
+    delete ring;
 }
 
 /***************/
@@ -142,50 +169,149 @@ void LTE_fdd_enb_msgq::send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM  type,
                             LTE_FDD_ENB_MESSAGE_UNION     *msg_content,
                             uint32                         msg_content_size)
 {
-    LTE_FDD_ENB_MESSAGE_STRUCT msg;
+    LTE_FDD_ENB_MESSAGE_STRUCT *msg;
+    uint32                      pos;
 
-    msg.type       = type;
-    msg.dest_layer = dest_layer;
-    if(msg_content != NULL)
+    if(LTE_FDD_ENB_MESSAGE_TYPE_KILL == type)
     {
-        memcpy(&msg.msg, msg_content, msg_content_size);
+        kill();
+        return;
     }
 
-    sem_wait(&sync_sem);
-    circ_buf->push_back(msg);
-    sem_post(&sync_sem);
-    sem_post(&msg_sem);
+    msg = claim(&pos);
+    if(NULL != msg)
+    {
+        msg->type       = type;
+        msg->dest_layer = dest_layer;
+        if(msg_content != NULL)
+        {
+            memcpy(&msg->msg, msg_content, msg_content_size);
+        }
+        publish(pos);
+    }
 }
-void LTE_fdd_enb_msgq::send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM       type,
+bool LTE_fdd_enb_msgq::send(LTE_FDD_ENB_MESSAGE_TYPE_ENUM       type,
                             LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched,
                             LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched)
 {
-    LTE_FDD_ENB_MESSAGE_STRUCT msg;
+    LTE_FDD_ENB_MESSAGE_STRUCT *msg;
+    uint32                      pos;
 
-    msg.type       = type;
-    msg.dest_layer = LTE_FDD_ENB_DEST_LAYER_PHY;
-    memcpy(&msg.msg.phy_schedule.dl_sched, dl_sched, sizeof(LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT));
-    memcpy(&msg.msg.phy_schedule.ul_sched, ul_sched, sizeof(LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT));
+    msg = claim(&pos);
+    if(NULL == msg)
+    {
+        return(false);
+    }
+    msg->type                      = type;
+    msg->dest_layer                = LTE_FDD_ENB_DEST_LAYER_PHY;
+    msg->msg.phy_schedule.dl_sched = dl_sched;
+    msg->msg.phy_schedule.ul_sched = ul_sched;
+    publish(pos);
 
-    sem_wait(&sync_sem);
-    circ_buf->push_back(msg);
-    sem_post(&sync_sem);
-    sem_post(&msg_sem);
+    return(true);
 }
 void LTE_fdd_enb_msgq::send(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
 {
-    sem_wait(&sync_sem);
-    circ_buf->push_back(msg);
-    sem_post(&sync_sem);
-    sem_post(&msg_sem);
+    LTE_FDD_ENB_MESSAGE_STRUCT *cell;
+    uint32                      pos;
+
+    if(LTE_FDD_ENB_MESSAGE_TYPE_KILL == msg.type)
+    {
+        kill();
+        return;
+    }
+
+    cell = claim(&pos);
+    if(NULL != cell)
+    {
+        memcpy(cell, &msg, sizeof(LTE_FDD_ENB_MESSAGE_STRUCT));
+        publish(pos);
+    }
 }
-void* LTE_fdd_enb_msgq::receive_thread(void *inputs)
+LTE_FDD_ENB_MESSAGE_STRUCT* LTE_fdd_enb_msgq::claim(uint32 *pos)
 {
     LTE_fdd_enb_interface      *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_fdd_enb_msgq           *msgq      = (LTE_fdd_enb_msgq *)inputs;
-    LTE_FDD_ENB_MESSAGE_STRUCT  msg;
+    LTE_FDD_ENB_MESSAGE_STRUCT *msg;
+
+    msg = ring->claim(pos);
+    while(NULL == msg)
+    {
+        if(LTE_FDD_ENB_MSGQ_OVERFLOW_DROP_NEWEST == overflow ||
+           __atomic_load_n(&killed, __ATOMIC_ACQUIRE))
+        {
+            __atomic_fetch_add(&stats.N_dropped, 1, __ATOMIC_RELAXED);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                              LTE_FDD_ENB_DEBUG_LEVEL_MSGQ,
+                              "%s full, dropping message",
+                              msgq_name.c_str());
+            return(NULL);
+        }
+
+        // Wait for the receive thread to release a cell, checking the ring
+        // again after flagging the wait so that a release racing with it
+        // is not missed.  A stale post only costs an extra pass.
+        __atomic_fetch_add(&N_tx_waiting, 1, __ATOMIC_SEQ_CST);
+        msg = ring->claim(pos);
+        if(NULL == msg)
+        {
+            sem_wait(&space_sem);
+            msg = ring->claim(pos);
+        }
+    }
+
+    return(msg);
+}
+void LTE_fdd_enb_msgq::publish(uint32 pos)
+{
+    ring->publish(pos);
+    __atomic_fetch_add(&stats.N_sent, 1, __ATOMIC_RELAXED);
+
+    // Only wake the receive thread if it is waiting, the fence orders the
+    // publish before the check against the receive thread's check of the
+    // ring after it sets rx_waiting
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&rx_waiting, __ATOMIC_RELAXED) &&
+       __atomic_exchange_n(&rx_waiting, false, __ATOMIC_SEQ_CST))
+    {
+        sem_post(&msg_sem);
+    }
+}
+void LTE_fdd_enb_msgq::kill(void)
+{
+    __atomic_store_n(&killed, true, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if(__atomic_exchange_n(&rx_waiting, false, __ATOMIC_SEQ_CST))
+    {
+        sem_post(&msg_sem);
+    }
+    wake_senders();
+}
+void LTE_fdd_enb_msgq::wake_senders(void)
+{
+    uint32 N_waiting;
+
+    // The fence orders the releases before the check against the sender's
+    // check of the ring after it flags the wait
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if(0 == __atomic_load_n(&N_tx_waiting, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+    N_waiting = __atomic_exchange_n(&N_tx_waiting, 0, __ATOMIC_SEQ_CST);
+    while(N_waiting > 0)
+    {
+        sem_post(&space_sem);
+        N_waiting--;
+    }
+}
+void* LTE_fdd_enb_msgq::receive_thread(void *inputs)
+{
+    LTE_fdd_enb_msgq           *msgq     = (LTE_fdd_enb_msgq *)inputs;
+    LTE_FDD_ENB_MESSAGE_STRUCT *msg;
     struct sched_param          priority;
     cpu_set_t                   af_mask;
+    uint32                      depth;
     bool                        not_done = true;
 
     // Set priority
@@ -203,40 +329,58 @@ void* LTE_fdd_enb_msgq::receive_thread(void *inputs)
 
     while(not_done)
     {
-        // Wait for a message
-        sem_wait(&msgq->msg_sem);
-        sem_wait(&msgq->sync_sem);
-        if(msgq->circ_buf->size() != 0)
+        // Everything published before a kill is still processed
+        if(__atomic_load_n(&msgq->killed, __ATOMIC_ACQUIRE))
         {
-            while(msgq->circ_buf->size() != 0)
-            {
-                msg = msgq->circ_buf->front();
-                msgq->circ_buf->pop_front();
-                sem_post(&msgq->sync_sem);
+            not_done = false;
+        }
+
+        // Process every published message in place
+        depth = msgq->ring->depth();
+        if(depth > msgq->stats.max_depth)
+        {
+            __atomic_store_n(&msgq->stats.max_depth, depth, __ATOMIC_RELAXED);
+        }
+        msg = msgq->ring->front();
+        while(NULL != msg)
+        {
+            msgq->callback(*msg);
+            msgq->ring->release();
+            __atomic_fetch_add(&msgq->stats.N_received, 1, __ATOMIC_RELAXED);
+            msg = msgq->ring->front();
+        }
+        msgq->wake_senders();
 
-                // Process message
-                switch(msg.type)
+        if(not_done)
+        {
+            // Wait for a message, checking the ring again after flagging
+            // the wait so that a publish racing with it is not missed
+            __atomic_store_n(&msgq->rx_waiting, true, __ATOMIC_SEQ_CST);
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            if(NULL != msgq->ring->front() ||
+               __atomic_load_n(&msgq->killed, __ATOMIC_ACQUIRE))
+            {
+                if(!__atomic_exchange_n(&msgq->rx_waiting, false, __ATOMIC_SEQ_CST))
                 {
-                case LTE_FDD_ENB_MESSAGE_TYPE_KILL:
-                    not_done = false;
-                    break;
-                default:
-                    msgq->callback(msg);
-                    break;
+                    // A sender already cleared the flag and posted
+                    sem_wait(&msgq->msg_sem);
                 }
-
-                sem_wait(&msgq->sync_sem);
+            }else{
+                sem_wait(&msgq->msg_sem);
             }
-        }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_MSGQ,
-                                      __FILE__,
-                                      __LINE__,
-                                      "%s circular buffer empty on receive",
-                                      msgq->msgq_name.c_str());
         }
-        sem_post(&msgq->sync_sem);
     }
 
     return(NULL);
 }
+
+/********************/
+/*    Statistics    */
+/********************/
+void LTE_fdd_enb_msgq::get_stats(LTE_FDD_ENB_MSGQ_STATS_STRUCT *_stats)
+{
+    _stats->N_sent     = __atomic_load_n(&stats.N_sent, __ATOMIC_RELAXED);
+    _stats->N_dropped  = __atomic_load_n(&stats.N_dropped, __ATOMIC_RELAXED);
+    _stats->N_received = __atomic_load_n(&stats.N_received, __ATOMIC_RELAXED);
+    _stats->max_depth  = __atomic_load_n(&stats.max_depth, __ATOMIC_RELAXED);
+}
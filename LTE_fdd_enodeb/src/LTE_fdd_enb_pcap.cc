@@ -0,0 +1,423 @@
+#line 2 "LTE_fdd_enb_pcap.cc" // Make __FILE__ omit the path
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_pcap.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 packet capture.
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_pcap.h"
+#include "LTE_fdd_enb_interface.h"
+#include "libtools_helpers.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_PCAP_HDR_SIZE      16
+#define LTE_FDD_ENB_PCAPNG_EPB_SIZE    28
+#define LTE_FDD_ENB_PCAPNG_EPB_TYPE    6
+#define LTE_FDD_ENB_PCAPNG_IDB_TYPE    1
+#define LTE_FDD_ENB_PCAPNG_SHB_TYPE    0x0A0D0D0A
+#define LTE_FDD_ENB_PCAPNG_BYTE_ORDER  0x1A2B3C4D
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_pcap::LTE_fdd_enb_pcap(LTE_fdd_enb_interface *_interface,
+                                   std::string            _file_name,
+                                   uint32                 _link_type)
+{
+    interface          = _interface;
+    ring               = new LTE_fdd_enb_ring<LTE_FDD_ENB_PCAP_RECORD_STRUCT>(LTE_FDD_ENB_PCAP_N_RECORDS, false);
+    file_name          = _file_name;
+    link_type          = _link_type;
+    file_size          = 0;
+    file_open_time     = 0;
+    file_idx           = 0;
+    file_N_records     = 0;
+    rotate_size        = 0;
+    rotate_time        = 0;
+    snaplen            = LTE_FDD_ENB_DEFAULT_PCAP_SNAPLEN;
+    file_snaplen       = snaplen;
+    N_dropped          = 0;
+    N_dropped_reported = 0;
+    cnfg_gen           = 0;
+    file_cnfg_gen      = 0;
+    fd                 = -1;
+    format             = LTE_FDD_ENB_PCAP_FORMAT_PCAP;
+    file_format        = format;
+    enabled            = false;
+    stop               = false;
+    pthread_create(&thread, NULL, &writer_thread, this);
+}
+LTE_fdd_enb_pcap::~LTE_fdd_enb_pcap()
+{
+    // The writer drains the ring before it exits
+    __atomic_store_n(&stop, true, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+
+    delete ring;
+}
+
+/*******************/
+/*    Producers    */
+/*******************/
+LTE_FDD_ENB_PCAP_RECORD_STRUCT* LTE_fdd_enb_pcap::claim(uint32 *pos)
+{
+    LTE_FDD_ENB_PCAP_RECORD_STRUCT *rec = ring->claim(pos);
+
+    if(NULL == rec)
+    {
+        __atomic_fetch_add(&N_dropped, 1, __ATOMIC_RELAXED);
+    }
+
+    return(rec);
+}
+void LTE_fdd_enb_pcap::publish(uint32 pos)
+{
+    ring->publish(pos);
+}
+
+/***********************/
+/*    Configuration    */
+/***********************/
+void LTE_fdd_enb_pcap::set_cnfg(bool                         _enabled,
+                                LTE_FDD_ENB_PCAP_FORMAT_ENUM _format,
+                                uint32                       _snaplen,
+                                uint64                       _rotate_size,
+                                uint32                       _rotate_time)
+{
+    // A new format or snaplen needs a new file header
+    if(_format  != __atomic_load_n(&format, __ATOMIC_RELAXED) ||
+       _snaplen != __atomic_load_n(&snaplen, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&format, _format, __ATOMIC_RELAXED);
+        __atomic_store_n(&snaplen, _snaplen, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&cnfg_gen, 1, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&rotate_size, _rotate_size, __ATOMIC_RELAXED);
+    __atomic_store_n(&rotate_time, _rotate_time, __ATOMIC_RELAXED);
+    __atomic_store_n(&enabled, _enabled, __ATOMIC_RELAXED);
+}
+
+/********************/
+/*    Statistics    */
+/********************/
+uint32 LTE_fdd_enb_pcap::get_N_dropped(void)
+{
+    return(__atomic_load_n(&N_dropped, __ATOMIC_RELAXED));
+}
+
+/****************/
+/*    Writer    */
+/****************/
+void* LTE_fdd_enb_pcap::writer_thread(void *inputs)
+{
+    LTE_fdd_enb_pcap *pcap = (LTE_fdd_enb_pcap *)inputs;
+    cpu_set_t         af_mask;
+
+    // Set affinity to not the last core (last core is for PHY/Radio)
+    pthread_getaffinity_np(pcap->thread, sizeof(af_mask), &af_mask);
+    CPU_CLR(sysconf(_SC_NPROCESSORS_ONLN)-1, &af_mask);
+    pthread_setaffinity_np(pcap->thread, sizeof(af_mask), &af_mask);
+
+    pcap->open_file();
+    while(!__atomic_load_n(&pcap->stop, __ATOMIC_ACQUIRE))
+    {
+        if(0 == pcap->write_records())
+        {
+            usleep(LTE_FDD_ENB_PCAP_POLL_US);
+        }
+    }
+    while(0 != pcap->write_records());
+    pcap->close_file();
+
+    return(NULL);
+}
+uint32 LTE_fdd_enb_pcap::write_records(void)
+{
+    LTE_FDD_ENB_PCAP_RECORD_STRUCT *rec;
+    struct iovec                    iov[LTE_FDD_ENB_PCAP_MAX_BATCH*3];
+    uint64                          ts;
+    uint64                          N_bytes = 0;
+    uint64                          max_size;
+    uint32                          hdr[LTE_FDD_ENB_PCAP_MAX_BATCH][LTE_FDD_ENB_PCAPNG_EPB_SIZE/sizeof(uint32)];
+    uint32                          trailer[LTE_FDD_ENB_PCAP_MAX_BATCH][2];
+    uint32                          max_time;
+    uint32                          N_iov = 0;
+    uint32                          N_recs;
+    uint32                          N_pad;
+    uint32                          total;
+    uint32                          dropped;
+
+    // Start a new file for a new format or snaplen, or when the current
+    // one is old enough
+    max_time = __atomic_load_n(&rotate_time, __ATOMIC_RELAXED);
+    if(file_cnfg_gen != __atomic_load_n(&cnfg_gen, __ATOMIC_ACQUIRE) ||
+       (0                         != max_time &&
+        0                         != file_N_records &&
+        (time(NULL) - file_open_time) >= (time_t)max_time))
+    {
+        rotate_file();
+    }
+
+    for(N_recs=0; N_recs<LTE_FDD_ENB_PCAP_MAX_BATCH; N_recs++)
+    {
+        rec = ring->peek(N_recs);
+        if(NULL == rec)
+        {
+            break;
+        }
+
+        if(LTE_FDD_ENB_PCAP_FORMAT_PCAP == file_format)
+        {
+            // Record header in the byte order of the file header
+            hdr[N_recs][0]          = htonl(rec->time.tv_sec);
+            hdr[N_recs][1]          = htonl(rec->time.tv_usec);
+            hdr[N_recs][2]          = htonl(rec->N_captured);
+            hdr[N_recs][3]          = htonl(rec->N_bytes);
+            iov[N_iov].iov_base     = hdr[N_recs];
+            iov[N_iov++].iov_len    = LTE_FDD_ENB_PCAP_HDR_SIZE;
+            iov[N_iov].iov_base     = rec->msg;
+            iov[N_iov++].iov_len    = rec->N_captured;
+            N_bytes                += LTE_FDD_ENB_PCAP_HDR_SIZE + rec->N_captured;
+        }else{
+            // Enhanced packet block, padded to 32 bits
+            N_pad                   = (4 - (rec->N_captured % 4)) % 4;
+            total                   = LTE_FDD_ENB_PCAPNG_EPB_SIZE + rec->N_captured + N_pad + sizeof(uint32);
+            ts                      = (uint64)rec->time.tv_sec*1000000 + rec->time.tv_usec;
+            hdr[N_recs][0]          = LTE_FDD_ENB_PCAPNG_EPB_TYPE;
+            hdr[N_recs][1]          = total;
+            hdr[N_recs][2]          = 0;
+            hdr[N_recs][3]          = (uint32)(ts >> 32);
+            hdr[N_recs][4]          = (uint32)ts;
+            hdr[N_recs][5]          = rec->N_captured;
+            hdr[N_recs][6]          = rec->N_bytes;
+            trailer[N_recs][0]      = 0;
+            memcpy((uint8 *)trailer[N_recs] + N_pad, &total, sizeof(uint32));
+            iov[N_iov].iov_base     = hdr[N_recs];
+            iov[N_iov++].iov_len    = LTE_FDD_ENB_PCAPNG_EPB_SIZE;
+            iov[N_iov].iov_base     = rec->msg;
+            iov[N_iov++].iov_len    = rec->N_captured;
+            iov[N_iov].iov_base     = trailer[N_recs];
+            iov[N_iov++].iov_len    = N_pad + sizeof(uint32);
+            N_bytes                += total;
+        }
+    }
+
+    if(0 != N_recs)
+    {
+        if(-1 != fd &&
+           !write_iov(iov, N_iov))
+        {
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                              "Couldn't write %s, %s",
+                              file_name.c_str(),
+                              strerror(errno));
+            close_file();
+        }
+        ring->release(N_recs);
+        file_size      += N_bytes;
+        file_N_records += N_recs;
+
+        max_size = __atomic_load_n(&rotate_size, __ATOMIC_RELAXED);
+        if(0         != max_size &&
+           file_size >= max_size)
+        {
+            rotate_file();
+        }
+    }
+
+    // Report records that did not fit
+    dropped = get_N_dropped();
+    if(dropped != N_dropped_reported)
+    {
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                          LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                          "Dropped %u pcap records for %s",
+                          dropped - N_dropped_reported,
+                          file_name.c_str());
+        N_dropped_reported = dropped;
+    }
+
+    return(N_recs);
+}
+bool LTE_fdd_enb_pcap::open_file(void)
+{
+    std::string  name;
+    struct iovec iov;
+    uint32       hdr[12];
+    uint16       tmp_u16[2];
+
+    file_cnfg_gen  = __atomic_load_n(&cnfg_gen, __ATOMIC_ACQUIRE);
+    file_format    = __atomic_load_n(&format, __ATOMIC_RELAXED);
+    file_snaplen   = __atomic_load_n(&snaplen, __ATOMIC_RELAXED);
+    file_size      = 0;
+    file_N_records = 0;
+    file_open_time = time(NULL);
+    name           = file_name + "." + LTE_fdd_enb_pcap_format_text[file_format];
+
+    fd = open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(-1 == fd)
+    {
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                          "Couldn't open %s, %s",
+                          name.c_str(),
+                          strerror(errno));
+        return(false);
+    }
+
+    if(LTE_FDD_ENB_PCAP_FORMAT_PCAP == file_format)
+    {
+        // Global header: magic number, version 2.4, timezone, sigfigs,
+        // snaplen and link type
+        hdr[0]      = htonl(0xa1b2c3d4);
+        tmp_u16[0]  = htons(2);
+        tmp_u16[1]  = htons(4);
+        memcpy(&hdr[1], tmp_u16, sizeof(tmp_u16));
+        hdr[2]      = htonl(0);
+        hdr[3]      = htonl(0);
+        hdr[4]      = htonl(file_snaplen);
+        hdr[5]      = htonl(link_type);
+        iov.iov_len = 6*sizeof(uint32);
+    }else{
+        // Section header block, version 1.0 of unknown length
+        hdr[0]      = LTE_FDD_ENB_PCAPNG_SHB_TYPE;
+        hdr[1]      = 28;
+        hdr[2]      = LTE_FDD_ENB_PCAPNG_BYTE_ORDER;
+        tmp_u16[0]  = 1;
+        tmp_u16[1]  = 0;
+        memcpy(&hdr[3], tmp_u16, sizeof(tmp_u16));
+        hdr[4]      = 0xFFFFFFFF;
+        hdr[5]      = 0xFFFFFFFF;
+        hdr[6]      = 28;
+
+        // Interface description block, microsecond timestamps
+        hdr[7]      = LTE_FDD_ENB_PCAPNG_IDB_TYPE;
+        hdr[8]      = 20;
+        tmp_u16[0]  = link_type;
+        tmp_u16[1]  = 0;
+        memcpy(&hdr[9], tmp_u16, sizeof(tmp_u16));
+        hdr[10]     = file_snaplen;
+        hdr[11]     = 20;
+        iov.iov_len = 12*sizeof(uint32);
+    }
+    iov.iov_base = hdr;
+    if(!write_iov(&iov, 1))
+    {
+        close_file();
+        return(false);
+    }
+    file_size = iov.iov_len;
+
+    return(true);
+}
+void LTE_fdd_enb_pcap::close_file(void)
+{
+    if(-1 != fd)
+    {
+        close(fd);
+        fd = -1;
+    }
+}
+void LTE_fdd_enb_pcap::rotate_file(void)
+{
+    std::string name = file_name + "." + LTE_fdd_enb_pcap_format_text[file_format];
+
+    // The current file keeps its name, full files are numbered
+    close_file();
+    if(0 != file_N_records)
+    {
+        file_idx++;
+        rename(name.c_str(),
+               (file_name + "_" + to_string((uint64)file_idx, 5) + "." + LTE_fdd_enb_pcap_format_text[file_format]).c_str());
+    }else if(file_format != __atomic_load_n(&format, __ATOMIC_RELAXED)){
+        unlink(name.c_str());
+    }
+    open_file();
+}
+bool LTE_fdd_enb_pcap::write_iov(struct iovec *iov,
+                                 uint32        N_iov)
+{
+    ssize_t N_bytes;
+
+    while(0 != N_iov)
+    {
+        N_bytes = writev(fd, iov, (N_iov < IOV_MAX) ? N_iov : IOV_MAX);
+        if(0 > N_bytes)
+        {
+            if(EINTR == errno)
+            {
+                continue;
+            }
+            return(false);
+        }
+
+        // Skip what was written, a short write resumes mid vector
+        while(0 != N_iov &&
+              (size_t)N_bytes >= iov->iov_len)
+        {
+            N_bytes -= iov->iov_len;
+            iov++;
+            N_iov--;
+        }
+        if(0 != N_iov)
+        {
+            iov->iov_base  = (uint8 *)iov->iov_base + N_bytes;
+            iov->iov_len  -= N_bytes;
+        }
+    }
+
+    return(true);
+}
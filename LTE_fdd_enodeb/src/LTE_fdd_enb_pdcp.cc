@@ -140,12 +140,11 @@ void LTE_fdd_enb_pdcp::handle_rlc_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_pdu_ready(&msg.msg.pdcp_pdu_ready);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid RLC message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                              "Received invalid RLC message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
@@ -164,12 +163,11 @@ void LTE_fdd_enb_pdcp::handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_sdu_ready(&msg.msg.pdcp_sdu_ready);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid RRC message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                              "Received invalid RRC message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
@@ -188,21 +186,19 @@ void LTE_fdd_enb_pdcp::handle_gw_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_data_sdu_ready(&msg.msg.pdcp_data_sdu_ready);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid GW message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                              "Received invalid GW message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received GW message for invalid layer %s",
-                                  LTE_fdd_enb_dest_layer_text[msg.dest_layer]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                          "Received GW message for invalid layer %s",
+                          LTE_fdd_enb_dest_layer_text[msg.dest_layer]);
     }
 }
 
@@ -233,14 +229,13 @@ void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *p
 
     if(LTE_FDD_ENB_ERROR_NONE == pdu_ready->rb->get_next_pdcp_pdu(&pdu))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                  __FILE__,
-                                  __LINE__,
-                                  pdu,
-                                  "Received PDU for RNTI=%u and RB=%s",
-                                  pdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                          pdu,
+                          "Received PDU for RNTI=%u and RB=%s",
+                          pdu_ready->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
 
         // FIXME: Add SN and integrity verification
 
@@ -304,14 +299,13 @@ void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *p
                              (LTE_FDD_ENB_MESSAGE_UNION *)&gw_data_ready,
                              sizeof(LTE_FDD_ENB_GW_DATA_READY_MSG_STRUCT));
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      pdu,
-                                      "Received PDU for RNTI=%u with invalid RB=%s",
-                                      pdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                              pdu,
+                              "Received PDU for RNTI=%u with invalid RB=%s",
+                              pdu_ready->user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
         }
 
         // Delete the PDU
@@ -333,14 +327,13 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
 
     if(LTE_FDD_ENB_ERROR_NONE == sdu_ready->rb->get_next_pdcp_sdu(&sdu))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                  __FILE__,
-                                  __LINE__,
-                                  sdu,
-                                  "Received SDU for RNTI=%u and RB=%s",
-                                  sdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                          sdu,
+                          "Received SDU for RNTI=%u and RB=%s",
+                          sdu_ready->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
 
         if(LTE_FDD_ENB_RB_SRB0 == sdu_ready->rb->get_rb_id())
         {
@@ -354,14 +347,13 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
                 sdu->N_bits += 8 - (sdu->N_bits % 8);
             }
 
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      sdu,
-                                      "Sending PDU for RNTI=%u and RB=%s",
-                                      sdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                              sdu,
+                              "Sending PDU for RNTI=%u and RB=%s",
+                              sdu_ready->user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
 
             // Convert from bit to byte struct
             sdu_ptr = sdu->msg;
@@ -405,14 +397,13 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
             // Increment the SN
             sdu_ready->rb->set_pdcp_tx_count(contents.count + 1);
 
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      &pdu,
-                                      "Sending PDU for RNTI=%u and RB=%s",
-                                      sdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                              &pdu,
+                              "Sending PDU for RNTI=%u and RB=%s",
+                              sdu_ready->user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
 
             // Queue the PDU for RLC
             sdu_ready->rb->queue_rlc_sdu(&pdu);
@@ -428,23 +419,21 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
             // Delete the SDU
             sdu_ready->rb->delete_next_pdcp_sdu();
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      sdu,
-                                      "Received SDU for RNTI=%u with invalid RB=%s",
-                                      sdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                              sdu,
+                              "Received SDU for RNTI=%u with invalid RB=%s",
+                              sdu_ready->user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received SDU ready with no data, RNTI=%u, RB=%s",
-                                  sdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                          "Received SDU ready with no data, RNTI=%u, RB=%s",
+                          sdu_ready->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
     }
 }
 
@@ -460,14 +449,13 @@ void LTE_fdd_enb_pdcp::handle_data_sdu_ready(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG
 
     if(LTE_FDD_ENB_ERROR_NONE == data_sdu_ready->rb->get_next_pdcp_data_sdu(&sdu))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                  __FILE__,
-                                  __LINE__,
-                                  sdu,
-                                  "Received data SDU from GW for RNTI=%u and RB=%s",
-                                  data_sdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                          sdu,
+                          "Received data SDU from GW for RNTI=%u and RB=%s",
+                          data_sdu_ready->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
 
         if(data_sdu_ready->rb->get_rb_id()       >= LTE_FDD_ENB_RB_DRB1 &&
            data_sdu_ready->rb->get_pdcp_config() == LTE_FDD_ENB_PDCP_CONFIG_LONG_SN)
@@ -481,14 +469,13 @@ void LTE_fdd_enb_pdcp::handle_data_sdu_ready(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG
             // Increment the SN
             data_sdu_ready->rb->set_pdcp_tx_count(contents.count + 1);
 
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      &pdu,
-                                      "Sending PDU for RNTI=%u and RB=%s",
-                                      data_sdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                              &pdu,
+                              "Sending PDU for RNTI=%u and RB=%s",
+                              data_sdu_ready->user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
 
             // Queue the PDU for RLC
             data_sdu_ready->rb->queue_rlc_sdu(&pdu);
@@ -504,21 +491,19 @@ void LTE_fdd_enb_pdcp::handle_data_sdu_ready(LTE_FDD_ENB_PDCP_DATA_SDU_READY_MSG
             // Delete the SDU
             data_sdu_ready->rb->delete_next_pdcp_data_sdu();
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received data SDU from GW for invalid RB=%s, RNTI=%u",
-                                      LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()],
-                                      data_sdu_ready->user->get_c_rnti());
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                              "Received data SDU from GW for invalid RB=%s, RNTI=%u",
+                              LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()],
+                              data_sdu_ready->user->get_c_rnti());
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received data SDU ready from GW with no data, RNTI=%u, RB=%s",
-                                  data_sdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                          "Received data SDU ready from GW with no data, RNTI=%u, RB=%s",
+                          data_sdu_ready->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[data_sdu_ready->rb->get_rb_id()]);
     }
 }
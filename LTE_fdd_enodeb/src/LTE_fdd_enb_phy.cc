@@ -119,12 +119,17 @@ LTE_fdd_enb_phy::LTE_fdd_enb_phy()
     sem_init(&sys_info_sem, 0, 1);
     sem_init(&dl_sched_sem, 0, 1);
     sem_init(&ul_sched_sem, 0, 1);
-    interface = NULL;
-    started   = false;
+    interface      = NULL;
+    started        = false;
+    dl_template    = NULL;
+    dl_sched_free  = new LTE_fdd_enb_ring<LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT*>(LTE_FDD_ENB_N_SCHED_BUFS, false);
+    ul_sched_free  = new LTE_fdd_enb_ring<LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT*>(LTE_FDD_ENB_N_SCHED_BUFS, false);
 }
 LTE_fdd_enb_phy::~LTE_fdd_enb_phy()
 {
     stop();
+    delete ul_sched_free;
+    delete dl_sched_free;
     sem_destroy(&ul_sched_sem);
     sem_destroy(&dl_sched_sem);
     sem_destroy(&sys_info_sem);
@@ -138,21 +143,36 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_msgq      *from_mac,
                             bool                   direct_to_ue,
                             LTE_fdd_enb_interface *iface)
 {
-    LTE_fdd_enb_radio    *radio = LTE_fdd_enb_radio::get_instance();
-    LTE_fdd_enb_msgq_cb   mac_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_phy, &LTE_fdd_enb_phy::handle_mac_msg>, this);
-    libtools_ipc_msgq_cb  ue_cb(&libtools_ipc_msgq_cb_wrapper<LTE_fdd_enb_phy, &LTE_fdd_enb_phy::handle_ue_msg>, this);
-    LIBLTE_PHY_FS_ENUM    fs;
-    uint32                i;
-    uint32                j;
-    uint32                k;
-    uint32                samp_rate;
-    uint8                 prach_cnfg_idx;
+    LTE_fdd_enb_cnfg_db                *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
+    LTE_fdd_enb_radio                  *radio   = LTE_fdd_enb_radio::get_instance();
+    LTE_fdd_enb_msgq_cb                 mac_cb(&LTE_fdd_enb_msgq_cb_wrapper<LTE_fdd_enb_phy, &LTE_fdd_enb_phy::handle_mac_msg>, this);
+    libtools_ipc_msgq_cb                ue_cb(&libtools_ipc_msgq_cb_wrapper<LTE_fdd_enb_phy, &LTE_fdd_enb_phy::handle_ue_msg>, this);
+    LIBLTE_PHY_FS_ENUM                  fs;
+    std::string                         wisdom_file;
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched;
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched;
+    uint32                              i;
+    uint32                              j;
+    uint32                              k;
+    uint32                              samp_rate;
+    uint8                               prach_cnfg_idx;
 
     if(!started)
     {
         // Get the latest sys info
         update_sys_info();
 
+        // Load the FFTW wisdom before planning
+        cnfg_db->get_param(LTE_FDD_ENB_PARAM_FFTW_WISDOM_FILE, wisdom_file);
+        if(LIBLTE_SUCCESS != liblte_phy_set_fftw_wisdom_file(wisdom_file.c_str()))
+        {
+            LTE_FDD_ENB_DEBUG(iface,
+                              LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                              "Invalid FFTW wisdom file %s",
+                              wisdom_file.c_str());
+        }
+
         // Initialize phy
         samp_rate = radio->get_phy_sample_rate();
         if(30720000 == samp_rate)
@@ -167,12 +187,11 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_msgq      *from_mac,
         }else if(1920000 == samp_rate){
             fs = LIBLTE_PHY_FS_1_92MHZ;
         }else{
-            iface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PHY,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Invalid sample rate %u",
-                                  samp_rate);
+            LTE_FDD_ENB_DEBUG(iface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                              "Invalid sample rate %u",
+                              samp_rate);
         }
         liblte_phy_init(&phy_struct,
                         fs,
@@ -196,14 +215,30 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_msgq      *from_mac,
                            sys_info.sib2.rr_config_common_sib.pucch_cnfg.delta_pucch_shift);
 
         // Downlink
+        dl_template = new float[10*LIBLTE_PHY_N_ANT_MAX*14*2*phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl];
+        build_dl_templates();
+        // The PHY holds one schedule buffer per subframe, the rest of
+        // the pool is free for the MAC to fill in and hand over
+        for(i=0; i<LTE_FDD_ENB_N_SCHED_BUFS; i++)
+        {
+            dl_sched_free->pop(&dl_sched);
+            ul_sched_free->pop(&ul_sched);
+        }
         for(i=0; i<10; i++)
         {
-            dl_schedule[i].current_tti            = i;
-            dl_schedule[i].dl_allocations.N_alloc = 0;
-            dl_schedule[i].ul_allocations.N_alloc = 0;
-            ul_schedule[i].current_tti            = i;
-            ul_schedule[i].decodes.N_alloc        = 0;
-            ul_schedule[i].N_pucch                = 0;
+            dl_schedule[i]                         = &dl_sched_pool[i];
+            ul_schedule[i]                         = &ul_sched_pool[i];
+            dl_schedule[i]->current_tti            = i;
+            dl_schedule[i]->dl_allocations.N_alloc = 0;
+            dl_schedule[i]->ul_allocations.N_alloc = 0;
+            ul_schedule[i]->current_tti            = i;
+            ul_schedule[i]->decodes.N_alloc        = 0;
+            ul_schedule[i]->N_pucch                = 0;
+        }
+        for(i=10; i<LTE_FDD_ENB_N_SCHED_BUFS; i++)
+        {
+            dl_sched_free->push(&dl_sched_pool[i]);
+            ul_sched_free->push(&ul_sched_pool[i]);
         }
         pcfich.cfi = 2; // FIXME: Make this dynamic every subfr
         for(i=0; i<10; i++)
@@ -341,6 +376,9 @@ void LTE_fdd_enb_phy::stop(void)
 
         liblte_phy_ul_cleanup(phy_struct);
         liblte_phy_cleanup(phy_struct);
+
+        delete [] dl_template;
+        dl_template = NULL;
     }
 }
 
@@ -353,6 +391,11 @@ void LTE_fdd_enb_phy::update_sys_info(void)
     LTE_fdd_enb_cnfg_db  *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
 
     cnfg_db->get_sys_info(sys_info);
+
+    if(started)
+    {
+        build_dl_templates();
+    }
 }
 uint32 LTE_fdd_enb_phy::get_n_cce(void)
 {
@@ -373,6 +416,34 @@ void LTE_fdd_enb_phy::get_current_ttis(uint32 *dl_tti,
     *dl_tti = dl_current_tti;
     *ul_tti = ul_current_tti;
 }
+LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT* LTE_fdd_enb_phy::get_dl_sched_buf(void)
+{
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched = NULL;
+
+    dl_sched_free->pop(&dl_sched);
+
+    return(dl_sched);
+}
+LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT* LTE_fdd_enb_phy::get_ul_sched_buf(void)
+{
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched = NULL;
+
+    ul_sched_free->pop(&ul_sched);
+
+    return(ul_sched);
+}
+void LTE_fdd_enb_phy::free_sched_bufs(LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched,
+                                      LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched)
+{
+    if(NULL != dl_sched)
+    {
+        dl_sched_free->push(dl_sched);
+    }
+    if(NULL != ul_sched)
+    {
+        ul_sched_free->push(ul_sched);
+    }
+}
 
 /***********************/
 /*    Communication    */
@@ -388,21 +459,19 @@ void LTE_fdd_enb_phy::handle_mac_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_phy_schedule(&msg.msg.phy_schedule);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PHY,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                              "Received invalid message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PHY,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received message for invalid layer %s",
-                                  LTE_fdd_enb_dest_layer_text[msg.dest_layer]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                          "Received message for invalid layer %s",
+                          LTE_fdd_enb_dest_layer_text[msg.dest_layer]);
     }
 }
 void LTE_fdd_enb_phy::handle_ue_msg(LIBTOOLS_IPC_MSGQ_MESSAGE_STRUCT *msg)
@@ -413,12 +482,11 @@ void LTE_fdd_enb_phy::handle_ue_msg(LIBTOOLS_IPC_MSGQ_MESSAGE_STRUCT *msg)
         msgq_to_ue = NULL;
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PHY,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received invalid UE message %s",
-                                  libtools_ipc_msgq_message_type_text[msg->type]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                          "Received invalid UE message %s",
+                          libtools_ipc_msgq_message_type_text[msg->type]);
         break;
     }
 }
@@ -456,72 +524,132 @@ void LTE_fdd_enb_phy::radio_interface(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
 /******************/
 void LTE_fdd_enb_phy::handle_phy_schedule(LTE_FDD_ENB_PHY_SCHEDULE_MSG_STRUCT *phy_sched)
 {
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched = phy_sched->dl_sched;
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT *ul_sched = phy_sched->ul_sched;
+
     sem_wait(&dl_sched_sem);
     sem_wait(&ul_sched_sem);
 
-    if(phy_sched->dl_sched.current_tti                    < dl_current_tti &&
-       (dl_current_tti - phy_sched->dl_sched.current_tti) < (LTE_FDD_ENB_CURRENT_TTI_MAX/2))
+    if(phy_sched->dl_sched->current_tti                    < dl_current_tti &&
+       (dl_current_tti - phy_sched->dl_sched->current_tti) < (LTE_FDD_ENB_CURRENT_TTI_MAX/2))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PHY,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Late DL subframe from MAC:%u, PHY is currently on %u",
-                                  phy_sched->dl_sched.current_tti,
-                                  dl_current_tti);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                          "Late DL subframe from MAC:%u, PHY is currently on %u",
+                          phy_sched->dl_sched->current_tti,
+                          dl_current_tti);
 
         late_subfr = true;
-        if(phy_sched->dl_sched.current_tti == last_rts_current_tti)
+        if(phy_sched->dl_sched->current_tti == last_rts_current_tti)
         {
             late_subfr = false;
         }
     }else{
-        if(phy_sched->dl_sched.dl_allocations.N_alloc ||
-           phy_sched->dl_sched.ul_allocations.N_alloc)
+        if(phy_sched->dl_sched->dl_allocations.N_alloc ||
+           phy_sched->dl_sched->ul_allocations.N_alloc)
         {
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PHY,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received PDSCH schedule from MAC CURRENT_TTI:MAC=%u,PHY=%u N_dl_allocs=%u N_ul_allocs=%u",
-                                      phy_sched->dl_sched.current_tti,
-                                      dl_current_tti,
-                                      phy_sched->dl_sched.dl_allocations.N_alloc,
-                                      phy_sched->dl_sched.ul_allocations.N_alloc);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                              "Received PDSCH schedule from MAC CURRENT_TTI:MAC=%u,PHY=%u N_dl_allocs=%u N_ul_allocs=%u",
+                              phy_sched->dl_sched->current_tti,
+                              dl_current_tti,
+                              phy_sched->dl_sched->dl_allocations.N_alloc,
+                              phy_sched->dl_sched->ul_allocations.N_alloc);
         }
 
-        memcpy(&dl_schedule[phy_sched->dl_sched.current_tti%10], &phy_sched->dl_sched, sizeof(LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT));
+        // Swap the schedule in and free the one it replaces
+        dl_sched                                         = dl_schedule[phy_sched->dl_sched->current_tti%10];
+        dl_schedule[phy_sched->dl_sched->current_tti%10] = phy_sched->dl_sched;
 
         late_subfr = false;
     }
-    if(phy_sched->ul_sched.current_tti                    < ul_current_tti &&
-       (ul_current_tti - phy_sched->ul_sched.current_tti) < (LTE_FDD_ENB_CURRENT_TTI_MAX/2))
+    if(phy_sched->ul_sched->current_tti                    < ul_current_tti &&
+       (ul_current_tti - phy_sched->ul_sched->current_tti) < (LTE_FDD_ENB_CURRENT_TTI_MAX/2))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PHY,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Late UL subframe from MAC:%u, PHY is currently on %u",
-                                  phy_sched->ul_sched.current_tti,
-                                  ul_current_tti);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                          "Late UL subframe from MAC:%u, PHY is currently on %u",
+                          phy_sched->ul_sched->current_tti,
+                          ul_current_tti);
     }else{
-        if(phy_sched->ul_sched.decodes.N_alloc)
+        if(phy_sched->ul_sched->decodes.N_alloc)
         {
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PHY,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received PUSCH schedule from MAC CURRENT_TTI:MAC=%u,PHY=%u N_ul_decodes=%u",
-                                      phy_sched->ul_sched.current_tti,
-                                      ul_current_tti,
-                                      phy_sched->ul_sched.decodes.N_alloc);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                              "Received PUSCH schedule from MAC CURRENT_TTI:MAC=%u,PHY=%u N_ul_decodes=%u",
+                              phy_sched->ul_sched->current_tti,
+                              ul_current_tti,
+                              phy_sched->ul_sched->decodes.N_alloc);
         }
 
-        memcpy(&ul_schedule[phy_sched->ul_sched.current_tti%10], &phy_sched->ul_sched, sizeof(LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT));
+        // Swap the schedule in and free the one it replaces
+        ul_sched                                         = ul_schedule[phy_sched->ul_sched->current_tti%10];
+        ul_schedule[phy_sched->ul_sched->current_tti%10] = phy_sched->ul_sched;
     }
 
     sem_post(&ul_sched_sem);
     sem_post(&dl_sched_sem);
+
+    // Late schedules are freed without being used
+    dl_sched_free->push(dl_sched);
+    ul_sched_free->push(ul_sched);
+}
+void LTE_fdd_enb_phy::build_dl_templates(void)
+{
+    uint32 N_sc = phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl;
+    uint32 subfn;
+    uint32 p;
+    uint32 i;
+    uint32 idx;
+
+    // The PSS, SSS, and CRS only depend on the cell and the subframe
+    // number, so they are mapped once per subframe number instead of
+    // every subframe
+    for(subfn=0; subfn<10; subfn++)
+    {
+        for(p=0; p<sys_info.N_ant; p++)
+        {
+            for(i=0; i<14; i++)
+            {
+                liblte_phy_clear_tx_symb(&dl_subframe, p, i, N_sc);
+            }
+        }
+        dl_subframe.num = subfn;
+
+        // Handle PSS and SSS
+        if(0 == dl_subframe.num ||
+           5 == dl_subframe.num)
+        {
+            liblte_phy_map_pss(phy_struct,
+                               &dl_subframe,
+                               sys_info.N_id_2,
+                               sys_info.N_ant);
+            liblte_phy_map_sss(phy_struct,
+                               &dl_subframe,
+                               sys_info.N_id_1,
+                               sys_info.N_id_2,
+                               sys_info.N_ant);
+        }
+
+        // Handle CRS
+        liblte_phy_map_crs(phy_struct,
+                           &dl_subframe,
+                           sys_info.N_id_cell,
+                           sys_info.N_ant);
+
+        for(p=0; p<sys_info.N_ant; p++)
+        {
+            for(i=0; i<14; i++)
+            {
+                idx = ((subfn*LIBLTE_PHY_N_ANT_MAX + p)*14 + i)*2*N_sc;
+                liblte_phy_save_tx_symb(&dl_subframe, p, i, N_sc, &dl_template[idx]);
+            }
+        }
+    }
 }
 void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
 {
@@ -535,42 +663,20 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     uint32                                act_noutput_items;
     uint32                                sfn   = dl_current_tti/10;
     uint32                                subfn = dl_current_tti%10;
+    uint32                                N_sc  = phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl;
+    uint32                                idx;
 
-    // Initialize the output to all zeros
+    // Start from the PSS, SSS, and CRS of this subframe
     for(p=0; p<sys_info.N_ant; p++)
     {
         for(i=0; i<14; i++)
         {
-            for(j=0; j<LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP; j++)
-            {
-                dl_subframe.tx_symb_re[p][i][j] = 0;
-                dl_subframe.tx_symb_im[p][i][j] = 0;
-            }
+            idx = ((subfn*LIBLTE_PHY_N_ANT_MAX + p)*14 + i)*2*N_sc;
+            liblte_phy_load_tx_symb(&dl_subframe, p, i, N_sc, &dl_template[idx]);
         }
     }
     dl_subframe.num = subfn;
 
-    // Handle PSS and SSS
-    if(0 == dl_subframe.num ||
-       5 == dl_subframe.num)
-    {
-        liblte_phy_map_pss(phy_struct,
-                           &dl_subframe,
-                           sys_info.N_id_2,
-                           sys_info.N_ant);
-        liblte_phy_map_sss(phy_struct,
-                           &dl_subframe,
-                           sys_info.N_id_1,
-                           sys_info.N_id_2,
-                           sys_info.N_ant);
-    }
-
-    // Handle CRS
-    liblte_phy_map_crs(phy_struct,
-                       &dl_subframe,
-                       sys_info.N_id_cell,
-                       sys_info.N_ant);
-
     // Handle PBCH
     if(0 == dl_subframe.num)
     {
@@ -689,27 +795,26 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
 
     // Handle user data
     sem_wait(&dl_sched_sem);
-    if(dl_schedule[dl_current_tti%10].current_tti == dl_current_tti)
+    if(dl_schedule[dl_current_tti%10]->current_tti == dl_current_tti)
     {
-        for(i=0; i<dl_schedule[subfn].dl_allocations.N_alloc; i++)
+        for(i=0; i<dl_schedule[subfn]->dl_allocations.N_alloc; i++)
         {
-            memcpy(&pdcch.alloc[pdcch.N_alloc], &dl_schedule[subfn].dl_allocations.alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+            memcpy(&pdcch.alloc[pdcch.N_alloc], &dl_schedule[subfn]->dl_allocations.alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
             pdcch.alloc[pdcch.N_alloc++].dl_alloc = true;
         }
-        for(i=0; i<dl_schedule[subfn].ul_allocations.N_alloc; i++)
+        for(i=0; i<dl_schedule[subfn]->ul_allocations.N_alloc; i++)
         {
-            memcpy(&pdcch.alloc[pdcch.N_alloc], &dl_schedule[subfn].ul_allocations.alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+            memcpy(&pdcch.alloc[pdcch.N_alloc], &dl_schedule[subfn]->ul_allocations.alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
             pdcch.alloc[pdcch.N_alloc++].dl_alloc = false;
         }
     }else{
         late_subfr = true;
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PHY,
-                                  __FILE__,
-                                  __LINE__,
-                                  "PDSCH current_tti from MAC (%u) does not match PHY (%u)",
-                                  dl_schedule[subfn].current_tti,
-                                  dl_current_tti);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                          "PDSCH current_tti from MAC (%u) does not match PHY (%u)",
+                          dl_schedule[subfn]->current_tti,
+                          dl_current_tti);
     }
     sem_post(&dl_sched_sem);
 
@@ -727,11 +832,10 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     }
     if(last_prb > phy_struct->N_rb_dl)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_PHY,
-                                  __FILE__,
-                                  __LINE__,
-                                  "More PRBs allocated than are available");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                          "More PRBs allocated than are available");
     }else{
         liblte_phy_pdcch_channel_encode(phy_struct,
                                         &pcfich,
@@ -762,11 +866,18 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
 
     for(p=0; p<sys_info.N_ant; p++)
     {
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+        liblte_phy_create_dl_subframe_cf(phy_struct,
+                                         &dl_subframe,
+                                         p,
+                                         &tx_buf->samps[p][0]);
+#else
         liblte_phy_create_dl_subframe(phy_struct,
                                       &dl_subframe,
                                       p,
                                       &tx_buf->i_buf[p][0],
                                       &tx_buf->q_buf[p][0]);
+#endif
     }
     tx_buf->N_samps_per_ant = phy_struct->N_samps_per_subfr;
     tx_buf->current_tti     = dl_current_tti;
@@ -829,6 +940,14 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
                true            == prach_subfn_zero_allowed)
             {
                 prach_decode.current_tti = ul_current_tti;
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+                liblte_phy_detect_prach_cf(phy_struct,
+                                           rx_buf->samps[0],
+                                           sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_freq_offset,
+                                           &prach_decode.num_preambles,
+                                           prach_decode.preamble,
+                                           prach_decode.timing_adv);
+#else
                 liblte_phy_detect_prach(phy_struct,
                                         rx_buf->i_buf[0],
                                         rx_buf->q_buf[0],
@@ -836,6 +955,7 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
                                         &prach_decode.num_preambles,
                                         prach_decode.preamble,
                                         prach_decode.timing_adv);
+#endif
 
                 msgq_to_mac->send(LTE_FDD_ENB_MESSAGE_TYPE_PRACH_DECODE,
                                   LTE_FDD_ENB_DEST_LAYER_MAC,
@@ -846,30 +966,36 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
     }
 
     sem_wait(&ul_sched_sem);
-    if(0 != ul_schedule[ul_subframe.num].N_pucch ||
-       0 != ul_schedule[ul_subframe.num].decodes.N_alloc)
+    if(0 != ul_schedule[ul_subframe.num]->N_pucch ||
+       0 != ul_schedule[ul_subframe.num]->decodes.N_alloc)
     {
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+        subfr_err = liblte_phy_get_ul_subframe_cf(phy_struct,
+                                                  rx_buf->samps[0],
+                                                  &ul_subframe);
+#else
         subfr_err = liblte_phy_get_ul_subframe(phy_struct,
                                                rx_buf->i_buf[0],
                                                rx_buf->q_buf[0],
                                                &ul_subframe);
+#endif
     }
 
     // Handle PUCCH
     if(LIBLTE_SUCCESS == subfr_err &&
-       0              != ul_schedule[ul_subframe.num].N_pucch)
+       0              != ul_schedule[ul_subframe.num]->N_pucch)
     {
         pucch_decode.current_tti = ul_current_tti;
-        for(i=0; i<ul_schedule[ul_subframe.num].N_pucch; i++)
+        for(i=0; i<ul_schedule[ul_subframe.num]->N_pucch; i++)
         {
-            pucch_decode.rnti = ul_schedule[ul_subframe.num].pucch[i].rnti;
-            pucch_decode.type = ul_schedule[ul_subframe.num].pucch[i].type;
+            pucch_decode.rnti = ul_schedule[ul_subframe.num]->pucch[i].rnti;
+            pucch_decode.type = ul_schedule[ul_subframe.num]->pucch[i].type;
             pucch_err = liblte_phy_pucch_format_1_1a_1b_channel_decode(phy_struct,
                                                                        &ul_subframe,
                                                                        LIBLTE_PHY_PUCCH_FORMAT_1B,
                                                                        sys_info.N_id_cell,
                                                                        sys_info.N_ant,
-                                                                       ul_schedule[ul_subframe.num].pucch[i].n_1_p_pucch,
+                                                                       ul_schedule[ul_subframe.num]->pucch[i].n_1_p_pucch,
                                                                        pucch_decode.msg.msg,
                                                                        &pucch_decode.msg.N_bits);
             if(LTE_FDD_ENB_PUCCH_TYPE_ACK_NACK == pucch_decode.type)
@@ -894,30 +1020,30 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
             }
         }
     }
-    ul_schedule[ul_subframe.num].N_pucch = 0;
+    ul_schedule[ul_subframe.num]->N_pucch = 0;
 
     // Handle PUSCH
     if(LIBLTE_SUCCESS == subfr_err &&
-       0              != ul_schedule[ul_subframe.num].decodes.N_alloc)
+       0              != ul_schedule[ul_subframe.num]->decodes.N_alloc)
     {
-        for(i=0; i<ul_schedule[ul_subframe.num].decodes.N_alloc; i++)
+        for(i=0; i<ul_schedule[ul_subframe.num]->decodes.N_alloc; i++)
         {
             // Determine PHICH indecies
-            I_prb_ra      = ul_schedule[ul_subframe.num].decodes.alloc[i].prb[0][0];
+            I_prb_ra      = ul_schedule[ul_subframe.num]->decodes.alloc[i].prb[0][0];
             n_group_phich = I_prb_ra % phy_struct->N_group_phich;
             n_seq_phich   = (I_prb_ra/phy_struct->N_group_phich) % (2*phy_struct->N_sf_phich);
 
             // Attempt decode
             if(LIBLTE_SUCCESS == liblte_phy_pusch_channel_decode(phy_struct,
                                                                  &ul_subframe,
-                                                                 &ul_schedule[ul_subframe.num].decodes.alloc[i],
+                                                                 &ul_schedule[ul_subframe.num]->decodes.alloc[i],
                                                                  sys_info.N_id_cell,
                                                                  1,
                                                                  pusch_decode.msg.msg,
                                                                  &pusch_decode.msg.N_bits))
             {
                 pusch_decode.current_tti = ul_current_tti;
-                pusch_decode.rnti        = ul_schedule[ul_subframe.num].decodes.alloc[i].rnti;
+                pusch_decode.rnti        = ul_schedule[ul_subframe.num]->decodes.alloc[i].rnti;
 
                 msgq_to_mac->send(LTE_FDD_ENB_MESSAGE_TYPE_PUSCH_DECODE,
                                   LTE_FDD_ENB_DEST_LAYER_MAC,
@@ -934,7 +1060,7 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
             }
         }
     }
-    ul_schedule[ul_subframe.num].decodes.N_alloc = 0;
+    ul_schedule[ul_subframe.num]->decodes.N_alloc = 0;
     sem_post(&ul_sched_sem);
 
     // Update counters
@@ -319,21 +319,28 @@ void LTE_fdd_enb_radio_usrp_b2x0::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf,
         metadata.time_spec = next_tx_ts;
         for(i=0; i<N_tx_samps; i++)
         {
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+            tx_buf[i] = gr_complex(buf->samps[0][idx+i].re/50.0, buf->samps[0][idx+i].im/50.0);
+            for(p=1; p<radio_params->N_ant; p++)
+            {
+                tx_buf[i] += gr_complex(buf->samps[p][idx+i].re/50.0, buf->samps[p][idx+i].im/50.0);
+            }
+#else
             tx_buf[i] = gr_complex(buf->i_buf[0][idx+i]/50.0, buf->q_buf[0][idx+i]/50.0);
             for(p=1; p<radio_params->N_ant; p++)
             {
                 tx_buf[i] += gr_complex(buf->i_buf[p][idx+i]/50.0, buf->q_buf[p][idx+i]/50.0);
             }
+#endif
             tx_buf[i] /= radio_params->N_ant;
         }
 #if EXTRA_RADIO_DEBUG
-        radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                                LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                __FILE__,
-                                                __LINE__,
-                                                "Sending subfr %lld %u",
-                                                metadata.time_spec.to_ticks(fs),
-                                                buf->current_tti);
+        LTE_FDD_ENB_DEBUG(radio_params->interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Sending subfr %lld %u",
+                          metadata.time_spec.to_ticks(fs),
+                          buf->current_tti);
 #endif
         tx_stream->send(tx_buf, N_tx_samps, metadata);
         idx           += N_tx_samps;
@@ -346,21 +353,28 @@ void LTE_fdd_enb_radio_usrp_b2x0::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf,
         metadata.time_spec = next_tx_ts;
         for(i=0; i<samps_to_send; i++)
         {
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+            tx_buf[i] = gr_complex(buf->samps[0][idx+i].re/50.0, buf->samps[0][idx+i].im/50.0);
+            for(p=1; p<radio_params->N_ant; p++)
+            {
+                tx_buf[i] += gr_complex(buf->samps[p][idx+i].re/50.0, buf->samps[p][idx+i].im/50.0);
+            }
+#else
             tx_buf[i] = gr_complex(buf->i_buf[0][idx+i]/50.0, buf->q_buf[0][idx+i]/50.0);
             for(p=1; p<radio_params->N_ant; p++)
             {
                 tx_buf[i] += gr_complex(buf->i_buf[p][idx+i]/50.0, buf->q_buf[p][idx+i]/50.0);
             }
+#endif
             tx_buf[i] /= radio_params->N_ant;
         }
 #if EXTRA_RADIO_DEBUG
-        radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                                LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                __FILE__,
-                                                __LINE__,
-                                                "Sending subfr %lld %u",
-                                                metadata.time_spec.to_ticks(fs),
-                                                buf->current_tti);
+        LTE_FDD_ENB_DEBUG(radio_params->interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Sending subfr %lld %u",
+                          metadata.time_spec.to_ticks(fs),
+                          buf->current_tti);
 #endif
         tx_stream->send(tx_buf, samps_to_send, metadata);
         next_tx_ts += uhd::time_spec_t::from_ticks(samps_to_send,
@@ -404,13 +418,12 @@ void LTE_fdd_enb_radio_usrp_b2x0::receive(LTE_FDD_ENB_RADIO_PARAMS_STRUCT *radio
 
         if(check_ts.to_ticks(radio_params->samp_rate) == next_rx_ts.to_ticks(radio_params->samp_rate))
         {
-            radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                                    LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                    __FILE__,
-                                                    __LINE__,
-                                                    "RX synced %lld %lld",
-                                                    check_ts.to_ticks(radio_params->samp_rate),
-                                                    next_rx_ts.to_ticks(radio_params->samp_rate));
+            LTE_FDD_ENB_DEBUG(radio_params->interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                              "RX synced %lld %lld",
+                              check_ts.to_ticks(radio_params->samp_rate),
+                              next_rx_ts.to_ticks(radio_params->samp_rate));
             radio_params->samp_idx  = 0;
             radio_params->rx_synced = true;
         }else{
@@ -418,13 +431,12 @@ void LTE_fdd_enb_radio_usrp_b2x0::receive(LTE_FDD_ENB_RADIO_PARAMS_STRUCT *radio
                                                      radio_params->samp_rate);
             if(check_ts.to_ticks(radio_params->samp_rate) > next_rx_ts.to_ticks(radio_params->samp_rate))
             {
-                radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                                        LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                        __FILE__,
-                                                        __LINE__,
-                                                        "RX modifying recv_size to sync %lld %lld",
-                                                        check_ts.to_ticks(radio_params->samp_rate),
-                                                        next_rx_ts.to_ticks(radio_params->samp_rate));
+                LTE_FDD_ENB_DEBUG(radio_params->interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                                  "RX modifying recv_size to sync %lld %lld",
+                                  check_ts.to_ticks(radio_params->samp_rate),
+                                  next_rx_ts.to_ticks(radio_params->samp_rate));
                 check_ts  -= uhd::time_spec_t::from_ticks(N_rx_samps, radio_params->samp_rate);
                 recv_size  = (uint32)(next_rx_ts.to_ticks(radio_params->samp_rate) - check_ts.to_ticks(radio_params->samp_rate));
             }
@@ -437,34 +449,31 @@ void LTE_fdd_enb_radio_usrp_b2x0::receive(LTE_FDD_ENB_RADIO_PARAMS_STRUCT *radio
             metadata_ts_ticks = metadata.time_spec.to_ticks(radio_params->samp_rate);
             if(radio_params->num_samps != N_rx_samps)
             {
-                radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                                        LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                        __FILE__,
-                                                        __LINE__,
-                                                        "RX packet size issue %u %u %lld %lld",
-                                                        radio_params->num_samps,
-                                                        N_rx_samps,
-                                                        metadata_ts_ticks,
-                                                        next_rx_ts_ticks);
+                LTE_FDD_ENB_DEBUG(radio_params->interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                                  "RX packet size issue %u %u %lld %lld",
+                                  radio_params->num_samps,
+                                  N_rx_samps,
+                                  metadata_ts_ticks,
+                                  next_rx_ts_ticks);
             }
             if((next_rx_ts_ticks - metadata_ts_ticks) > 1)
             {
                 // FIXME: Not sure this will ever happen
-                radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                                        LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                        __FILE__,
-                                                        __LINE__,
-                                                        "RX old time spec %lld %lld",
-                                                        metadata_ts_ticks,
-                                                        next_rx_ts_ticks);
+                LTE_FDD_ENB_DEBUG(radio_params->interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                                  "RX old time spec %lld %lld",
+                                  metadata_ts_ticks,
+                                  next_rx_ts_ticks);
             }else if((metadata_ts_ticks - next_rx_ts_ticks) > 1){
-                radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                                        LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                        __FILE__,
-                                                        __LINE__,
-                                                        "RX overrun %lld %lld",
-                                                        metadata_ts_ticks,
-                                                        next_rx_ts_ticks);
+                LTE_FDD_ENB_DEBUG(radio_params->interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                                  "RX overrun %lld %lld",
+                                  metadata_ts_ticks,
+                                  next_rx_ts_ticks);
 
                 // Determine how many subframes we are going to drop
                 radio_params->N_subfrs_dropped = ((metadata_ts_ticks - next_rx_ts_ticks)/radio_params->N_samps_per_subfr) + 2;
@@ -497,23 +506,28 @@ void LTE_fdd_enb_radio_usrp_b2x0::receive(LTE_FDD_ENB_RADIO_PARAMS_STRUCT *radio
                 {
                     if((radio_params->samp_idx + radio_params->num_samps) <= radio_params->N_samps_per_subfr)
                     {
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+                        memcpy(&radio_params->rx_radio_buf[radio_params->buf_idx].samps[0][radio_params->samp_idx],
+                               &rx_buf[radio_params->recv_idx],
+                               sizeof(gr_complex)*radio_params->num_samps);
+#else
                         for(i=0; i<radio_params->num_samps; i++)
                         {
                             radio_params->rx_radio_buf[radio_params->buf_idx].i_buf[0][radio_params->samp_idx+i] = rx_buf[radio_params->recv_idx+i].real();
                             radio_params->rx_radio_buf[radio_params->buf_idx].q_buf[0][radio_params->samp_idx+i] = rx_buf[radio_params->recv_idx+i].imag();
                         }
+#endif
                         radio_params->samp_idx += radio_params->num_samps;
 
                         if(radio_params->samp_idx == radio_params->N_samps_per_subfr)
                         {
 #if EXTRA_RADIO_DEBUG
-                            radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                                                    LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                                    __FILE__,
-                                                                    __LINE__,
-                                                                    "Receiving subfr %lld %u",
-                                                                    next_rx_subfr_ts.to_ticks(radio_params->samp_rate),
-                                                                    radio_params->rx_current_tti);
+                            LTE_FDD_ENB_DEBUG(radio_params->interface,
+                                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                              LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                                              "Receiving subfr %lld %u",
+                                              next_rx_subfr_ts.to_ticks(radio_params->samp_rate),
+                                              radio_params->rx_current_tti);
 #endif
                             radio_params->rx_radio_buf[radio_params->buf_idx].current_tti = radio_params->rx_current_tti;
                             radio_params->phy->radio_interface(&radio_params->tx_radio_buf[radio_params->buf_idx],
@@ -526,19 +540,24 @@ void LTE_fdd_enb_radio_usrp_b2x0::receive(LTE_FDD_ENB_RADIO_PARAMS_STRUCT *radio
                         }
                         radio_params->num_samps = 0;
                     }else{
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+                        memcpy(&radio_params->rx_radio_buf[radio_params->buf_idx].samps[0][radio_params->samp_idx],
+                               &rx_buf[radio_params->recv_idx],
+                               sizeof(gr_complex)*(radio_params->N_samps_per_subfr - radio_params->samp_idx));
+#else
                         for(i=0; i<(radio_params->N_samps_per_subfr - radio_params->samp_idx); i++)
                         {
                             radio_params->rx_radio_buf[radio_params->buf_idx].i_buf[0][radio_params->samp_idx+i] = rx_buf[radio_params->recv_idx+i].real();
                             radio_params->rx_radio_buf[radio_params->buf_idx].q_buf[0][radio_params->samp_idx+i] = rx_buf[radio_params->recv_idx+i].imag();
                         }
+#endif
 #if EXTRA_RADIO_DEBUG
-                        radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                                                LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                                __FILE__,
-                                                                __LINE__,
-                                                                "Receiving subfr %lld %u",
-                                                                next_rx_subfr_ts.to_ticks(radio_params->samp_rate),
-                                                                radio_params->rx_current_tti);
+                        LTE_FDD_ENB_DEBUG(radio_params->interface,
+                                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                                          "Receiving subfr %lld %u",
+                                          next_rx_subfr_ts.to_ticks(radio_params->samp_rate),
+                                          radio_params->rx_current_tti);
 #endif
                         radio_params->rx_radio_buf[radio_params->buf_idx].current_tti = radio_params->rx_current_tti;
                         radio_params->phy->radio_interface(&radio_params->tx_radio_buf[radio_params->buf_idx],
@@ -554,12 +573,11 @@ void LTE_fdd_enb_radio_usrp_b2x0::receive(LTE_FDD_ENB_RADIO_PARAMS_STRUCT *radio
                 }
             }
         }else{
-            radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                                    LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                    __FILE__,
-                                                    __LINE__,
-                                                    "RX error %u",
-                                                    (uint32)metadata.error_code);
+            LTE_FDD_ENB_DEBUG(radio_params->interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                              "RX error %u",
+                              (uint32)metadata.error_code);
         }
     }
 }
@@ -598,12 +616,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
     // Only supporting N_ant=1
     if(1 != N_ant)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Not supported N_ant=%u",
-                                  N_ant);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Not supported N_ant=%u",
+                          N_ant);
         return(err);
     }
 
@@ -611,12 +628,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
     bladerf_idx = idx - find_usrps() - 1;
     if(bladerf_idx >= find_bladerfs())
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Incorrect bladerf index %u",
-                                  bladerf_idx);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Incorrect bladerf index %u",
+                          bladerf_idx);
         return(err);
     }
 
@@ -625,12 +641,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
     status = bladerf_open_with_devinfo(&bladerf, &devs[bladerf_idx]);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to open device: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to open device: %s",
+                          bladerf_strerror(status));
         return(err);
     }
 
@@ -640,12 +655,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                    liblte_interface_ul_earfcn_to_frequency(ul_earfcn));
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set RX frequency: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set RX frequency: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -657,12 +671,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                      NULL);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set RX sample rate: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set RX sample rate: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -674,12 +687,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                    NULL);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set RX bandwidth: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set RX bandwidth: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -690,12 +702,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                   BLADERF_LNA_GAIN_MID);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set LNA gain: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set LNA gain: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -706,12 +717,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                 BLADERF_RXVGA1_GAIN_MIN);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set RX VGA1 gain: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set RX VGA1 gain: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -722,12 +732,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                 BLADERF_RXVGA2_GAIN_MIN);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set RX VGA2 gain: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set RX VGA2 gain: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -738,12 +747,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                    liblte_interface_dl_earfcn_to_frequency(dl_earfcn));
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set TX frequency: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set TX frequency: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -755,12 +763,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                      NULL);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set TX sample rate: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set TX sample rate: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -772,12 +779,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                    NULL);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set TX bandwidth: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set TX bandwidth: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -788,12 +794,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                 BLADERF_TXVGA1_GAIN_MAX);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set TX VGA1 gain: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set TX VGA1 gain: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -804,12 +809,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                 BLADERF_TXVGA2_GAIN_MAX - 1);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set TX VGA2 gain: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set TX VGA2 gain: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -830,12 +834,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                  BLADERF_TIMEOUT_MS);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set TX sync config: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set TX sync config: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -850,12 +853,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
                                  BLADERF_TIMEOUT_MS);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to set RX sync config: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to set RX sync config: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -864,12 +866,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
     status = bladerf_enable_module(bladerf, BLADERF_MODULE_TX, true);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to enable TX module: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to enable TX module: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -878,12 +879,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio_bladerf::setup(uint32 idx,
     status = bladerf_enable_module(bladerf, BLADERF_MODULE_RX, true);
     if(0 != status)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Failed to enable RX module: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Failed to enable RX module: %s",
+                          bladerf_strerror(status));
         bladerf_close(bladerf);
         return(err);
     }
@@ -926,8 +926,13 @@ void LTE_fdd_enb_radio_bladerf::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf,
 
     for(i=0; i<samps_to_send; i++)
     {
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+        tx_buf[(i*2)  ] = (int16_t)(buf->samps[0][i].re * 40.0);
+        tx_buf[(i*2)+1] = (int16_t)(buf->samps[0][i].im * 40.0);
+#else
         tx_buf[(i*2)  ] = (int16_t)(buf->i_buf[0][i] * 40.0);
         tx_buf[(i*2)+1] = (int16_t)(buf->q_buf[0][i] * 40.0);
+#endif
     }
 
     if(first_tx_sample)
@@ -942,26 +947,23 @@ void LTE_fdd_enb_radio_bladerf::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf,
     if(BLADERF_ERR_TIME_PAST == status)
     {
         LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "TX failed: BLADERF_ERR_TIME_PAST");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "TX failed: BLADERF_ERR_TIME_PAST");
     }else if(0 != status){
         LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "TX failed: %s",
-                                  bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "TX failed: %s",
+                          bladerf_strerror(status));
     }else if(BLADERF_META_STATUS_UNDERRUN & metadata_tx.status){
         LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                  __FILE__,
-                                  __LINE__,
-                                  "TX failed: BLADERF_META_STATUS_UNDERRUN");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "TX failed: BLADERF_META_STATUS_UNDERRUN");
     }
 
     next_tx_ts += samps_to_send;
@@ -991,18 +993,16 @@ void LTE_fdd_enb_radio_bladerf::receive(LTE_FDD_ENB_RADIO_PARAMS_STRUCT *radio_p
     status = bladerf_sync_rx(bladerf, rx_buf, radio_params->N_samps_per_subfr, &metadata_rx, 1000);
     if(0 != status)
     {
-        radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                                LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                __FILE__,
-                                                __LINE__,
-                                                "RX failed: %s",
-                                                bladerf_strerror(status));
+        LTE_FDD_ENB_DEBUG(radio_params->interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "RX failed: %s",
+                          bladerf_strerror(status));
     }else if(BLADERF_META_STATUS_OVERRUN & metadata_rx.status){
-        radio_params->interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                                LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                __FILE__,
-                                                __LINE__,
-                                                "RX failed: BLADERF_META_STATUS_OVERRUN");
+        LTE_FDD_ENB_DEBUG(radio_params->interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "RX failed: BLADERF_META_STATUS_OVERRUN");
 
         // Determine how many subframes we are going to drop
         radio_params->N_subfrs_dropped = 10;
@@ -1015,8 +1015,13 @@ void LTE_fdd_enb_radio_bladerf::receive(LTE_FDD_ENB_RADIO_PARAMS_STRUCT *radio_p
     }else{
         for(i=0; i<radio_params->N_samps_per_subfr; i++)
         {
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+            radio_params->rx_radio_buf[radio_params->buf_idx].samps[0][i].re = rx_buf[(i*2)  ] / 40.0;
+            radio_params->rx_radio_buf[radio_params->buf_idx].samps[0][i].im = rx_buf[(i*2)+1] / 40.0;
+#else
             radio_params->rx_radio_buf[radio_params->buf_idx].i_buf[0][i] = rx_buf[(i*2)  ] / 40.0;
             radio_params->rx_radio_buf[radio_params->buf_idx].q_buf[0][i] = rx_buf[(i*2)+1] / 40.0;
+#endif
         }
         metadata_rx.timestamp                                         += radio_params->N_samps_per_subfr;
         radio_params->rx_radio_buf[radio_params->buf_idx].current_tti  = radio_params->rx_current_tti;
@@ -1409,12 +1414,11 @@ void LTE_fdd_enb_radio::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf)
         bladerf.send(buf, &radio_params);
         break;
     default:
-        radio_params.interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                               LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                               __FILE__,
-                                               __LINE__,
-                                               "Invalid radio type %u",
-                                               selected_radio_type);
+        LTE_FDD_ENB_DEBUG(radio_params.interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                          "Invalid radio type %u",
+                          selected_radio_type);
         break;
     }
 }
@@ -1468,12 +1472,11 @@ void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
             radio->bladerf.receive(&radio->radio_params);
             break;
         default:
-            radio->radio_params.interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                                          LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
-                                                          __FILE__,
-                                                          __LINE__,
-                                                          "Invalid radio type %u",
-                                                          radio_type);
+            LTE_FDD_ENB_DEBUG(radio->radio_params.interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                              "Invalid radio type %u",
+                              radio_type);
             return(NULL);
         }
     }
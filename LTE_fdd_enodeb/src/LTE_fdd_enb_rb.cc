@@ -320,15 +320,14 @@ void LTE_fdd_enb_rb::set_mme_procedure(LTE_FDD_ENB_MME_PROC_ENUM procedure)
 {
     LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RB,
-                              __FILE__,
-                              __LINE__,
-                              "%s MME procedure moving from %s to %s for RNTI=%u",
-                              LTE_fdd_enb_rb_text[rb],
-                              LTE_fdd_enb_mme_proc_text[mme_procedure],
-                              LTE_fdd_enb_mme_proc_text[procedure],
-                              user->get_c_rnti());
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RB,
+                      "%s MME procedure moving from %s to %s for RNTI=%u",
+                      LTE_fdd_enb_rb_text[rb],
+                      LTE_fdd_enb_mme_proc_text[mme_procedure],
+                      LTE_fdd_enb_mme_proc_text[procedure],
+                      user->get_c_rnti());
 
     mme_procedure = procedure;
 }
@@ -340,15 +339,14 @@ void LTE_fdd_enb_rb::set_mme_state(LTE_FDD_ENB_MME_STATE_ENUM state)
 {
     LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RB,
-                              __FILE__,
-                              __LINE__,
-                              "%s MME state moving from %s to %s for RNTI=%u",
-                              LTE_fdd_enb_rb_text[rb],
-                              LTE_fdd_enb_mme_state_text[mme_state],
-                              LTE_fdd_enb_mme_state_text[state],
-                              user->get_c_rnti());
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RB,
+                      "%s MME state moving from %s to %s for RNTI=%u",
+                      LTE_fdd_enb_rb_text[rb],
+                      LTE_fdd_enb_mme_state_text[mme_state],
+                      LTE_fdd_enb_mme_state_text[state],
+                      user->get_c_rnti());
 
     mme_state = state;
 }
@@ -388,15 +386,14 @@ void LTE_fdd_enb_rb::set_rrc_procedure(LTE_FDD_ENB_RRC_PROC_ENUM procedure)
 {
     LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RB,
-                              __FILE__,
-                              __LINE__,
-                              "%s RRC procedure moving from %s to %s for RNTI=%u",
-                              LTE_fdd_enb_rb_text[rb],
-                              LTE_fdd_enb_rrc_proc_text[rrc_procedure],
-                              LTE_fdd_enb_rrc_proc_text[procedure],
-                              user->get_c_rnti());
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RB,
+                      "%s RRC procedure moving from %s to %s for RNTI=%u",
+                      LTE_fdd_enb_rb_text[rb],
+                      LTE_fdd_enb_rrc_proc_text[rrc_procedure],
+                      LTE_fdd_enb_rrc_proc_text[procedure],
+                      user->get_c_rnti());
     rrc_procedure = procedure;
 }
 LTE_FDD_ENB_RRC_PROC_ENUM LTE_fdd_enb_rb::get_rrc_procedure(void)
@@ -407,15 +404,14 @@ void LTE_fdd_enb_rb::set_rrc_state(LTE_FDD_ENB_RRC_STATE_ENUM state)
 {
     LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RB,
-                              __FILE__,
-                              __LINE__,
-                              "%s RRC state moving from %s to %s for RNTI=%u",
-                              LTE_fdd_enb_rb_text[rb],
-                              LTE_fdd_enb_rrc_state_text[rrc_state],
-                              LTE_fdd_enb_rrc_state_text[state],
-                              user->get_c_rnti());
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RB,
+                      "%s RRC state moving from %s to %s for RNTI=%u",
+                      LTE_fdd_enb_rb_text[rb],
+                      LTE_fdd_enb_rrc_state_text[rrc_state],
+                      LTE_fdd_enb_rrc_state_text[state],
+                      user->get_c_rnti());
     rrc_state = state;
 }
 LTE_FDD_ENB_RRC_STATE_ENUM LTE_fdd_enb_rb::get_rrc_state(void)
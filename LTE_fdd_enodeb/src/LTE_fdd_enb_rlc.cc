@@ -169,12 +169,11 @@ void LTE_fdd_enb_rlc::handle_mac_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_pdu_ready(&msg.msg.rlc_pdu_ready);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid MAC message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                              "Received invalid MAC message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
@@ -193,12 +192,11 @@ void LTE_fdd_enb_rlc::handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_sdu_ready(&msg.msg.rlc_sdu_ready);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid PDCP message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                              "Received invalid PDCP message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
@@ -231,20 +229,19 @@ void LTE_fdd_enb_rlc::handle_retransmit(LIBLTE_RLC_SINGLE_AMD_PDU_STRUCT *amd,
     // Start t-pollretransmit
     rb->rlc_start_t_poll_retransmit();
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                              __FILE__,
-                              __LINE__,
-                              &pdu,
-                              "Re-sending AMD PDU for RNTI=%u, RB=%s, VT(A)=%u, SN=%u, VT(MS)=%u, RF=%s, P=%s, FI=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                              rb->get_rlc_vta(),
-                              amd->hdr.sn,
-                              rb->get_rlc_vtms(),
-                              liblte_rlc_rf_field_text[amd->hdr.rf],
-                              liblte_rlc_p_field_text[amd->hdr.p],
-                              liblte_rlc_fi_field_text[amd->hdr.fi]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                      &pdu,
+                      "Re-sending AMD PDU for RNTI=%u, RB=%s, VT(A)=%u, SN=%u, VT(MS)=%u, RF=%s, P=%s, FI=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                      rb->get_rlc_vta(),
+                      amd->hdr.sn,
+                      rb->get_rlc_vtms(),
+                      liblte_rlc_rf_field_text[amd->hdr.rf],
+                      liblte_rlc_p_field_text[amd->hdr.p],
+                      liblte_rlc_fi_field_text[amd->hdr.fi]);
 
     // Queue the SDU for MAC
     rb->queue_mac_sdu(&pdu);
@@ -267,14 +264,13 @@ void LTE_fdd_enb_rlc::handle_pdu_ready(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT *pdu
 
     if(LTE_FDD_ENB_ERROR_NONE == pdu_ready->rb->get_next_rlc_pdu(&pdu))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  pdu,
-                                  "Received PDU for RNTI=%u and RB=%s",
-                                  pdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                          pdu,
+                          "Received PDU for RNTI=%u and RB=%s",
+                          pdu_ready->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
 
         switch(pdu_ready->rb->get_rlc_config())
         {
@@ -288,26 +284,24 @@ void LTE_fdd_enb_rlc::handle_pdu_ready(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT *pdu
             handle_am_pdu(pdu, pdu_ready->user, pdu_ready->rb);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                      __FILE__,
-                                      __LINE__,
-                                      pdu,
-                                      "Received PDU for RNTI=%u, RB=%s, and invalid rlc_config=%s",
-                                      pdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()],
-                                      LTE_fdd_enb_rlc_config_text[pdu_ready->rb->get_rlc_config()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                              pdu,
+                              "Received PDU for RNTI=%u, RB=%s, and invalid rlc_config=%s",
+                              pdu_ready->user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()],
+                              LTE_fdd_enb_rlc_config_text[pdu_ready->rb->get_rlc_config()]);
             break;
         }
 
         // Delete the PDU
         pdu_ready->rb->delete_next_rlc_pdu();
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received pdu_ready message with no PDU queued");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                          "Received pdu_ready message with no PDU queued");
     }
 }
 void LTE_fdd_enb_rlc::handle_tm_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
@@ -344,18 +338,17 @@ void LTE_fdd_enb_rlc::handle_um_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
         if(!(vrul       <= umd.hdr.sn &&
              umd.hdr.sn  < vrur))
         {
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                      __FILE__,
-                                      __LINE__,
-                                      &umd.data[0],
-                                      "Received UMD PDU for RNTI=%u, RB=%s, VR(UL)=%d, SN=%u, VR(UR)=%u, FI=%s",
-                                      user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                      vrul,
-                                      umd.hdr.sn,
-                                      vrur,
-                                      liblte_rlc_fi_field_text[umd.hdr.fi]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                              &umd.data[0],
+                              "Received UMD PDU for RNTI=%u, RB=%s, VR(UL)=%d, SN=%u, VR(UR)=%u, FI=%s",
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                              vrul,
+                              umd.hdr.sn,
+                              vrur,
+                              liblte_rlc_fi_field_text[umd.hdr.fi]);
 
             if(1 == umd.N_data)
             {
@@ -421,32 +414,29 @@ void LTE_fdd_enb_rlc::handle_um_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                                        sizeof(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT));
                 }
             }else{
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                          __FILE__,
-                                          __LINE__,
-                                          "Multiple data segments (%u) in one RLC PDU",
-                                          umd.N_data);
+                LTE_FDD_ENB_DEBUG(interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                  "Multiple data segments (%u) in one RLC PDU",
+                                  umd.N_data);
             }
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                      __FILE__,
-                                      __LINE__,
-                                      &umd.data[0],
-                                      "Received UMD PDU for RNTI=%u, RB=%s, that is outside of the receiving window (%d <= %u < %u)",
-                                      user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                      vrul,
-                                      umd.hdr.sn,
-                                      vrur);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                              &umd.data[0],
+                              "Received UMD PDU for RNTI=%u, RB=%s, that is outside of the receiving window (%d <= %u < %u)",
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                              vrul,
+                              umd.hdr.sn,
+                              vrur);
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Can't unpack UMD PDU");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                          "Can't unpack UMD PDU");
     }
 }
 void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
@@ -470,33 +460,31 @@ void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
         }else{
             if(LIBLTE_RLC_RF_FIELD_AMD_PDU_SEGMENT == amd_pdus.pdu[0].hdr.rf)
             {
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                          __FILE__,
-                                          __LINE__,
-                                          &amd_pdus.pdu[0].data,
-                                          "Not handling AMD PDU segments");
+                LTE_FDD_ENB_DEBUG(interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                  &amd_pdus.pdu[0].data,
+                                  "Not handling AMD PDU segments");
             }else{
                 for(i=0; i<amd_pdus.N_pdu; i++)
                 {
                     if(vrr                    <= amd_pdus.pdu[i].hdr.sn &&
                        amd_pdus.pdu[i].hdr.sn <  vrmr)
                     {
-                        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                                  __FILE__,
-                                                  __LINE__,
-                                                  &amd_pdus.pdu[i].data,
-                                                  "Received AMD PDU for RNTI=%u, RB=%s, VR(R)=%u, SN=%u, VR(MR)=%u, VR(H)=%u, RF=%s, P=%s, FI=%s",
-                                                  user->get_c_rnti(),
-                                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                                  vrr,
-                                                  amd_pdus.pdu[i].hdr.sn,
-                                                  vrmr,
-                                                  vrh,
-                                                  liblte_rlc_rf_field_text[amd_pdus.pdu[i].hdr.rf],
-                                                  liblte_rlc_p_field_text[amd_pdus.pdu[i].hdr.p],
-                                                  liblte_rlc_fi_field_text[amd_pdus.pdu[i].hdr.fi]);
+                        LTE_FDD_ENB_DEBUG(interface,
+                                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                          &amd_pdus.pdu[i].data,
+                                          "Received AMD PDU for RNTI=%u, RB=%s, VR(R)=%u, SN=%u, VR(MR)=%u, VR(H)=%u, RF=%s, P=%s, FI=%s",
+                                          user->get_c_rnti(),
+                                          LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                          vrr,
+                                          amd_pdus.pdu[i].hdr.sn,
+                                          vrmr,
+                                          vrh,
+                                          liblte_rlc_rf_field_text[amd_pdus.pdu[i].hdr.rf],
+                                          liblte_rlc_p_field_text[amd_pdus.pdu[i].hdr.p],
+                                          liblte_rlc_fi_field_text[amd_pdus.pdu[i].hdr.fi]);
 
                         // Place RLC data PDU in reception buffer
                         rb->rlc_add_to_am_reception_buffer(&amd_pdus.pdu[i]);
@@ -538,18 +526,17 @@ void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
                             send_status_pdu(&status, user, rb);
                         }
                     }else{
-                        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                                  __FILE__,
-                                                  __LINE__,
-                                                  &amd_pdus.pdu[i].data,
-                                                  "Received AMD PDU for RNTI=%u, RB=%s, that is outside of the receiving window (%u <= %u < %u), P=%s",
-                                                  user->get_c_rnti(),
-                                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                                  vrr,
-                                                  amd_pdus.pdu[i].hdr.sn,
-                                                  vrmr,
-                                                  liblte_rlc_p_field_text[amd_pdus.pdu[i].hdr.p]);
+                        LTE_FDD_ENB_DEBUG(interface,
+                                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                          &amd_pdus.pdu[i].data,
+                                          "Received AMD PDU for RNTI=%u, RB=%s, that is outside of the receiving window (%u <= %u < %u), P=%s",
+                                          user->get_c_rnti(),
+                                          LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                          vrr,
+                                          amd_pdus.pdu[i].hdr.sn,
+                                          vrmr,
+                                          liblte_rlc_p_field_text[amd_pdus.pdu[i].hdr.p]);
 
 //                        if(amd_pdus.pdu[i].hdr.p)
                         {
@@ -562,11 +549,10 @@ void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
             }
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Can't unpack AMD PDU");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                          "Can't unpack AMD PDU");
     }
 }
 void LTE_fdd_enb_rlc::handle_status_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
@@ -579,12 +565,11 @@ void LTE_fdd_enb_rlc::handle_status_pdu(LIBLTE_BYTE_MSG_STRUCT *pdu,
 
     rb->rlc_update_transmission_buffer(&status);
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                              __FILE__,
-                              __LINE__,
-                              pdu,
-                              "Received STATUS PDU");
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                      pdu,
+                      "Received STATUS PDU");
 }
 
 /*******************************/
@@ -596,14 +581,13 @@ void LTE_fdd_enb_rlc::handle_sdu_ready(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT *sdu
 
     if(LTE_FDD_ENB_ERROR_NONE == sdu_ready->rb->get_next_rlc_sdu(&sdu))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  sdu,
-                                  "Received SDU for RNTI=%u and RB=%s",
-                                  sdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                          sdu,
+                          "Received SDU for RNTI=%u and RB=%s",
+                          sdu_ready->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
 
         switch(sdu_ready->rb->get_rlc_config())
         {
@@ -617,25 +601,23 @@ void LTE_fdd_enb_rlc::handle_sdu_ready(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT *sdu
             handle_am_sdu(sdu, sdu_ready->user, sdu_ready->rb);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received SDU for RNTI=%u, RB=%s, and invalid rlc_config=%s",
-                                      sdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()],
-                                      LTE_fdd_enb_rlc_config_text[sdu_ready->rb->get_rlc_config()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                              "Received SDU for RNTI=%u, RB=%s, and invalid rlc_config=%s",
+                              sdu_ready->user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()],
+                              LTE_fdd_enb_rlc_config_text[sdu_ready->rb->get_rlc_config()]);
             break;
         }
 
         // Delete the SDU
         sdu_ready->rb->delete_next_rlc_sdu();
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received sdu_ready message with no SDU queued");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                          "Received sdu_ready message with no SDU queued");
     }
 }
 void LTE_fdd_enb_rlc::handle_tm_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu,
@@ -644,14 +626,13 @@ void LTE_fdd_enb_rlc::handle_tm_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu,
 {
     LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT mac_sdu_ready;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                              __FILE__,
-                              __LINE__,
-                              sdu,
-                              "Sending TMD PDU for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                      sdu,
+                      "Sending TMD PDU for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the SDU for MAC
     rb->queue_mac_sdu(sdu);
@@ -686,16 +667,15 @@ void LTE_fdd_enb_rlc::handle_um_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu,
         rb->set_rlc_vtus(vtus+1);
         liblte_rlc_pack_umd_pdu(&umd, &pdu);
 
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  &pdu,
-                                  "Sending UMD PDU for RNTI=%u, RB=%s, SN=%u, FI=%s",
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                  umd.hdr.sn,
-                                  liblte_rlc_fi_field_text[umd.hdr.fi]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                          &pdu,
+                          "Sending UMD PDU for RNTI=%u, RB=%s, SN=%u, FI=%s",
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                          umd.hdr.sn,
+                          liblte_rlc_fi_field_text[umd.hdr.fi]);
 
         // Queue the PDU for MAC
         rb->queue_mac_sdu(&pdu);
@@ -736,16 +716,15 @@ void LTE_fdd_enb_rlc::handle_um_sdu(LIBLTE_BYTE_MSG_STRUCT *sdu,
             vtus = rb->get_rlc_vtus();
             liblte_rlc_pack_umd_pdu(&umd, &pdu);
 
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                      __FILE__,
-                                      __LINE__,
-                                      &pdu,
-                                      "Sending UMD PDU for RNTI=%u, RB=%s, SN=%u, FI=%s",
-                                      user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                      umd.hdr.sn,
-                                      liblte_rlc_fi_field_text[umd.hdr.fi]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                              &pdu,
+                              "Sending UMD PDU for RNTI=%u, RB=%s, SN=%u, FI=%s",
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                              umd.hdr.sn,
+                              liblte_rlc_fi_field_text[umd.hdr.fi]);
 
             // Queue the PDU for MAC
             rb->queue_mac_sdu(&pdu);
@@ -829,14 +808,13 @@ void LTE_fdd_enb_rlc::send_status_pdu(LIBLTE_RLC_STATUS_PDU_STRUCT *status_pdu,
     // Pack the PDU
     liblte_rlc_pack_status_pdu(status_pdu, &mac_sdu);
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                              __FILE__,
-                              __LINE__,
-                              &mac_sdu,
-                              "Sending STATUS PDU for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                      &mac_sdu,
+                      "Sending STATUS PDU for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the PDU for MAC
     rb->queue_mac_sdu(&mac_sdu);
@@ -870,20 +848,19 @@ void LTE_fdd_enb_rlc::send_amd_pdu(LIBLTE_RLC_SINGLE_AMD_PDU_STRUCT *amd,
     if(vta         <= amd->hdr.sn &&
        amd->hdr.sn <  vtms)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  &pdu,
-                                  "Sending AMD PDU for RNTI=%u, RB=%s, VT(A)=%u, SN=%u, VT(MS)=%u, RF=%s, P=%s, FI=%s",
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                  vta,
-                                  amd->hdr.sn,
-                                  vtms,
-                                  liblte_rlc_rf_field_text[amd->hdr.rf],
-                                  liblte_rlc_p_field_text[amd->hdr.p],
-                                  liblte_rlc_fi_field_text[amd->hdr.fi]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                          &pdu,
+                          "Sending AMD PDU for RNTI=%u, RB=%s, VT(A)=%u, SN=%u, VT(MS)=%u, RF=%s, P=%s, FI=%s",
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                          vta,
+                          amd->hdr.sn,
+                          vtms,
+                          liblte_rlc_rf_field_text[amd->hdr.rf],
+                          liblte_rlc_p_field_text[amd->hdr.p],
+                          liblte_rlc_fi_field_text[amd->hdr.fi]);
 
         // Queue the SDU for MAC
         rb->queue_mac_sdu(&pdu);
@@ -896,16 +873,15 @@ void LTE_fdd_enb_rlc::send_amd_pdu(LIBLTE_RLC_SINGLE_AMD_PDU_STRUCT *amd,
                           (LTE_FDD_ENB_MESSAGE_UNION *)&mac_sdu_ready,
                           sizeof(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT));
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                                  __FILE__,
-                                  __LINE__,
-                                  &pdu,
-                                  "Can't send AMD PDU for RNTI=%u, RB=%s, outside of transmit window (%u <= %u < %u)",
-                                  user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                  vta,
-                                  amd->hdr.sn,
-                                  vtms);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                          &pdu,
+                          "Can't send AMD PDU for RNTI=%u, RB=%s, outside of transmit window (%u <= %u < %u)",
+                          user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                          vta,
+                          amd->hdr.sn,
+                          vtms);
     }
 }
@@ -185,12 +185,11 @@ void LTE_fdd_enb_rrc::handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_pdu_ready(&msg.msg.rrc_pdu_ready);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid PDCP message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              "Received invalid PDCP message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
@@ -212,12 +211,11 @@ void LTE_fdd_enb_rrc::handle_mme_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_cmd(&msg.msg.rrc_cmd_ready);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid MME message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              "Received invalid MME message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
@@ -246,14 +244,13 @@ void LTE_fdd_enb_rrc::handle_pdu_ready(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT *pdu
 
     if(LTE_FDD_ENB_ERROR_NONE == pdu_ready->rb->get_next_rrc_pdu(&pdu))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                  __FILE__,
-                                  __LINE__,
-                                  pdu,
-                                  "Received PDU for RNTI=%u and RB=%s",
-                                  pdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                          pdu,
+                          "Received PDU for RNTI=%u and RB=%s",
+                          pdu_ready->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
 
         // Call the appropriate state machine
         switch(pdu_ready->rb->get_rb_id())
@@ -266,25 +263,23 @@ void LTE_fdd_enb_rrc::handle_pdu_ready(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT *pdu
             dcch_sm(pdu, pdu_ready->user, pdu_ready->rb);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                      __FILE__,
-                                      __LINE__,
-                                      pdu,
-                                      "Received PDU for RNTI=%u and invalid RB=%s",
-                                      pdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              pdu,
+                              "Received PDU for RNTI=%u and invalid RB=%s",
+                              pdu_ready->user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
             break;
         }
 
         // Delete the PDU
         pdu_ready->rb->delete_next_rrc_pdu();
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received pdu_ready message with no PDU queued");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                          "Received pdu_ready message with no PDU queued");
     }
 }
 
@@ -297,14 +292,13 @@ void LTE_fdd_enb_rrc::handle_nas_msg(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT *n
 
     if(LTE_FDD_ENB_ERROR_NONE == nas_msg->rb->get_next_rrc_nas_msg(&msg))
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                  __FILE__,
-                                  __LINE__,
-                                  msg,
-                                  "Received NAS message for RNTI=%u and RB=%s",
-                                  nas_msg->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[nas_msg->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                          msg,
+                          "Received NAS message for RNTI=%u and RB=%s",
+                          nas_msg->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[nas_msg->rb->get_rb_id()]);
 
         // Send the NAS message
         send_dl_info_transfer(nas_msg->user, nas_msg->rb, msg);
@@ -312,11 +306,10 @@ void LTE_fdd_enb_rrc::handle_nas_msg(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT *n
         // Delete the NAS message
         nas_msg->rb->delete_next_rrc_nas_msg();
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received NAS message with no message queued");
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                          "Received NAS message with no message queued");
     }
 }
 void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *cmd)
@@ -326,14 +319,13 @@ void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *cmd)
     LTE_fdd_enb_rb         *drb1 = NULL;
     LTE_fdd_enb_rb         *drb2 = NULL;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              "Received MME command %s for RNTI=%u and RB=%s",
-                              LTE_fdd_enb_rrc_cmd_text[cmd->cmd],
-                              cmd->user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[cmd->rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      "Received MME command %s for RNTI=%u and RB=%s",
+                      LTE_fdd_enb_rrc_cmd_text[cmd->cmd],
+                      cmd->user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[cmd->rb->get_rb_id()]);
 
     switch(cmd->cmd)
     {
@@ -369,11 +361,10 @@ void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *cmd)
                 send_rrc_con_reconfig(cmd->user, cmd->rb, NULL);
             }
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Handle CMD can't setup default DRB");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              "Handle CMD can't setup default DRB");
         }
         break;
     case LTE_FDD_ENB_RRC_CMD_SETUP_DED_DRB:
@@ -408,22 +399,20 @@ void LTE_fdd_enb_rrc::handle_cmd(LTE_FDD_ENB_RRC_CMD_READY_MSG_STRUCT *cmd)
                 send_rrc_con_reconfig(cmd->user, cmd->rb, NULL);
             }
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Handle CMD can't setup dedicated DRB");
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              "Handle CMD can't setup dedicated DRB");
         }
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received MME command %s for RNTI=%u and RB=%s",
-                                  LTE_fdd_enb_rrc_cmd_text[cmd->cmd],
-                                  cmd->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[cmd->rb->get_rb_id()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                          "Received MME command %s for RNTI=%u and RB=%s",
+                          LTE_fdd_enb_rrc_cmd_text[cmd->cmd],
+                          cmd->user->get_c_rnti(),
+                          LTE_fdd_enb_rb_text[cmd->rb->get_rb_id()]);
         break;
     }
 }
@@ -456,20 +445,18 @@ void LTE_fdd_enb_rrc::ccch_sm(LIBLTE_BIT_MSG_STRUCT *msg,
                 srb1->set_rrc_procedure(LTE_FDD_ENB_RRC_PROC_RRC_CON_REQ);
                 srb1->set_rrc_state(LTE_FDD_ENB_RRC_STATE_WAIT_FOR_CON_SETUP_COMPLETE);
             }else{
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                          __FILE__,
-                                          __LINE__,
-                                          "UL-CCCH-Message can't setup srb1");
+                LTE_FDD_ENB_DEBUG(interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                                  "UL-CCCH-Message can't setup srb1");
             }
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "UL-CCCH-Message RRC CON REQ state machine invalid state %s",
-                                      LTE_fdd_enb_rrc_state_text[loc_rb->get_rrc_state()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              "UL-CCCH-Message RRC CON REQ state machine invalid state %s",
+                              LTE_fdd_enb_rrc_state_text[loc_rb->get_rrc_state()]);
             break;
         }
         break;
@@ -489,22 +476,20 @@ void LTE_fdd_enb_rrc::ccch_sm(LIBLTE_BIT_MSG_STRUCT *msg,
             }
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "UL-CCCH-Message RRC CON REEST REQ state machine invalid state %s",
-                                      LTE_fdd_enb_rrc_state_text[loc_rb->get_rrc_state()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              "UL-CCCH-Message RRC CON REEST REQ state machine invalid state %s",
+                              LTE_fdd_enb_rrc_state_text[loc_rb->get_rrc_state()]);
             break;
         }
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "CCCH state machine invalid procedure %s",
-                                  LTE_fdd_enb_rrc_proc_text[loc_rb->get_rrc_procedure()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                          "CCCH state machine invalid procedure %s",
+                          LTE_fdd_enb_rrc_proc_text[loc_rb->get_rrc_procedure()]);
         break;
     }
 }
@@ -525,22 +510,20 @@ void LTE_fdd_enb_rrc::dcch_sm(LIBLTE_BIT_MSG_STRUCT *msg,
             parse_ul_dcch_message(msg, user, rb);
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "UL-DCCH-Message RRC CON REQ state machine invalid state %s",
-                                      LTE_fdd_enb_rrc_state_text[rb->get_rrc_state()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              "UL-DCCH-Message RRC CON REQ state machine invalid state %s",
+                              LTE_fdd_enb_rrc_state_text[rb->get_rrc_state()]);
             break;
         }
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                  __FILE__,
-                                  __LINE__,
-                                  "DCCH state machine invalid procedure %s",
-                                  LTE_fdd_enb_rrc_proc_text[rb->get_rrc_procedure()]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                          "DCCH state machine invalid procedure %s",
+                          LTE_fdd_enb_rrc_proc_text[rb->get_rrc_procedure()]);
         break;
     }
 }
@@ -560,14 +543,13 @@ void LTE_fdd_enb_rrc::parse_ul_ccch_message(LIBLTE_BIT_MSG_STRUCT  *msg,
     liblte_rrc_unpack_ul_ccch_msg(msg,
                                   &(*rb)->ul_ccch_msg);
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              "Received %s for RNTI=%u, RB=%s",
-                              liblte_rrc_ul_ccch_msg_type_text[(*rb)->ul_ccch_msg.msg_type],
-                              (*user)->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      "Received %s for RNTI=%u, RB=%s",
+                      liblte_rrc_ul_ccch_msg_type_text[(*rb)->ul_ccch_msg.msg_type],
+                      (*user)->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
 
     switch((*rb)->ul_ccch_msg.msg_type)
     {
@@ -583,14 +565,13 @@ void LTE_fdd_enb_rrc::parse_ul_ccch_message(LIBLTE_BIT_MSG_STRUCT  *msg,
                     user_mgr->transfer_c_rnti(*user, act_user);
                     *user = act_user;
                 }
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                          __FILE__,
-                                          __LINE__,
-                                          "IMSI=%s is associated with RNTI=%u, RB=%s",
-                                          (*user)->get_imsi_str().c_str(),
-                                          (*user)->get_c_rnti(),
-                                          LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
+                LTE_FDD_ENB_DEBUG(interface,
+                                  LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                                  "IMSI=%s is associated with RNTI=%u, RB=%s",
+                                  (*user)->get_imsi_str().c_str(),
+                                  (*user)->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
             }
         }
         (*rb)->set_rrc_procedure(LTE_FDD_ENB_RRC_PROC_RRC_CON_REQ);
@@ -605,26 +586,24 @@ void LTE_fdd_enb_rrc::parse_ul_ccch_message(LIBLTE_BIT_MSG_STRUCT  *msg,
                 user_mgr->transfer_c_rnti(*user, act_user);
                 *user = act_user;
             }
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                      __FILE__,
-                                      __LINE__,
-                                      "IMSI=%s is associated with RNTI=%u, RB=%s",
-                                      (*user)->get_imsi_str().c_str(),
-                                      (*user)->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              "IMSI=%s is associated with RNTI=%u, RB=%s",
+                              (*user)->get_imsi_str().c_str(),
+                              (*user)->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[(*rb)->get_rb_id()]);
         }
         (*rb)->set_rrc_procedure(LTE_FDD_ENB_RRC_PROC_RRC_CON_REEST_REQ);
         (*rb)->set_rrc_state(LTE_FDD_ENB_RRC_STATE_IDLE);
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                  __FILE__,
-                                  __LINE__,
-                                  msg,
-                                  "UL-CCCH-Message received with invalid msg_type=%s",
-                                  liblte_rrc_ul_ccch_msg_type_text[(*rb)->ul_ccch_msg.msg_type]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                          msg,
+                          "UL-CCCH-Message received with invalid msg_type=%s",
+                          liblte_rrc_ul_ccch_msg_type_text[(*rb)->ul_ccch_msg.msg_type]);
         break;
     }
 }
@@ -639,14 +618,13 @@ void LTE_fdd_enb_rrc::parse_ul_dcch_message(LIBLTE_BIT_MSG_STRUCT *msg,
     liblte_rrc_unpack_ul_dcch_msg(msg,
                                   &rb->ul_dcch_msg);
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              "Received %s for RNTI=%u, RB=%s",
-                              liblte_rrc_ul_dcch_msg_type_text[rb->ul_dcch_msg.msg_type],
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      "Received %s for RNTI=%u, RB=%s",
+                      liblte_rrc_ul_dcch_msg_type_text[rb->ul_dcch_msg.msg_type],
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     switch(rb->ul_dcch_msg.msg_type)
     {
@@ -681,13 +659,12 @@ void LTE_fdd_enb_rrc::parse_ul_dcch_message(LIBLTE_BIT_MSG_STRUCT *msg,
                               (LTE_FDD_ENB_MESSAGE_UNION *)&nas_msg_ready,
                               sizeof(LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT));
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                      __FILE__,
-                                      __LINE__,
-                                      msg,
-                                      "UL-DCCH-Message UL Information Transfer received with invalid dedicated info %s",
-                                      liblte_rrc_ul_information_transfer_type_text[rb->ul_dcch_msg.msg.ul_info_transfer.dedicated_info_type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              msg,
+                              "UL-DCCH-Message UL Information Transfer received with invalid dedicated info %s",
+                              liblte_rrc_ul_information_transfer_type_text[rb->ul_dcch_msg.msg.ul_info_transfer.dedicated_info_type]);
         }
         break;
     case LIBLTE_RRC_UL_DCCH_MSG_TYPE_SECURITY_MODE_COMPLETE:
@@ -703,22 +680,20 @@ void LTE_fdd_enb_rrc::parse_ul_dcch_message(LIBLTE_BIT_MSG_STRUCT *msg,
     case LIBLTE_RRC_UL_DCCH_MSG_TYPE_RRC_CON_RECONFIG_COMPLETE:
         break;
     case LIBLTE_RRC_UL_DCCH_MSG_TYPE_UE_CAPABILITY_INFO:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                  __FILE__,
-                                  __LINE__,
-                                  msg,
-                                  "UE Capability Information for RNTI=%u",
-                                  user->get_c_rnti());
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                          msg,
+                          "UE Capability Information for RNTI=%u",
+                          user->get_c_rnti());
         break;
     default:
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                                  __FILE__,
-                                  __LINE__,
-                                  msg,
-                                  "UL-DCCH-Message received with invalid msg_type=%s",
-                                  liblte_rrc_ul_dcch_msg_type_text[rb->ul_dcch_msg.msg_type]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                          LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                          msg,
+                          "UL-DCCH-Message received with invalid msg_type=%s",
+                          liblte_rrc_ul_dcch_msg_type_text[rb->ul_dcch_msg.msg_type]);
         break;
     }
 }
@@ -738,14 +713,13 @@ void LTE_fdd_enb_rrc::send_dl_info_transfer(LTE_fdd_enb_user       *user,
     rb->dl_dcch_msg.msg.dl_info_transfer.dedicated_info_type = LIBLTE_RRC_DL_INFORMATION_TRANSFER_TYPE_NAS;
     memcpy(&rb->dl_dcch_msg.msg.dl_info_transfer.dedicated_info, msg, sizeof(LIBLTE_BYTE_MSG_STRUCT));
     liblte_rrc_pack_dl_dcch_msg(&rb->dl_dcch_msg, &pdcp_sdu);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              &pdcp_sdu,
-                              "Sending DL Info Transfer for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      &pdcp_sdu,
+                      "Sending DL Info Transfer for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the PDU for PDCP
     rb->queue_pdcp_sdu(&pdcp_sdu);
@@ -869,14 +843,13 @@ void LTE_fdd_enb_rrc::send_rrc_con_reconfig(LTE_fdd_enb_user       *user,
     rrc_con_recnfg->rr_cnfg_ded.rlf_timers_and_constants_present = false;
     rrc_con_recnfg->sec_cnfg_ho_present                          = false;
     liblte_rrc_pack_dl_dcch_msg(&rb->dl_dcch_msg, &pdcp_sdu);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              &pdcp_sdu,
-                              "Sending RRC Connection Reconfiguration for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      &pdcp_sdu,
+                      "Sending RRC Connection Reconfiguration for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the PDU for PDCP
     rb->queue_pdcp_sdu(&pdcp_sdu);
@@ -927,13 +900,12 @@ void LTE_fdd_enb_rrc::send_rrc_con_reest(LTE_fdd_enb_user *user,
     increment_i_sr();
     rrc_con_reest->rr_cnfg.rlf_timers_and_constants_present = false;
     liblte_rrc_pack_dl_ccch_msg(&rb->dl_ccch_msg, &pdcp_sdu);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              "Sending RRC Connection Reestablishment for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      "Sending RRC Connection Reestablishment for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the PDU for PDCP
     rb->queue_pdcp_sdu(&pdcp_sdu);
@@ -954,14 +926,13 @@ void LTE_fdd_enb_rrc::send_rrc_con_reest_reject(LTE_fdd_enb_user *user,
 
     rb->dl_ccch_msg.msg_type = LIBLTE_RRC_DL_CCCH_MSG_TYPE_RRC_CON_REEST_REJ;
     liblte_rrc_pack_dl_ccch_msg(&rb->dl_ccch_msg, &pdcp_sdu);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              &pdcp_sdu,
-                              "Sending RRC Connection Reestablishment Reject for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      &pdcp_sdu,
+                      "Sending RRC Connection Reestablishment Reject for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the PDU for PDCP
     rb->queue_pdcp_sdu(&pdcp_sdu);
@@ -985,14 +956,13 @@ void LTE_fdd_enb_rrc::send_rrc_con_release(LTE_fdd_enb_user *user,
     rb->dl_dcch_msg.msg.rrc_con_release.rrc_transaction_id = rb->get_rrc_transaction_id();
     rb->dl_dcch_msg.msg.rrc_con_release.release_cause      = LIBLTE_RRC_RELEASE_CAUSE_OTHER;
     liblte_rrc_pack_dl_dcch_msg(&rb->dl_dcch_msg, &pdcp_sdu);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              &pdcp_sdu,
-                              "Sending RRC Connection Release for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      &pdcp_sdu,
+                      "Sending RRC Connection Release for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     mac->remove_periodic_sr_pucch(user->get_c_rnti());
 
@@ -1045,14 +1015,13 @@ void LTE_fdd_enb_rrc::send_rrc_con_setup(LTE_fdd_enb_user *user,
     increment_i_sr();
     rrc_con_setup->rr_cnfg.rlf_timers_and_constants_present = false;
     liblte_rrc_pack_dl_ccch_msg(&rb->dl_ccch_msg, &pdcp_sdu);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              &pdcp_sdu,
-                              "Sending RRC Connection Setup for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      &pdcp_sdu,
+                      "Sending RRC Connection Setup for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the PDU for PDCP
     rb->queue_pdcp_sdu(&pdcp_sdu);
@@ -1076,14 +1045,13 @@ void LTE_fdd_enb_rrc::send_security_mode_command(LTE_fdd_enb_user *user,
     rb->dl_dcch_msg.msg.security_mode_cmd.sec_algs.cipher_alg = LIBLTE_RRC_CIPHERING_ALGORITHM_EEA0;
     rb->dl_dcch_msg.msg.security_mode_cmd.sec_algs.int_alg    = LIBLTE_RRC_INTEGRITY_PROT_ALGORITHM_EIA2;
     liblte_rrc_pack_dl_dcch_msg(&rb->dl_dcch_msg, &pdcp_sdu);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              &pdcp_sdu,
-                              "Sending Security Mode Command for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      &pdcp_sdu,
+                      "Sending Security Mode Command for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Configure PDCP for security
     rb->set_pdcp_config(LTE_FDD_ENB_PDCP_CONFIG_SECURITY);
@@ -1115,14 +1083,13 @@ void LTE_fdd_enb_rrc::send_ue_capability_enquiry(LTE_fdd_enb_user *user,
     ue_cap_enquiry->rat_type_list[ue_cap_enquiry->rat_type_list_size++] = LIBLTE_RRC_RAT_TYPE_GERAN_PS;
     ue_cap_enquiry->rat_type_list[ue_cap_enquiry->rat_type_list_size++] = LIBLTE_RRC_RAT_TYPE_CDMA2000_1XRTT;
     liblte_rrc_pack_dl_dcch_msg(&rb->dl_dcch_msg, &pdcp_sdu);
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
-                              __FILE__,
-                              __LINE__,
-                              &pdcp_sdu,
-                              "Sending UE Capability Enquiry for RNTI=%u, RB=%s",
-                              user->get_c_rnti(),
-                              LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    LTE_FDD_ENB_DEBUG(interface,
+                      LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                      LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                      &pdcp_sdu,
+                      "Sending UE Capability Enquiry for RNTI=%u, RB=%s",
+                      user->get_c_rnti(),
+                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
     // Queue the PDU for PDCP
     rb->queue_pdcp_sdu(&pdcp_sdu);
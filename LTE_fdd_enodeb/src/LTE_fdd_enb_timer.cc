@@ -76,14 +76,15 @@ void LTE_fdd_enb_timer_cb::operator()(uint32 id)
 /********************************/
 /*    Constructor/Destructor    */
 /********************************/
-LTE_fdd_enb_timer::LTE_fdd_enb_timer(uint32               m_seconds,
-                                     uint32               _id,
-                                     LTE_fdd_enb_timer_cb _cb)
+LTE_fdd_enb_timer::LTE_fdd_enb_timer()
 {
-    cb                = _cb;
-    id                = _id;
-    expiry_m_seconds  = m_seconds;
-    current_m_seconds = 0;
+    id               = 0;
+    expiry_m_seconds = 0;
+    slot             = NULL;
+    prev             = NULL;
+    next             = NULL;
+    expiry_tick      = 0;
+    state            = LTE_FDD_ENB_TIMER_STATE_FREE;
 }
 LTE_fdd_enb_timer::~LTE_fdd_enb_timer()
 {
@@ -92,29 +93,9 @@ LTE_fdd_enb_timer::~LTE_fdd_enb_timer()
 /****************************/
 /*    External Interface    */
 /****************************/
-void LTE_fdd_enb_timer::reset(void)
+void LTE_fdd_enb_timer::setup(uint32               m_seconds,
+                              LTE_fdd_enb_timer_cb _cb)
 {
-    current_m_seconds = 0;
-}
-void LTE_fdd_enb_timer::increment(void)
-{
-    current_m_seconds++;
-}
-bool LTE_fdd_enb_timer::expired(void)
-{
-    bool exp = false;
-
-    if(current_m_seconds > expiry_m_seconds)
-    {
-        exp = true;
-    }
-
-    return(exp);
-}
-void LTE_fdd_enb_timer::call_callback(void)
-{
-    if(expired())
-    {
-        cb(id);
-    }
+    cb               = _cb;
+    expiry_m_seconds = m_seconds;
 }
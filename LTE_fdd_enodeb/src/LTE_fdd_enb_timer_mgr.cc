@@ -43,7 +43,7 @@
 #include "LTE_fdd_enb_timer_mgr.h"
 #include "LTE_fdd_enb_user_mgr.h"
 #include "libtools_scoped_lock.h"
-#include <list>
+#include <time.h>
 
 /*******************************************************************************
                               DEFINES
@@ -96,19 +96,35 @@ void LTE_fdd_enb_timer_mgr::cleanup(void)
 /********************************/
 LTE_fdd_enb_timer_mgr::LTE_fdd_enb_timer_mgr()
 {
+    uint32 i;
+    uint32 j;
+
     sem_init(&start_sem, 0, 1);
     sem_init(&timer_sem, 0, 1);
-    interface = NULL;
-    started   = false;
+    interface    = NULL;
+    started      = false;
+    free_timers  = NULL;
+    N_timers     = 0;
+    current_tick = 0;
+    for(i=0; i<LTE_FDD_ENB_TIMER_WHEEL_N_LEVELS; i++)
+    {
+        for(j=0; j<LTE_FDD_ENB_TIMER_WHEEL_N_SLOTS; j++)
+        {
+            wheel[i][j] = NULL;
+        }
+    }
+    expired_timers.reserve(LTE_FDD_ENB_TIMER_POOL_CHUNK_SIZE);
+    expired_ids.reserve(LTE_FDD_ENB_TIMER_POOL_CHUNK_SIZE);
+    memset(&tick_hist, 0, sizeof(tick_hist));
 }
 LTE_fdd_enb_timer_mgr::~LTE_fdd_enb_timer_mgr()
 {
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator iter;
+    uint32 i;
 
     sem_wait(&timer_sem);
-    for(iter=timer_map.begin(); iter!=timer_map.end(); iter++)
+    for(i=0; i<timer_pool.size(); i++)
     {
-        delete (*iter).second;
+        delete [] timer_pool[i];
     }
     sem_post(&timer_sem);
     sem_destroy(&timer_sem);
@@ -128,18 +144,36 @@ void LTE_fdd_enb_timer_mgr::start(LTE_fdd_enb_msgq      *from_mac,
     {
         interface     = iface;
         started       = true;
-        next_timer_id = 0;
         msgq_from_mac = from_mac;
         msgq_from_mac->attach_rx(timer_cb);
     }
 }
 void LTE_fdd_enb_timer_mgr::stop(void)
 {
-    libtools_scoped_lock lock(start_sem);
+    libtools_scoped_lock                lock(start_sem);
+    LTE_FDD_ENB_TIMER_TICK_HIST_STRUCT  hist;
+    char                                hist_str[LTE_FDD_ENB_TIMER_TICK_HIST_N_BINS*32];
+    uint32                              len;
+    uint32                              i;
 
     if(started)
     {
         started = false;
+
+        get_tick_hist(&hist);
+        len = 0;
+        for(i=0; i<LTE_FDD_ENB_TIMER_TICK_HIST_N_BINS; i++)
+        {
+            len += snprintf(&hist_str[len], sizeof(hist_str) - len, " <%uus=%u", 1 << i, hist.bins[i]);
+        }
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_TIMER,
+                          "Tick processing N_ticks=%u max=%uus pool_size=%u%s",
+                          hist.N_ticks,
+                          hist.max_us,
+                          N_timers,
+                          hist_str);
     }
 }
 
@@ -150,38 +184,37 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::start_timer(uint32
                                                           LTE_fdd_enb_timer_cb  cb,
                                                           uint32               *timer_id)
 {
-    libtools_scoped_lock                             lock(timer_sem);
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator  iter      = timer_map.find(next_timer_id);
-    LTE_fdd_enb_timer                               *new_timer = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                           err       = LTE_FDD_ENB_ERROR_BAD_ALLOC;
-
-    while(timer_map.end()              != iter &&
-          LTE_FDD_ENB_INVALID_TIMER_ID != next_timer_id)
-    {
-        next_timer_id++;
-        iter = timer_map.find(next_timer_id);
-    }
-    new_timer = new LTE_fdd_enb_timer(m_seconds, next_timer_id, cb);
+    libtools_scoped_lock    lock(timer_sem);
+    LTE_fdd_enb_timer      *new_timer = alloc_timer();
+    LTE_FDD_ENB_ERROR_ENUM  err       = LTE_FDD_ENB_ERROR_BAD_ALLOC;
 
     if(NULL != new_timer)
     {
-        *timer_id                  = next_timer_id;
-        timer_map[next_timer_id++] = new_timer;
-        err                        = LTE_FDD_ENB_ERROR_NONE;
+        new_timer->setup(m_seconds, cb);
+        new_timer->expiry_tick = current_tick + m_seconds + 1;
+        new_timer->state       = LTE_FDD_ENB_TIMER_STATE_ARMED;
+        insert_timer(new_timer);
+        *timer_id = new_timer->id;
+        err       = LTE_FDD_ENB_ERROR_NONE;
     }
 
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::stop_timer(uint32 timer_id)
 {
-    libtools_scoped_lock                            lock(timer_sem);
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator iter = timer_map.find(timer_id);
-    LTE_FDD_ENB_ERROR_ENUM                          err  = LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND;
+    libtools_scoped_lock    lock(timer_sem);
+    LTE_fdd_enb_timer      *timer = find_timer(timer_id);
+    LTE_FDD_ENB_ERROR_ENUM  err   = LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND;
 
-    if(timer_map.end() != iter)
+    if(NULL != timer)
     {
-        delete (*iter).second;
-        timer_map.erase(iter);
+        // An expired timer is no longer in the wheel and freeing it
+        // stops its callback from being called
+        if(LTE_FDD_ENB_TIMER_STATE_ARMED == timer->state)
+        {
+            remove_timer(timer);
+        }
+        free_timer(timer);
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
@@ -189,18 +222,32 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::stop_timer(uint32 timer_id)
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::reset_timer(uint32 timer_id)
 {
-    libtools_scoped_lock                            lock(timer_sem);
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator iter = timer_map.find(timer_id);
-    LTE_FDD_ENB_ERROR_ENUM                          err  = LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND;
+    libtools_scoped_lock    lock(timer_sem);
+    LTE_fdd_enb_timer      *timer = find_timer(timer_id);
+    LTE_FDD_ENB_ERROR_ENUM  err   = LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND;
 
-    if(timer_map.end() != iter)
+    if(NULL != timer)
     {
-        (*iter).second->reset();
+        // Resetting an expired timer rearms it instead of calling its
+        // callback
+        if(LTE_FDD_ENB_TIMER_STATE_ARMED == timer->state)
+        {
+            remove_timer(timer);
+        }
+        timer->expiry_tick = current_tick + timer->expiry_m_seconds + 1;
+        timer->state       = LTE_FDD_ENB_TIMER_STATE_ARMED;
+        insert_timer(timer);
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
     return(err);
 }
+void LTE_fdd_enb_timer_mgr::get_tick_hist(LTE_FDD_ENB_TIMER_TICK_HIST_STRUCT *hist)
+{
+    libtools_scoped_lock lock(timer_sem);
+
+    memcpy(hist, &tick_hist, sizeof(LTE_FDD_ENB_TIMER_TICK_HIST_STRUCT));
+}
 
 /***********************/
 /*    Communication    */
@@ -216,51 +263,226 @@ void LTE_fdd_enb_timer_mgr::handle_msg(LTE_FDD_ENB_MESSAGE_STRUCT &msg)
             handle_tick();
             break;
         default:
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_TIMER,
-                                      __FILE__,
-                                      __LINE__,
-                                      "Received invalid TIMER message %s",
-                                      LTE_fdd_enb_message_type_text[msg.type]);
+            LTE_FDD_ENB_DEBUG(interface,
+                              LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                              LTE_FDD_ENB_DEBUG_LEVEL_TIMER,
+                              "Received invalid TIMER message %s",
+                              LTE_fdd_enb_message_type_text[msg.type]);
             break;
         }
     }else{
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_TIMER,
-                                  __FILE__,
-                                  __LINE__,
-                                  "Received message for invalid layer (%s)",
-                                  LTE_fdd_enb_dest_layer_text[msg.dest_layer]);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                          LTE_FDD_ENB_DEBUG_LEVEL_TIMER,
+                          "Received message for invalid layer (%s)",
+                          LTE_fdd_enb_dest_layer_text[msg.dest_layer]);
     }
 }
 void LTE_fdd_enb_timer_mgr::handle_tick(void)
 {
-    LTE_fdd_enb_user_mgr                            *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator  iter;
-    std::list<uint32>                                expired_list;
+    LTE_fdd_enb_timer    *timer;
+    LTE_fdd_enb_timer    *next;
+    LTE_fdd_enb_timer_cb  cb;
+    struct timespec       start_time;
+    struct timespec       end_time;
+    uint32                level;
+    uint32                idx;
+    uint32                tick_us;
+    uint32                bin;
+    uint32                i;
+    bool                  expired;
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
 
     sem_wait(&timer_sem);
-    for(iter=timer_map.begin(); iter!=timer_map.end(); iter++)
+    current_tick++;
+
+    // Move the timers of every level whose slot boundary was crossed
+    // down the wheel
+    for(level=1; level<LTE_FDD_ENB_TIMER_WHEEL_N_LEVELS; level++)
+    {
+        if(0 != (current_tick & ((1 << (level*LTE_FDD_ENB_TIMER_WHEEL_SLOT_BITS)) - 1)))
+        {
+            break;
+        }
+        cascade(level);
+    }
+
+    // Every timer in the current level 0 slot expires on this tick
+    idx           = current_tick & LTE_FDD_ENB_TIMER_WHEEL_SLOT_MASK;
+    timer         = wheel[0][idx];
+    wheel[0][idx] = NULL;
+    while(NULL != timer)
     {
-        (*iter).second->increment();
+        next         = timer->next;
+        timer->slot  = NULL;
+        timer->prev  = NULL;
+        timer->next  = NULL;
+        timer->state = LTE_FDD_ENB_TIMER_STATE_FIRING;
+        expired_timers.push_back(timer);
+        expired_ids.push_back(timer->id);
+        timer = next;
+    }
+    sem_post(&timer_sem);
 
-        if((*iter).second->expired())
+    // Call the callbacks outside the lock so that they can start, stop,
+    // and reset timers, skipping timers stopped or reset since expiring
+    for(i=0; i<expired_timers.size(); i++)
+    {
+        sem_wait(&timer_sem);
+        timer   = expired_timers[i];
+        expired = false;
+        if(LTE_FDD_ENB_TIMER_STATE_FIRING == timer->state &&
+           expired_ids[i]                 == timer->id)
         {
-            expired_list.push_back((*iter).first);
+            cb      = timer->cb;
+            expired = true;
+            free_timer(timer);
         }
+        sem_post(&timer_sem);
+
+        if(expired)
+        {
+            cb(expired_ids[i]);
+        }
+    }
+    expired_timers.clear();
+    expired_ids.clear();
+
+    // Tick processing time histogram
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    tick_us = (end_time.tv_sec - start_time.tv_sec)*1000000 + (end_time.tv_nsec - start_time.tv_nsec)/1000;
+    bin     = 0;
+    while(bin < (LTE_FDD_ENB_TIMER_TICK_HIST_N_BINS - 1) &&
+          tick_us >= (uint32)(1 << bin))
+    {
+        bin++;
+    }
+    sem_wait(&timer_sem);
+    tick_hist.N_ticks++;
+    tick_hist.bins[bin]++;
+    if(tick_us > tick_hist.max_us)
+    {
+        tick_hist.max_us = tick_us;
     }
     sem_post(&timer_sem);
+}
 
-    // Delete expired timers
-    while(0 != expired_list.size())
+/***********************/
+/*    Timer Storage    */
+/***********************/
+LTE_fdd_enb_timer* LTE_fdd_enb_timer_mgr::alloc_timer(void)
+{
+    LTE_fdd_enb_timer *chunk;
+    LTE_fdd_enb_timer *timer = NULL;
+    uint32             i;
+
+    // Grow the pool a chunk at a time
+    if(NULL     == free_timers &&
+       N_timers <  LTE_FDD_ENB_TIMER_POOL_MAX_SIZE)
     {
-        iter = timer_map.find(expired_list.front());
-        if(timer_map.end() != iter)
+        chunk = new LTE_fdd_enb_timer[LTE_FDD_ENB_TIMER_POOL_CHUNK_SIZE];
+        timer_pool.push_back(chunk);
+        for(i=LTE_FDD_ENB_TIMER_POOL_CHUNK_SIZE; i>0; i--)
         {
-            (*iter).second->call_callback();
-            delete (*iter).second;
-            timer_map.erase(iter);
+            if((N_timers + i - 1) < LTE_FDD_ENB_TIMER_POOL_MAX_SIZE)
+            {
+                chunk[i-1].id   = N_timers + i - 1;
+                chunk[i-1].next = free_timers;
+                free_timers     = &chunk[i-1];
+            }
         }
-        expired_list.pop_front();
+        N_timers += LTE_FDD_ENB_TIMER_POOL_CHUNK_SIZE;
+    }
+
+    if(NULL != free_timers)
+    {
+        timer       = free_timers;
+        free_timers = timer->next;
+        timer->next = NULL;
+    }
+
+    return(timer);
+}
+void LTE_fdd_enb_timer_mgr::free_timer(LTE_fdd_enb_timer *timer)
+{
+    // Bump the generation so that the old id is no longer found
+    timer->id    += 1 << LTE_FDD_ENB_TIMER_ID_INDEX_BITS;
+    timer->state  = LTE_FDD_ENB_TIMER_STATE_FREE;
+    timer->prev   = NULL;
+    timer->next   = free_timers;
+    free_timers   = timer;
+}
+LTE_fdd_enb_timer* LTE_fdd_enb_timer_mgr::find_timer(uint32 timer_id)
+{
+    LTE_fdd_enb_timer *timer;
+    uint32             idx = timer_id & LTE_FDD_ENB_TIMER_ID_INDEX_MASK;
+
+    if(idx >= N_timers)
+    {
+        return(NULL);
+    }
+    timer = &timer_pool[idx/LTE_FDD_ENB_TIMER_POOL_CHUNK_SIZE][idx%LTE_FDD_ENB_TIMER_POOL_CHUNK_SIZE];
+    if(LTE_FDD_ENB_TIMER_STATE_FREE == timer->state ||
+       timer_id                     != timer->id)
+    {
+        return(NULL);
+    }
+
+    return(timer);
+}
+void LTE_fdd_enb_timer_mgr::insert_timer(LTE_fdd_enb_timer *timer)
+{
+    uint32 delta = timer->expiry_tick - current_tick;
+    uint32 level = 0;
+    uint32 idx;
+
+    // Each level is 64 times coarser than the one below, the top level
+    // holds everything longer and is cascaded again when it comes around
+    while(level < (LTE_FDD_ENB_TIMER_WHEEL_N_LEVELS - 1) &&
+          delta >= (uint32)(1 << ((level + 1)*LTE_FDD_ENB_TIMER_WHEEL_SLOT_BITS)))
+    {
+        level++;
+    }
+    idx = (timer->expiry_tick >> (level*LTE_FDD_ENB_TIMER_WHEEL_SLOT_BITS)) & LTE_FDD_ENB_TIMER_WHEEL_SLOT_MASK;
+
+    timer->slot = &wheel[level][idx];
+    timer->prev = NULL;
+    timer->next = wheel[level][idx];
+    if(NULL != timer->next)
+    {
+        timer->next->prev = timer;
+    }
+    wheel[level][idx] = timer;
+}
+void LTE_fdd_enb_timer_mgr::remove_timer(LTE_fdd_enb_timer *timer)
+{
+    if(NULL != timer->prev)
+    {
+        timer->prev->next = timer->next;
+    }else{
+        *timer->slot = timer->next;
+    }
+    if(NULL != timer->next)
+    {
+        timer->next->prev = timer->prev;
+    }
+    timer->slot = NULL;
+    timer->prev = NULL;
+    timer->next = NULL;
+}
+void LTE_fdd_enb_timer_mgr::cascade(uint32 level)
+{
+    LTE_fdd_enb_timer *timer;
+    LTE_fdd_enb_timer *next;
+    uint32             idx = (current_tick >> (level*LTE_FDD_ENB_TIMER_WHEEL_SLOT_BITS)) & LTE_FDD_ENB_TIMER_WHEEL_SLOT_MASK;
+
+    timer             = wheel[level][idx];
+    wheel[level][idx] = NULL;
+    while(NULL != timer)
+    {
+        next = timer->next;
+        insert_timer(timer);
+        timer = next;
     }
 }
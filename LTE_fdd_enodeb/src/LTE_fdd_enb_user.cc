@@ -210,6 +210,7 @@ void LTE_fdd_enb_user::init(void)
     // Identity
     c_rnti     = 0xFFFF;
     c_rnti_set = false;
+    LTE_fdd_enb_user_mgr::get_instance()->update_user(this);
 }
 
 /******************/
@@ -219,6 +220,7 @@ void LTE_fdd_enb_user::set_id(LTE_FDD_ENB_USER_ID_STRUCT *identity)
 {
     memcpy(&id, identity, sizeof(LTE_FDD_ENB_USER_ID_STRUCT));
     id_set = true;
+    LTE_fdd_enb_user_mgr::get_instance()->update_user(this);
 }
 LTE_FDD_ENB_USER_ID_STRUCT* LTE_fdd_enb_user::get_id(void)
 {
@@ -232,6 +234,7 @@ void LTE_fdd_enb_user::set_guti(LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT *_guti)
 {
     memcpy(&guti, _guti, sizeof(LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT));
     guti_set = true;
+    LTE_fdd_enb_user_mgr::get_instance()->update_user(this);
 }
 LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT* LTE_fdd_enb_user::get_guti(void)
 {
@@ -269,6 +272,7 @@ void LTE_fdd_enb_user::set_c_rnti(uint16 _c_rnti)
 {
     c_rnti     = _c_rnti;
     c_rnti_set = true;
+    LTE_fdd_enb_user_mgr::get_instance()->update_user(this);
 }
 uint16 LTE_fdd_enb_user::get_c_rnti(void)
 {
@@ -282,6 +286,7 @@ void LTE_fdd_enb_user::set_ip_addr(uint32 addr)
 {
     ip_addr     = addr;
     ip_addr_set = true;
+    LTE_fdd_enb_user_mgr::get_instance()->update_user(this);
 }
 uint32 LTE_fdd_enb_user::get_ip_addr(void)
 {
@@ -295,6 +300,7 @@ void LTE_fdd_enb_user::prepare_for_deletion(void)
 {
     // Let the C-RNTI timer cleanup the user
     id_set = false;
+    LTE_fdd_enb_user_mgr::get_instance()->update_user(this);
 }
 
 /******************/
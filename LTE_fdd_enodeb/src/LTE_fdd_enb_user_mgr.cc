@@ -114,15 +114,16 @@ void LTE_fdd_enb_user_mgr::cleanup(void)
 /********************************/
 LTE_fdd_enb_user_mgr::LTE_fdd_enb_user_mgr()
 {
-    sem_init(&user_sem, 0, 1);
+    pthread_rwlock_init(&user_lock, NULL);
     sem_init(&c_rnti_sem, 0, 1);
     sem_init(&timer_id_sem, 0, 1);
-    next_m_tmsi = 1;
-    next_c_rnti = LIBLTE_MAC_C_RNTI_START;
+    next_m_tmsi   = 1;
+    next_user_seq = 0;
+    next_c_rnti   = LIBLTE_MAC_C_RNTI_START;
 }
 LTE_fdd_enb_user_mgr::~LTE_fdd_enb_user_mgr()
 {
-    sem_destroy(&user_sem);
+    pthread_rwlock_destroy(&user_lock);
     sem_destroy(&c_rnti_sem);
     sem_destroy(&timer_id_sem);
 }
@@ -160,12 +161,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::assign_c_rnti(LTE_fdd_enb_user *use
         c_rnti_map[next_c_rnti] = user;
         *c_rnti                 = next_c_rnti++;
 
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_USER,
-                                  __FILE__,
-                                  __LINE__,
-                                  "C-RNTI=%u assigned",
-                                  *c_rnti);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_USER,
+                          "C-RNTI=%u assigned",
+                          *c_rnti);
 
         if(LIBLTE_MAC_C_RNTI_END < next_c_rnti)
         {
@@ -188,12 +188,11 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::release_c_rnti(uint16 c_rnti)
 
     if(c_rnti_map.end() != iter)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_USER,
-                                  __FILE__,
-                                  __LINE__,
-                                  "C-RNTI=%u released",
-                                  c_rnti);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_USER,
+                          "C-RNTI=%u released",
+                          c_rnti);
 
         // Initialize or delete the user
         if((*iter).second->is_id_set())
@@ -281,13 +280,14 @@ uint32 LTE_fdd_enb_user_mgr::get_next_m_tmsi(void)
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::add_user(LTE_fdd_enb_user **user)
 {
-    LTE_fdd_enb_interface  *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_fdd_enb_timer_mgr  *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
-    LTE_fdd_enb_user       *new_user  = NULL;
-    LTE_fdd_enb_timer_cb    timer_expiry_cb(&LTE_fdd_enb_timer_cb_wrapper<LTE_fdd_enb_user_mgr, &LTE_fdd_enb_user_mgr::handle_c_rnti_timer_expiry>, this);
-    LTE_FDD_ENB_ERROR_ENUM  err       = LTE_FDD_ENB_ERROR_NONE;
-    uint32                  timer_id;
-    uint16                  c_rnti;
+    LTE_fdd_enb_interface        *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_fdd_enb_timer_mgr        *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    LTE_fdd_enb_user             *new_user  = NULL;
+    LTE_FDD_ENB_USER_KEYS_STRUCT *keys;
+    LTE_fdd_enb_timer_cb          timer_expiry_cb(&LTE_fdd_enb_timer_cb_wrapper<LTE_fdd_enb_user_mgr, &LTE_fdd_enb_user_mgr::handle_c_rnti_timer_expiry>, this);
+    LTE_FDD_ENB_ERROR_ENUM        err       = LTE_FDD_ENB_ERROR_NONE;
+    uint32                        timer_id;
+    uint16                        c_rnti;
 
     new_user = new LTE_fdd_enb_user();
 
@@ -307,10 +307,14 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::add_user(LTE_fdd_enb_user **user)
             new_user->set_c_rnti(c_rnti);
             new_user->start_inactivity_timer(LTE_FDD_ENB_USER_INACTIVITY_TIMER_VALUE_MS);
 
-            // Store user
-            sem_wait(&user_sem);
-            user_list.push_back(new_user);
-            sem_post(&user_sem);
+            // Store and index user
+            pthread_rwlock_wrlock(&user_lock);
+            keys            = &user_keys[new_user];
+            keys->user      = new_user;
+            keys->list_iter = user_list.insert(user_list.end(), new_user);
+            keys->seq       = next_user_seq++;
+            index_user(keys);
+            pthread_rwlock_unlock(&user_lock);
 
             // Return user
             *user = new_user;
@@ -327,25 +331,22 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::add_user(LTE_fdd_enb_user **user)
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(std::string        imsi,
                                                        LTE_fdd_enb_user **user)
 {
-    libtools_scoped_lock                    lock(user_sem);
-    std::list<LTE_fdd_enb_user*>::iterator  iter;
-    LTE_FDD_ENB_ERROR_ENUM                  err      = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
-    uint64                                  imsi_num = 0;
+    LTE_FDD_ENB_USER_KEYS_STRUCT *keys;
+    LTE_FDD_ENB_ERROR_ENUM        err      = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    uint64                        imsi_num = 0;
 
     if(imsi.length() == 15)
     {
         to_number(imsi, 15, &imsi_num);
 
-        for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+        pthread_rwlock_rdlock(&user_lock);
+        keys = find_oldest(&imsi_index, imsi_num);
+        if(NULL != keys)
         {
-            if((*iter)->is_id_set() &&
-               (*iter)->get_id()->imsi == imsi_num)
-            {
-                *user = (*iter);
-                err   = LTE_FDD_ENB_ERROR_NONE;
-                break;
-            }
+            *user = keys->user;
+            err   = LTE_FDD_ENB_ERROR_NONE;
         }
+        pthread_rwlock_unlock(&user_lock);
     }
 
     return(err);
@@ -353,226 +354,199 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(std::string        imsi,
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(uint16             c_rnti,
                                                        LTE_fdd_enb_user **user)
 {
-    libtools_scoped_lock                   lock(user_sem);
-    std::list<LTE_fdd_enb_user*>::iterator iter;
-    LTE_FDD_ENB_ERROR_ENUM                 err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    LTE_FDD_ENB_USER_KEYS_STRUCT *keys;
+    LTE_FDD_ENB_ERROR_ENUM        err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    pthread_rwlock_rdlock(&user_lock);
+    keys = find_oldest(&c_rnti_index, c_rnti);
+    if(NULL != keys)
     {
-        if((*iter)->is_c_rnti_set() &&
-           (*iter)->get_c_rnti() == c_rnti)
-        {
-            *user = (*iter);
-            err   = LTE_FDD_ENB_ERROR_NONE;
-            break;
-        }
+        *user = keys->user;
+        err   = LTE_FDD_ENB_ERROR_NONE;
     }
+    pthread_rwlock_unlock(&user_lock);
 
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT  *guti,
                                                        LTE_fdd_enb_user                     **user)
 {
-    libtools_scoped_lock                   lock(user_sem);
-    std::list<LTE_fdd_enb_user*>::iterator iter;
-    LTE_FDD_ENB_ERROR_ENUM                 err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
-
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    std::pair<LTE_FDD_ENB_USER_INDEX::iterator, LTE_FDD_ENB_USER_INDEX::iterator>  range;
+    LTE_FDD_ENB_USER_INDEX::iterator                                               iter;
+    LTE_FDD_ENB_USER_KEYS_STRUCT                                                  *keys  = NULL;
+    LTE_FDD_ENB_ERROR_ENUM                                                         err   = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+
+    pthread_rwlock_rdlock(&user_lock);
+    range = m_tmsi_index.equal_range(guti->m_tmsi);
+    for(iter=range.first; iter!=range.second; iter++)
     {
-        if((*iter)->is_guti_set()                                  &&
-           (*iter)->get_guti()->m_tmsi       == guti->m_tmsi       &&
-           (*iter)->get_guti()->mcc          == guti->mcc          &&
-           (*iter)->get_guti()->mnc          == guti->mnc          &&
-           (*iter)->get_guti()->mme_group_id == guti->mme_group_id &&
-           (*iter)->get_guti()->mme_code     == guti->mme_code)
+        if((*iter).second->guti.mcc          == guti->mcc          &&
+           (*iter).second->guti.mnc          == guti->mnc          &&
+           (*iter).second->guti.mme_group_id == guti->mme_group_id &&
+           (*iter).second->guti.mme_code     == guti->mme_code     &&
+           (NULL == keys || (*iter).second->seq < keys->seq))
         {
-            *user = (*iter);
-            err   = LTE_FDD_ENB_ERROR_NONE;
-            break;
+            keys = (*iter).second;
         }
     }
+    if(NULL != keys)
+    {
+        *user = keys->user;
+        err   = LTE_FDD_ENB_ERROR_NONE;
+    }
+    pthread_rwlock_unlock(&user_lock);
 
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(LIBLTE_RRC_S_TMSI_STRUCT  *s_tmsi,
                                                        LTE_fdd_enb_user         **user)
 {
-    libtools_scoped_lock                   lock(user_sem);
-    std::list<LTE_fdd_enb_user*>::iterator iter;
-    LTE_FDD_ENB_ERROR_ENUM                 err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
-
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    std::pair<LTE_FDD_ENB_USER_INDEX::iterator, LTE_FDD_ENB_USER_INDEX::iterator>  range;
+    LTE_FDD_ENB_USER_INDEX::iterator                                               iter;
+    LTE_FDD_ENB_USER_KEYS_STRUCT                                                  *keys  = NULL;
+    LTE_FDD_ENB_ERROR_ENUM                                                         err   = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+
+    pthread_rwlock_rdlock(&user_lock);
+    range = m_tmsi_index.equal_range(s_tmsi->m_tmsi);
+    for(iter=range.first; iter!=range.second; iter++)
     {
-        if((*iter)->is_guti_set()                          &&
-           (*iter)->get_guti()->m_tmsi   == s_tmsi->m_tmsi &&
-           (*iter)->get_guti()->mme_code == s_tmsi->mmec)
+        if((*iter).second->guti.mme_code == s_tmsi->mmec &&
+           (NULL == keys || (*iter).second->seq < keys->seq))
         {
-            *user = (*iter);
-            err   = LTE_FDD_ENB_ERROR_NONE;
-            break;
+            keys = (*iter).second;
         }
     }
+    if(NULL != keys)
+    {
+        *user = keys->user;
+        err   = LTE_FDD_ENB_ERROR_NONE;
+    }
+    pthread_rwlock_unlock(&user_lock);
 
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(uint32             ip_addr,
                                                        LTE_fdd_enb_user **user)
 {
-    libtools_scoped_lock                   lock(user_sem);
-    std::list<LTE_fdd_enb_user*>::iterator iter;
-    LTE_FDD_ENB_ERROR_ENUM                 err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    LTE_FDD_ENB_USER_KEYS_STRUCT *keys;
+    LTE_FDD_ENB_ERROR_ENUM        err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    pthread_rwlock_rdlock(&user_lock);
+    keys = find_oldest(&ip_addr_index, ip_addr);
+    if(NULL != keys)
     {
-        if((*iter)->is_ip_addr_set() &&
-           (*iter)->get_ip_addr() == ip_addr)
-        {
-            *user = (*iter);
-            err   = LTE_FDD_ENB_ERROR_NONE;
-            break;
-        }
+        *user = keys->user;
+        err   = LTE_FDD_ENB_ERROR_NONE;
     }
+    pthread_rwlock_unlock(&user_lock);
 
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::del_user(LTE_fdd_enb_user *user)
 {
-    libtools_scoped_lock                    lock(user_sem);
-    std::list<LTE_fdd_enb_user*>::iterator  iter;
-    LTE_fdd_enb_user                       *tmp_user = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                  err      = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    boost::unordered_map<LTE_fdd_enb_user*, LTE_FDD_ENB_USER_KEYS_STRUCT>::iterator iter;
+    LTE_FDD_ENB_ERROR_ENUM                                                          err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
 
-    if(user->is_id_set())
+    pthread_rwlock_wrlock(&user_lock);
+    iter = user_keys.find(user);
+    if(user_keys.end() != iter)
     {
-        for(iter=user_list.begin(); iter!=user_list.end(); iter++)
-        {
-            if(user->get_id()->imsi == (*iter)->get_id()->imsi &&
-               user->get_id()->imei == (*iter)->get_id()->imei)
-            {
-                tmp_user = (*iter);
-                iter     = user_list.erase(iter);
-                delete tmp_user;
-                err = LTE_FDD_ENB_ERROR_NONE;
-                break;
-            }
-        }
-    }else if(user->is_guti_set()){
-        for(iter=user_list.begin(); iter!=user_list.end(); iter++)
-        {
-            if(user->get_guti()->m_tmsi       == (*iter)->get_guti()->m_tmsi       &&
-               user->get_guti()->mcc          == (*iter)->get_guti()->mcc          &&
-               user->get_guti()->mnc          == (*iter)->get_guti()->mnc          &&
-               user->get_guti()->mme_group_id == (*iter)->get_guti()->mme_group_id &&
-               user->get_guti()->mme_code     == (*iter)->get_guti()->mme_code)
-            {
-                tmp_user = (*iter);
-                iter     = user_list.erase(iter);
-                delete tmp_user;
-                err = LTE_FDD_ENB_ERROR_NONE;
-                break;
-            }
-        }
-    }else if(user->is_c_rnti_set()){
-        for(iter=user_list.begin(); iter!=user_list.end(); iter++)
-        {
-            if(user->get_c_rnti() == (*iter)->get_c_rnti())
-            {
-                tmp_user = (*iter);
-                iter     = user_list.erase(iter);
-                delete tmp_user;
-                err = LTE_FDD_ENB_ERROR_NONE;
-                break;
-            }
-        }
+        remove_user(&(*iter).second);
+        err = LTE_FDD_ENB_ERROR_NONE;
     }
+    pthread_rwlock_unlock(&user_lock);
 
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::del_user(std::string imsi)
 {
-    libtools_scoped_lock                    lock(user_sem);
-    std::list<LTE_fdd_enb_user*>::iterator  iter;
-    LTE_fdd_enb_user                       *tmp_user = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                  err      = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
-    uint64                                  imsi_num = 0;
+    LTE_FDD_ENB_USER_KEYS_STRUCT *keys;
+    LTE_FDD_ENB_ERROR_ENUM        err      = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    uint64                        imsi_num = 0;
 
     if(imsi.length() == 15)
     {
         to_number(imsi, 15, &imsi_num);
 
-        for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+        pthread_rwlock_wrlock(&user_lock);
+        keys = find_oldest(&imsi_index, imsi_num);
+        if(NULL != keys)
         {
-            if((*iter)->is_id_set() &&
-               (*iter)->get_id()->imsi == imsi_num)
-            {
-                tmp_user = (*iter);
-                iter     = user_list.erase(iter);
-                delete tmp_user;
-                err = LTE_FDD_ENB_ERROR_NONE;
-                break;
-            }
+            remove_user(keys);
+            err = LTE_FDD_ENB_ERROR_NONE;
         }
+        pthread_rwlock_unlock(&user_lock);
     }
 
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::del_user(uint16 c_rnti)
 {
-    libtools_scoped_lock                    lock(user_sem);
-    std::list<LTE_fdd_enb_user*>::iterator  iter;
-    LTE_fdd_enb_user                       *tmp_user = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                  err      = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    LTE_FDD_ENB_USER_KEYS_STRUCT *keys;
+    LTE_FDD_ENB_ERROR_ENUM        err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    pthread_rwlock_wrlock(&user_lock);
+    keys = find_oldest(&c_rnti_index, c_rnti);
+    if(NULL != keys)
     {
-        if((*iter)->is_c_rnti_set() &&
-           (*iter)->get_c_rnti() == c_rnti)
-        {
-            tmp_user = (*iter);
-            iter     = user_list.erase(iter);
-            delete tmp_user;
-            err = LTE_FDD_ENB_ERROR_NONE;
-            break;
-        }
+        remove_user(keys);
+        err = LTE_FDD_ENB_ERROR_NONE;
     }
+    pthread_rwlock_unlock(&user_lock);
 
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::del_user(LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT *guti)
 {
-    libtools_scoped_lock                    lock(user_sem);
-    std::list<LTE_fdd_enb_user*>::iterator  iter;
-    LTE_fdd_enb_user                       *tmp_user = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                  err      = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
-
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    std::pair<LTE_FDD_ENB_USER_INDEX::iterator, LTE_FDD_ENB_USER_INDEX::iterator>  range;
+    LTE_FDD_ENB_USER_INDEX::iterator                                               iter;
+    LTE_FDD_ENB_USER_KEYS_STRUCT                                                  *keys  = NULL;
+    LTE_FDD_ENB_ERROR_ENUM                                                         err   = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+
+    pthread_rwlock_wrlock(&user_lock);
+    range = m_tmsi_index.equal_range(guti->m_tmsi);
+    for(iter=range.first; iter!=range.second; iter++)
     {
-        if((*iter)->is_guti_set()                                  &&
-           (*iter)->get_guti()->m_tmsi       == guti->m_tmsi       &&
-           (*iter)->get_guti()->mcc          == guti->mcc          &&
-           (*iter)->get_guti()->mnc          == guti->mnc          &&
-           (*iter)->get_guti()->mme_group_id == guti->mme_group_id &&
-           (*iter)->get_guti()->mme_code     == guti->mme_code)
+        if((*iter).second->guti.mcc          == guti->mcc          &&
+           (*iter).second->guti.mnc          == guti->mnc          &&
+           (*iter).second->guti.mme_group_id == guti->mme_group_id &&
+           (*iter).second->guti.mme_code     == guti->mme_code     &&
+           (NULL == keys || (*iter).second->seq < keys->seq))
         {
-            tmp_user = (*iter);
-            iter     = user_list.erase(iter);
-            delete tmp_user;
-            err = LTE_FDD_ENB_ERROR_NONE;
-            break;
+            keys = (*iter).second;
         }
     }
+    if(NULL != keys)
+    {
+        remove_user(keys);
+        err = LTE_FDD_ENB_ERROR_NONE;
+    }
+    pthread_rwlock_unlock(&user_lock);
 
     return(err);
 }
+void LTE_fdd_enb_user_mgr::update_user(LTE_fdd_enb_user *user)
+{
+    boost::unordered_map<LTE_fdd_enb_user*, LTE_FDD_ENB_USER_KEYS_STRUCT>::iterator iter;
+
+    pthread_rwlock_wrlock(&user_lock);
+    iter = user_keys.find(user);
+    if(user_keys.end() != iter)
+    {
+        unindex_user(&(*iter).second);
+        index_user(&(*iter).second);
+    }
+    pthread_rwlock_unlock(&user_lock);
+}
 std::string LTE_fdd_enb_user_mgr::print_all_users(void)
 {
-    libtools_scoped_lock                    lock(user_sem);
     std::list<LTE_fdd_enb_user*>::iterator  iter;
     std::string                             output;
     LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT   *guti;
     uint32                                  i;
     uint32                                  hex_val;
 
+    pthread_rwlock_rdlock(&user_lock);
     output = to_string((uint32)user_list.size());
     for(iter=user_list.begin(); iter!=user_list.end(); iter++)
     {
@@ -600,10 +574,107 @@ std::string LTE_fdd_enb_user_mgr::print_all_users(void)
             }
         }
     }
+    pthread_rwlock_unlock(&user_lock);
 
     return(output);
 }
 
+/***********************/
+/*    User Indexing    */
+/***********************/
+void LTE_fdd_enb_user_mgr::index_user(LTE_FDD_ENB_USER_KEYS_STRUCT *keys)
+{
+    LTE_fdd_enb_user *user = keys->user;
+
+    keys->imsi_set    = user->is_id_set();
+    keys->c_rnti_set  = user->is_c_rnti_set();
+    keys->guti_set    = user->is_guti_set();
+    keys->ip_addr_set = user->is_ip_addr_set();
+
+    if(keys->imsi_set)
+    {
+        keys->imsi = user->get_id()->imsi;
+        imsi_index.insert(std::make_pair(keys->imsi, keys));
+    }
+    if(keys->c_rnti_set)
+    {
+        keys->c_rnti = user->get_c_rnti();
+        c_rnti_index.insert(std::make_pair((uint64)keys->c_rnti, keys));
+    }
+    if(keys->guti_set)
+    {
+        memcpy(&keys->guti, user->get_guti(), sizeof(LIBLTE_MME_EPS_MOBILE_ID_GUTI_STRUCT));
+        m_tmsi_index.insert(std::make_pair((uint64)keys->guti.m_tmsi, keys));
+    }
+    if(keys->ip_addr_set)
+    {
+        keys->ip_addr = user->get_ip_addr();
+        ip_addr_index.insert(std::make_pair((uint64)keys->ip_addr, keys));
+    }
+}
+void LTE_fdd_enb_user_mgr::unindex_user(LTE_FDD_ENB_USER_KEYS_STRUCT *keys)
+{
+    if(keys->imsi_set)
+    {
+        erase_index_entry(&imsi_index, keys->imsi, keys);
+    }
+    if(keys->c_rnti_set)
+    {
+        erase_index_entry(&c_rnti_index, keys->c_rnti, keys);
+    }
+    if(keys->guti_set)
+    {
+        erase_index_entry(&m_tmsi_index, keys->guti.m_tmsi, keys);
+    }
+    if(keys->ip_addr_set)
+    {
+        erase_index_entry(&ip_addr_index, keys->ip_addr, keys);
+    }
+}
+void LTE_fdd_enb_user_mgr::erase_index_entry(LTE_FDD_ENB_USER_INDEX       *index,
+                                             uint64                        key,
+                                             LTE_FDD_ENB_USER_KEYS_STRUCT *keys)
+{
+    std::pair<LTE_FDD_ENB_USER_INDEX::iterator, LTE_FDD_ENB_USER_INDEX::iterator> range = index->equal_range(key);
+    LTE_FDD_ENB_USER_INDEX::iterator                                              iter;
+
+    for(iter=range.first; iter!=range.second; iter++)
+    {
+        if(keys == (*iter).second)
+        {
+            index->erase(iter);
+            break;
+        }
+    }
+}
+LTE_FDD_ENB_USER_KEYS_STRUCT* LTE_fdd_enb_user_mgr::find_oldest(LTE_FDD_ENB_USER_INDEX *index,
+                                                               uint64                  key)
+{
+    std::pair<LTE_FDD_ENB_USER_INDEX::iterator, LTE_FDD_ENB_USER_INDEX::iterator>  range = index->equal_range(key);
+    LTE_FDD_ENB_USER_INDEX::iterator                                               iter;
+    LTE_FDD_ENB_USER_KEYS_STRUCT                                                  *keys  = NULL;
+
+    // Users sharing an identity resolve to the first one added
+    for(iter=range.first; iter!=range.second; iter++)
+    {
+        if(NULL == keys || (*iter).second->seq < keys->seq)
+        {
+            keys = (*iter).second;
+        }
+    }
+
+    return(keys);
+}
+void LTE_fdd_enb_user_mgr::remove_user(LTE_FDD_ENB_USER_KEYS_STRUCT *keys)
+{
+    LTE_fdd_enb_user *user = keys->user;
+
+    unindex_user(keys);
+    user_list.erase(keys->list_iter);
+    user_keys.erase(user);
+    delete user;
+}
+
 /**********************/
 /*    C-RNTI Timer    */
 /**********************/
@@ -617,12 +688,11 @@ void LTE_fdd_enb_user_mgr::handle_c_rnti_timer_expiry(uint32 timer_id)
     sem_wait(&timer_id_sem);
     if(timer_id_map_forward.end() != forward_iter)
     {
-        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                  LTE_FDD_ENB_DEBUG_LEVEL_USER,
-                                  __FILE__,
-                                  __LINE__,
-                                  "C-RNTI allocation timer expiry C-RNTI=%u",
-                                  (*forward_iter).second);
+        LTE_FDD_ENB_DEBUG(interface,
+                          LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                          LTE_FDD_ENB_DEBUG_LEVEL_USER,
+                          "C-RNTI allocation timer expiry C-RNTI=%u",
+                          (*forward_iter).second);
         c_rnti = (*forward_iter).second;
         reverse_iter = timer_id_map_reverse.find((*forward_iter).second);
         if(timer_id_map_reverse.end() != reverse_iter)
@@ -91,6 +91,9 @@
 #include "liblte_common.h"
 #include "liblte_rrc.h"
 #include "fftw3.h"
+#include <pthread.h>
+#include <semaphore.h>
+#include <string.h>
 
 /*******************************************************************************
                               DEFINES
@@ -178,9 +181,26 @@
 #define LIBLTE_PHY_MAX_CODE_BLOCK_SIZE 6176
 #define LIBLTE_PHY_MAX_VITERBI_STATES  128
 #define LIBLTE_PHY_BASE_CODING_RATE    3
+#define LIBLTE_PHY_MAX_N_CODE_BLOCKS   13
+#define LIBLTE_PHY_MAX_TB_SIZE         (LIBLTE_PHY_MAX_N_CODE_BLOCKS*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE)
+
+// Viterbi decoder (K=7 tail-biting)
+#define LIBLTE_PHY_VITERBI_K7_N_STATES   64
+#define LIBLTE_PHY_VITERBI_K7_WRAP_BITS  48
+#define LIBLTE_PHY_VITERBI_K7_MAX_BITS   256
+#define LIBLTE_PHY_VITERBI_K7_MAX_STEPS  (LIBLTE_PHY_VITERBI_K7_MAX_BITS+2*LIBLTE_PHY_VITERBI_K7_WRAP_BITS)
+
+// Turbo decoder
+#define LIBLTE_PHY_TURBO_N_STATES                8
+#define LIBLTE_PHY_TURBO_N_TAIL_BITS             3
+#define LIBLTE_PHY_TURBO_WINDOW_SIZE             64
+#define LIBLTE_PHY_TURBO_DEFAULT_MAX_ITERATIONS  6
+#define LIBLTE_PHY_TURBO_MAX_ITERATIONS          16
 
 // Rate matching
 #define LIBLTE_PHY_N_COLUMNS_RATE_MATCH 32
+#define LIBLTE_PHY_RATE_MATCH_N_TABLES  8
+#define LIBLTE_PHY_RATE_MATCH_MAX_W     (LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE)
 
 // PDCCH
 #define LIBLTE_PHY_PDCCH_N_REGS_MAX 787
@@ -188,6 +208,28 @@
 #define LIBLTE_PHY_PDCCH_N_RE_CCE   (LIBLTE_PHY_PDCCH_N_REG_CCE * 4)
 #define LIBLTE_PHY_PDCCH_N_CCE_MAX  (LIBLTE_PHY_PDCCH_N_REGS_MAX / LIBLTE_PHY_PDCCH_N_REG_CCE)
 #define LIBLTE_PHY_PDCCH_N_BITS_MAX 576
+#define LIBLTE_PHY_PDCCH_N_BITS_CCE (LIBLTE_PHY_PDCCH_N_RE_CCE * 2)
+#define LIBLTE_PHY_PDCCH_MAX_UE_RNTIS 32
+
+// Coarse timing PSS correlation, 256 bins out of a 4*FFT_size point
+// block gives 4800 correlation lags per half frame at every sample rate
+#define LIBLTE_PHY_PSS_CORR_N_BINS       256
+#define LIBLTE_PHY_PSS_CORR_N_HALF_FRAME 4800
+
+// DL channel estimation, the MMSE frequency interpolator assumes an
+// exponential power delay profile with this RMS delay spread and SNR
+#define LIBLTE_PHY_DL_CE_N_TAPS_MAX         4
+#define LIBLTE_PHY_DL_CE_MMSE_DELAY_SPREAD  1.0e-6
+#define LIBLTE_PHY_DL_CE_MMSE_SNR           100.0
+
+// PRACH
+#define LIBLTE_PHY_PRACH_N_PREAMBLES        64
+#define LIBLTE_PHY_PRACH_N_ZC_MAX           839
+#define LIBLTE_PHY_PRACH_T_FFT_MAX          24576
+#define LIBLTE_PHY_PRACH_DEC_FS             1920000
+#define LIBLTE_PHY_PRACH_DEC_TAPS_PER_PHASE 12
+#define LIBLTE_PHY_PRACH_DEC_N_TAPS_MAX     (LIBLTE_PHY_PRACH_DEC_TAPS_PER_PHASE*(30720000/LIBLTE_PHY_PRACH_DEC_FS) + 1)
+#define LIBLTE_PHY_PRACH_DEFAULT_THRESHOLD  18.0
 
 /*******************************************************************************
                               TYPEDEFS
@@ -223,7 +265,142 @@ typedef enum{
     LIBLTE_PHY_CHAN_TYPE_ULCCH,
 }LIBLTE_PHY_CHAN_TYPE_ENUM;
 
+typedef enum{
+    LIBLTE_PHY_TURBO_DECODER_VITERBI_SISO = 0,
+    LIBLTE_PHY_TURBO_DECODER_MAX_LOG_MAP,
+    LIBLTE_PHY_TURBO_DECODER_N_ITEMS,
+}LIBLTE_PHY_TURBO_DECODER_ENUM;
+static const char liblte_phy_turbo_decoder_text[LIBLTE_PHY_TURBO_DECODER_N_ITEMS][20] = {"Viterbi SISO", "Max-Log-MAP"};
+
+typedef enum{
+    LIBLTE_PHY_TURBO_KERNEL_SCALAR = 0,
+    LIBLTE_PHY_TURBO_KERNEL_SSE4_1,
+    LIBLTE_PHY_TURBO_KERNEL_AVX2,
+    LIBLTE_PHY_TURBO_KERNEL_N_ITEMS,
+}LIBLTE_PHY_TURBO_KERNEL_ENUM;
+static const char liblte_phy_turbo_kernel_text[LIBLTE_PHY_TURBO_KERNEL_N_ITEMS][20] = {"Scalar", "SSE4.1", "AVX2"};
+
+typedef enum{
+    LIBLTE_PHY_COARSE_TIMING_METHOD_CP_CORR = 0,
+    LIBLTE_PHY_COARSE_TIMING_METHOD_PSS_CORR,
+    LIBLTE_PHY_COARSE_TIMING_METHOD_N_ITEMS,
+}LIBLTE_PHY_COARSE_TIMING_METHOD_ENUM;
+static const char liblte_phy_coarse_timing_method_text[LIBLTE_PHY_COARSE_TIMING_METHOD_N_ITEMS][20] = {"CP correlation", "PSS correlation"};
+
+typedef enum{
+    LIBLTE_PHY_DL_CE_INTERP_LINEAR = 0,
+    LIBLTE_PHY_DL_CE_INTERP_MMSE,
+    LIBLTE_PHY_DL_CE_INTERP_N_ITEMS,
+}LIBLTE_PHY_DL_CE_INTERP_ENUM;
+static const char liblte_phy_dl_ce_interp_text[LIBLTE_PHY_DL_CE_INTERP_N_ITEMS][20] = {"Linear", "MMSE"};
+
+typedef struct{
+    uint32 N_iterations[LIBLTE_PHY_MAX_N_CODE_BLOCKS];
+    uint32 decode_time_us[LIBLTE_PHY_MAX_N_CODE_BLOCKS];
+    uint32 N_codeblocks;
+    bool   crc_pass[LIBLTE_PHY_MAX_N_CODE_BLOCKS];
+}LIBLTE_PHY_TURBO_DECODE_STATS_STRUCT;
+
+typedef struct{
+    float  peak_to_noise[LIBLTE_PHY_PRACH_N_PREAMBLES];
+    uint32 detect_time_us;
+    uint32 N_roots;
+    uint32 N_detected;
+}LIBLTE_PHY_PRACH_DETECT_STATS_STRUCT;
+
+typedef struct{
+    uint32 decode_time_us;
+    uint32 N_cce;
+    uint32 N_cce_active;
+    uint32 N_cand_tried;
+    uint32 N_cand_decoded;
+    uint32 N_found;
+}LIBLTE_PHY_PDCCH_DECODE_STATS_STRUCT;
+
+typedef struct{
+    uint8  *base;
+    uint32  size;
+    uint32  used;
+    bool    huge_pages;
+}LIBLTE_PHY_ARENA_STRUCT;
+
+// The d_bits index (d_idx*3 + stream) of each non <NULL> bit in the
+// circular buffer, rate matching reads N_e_bits of them, wrapping
+// around, from the start position of the redundancy version
 typedef struct{
+    uint32 N_branch_bits;
+    uint32 N_fill_bits;
+    uint32 N_cb;
+    uint32 N_w_bits;
+    uint32 rv_start[4];
+    uint32 last_use;
+    bool   turbo;
+    bool   valid;
+    uint16 d_idx[LIBLTE_PHY_RATE_MATCH_MAX_W];
+}LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT;
+
+// Max-Log-MAP turbo decoder scratch, one per code block decoding thread
+typedef struct{
+    float  d_bits[LIBLTE_PHY_RATE_MATCH_MAX_W];
+    int16  llr[LIBLTE_PHY_RATE_MATCH_MAX_W];
+    uint32 pi_K;
+    int16  sys[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE+LIBLTE_PHY_TURBO_N_TAIL_BITS];
+    int16  par_1[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE+LIBLTE_PHY_TURBO_N_TAIL_BITS];
+    int16  sys_int[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE+LIBLTE_PHY_TURBO_N_TAIL_BITS];
+    int16  par_2[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE+LIBLTE_PHY_TURBO_N_TAIL_BITS];
+    int16  apriori[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
+    int16  extrinsic[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
+    int16  alpha[LIBLTE_PHY_TURBO_WINDOW_SIZE+1][LIBLTE_PHY_TURBO_N_STATES];
+    uint16 pi[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
+}LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT;
+
+// One code block of a transport block being decoded, the outputs are
+// valid once done is set
+typedef struct{
+    LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT *table;
+    LIBLTE_ERROR_ENUM                   err;
+    float                              *e_bits;
+    uint8                              *c_bits;
+    uint32                              N_e_bits;
+    uint32                              N_fill_bits;
+    uint32                              rv_idx;
+    uint32                              crc;
+    uint32                              N_c_bits;
+    uint32                              N_iterations;
+    uint32                              decode_time_us;
+    uint32                              done;
+}LIBLTE_PHY_CB_DECODE_TASK_STRUCT;
+
+// Code block decoding worker thread, phy_struct is the
+// LIBLTE_PHY_STRUCT the worker belongs to
+typedef struct{
+    LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT  ctx;
+    void                               *phy_struct;
+    pthread_t                           thread;
+    sem_t                               start_sem;
+    int32                               cpu;
+}LIBLTE_PHY_CB_DECODE_WORKER_STRUCT;
+
+// Interleaved complex sample, laid out like fftwf_complex,
+// std::complex<float> and gr_complex
+typedef struct{
+    float re;
+    float im;
+}LIBLTE_PHY_CF_STRUCT;
+
+// Resource elements of a subframe, stored as interleaved complex when
+// LIBLTE_PHY_INTERLEAVED_IQ is defined and as split re/im arrays
+// otherwise.  Use the liblte_phy_*_symb/ce accessors to stay
+// independent of the layout.
+typedef struct{
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    // Receive
+    LIBLTE_PHY_CF_STRUCT rx_symb[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    LIBLTE_PHY_CF_STRUCT rx_ce[LIBLTE_PHY_N_ANT_MAX][16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+
+    // Transmit
+    LIBLTE_PHY_CF_STRUCT tx_symb[LIBLTE_PHY_N_ANT_MAX][16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+#else
     // Receive
     float rx_symb_re[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float rx_symb_im[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
@@ -233,6 +410,7 @@ typedef struct{
     // Transmit
     float tx_symb_re[LIBLTE_PHY_N_ANT_MAX][16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float tx_symb_im[LIBLTE_PHY_N_ANT_MAX][16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+#endif
 
     // Common
     uint32 num;
@@ -242,15 +420,132 @@ typedef struct{
                               DECLARATIONS
 *******************************************************************************/
 
+/*********************************************************************
+    Name: liblte_phy_subframe accessors
+
+    Description: Read and write the resource elements of a subframe
+                 without depending on the layout selected by
+                 LIBLTE_PHY_INTERLEAVED_IQ.  liblte_phy_save_tx_symb
+                 and liblte_phy_load_tx_symb copy one symbol of N_sc
+                 resource elements to and from 2*N_sc floats.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+static inline float liblte_phy_rx_symb_re(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                          uint32                      l,
+                                          uint32                      k)
+{
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    return(subframe->rx_symb[l][k].re);
+#else
+    return(subframe->rx_symb_re[l][k]);
+#endif
+}
+static inline float liblte_phy_rx_symb_im(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                          uint32                      l,
+                                          uint32                      k)
+{
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    return(subframe->rx_symb[l][k].im);
+#else
+    return(subframe->rx_symb_im[l][k]);
+#endif
+}
+static inline float liblte_phy_rx_ce_re(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                        uint32                      p,
+                                        uint32                      l,
+                                        uint32                      k)
+{
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    return(subframe->rx_ce[p][l][k].re);
+#else
+    return(subframe->rx_ce_re[p][l][k]);
+#endif
+}
+static inline float liblte_phy_rx_ce_im(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                        uint32                      p,
+                                        uint32                      l,
+                                        uint32                      k)
+{
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    return(subframe->rx_ce[p][l][k].im);
+#else
+    return(subframe->rx_ce_im[p][l][k]);
+#endif
+}
+static inline void liblte_phy_set_tx_symb(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                          uint32                      p,
+                                          uint32                      l,
+                                          uint32                      k,
+                                          float                       re,
+                                          float                       im)
+{
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    subframe->tx_symb[p][l][k].re = re;
+    subframe->tx_symb[p][l][k].im = im;
+#else
+    subframe->tx_symb_re[p][l][k] = re;
+    subframe->tx_symb_im[p][l][k] = im;
+#endif
+}
+static inline void liblte_phy_clear_tx_symb(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                            uint32                      p,
+                                            uint32                      l,
+                                            uint32                      N_sc)
+{
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    memset(subframe->tx_symb[p][l], 0, sizeof(LIBLTE_PHY_CF_STRUCT)*N_sc);
+#else
+    memset(subframe->tx_symb_re[p][l], 0, sizeof(float)*N_sc);
+    memset(subframe->tx_symb_im[p][l], 0, sizeof(float)*N_sc);
+#endif
+}
+static inline void liblte_phy_save_tx_symb(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                           uint32                      p,
+                                           uint32                      l,
+                                           uint32                      N_sc,
+                                           float                      *buf)
+{
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    memcpy(buf, subframe->tx_symb[p][l], sizeof(LIBLTE_PHY_CF_STRUCT)*N_sc);
+#else
+    memcpy(&buf[0],    subframe->tx_symb_re[p][l], sizeof(float)*N_sc);
+    memcpy(&buf[N_sc], subframe->tx_symb_im[p][l], sizeof(float)*N_sc);
+#endif
+}
+static inline void liblte_phy_load_tx_symb(LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                           uint32                      p,
+                                           uint32                      l,
+                                           uint32                      N_sc,
+                                           float                      *buf)
+{
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    memcpy(subframe->tx_symb[p][l], buf, sizeof(LIBLTE_PHY_CF_STRUCT)*N_sc);
+#else
+    memcpy(subframe->tx_symb_re[p][l], &buf[0],    sizeof(float)*N_sc);
+    memcpy(subframe->tx_symb_im[p][l], &buf[N_sc], sizeof(float)*N_sc);
+#endif
+}
+
 /*********************************************************************
     Name: liblte_phy_init
 
-    Description: Initializes the LTE Physical Layer library.
+    Description: Initializes the LTE Physical Layer library.  Tables
+                 that depend on the bandwidth are sized for the largest
+                 N_rb_dl supported by fs (N_rb_max) and all memory is
+                 aligned to 64 bytes.  mem_footprint holds the bytes
+                 allocated for the context, including the tables added
+                 by liblte_phy_ul_init.
 
     Document Reference: N/A
 *********************************************************************/
 // Defines
 #define LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN 0xFFFF
+#define LIBLTE_PHY_MEM_ALIGN              64
 // Enums
 // Structs
 typedef struct{
@@ -259,27 +554,29 @@ typedef struct{
     fftwf_complex *transform_precoding_out;
     fftwf_plan     transform_precoding_plan[LIBLTE_PHY_N_RB_UL_MAX];
     fftwf_plan     transform_pre_decoding_plan[LIBLTE_PHY_N_RB_UL_MAX];
-    float          pusch_z_est_re[14400];
-    float          pusch_z_est_im[14400];
-    float          pusch_c_est_0_re[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float          pusch_c_est_0_im[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float          pusch_c_est_1_re[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float          pusch_c_est_1_im[LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float          pusch_c_est_re[14400];
-    float          pusch_c_est_im[14400];
-    float          pusch_z_re[LIBLTE_PHY_N_ANT_MAX][14400];
-    float          pusch_z_im[LIBLTE_PHY_N_ANT_MAX][14400];
-    float          pusch_y_re[14400];
-    float          pusch_y_im[14400];
-    float          pusch_x_re[14400];
-    float          pusch_x_im[14400];
-    float          pusch_d_re[14400];
-    float          pusch_d_im[14400];
-    float          pusch_descramb_bits[28800];
-    uint32         pusch_c[28800];
-    uint8          pusch_encode_bits[28800];
-    uint8          pusch_scramb_bits[28800];
-    int8           pusch_soft_bits[28800];
+
+    // PUSCH scratch, allocated from ul_arena and sized for N_rb_max
+    float  *pusch_z_est_re;
+    float  *pusch_z_est_im;
+    float  *pusch_c_est_0_re;
+    float  *pusch_c_est_0_im;
+    float  *pusch_c_est_1_re;
+    float  *pusch_c_est_1_im;
+    float  *pusch_c_est_re;
+    float  *pusch_c_est_im;
+    float  *pusch_z_re[LIBLTE_PHY_N_ANT_MAX];
+    float  *pusch_z_im[LIBLTE_PHY_N_ANT_MAX];
+    float  *pusch_y_re;
+    float  *pusch_y_im;
+    float  *pusch_x_re;
+    float  *pusch_x_im;
+    float  *pusch_d_re;
+    float  *pusch_d_im;
+    float  *pusch_descramb_bits;
+    uint32 *pusch_c;
+    uint8  *pusch_encode_bits;
+    uint8  *pusch_scramb_bits;
+    int8   *pusch_soft_bits;
 
     // PUCCH
     float pucch_z_est_re[LIBLTE_PHY_N_SC_RB_UL*14];
@@ -300,11 +597,14 @@ typedef struct{
     float  ulrs_r_bar_u_v_im[2048];
     uint32 ulrs_c[160];
 
-    // DMRS
-    float  pusch_dmrs_0_re[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float  pusch_dmrs_0_im[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float  pusch_dmrs_1_re[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
-    float  pusch_dmrs_1_im[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX][LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL];
+    // DMRS, pusch_dmrs_*[subfr][N_prb] points to N_prb*N_sc_rb_ul
+    // values in ul_arena for every N_prb up to N_rb_max.  ul_arena
+    // also holds the PUSCH scratch
+    LIBLTE_PHY_ARENA_STRUCT  ul_arena;
+    float                   *pusch_dmrs_0_re[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX];
+    float                   *pusch_dmrs_0_im[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX];
+    float                   *pusch_dmrs_1_re[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX];
+    float                   *pusch_dmrs_1_im[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX];
     float  pucch_dmrs_0_re[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX/2][LIBLTE_PHY_M_PUCCH_RS*LIBLTE_PHY_N_SC_RB_UL];
     float  pucch_dmrs_0_im[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX/2][LIBLTE_PHY_M_PUCCH_RS*LIBLTE_PHY_N_SC_RB_UL];
     float  pucch_dmrs_1_re[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX/2][LIBLTE_PHY_M_PUCCH_RS*LIBLTE_PHY_N_SC_RB_UL];
@@ -317,50 +617,72 @@ typedef struct{
     uint32 pucch_n_oc_p[LIBLTE_PHY_N_SUBFR_PER_FRAME][LIBLTE_PHY_N_RB_UL_MAX/2][2];
 
     // PRACH
-    fftwf_complex *prach_dft_in;
-    fftwf_complex *prach_dft_out;
-    fftwf_complex *prach_fft_in;
-    fftwf_complex *prach_fft_out;
-    fftwf_plan     prach_dft_plan;
-    fftwf_plan     prach_ifft_plan;
-    fftwf_plan     prach_fft_plan;
-    fftwf_plan     prach_idft_plan;
-    float          prach_x_u_v_re[64][839];
-    float          prach_x_u_v_im[64][839];
-    float          prach_x_u_re[64][839];
-    float          prach_x_u_im[64][839];
-    float          prach_x_u_fft_re[64][839];
-    float          prach_x_u_fft_im[64][839];
-    float          prach_x_hat_re[839];
-    float          prach_x_hat_im[839];
-    uint32         prach_zczc;
-    uint32         prach_preamble_format;
-    uint32         prach_root_seq_idx;
-    uint32         prach_N_x_u;
-    uint32         prach_N_zc;
-    uint32         prach_T_fft;
-    uint32         prach_T_seq;
-    uint32         prach_T_cp;
-    uint32         prach_delta_f_RA;
-    uint32         prach_phi;
-    bool           prach_hs_flag;
-
-    // PDSCH
-    float  pdsch_y_est_re[5000];
-    float  pdsch_y_est_im[5000];
-    float  pdsch_c_est_re[LIBLTE_PHY_N_ANT_MAX][5000];
-    float  pdsch_c_est_im[LIBLTE_PHY_N_ANT_MAX][5000];
-    float  pdsch_y_re[LIBLTE_PHY_N_ANT_MAX][5000];
-    float  pdsch_y_im[LIBLTE_PHY_N_ANT_MAX][5000];
-    float  pdsch_x_re[10000];
-    float  pdsch_x_im[10000];
-    float  pdsch_d_re[10000];
-    float  pdsch_d_im[10000];
-    float  pdsch_descramb_bits[10000];
-    uint32 pdsch_c[10000];
-    uint8  pdsch_encode_bits[10000];
-    uint8  pdsch_scramb_bits[10000];
-    int8   pdsch_soft_bits[10000];
+    LIBLTE_PHY_PRACH_DETECT_STATS_STRUCT prach_stats;
+    fftwf_complex                       *prach_dft_in;
+    fftwf_complex                       *prach_dft_out;
+    fftwf_complex                       *prach_fft_in;
+    fftwf_complex                       *prach_fft_out;
+    fftwf_complex                       *prach_dec_fft_in;
+    fftwf_complex                       *prach_dec_fft_out;
+    fftwf_plan                           prach_dft_plan;
+    fftwf_plan                           prach_ifft_plan;
+    fftwf_plan                           prach_dec_fft_plan;
+    fftwf_plan                           prach_idft_plan;
+    float                                prach_x_u_v_re[64][839];
+    float                                prach_x_u_v_im[64][839];
+    float                                prach_x_u_re[64][839];
+    float                                prach_x_u_im[64][839];
+    float                                prach_x_u_fft_re[64][839];
+    float                                prach_x_u_fft_im[64][839];
+    float                                prach_x_hat_re[839];
+    float                                prach_x_hat_im[839];
+    float                                prach_corr[839];
+    float                                prach_dec_h[LIBLTE_PHY_PRACH_DEC_N_TAPS_MAX];
+    float                                prach_dec_g_re[LIBLTE_PHY_PRACH_DEC_N_TAPS_MAX];
+    float                                prach_dec_g_im[LIBLTE_PHY_PRACH_DEC_N_TAPS_MAX];
+    float                                prach_dec_comp[839];
+    float                                prach_dec_x_re[LIBLTE_PHY_PRACH_T_FFT_MAX+LIBLTE_PHY_PRACH_DEC_N_TAPS_MAX];
+    float                                prach_dec_x_im[LIBLTE_PHY_PRACH_T_FFT_MAX+LIBLTE_PHY_PRACH_DEC_N_TAPS_MAX];
+    float                                prach_threshold;
+    uint32                               prach_dec_factor;
+    uint32                               prach_dec_N_fft;
+    uint32                               prach_dec_N_taps;
+    uint32                               prach_dec_freq_offset;
+    uint32                               prach_C_v[64];
+    uint32                               prach_root[64];
+    uint32                               prach_N_cs;
+    uint32                               prach_zczc;
+    uint32                               prach_preamble_format;
+    uint32                               prach_root_seq_idx;
+    uint32                               prach_N_x_u;
+    uint32                               prach_N_zc;
+    uint32                               prach_T_fft;
+    uint32                               prach_T_seq;
+    uint32                               prach_T_cp;
+    uint32                               prach_delta_f_RA;
+    uint32                               prach_phi;
+    bool                                 prach_hs_flag;
+
+    // PDSCH, allocated from dl_arena and sized for N_rb_max, the
+    // pdsch_c_est_* and pdsch_y_* blocks of each antenna follow each
+    // other pdsch_N_re_max values apart
+    float  *pdsch_y_est_re;
+    float  *pdsch_y_est_im;
+    float  *pdsch_c_est_re[LIBLTE_PHY_N_ANT_MAX];
+    float  *pdsch_c_est_im[LIBLTE_PHY_N_ANT_MAX];
+    float  *pdsch_y_re[LIBLTE_PHY_N_ANT_MAX];
+    float  *pdsch_y_im[LIBLTE_PHY_N_ANT_MAX];
+    float  *pdsch_x_re;
+    float  *pdsch_x_im;
+    float  *pdsch_d_re;
+    float  *pdsch_d_im;
+    float  *pdsch_descramb_bits;
+    uint32 *pdsch_c;
+    uint8  *pdsch_c_bytes;
+    uint8  *pdsch_encode_bytes;
+    uint8  *pdsch_scramb_bytes;
+    int8   *pdsch_soft_bits;
+    uint32  pdsch_N_re_max;
 
     // BCH
     float  bch_y_est_re[240];
@@ -383,63 +705,79 @@ typedef struct{
     uint8  bch_scramb_bits[480];
     int8   bch_soft_bits[480];
 
-    // PDCCH
-    float  pdcch_reg_y_est_re[LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_reg_y_est_im[LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_reg_c_est_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_reg_c_est_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_shift_y_est_re[LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_shift_y_est_im[LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_shift_c_est_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_shift_c_est_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_perm_y_est_re[LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_perm_y_est_im[LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_perm_c_est_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_perm_c_est_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_cce_y_est_re[LIBLTE_PHY_PDCCH_N_CCE_MAX][LIBLTE_PHY_PDCCH_N_RE_CCE];
-    float  pdcch_cce_y_est_im[LIBLTE_PHY_PDCCH_N_CCE_MAX][LIBLTE_PHY_PDCCH_N_RE_CCE];
-    float  pdcch_cce_c_est_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_CCE_MAX][LIBLTE_PHY_PDCCH_N_RE_CCE];
-    float  pdcch_cce_c_est_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_CCE_MAX][LIBLTE_PHY_PDCCH_N_RE_CCE];
+    // PDCCH, the REG and CCE buffers are allocated from dl_arena and
+    // sized for the REGs and CCEs of N_rb_max
+    LIBLTE_PHY_PDCCH_DECODE_STATS_STRUCT pdcch_stats;
+    float  (*pdcch_reg_y_est_re)[4];
+    float  (*pdcch_reg_y_est_im)[4];
+    float  (*pdcch_reg_c_est_re[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_reg_c_est_im[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_shift_y_est_re)[4];
+    float  (*pdcch_shift_y_est_im)[4];
+    float  (*pdcch_shift_c_est_re[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_shift_c_est_im[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_perm_y_est_re)[4];
+    float  (*pdcch_perm_y_est_im)[4];
+    float  (*pdcch_perm_c_est_re[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_perm_c_est_im[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_cce_y_est_re)[LIBLTE_PHY_PDCCH_N_RE_CCE];
+    float  (*pdcch_cce_y_est_im)[LIBLTE_PHY_PDCCH_N_RE_CCE];
+    float  (*pdcch_cce_c_est_re[LIBLTE_PHY_N_ANT_MAX])[LIBLTE_PHY_PDCCH_N_RE_CCE];
+    float  (*pdcch_cce_c_est_im[LIBLTE_PHY_N_ANT_MAX])[LIBLTE_PHY_PDCCH_N_RE_CCE];
     float  pdcch_y_est_re[LIBLTE_PHY_PDCCH_N_BITS_MAX / 2];
     float  pdcch_y_est_im[LIBLTE_PHY_PDCCH_N_BITS_MAX / 2];
     float  pdcch_c_est_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_BITS_MAX / 2];
     float  pdcch_c_est_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_BITS_MAX / 2];
     float  pdcch_y_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_BITS_MAX / 2];
     float  pdcch_y_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_BITS_MAX / 2];
-    float  pdcch_cce_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_CCE_MAX][LIBLTE_PHY_PDCCH_N_RE_CCE];
-    float  pdcch_cce_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_CCE_MAX][LIBLTE_PHY_PDCCH_N_RE_CCE];
-    float  pdcch_reg_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_reg_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_perm_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_perm_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_shift_re[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
-    float  pdcch_shift_im[LIBLTE_PHY_N_ANT_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX][4];
+    float  (*pdcch_cce_re[LIBLTE_PHY_N_ANT_MAX])[LIBLTE_PHY_PDCCH_N_RE_CCE];
+    float  (*pdcch_cce_im[LIBLTE_PHY_N_ANT_MAX])[LIBLTE_PHY_PDCCH_N_RE_CCE];
+    float  (*pdcch_reg_re[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_reg_im[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_perm_re[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_perm_im[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_shift_re[LIBLTE_PHY_N_ANT_MAX])[4];
+    float  (*pdcch_shift_im[LIBLTE_PHY_N_ANT_MAX])[4];
     float  pdcch_x_re[LIBLTE_PHY_PDCCH_N_BITS_MAX / 2];
     float  pdcch_x_im[LIBLTE_PHY_PDCCH_N_BITS_MAX / 2];
     float  pdcch_d_re[LIBLTE_PHY_PDCCH_N_BITS_MAX / 2];
     float  pdcch_d_im[LIBLTE_PHY_PDCCH_N_BITS_MAX / 2];
     float  pdcch_descramb_bits[LIBLTE_PHY_PDCCH_N_BITS_MAX];
-    uint32 pdcch_c[LIBLTE_PHY_PDCCH_N_BITS_MAX * 2];
-    uint32 pdcch_permute_map[LIBLTE_PHY_PDCCH_N_REGS_MAX][LIBLTE_PHY_PDCCH_N_REGS_MAX];
+    float  pdcch_cce_soft_bits[LIBLTE_PHY_PDCCH_N_CCE_MAX * LIBLTE_PHY_PDCCH_N_BITS_CCE];
+    uint32 pdcch_c[LIBLTE_PHY_PDCCH_N_CCE_MAX * LIBLTE_PHY_PDCCH_N_BITS_CCE];
+    uint32 pdcch_permute_map[4][LIBLTE_PHY_PDCCH_N_REGS_MAX];
+    uint32 pdcch_permute_N_reg[4];
     uint16 pdcch_reg_vec[LIBLTE_PHY_PDCCH_N_REGS_MAX];
     uint16 pdcch_reg_perm_vec[LIBLTE_PHY_PDCCH_N_REGS_MAX];
     uint8  pdcch_dci[LIBLTE_PHY_PDCCH_N_BITS_MAX];
     uint8  pdcch_encode_bits[LIBLTE_PHY_PDCCH_N_BITS_MAX];
     uint8  pdcch_scramb_bits[LIBLTE_PHY_PDCCH_N_BITS_MAX];
     int8   pdcch_soft_bits[LIBLTE_PHY_PDCCH_N_BITS_MAX];
+    uint32 pdcch_N_ue_rntis;
+    uint16 pdcch_ue_rntis[LIBLTE_PHY_PDCCH_MAX_UE_RNTIS];
     bool   pdcch_cce_used[LIBLTE_PHY_PDCCH_N_CCE_MAX];
+    bool   pdcch_cce_active[LIBLTE_PHY_PDCCH_N_CCE_MAX];
 
     // PHICH
     uint32 N_group_phich;
     uint32 N_sf_phich;
 
-    // CRS & Channel Estimate
-    float crs_re[14][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float crs_im[14][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float dl_ce_crs_re[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float dl_ce_crs_im[16][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float dl_ce_mag[5][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float dl_ce_ang[5][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    // CRS & Channel Estimate, the per subcarrier buffers are allocated
+    // from dl_arena and sized for N_rb_max
+    LIBLTE_PHY_DL_CE_INTERP_ENUM  dl_ce_interp;
+    float                         dl_ce_crs_re[5][2*LIBLTE_PHY_N_RB_DL_20MHZ];
+    float                         dl_ce_crs_im[5][2*LIBLTE_PHY_N_RB_DL_20MHZ];
+    float                        *dl_ce_re[5];
+    float                        *dl_ce_im[5];
+    float                        *dl_ce_w_re[6][LIBLTE_PHY_DL_CE_N_TAPS_MAX];
+    float                        *dl_ce_w_im[6][LIBLTE_PHY_DL_CE_N_TAPS_MAX];
+    float                        *dl_ce_avg_re[LIBLTE_PHY_N_ANT_MAX][5];
+    float                        *dl_ce_avg_im[LIBLTE_PHY_N_ANT_MAX][5];
+    float                         dl_ce_avg_alpha;
+    uint32                        dl_ce_avg_N_id_cell;
+    uint32                        dl_ce_n_taps;
+    uint16                       *dl_ce_w_idx[6];
+    bool                          dl_ce_avg_valid[LIBLTE_PHY_N_ANT_MAX];
 
     // PSS
     float pss_mod_re_n1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
@@ -449,11 +787,11 @@ typedef struct{
     float pss_mod_re_p1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float pss_mod_im_p1[3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
 
-    // SSS
-    float sss_mod_re_0[168][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float sss_mod_im_0[168][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float sss_mod_re_5[168][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float sss_mod_im_5[168][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    // SSS, only the 62 center subcarriers of each sequence are kept
+    float sss_mod_re_0[168][64];
+    float sss_mod_im_0[168][64];
+    float sss_mod_re_5[168][64];
+    float sss_mod_im_5[168][64];
     float sss_re_0[63];
     float sss_im_0[63];
     float sss_re_5[63];
@@ -472,12 +810,25 @@ typedef struct{
     int8  sss_z1_m1[31];
 
     // Timing
-    float dl_timing_abs_corr[LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ*2];
+    LIBLTE_PHY_COARSE_TIMING_METHOD_ENUM  dl_timing_method;
+    fftwf_complex                        *dl_pss_corr_in;
+    fftwf_complex                        *dl_pss_corr_out;
+    fftwf_complex                        *dl_pss_corr_dec_in;
+    fftwf_complex                        *dl_pss_corr_dec_out;
+    fftwf_plan                            dl_pss_corr_fft_plan;
+    fftwf_plan                            dl_pss_corr_ifft_plan;
+    float                                 dl_timing_abs_corr[LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ*2];
+    float                                 dl_timing_prod_re[LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ+LIBLTE_PHY_N_SAMPS_CP_L_ELSE_30_72MHZ];
+    float                                 dl_timing_prod_im[LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ+LIBLTE_PHY_N_SAMPS_CP_L_ELSE_30_72MHZ];
+    float                                 dl_pss_corr_fd_re[3][LIBLTE_PHY_PSS_CORR_N_BINS];
+    float                                 dl_pss_corr_fd_im[3][LIBLTE_PHY_PSS_CORR_N_BINS];
+    float                                 dl_pss_corr_abs[3][LIBLTE_PHY_PSS_CORR_N_HALF_FRAME];
 
     // CRS Storage
-    float  crs_re_storage[20][3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
-    float  crs_im_storage[20][3][LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
+    float  crs_re_storage[20][3][2*LIBLTE_PHY_N_RB_DL_MAX];
+    float  crs_im_storage[20][3][2*LIBLTE_PHY_N_RB_DL_MAX];
     uint32 N_id_cell_crs;
+    uint32 crs_storage_valid;
 
     // Samples to Symbols & Symbols to Samples
     fftwf_complex *s2s_in;
@@ -485,7 +836,10 @@ typedef struct{
     fftwf_plan     symbs_to_samps_dl_plan;
     fftwf_plan     samps_to_symbs_dl_plan;
     fftwf_plan     symbs_to_samps_ul_plan;
-    fftwf_plan     samps_to_symbs_ul_plan;
+    fftwf_plan     samps_to_symbs_dl_subfr_plan;
+    fftwf_plan     samps_to_symbs_ul_subfr_plan;
+    float          s2s_ul_rot_re[LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ];
+    float          s2s_ul_rot_im[LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ];
 
     // Viterbi decode
     float vd_path_metric[LIBLTE_PHY_MAX_VITERBI_STATES][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
@@ -497,6 +851,13 @@ typedef struct{
     float vd_tb_weight[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     uint8 vd_st_output[LIBLTE_PHY_MAX_VITERBI_STATES][2][3];
 
+    // Viterbi decode (K=7 tail-biting)
+    uint32 vd_k7_g[3];
+    int16  vd_k7_sign[2][3][LIBLTE_PHY_VITERBI_K7_N_STATES];
+    int16  vd_k7_metric[2][LIBLTE_PHY_VITERBI_K7_N_STATES];
+    int16  vd_k7_in[3*LIBLTE_PHY_VITERBI_K7_MAX_BITS];
+    uint64 vd_k7_dec[LIBLTE_PHY_VITERBI_K7_MAX_STEPS];
+
     // Turbo encode
     uint8 te_z[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     uint8 te_fb1[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
@@ -504,6 +865,11 @@ typedef struct{
     uint8 te_z_prime[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     uint8 te_x_prime[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
 
+    // Turbo encode packed
+    uint32 te_pi_K;
+    uint16 te_pi[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
+    uint8  te_c_prime_bytes[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/8];
+
     // Turbo decode
     int8 td_vitdec_in[LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     int8 td_in_int[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
@@ -520,33 +886,35 @@ typedef struct{
     int8 td_fb_int_1[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     int8 td_fb_int_2[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
 
-    // Rate Match Turbo
-    uint8 rmt_tmp[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-    uint8 rmt_sb_mat[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/LIBLTE_PHY_N_COLUMNS_RATE_MATCH][LIBLTE_PHY_N_COLUMNS_RATE_MATCH];
-    uint8 rmt_sb_perm_mat[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/LIBLTE_PHY_N_COLUMNS_RATE_MATCH][LIBLTE_PHY_N_COLUMNS_RATE_MATCH];
-    uint8 rmt_y[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-    uint8 rmt_w[LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-
-    // Rate Unmatch Turbo
-    float rut_tmp[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-    float rut_sb_mat[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/LIBLTE_PHY_N_COLUMNS_RATE_MATCH][LIBLTE_PHY_N_COLUMNS_RATE_MATCH];
-    float rut_sb_perm_mat[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/LIBLTE_PHY_N_COLUMNS_RATE_MATCH][LIBLTE_PHY_N_COLUMNS_RATE_MATCH];
-    float rut_y[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-    float rut_w_dum[LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-    float rut_w[LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-    float rut_v[LIBLTE_PHY_BASE_CODING_RATE][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-
-    // Rate Match Conv
-    uint8 rmc_tmp[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-    uint8 rmc_sb_mat[LIBLTE_PHY_N_COLUMNS_RATE_MATCH][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/LIBLTE_PHY_N_COLUMNS_RATE_MATCH];
-    uint8 rmc_sb_perm_mat[LIBLTE_PHY_N_COLUMNS_RATE_MATCH][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/LIBLTE_PHY_N_COLUMNS_RATE_MATCH];
-    uint8 rmc_w[LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-
-    // Rate Unatch Conv
+    // Turbo decode (Max-Log-MAP)
+    LIBLTE_PHY_TURBO_DECODE_STATS_STRUCT td_stats;
+    LIBLTE_PHY_TURBO_DECODER_ENUM        td_type;
+    LIBLTE_PHY_TURBO_KERNEL_ENUM         td_kernel;
+    uint32                               td_max_iterations;
+
+    // Code block decoding, the calling thread and the workers claim
+    // tasks through cbd_claim, which holds the round in the upper 32
+    // bits, the number of tasks in the next 16 and the next task to
+    // be claimed in the lower 16
+    LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT  cbd_ctx;
+    LIBLTE_PHY_CB_DECODE_TASK_STRUCT    cbd_task[LIBLTE_PHY_MAX_N_CODE_BLOCKS];
+    LIBLTE_PHY_CB_DECODE_WORKER_STRUCT *cbd_worker;
+    uint64                              cbd_claim;
+    uint32                              cbd_N_workers;
+    uint32                              cbd_mem_size;
+    bool                                cbd_huge_pages;
+    bool                                cbd_shutdown;
+
+    // Rate Match/Unmatch tables, least recently used is replaced
+    LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT rm_table[LIBLTE_PHY_RATE_MATCH_N_TABLES];
+    uint32                             rm_use_count;
+    uint32                             rm_N_table_hits;
+    uint32                             rm_N_table_misses;
+
+    // PDCCH REG Permutation
     float ruc_tmp[LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     float ruc_sb_mat[LIBLTE_PHY_N_COLUMNS_RATE_MATCH][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/LIBLTE_PHY_N_COLUMNS_RATE_MATCH];
     float ruc_sb_perm_mat[LIBLTE_PHY_N_COLUMNS_RATE_MATCH][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/LIBLTE_PHY_N_COLUMNS_RATE_MATCH];
-    float ruc_w_dum[LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     float ruc_w[LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     float ruc_v[LIBLTE_PHY_BASE_CODING_RATE][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
 
@@ -554,35 +922,37 @@ typedef struct{
     // FIXME: Sizes
     float  ulsch_y_idx[92160];
     float  ulsch_y_mat[92160];
-    float  ulsch_rx_d_bits[75376];
-    float  ulsch_rx_e_bits[5][LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     float  ulsch_rx_f_bits[92160];
     float  ulsch_rx_g_bits[92160];
-    uint32 ulsch_N_c_bits[5];
-    uint32 ulsch_N_e_bits[5];
-    uint8  ulsch_b_bits[30720];
-    uint8  ulsch_c_bits[5][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
+    uint32 ulsch_N_c_bits[LIBLTE_PHY_MAX_N_CODE_BLOCKS];
+    uint32 ulsch_N_e_bits[LIBLTE_PHY_MAX_N_CODE_BLOCKS];
+    uint8  ulsch_b_bits[LIBLTE_PHY_MAX_TB_SIZE];
+    uint8  ulsch_c_bits[LIBLTE_PHY_MAX_N_CODE_BLOCKS][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     uint8  ulsch_tx_d_bits[75376];
-    uint8  ulsch_tx_e_bits[5][LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
+    uint8  ulsch_tx_e_bits[LIBLTE_PHY_MAX_N_CODE_BLOCKS][LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     uint8  ulsch_tx_f_bits[92160];
     uint8  ulsch_tx_g_bits[92160];
 
     // DLSCH
     // FIXME: Sizes
-    float  dlsch_rx_d_bits[75376];
-    float  dlsch_rx_e_bits[5][LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
-    uint32 dlsch_N_c_bits[5];
-    uint32 dlsch_N_e_bits[5];
-    uint8  dlsch_b_bits[30720];
-    uint8  dlsch_c_bits[5][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
+    uint32 dlsch_N_c_bits[LIBLTE_PHY_MAX_N_CODE_BLOCKS];
+    uint32 dlsch_N_e_bits[LIBLTE_PHY_MAX_N_CODE_BLOCKS];
+    uint8  dlsch_b_bits[LIBLTE_PHY_MAX_TB_SIZE];
+    uint8  dlsch_c_bits[LIBLTE_PHY_MAX_N_CODE_BLOCKS][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
     uint8  dlsch_tx_d_bits[75376];
-    uint8  dlsch_tx_e_bits[5][LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
+    uint8  dlsch_b_bytes[LIBLTE_PHY_MAX_TB_SIZE/8];
+    uint8  dlsch_c_bytes[LIBLTE_PHY_MAX_N_CODE_BLOCKS][LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/8];
+    uint8  dlsch_tx_d_bytes[LIBLTE_PHY_BASE_CODING_RATE*(LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/8+1)];
 
     // DCI
     float dci_rx_d_bits[576];
     uint8 dci_tx_d_bits[576];
     uint8 dci_c_bits[192];
 
+    // DL scratch, holds the bandwidth dependent PDSCH, PDCCH and DL
+    // channel estimate buffers
+    LIBLTE_PHY_ARENA_STRUCT dl_arena;
+
     // Generic
     float  rx_symb_re[LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
     float  rx_symb_im[LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP];
@@ -599,8 +969,11 @@ typedef struct{
     uint32 N_sc_rb_ul;
     uint32 FFT_pad_size;
     uint32 FFT_size;
+    uint32 N_rb_max;
+    uint32 mem_footprint;
     uint8  N_ant;
     bool   ul_init;
+    bool   huge_pages;
 }LIBLTE_PHY_STRUCT;
 // Functions
 LIBLTE_ERROR_ENUM liblte_phy_init(LIBLTE_PHY_STRUCT  **phy_struct,
@@ -652,6 +1025,192 @@ LIBLTE_ERROR_ENUM liblte_phy_ul_cleanup(LIBLTE_PHY_STRUCT *phy_struct);
 LIBLTE_ERROR_ENUM liblte_phy_update_n_rb_dl(LIBLTE_PHY_STRUCT *phy_struct,
                                             uint32             N_rb_dl);
 
+/*********************************************************************
+    Name: liblte_phy_set_fftw_wisdom_file
+
+    Description: Sets the file used to keep FFTW wisdom between runs
+                 and imports the wisdom already saved in it.  The
+                 FFTW version and CPU model are appended to file_name,
+                 so wisdom is never used with a different library or
+                 machine.  liblte_phy_init and liblte_phy_ul_init save
+                 the wisdom after planning.  A NULL or empty file_name
+                 stops saving.  Wisdom files owned or writable by
+                 other users are not imported.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_FFTW_WISDOM_FILE_NAME_MAX 1024
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_fftw_wisdom_file(const char *file_name);
+
+/*********************************************************************
+    Name: liblte_phy_plan_all_fftw_wisdom
+
+    Description: Plans the FFTs of every sample rate and bandwidth and
+                 saves the wisdom to the file set by
+                 liblte_phy_set_fftw_wisdom_file, so that later calls
+                 to liblte_phy_init and liblte_phy_ul_init only load
+                 plans.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_plan_all_fftw_wisdom(void);
+
+/*********************************************************************
+    Name: liblte_phy_set_huge_pages
+
+    Description: Selects whether PHY contexts created by later calls
+                 to liblte_phy_init and liblte_phy_ul_init are backed
+                 by huge pages.  Explicit huge pages are used when the
+                 system has them reserved, transparent huge pages are
+                 requested otherwise.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_HUGE_PAGE_SIZE (2*1024*1024)
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_huge_pages(bool enable);
+
+/*********************************************************************
+    Name: liblte_phy_set_turbo_decoder
+
+    Description: Selects the turbo decoder used by the PUSCH and
+                 PDSCH channel decoders and the maximum number of
+                 decoder iterations.  Statistics for the most recent
+                 transport block are available in td_stats.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_turbo_decoder(LIBLTE_PHY_STRUCT             *phy_struct,
+                                               LIBLTE_PHY_TURBO_DECODER_ENUM  type,
+                                               uint32                         max_iterations);
+
+/*********************************************************************
+    Name: liblte_phy_set_turbo_kernel
+
+    Description: Selects the trellis kernel used by the Max-Log-MAP
+                 turbo decoder and the K=7 Viterbi decoder.  The
+                 fastest kernel supported by the CPU is selected by
+                 liblte_phy_init, this can be used to force a slower
+                 one.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_turbo_kernel(LIBLTE_PHY_STRUCT            *phy_struct,
+                                              LIBLTE_PHY_TURBO_KERNEL_ENUM  kernel);
+
+/*********************************************************************
+    Name: liblte_phy_set_decode_threads
+
+    Description: Sets the number of threads decoding the code blocks
+                 of a PUSCH or PDSCH transport block in parallel,
+                 including the calling thread.  N_threads-1 worker
+                 threads are started, worker n is pinned to CPU
+                 first_cpu+n-1 unless first_cpu is negative.  A
+                 N_threads of 1 stops the workers.
+
+    Document Reference: N/A
+
+    Notes: Only the Max-Log-MAP turbo decoder runs in the workers
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_decode_threads(LIBLTE_PHY_STRUCT *phy_struct,
+                                                uint32             N_threads,
+                                                int32              first_cpu);
+
+/*********************************************************************
+    Name: liblte_phy_set_coarse_timing_method
+
+    Description: Selects how liblte_phy_dl_find_coarse_timing_and_freq_offset
+                 searches for eNBs, either by cyclic prefix
+                 correlation or by FFT based correlation with the
+                 three PSS sequences.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_coarse_timing_method(LIBLTE_PHY_STRUCT                    *phy_struct,
+                                                      LIBLTE_PHY_COARSE_TIMING_METHOD_ENUM  method);
+
+/*********************************************************************
+    Name: liblte_phy_set_dl_channel_estimator
+
+    Description: Selects the frequency interpolation used between CRSs
+                 by liblte_phy_get_dl_subframe_and_ce and the weight
+                 given to the current subframe when averaging the CRS
+                 channel estimates across subframes.  A time_avg_alpha
+                 of 1 disables averaging.  Changing either restarts
+                 the averaging.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_dl_channel_estimator(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                      LIBLTE_PHY_DL_CE_INTERP_ENUM  interp,
+                                                      float                         time_avg_alpha);
+
+/*********************************************************************
+    Name: liblte_phy_set_prach_threshold
+
+    Description: Sets the PRACH detection threshold, as a ratio of the
+                 correlation peak power to the per root noise floor.
+                 Statistics for the most recent PRACH occasion are
+                 available in prach_stats.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_prach_threshold(LIBLTE_PHY_STRUCT *phy_struct,
+                                                 float              threshold);
+
+/*********************************************************************
+    Name: liblte_phy_set_pdcch_ue_rntis
+
+    Description: Sets the RNTIs whose UE specific search spaces are
+                 searched by liblte_phy_pdcch_channel_decode.  DCI 1As
+                 for these RNTIs are also accepted in the common search
+                 space.
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 9.1.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_set_pdcch_ue_rntis(LIBLTE_PHY_STRUCT *phy_struct,
+                                                uint16            *rntis,
+                                                uint32             N_rntis);
+
 /*********************************************************************
     Name: liblte_phy_pusch_channel_encode
 
@@ -851,7 +1410,9 @@ LIBLTE_ERROR_ENUM liblte_phy_generate_prach(LIBLTE_PHY_STRUCT *phy_struct,
 /*********************************************************************
     Name: liblte_phy_detect_prach
 
-    Description: Detects PRACHs from baseband I/Q
+    Description: Detects PRACHs from baseband I/Q, reporting every
+                 preamble whose cyclic shift zone peaks above the
+                 threshold set by liblte_phy_set_prach_threshold
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
 *********************************************************************/
@@ -867,6 +1428,25 @@ LIBLTE_ERROR_ENUM liblte_phy_detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
                                           uint32            *det_pre,
                                           uint32            *det_ta);
 
+/*********************************************************************
+    Name: liblte_phy_detect_prach_cf
+
+    Description: Detects PRACHs from interleaved complex baseband I/Q,
+                 see liblte_phy_detect_prach
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_detect_prach_cf(LIBLTE_PHY_STRUCT    *phy_struct,
+                                             LIBLTE_PHY_CF_STRUCT *samps,
+                                             uint32                freq_offset,
+                                             uint32               *N_det_pre,
+                                             uint32               *det_pre,
+                                             uint32               *det_ta);
+
 /*********************************************************************
     Name: liblte_phy_pdsch_channel_encode
 
@@ -999,11 +1579,16 @@ LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT
     Name: liblte_phy_pdcch_channel_decode
 
     Description: Demodulates and decodes all of the Physical Downlink
-                 Control Channels (PCFICH, PHICH, and PDCCH)
+                 Control Channels (PCFICH, PHICH, and PDCCH).  The
+                 common search space and the UE specific search spaces
+                 of the RNTIs set by liblte_phy_set_pdcch_ue_rntis are
+                 searched.  Statistics for the most recent subframe
+                 are available in pdcch_stats.
 
     Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.7, 6.8, and
                         6.9
                         3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+                        3GPP TS 36.213 v10.3.0 section 9.1.1
 *********************************************************************/
 // Defines
 // Enums
@@ -1117,7 +1702,11 @@ LIBLTE_ERROR_ENUM liblte_phy_find_sss(LIBLTE_PHY_STRUCT *phy_struct,
 
     Description: Finds coarse time syncronization and frequency offset
                  by auto-correlating to find the cyclic prefix on
-                 reference signal symbols of the downlink
+                 reference signal symbols of the downlink, or by
+                 correlating with the PSS if selected with
+                 liblte_phy_set_coarse_timing_method.  The PSS search
+                 reads up to 4*N_samps_per_symb samples past the last
+                 slot.
 
     Document Reference: 3GPP TS 36.211 v10.1.0
 *********************************************************************/
@@ -1155,11 +1744,32 @@ LIBLTE_ERROR_ENUM liblte_phy_create_dl_subframe(LIBLTE_PHY_STRUCT          *phy_
                                                 float                      *i_samps,
                                                 float                      *q_samps);
 
+/*********************************************************************
+    Name: liblte_phy_create_dl_subframe_cf
+
+    Description: Creates the baseband signal for a particular
+                 downlink subframe as interleaved complex samples.
+                 The IFFT output is written straight into samps when
+                 its alignment allows it.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_create_dl_subframe_cf(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                   LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                                   uint8                       ant,
+                                                   LIBLTE_PHY_CF_STRUCT       *samps);
+
 /*********************************************************************
     Name: liblte_phy_get_dl_subframe_and_ce
 
     Description: Resolves all symbols and channel estimates for a
-                 particular downlink subframe
+                 particular downlink subframe.  Channel estimates are
+                 interpolated in complex form, first across subcarriers
+                 then across symbols.
 
     Document Reference: 3GPP TS 36.211 v10.1.0
 *********************************************************************/
@@ -1192,6 +1802,22 @@ LIBLTE_ERROR_ENUM liblte_phy_get_ul_subframe(LIBLTE_PHY_STRUCT          *phy_str
                                              float                      *q_samps,
                                              LIBLTE_PHY_SUBFRAME_STRUCT *subframe);
 
+/*********************************************************************
+    Name: liblte_phy_get_ul_subframe_cf
+
+    Description: Resolves all symbols for a particular uplink subframe
+                 from interleaved complex samples
+
+    Document Reference: 3GPP TS 36.211 v10.1.0
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_get_ul_subframe_cf(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                LIBLTE_PHY_CF_STRUCT       *samps,
+                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe);
+
 /*********************************************************************
     Name: liblte_phy_get_tbs_mcs_and_n_prb_for_dl
 
@@ -1297,6 +1923,34 @@ void liblte_phy_rate_match_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
                                  uint32                     N_e_bits,
                                  uint8                     *e_bits);
 
+/*********************************************************************
+    Name: liblte_phy_rate_match_turbo_packed
+
+    Description: Rate matches packed turbo encoded data, writing the
+                 output bits starting at e_offset.  This makes code
+                 block concatenation a matter of advancing e_offset.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.4.1 and
+                        5.1.5
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void liblte_phy_rate_match_turbo_packed(LIBLTE_PHY_STRUCT         *phy_struct,
+                                        uint8                     *d_bytes,
+                                        uint32                     N_d_bits,
+                                        uint32                     N_fill_bits,
+                                        uint32                     N_codeblocks,
+                                        uint32                     tx_mode,
+                                        uint32                     N_soft,
+                                        uint32                     M_dl_harq,
+                                        LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                                        uint32                     rv_idx,
+                                        uint32                     N_e_bits,
+                                        uint8                     *e_bytes,
+                                        uint32                     e_offset);
+
 /*********************************************************************
     Name: liblte_phy_rate_unmatch_turbo
 
@@ -1322,6 +1976,37 @@ void liblte_phy_rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
                                    float                     *d_bits,
                                    uint32                    *N_d_bits);
 
+/*********************************************************************
+    Name: liblte_phy_rate_unmatch_turbo_combine
+
+    Description: Rate unmatches turbo encoded data, soft combining it
+                 with the d_bits of earlier transmissions of the same
+                 code block (HARQ chase combining or incremental
+                 redundancy)
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
+
+    Notes: d_bits must hold the output of liblte_phy_rate_unmatch_turbo
+           for the first transmission
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void liblte_phy_rate_unmatch_turbo_combine(LIBLTE_PHY_STRUCT         *phy_struct,
+                                           float                     *e_bits,
+                                           uint32                     N_e_bits,
+                                           uint8                     *dummy_bits,
+                                           uint32                     N_dummy_bits,
+                                           uint32                     N_codeblocks,
+                                           uint32                     tx_mode,
+                                           uint32                     N_soft,
+                                           uint32                     M_dl_harq,
+                                           LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                                           uint32                     rv_idx,
+                                           float                     *d_bits,
+                                           uint32                    *N_d_bits);
+
 /*********************************************************************
     Name: liblte_phy_code_block_segmentation
 
@@ -1342,6 +2027,26 @@ void liblte_phy_code_block_segmentation(uint8  *b_bits,
                                         uint32  N_c_bits_max,
                                         uint32 *N_c_bits);
 
+/*********************************************************************
+    Name: liblte_phy_code_block_segmentation_packed
+
+    Description: Performs code block segmentation for turbo coded
+                 channels on packed bits.  Filler bits are set to 0.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void liblte_phy_code_block_segmentation_packed(uint8  *b_bytes,
+                                               uint32  N_b_bits,
+                                               uint32 *N_codeblocks,
+                                               uint32 *N_filler_bits,
+                                               uint8  *c_bytes,
+                                               uint32  N_c_bytes_max,
+                                               uint32 *N_c_bits);
+
 /*********************************************************************
     Name: liblte_phy_code_block_desegmentation
 
@@ -1361,4 +2066,59 @@ void liblte_phy_code_block_desegmentation(uint8  *c_bits,
                                           uint8  *b_bits,
                                           uint32  N_b_bits);
 
+/*********************************************************************
+    Name: liblte_phy_modulation_mapper_packed
+
+    Description: Maps packed binary digits, most significant bit
+                 first, to complex-valued modulation symbols.  Whole
+                 bytes are mapped to groups of symbols with a single
+                 table lookup.  A partial last symbol is padded with
+                 zeros.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void liblte_phy_modulation_mapper_packed(uint8                           *bytes,
+                                         uint32                           N_bits,
+                                         LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
+                                         float                           *d_re,
+                                         float                           *d_im,
+                                         uint32                          *M_symb);
+
+/*********************************************************************
+    Name: liblte_phy_pack_bits
+
+    Description: Packs an array of unpacked bits into bytes, most
+                 significant bit first.  Unused bits in the last byte
+                 are set to 0.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void liblte_phy_pack_bits(uint8  *bits,
+                          uint32  N_bits,
+                          uint8  *bytes);
+
+/*********************************************************************
+    Name: liblte_phy_unpack_bits
+
+    Description: Unpacks an array of bytes, most significant bit
+                 first, into one bit per byte
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void liblte_phy_unpack_bits(uint8  *bytes,
+                            uint32  N_bits,
+                            uint8  *bits);
+
 #endif /* __LIBLTE_PHY_H__ */
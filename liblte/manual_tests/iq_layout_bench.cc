@@ -0,0 +1,248 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+/*********************************************************************
+    Name: iq_layout_bench.cc
+
+    Description: times the eNB sample path of one TTI, creating the
+                 DL subframe of every antenna and resolving one UL
+                 subframe, once through split I/Q buffers that are
+                 converted to and from the interleaved radio buffers
+                 and once through the _cf functions that use the radio
+                 buffers directly.  Also checks that both give the same
+                 samples and symbols and reports the layout conversion
+                 copies saved per TTI.  Build with and without
+                 LIBLTE_PHY_INTERLEAVED_IQ to compare the subframe
+                 layouts.
+    compile:     make iq_layout_bench
+    run:         ./iq_layout_bench [fs_idx] [N_ant] [N_iter]
+                 ./iq_layout_bench_interleaved [fs_idx] [N_ant] [N_iter]
+
+*********************************************************************/
+
+#include "liblte_phy.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+static const uint32 N_rb[LIBLTE_PHY_FS_N_ITEMS] = {6, 15, 25, 50, 100};
+
+static LIBLTE_PHY_SUBFRAME_STRUCT subframe;
+static LIBLTE_PHY_SUBFRAME_STRUCT ul_subframe;
+
+static uint32 elapsed_us(struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return((end.tv_sec - start->tv_sec)*1000000 + (end.tv_nsec - start->tv_nsec)/1000);
+}
+
+int main(int argc, char *argv[])
+{
+    LIBLTE_PHY_STRUCT    *phy_struct;
+    LIBLTE_PHY_FS_ENUM    fs        = LIBLTE_PHY_FS_7_68MHZ;
+    LIBLTE_PHY_CF_STRUCT *radio_tx;
+    LIBLTE_PHY_CF_STRUCT *radio_tx_cf;
+    LIBLTE_PHY_CF_STRUCT *radio_rx;
+    LIBLTE_PHY_CF_STRUCT *ant_cf;
+    struct timespec       start;
+    float                *ant_re;
+    float                *ant_im;
+    float                *rx_re;
+    float                *rx_im;
+    float                *ul_symb;
+    float                 max_err;
+    uint32                N_sc;
+    uint32                N_samps;
+    uint32                N_iter    = 1000;
+    uint32                dl_us[2];
+    uint32                ul_us[2];
+    uint32                n;
+    uint32                p;
+    uint32                i;
+    uint32                j;
+    uint8                 N_ant     = 1;
+
+    if(argc > 1)
+    {
+        fs = (LIBLTE_PHY_FS_ENUM)(atoi(argv[1]) % LIBLTE_PHY_FS_N_ITEMS);
+    }
+    if(argc > 2)
+    {
+        N_ant = atoi(argv[2]);
+    }
+    if(argc > 3)
+    {
+        N_iter = atoi(argv[3]);
+    }
+
+    liblte_phy_init(&phy_struct, fs, 0, N_ant, N_rb[fs], LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP, 1);
+    N_sc        = N_rb[fs]*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP;
+    N_samps     = phy_struct->N_samps_per_subfr;
+    radio_tx    = (LIBLTE_PHY_CF_STRUCT *)malloc(sizeof(LIBLTE_PHY_CF_STRUCT)*N_samps);
+    radio_tx_cf = (LIBLTE_PHY_CF_STRUCT *)malloc(sizeof(LIBLTE_PHY_CF_STRUCT)*N_samps);
+    radio_rx    = (LIBLTE_PHY_CF_STRUCT *)malloc(sizeof(LIBLTE_PHY_CF_STRUCT)*N_samps);
+    ant_cf      = (LIBLTE_PHY_CF_STRUCT *)malloc(sizeof(LIBLTE_PHY_CF_STRUCT)*N_samps);
+    ant_re      = (float *)malloc(sizeof(float)*N_samps);
+    ant_im      = (float *)malloc(sizeof(float)*N_samps);
+    rx_re       = (float *)malloc(sizeof(float)*N_samps);
+    rx_im       = (float *)malloc(sizeof(float)*N_samps);
+    ul_symb     = (float *)malloc(sizeof(float)*2*N_sc*14);
+
+    // Random QPSK on every resource element
+    srand(1);
+    for(p=0; p<N_ant; p++)
+    {
+        for(i=0; i<14; i++)
+        {
+            for(j=0; j<N_sc; j++)
+            {
+                liblte_phy_set_tx_symb(&subframe,
+                                       p,
+                                       i,
+                                       j,
+                                       (rand() & 1) ? M_SQRT1_2 : -M_SQRT1_2,
+                                       (rand() & 1) ? M_SQRT1_2 : -M_SQRT1_2);
+            }
+        }
+    }
+    for(i=0; i<N_samps; i++)
+    {
+        radio_rx[i].re = (float)rand()/RAND_MAX - 0.5;
+        radio_rx[i].im = (float)rand()/RAND_MAX - 0.5;
+    }
+
+    printf("fs=%sMHz N_rb=%u N_ant=%u subframe layout %s\n",
+           liblte_phy_fs_text[fs],
+           N_rb[fs],
+           N_ant,
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+           "interleaved");
+#else
+           "split");
+#endif
+
+    // DL through split buffers, interleaved and summed by the radio
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(n=0; n<N_iter; n++)
+    {
+        memset(radio_tx, 0, sizeof(LIBLTE_PHY_CF_STRUCT)*N_samps);
+        for(p=0; p<N_ant; p++)
+        {
+            liblte_phy_create_dl_subframe(phy_struct, &subframe, p, ant_re, ant_im);
+            for(i=0; i<N_samps; i++)
+            {
+                radio_tx[i].re += ant_re[i];
+                radio_tx[i].im += ant_im[i];
+            }
+        }
+    }
+    dl_us[0] = elapsed_us(&start);
+
+    // DL straight into interleaved buffers
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(n=0; n<N_iter; n++)
+    {
+        liblte_phy_create_dl_subframe_cf(phy_struct, &subframe, 0, radio_tx_cf);
+        for(p=1; p<N_ant; p++)
+        {
+            liblte_phy_create_dl_subframe_cf(phy_struct, &subframe, p, ant_cf);
+            for(i=0; i<N_samps; i++)
+            {
+                radio_tx_cf[i].re += ant_cf[i].re;
+                radio_tx_cf[i].im += ant_cf[i].im;
+            }
+        }
+    }
+    dl_us[1] = elapsed_us(&start);
+    max_err = 0;
+    for(i=0; i<N_samps; i++)
+    {
+        max_err = fmaxf(max_err, fabsf(radio_tx[i].re - radio_tx_cf[i].re));
+        max_err = fmaxf(max_err, fabsf(radio_tx[i].im - radio_tx_cf[i].im));
+    }
+    printf("DL: split %6.1f us/TTI, interleaved %6.1f us/TTI, max diff %g\n",
+           (float)dl_us[0]/N_iter,
+           (float)dl_us[1]/N_iter,
+           max_err);
+
+    // UL through split buffers, deinterleaved from the radio
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(n=0; n<N_iter; n++)
+    {
+        for(i=0; i<N_samps; i++)
+        {
+            rx_re[i] = radio_rx[i].re;
+            rx_im[i] = radio_rx[i].im;
+        }
+        liblte_phy_get_ul_subframe(phy_struct, rx_re, rx_im, &ul_subframe);
+    }
+    ul_us[0] = elapsed_us(&start);
+    for(i=0; i<14; i++)
+    {
+        for(j=0; j<N_sc; j++)
+        {
+            ul_symb[(i*N_sc+j)*2+0] = liblte_phy_rx_symb_re(&ul_subframe, i, j);
+            ul_symb[(i*N_sc+j)*2+1] = liblte_phy_rx_symb_im(&ul_subframe, i, j);
+        }
+    }
+
+    // UL straight from the interleaved radio buffer
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(n=0; n<N_iter; n++)
+    {
+        liblte_phy_get_ul_subframe_cf(phy_struct, radio_rx, &ul_subframe);
+    }
+    ul_us[1] = elapsed_us(&start);
+    max_err = 0;
+    for(i=0; i<14; i++)
+    {
+        for(j=0; j<N_sc; j++)
+        {
+            max_err = fmaxf(max_err, fabsf(ul_symb[(i*N_sc+j)*2+0] - liblte_phy_rx_symb_re(&ul_subframe, i, j)));
+            max_err = fmaxf(max_err, fabsf(ul_symb[(i*N_sc+j)*2+1] - liblte_phy_rx_symb_im(&ul_subframe, i, j)));
+        }
+    }
+    printf("UL: split %6.1f us/TTI, interleaved %6.1f us/TTI, max diff %g\n",
+           (float)ul_us[0]/N_iter,
+           (float)ul_us[1]/N_iter,
+           max_err);
+
+    // Every conversion pass reads and writes each sample once
+    printf("Layout conversion saved per TTI: %u passes, %u samples, %u bytes\n",
+           N_ant + 1,
+           (N_ant + 1)*N_samps,
+           (N_ant + 1)*N_samps*2*(uint32)sizeof(LIBLTE_PHY_CF_STRUCT));
+
+    liblte_phy_cleanup(phy_struct);
+    free(radio_tx);
+    free(radio_tx_cf);
+    free(radio_rx);
+    free(ant_cf);
+    free(ant_re);
+    free(ant_im);
+    free(rx_re);
+    free(rx_im);
+    free(ul_symb);
+
+    return(0);
+}
@@ -0,0 +1,171 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+/*********************************************************************
+    Name: modmap_bench.cc
+
+    Description: checks liblte_phy_modulation_mapper_packed against a
+                 bit by bit implementation of 3GPP TS 36.211 v10.1.0
+                 section 7.1 and reports the time per symbol for each
+                 modulation order
+    compile:     make modmap_bench
+    run:         ./modmap_bench
+
+*********************************************************************/
+
+#include "liblte_phy.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define N_BITS  43200
+#define N_ITERS 2000
+
+static void ref_mapper(uint8                           *bits,
+                       uint32                           N_bits,
+                       LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
+                       float                           *d_re,
+                       float                           *d_im,
+                       uint32                          *M_symb)
+{
+    uint32 i;
+    uint8  b[6];
+    uint32 Q_m = 1;
+
+    if(LIBLTE_PHY_MODULATION_TYPE_QPSK == type)
+    {
+        Q_m = 2;
+    }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == type){
+        Q_m = 4;
+    }else if(LIBLTE_PHY_MODULATION_TYPE_64QAM == type){
+        Q_m = 6;
+    }
+    *M_symb = (N_bits + Q_m - 1)/Q_m;
+    for(i=0; i<*M_symb; i++)
+    {
+        for(uint32 j=0; j<Q_m; j++)
+        {
+            b[j] = (i*Q_m + j < N_bits) ? bits[i*Q_m + j] : 0;
+        }
+        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == type)
+        {
+            d_re[i] = (1 - 2*b[0])/sqrt(2);
+            d_im[i] = (1 - 2*b[0])/sqrt(2);
+        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == type){
+            d_re[i] = (1 - 2*b[0])/sqrt(2);
+            d_im[i] = (1 - 2*b[1])/sqrt(2);
+        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == type){
+            d_re[i] = (1 - 2*b[0])*(1 + 2*b[2])/sqrt(10);
+            d_im[i] = (1 - 2*b[1])*(1 + 2*b[3])/sqrt(10);
+        }else{
+            d_re[i] = (1 - 2*b[0])*(4 - (1 - 2*b[2])*(1 + 2*b[4]))/sqrt(42);
+            d_im[i] = (1 - 2*b[1])*(4 - (1 - 2*b[3])*(1 + 2*b[5]))/sqrt(42);
+        }
+    }
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return(ts.tv_sec*1e9 + ts.tv_nsec);
+}
+
+int main(void)
+{
+    static uint8  bits[N_BITS];
+    static uint8  bytes[N_BITS/8 + 1];
+    static float  ref_re[N_BITS];
+    static float  ref_im[N_BITS];
+    static float  d_re[N_BITS];
+    static float  d_im[N_BITS];
+    const char   *names[4] = {"BPSK", "QPSK", "16QAM", "64QAM"};
+    uint32        ref_M_symb;
+    uint32        M_symb;
+    uint32        N_bits;
+    uint32        i;
+    uint32        t;
+    uint32        k;
+    uint32        errors = 0;
+    double        start;
+    double        ref_ns;
+    double        packed_ns;
+
+    srand(1);
+    for(t=0; t<=LIBLTE_PHY_MODULATION_TYPE_64QAM; t++)
+    {
+        LIBLTE_PHY_MODULATION_TYPE_ENUM type = (LIBLTE_PHY_MODULATION_TYPE_ENUM)t;
+
+        // Odd lengths exercise the partial byte and partial symbol paths
+        for(k=0; k<100; k++)
+        {
+            N_bits = 1 + rand()%N_BITS;
+            for(i=0; i<N_bits; i++)
+            {
+                bits[i] = rand() & 1;
+            }
+            liblte_phy_pack_bits(bits, N_bits, bytes);
+            ref_mapper(bits, N_bits, type, ref_re, ref_im, &ref_M_symb);
+            liblte_phy_modulation_mapper_packed(bytes, N_bits, type, d_re, d_im, &M_symb);
+            if(M_symb != ref_M_symb)
+            {
+                errors++;
+                continue;
+            }
+            for(i=0; i<M_symb; i++)
+            {
+                if(fabs(d_re[i] - ref_re[i]) > 1e-6 ||
+                   fabs(d_im[i] - ref_im[i]) > 1e-6)
+                {
+                    errors++;
+                    break;
+                }
+            }
+        }
+
+        // Timing over a full 20MHz worth of PDSCH bits
+        for(i=0; i<N_BITS; i++)
+        {
+            bits[i] = rand() & 1;
+        }
+        liblte_phy_pack_bits(bits, N_BITS, bytes);
+        start = now_ns();
+        for(k=0; k<N_ITERS; k++)
+        {
+            ref_mapper(bits, N_BITS, type, ref_re, ref_im, &ref_M_symb);
+        }
+        ref_ns = (now_ns() - start)/N_ITERS/ref_M_symb;
+        start = now_ns();
+        for(k=0; k<N_ITERS; k++)
+        {
+            liblte_phy_modulation_mapper_packed(bytes, N_BITS, type, d_re, d_im, &M_symb);
+        }
+        packed_ns = (now_ns() - start)/N_ITERS/M_symb;
+        printf("%-6s reference %6.2f ns/symbol, packed %6.2f ns/symbol\n",
+               names[t],
+               ref_ns,
+               packed_ns);
+    }
+    printf("%s (%u errors)\n", (0 == errors) ? "PASS" : "FAIL", errors);
+
+    return((0 == errors) ? 0 : 1);
+}
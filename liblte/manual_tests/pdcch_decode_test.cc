@@ -0,0 +1,248 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+/*********************************************************************
+    Name: pdcch_decode_test.cc
+
+    Description: encodes a frame of PDCCHs carrying an SI-RNTI and a
+                 C-RNTI DCI 1A, sends it through AWGN and blind decodes
+                 every subframe with liblte_phy_pdcch_channel_decode,
+                 reporting the allocations found, the search statistics
+                 and the decode time per subframe with and without the
+                 C-RNTIs being tracked
+    compile:     make pdcch_decode_test
+    run:         ./pdcch_decode_test [fs_idx] [N_ant] [snr_db]
+
+*********************************************************************/
+
+#include "liblte_phy.h"
+#include "liblte_mac.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define N_UE_RNTIS 16
+#define C_RNTI_0   0x46
+
+static const uint32 N_rb[LIBLTE_PHY_FS_N_ITEMS] = {6, 15, 25, 50, 100};
+
+static LIBLTE_PHY_SUBFRAME_STRUCT subframe;
+static LIBLTE_PHY_PCFICH_STRUCT   pcfich;
+static LIBLTE_PHY_PHICH_STRUCT    phich;
+static LIBLTE_PHY_PDCCH_STRUCT    pdcch;
+
+static float gauss(void)
+{
+    float u1 = (rand() + 1.0)/(RAND_MAX + 2.0);
+    float u2 = (rand() + 1.0)/(RAND_MAX + 2.0);
+
+    return(sqrt(-2*log(u1))*cos(2*M_PI*u2));
+}
+
+int main(int argc, char *argv[])
+{
+    LIBLTE_PHY_STRUCT            *phy_struct;
+    LIBLTE_PHY_ALLOCATION_STRUCT *alloc;
+    LIBLTE_PHY_FS_ENUM            fs        = LIBLTE_PHY_FS_7_68MHZ;
+    float                        *samps_re;
+    float                        *samps_im;
+    float                        *ant_re;
+    float                        *ant_im;
+    float                         snr_db    = 10;
+    float                         noise_std;
+    double                        sig_pow;
+    uint32                        N_id_cell = 17;
+    uint32                        N_samps;
+    uint32                        N_found;
+    uint32                        N_errors;
+    uint32                        time_us;
+    uint32                        s;
+    uint32                        i;
+    uint32                        j;
+    uint32                        k;
+    uint32                        t;
+    uint16                        ue_rntis[N_UE_RNTIS];
+    uint8                         N_ant     = 1;
+
+    if(argc > 1)
+    {
+        fs = (LIBLTE_PHY_FS_ENUM)(atoi(argv[1]) % LIBLTE_PHY_FS_N_ITEMS);
+    }
+    if(argc > 2)
+    {
+        N_ant = atoi(argv[2]);
+    }
+    if(argc > 3)
+    {
+        snr_db = atof(argv[3]);
+    }
+
+    liblte_phy_init(&phy_struct, fs, N_id_cell, N_ant, N_rb[fs], LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP, 1);
+    N_samps  = phy_struct->N_samps_per_subfr;
+    samps_re = (float *)calloc(N_samps*11, sizeof(float));
+    samps_im = (float *)calloc(N_samps*11, sizeof(float));
+    ant_re   = (float *)malloc(sizeof(float)*N_samps);
+    ant_im   = (float *)malloc(sizeof(float)*N_samps);
+    memset(&phich, 0, sizeof(phich));
+
+    // Encode a frame, plus the first subframe of the next for the
+    // channel estimate of the last subframe
+    for(s=0; s<11; s++)
+    {
+        for(i=0; i<N_ant; i++)
+        {
+            for(j=0; j<14; j++)
+            {
+                liblte_phy_clear_tx_symb(&subframe, i, j, LIBLTE_PHY_N_RB_DL_MAX*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
+            }
+        }
+        subframe.num = s % 10;
+        liblte_phy_map_crs(phy_struct, &subframe, N_id_cell, N_ant);
+
+        memset(&pdcch, 0, sizeof(pdcch));
+        pcfich.cfi     = 2;
+        pdcch.N_symbs  = 2;
+        pdcch.N_alloc  = 2;
+        alloc          = &pdcch.alloc[0];
+        alloc->rnti    = LIBLTE_MAC_SI_RNTI;
+        alloc->N_prb   = 3;
+        alloc->mcs     = 5;
+        alloc->rv_idx  = s % 4;
+        alloc          = &pdcch.alloc[1];
+        alloc->rnti    = C_RNTI_0 + subframe.num;
+        alloc->N_prb   = N_rb[fs]/2 + 2;
+        alloc->mcs     = 12;
+        alloc->ndi     = true;
+        alloc->tpc     = 1;
+        for(i=0; i<2; i++)
+        {
+            pdcch.alloc[i].chan_type = LIBLTE_PHY_CHAN_TYPE_DLSCH;
+            pdcch.alloc[i].prb[0][0] = 0;
+        }
+        liblte_phy_pdcch_channel_encode(phy_struct,
+                                        &pcfich,
+                                        &phich,
+                                        &pdcch,
+                                        N_id_cell,
+                                        N_ant,
+                                        1,
+                                        LIBLTE_RRC_PHICH_DURATION_NORMAL,
+                                        &subframe);
+        for(i=0; i<N_ant; i++)
+        {
+            liblte_phy_create_dl_subframe(phy_struct, &subframe, i, ant_re, ant_im);
+            for(j=0; j<N_samps; j++)
+            {
+                samps_re[s*N_samps+j] += ant_re[j];
+                samps_im[s*N_samps+j] += ant_im[j];
+            }
+        }
+    }
+
+    // AWGN at snr_db
+    sig_pow = 0;
+    for(i=0; i<N_samps*10; i++)
+    {
+        sig_pow += samps_re[i]*samps_re[i] + samps_im[i]*samps_im[i];
+    }
+    noise_std = sqrt(sig_pow/(N_samps*10)/pow(10, snr_db/10)/2);
+    srand(1);
+    for(i=0; i<N_samps*11; i++)
+    {
+        samps_re[i] += noise_std*gauss();
+        samps_im[i] += noise_std*gauss();
+    }
+
+    printf("fs=%sMHz N_rb=%u N_ant=%u SNR=%.1fdB\n",
+           liblte_phy_fs_text[fs],
+           N_rb[fs],
+           N_ant,
+           snr_db);
+
+    for(i=0; i<N_UE_RNTIS; i++)
+    {
+        ue_rntis[i] = C_RNTI_0 + i;
+    }
+    for(t=0; t<2; t++)
+    {
+        // First pass only searches the common search space RNTIs
+        liblte_phy_set_pdcch_ue_rntis(phy_struct, ue_rntis, t*N_UE_RNTIS);
+        N_found  = 0;
+        N_errors = 0;
+        time_us  = 0;
+        for(s=0; s<10; s++)
+        {
+            liblte_phy_get_dl_subframe_and_ce(phy_struct, samps_re, samps_im, 0, s, N_id_cell, N_ant, &subframe);
+            if(LIBLTE_SUCCESS != liblte_phy_pdcch_channel_decode(phy_struct,
+                                                                 &subframe,
+                                                                 N_id_cell,
+                                                                 N_ant,
+                                                                 1,
+                                                                 LIBLTE_RRC_PHICH_DURATION_NORMAL,
+                                                                 &pcfich,
+                                                                 &phich,
+                                                                 &pdcch))
+            {
+                pdcch.N_alloc = 0;
+            }
+            time_us += phy_struct->pdcch_stats.decode_time_us;
+            printf("  subframe %u: CCEs %2u active %2u, candidates tried %3u decoded %3u, found",
+                   s,
+                   phy_struct->pdcch_stats.N_cce,
+                   phy_struct->pdcch_stats.N_cce_active,
+                   phy_struct->pdcch_stats.N_cand_tried,
+                   phy_struct->pdcch_stats.N_cand_decoded);
+            for(i=0; i<pdcch.N_alloc; i++)
+            {
+                if(LIBLTE_MAC_SI_RNTI == pdcch.alloc[i].rnti)
+                {
+                    k = 3;
+                }else if((C_RNTI_0 + s) == pdcch.alloc[i].rnti){
+                    k = N_rb[fs]/2 + 2;
+                }else{
+                    k = 0;
+                }
+                if(pdcch.alloc[i].N_prb    == k &&
+                   pdcch.alloc[i].prb[0][0] == 0)
+                {
+                    N_found++;
+                }else{
+                    N_errors++;
+                }
+                printf(" 0x%04X", pdcch.alloc[i].rnti);
+            }
+            printf("\n");
+        }
+        printf("%s: found %u/%u DCIs, %u false or wrong, %u us/subframe\n",
+               (0 == t) ? "Common RNTIs" : "Tracking C-RNTIs",
+               N_found,
+               (0 == t) ? 10 : 20,
+               N_errors,
+               time_us/10);
+    }
+
+    liblte_phy_cleanup(phy_struct);
+    free(samps_re);
+    free(samps_im);
+    free(ant_re);
+    free(ant_im);
+
+    return(0);
+}
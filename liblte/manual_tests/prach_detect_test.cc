@@ -0,0 +1,228 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+/*********************************************************************
+    Name: prach_detect_test.cc
+
+    Description: sends several PRACH preambles with random delays and
+                 phases through AWGN into liblte_phy_detect_prach and
+                 reports the detection rate, the false alarm rate and
+                 the detection time per occasion for a range of SNRs
+    compile:     make prach_detect_test
+    run:         ./prach_detect_test [fs_idx] [N_trials]
+
+*********************************************************************/
+
+#include "liblte_phy.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define N_PRE_MAX 8
+
+static const uint32 N_rb[LIBLTE_PHY_FS_N_ITEMS] = {6, 15, 25, 50, 100};
+
+static float gauss(void)
+{
+    float u1 = (rand() + 1.0)/(RAND_MAX + 2.0);
+    float u2 = (rand() + 1.0)/(RAND_MAX + 2.0);
+
+    return(sqrt(-2*log(u1))*cos(2*M_PI*u2));
+}
+
+int main(int argc, char *argv[])
+{
+    LIBLTE_PHY_STRUCT  *phy_struct;
+    LIBLTE_PHY_FS_ENUM  fs          = LIBLTE_PHY_FS_1_92MHZ;
+    float              *pre_re;
+    float              *pre_im;
+    float              *samps_re;
+    float              *samps_im;
+    float               snr_db[]    = {-24, -21, -18, -15, -12, 0};
+    float               amp;
+    float               phase;
+    float               rot_re;
+    float               rot_im;
+    float               noise_std;
+    uint32              N_snr       = sizeof(snr_db)/sizeof(snr_db[0]);
+    uint32              N_trials    = 100;
+    uint32              freq_offset = 2;
+    uint32              N_det_pre;
+    uint32              det_pre[64];
+    uint32              det_ta[64];
+    uint32              tx_pre[N_PRE_MAX];
+    uint32              tx_delay[N_PRE_MAX];
+    uint32              N_tx;
+    uint32              N_samps;
+    uint32              max_delay;
+    uint32              N_sent;
+    uint32              N_found;
+    uint32              N_false;
+    uint32              N_ta_err;
+    uint32              N_fa_occasions;
+    uint32              time_us;
+    uint32              s;
+    uint32              t;
+    uint32              i;
+    uint32              j;
+    uint32              k;
+    bool                found;
+    bool                dup;
+
+    if(argc > 1)
+    {
+        fs = (LIBLTE_PHY_FS_ENUM)(atoi(argv[1]) % LIBLTE_PHY_FS_N_ITEMS);
+    }
+    if(argc > 2)
+    {
+        N_trials = atoi(argv[2]);
+    }
+
+    liblte_phy_init(&phy_struct, fs, 0, 1, N_rb[fs], LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP, 1);
+    liblte_phy_ul_init(phy_struct, 0, 22, 0, 1, false, 0, false, false, 0, 0, 0, 1);
+    N_samps   = phy_struct->N_samps_per_subfr;
+    max_delay = (phy_struct->prach_N_cs - 1)*phy_struct->prach_T_fft/phy_struct->prach_N_zc;
+    pre_re    = (float *)malloc(sizeof(float)*N_samps*2);
+    pre_im    = (float *)malloc(sizeof(float)*N_samps*2);
+    samps_re  = (float *)malloc(sizeof(float)*N_samps*2);
+    samps_im  = (float *)malloc(sizeof(float)*N_samps*2);
+
+    printf("fs=%sMHz N_zc=%u N_cs=%u T_fft=%u decimated FFT=%u taps=%u threshold=%.1f\n",
+           liblte_phy_fs_text[fs],
+           phy_struct->prach_N_zc,
+           phy_struct->prach_N_cs,
+           phy_struct->prach_T_fft,
+           phy_struct->prach_dec_N_fft,
+           phy_struct->prach_dec_N_taps,
+           phy_struct->prach_threshold);
+
+    srand(1);
+    for(s=0; s<=N_snr; s++)
+    {
+        N_sent         = 0;
+        N_found        = 0;
+        N_false        = 0;
+        N_ta_err       = 0;
+        N_fa_occasions = 0;
+        time_us        = 0;
+        for(t=0; t<N_trials; t++)
+        {
+            // The last pass is noise only, to measure the false alarm rate
+            N_tx = (s < N_snr) ? (1 + rand()%N_PRE_MAX) : 0;
+            for(i=0; i<N_tx; i++)
+            {
+                do{
+                    tx_pre[i] = rand()%64;
+                    dup       = false;
+                    for(j=0; j<i; j++)
+                    {
+                        dup |= (tx_pre[j] == tx_pre[i]);
+                    }
+                }while(dup);
+                tx_delay[i] = rand()%(max_delay + 1);
+            }
+
+            // Unit power noise, each preamble at snr_db
+            for(i=0; i<N_samps*2; i++)
+            {
+                samps_re[i] = gauss()/sqrt(2);
+                samps_im[i] = gauss()/sqrt(2);
+            }
+            for(i=0; i<N_tx; i++)
+            {
+                memset(pre_re, 0, sizeof(float)*N_samps*2);
+                memset(pre_im, 0, sizeof(float)*N_samps*2);
+                liblte_phy_generate_prach(phy_struct, tx_pre[i], freq_offset, pre_re, pre_im);
+                amp = 0;
+                for(j=0; j<phy_struct->prach_T_fft; j++)
+                {
+                    amp += pre_re[phy_struct->prach_T_cp+j]*pre_re[phy_struct->prach_T_cp+j] + pre_im[phy_struct->prach_T_cp+j]*pre_im[phy_struct->prach_T_cp+j];
+                }
+                amp    = pow(10, snr_db[s]/20)/sqrt(amp/phy_struct->prach_T_fft);
+                phase  = 2*M_PI*rand()/RAND_MAX;
+                rot_re = amp*cos(phase);
+                rot_im = amp*sin(phase);
+                for(j=0; j<N_samps; j++)
+                {
+                    samps_re[j+tx_delay[i]] += pre_re[j]*rot_re - pre_im[j]*rot_im;
+                    samps_im[j+tx_delay[i]] += pre_re[j]*rot_im + pre_im[j]*rot_re;
+                }
+            }
+
+            liblte_phy_detect_prach(phy_struct, samps_re, samps_im, freq_offset, &N_det_pre, det_pre, det_ta);
+            time_us += phy_struct->prach_stats.detect_time_us;
+
+            // Score the detections
+            N_sent += N_tx;
+            for(i=0; i<N_det_pre; i++)
+            {
+                found = false;
+                for(j=0; j<N_tx; j++)
+                {
+                    if(det_pre[i] == tx_pre[j])
+                    {
+                        found = true;
+                        k     = tx_delay[j]*(30720000/phy_struct->fs)/16;
+                        if(det_ta[i] > k+2 || det_ta[i]+2 < k)
+                        {
+                            N_ta_err++;
+                        }
+                    }
+                }
+                if(found)
+                {
+                    N_found++;
+                }else{
+                    N_false++;
+                }
+            }
+            if(0 == N_tx && 0 != N_det_pre)
+            {
+                N_fa_occasions++;
+            }
+        }
+        if(s < N_snr)
+        {
+            printf("SNR %6.1fdB: detected %5u/%5u (%6.2f%%), false %4u, TA errors %4u, %6u us/occasion\n",
+                   snr_db[s],
+                   N_found,
+                   N_sent,
+                   100.0*N_found/N_sent,
+                   N_false,
+                   N_ta_err,
+                   time_us/N_trials);
+        }else{
+            printf("Noise only:  false alarm occasions %u/%u, false preambles %u, %6u us/occasion\n",
+                   N_fa_occasions,
+                   N_trials,
+                   N_false,
+                   time_us/N_trials);
+        }
+    }
+
+    liblte_phy_ul_cleanup(phy_struct);
+    liblte_phy_cleanup(phy_struct);
+    free(pre_re);
+    free(pre_im);
+    free(samps_re);
+    free(samps_im);
+
+    return(0);
+}
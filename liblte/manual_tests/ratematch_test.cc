@@ -35,6 +35,9 @@ using namespace itpp;
 using std::cout;
 using std::endl;
 
+static float rx_e_bits[LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
+static float rx_d_bits[LIBLTE_PHY_BASE_CODING_RATE*LIBLTE_PHY_MAX_CODE_BLOCK_SIZE];
+
 uint32 TURBO_K_TABLE[188] = {  40,  48,  56,  64,  72,  80,  88,  96, 104, 112,
                               120, 128, 136, 144, 152, 160, 168, 176, 184, 192,
                               200, 208, 216, 224, 232, 240, 248, 256, 264, 272,
@@ -175,9 +178,9 @@ int main(void)
             // number of e bits (E) and e bits are obtained after code_block_deconcatenation
             for (i=0; i<phy_struct_tx->dlsch_N_e_bits[cb]; i++){
                 if(phy_struct_tx->dlsch_tx_e_bits[cb][i] == 0){
-                    phy_struct_rx->dlsch_rx_e_bits[cb][i] = 1.0;
+                    rx_e_bits[i] = 1.0;
                 }else{
-                    phy_struct_rx->dlsch_rx_e_bits[cb][i] = -1.0;
+                    rx_e_bits[i] = -1.0;
                 }
             }
             phy_struct_rx->dlsch_N_e_bits[cb] = phy_struct_tx->dlsch_N_e_bits[cb];
@@ -198,7 +201,7 @@ int main(void)
                 phy_struct_rx->dlsch_tx_d_bits[i] = 0;
             }
             liblte_phy_rate_unmatch_turbo(phy_struct_rx,
-                                          phy_struct_rx->dlsch_rx_e_bits[cb], // input
+                                          rx_e_bits, // input
                                           phy_struct_rx->dlsch_N_e_bits[cb], // E, input
                                           phy_struct_rx->dlsch_tx_d_bits, //all 0 bits input
                                           N_rx_d_bits/3, // = D, input
@@ -208,14 +211,14 @@ int main(void)
                                           M_dl_harq, // input
                                           LIBLTE_PHY_CHAN_TYPE_DLSCH, // input
                                           rv_idx,// input
-                                          phy_struct_rx->dlsch_rx_d_bits, // output
+                                          rx_d_bits, // output
                                           &N_rx_d_bits); //=3*D
             // =========================================================================================
 
             // compares tx-rx d bits
             bvec dlsch_rx_d_bits_itpp_tmp(N_rx_d_bits);  // output d_bits from rate_unmatch_turbo
             for (i=0; i<N_rx_d_bits; i++){
-                if(phy_struct_rx->dlsch_rx_d_bits[i] > 0.0){
+                if(rx_d_bits[i] > 0.0){
                     dlsch_rx_d_bits_itpp_tmp(i) = bin(0);
                 }else{
                     dlsch_rx_d_bits_itpp_tmp(i) = bin(1);
@@ -240,6 +243,7 @@ int main(void)
 
     } // k loop
 
+    cout << "rate match tables: " << phy_struct_rx->rm_N_table_hits << " hits, " << phy_struct_rx->rm_N_table_misses << " misses" << endl;
     if(count == 0){
         cout << "all tests pass !! " << endl;
     }else{
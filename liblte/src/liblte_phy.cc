@@ -141,6 +141,18 @@
 #include "liblte_phy.h"
 #include "liblte_mac.h"
 #include <math.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 /*******************************************************************************
                               DEFINES
@@ -148,15 +160,62 @@
 
 #define N_SYMB_DL_NORMAL_CP 7
 
+// CRC polynomials from 3GPP TS 36.212 v10.1.0 section 5.1.1
+#define CRC24A      0x01864CFB
+#define CRC24B      0x01800063
+#define CRC16       0x00011021
+#define CRC8        0x0000019B
+#define CRC_N_POLYS 4
+
+// Soft bits are max-log LLRs quantized to 1/LLR_INT8_SCALE.  The default
+// noise variance, used when there is no estimate, maps noiseless QPSK to
+// full scale.
+#define LLR_INT8_SCALE        8
+#define LLR_MIN_NOISE_VAR     0.0001
+#define LLR_DEFAULT_NOISE_VAR 0.125
+
 /*******************************************************************************
                               TYPEDEFS
 *******************************************************************************/
 
+typedef struct{
+    uint32 table[CRC_N_POLYS][8][256];
+}CRC_TABLES_STRUCT;
+
+typedef struct{
+    uint32 (*table)[256];
+    uint32   poly;
+    uint32   N_p_bits;
+    uint32   rem;
+}CRC_STATE_STRUCT;
+
+typedef struct{
+    float symb_re[LIBLTE_PHY_MODULATION_TYPE_64QAM+1][64];
+    float symb_im[LIBLTE_PHY_MODULATION_TYPE_64QAM+1][64];
+    float qpsk_re[256][4];
+    float qpsk_im[256][4];
+    float qam16_re[256][2];
+    float qam16_im[256][2];
+}MOD_TABLES_STRUCT;
+
+typedef struct{
+    uint32 x2_jump[31];
+    uint8  bit_reverse[256];
+}PRS_C_TABLES_STRUCT;
+
+typedef void (*TURBO_TRELLIS_STEP_FUNC)(int16 *in, int32 L_sys, int32 L_par, bool tail, int16 *out);
+typedef int16 (*TURBO_TRELLIS_EXTRINSIC_FUNC)(int16 *alpha, int16 *beta, int32 L_par);
+typedef void (*TURBO_TRELLIS_DUAL_STEP_FUNC)(int16 *alpha, int32 L_sys_f, int32 L_par_f, int16 *alpha_next,
+                                             int16 *beta, int32 L_sys_b, int32 L_par_b, int16 *beta_prev);
+typedef uint64 (*VITERBI_K7_ACS_FUNC)(int16 *metric, int16 *d, int16 (*sign)[3][LIBLTE_PHY_VITERBI_K7_N_STATES], int16 *metric_next);
 
 /*******************************************************************************
                               GLOBAL VARIABLES
 *******************************************************************************/
 
+// Bits per symbol for each modulation type from 3GPP TS 36.211 v10.1.0 section 7.1
+uint32 MOD_Q_M[LIBLTE_PHY_MODULATION_TYPE_64QAM+1] = {1, 2, 4, 6};
+
 // Orthogonal sequences for PUCCH from 3GPP TS 36.211 v10.1.0 table 5.4.1-2
 int32 W_5_4_1_2[3][4] = {{ 1,  1,  1,  1},
                          { 1, -1,  1, -1},
@@ -749,6 +808,48 @@ uint32 TBS_71721[27][110] = {{   16,   32,   56,   88,  120,  152,  176,  208,
 uint32 TBS_71723[32] = {  40,  56,  72, 120, 136, 144, 176, 208, 224, 256, 280, 296, 328, 336, 392, 488,
                          552, 600, 632, 696, 776, 840, 904,1000,1064,1128,1224,1288,1384,1480,1608,1736};
 
+// Turbo constituent encoder trellis from 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
+// State bit 0 is the most recent register value and the branch index is the
+// value shifted into the register (a = c ^ fb), which is forced to 0 during
+// trellis termination
+uint8 TURBO_TRELLIS_NEXT_STATE[LIBLTE_PHY_TURBO_N_STATES][2] = {{0,1},{2,3},{4,5},{6,7},
+                                                                {0,1},{2,3},{4,5},{6,7}};
+uint8 TURBO_TRELLIS_SYS_BIT[LIBLTE_PHY_TURBO_N_STATES][2]    = {{0,1},{0,1},{1,0},{1,0},
+                                                                {1,0},{1,0},{0,1},{0,1}};
+uint8 TURBO_TRELLIS_PAR_BIT[LIBLTE_PHY_TURBO_N_STATES][2]    = {{0,1},{1,0},{0,1},{1,0},
+                                                                {1,0},{0,1},{1,0},{0,1}};
+
+// Vector forms of the turbo trellis.  The forward tables are indexed by the
+// two predecessors (n>>1 and (n>>1)|4) of each state n, the backward tables
+// by the input bit.  Signs are +1 for a coded 0 and -1 for a coded 1.
+int8  TURBO_SIMD_FWD_SHUFFLE[2][16] = {{ 0, 1, 0, 1, 2, 3, 2, 3, 4, 5, 4, 5, 6, 7, 6, 7},
+                                       { 8, 9, 8, 9,10,11,10,11,12,13,12,13,14,15,14,15}};
+int16 TURBO_SIMD_FWD_SYS_SIGN[2][8] = {{ 1,-1, 1,-1,-1, 1,-1, 1},
+                                       {-1, 1,-1, 1, 1,-1, 1,-1}};
+int16 TURBO_SIMD_FWD_PAR_SIGN[2][8] = {{ 1,-1,-1, 1, 1,-1,-1, 1},
+                                       {-1, 1, 1,-1,-1, 1, 1,-1}};
+int8  TURBO_SIMD_BWD_SHUFFLE[2][16] = {{ 0, 1, 4, 5, 8, 9,12,13, 0, 1, 4, 5, 8, 9,12,13},
+                                       { 2, 3, 6, 7,10,11,14,15, 2, 3, 6, 7,10,11,14,15}};
+int16 TURBO_SIMD_BWD_SYS_SIGN[2][8] = {{ 1, 1,-1,-1,-1,-1, 1, 1},
+                                       {-1,-1, 1, 1, 1, 1,-1,-1}};
+int16 TURBO_SIMD_BWD_PAR_SIGN[2][8] = {{ 1,-1, 1,-1,-1, 1,-1, 1},
+                                       {-1, 1,-1, 1, 1,-1, 1,-1}};
+// Combined forward (low half) and backward (high half) tables, indexed by
+// the branch
+int8  TURBO_SIMD_DUAL_SHUFFLE[2][32] = {{ 0, 1, 0, 1, 2, 3, 2, 3, 4, 5, 4, 5, 6, 7, 6, 7,
+                                          0, 1, 4, 5, 8, 9,12,13, 0, 1, 4, 5, 8, 9,12,13},
+                                        { 8, 9, 8, 9,10,11,10,11,12,13,12,13,14,15,14,15,
+                                          2, 3, 6, 7,10,11,14,15, 2, 3, 6, 7,10,11,14,15}};
+int16 TURBO_SIMD_DUAL_SYS_SIGN[2][16] = {{ 1,-1, 1,-1,-1, 1,-1, 1, 1, 1,-1,-1,-1,-1, 1, 1},
+                                         {-1, 1,-1, 1, 1,-1, 1,-1,-1,-1, 1, 1, 1, 1,-1,-1}};
+int16 TURBO_SIMD_DUAL_PAR_SIGN[2][16] = {{ 1,-1,-1, 1, 1,-1,-1, 1, 1,-1, 1,-1,-1, 1,-1, 1},
+                                         {-1, 1, 1,-1,-1, 1, 1,-1,-1, 1,-1, 1, 1,-1, 1,-1}};
+
+// Splits 8 K=7 Viterbi path metrics into the even states (low half) and the
+// odd states (high half), the two predecessors of each butterfly
+int8  VITERBI_SIMD_DEINTERLEAVE[32] = { 0, 1, 4, 5, 8, 9,12,13, 2, 3, 6, 7,10,11,14,15,
+                                        0, 1, 4, 5, 8, 9,12,13, 2, 3, 6, 7,10,11,14,15};
+
 /*******************************************************************************
                               LOCAL FUNCTION PROTOTYPES
 *******************************************************************************/
@@ -985,6 +1086,42 @@ void prach_preamble_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
                             uint32             zczc,
                             bool               hs_flag);
 
+/*********************************************************************
+    Name: prach_dec_filter_gen
+
+    Description: Generates the PRACH decimation filter and the per
+                 subcarrier compensation of its passband droop
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void prach_dec_filter_gen(LIBLTE_PHY_STRUCT *phy_struct);
+
+/*********************************************************************
+    Name: detect_prach
+
+    Description: Detects PRACHs from baseband I/Q, reading every
+                 stride'th float so that both split and interleaved
+                 sample buffers can be used
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
+                  float             *samps_re,
+                  float             *samps_im,
+                  uint32             stride,
+                  uint32             freq_offset,
+                  uint32            *N_det_pre,
+                  uint32            *det_pre,
+                  uint32            *det_ta);
+
 /*********************************************************************
     Name: layer_mapper_dl
 
@@ -1123,7 +1260,8 @@ void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
 /*********************************************************************
     Name: pdcch_permute_pre_calc
 
-    Description: Pre calculates the PDCCH REG permutation.
+    Description: Pre calculates the PDCCH REG permutation for N_symbs
+                 PDCCH symbols and N_reg_pdcch REGs.
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 6.8.5
 *********************************************************************/
@@ -1132,8 +1270,34 @@ void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
 // Structs
 // Functions
 void pdcch_permute_pre_calc(LIBLTE_PHY_STRUCT *phy_struct,
-                            uint32             N_ant,
-                            float              phich_res);
+                            uint32             N_symbs,
+                            uint32             N_reg_pdcch);
+
+/*********************************************************************
+    Name: pdcch_candidate_decode
+
+    Description: Decodes one PDCCH candidate of L CCEs starting at
+                 cce_idx from the cached CCE soft bits.  Candidates
+                 using an empty CCE or a CCE of an already decoded
+                 PDCCH are rejected without decoding.  A ue_rnti of 0
+                 searches for the common search space RNTIs.  Returns
+                 true if an allocation was added.
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 9.1.1
+*********************************************************************/
+// Defines
+#define PDCCH_CCE_MIN_ENERGY 0.25 // -6dB relative to a CCE carrying a PDCCH
+// Enums
+// Structs
+// Functions
+bool pdcch_candidate_decode(LIBLTE_PHY_STRUCT       *phy_struct,
+                            uint32                   cce_idx,
+                            uint32                   L,
+                            uint16                   ue_rnti,
+                            uint8                    N_ant,
+                            uint32                   dci_1a_size,
+                            uint32                   dci_1c_size,
+                            LIBLTE_PHY_PDCCH_STRUCT *pdcch);
 
 /*********************************************************************
     Name: phich_channel_map
@@ -1193,6 +1357,129 @@ void generate_crs(uint32  N_s,
                   float  *crs_re,
                   float  *crs_im);
 
+/*********************************************************************
+    Name: crs_cache_get
+
+    Description: Returns the cell specific reference signals for a
+                 slot and symbol, generating and caching all symbols
+                 of the slot on first use for N_id_cell
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.10.1.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void crs_cache_get(LIBLTE_PHY_STRUCT  *phy_struct,
+                   uint32              N_s,
+                   uint32              L,
+                   uint32              N_id_cell,
+                   float             **crs_re,
+                   float             **crs_im);
+
+/*********************************************************************
+    Name: dl_ce_weights_gen
+
+    Description: Generates the frequency interpolation weights used
+                 between CRSs for each of the 6 CRS subcarrier offsets
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dl_ce_weights_gen(LIBLTE_PHY_STRUCT *phy_struct);
+
+/*********************************************************************
+    Name: dl_ce_interp_freq
+
+    Description: Interpolates the channel estimates at the CRSs of a
+                 symbol to every subcarrier
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dl_ce_interp_freq(LIBLTE_PHY_STRUCT *phy_struct,
+                       uint32             offset,
+                       float             *crs_re,
+                       float             *crs_im,
+                       float             *ce_re,
+                       float             *ce_im);
+
+/*********************************************************************
+    Name: dl_ce_interp_time
+
+    Description: Computes out = a + t*(b - a) for N complex values,
+                 used to interpolate channel estimates across symbols
+                 and to average them across subframes
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dl_ce_interp_time(float  *a_re,
+                       float  *a_im,
+                       float  *b_re,
+                       float  *b_im,
+                       float   t,
+                       uint32  N,
+                       float  *out_re,
+                       float  *out_im);
+void dl_ce_interp_time_scalar(float  *a_re,
+                              float  *a_im,
+                              float  *b_re,
+                              float  *b_im,
+                              float   t,
+                              uint32  N,
+                              float  *out_re,
+                              float  *out_im);
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse4.1")))
+void dl_ce_interp_time_sse4_1(float  *a_re,
+                              float  *a_im,
+                              float  *b_re,
+                              float  *b_im,
+                              float   t,
+                              uint32  N,
+                              float  *out_re,
+                              float  *out_im);
+__attribute__((target("avx2")))
+void dl_ce_interp_time_avx2(float  *a_re,
+                            float  *a_im,
+                            float  *b_re,
+                            float  *b_im,
+                            float   t,
+                            uint32  N,
+                            float  *out_re,
+                            float  *out_im);
+#endif
+
+/*********************************************************************
+    Name: dl_ce_interp_time_cf
+
+    Description: Computes out = a + t*(b - a) for N complex values,
+                 writing the result as interleaved complex values
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dl_ce_interp_time_cf(float                *a_re,
+                          float                *a_im,
+                          float                *b_re,
+                          float                *b_im,
+                          float                 t,
+                          uint32                N,
+                          LIBLTE_PHY_CF_STRUCT *out);
+
 /*********************************************************************
     Name: generate_pss
 
@@ -1208,6 +1495,41 @@ void generate_pss(uint32  N_id_2,
                   float  *pss_re,
                   float  *pss_im);
 
+/*********************************************************************
+    Name: pss_corr_init
+
+    Description: Allocates the FFT based PSS correlator and generates
+                 the frequency domain PSS replicas
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void pss_corr_init(LIBLTE_PHY_STRUCT *phy_struct);
+
+/*********************************************************************
+    Name: pss_coarse_timing_search
+
+    Description: Finds slot starts of eNB signals by correlating with
+                 the PSS, one 4*N_samps_per_symb point FFT per
+                 3*N_samps_per_symb samples and only the bins around
+                 the PSS going back through the inverse FFT
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void pss_coarse_timing_search(LIBLTE_PHY_STRUCT *phy_struct,
+                              float             *i_samps,
+                              float             *q_samps,
+                              uint32             N_slots,
+                              int32             *abs_corr_idx,
+                              uint32            *n_corr_peaks);
+
 /*********************************************************************
     Name: generate_sss
 
@@ -1239,13 +1561,23 @@ void generate_sss(LIBLTE_PHY_STRUCT *phy_struct,
 // Enums
 // Structs
 // Functions
-void symbols_to_samples_dl(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *symb_re,
-                           float             *symb_im,
-                           uint32             symbol_offset,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32            *N_samps);
+void symbols_to_samples_dl(LIBLTE_PHY_STRUCT          *phy_struct,
+                           LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                           uint8                       ant,
+                           uint32                      symbol_offset,
+                           float                      *samps_re,
+                           float                      *samps_im,
+                           uint32                     *N_samps);
+void symbols_to_samples_dl_cf(LIBLTE_PHY_STRUCT          *phy_struct,
+                              LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                              uint8                       ant,
+                              uint32                      symbol_offset,
+                              LIBLTE_PHY_CF_STRUCT       *samps,
+                              uint32                     *N_samps);
+void symbol_to_fft_in_dl(LIBLTE_PHY_STRUCT          *phy_struct,
+                         LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                         uint8                       ant,
+                         uint32                      symbol_offset);
 
 /*********************************************************************
     Name: symbols_to_samples_ul
@@ -1284,15 +1616,35 @@ void samples_to_symbols_dl(LIBLTE_PHY_STRUCT *phy_struct,
                            float             *samps_im,
                            uint32             slot_start_idx,
                            uint32             symbol_offset,
-                           uint8              scale,
                            float             *symb_re,
                            float             *symb_im);
 
 /*********************************************************************
-    Name: samples_to_symbols_ul
+    Name: samples_to_subframe_dl
 
-    Description: Converts I/Q samples to subcarrier symbols for the
-                 uplink
+    Description: Converts the I/Q samples of a downlink subframe, plus
+                 the first two symbols of the next subframe, to
+                 subcarrier symbols using a single batched FFT
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void samples_to_subframe_dl(LIBLTE_PHY_STRUCT          *phy_struct,
+                            float                      *samps_re,
+                            float                      *samps_im,
+                            uint32                      subfr_start_idx,
+                            LIBLTE_PHY_SUBFRAME_STRUCT *subframe);
+
+/*********************************************************************
+    Name: samples_to_subframe_ul
+
+    Description: Converts the I/Q samples of an uplink subframe to
+                 subcarrier symbols using a single batched FFT, reading
+                 every stride'th float so that both split and
+                 interleaved sample buffers can be used
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
 *********************************************************************/
@@ -1300,23 +1652,20 @@ void samples_to_symbols_dl(LIBLTE_PHY_STRUCT *phy_struct,
 // Enums
 // Structs
 // Functions
-void samples_to_symbols_ul(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32             slot_start_idx,
-                           uint32             symbol_offset,
-                           float             *symb_re,
-                           float             *symb_im);
+void samples_to_subframe_ul(LIBLTE_PHY_STRUCT          *phy_struct,
+                            float                      *samps_re,
+                            float                      *samps_im,
+                            uint32                      stride,
+                            LIBLTE_PHY_SUBFRAME_STRUCT *subframe);
 
 /*********************************************************************
     Name: modulation_mapper
 
     Description: Maps binary digits to complex-valued modulation
-                 symbols
+                 symbols using precomputed constellation tables.  A
+                 partial last symbol is padded with zeros.
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
-
-    NOTES: Currently only supports BPSK and QPSK
 *********************************************************************/
 // Defines
 // Enums
@@ -1330,14 +1679,45 @@ void modulation_mapper(uint8                           *bits,
                        uint32                          *M_symb);
 
 /*********************************************************************
-    Name: modulation_demapper
+    Name: mod_tables
 
-    Description: Maps complex-valued modulation symbols to binary
-                 digits
+    Description: Returns the modulation mapper constellation tables,
+                 calculating them on first use
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+MOD_TABLES_STRUCT* mod_tables(void);
+
+/*********************************************************************
+    Name: mod_tables_pre_calc
+
+    Description: Calculates the constellation tables for a single
+                 symbol of each modulation type, and for all symbols
+                 of a byte for QPSK and 16QAM
 
     Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+bool mod_tables_pre_calc(MOD_TABLES_STRUCT *tables);
+
+/*********************************************************************
+    Name: modulation_demapper
 
-    NOTES: Currently only supports BPSK and QPSK
+    Description: Maps complex-valued modulation symbols to max-log
+                 LLR soft bits, positive for a 0 bit.  The Gray coded
+                 constellations let each LLR be computed from a single
+                 I or Q component with piecewise linear functions.
+                 noise_var is the noise variance of the symbols and
+                 LLRs are quantized to 1/LLR_INT8_SCALE.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
 // Defines
 // Enums
@@ -1347,9249 +1727,13588 @@ void modulation_demapper(float                           *d_re,
                          float                           *d_im,
                          uint32                           M_symb,
                          LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
+                         float                            noise_var,
                          int8                            *bits,
                          uint32                          *N_bits);
 
 /*********************************************************************
-    Name: generate_prs_c
+    Name: llr_demap_scalar
 
-    Description: Generates the psuedo random sequence c
+    Description: Reference max-log LLR demapper for QPSK, 16QAM, and
+                 64QAM.  The first I/Q LLR pair is g*y and each
+                 following pair is g*(T[k-1] - |previous|).
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void generate_prs_c(uint32  c_init,
-                    uint32  len,
-                    uint32 *c);
+void llr_demap_scalar(float  *d_re,
+                      float  *d_im,
+                      uint32  M_symb,
+                      uint32  Q_m,
+                      float  *T,
+                      float   gain,
+                      int8   *bits);
 
 /*********************************************************************
-    Name: calc_crc
+    Name: llr_quantize
 
-    Description: Calculates one of the LTE CRCs
+    Description: Saturates an LLR to +/-127 and rounds it to the
+                 nearest integer
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+    Document Reference: N/A
 *********************************************************************/
 // Defines
-#define CRC24A 0x01864CFB
-#define CRC24B 0x01800063
-#define CRC16  0x00011021
-#define CRC8   0x0000019B
 // Enums
 // Structs
 // Functions
-void calc_crc(uint8  *a_bits,
-              uint32  N_a_bits,
-              uint32  crc,
-              uint8  *p_bits,
-              uint32  N_p_bits);
+int8 llr_quantize(float llr);
 
+#if defined(__x86_64__) || defined(__i386__)
 /*********************************************************************
-    Name: conv_encode
+    Name: llr_demap_sse4_1
 
-    Description: Convolutionally encodes a bit array using the
-                 provided parameters
+    Description: SSE4.1 version of llr_demap_scalar, 4 symbols at a
+                 time
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void conv_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                 uint8             *c_bits,
-                 uint32             N_c_bits,
-                 uint32             constraint_len,
-                 uint32             rate,
-                 uint32            *g,
-                 bool               tail_bit,
-                 uint8             *d_bits,
-                 uint32            *N_d_bits);
+__attribute__((target("sse4.1")))
+void llr_demap_sse4_1(float  *d_re,
+                      float  *d_im,
+                      uint32  M_symb,
+                      uint32  Q_m,
+                      float  *T,
+                      float   gain,
+                      int8   *bits);
 
 /*********************************************************************
-    Name: conv_encode_soft
+    Name: llr_demap_avx2
 
-    Description: Convolutionally encodes a soft bit array using the
-                 provided parameters
+    Description: AVX2 version of llr_demap_scalar, 8 symbols at a
+                 time
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void conv_encode_soft(LIBLTE_PHY_STRUCT *phy_struct,
-                      int8              *c_bits,
-                      uint32             N_c_bits,
-                      uint32             constraint_len,
-                      uint32             rate,
-                      uint32            *g,
-                      bool               tail_bit,
-                      int8              *d_bits,
-                      uint32            *N_d_bits);
+__attribute__((target("avx2")))
+void llr_demap_avx2(float  *d_re,
+                    float  *d_im,
+                    uint32  M_symb,
+                    uint32  Q_m,
+                    float  *T,
+                    float   gain,
+                    int8   *bits);
+#endif
 
 /*********************************************************************
-    Name: viterbi_decode
+    Name: generate_prs_c
 
-    Description: Viterbi decodes a convolutionally coded input bit
-                 array using the provided parameters
+    Description: Generates the psuedo random sequence c
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                    float             *d_bits,
-                    uint32             N_d_bits,
-                    uint32             constraint_len,
-                    uint32             rate,
-                    uint32            *g,
-                    uint8             *c_bits,
-                    uint32            *N_c_bits);
+void generate_prs_c(uint32  c_init,
+                    uint32  len,
+                    uint32 *c);
 
 /*********************************************************************
-    Name: viterbi_decode_siso
+    Name: generate_prs_c_packed
 
-    Description: Soft input soft output viterbi decodes a
-                 convolutionally coded input bit array using the
-                 provided parameters
+    Description: Generates the psuedo random sequence c as packed
+                 bits, most significant bit first
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void viterbi_decode_siso(LIBLTE_PHY_STRUCT *phy_struct,
-                         int8              *d_bits,
-                         uint32             N_d_bits,
-                         uint32             constraint_len,
-                         uint32             rate,
-                         uint32            *g,
-                         int8              *c_bits,
-                         uint32            *N_c_bits);
+void generate_prs_c_packed(uint32  c_init,
+                           uint32  len,
+                           uint8  *c_bytes);
 
 /*********************************************************************
-    Name: turbo_encode
+    Name: prs_c_init
 
-    Description: Turbo encodes a bit array using the LTE Parallel
-                 Concatenated Convolutional Code
+    Description: Initializes both m-sequences of the psuedo random
+                 sequence c, advanced by N_c
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void prs_c_init(uint32  c_init,
+                uint32 *x1,
+                uint32 *x2);
 
-    Notes: Currently not handling filler bits
+/*********************************************************************
+    Name: prs_c_word
+
+    Description: Generates the next 32 bits of the psuedo random
+                 sequence c, first bit in the least significant bit
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                  uint8             *c_bits,
-                  uint32             N_c_bits,
-                  uint32             N_fill_bits,
-                  uint8             *d_bits,
-                  uint32            *N_d_bits);
+uint32 prs_c_word(uint32 *x1,
+                  uint32 *x2);
 
 /*********************************************************************
-    Name: turbo_decode
+    Name: prs_c_tables
 
-    Description: Turbo decodes data according to the LTE Parallel
-                 Concatenated Convolutional Code.  The design of this
-                 decoder is based on the conversion of the constituent
-                 coder from:
-                                   -------->+---------------->+---- out
-                                   |        ^                 ^
-                           in_act  |   |-|  |   |-|      |-|  |
-                 in --->+------------->|D|----->|D|----->|D|---
-                        ^              |-|      |-|  |   |-|  |
-                        |                            v        |
-                        -----------------------------+<--------
-                 to:
-                           ------->+---------------->+------------- out
-                           |       ^                 ^
-                           |  |-|  |   |-|      |-|  |       
-                 in_act ------|D|----->|D|----->|D|---         
-                           |  |-|      |-|  |   |-|  |          
-                           |                v        v         
-                           ---------------->+------->+------------- in
-                 in_act can be determined using viterbi decoding and
-                 a second copy of in can be calculated using in_act
-
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Description: Returns the psuedo random sequence c tables,
+                 calculating them on first use
 
-    Notes: Currently not handling filler bits
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void turbo_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                  float             *d_bits,
-                  uint32             N_d_bits,
-                  uint32             N_fill_bits,
-                  uint8             *c_bits,
-                  uint32            *N_c_bits);
+PRS_C_TABLES_STRUCT* prs_c_tables(void);
 
 /*********************************************************************
-    Name: turbo_constituent_encoder
+    Name: prs_c_tables_pre_calc
 
-    Description: Constituent encoder for the LTE Parallel Concatenated
-                 Convolutional Code
+    Description: Calculates the jump table that advances the 2nd
+                 m-sequence by N_c for each bit of c_init, and the
+                 byte bit reversal table used for packed output
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void turbo_constituent_encoder(uint8  *in_bits,
-                               uint32  N_in_bits,
-                               uint8  *out_bits,
-                               uint8  *fb_bits);
+bool prs_c_tables_pre_calc(PRS_C_TABLES_STRUCT *tables);
 
 /*********************************************************************
-    Name: turbo_internal_interleaver
+    Name: calc_crc
 
-    Description: Internal interleaver for the LTE Parallel
-                 Concatenated Convolutional Code
+    Description: Calculates one of the LTE CRCs
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void turbo_internal_interleaver(uint8  *in_bits,
-                                uint32  N_in_bits,
-                                uint8  *out_bits);
-void turbo_internal_interleaver(int8   *in_bits,
-                                uint32  N_in_bits,
-                                int8   *out_bits);
-void turbo_internal_interleaver(float  *in_bits,
-                                uint32  N_in_bits,
-                                float  *out_bits);
+void calc_crc(uint8  *a_bits,
+              uint32  N_a_bits,
+              uint32  crc,
+              uint8  *p_bits,
+              uint32  N_p_bits);
 
 /*********************************************************************
-    Name: turbo_internal_deinterleaver
+    Name: check_crc
 
-    Description: Internal Deinterleaver for the LTE Parallel
-                 Concatenated Convolutional Code
+    Description: Checks the trailing CRC bits of a bit array
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void turbo_internal_deinterleaver(float  *in_bits,
-                                  uint32  N_in_bits,
-                                  float  *out_bits);
-void turbo_internal_deinterleaver(int8   *in_bits,
-                                  uint32  N_in_bits,
-                                  int8   *out_bits);
+bool check_crc(uint8  *c_bits,
+               uint32  N_c_bits,
+               uint32  crc,
+               uint32  N_p_bits);
 
 /*********************************************************************
-    Name: rate_match_conv
+    Name: crc_init
 
-    Description: Rate matches convolutionally encoded data
+    Description: Initializes an incremental CRC calculation
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void rate_match_conv(LIBLTE_PHY_STRUCT *phy_struct,
-                     uint8             *d_bits,
-                     uint32             N_d_bits,
-                     uint32             N_e_bits,
-                     uint8             *e_bits);
+void crc_init(CRC_STATE_STRUCT *state,
+              uint32            crc,
+              uint32            N_p_bits);
 
 /*********************************************************************
-    Name: rate_unmatch_conv
+    Name: crc_update_bits
 
-    Description: Rate unmatches convolutionally encoded data
+    Description: Adds an array of unpacked bits to an incremental CRC
+                 calculation.  Only the least significant bit of each
+                 entry is used, so filler bits (TX_NULL_SYMB) are
+                 included as 0.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
-#define RX_NULL_BIT 10000
-#define TX_NULL_BIT 100
 // Enums
 // Structs
 // Functions
-void rate_unmatch_conv(LIBLTE_PHY_STRUCT *phy_struct,
-                       float             *e_bits,
-                       uint32             N_e_bits,
-                       uint32             N_c_bits,
-                       float             *d_bits,
-                       uint32            *N_d_bits);
+void crc_update_bits(CRC_STATE_STRUCT *state,
+                     uint8            *bits,
+                     uint32            N_bits);
 
 /*********************************************************************
-    Name: code_block_concatenation
+    Name: crc_update_bytes
 
-    Description: Performs code block concatenation for turbo coded
-                 channels
+    Description: Adds an array of packed bytes, most significant bit
+                 first, to an incremental CRC calculation
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void code_block_concatenation(uint8  *e_bits,
-                              uint32 *N_e_bits,
-                              uint32  N_e_bits_max,
-                              uint32  N_codeblocks,
-                              uint8  *f_bits,
-                              uint32 *N_f_bits);
+void crc_update_bytes(CRC_STATE_STRUCT *state,
+                      uint8            *bytes,
+                      uint32            N_bytes);
 
 /*********************************************************************
-    Name: code_block_deconcatenation
+    Name: code_block_segmentation_sizes
 
-    Description: Performs code block deconcatenation for turbo coded
+    Description: Determines the code block sizes for turbo coded
                  channels
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void code_block_deconcatenation(float  *f_bits,
-                                uint32  N_f_bits,
-                                uint32  tbs,
-                                float  *e_bits,
-                                uint32 *N_e_bits,
-                                uint32  N_e_bits_max,
-                                uint32 *N_codeblocks);
+void code_block_segmentation_sizes(uint32  N_b_bits,
+                                   uint32 *L,
+                                   uint32 *C,
+                                   uint32 *F,
+                                   uint32 *K_plus,
+                                   uint32 *K_minus,
+                                   uint32 *C_minus);
 
 /*********************************************************************
-    Name: ulsch_data_control_multiplexing
+    Name: bit_copy
 
-    Description: Multiplexes the control and data bits for Uplink
-                 Shared Channel
+    Description: Copies packed bits between arbitrary bit offsets
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void ulsch_data_control_multiplexing(uint8  *f_bits,
-                                     uint32  N_f_bits,
-                                     uint8  *cqi_bits,
-                                     uint32  N_cqi_bits,
-                                     uint32  N_l,
-                                     uint32  Q_m,
-                                     uint8  *g_bits,
-                                     uint32 *N_g_bits);
+void bit_copy(uint8  *src,
+              uint32  src_offset,
+              uint8  *dst,
+              uint32  dst_offset,
+              uint32  N_bits);
 
 /*********************************************************************
-    Name: ulsch_data_control_demultiplexing
+    Name: bit_write
 
-    Description: Demultiplexes the control and data bits for Uplink
-                 Shared Channel
+    Description: Writes the N_bits least significant bits of a value,
+                 most significant bit first, into packed bits
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void ulsch_data_control_demultiplexing(float  *g_bits,
-                                       uint32  N_g_bits,
-                                       uint32  N_cqi_bits,
-                                       uint32  N_l,
-                                       uint32  Q_m,
-                                       float  *f_bits,
-                                       uint32 *N_f_bits,
-                                       float  *cqi_bits);
+void bit_write(uint8  *dst,
+               uint32  dst_offset,
+               uint32  value,
+               uint32  N_bits);
 
 /*********************************************************************
-    Name: ulsch_channel_interleaver
+    Name: crc_update_packed_bits
 
-    Description: Interleaves Uplink Shared Channel data with RI and
-                 ACK control information
+    Description: Adds a number of packed bits, most significant bit
+                 first, to an incremental CRC calculation
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void ulsch_channel_interleaver(LIBLTE_PHY_STRUCT *phy_struct,
-                               uint8             *g_bits,
-                               uint32             N_g_bits,
-                               uint8             *ri_bits,
-                               uint32             N_ri_bits,
-                               uint8             *ack_bits,
-                               uint32             N_ack_bits,
-                               uint32             N_l,
-                               uint32             Q_m,
-                               uint8             *h_bits,
-                               uint32            *N_h_bits);
+void crc_update_packed_bits(CRC_STATE_STRUCT *state,
+                            uint8            *bytes,
+                            uint32            N_bits);
 
 /*********************************************************************
-    Name: ulsch_channel_deinterleaver
+    Name: crc_update_zeros
 
-    Description: Deinterleaves Uplink Shared Channel data from RI and
-                 ACK control information
+    Description: Adds a number of 0 bits to an incremental CRC
+                 calculation
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void ulsch_channel_deinterleaver(LIBLTE_PHY_STRUCT *phy_struct,
-                                 float             *h_bits,
-                                 uint32             N_h_bits,
-                                 uint32             N_ri_bits,
-                                 uint32             N_ack_bits,
-                                 uint32             N_l,
-                                 uint32             Q_m,
-                                 float             *g_bits,
-                                 uint32            *N_g_bits,
-                                 float             *ri_bits,
-                                 float             *ack_bits);
+void crc_update_zeros(CRC_STATE_STRUCT *state,
+                      uint32            N_bits);
 
 /*********************************************************************
-    Name: ulsch_channel_encode
+    Name: crc_value
 
-    Description: Channel encodes the Uplink Shared Channel
-
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
+    Description: Returns the current CRC remainder of an incremental
+                 CRC calculation, most significant bit first
 
-    Notes: Not handling control bits
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                          uint8             *in_bits,
-                          uint32             N_in_bits,
-                          uint32             tbs,
-                          uint32             tx_mode,
-                          uint32             G,
-                          uint32             N_l,
-                          uint32             Q_m,
-                          uint32             rv_idx,
-                          uint8             *out_bits,
-                          uint32            *N_out_bits);
+uint32 crc_value(CRC_STATE_STRUCT *state);
 
 /*********************************************************************
-    Name: ulsch_channel_decode
-
-    Description: Channel decodes the Uplink Shared Channel
+    Name: crc_final
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
+    Description: Converts the current CRC remainder of an incremental
+                 CRC calculation into an array of parity bits
 
-    Notes: Not handling control bits
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float             *in_bits,
-                                       uint32             N_in_bits,
-                                       uint32             tbs,
-                                       uint32             tx_mode,
-                                       uint32             N_l,
-                                       uint32             Q_m,
-                                       uint32             rv_idx,
-                                       uint8             *out_bits,
-                                       uint32            *N_out_bits);
+void crc_final(CRC_STATE_STRUCT *state,
+               uint8            *p_bits);
 
 /*********************************************************************
-    Name: bch_channel_encode
+    Name: crc_tables
 
-    Description: Channel encodes the broadcast channel
+    Description: Returns the slicing-by-8 CRC tables, calculating them
+                 on first use
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void bch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                        uint8             *in_bits,
-                        uint32             N_in_bits,
-                        uint8              N_ant,
-                        uint8             *out_bits,
-                        uint32            *N_out_bits);
+CRC_TABLES_STRUCT* crc_tables(void);
 
 /*********************************************************************
-    Name: bch_channel_decode
+    Name: crc_tables_pre_calc
 
-    Description: Channel decodes the broadcast channel
+    Description: Calculates the slicing-by-8 CRC tables for all of the
+                 LTE CRC polynomials
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM bch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                     float             *in_bits,
-                                     uint32             N_in_bits,
-                                     uint8              N_ant,
-                                     uint8             *out_bits,
-                                     uint32            *N_out_bits);
+bool crc_tables_pre_calc(CRC_TABLES_STRUCT *tables);
 
 /*********************************************************************
-    Name: dlsch_channel_encode
+    Name: conv_encode
 
-    Description: Channel encodes the Downlink Shared Channel
+    Description: Convolutionally encodes a bit array using the
+                 provided parameters
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                          uint8             *in_bits,
-                          uint32             N_in_bits,
-                          uint32             tbs,
-                          uint32             tx_mode,
-                          uint32             rv_idx,
-                          uint32             G,
-                          uint32             N_l,
-                          uint32             Q_m,
-                          uint32             M_dl_harq,
-                          uint32             N_soft,
-                          uint8             *out_bits,
-                          uint32            *N_out_bits);
+void conv_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                 uint8             *c_bits,
+                 uint32             N_c_bits,
+                 uint32             constraint_len,
+                 uint32             rate,
+                 uint32            *g,
+                 bool               tail_bit,
+                 uint8             *d_bits,
+                 uint32            *N_d_bits);
 
 /*********************************************************************
-    Name: dlsch_channel_decode
+    Name: conv_encode_soft
 
-    Description: Channel decodes the Downlink Shared Channel
+    Description: Convolutionally encodes a soft bit array using the
+                 provided parameters
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float             *in_bits,
-                                       uint32             N_in_bits,
-                                       uint32             tbs,
-                                       uint32             tx_mode,
-                                       uint32             rv_idx,
-                                       uint32             M_dl_harq,
-                                       uint32             N_soft,
-                                       uint8             *out_bits,
-                                       uint32            *N_out_bits);
-
-/*********************************************************************
-    Name: dci_channel_encode
+void conv_encode_soft(LIBLTE_PHY_STRUCT *phy_struct,
+                      int8              *c_bits,
+                      uint32             N_c_bits,
+                      uint32             constraint_len,
+                      uint32             rate,
+                      uint32            *g,
+                      bool               tail_bit,
+                      int8              *d_bits,
+                      uint32            *N_d_bits);
 
-    Description: Channel encodes the Downlink Control Information
-                 channel
+/*********************************************************************
+    Name: viterbi_decode
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+    Description: Viterbi decodes a convolutionally coded input bit
+                 array using the provided parameters
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void dci_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                        uint8             *in_bits,
-                        uint32             N_in_bits,
-                        uint16             rnti,
-                        uint8              ue_ant,
-                        uint32             N_out_bits,
-                        uint8             *out_bits);
+void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                    float             *d_bits,
+                    uint32             N_d_bits,
+                    uint32             constraint_len,
+                    uint32             rate,
+                    uint32            *g,
+                    uint8             *c_bits,
+                    uint32            *N_c_bits);
 
 /*********************************************************************
-    Name: dci_channel_decode
+    Name: viterbi_decode_siso
 
-    Description: Channel decodes the Downlink Control Information
-                 channel
+    Description: Soft input soft output viterbi decodes a
+                 convolutionally coded input bit array using the
+                 provided parameters
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                     float             *in_bits,
-                                     uint32             N_in_bits,
-                                     uint16             rnti_start,
-                                     uint16             rnti_range,
-                                     uint8              ue_ant,
-                                     uint8             *out_bits,
-                                     uint32             N_out_bits,
-                                     uint16            *rnti_found);
+void viterbi_decode_siso(LIBLTE_PHY_STRUCT *phy_struct,
+                         int8              *d_bits,
+                         uint32             N_d_bits,
+                         uint32             constraint_len,
+                         uint32             rate,
+                         uint32            *g,
+                         int8              *c_bits,
+                         uint32            *N_c_bits);
 
 /*********************************************************************
-    Name: dci_0_pack
+    Name: viterbi_decode_k7
 
-    Description: Packs all of the fields into the Downlink Control
-                 Information format 0
-
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.6
+    Description: Viterbi decodes a tail-biting, constraint length 7,
+                 rate 1/3 convolutionally coded input bit array using
+                 16 bit path metrics.  The trellis is run around the
+                 circular input with LIBLTE_PHY_VITERBI_K7_WRAP_BITS
+                 extra steps on each side so that the start and end
+                 states converge without knowing them.
 
-    Notes: Currently only handles non-hopping single-cluster
-           assignments
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
 // Defines
-#define DCI_0_1A_FLAG_0          0
-#define DCI_0_1A_FLAG_1A         1
-#define DCI_VRB_TYPE_LOCALIZED   0
-#define DCI_VRB_TYPE_DISTRIBUTED 1
+#define VITERBI_K7_SOFT_MAX 127
 // Enums
 // Structs
 // Functions
-void dci_0_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
-                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
-                uint32                           N_rb_ul,
-                uint8                            N_ant,
-                uint8                           *out_bits,
-                uint32                          *N_out_bits);
+void viterbi_decode_k7(LIBLTE_PHY_STRUCT *phy_struct,
+                       float             *d_bits,
+                       uint32             N_d_bits,
+                       uint32            *g,
+                       uint8             *c_bits,
+                       uint32            *N_c_bits);
 
 /*********************************************************************
-    Name: dci_0_unpack
-
-    Description: Unpacks all of the fields from the Downlink Control
-                 Information format 0
+    Name: viterbi_k7_tables
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.1.1
-                        3GPP TS 36.213 v10.3.0 section 8.6
+    Description: Calculates the branch output signs of the K=7, rate
+                 1/3 trellis for a set of generator polynomials
 
-    Notes: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-// FIXME
+void viterbi_k7_tables(LIBLTE_PHY_STRUCT *phy_struct,
+                       uint32            *g);
 
 /*********************************************************************
-    Name: dci_1a_pack
+    Name: viterbi_k7_acs
 
-    Description: Packs all of the fields into the Downlink Control
-                 Information format 1A
+    Description: Performs one add-compare-select step of the K=7,
+                 rate 1/3 trellis, returning the decision bit of
+                 each state
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Document Reference: N/A
 
-    Notes: Currently only handles localized virtual resource blocks
+    Notes: State n is entered from states (2n)%64 (decision 0)
+           and (2n+1)%64 (decision 1) with an input bit of n>>5.
+           Signs are +1 for a coded 0 and -1 for a coded 1.
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void dci_1a_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
-                 LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
-                 uint32                           N_rb_dl,
-                 uint8                            N_ant,
-                 uint8                           *out_bits,
-                 uint32                          *N_out_bits);
+uint64 viterbi_k7_acs(int16  *metric,
+                      int16  *d,
+                      int16 (*sign)[3][LIBLTE_PHY_VITERBI_K7_N_STATES],
+                      int16  *metric_next);
 
+#if defined(__x86_64__) || defined(__i386__)
 /*********************************************************************
-    Name: dci_1a_unpack
-
-    Description: Unpacks all of the fields from the Downlink Control
-                 Information format 1A
+    Name: viterbi_k7_acs_sse4_1
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Description: SSE4.1 version of viterbi_k7_acs, each vector holds
+                 8 butterflies
 
-    Notes: Currently only handles SI-RNTI, P-RNTI, or RA-RNTI and
-           localized virtual resource blocks
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM dci_1a_unpack(uint8                           *in_bits,
-                                uint32                           N_in_bits,
-                                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
-                                uint16                           rnti,
-                                uint32                           N_rb_dl,
-                                uint8                            N_ant,
-                                LIBLTE_PHY_ALLOCATION_STRUCT    *alloc);
+__attribute__((target("sse4.1")))
+uint64 viterbi_k7_acs_sse4_1(int16  *metric,
+                             int16  *d,
+                             int16 (*sign)[3][LIBLTE_PHY_VITERBI_K7_N_STATES],
+                             int16  *metric_next);
 
 /*********************************************************************
-    Name: dci_1c_pack
+    Name: viterbi_k7_acs_avx2
 
-    Description: Packs all of the fields into the Downlink Control
-                 Information format 1C
+    Description: AVX2 version of viterbi_k7_acs, each vector holds
+                 16 butterflies
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Document Reference: N/A
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-// FIXME
+__attribute__((target("avx2")))
+uint64 viterbi_k7_acs_avx2(int16  *metric,
+                           int16  *d,
+                           int16 (*sign)[3][LIBLTE_PHY_VITERBI_K7_N_STATES],
+                           int16  *metric_next);
+#endif
 
 /*********************************************************************
-    Name: dci_1c_unpack
+    Name: turbo_encode
 
-    Description: Unpacks all of the fields from the Downlink Control
-                 Information format 1C
+    Description: Turbo encodes a bit array using the LTE Parallel
+                 Concatenated Convolutional Code
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
-                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
-                        3GPP TS 36.213 v10.3.0 section 7.1.7
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 
-    Notes: Currently only handling SI-RNTI, P-RNTI, and RA-RNTI
+    Notes: Currently not handling filler bits
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM dci_1c_unpack(uint8                        *in_bits,
-                                uint32                        N_in_bits,
-                                uint16                        rnti,
-                                uint32                        N_rb_dl,
-                                uint8                         N_ant,
-                                LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
+void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                  uint8             *c_bits,
+                  uint32             N_c_bits,
+                  uint32             N_fill_bits,
+                  uint8             *d_bits,
+                  uint32            *N_d_bits);
 
 /*********************************************************************
-    Name: cfi_channel_encode
+    Name: turbo_encode_packed
 
-    Description: Channel encodes the Control Format Indicator channel
+    Description: Turbo encodes packed bits using the LTE Parallel
+                 Concatenated Convolutional Code.  The three output
+                 streams are each (N_c_bits+11)/8 bytes long and are
+                 stored one after the other.  Filler bits must be 0.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void cfi_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                        uint32             cfi,
-                        uint8             *out_bits,
-                        uint32            *N_out_bits);
+void turbo_encode_packed(LIBLTE_PHY_STRUCT *phy_struct,
+                         uint8             *c_bytes,
+                         uint32             N_c_bits,
+                         uint8             *d_bytes,
+                         uint32            *N_d_bits);
 
 /*********************************************************************
-    Name: cfi_channel_decode
+    Name: turbo_encoder_tables
 
-    Description: Channel decodes the Control Format Indicator channel
+    Description: Returns the byte at a time turbo constituent encoder
+                 tables, calculating them on first use.  Each entry
+                 holds the 8 parity bits in the low byte and the next
+                 state in the high byte.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
+    Document Reference: N/A
 *********************************************************************/
 // Defines
-#define CFI_N_ACCEPTABLE_BERS 4
 // Enums
 // Structs
 // Functions
-LIBLTE_ERROR_ENUM cfi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                                     float             *in_bits,
-                                     uint32             N_in_bits,
-                                     uint32            *cfi);
+uint16 (*turbo_encoder_tables(void))[256];
 
 /*********************************************************************
-    Name: get_ulsch_ce
+    Name: turbo_encoder_tables_pre_calc
 
-    Description: Resolves channel estimates for the uplink shared
-                 channel
+    Description: Calculates the byte at a time turbo constituent
+                 encoder tables
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void get_ulsch_ce(LIBLTE_PHY_STRUCT *phy_struct,
-                  float             *c_est_0_re,
-                  float             *c_est_0_im,
-                  float             *c_est_1_re,
-                  float             *c_est_1_im,
-                  uint32             N_prb,
-                  uint32             N_subfr,
-                  float             *c_est_re,
-                  float             *c_est_im);
+bool turbo_encoder_tables_pre_calc(uint16 (*table)[256]);
 
 /*********************************************************************
-    Name: get_ulcch_ce
+    Name: turbo_decode
 
-    Description: Resolves channel estimates for the uplink control
-                 channel
+    Description: Turbo decodes data according to the LTE Parallel
+                 Concatenated Convolutional Code using the decoder
+                 selected in phy_struct.  If crc is non-zero the last
+                 24 decoded bits are checked as a CRC of that type.
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void get_ulcch_ce(LIBLTE_PHY_STRUCT *phy_struct,
-                  float             *c_est_0_re,
-                  float             *c_est_0_im,
-                  float             *c_est_1_re,
-                  float             *c_est_1_im,
-                  uint32             N_subfr,
-                  uint32             N_1_p_pucch,
-                  float             *c_est_re,
-                  float             *c_est_im);
+LIBLTE_ERROR_ENUM turbo_decode(LIBLTE_PHY_STRUCT                  *phy_struct,
+                               LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT *ctx,
+                               float                              *d_bits,
+                               uint32                              N_d_bits,
+                               uint32                              N_fill_bits,
+                               uint32                              crc,
+                               uint8                              *c_bits,
+                               uint32                             *N_c_bits,
+                               uint32                             *N_iterations);
 
 /*********************************************************************
-    Name: get_soft_decision
+    Name: turbo_decode_viterbi_siso
 
-    Description: Determines the magnitude of the soft decision
+    Description: Turbo decodes data according to the LTE Parallel
+                 Concatenated Convolutional Code.  The design of this
+                 decoder is based on the conversion of the constituent
+                 coder from:
+                                   -------->+---------------->+---- out
+                                   |        ^                 ^
+                           in_act  |   |-|  |   |-|      |-|  |
+                 in --->+------------->|D|----->|D|----->|D|---
+                        ^              |-|      |-|  |   |-|  |
+                        |                            v        |
+                        -----------------------------+<--------
+                 to:
+                           ------->+---------------->+------------- out
+                           |       ^                 ^
+                           |  |-|  |   |-|      |-|  |       
+                 in_act ------|D|----->|D|----->|D|---         
+                           |  |-|      |-|  |   |-|  |          
+                           |                v        v         
+                           ---------------->+------->+------------- in
+                 in_act can be determined using viterbi decoding and
+                 a second copy of in can be calculated using in_act
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+
+    Notes: Currently not handling filler bits
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-float get_soft_decision(float rx_re,
-                        float rx_im,
-                        float exp_re,
-                        float exp_im,
-                        float max_dist);
-float get_soft_decision(float rx,
-                        float exp,
-                        float max_dist);
+void turbo_decode_viterbi_siso(LIBLTE_PHY_STRUCT *phy_struct,
+                               float             *d_bits,
+                               uint32             N_d_bits,
+                               uint32             N_fill_bits,
+                               uint8             *c_bits,
+                               uint32            *N_c_bits);
 
 /*********************************************************************
-    Name: get_num_bits_in_prb
+    Name: turbo_decode_max_log_map
 
-    Description: Determines the number of bits available in a
-                 particular PRB with a particular modulation type
+    Description: Turbo decodes data according to the LTE Parallel
+                 Concatenated Convolutional Code using two fixed point
+                 Max-Log-MAP constituent decoders exchanging extrinsic
+                 information through the internal interleaver.
+                 Iterations stop as soon as the decoded bits pass the
+                 CRC check.
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
 // Defines
+#define TURBO_LLR_CHANNEL_MAX   511
+#define TURBO_LLR_EXTRINSIC_MAX 1023
+#define TURBO_METRIC_NEG_INF    -16384
 // Enums
 // Structs
 // Functions
-uint32 get_num_bits_in_prb(uint32                          N_subframe,
-                           uint32                          N_ctrl_symbs,
-                           uint32                          prb,
-                           uint32                          N_rb_dl,
-                           uint8                           N_ant,
-                           LIBLTE_PHY_MODULATION_TYPE_ENUM mod_type);
+LIBLTE_ERROR_ENUM turbo_decode_max_log_map(LIBLTE_PHY_STRUCT                  *phy_struct,
+                                           LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT *ctx,
+                                           float                              *d_bits,
+                                           uint32                              N_d_bits,
+                                           uint32                              N_fill_bits,
+                                           uint32                              crc,
+                                           uint8                              *c_bits,
+                                           uint32                             *N_c_bits,
+                                           uint32                             *N_iterations);
 
 /*********************************************************************
-    Name: wrap_phase
+    Name: turbo_max_log_map_siso
 
-    Description: Checks the phase difference between two angles and
-                 wraps one to make the difference less than 2*pi.
+    Description: Soft input soft output Max-Log-MAP decoder for one
+                 of the LTE turbo constituent codes.  The backward
+                 recursion is run over windows of
+                 LIBLTE_PHY_TURBO_WINDOW_SIZE trellis steps, each
+                 preceded by an acquisition run over the next window.
 
-    Document Reference: N/A
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
 *********************************************************************/
 // Defines
 // Enums
 // Structs
 // Functions
-void wrap_phase(float *phase_1,
-                float  phase_2);
-
-/*******************************************************************************
-                              LIBRARY FUNCTIONS
-*******************************************************************************/
+void turbo_max_log_map_siso(LIBLTE_PHY_STRUCT                  *phy_struct,
+                            LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT *ctx,
+                            int16                              *sys,
+                            int16                              *par,
+                            int16                              *apriori,
+                            uint32                              K,
+                            int16                              *extrinsic);
 
 /*********************************************************************
-    Name: liblte_phy_init
+    Name: turbo_trellis_forward_step
 
-    Description: Initializes the LTE Physical Layer library.
+    Description: Performs one step of the Max-Log-MAP forward state
+                 metric recursion
 
     Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_init(LIBLTE_PHY_STRUCT  **phy_struct,
-                                  LIBLTE_PHY_FS_ENUM   fs,
-                                  uint16               N_id_cell,
-                                  uint8                N_ant,
-                                  uint32               N_rb_dl,
-                                  uint32               N_sc_rb_dl,
-                                  float                phich_res)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_trellis_forward_step(int16 *alpha,
+                                int32  L_sys,
+                                int32  L_par,
+                                bool   tail,
+                                int16 *alpha_next);
 
-    if(phy_struct != NULL)
-    {
-        *phy_struct = (LIBLTE_PHY_STRUCT *)malloc(sizeof(LIBLTE_PHY_STRUCT));
+/*********************************************************************
+    Name: turbo_trellis_backward_step
 
-        // Generic
-        switch(fs)
-        {
-        case LIBLTE_PHY_FS_30_72MHZ:
-            (*phy_struct)->fs                = 30720000;
-            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ;
-            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_30_72MHZ;
-            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_30_72MHZ;
-            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ;
-            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ;
-            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_30_72MHZ;
-            break;
-        case LIBLTE_PHY_FS_15_36MHZ:
-            (*phy_struct)->fs                = 15360000;
-            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_15_36MHZ;
-            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_15_36MHZ;
-            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_15_36MHZ;
-            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_15_36MHZ;
-            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_15_36MHZ;
-            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_15_36MHZ;
-            break;
-        case LIBLTE_PHY_FS_7_68MHZ:
-            (*phy_struct)->fs                = 7680000;
-            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_7_68MHZ;
-            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_7_68MHZ;
-            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_7_68MHZ;
-            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_7_68MHZ;
-            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_7_68MHZ;
-            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_7_68MHZ;
-            break;
-        case LIBLTE_PHY_FS_3_84MHZ:
-            (*phy_struct)->fs                = 3840000;
-            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_3_84MHZ;
-            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_3_84MHZ;
-            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_3_84MHZ;
-            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_3_84MHZ;
-            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_3_84MHZ;
-            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_3_84MHZ;
-            break;
-        case LIBLTE_PHY_FS_1_92MHZ:
-            (*phy_struct)->fs                = 1920000;
-            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_1_92MHZ;
-            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_1_92MHZ;
-            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_1_92MHZ;
-            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_1_92MHZ;
-            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_1_92MHZ;
-            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_1_92MHZ;
-            break;
-        }
-        (*phy_struct)->N_sc_rb_dl = N_sc_rb_dl;
-        (*phy_struct)->N_sc_rb_ul = LIBLTE_PHY_N_SC_RB_UL;
-        liblte_phy_update_n_rb_dl((*phy_struct), N_rb_dl);
-        (*phy_struct)->N_ant   = N_ant;
-        (*phy_struct)->ul_init = false;
+    Description: Performs one step of the Max-Log-MAP backward state
+                 metric recursion
 
-        // PHICH
-        if(LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP == (*phy_struct)->N_sc_rb_dl)
-        {
-            (*phy_struct)->N_group_phich = (uint32)ceilf((float)phich_res*((float)(*phy_struct)->N_rb_dl/(float)8));
-            (*phy_struct)->N_sf_phich    = 4;
-        }else{
-            (*phy_struct)->N_group_phich = 2*(uint32)ceilf((float)phich_res*((float)(*phy_struct)->N_rb_dl/(float)8));
-            (*phy_struct)->N_sf_phich    = 2;
-        }
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_trellis_backward_step(int16 *beta,
+                                 int32  L_sys,
+                                 int32  L_par,
+                                 bool   tail,
+                                 int16 *beta_prev);
 
-        // PDCCH Permutation
-        pdcch_permute_pre_calc(*phy_struct,
-                               N_ant,
-                               phich_res);
+/*********************************************************************
+    Name: turbo_trellis_extrinsic
 
-        // CRS Storage
-        if(LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN != N_id_cell)
-        {
-            (*phy_struct)->N_id_cell_crs = N_id_cell;
-            for(i=0; i<20; i++)
-            {
-                generate_crs(i, 0, N_id_cell, N_sc_rb_dl, (*phy_struct)->crs_re_storage[i][0], (*phy_struct)->crs_im_storage[i][0]);
-                generate_crs(i, 1, N_id_cell, N_sc_rb_dl, (*phy_struct)->crs_re_storage[i][1], (*phy_struct)->crs_im_storage[i][1]);
-                generate_crs(i, 4, N_id_cell, N_sc_rb_dl, (*phy_struct)->crs_re_storage[i][2], (*phy_struct)->crs_im_storage[i][2]);
-            }
-        }
+    Description: Calculates the Max-Log-MAP extrinsic information for
+                 one trellis step
 
-        // Samples to symbols
-        (*phy_struct)->s2s_in                 = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*(*phy_struct)->N_samps_per_symb*2*20);
-        (*phy_struct)->s2s_out                = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*(*phy_struct)->N_samps_per_symb*2*20);
-        (*phy_struct)->symbs_to_samps_dl_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb,
-                                                                  (*phy_struct)->s2s_in,
-                                                                  (*phy_struct)->s2s_out,
-                                                                  FFTW_BACKWARD,
-                                                                  FFTW_MEASURE);
-        (*phy_struct)->samps_to_symbs_dl_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb,
-                                                                  (*phy_struct)->s2s_in,
-                                                                  (*phy_struct)->s2s_out,
-                                                                  FFTW_FORWARD,
-                                                                  FFTW_MEASURE);
-        (*phy_struct)->symbs_to_samps_ul_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb*2,
-                                                                  (*phy_struct)->s2s_in,
-                                                                  (*phy_struct)->s2s_out,
-                                                                  FFTW_BACKWARD,
-                                                                  FFTW_MEASURE);
-        (*phy_struct)->samps_to_symbs_ul_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb*2,
-                                                                  (*phy_struct)->s2s_in,
-                                                                  (*phy_struct)->s2s_out,
-                                                                  FFTW_FORWARD,
-                                                                  FFTW_MEASURE);
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+int16 turbo_trellis_extrinsic(int16 *alpha,
+                              int16 *beta,
+                              int32  L_par);
 
-        err = LIBLTE_SUCCESS;
-    }
+/*********************************************************************
+    Name: turbo_extrinsic_clamp
 
-    return(err);
-}
-LIBLTE_ERROR_ENUM liblte_phy_ul_init(LIBLTE_PHY_STRUCT *phy_struct,
-                                     uint16             N_id_cell,
-                                     uint32             prach_root_seq_idx,
-                                     uint32             prach_preamble_format,
-                                     uint32             prach_zczc,
-                                     bool               prach_hs_flag,
-                                     uint8              group_assignment_pusch,
-                                     bool               group_hopping_enabled,
-                                     bool               sequence_hopping_enabled,
-                                     uint8              cyclic_shift,
-                                     uint8              cyclic_shift_dci,
-                                     uint8              N_cs_an,
-                                     uint8              delta_pucch_shift)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
+    Description: Converts the best path metrics for systematic bits
+                 of 0 and 1 into a clamped extrinsic value
 
-    if(phy_struct != NULL)
-    {
-        // PUSCH
-        phy_struct->transform_precoding_in  = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL);
-        phy_struct->transform_precoding_out = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*LIBLTE_PHY_N_RB_UL_MAX*LIBLTE_PHY_N_SC_RB_UL);
-        for(i=0; i<phy_struct->N_rb_ul; i++)
-        {
-            if((i % 2) == 0 ||
-               (i % 3) == 0 ||
-               (i % 5) == 0)
-            {
-                phy_struct->transform_precoding_plan[i]    = fftwf_plan_dft_1d(i*LIBLTE_PHY_N_SC_RB_UL,
-                                                                               phy_struct->transform_precoding_in,
-                                                                               phy_struct->transform_precoding_out,
-                                                                               FFTW_FORWARD,
-                                                                               FFTW_MEASURE);
-                phy_struct->transform_pre_decoding_plan[i] = fftwf_plan_dft_1d(i*LIBLTE_PHY_N_SC_RB_UL,
-                                                                               phy_struct->transform_precoding_in,
-                                                                               phy_struct->transform_precoding_out,
-                                                                               FFTW_BACKWARD,
-                                                                               FFTW_MEASURE);
-            }
-        }
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+int16 turbo_extrinsic_clamp(int32 max_0,
+                            int32 max_1);
 
-        // PUSCH DMRS
-        for(i=0; i<LIBLTE_PHY_N_SUBFR_PER_FRAME; i++)
-        {
-            for(j=0; j<LIBLTE_PHY_N_RB_UL_MAX; j++)
-            {
-                generate_dmrs_pusch(phy_struct,
-                                    i,
-                                    N_id_cell,
-                                    group_assignment_pusch,
-                                    cyclic_shift,
-                                    cyclic_shift_dci,
-                                    j,
-                                    0,
-                                    group_hopping_enabled,
-                                    sequence_hopping_enabled,
-                                    phy_struct->pusch_dmrs_0_re[i][j],
-                                    phy_struct->pusch_dmrs_0_im[i][j],
-                                    phy_struct->pusch_dmrs_1_re[i][j],
-                                    phy_struct->pusch_dmrs_1_im[i][j]);
-            }
-        }
+#if defined(__x86_64__) || defined(__i386__)
+/*********************************************************************
+    Name: turbo_trellis_forward_step_sse4_1
 
-        // PUCCH DMRS
-        for(i=0; i<LIBLTE_PHY_N_SUBFR_PER_FRAME; i++)
-        {
-            for(j=0; j<LIBLTE_PHY_N_RB_UL_MAX/2; j++)
-            {
-                generate_dmrs_pucch(phy_struct,
-                                    i,
-                                    N_id_cell,
-                                    group_assignment_pusch,
-                                    group_hopping_enabled,
-                                    sequence_hopping_enabled,
-                                    N_cs_an,
-                                    j,
-                                    delta_pucch_shift+1,
-                                    phy_struct->N_ant,
-                                    phy_struct->pucch_dmrs_0_re[i][j],
-                                    phy_struct->pucch_dmrs_0_im[i][j],
-                                    phy_struct->pucch_dmrs_1_re[i][j],
-                                    phy_struct->pucch_dmrs_1_im[i][j]);
-            }
-        }
+    Description: SSE4.1 version of turbo_trellis_forward_step, all 8
+                 trellis states are held in one vector
 
-        // PRACH
-        prach_preamble_seq_gen(phy_struct,
-                               prach_root_seq_idx,
-                               prach_preamble_format,
-                               prach_zczc,
-                               prach_hs_flag);
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+__attribute__((target("sse4.1")))
+void turbo_trellis_forward_step_sse4_1(int16 *alpha,
+                                       int32  L_sys,
+                                       int32  L_par,
+                                       bool   tail,
+                                       int16 *alpha_next);
 
-        switch(prach_preamble_format)
-        {
-        case 0:
-            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_seq      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_cp       = 3168/(30720000/phy_struct->fs);
-            phy_struct->prach_delta_f_RA = 1250;
-            phy_struct->prach_phi        = 7;
-            break;
-        case 1:
-            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_seq      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_cp       = 21024/(30720000/phy_struct->fs);
-            phy_struct->prach_delta_f_RA = 1250;
-            phy_struct->prach_phi        = 7;
-            break;
-        case 2:
-            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_seq      = 2*24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_cp       = 6240/(30720000/phy_struct->fs);
-            phy_struct->prach_delta_f_RA = 1250;
-            phy_struct->prach_phi        = 7;
-            break;
-        case 3:
-            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_seq      = 2*24576/(30720000/phy_struct->fs);
-            phy_struct->prach_T_cp       = 21024/(30720000/phy_struct->fs);
-            phy_struct->prach_delta_f_RA = 1250;
-            phy_struct->prach_phi        = 7;
-            break;
-        case 4:
-        default:
-            phy_struct->prach_T_fft      = 4096/(30720000/phy_struct->fs);
-            phy_struct->prach_T_seq      = 4096/(30720000/phy_struct->fs);
-            phy_struct->prach_T_cp       = 448/(30720000/phy_struct->fs);
-            phy_struct->prach_delta_f_RA = 7500;
-            phy_struct->prach_phi        = 2;
-            break;
-        }
-        phy_struct->prach_dft_in    = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_N_zc);
-        phy_struct->prach_dft_out   = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_N_zc);
-        phy_struct->prach_fft_in    = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_T_fft);
-        phy_struct->prach_fft_out   = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_T_fft);
-        phy_struct->prach_dft_plan  = fftwf_plan_dft_1d(phy_struct->prach_N_zc,
-                                                        phy_struct->prach_dft_in,
-                                                        phy_struct->prach_dft_out,
-                                                        FFTW_FORWARD,
-                                                        FFTW_MEASURE);
-        phy_struct->prach_ifft_plan = fftwf_plan_dft_1d(phy_struct->prach_T_fft,
-                                                        phy_struct->prach_fft_in,
-                                                        phy_struct->prach_fft_out,
-                                                        FFTW_BACKWARD,
-                                                        FFTW_MEASURE);
-        phy_struct->prach_fft_plan  = fftwf_plan_dft_1d(phy_struct->prach_T_fft,
-                                                        phy_struct->prach_fft_in,
-                                                        phy_struct->prach_fft_out,
-                                                        FFTW_FORWARD,
-                                                        FFTW_MEASURE);
-        phy_struct->prach_idft_plan = fftwf_plan_dft_1d(phy_struct->prach_N_zc,
-                                                        phy_struct->prach_dft_in,
-                                                        phy_struct->prach_dft_out,
-                                                        FFTW_BACKWARD,
-                                                        FFTW_MEASURE);
-        for(i=0; i<phy_struct->prach_N_x_u; i++)
-        {
-            for(j=0; j<phy_struct->prach_N_zc; j++)
-            {
-                phy_struct->prach_dft_in[j][0] = phy_struct->prach_x_u_re[i][j];
-                phy_struct->prach_dft_in[j][1] = phy_struct->prach_x_u_im[i][j];
-            }
-            fftwf_execute(phy_struct->prach_dft_plan);
-            for(j=0; j<phy_struct->prach_N_zc; j++)
-            {
-                phy_struct->prach_x_u_fft_re[i][j] = phy_struct->prach_dft_out[j][0];
-                phy_struct->prach_x_u_fft_im[i][j] = phy_struct->prach_dft_out[j][1];
-            }
-        }
-
-        // Generic
-        phy_struct->ul_init = true;
+/*********************************************************************
+    Name: turbo_trellis_backward_step_sse4_1
 
-        err = LIBLTE_SUCCESS;
-    }
+    Description: SSE4.1 version of turbo_trellis_backward_step, all 8
+                 trellis states are held in one vector
 
-    return(err);
-}
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+__attribute__((target("sse4.1")))
+void turbo_trellis_backward_step_sse4_1(int16 *beta,
+                                        int32  L_sys,
+                                        int32  L_par,
+                                        bool   tail,
+                                        int16 *beta_prev);
 
 /*********************************************************************
-    Name: liblte_phy_cleanup
+    Name: turbo_trellis_extrinsic_sse4_1
 
-    Description: Cleans up the LTE Physical Layer library.
+    Description: SSE4.1 version of turbo_trellis_extrinsic
 
     Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_cleanup(LIBLTE_PHY_STRUCT *phy_struct)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+// Defines
+// Enums
+// Structs
+// Functions
+__attribute__((target("sse4.1")))
+int16 turbo_trellis_extrinsic_sse4_1(int16 *alpha,
+                                     int16 *beta,
+                                     int32  L_par);
 
-    if(phy_struct != NULL)
-    {
-        // Samples to symbols
-        fftwf_destroy_plan(phy_struct->samps_to_symbs_dl_plan);
-        fftwf_destroy_plan(phy_struct->symbs_to_samps_dl_plan);
-        fftwf_destroy_plan(phy_struct->samps_to_symbs_ul_plan);
-        fftwf_destroy_plan(phy_struct->symbs_to_samps_ul_plan);
-        fftwf_free(phy_struct->s2s_in);
-        fftwf_free(phy_struct->s2s_out);
+/*********************************************************************
+    Name: turbo_trellis_forward_step_avx2
 
-        free(phy_struct);
-        err = LIBLTE_SUCCESS;
-    }
+    Description: AVX2 version of turbo_trellis_forward_step, both
+                 branches into each of the 8 trellis states are held
+                 in one vector
 
-    return(err);
-}
-LIBLTE_ERROR_ENUM liblte_phy_ul_cleanup(LIBLTE_PHY_STRUCT *phy_struct)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+__attribute__((target("avx2")))
+void turbo_trellis_forward_step_avx2(int16 *alpha,
+                                     int32  L_sys,
+                                     int32  L_par,
+                                     bool   tail,
+                                     int16 *alpha_next);
 
-    if(phy_struct != NULL &&
-       phy_struct->ul_init)
-    {
-        // PRACH
-        fftwf_destroy_plan(phy_struct->prach_idft_plan);
-        fftwf_destroy_plan(phy_struct->prach_fft_plan);
-        fftwf_destroy_plan(phy_struct->prach_ifft_plan);
-        fftwf_destroy_plan(phy_struct->prach_dft_plan);
-        fftwf_free(phy_struct->prach_dft_in);
-        fftwf_free(phy_struct->prach_dft_out);
-        fftwf_free(phy_struct->prach_fft_in);
-        fftwf_free(phy_struct->prach_fft_out);
+/*********************************************************************
+    Name: turbo_trellis_backward_step_avx2
 
-        // PUSCH
-        for(i=0; i<phy_struct->N_rb_ul; i++)
-        {
-            if((i % 2) == 0 ||
-               (i % 3) == 0 ||
-               (i % 5) == 0)
-            {
-                fftwf_destroy_plan(phy_struct->transform_precoding_plan[i]);
-                fftwf_destroy_plan(phy_struct->transform_pre_decoding_plan[i]);
-            }
-        }
-        fftwf_free(phy_struct->transform_precoding_in);
-        fftwf_free(phy_struct->transform_precoding_out);
+    Description: AVX2 version of turbo_trellis_backward_step, both
+                 branches out of each of the 8 trellis states are held
+                 in one vector
 
-        // Generic
-        phy_struct->ul_init = false;
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+__attribute__((target("avx2")))
+void turbo_trellis_backward_step_avx2(int16 *beta,
+                                      int32  L_sys,
+                                      int32  L_par,
+                                      bool   tail,
+                                      int16 *beta_prev);
 
-        err = LIBLTE_SUCCESS;
-    }
+/*********************************************************************
+    Name: turbo_trellis_extrinsic_avx2
 
-    return(err);
-}
+    Description: AVX2 version of turbo_trellis_extrinsic
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+__attribute__((target("avx2")))
+int16 turbo_trellis_extrinsic_avx2(int16 *alpha,
+                                   int16 *beta,
+                                   int32  L_par);
 
 /*********************************************************************
-    Name: liblte_phy_update_n_rb_dl
+    Name: turbo_trellis_dual_step_avx2
 
-    Description: Updates N_rb_dl and all associated variables.
+    Description: Performs one step of the forward state metric
+                 recursion and one independent step of the backward
+                 state metric recursion, neither of which may be in
+                 the trellis termination
 
     Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_update_n_rb_dl(LIBLTE_PHY_STRUCT *phy_struct,
-                                            uint32             N_rb_dl)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            used_subcarriers;
+// Defines
+// Enums
+// Structs
+// Functions
+__attribute__((target("avx2")))
+void turbo_trellis_dual_step_avx2(int16 *alpha,
+                                  int32  L_sys_f,
+                                  int32  L_par_f,
+                                  int16 *alpha_next,
+                                  int16 *beta,
+                                  int32  L_sys_b,
+                                  int32  L_par_b,
+                                  int16 *beta_prev);
 
-    if(phy_struct != NULL)
-    {
-        used_subcarriers = N_rb_dl*phy_struct->N_sc_rb_dl;
-        switch(phy_struct->N_samps_per_symb)
-        {
-        case LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ:
-            phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_30_72MHZ;
-            err                  = LIBLTE_SUCCESS;
-            break;
-        case LIBLTE_PHY_N_SAMPS_PER_SYMB_15_36MHZ:
-            if(LIBLTE_PHY_N_RB_DL_10MHZ  == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_5MHZ   == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
-            {
-                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_15_36MHZ;
-                err                  = LIBLTE_SUCCESS;
-            }
-            break;
-        case LIBLTE_PHY_N_SAMPS_PER_SYMB_7_68MHZ:
-            if(LIBLTE_PHY_N_RB_DL_5MHZ   == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
-            {
-                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_7_68MHZ;
-                err                  = LIBLTE_SUCCESS;
-            }
-            break;
-        case LIBLTE_PHY_N_SAMPS_PER_SYMB_3_84MHZ:
-            if(LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
-               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
-            {
-                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_3_84MHZ;
-                err                  = LIBLTE_SUCCESS;
-            }
-            break;
-        case LIBLTE_PHY_N_SAMPS_PER_SYMB_1_92MHZ:
-            if(LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
-            {
-                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_1_92MHZ;
-                err                  = LIBLTE_SUCCESS;
-            }
-            break;
-        }
+/*********************************************************************
+    Name: turbo_metric_normalize_sse4_1
 
-        if(LIBLTE_SUCCESS == err)
-        {
-            phy_struct->N_rb_dl      = N_rb_dl;
-            phy_struct->N_rb_ul      = N_rb_dl;
-            phy_struct->FFT_pad_size = (phy_struct->FFT_size - used_subcarriers)/2;
-        }
-    }
+    Description: Normalizes a vector of state metrics to state 0 and
+                 saturates them to the metric range
 
-    return(err);
-}
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+__attribute__((target("sse4.1")))
+__m128i turbo_metric_normalize_sse4_1(__m128i metric);
 
 /*********************************************************************
-    Name: liblte_phy_pusch_channel_encode
+    Name: turbo_hmax_sse4_1
 
-    Description: Encodes and modulates the Physical Uplink Shared
-                 Channel
+    Description: Finds the maximum of 8 signed 16 bit values
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+__attribute__((target("sse4.1")))
+int32 turbo_hmax_sse4_1(__m128i in);
+#endif
 
-    Notes: Only handling normal CP and N_ant=1
+/*********************************************************************
+    Name: fftw_wisdom_file_name
+
+    Description: Returns the process wide FFTW wisdom file name, empty
+                 when no wisdom file is set
+
+    Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_encode(LIBLTE_PHY_STRUCT            *phy_struct,
-                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
-                                                  uint32                        N_id_cell,
-                                                  uint8                         N_ant,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            p;
-    uint32            L;
-    uint32            idx;
-    uint32            c_init;
-    uint32            N_bits;
-    uint32            M_symb;
-    uint32            M_layer_symb;
-    uint32            M_ap_symb;
-    uint32            M_pusch_sc = alloc->N_prb*phy_struct->N_sc_rb_ul;
-    uint32            Q_m;
-    uint32            N_ul_symb = 7; // FIXME: Only handling normal CP
+// Defines
+// Enums
+// Structs
+// Functions
+char* fftw_wisdom_file_name(void);
 
-    if(phy_struct != NULL &&
-       alloc      != NULL &&
-       subframe   != NULL)
-    {
-        // Determine Q_m
-        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
-        {
-            Q_m = 1;
-        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
-            Q_m = 2;
-        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
-            Q_m = 4;
-        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
-            Q_m = 6;
-        }
-
-        // Encode the PUSCH
-        ulsch_channel_encode(phy_struct,
-                             alloc->msg[0].msg,
-                             alloc->msg[0].N_bits,
-                             alloc->tbs,
-                             alloc->tx_mode,
-                             alloc->N_prb*phy_struct->N_sc_rb_ul*(N_ul_symb-1)*2,
-                             alloc->N_layers,
-                             Q_m,
-                             alloc->rv_idx,
-                             phy_struct->pusch_encode_bits,
-                             &N_bits);
-        // FIXME: Only handling 1 codeword
-        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
-        generate_prs_c(c_init, N_bits, phy_struct->pusch_c);
-        for(i=0; i<N_bits; i++)
-        {
-            phy_struct->pusch_scramb_bits[i] = phy_struct->pusch_encode_bits[i] ^ phy_struct->pusch_c[i];
-        }
-        modulation_mapper(phy_struct->pusch_scramb_bits,
-                          N_bits,
-                          alloc->mod_type,
-                          phy_struct->pusch_d_re,
-                          phy_struct->pusch_d_im,
-                          &M_symb);
-        layer_mapper_ul(phy_struct->pusch_d_re,
-                        phy_struct->pusch_d_im,
-                        M_symb,
-                        N_ant,
-                        alloc->N_codewords,
-                        phy_struct->pusch_x_re,
-                        phy_struct->pusch_x_im,
-                        &M_layer_symb);
-        transform_precoding(phy_struct,
-                            phy_struct->pusch_x_re,
-                            phy_struct->pusch_x_im,
-                            M_layer_symb,
-                            alloc->N_prb,
-                            N_ant,
-                            alloc->N_codewords,
-                            phy_struct->pusch_y_re,
-                            phy_struct->pusch_y_im);
-        pre_coder_ul(phy_struct->pusch_y_re,
-                     phy_struct->pusch_y_im,
-                     M_layer_symb,
-                     N_ant,
-                     alloc->N_layers,
-                     phy_struct->pusch_z_re[0],
-                     phy_struct->pusch_z_im[0],
-                     &M_ap_symb);
-
-        // Map to physical resources
-        for(p=0; p<N_ant; p++)
-        {
-            idx = 0;
-            for(L=0; L<14; L++)
-            {
-                if(3 == L)
-                {
-                    // DMRS 0
-                    for(j=0; j<M_pusch_sc; j++)
-                    {
-                        subframe->tx_symb_re[p][L][j] = phy_struct->pusch_dmrs_0_re[subframe->num][alloc->N_prb][j];
-                        subframe->tx_symb_im[p][L][j] = phy_struct->pusch_dmrs_0_im[subframe->num][alloc->N_prb][j];
-                    }
-                }else if(10 == L){
-                    // DMRS 1
-                    for(j=0; j<M_pusch_sc; j++)
-                    {
-                        subframe->tx_symb_re[p][L][j] = phy_struct->pusch_dmrs_1_re[subframe->num][alloc->N_prb][j];
-                        subframe->tx_symb_im[p][L][j] = phy_struct->pusch_dmrs_1_im[subframe->num][alloc->N_prb][j];
-                    }
-                }else{
-                    // PUSCH
-                    for(j=0; j<M_pusch_sc; j++)
-                    {
-                        subframe->tx_symb_re[p][L][j] = phy_struct->pusch_z_re[p][idx];
-                        subframe->tx_symb_im[p][L][j] = phy_struct->pusch_z_im[p][idx];
-                        idx++;
-                    }
-                }
-            }
-        }
+/*********************************************************************
+    Name: fftw_wisdom_save
 
-        err = LIBLTE_SUCCESS;
-    }
+    Description: Saves the accumulated FFTW wisdom to the wisdom file
 
-    return(err);
-}
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void fftw_wisdom_save(void);
 
 /*********************************************************************
-    Name: liblte_phy_pusch_channel_decode
-
-    Description: Demodulates and decodes the Physical Uplink Shared
-                 Channel
+    Name: phy_huge_pages
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+    Description: Returns the process wide huge page selection
 
-    Notes: Only handles normal CP
+    Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT            *phy_struct,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
-                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
-                                                  uint32                        N_id_cell,
-                                                  uint8                         N_ant,
-                                                  uint8                        *out_bits,
-                                                  uint32                       *N_out_bits)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            L;
-    uint32            prb_idx;
-    uint32            z_idx;
-    uint32            c_idx_0;
-    uint32            c_idx_1;
-    uint32            M_layer_symb;
-    uint32            M_symb;
-    uint32            N_bits;
-    uint32            c_init;
-    uint32            Q_m;
+// Defines
+// Enums
+// Structs
+// Functions
+bool* phy_huge_pages(void);
 
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       alloc      != NULL &&
-       out_bits   != NULL &&
-       N_out_bits != NULL &&
-       phy_struct->ul_init)
-    {
-        // FIXME: Timing
+/*********************************************************************
+    Name: phy_mem_alloc
 
-        // Extract resource elements and construct channel estimate
-        z_idx   = 0;
-        c_idx_0 = 0;
-        c_idx_1 = 0;
-        for(L=0; L<14; L++)
-        {
-            for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
-            {
-                i = alloc->prb[L/7][prb_idx];
-                for(j=0; j<phy_struct->N_sc_rb_ul; j++)
-                {
-                    if(3 == L)
-                    {
-                        phy_struct->pusch_c_est_0_re[c_idx_0] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_ul+j];
-                        phy_struct->pusch_c_est_0_im[c_idx_0] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_ul+j];
-                        c_idx_0++;
-                    }else if(10 == L){
-                        phy_struct->pusch_c_est_1_re[c_idx_1] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_ul+j];
-                        phy_struct->pusch_c_est_1_im[c_idx_1] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_ul+j];
-                        c_idx_1++;
-                    }else{
-                        phy_struct->pusch_z_est_re[z_idx] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_ul+j];
-                        phy_struct->pusch_z_est_im[z_idx] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_ul+j];
-                        z_idx++;
-                    }
-                }
-            }
-        }
-        get_ulsch_ce(phy_struct,
-                     phy_struct->pusch_c_est_0_re,
-                     phy_struct->pusch_c_est_0_im,
-                     phy_struct->pusch_c_est_1_re,
-                     phy_struct->pusch_c_est_1_im,
-                     alloc->N_prb,
-                     subframe->num,
-                     phy_struct->pusch_c_est_re,
-                     phy_struct->pusch_c_est_im);
-        pre_decoder_and_matched_filter_ul(phy_struct->pusch_z_est_re,
-                                          phy_struct->pusch_z_est_im,
-                                          phy_struct->pusch_c_est_re,
-                                          phy_struct->pusch_c_est_im,
-                                          z_idx,
-                                          N_ant,
-                                          alloc->N_layers,
-                                          phy_struct->pusch_y_re,
-                                          phy_struct->pusch_y_im,
-                                          &M_layer_symb);
-        transform_pre_decoding(phy_struct,
-                               phy_struct->pusch_y_re,
-                               phy_struct->pusch_y_im,
-                               M_layer_symb,
-                               alloc->N_prb,
-                               N_ant,
-                               alloc->N_codewords,
-                               phy_struct->pusch_x_re,
-                               phy_struct->pusch_x_im);
-        layer_demapper_ul(phy_struct->pusch_x_re,
-                          phy_struct->pusch_x_im,
-                          M_layer_symb,
-                          N_ant,
-                          alloc->N_codewords,
-                          phy_struct->pusch_d_re,
-                          phy_struct->pusch_d_im,
-                          &M_symb);
-        modulation_demapper(phy_struct->pusch_d_re,
-                            phy_struct->pusch_d_im,
-                            M_symb,
-                            alloc->mod_type,
-                            phy_struct->pusch_soft_bits,
-                            &N_bits);
-        // FIXME: Only handling 1 codewords
-        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
-        generate_prs_c(c_init, N_bits, phy_struct->pusch_c);
-        for(i=0; i<N_bits; i++)
-        {
-            phy_struct->pusch_descramb_bits[i] = (float)phy_struct->pusch_soft_bits[i]*(1-2*(float)phy_struct->pusch_c[i]);
-        }
-        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
-        {
-            Q_m = 1;
-        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
-            Q_m = 2;
-        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
-            Q_m = 4;
-        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
-            Q_m = 6;
-        }
-        if(LIBLTE_SUCCESS == ulsch_channel_decode(phy_struct,
-                                                  phy_struct->pusch_descramb_bits,
-                                                  N_bits,
-                                                  alloc->tbs,
-                                                  alloc->tx_mode,
-                                                  alloc->N_layers,
-                                                  Q_m,
-                                                  alloc->rv_idx,
-                                                  out_bits,
-                                                  N_out_bits))
-        {
-            err = LIBLTE_SUCCESS;
-        }
-    }
+    Description: Allocates LIBLTE_PHY_MEM_ALIGN aligned memory, from
+                 huge pages if selected
 
-    return(err);
-}
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void* phy_mem_alloc(uint32  size,
+                    bool   *huge_pages);
 
 /*********************************************************************
-    Name: liblte_phy_pucch_format_1_1a_1b_channel_encode
-
-    Description: Encodes and modulates the Physical Uplink Control
-                 Channel for formats 1, 1a, and 1b
+    Name: phy_mem_free
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4.1
-                        3GPP TS 36.212 v10.1.0 section 5.2.3
+    Description: Frees memory allocated by phy_mem_alloc
 
-    Notes: Only handling normal CP and N_ant=1
+    Document Reference: N/A
 *********************************************************************/
-// FIXME
+// Defines
+// Enums
+// Structs
+// Functions
+void phy_mem_free(void   *ptr,
+                  uint32  size,
+                  bool    huge_pages);
 
 /*********************************************************************
-    Name: liblte_phy_pucch_format_1_1a_1b_channel_decode
+    Name: phy_arena_init
 
-    Description: Demodulates and decodes the Physical Uplink Control
-                 Channel for formats 1, 1a, and 1b
+    Description: Allocates an arena of size bytes, which is then
+                 handed out in aligned pieces by phy_arena_get
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4.1
-                        3GPP TS 36.212 v10.1.0 section 5.2.3
-
-    Notes: Only handling normal CP and N_ant=1
+    Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pucch_format_1_1a_1b_channel_decode(LIBLTE_PHY_STRUCT            *phy_struct,
-                                                                 LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
-                                                                 LIBLTE_PHY_PUCCH_FORMAT_ENUM  format,
-                                                                 uint32                        N_id_cell,
-                                                                 uint8                         N_ant,
-                                                                 uint32                        N_1_p_pucch,
-                                                                 uint8                        *out_bits,
-                                                                 uint32                       *N_out_bits)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            m_prime;
-    uint32            i;
-    uint32            j;
-    uint32            L;
-    uint32            z_idx;
-    uint32            c_idx_0;
-    uint32            c_idx_1;
-    uint32            M_layer_symb;
-    uint32            idx;
-    uint32            symb_num;
-    uint32            N_pucch_sf = 4;
-    float             s_ns_re[2];
-    float             s_ns_im[2];
-    float             s_w_re;
-    float             s_w_im;
-    float             s_w_r_re;
-    float             s_w_r_im;
-    float             denom;
-    float             d_re;
-    float             d_im;
-    float             sd;
-    float             r_u_v_re;
-    float             r_u_v_im;
-    float             ang;
+// Defines
+// Enums
+// Structs
+// Functions
+void phy_arena_init(LIBLTE_PHY_ARENA_STRUCT *arena,
+                    uint32                   size);
 
-    if(phy_struct != NULL                        &&
-       subframe   != NULL                        &&
-       (format    == LIBLTE_PHY_PUCCH_FORMAT_1   ||
-        format    == LIBLTE_PHY_PUCCH_FORMAT_1A  ||
-        format    == LIBLTE_PHY_PUCCH_FORMAT_1B) &&
-       out_bits   != NULL                        &&
-       N_out_bits != NULL)
-    {
-        // Extract resource elements and construct channel estimate
-        z_idx   = 0;
-        c_idx_0 = 0;
-        c_idx_1 = 0;
-        for(L=0; L<14; L++)
-        {
-            if(7 > L)
-            {
-                i = N_1_p_pucch;
-            }else{
-                i = phy_struct->N_rb_ul - N_1_p_pucch - 1;
-            }
-            for(j=0; j<phy_struct->N_sc_rb_ul; j++)
-            {
-                if(2 == L || 3 == L || 4 == L)
-                {
-                    phy_struct->pucch_c_est_0_re[c_idx_0] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_ul+j];
-                    phy_struct->pucch_c_est_0_im[c_idx_0] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_ul+j];
-                    c_idx_0++;
-                }else if(9 == L || 10 == L || 11 == L){
-                    phy_struct->pucch_c_est_1_re[c_idx_1] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_ul+j];
-                    phy_struct->pucch_c_est_1_im[c_idx_1] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_ul+j];
-                    c_idx_1++;
-                }else{
-                    phy_struct->pucch_z_est_re[z_idx] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_ul+j];
-                    phy_struct->pucch_z_est_im[z_idx] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_ul+j];
-                    z_idx++;
-                }
-            }
-        }
+/*********************************************************************
+    Name: phy_arena_get
 
-        // Recover z using the channel estimate
-        get_ulcch_ce(phy_struct,
-                     phy_struct->pucch_c_est_0_re,
-                     phy_struct->pucch_c_est_0_im,
-                     phy_struct->pucch_c_est_1_re,
-                     phy_struct->pucch_c_est_1_im,
-                     subframe->num,
-                     N_1_p_pucch,
-                     phy_struct->pucch_c_est_re,
-                     phy_struct->pucch_c_est_im);
-        pre_decoder_and_matched_filter_ul(phy_struct->pucch_z_est_re,
-                                          phy_struct->pucch_z_est_im,
-                                          phy_struct->pucch_c_est_re,
-                                          phy_struct->pucch_c_est_im,
-                                          z_idx,
-                                          N_ant,
-                                          1,
-                                          phy_struct->pucch_z_re[0],
-                                          phy_struct->pucch_z_im[0],
-                                          &M_layer_symb);
+    Description: Returns the next LIBLTE_PHY_MEM_ALIGN aligned piece
+                 of an arena
 
-        // Calculate s_ns
-        for(m_prime=0; m_prime<2; m_prime++)
-        {
-            if((phy_struct->pucch_n_prime_p[subframe->num][N_1_p_pucch][m_prime] % 2) == 0)
-            {
-                s_ns_re[m_prime] = 1;
-                s_ns_im[m_prime] = 0;
-            }else{
-                s_ns_re[m_prime] = cos(M_PI/2);
-                s_ns_im[m_prime] = sin(M_PI/2);
-            }
-        }
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+#define PHY_ARENA_ROUND(size) (((size) + LIBLTE_PHY_MEM_ALIGN - 1) & ~(LIBLTE_PHY_MEM_ALIGN - 1))
+// Enums
+// Structs
+// Functions
+void* phy_arena_get(LIBLTE_PHY_ARENA_STRUCT *arena,
+                    uint32                   size);
 
-        // Recover the bit that was sent
-        d_re = 0;
-        d_im = 0;
-        for(m_prime=0; m_prime<2; m_prime++)
-        {
-            for(i=0; i<N_pucch_sf; i++)
-            {
-                symb_num = i;
-                if(1 < symb_num)
-                {
-                    symb_num += 3;
-                }
-                s_w_re = s_ns_re[m_prime]*W_5_4_1_2[phy_struct->pucch_n_oc_p[subframe->num][N_1_p_pucch][m_prime]][i];
-                s_w_im = s_ns_im[m_prime]*W_5_4_1_2[phy_struct->pucch_n_oc_p[subframe->num][N_1_p_pucch][m_prime]][i];
-                for(j=0; j<LIBLTE_PHY_N_SC_RB_UL; j++)
-                {
-                    r_u_v_re  = phy_struct->pucch_r_u_v_alpha_p_re[subframe->num][N_1_p_pucch][m_prime][symb_num][j];
-                    r_u_v_im  = phy_struct->pucch_r_u_v_alpha_p_im[subframe->num][N_1_p_pucch][m_prime][symb_num][j];
-                    s_w_r_re  = s_w_re*r_u_v_re - s_w_im*r_u_v_im;
-                    s_w_r_im  = s_w_re*r_u_v_im + s_w_im*r_u_v_re;
-                    idx       = m_prime*N_pucch_sf*LIBLTE_PHY_N_SC_RB_UL + i*LIBLTE_PHY_N_SC_RB_UL + j;
-                    denom     = s_w_r_re*s_w_r_re + s_w_r_im*s_w_r_im;
-                    d_re     += (1/denom)*(phy_struct->pucch_z_re[0][idx]*s_w_r_re + phy_struct->pucch_z_im[0][idx]*s_w_r_im);
-                    d_im     += (1/denom)*(-phy_struct->pucch_z_re[0][idx]*s_w_r_im + phy_struct->pucch_z_im[0][idx]*s_w_r_re);
-                }
-            }
-        }
-        d_re /= idx;
-        d_im /= idx;
-        d_re *= sqrt(N_ant);
-        d_im *= sqrt(N_ant);
+/*********************************************************************
+    Name: phy_arena_free
 
-        // Quantify the bits that were sent
-        if(format == LIBLTE_PHY_PUCCH_FORMAT_1 ||
-           format == LIBLTE_PHY_PUCCH_FORMAT_1A)
-        {
-            if(d_re < 0)
-            {
-                sd = get_soft_decision(d_re, d_im, -1, 0, 1);
-                out_bits[0] = 1;
-            }else{
-                sd = get_soft_decision(d_re, d_im, 1, 0, 1);
-                out_bits[0] = 0;
-            }
-            *N_out_bits = 1;
-            if(sd > 0.5)
-            {
-                err = LIBLTE_SUCCESS;
-            }
-        }else{
-            ang = atan2f(d_im, d_re);
-            if((ang >= M_PI/4) && (ang < 3*M_PI/4))
-            {
-                sd = get_soft_decision(d_re, d_im, 0, 1, 1);
-                out_bits[0] = 1;
-                out_bits[1] = 0;
-            }else if((ang >= -M_PI/4) && (ang < M_PI/4)){
-                sd = get_soft_decision(d_re, d_im, 1, 0, 1);
-                out_bits[0] = 0;
-                out_bits[1] = 0;
-            }else if((ang >= -3*M_PI/4) && (ang < -M_PI/4)){
-                sd = get_soft_decision(d_re, d_im, 0, -1, 1);
-                out_bits[0] = 0;
-                out_bits[1] = 1;
-            }else{
-                sd = get_soft_decision(d_re, d_im, -1, 0, 1);
-                out_bits[0] = 1;
-                out_bits[1] = 1;
-            }
-            *N_out_bits = 2;
-            if(sd > 0.5)
-            {
-                err = LIBLTE_SUCCESS;
-            }
-        }
-    }
+    Description: Frees an arena
 
-    return(err);
-}
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void phy_arena_free(LIBLTE_PHY_ARENA_STRUCT *arena);
 
 /*********************************************************************
-    Name: liblte_phy_pucch_format_2_2a_2b_channel_encode
-
-    Description: Encodes and modulates the Physical Uplink Control
-                 Channel for formats 2, 2a, and 2b
+    Name: turbo_kernel_detect
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4.2
-                        3GPP TS 36.212 v10.1.0 section 5.2.3
+    Description: Determines the fastest turbo decoder trellis kernel
+                 supported by the CPU
 
-    Notes: Only handling normal CP and N_ant=1
+    Document Reference: N/A
 *********************************************************************/
-// FIXME
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_PHY_TURBO_KERNEL_ENUM turbo_kernel_detect(void);
 
 /*********************************************************************
-    Name: liblte_phy_pucch_format_2_2a_2b_channel_decode
+    Name: turbo_internal_interleaver_pre_calc
 
-    Description: Demodulates and decodes the Physical Uplink Control
-                 Channel for formats 2, 2a, and 2b
+    Description: Calculates the internal interleaver permutation for
+                 the LTE Parallel Concatenated Convolutional Code
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4.2
-                        3GPP TS 36.212 v10.1.0 section 5.2.3
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_internal_interleaver_pre_calc(uint32  K,
+                                         uint16 *pi);
 
-    Notes: Only handling normal CP and N_ant=1
+/*********************************************************************
+    Name: turbo_constituent_encoder
+
+    Description: Constituent encoder for the LTE Parallel Concatenated
+                 Convolutional Code
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
-// FIXME
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_constituent_encoder(uint8  *in_bits,
+                               uint32  N_in_bits,
+                               uint8  *out_bits,
+                               uint8  *fb_bits);
 
 /*********************************************************************
-    Name: liblte_phy_pucch_map_sr_config_idx
+    Name: turbo_internal_interleaver
 
-    Description: Maps SR configuration index to SR periodicity and
-                 SR subframe offset
+    Description: Internal interleaver for the LTE Parallel
+                 Concatenated Convolutional Code
 
-    Document Reference: 3GPP TS 36.213 v10.3.0 table 10.1.5-1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
-void liblte_phy_pucch_map_sr_config_idx(uint32  i_sr,
-                                        uint32 *sr_periodicity,
-                                        uint32 *N_offset_sr)
-{
-    if(i_sr < 5)
-    {
-        *sr_periodicity = 5;
-        *N_offset_sr    = i_sr;
-    }else if(i_sr < 15){
-        *sr_periodicity = 10;
-        *N_offset_sr    = i_sr - 5;
-    }else if(i_sr < 35){
-        *sr_periodicity = 20;
-        *N_offset_sr    = i_sr - 15;
-    }else if(i_sr < 75){
-        *sr_periodicity = 40;
-        *N_offset_sr    = i_sr - 35;
-    }else if(i_sr < 155){
-        *sr_periodicity = 80;
-        *N_offset_sr    = i_sr - 75;
-    }else if(i_sr < 157){
-        *sr_periodicity = 2;
-        *N_offset_sr    = i_sr - 155;
-    }else{
-        *sr_periodicity = 1;
-        *N_offset_sr    = i_sr - 157;
-    }
-}
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_internal_interleaver(uint8  *in_bits,
+                                uint32  N_in_bits,
+                                uint8  *out_bits);
+void turbo_internal_interleaver(int8   *in_bits,
+                                uint32  N_in_bits,
+                                int8   *out_bits);
+void turbo_internal_interleaver(float  *in_bits,
+                                uint32  N_in_bits,
+                                float  *out_bits);
 
 /*********************************************************************
-    Name: liblte_phy_generate_prach
+    Name: turbo_internal_deinterleaver
 
-    Description: Generates the baseband signal for a PRACH
+    Description: Internal Deinterleaver for the LTE Parallel
+                 Concatenated Convolutional Code
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.3
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_generate_prach(LIBLTE_PHY_STRUCT *phy_struct,
-                                            uint32             preamble_idx,
-                                            uint32             freq_offset,
-                                            float             *samps_re,
-                                            float             *samps_im)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            idx;
-    uint32            N_ra_prb;
-    uint32            k_0;
-    uint32            K;
-    uint32            start;
+// Defines
+// Enums
+// Structs
+// Functions
+void turbo_internal_deinterleaver(float  *in_bits,
+                                  uint32  N_in_bits,
+                                  float  *out_bits);
+void turbo_internal_deinterleaver(int8   *in_bits,
+                                  uint32  N_in_bits,
+                                  int8   *out_bits);
 
-    if(phy_struct != NULL &&
-       samps_re   != NULL &&
-       samps_im   != NULL &&
-       phy_struct->ul_init)
-    {
-        // Calculate PRACH parameters
-        N_ra_prb = freq_offset;
-        k_0      = N_ra_prb*phy_struct->N_sc_rb_ul - phy_struct->N_rb_ul*phy_struct->N_sc_rb_ul/2 + (phy_struct->FFT_size/2);
-        K        = 15000/phy_struct->prach_delta_f_RA;
+/*********************************************************************
+    Name: rate_match_conv
 
-        for(i=0; i<phy_struct->prach_N_zc; i++)
-        {
-            phy_struct->prach_dft_in[i][0] = phy_struct->prach_x_u_v_re[preamble_idx][i];
-            phy_struct->prach_dft_in[i][1] = phy_struct->prach_x_u_v_im[preamble_idx][i];
-        }
-        fftwf_execute(phy_struct->prach_dft_plan);
-        for(i=0; i<phy_struct->prach_T_fft; i++)
-        {
-            phy_struct->prach_fft_in[i][0] = 0;
-            phy_struct->prach_fft_in[i][1] = 0;
-        }
-        start = phy_struct->prach_phi + (K*k_0) + (K/2);
-        for(i=0; i<phy_struct->prach_N_zc; i++)
-        {
-            idx                              = (i+start+phy_struct->prach_T_fft/2)%phy_struct->prach_T_fft;
-            phy_struct->prach_fft_in[idx][0] = phy_struct->prach_dft_out[(i+phy_struct->prach_N_zc/2)%phy_struct->prach_N_zc][0];
-            phy_struct->prach_fft_in[idx][1] = phy_struct->prach_dft_out[(i+phy_struct->prach_N_zc/2)%phy_struct->prach_N_zc][1];
-        }
-        fftwf_execute(phy_struct->prach_ifft_plan);
-        if(phy_struct->prach_T_fft == phy_struct->prach_T_seq)
-        {
-            for(i=0; i<phy_struct->prach_T_fft; i++)
-            {
-                samps_re[phy_struct->prach_T_cp+i] = phy_struct->prach_fft_out[i][0];
-                samps_im[phy_struct->prach_T_cp+i] = phy_struct->prach_fft_out[i][1];
-            }
-        }else{
-            for(i=0; i<phy_struct->prach_T_fft; i++)
-            {
-                samps_re[phy_struct->prach_T_cp+i]                         = phy_struct->prach_fft_out[i][0];
-                samps_im[phy_struct->prach_T_cp+i]                         = phy_struct->prach_fft_out[i][1];
-                samps_re[phy_struct->prach_T_cp+phy_struct->prach_T_fft+i] = phy_struct->prach_fft_out[i][0];
-                samps_im[phy_struct->prach_T_cp+phy_struct->prach_T_fft+i] = phy_struct->prach_fft_out[i][1];
-            }
-        }
-        for(i=0; i<phy_struct->prach_T_cp; i++)
-        {
-            samps_re[i] = samps_re[phy_struct->prach_T_seq+i];
-            samps_im[i] = samps_im[phy_struct->prach_T_seq+i];
-        }
+    Description: Rate matches convolutionally encoded data
 
-        err = LIBLTE_SUCCESS;
-    }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void rate_match_conv(LIBLTE_PHY_STRUCT *phy_struct,
+                     uint8             *d_bits,
+                     uint32             N_d_bits,
+                     uint32             N_e_bits,
+                     uint8             *e_bits);
 
-    return(err);
-}
+/*********************************************************************
+    Name: rate_unmatch_conv
+
+    Description: Rate unmatches convolutionally encoded data
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.2
+*********************************************************************/
+// Defines
+#define RX_NULL_BIT 10000
+#define TX_NULL_BIT 100
+// Enums
+// Structs
+// Functions
+void rate_unmatch_conv(LIBLTE_PHY_STRUCT *phy_struct,
+                       float             *e_bits,
+                       uint32             N_e_bits,
+                       uint32             N_c_bits,
+                       float             *d_bits,
+                       uint32            *N_d_bits);
 
 /*********************************************************************
-    Name: liblte_phy_detect_prach
+    Name: rate_match_table
 
-    Description: Detects PRACHs from baseband I/Q
+    Description: Finds or builds the sub-block interleaved circular
+                 buffer table of a code block, replacing the least
+                 recently used table when building a new one
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.4.1 and
+                        5.1.4.2
 
-    Notes: Currently only supports detection of one preamble
+    Notes: The number of rate matched bits and the redundancy
+           version only change how much of the circular buffer is
+           read and where from, so they are not part of the key.
+           N_fill_bits and N_cb are only used for turbo codes, the
+           systematic filler bits are <NULL> like the dummy bits.
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
-                                          float             *samps_re,
-                                          float             *samps_im,
-                                          uint32             freq_offset,
-                                          uint32            *N_det_pre,
-                                          uint32            *det_pre,
-                                          uint32            *det_ta)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    float             max_val;
-    float             abs_corr;
-    float             ave_val;
-    int32             N_neg_RA_shift;
-    uint32            i;
-    uint32            j;
-    uint32            u;
-    uint32            N_cs;
-    uint32            p;
-    uint32            v_max;
-    uint32            d_u;
-    uint32            d_start;
-    uint32            N_RA_shift;
-    uint32            N_RA_group;
-    uint32            N_ra_prb;
-    uint32            k_0;
-    uint32            K;
-    uint32            start;
-    uint32            idx;
-    uint32            max_root;
-    uint32            max_offset;
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT* rate_match_table(LIBLTE_PHY_STRUCT *phy_struct,
+                                                     bool               turbo,
+                                                     uint32             N_branch_bits,
+                                                     uint32             N_fill_bits,
+                                                     uint32             N_cb);
 
-    if(phy_struct != NULL &&
-       samps_re   != NULL &&
-       samps_im   != NULL &&
-       N_det_pre  != NULL &&
-       det_pre    != NULL &&
-       det_ta     != NULL &&
-       phy_struct->ul_init)
-    {
-        // Determine u
-        if(4 == phy_struct->prach_preamble_format)
-        {
-            u = PRACH_5_7_2_5[phy_struct->prach_root_seq_idx];
-        }else{
-            u = PRACH_5_7_2_4[phy_struct->prach_root_seq_idx];
-        }
+/*********************************************************************
+    Name: rate_match_turbo_n_cb
 
-        // Determine N_cs
-        if(4 == phy_struct->prach_preamble_format)
-        {
-            N_cs = PRACH_5_7_2_3[phy_struct->prach_zczc];
-        }else{
-            if(phy_struct->prach_hs_flag)
-            {
-                N_cs = PRACH_5_7_2_2_RS[phy_struct->prach_zczc];
-            }else{
-                N_cs = PRACH_5_7_2_2_URS[phy_struct->prach_zczc];
-            }
-        }
+    Description: Determines the soft buffer size of a turbo coded
+                 code block
 
-        // Determine v_max
-        if(phy_struct->prach_hs_flag)
-        {
-            // Determine d_u
-            for(p=1; p<=phy_struct->prach_N_zc; p++)
-            {
-                if(((p*u) % phy_struct->prach_N_zc) == 1)
-                {
-                    break;
-                }
-            }
-            if(p >= 0 && p < phy_struct->prach_N_zc/2)
-            {
-                d_u = p;
-            }else{
-                d_u = phy_struct->prach_N_zc - p;
-            }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+uint32 rate_match_turbo_n_cb(uint32                    N_branch_bits,
+                             uint32                    N_codeblocks,
+                             uint32                    tx_mode,
+                             uint32                    N_soft,
+                             uint32                    M_dl_harq,
+                             LIBLTE_PHY_CHAN_TYPE_ENUM chan_type);
 
-            // Determine N_RA_shift, d_start, N_RA_group, and N_neg_RA_shift
-            if(d_u >= N_cs && d_u < phy_struct->prach_N_zc/3)
-            {
-                N_RA_shift     = d_u/N_cs;
-                d_start        = 2*d_u + N_RA_shift*N_cs;
-                N_RA_group     = phy_struct->prach_N_zc/d_start;
-                N_neg_RA_shift = (phy_struct->prach_N_zc - 2*d_u - N_RA_group*d_start)/N_cs;
-                if(N_neg_RA_shift < 0)
-                {
-                    N_neg_RA_shift = 0;
-                }
-            }else{
-                N_RA_shift     = (phy_struct->prach_N_zc - 2*d_u)/N_cs;
-                d_start        = phy_struct->prach_N_zc - 2*d_u + N_RA_shift*N_cs;
-                N_RA_group     = d_u/d_start;
-                N_neg_RA_shift = (d_u - N_RA_group*d_start)/N_cs;
-                if(N_neg_RA_shift < 0)
-                {
-                    N_neg_RA_shift = 0;
-                }
-                if(N_neg_RA_shift > N_RA_shift)
-                {
-                    N_neg_RA_shift = N_RA_shift;
-                }
-            }
+/*********************************************************************
+    Name: rate_unmatch_turbo
 
-            // Restricted set
-            v_max = N_RA_shift*N_RA_group + N_neg_RA_shift - 1;
-        }else{
-            // Unrestricted set
-            if(0 == N_cs)
-            {
-                v_max = 0;
-            }else{
-                v_max = (phy_struct->prach_N_zc/N_cs)-1;
-            }
-        }
+    Description: Rate unmatches turbo encoded data, scattering and
+                 accumulating the e_bits into the d_bits
 
-        // Calculate PRACH parameters
-        N_ra_prb = freq_offset;
-        k_0      = N_ra_prb*phy_struct->N_sc_rb_ul - phy_struct->N_rb_ul*phy_struct->N_sc_rb_ul/2 + (phy_struct->FFT_size/2);
-        K        = 15000/phy_struct->prach_delta_f_RA;
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
 
-        for(i=0; i<phy_struct->prach_T_fft; i++)
-        {
-            phy_struct->prach_fft_in[i][0] = samps_re[phy_struct->prach_T_cp+i];
-            phy_struct->prach_fft_in[i][1] = samps_im[phy_struct->prach_T_cp+i];
-        }
-        fftwf_execute(phy_struct->prach_fft_plan);
-        start = phy_struct->prach_phi + (K*k_0) + (K/2);
-        for(i=0; i<phy_struct->prach_N_zc; i++)
-        {
-            idx                           = (i+start+phy_struct->prach_T_fft/2)%phy_struct->prach_T_fft;
-            phy_struct->prach_x_hat_re[i] = phy_struct->prach_fft_out[idx][0];
-            phy_struct->prach_x_hat_im[i] = phy_struct->prach_fft_out[idx][1];
-        }
-
-        // Correlate with all available roots
-        ave_val = 0;
-        max_val = 0;
-        for(i=0; i<phy_struct->prach_N_x_u; i++)
-        {
-            for(j=0; j<phy_struct->prach_N_zc; j++)
-            {
-                phy_struct->prach_dft_in[j][0] = phy_struct->prach_x_u_fft_re[i][j]*phy_struct->prach_x_hat_re[j] + phy_struct->prach_x_u_fft_im[i][j]*phy_struct->prach_x_hat_im[j];
-                phy_struct->prach_dft_in[j][1] = phy_struct->prach_x_u_fft_im[i][j]*phy_struct->prach_x_hat_re[j] - phy_struct->prach_x_u_fft_re[i][j]*phy_struct->prach_x_hat_im[j];
-            }
-            fftwf_execute(phy_struct->prach_idft_plan);
-            for(j=0; j<phy_struct->prach_N_zc; j++)
-            {
-                abs_corr  = phy_struct->prach_dft_out[j][0]*phy_struct->prach_dft_out[j][0] + phy_struct->prach_dft_out[j][1]*phy_struct->prach_dft_out[j][1];
-                ave_val  += abs_corr;
-                if(abs_corr > max_val)
-                {
-                    max_val    = abs_corr;
-                    max_root   = i;
-                    max_offset = j;
-                }
-            }
-            ave_val /= phy_struct->prach_N_zc;
-        }
+    Notes: If combine is false, the d_bits are cleared to <NULL>
+           first
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void rate_unmatch_turbo(LIBLTE_PHY_STRUCT *phy_struct,
+                        float             *e_bits,
+                        uint32             N_e_bits,
+                        uint32             N_branch_bits,
+                        uint32             N_fill_bits,
+                        uint32             N_cb,
+                        uint32             rv_idx,
+                        bool               combine,
+                        float             *d_bits,
+                        uint32            *N_d_bits);
 
-        if(max_val >= 50*ave_val &&
-           max_val != 0)
-        {
-            *N_det_pre = 1;
-            if(0 == N_cs)
-            {
-                *det_pre = max_root*(v_max+1);
-                *det_ta  = ((max_offset%phy_struct->prach_N_zc)*29.155/16)-1;
-            }else{
-                *det_pre = max_root*(v_max+1) + ((max_offset+N_cs)%phy_struct->prach_N_zc)/N_cs;
-                *det_ta  = (((N_cs - ((max_offset+N_cs)%phy_struct->prach_N_zc))%N_cs)*29.155/16)-1;
-            }
-        }else{
-            *N_det_pre = 0;
-        }
+/*********************************************************************
+    Name: rate_unmatch_scatter
 
-        err = LIBLTE_SUCCESS;
-    }
+    Description: Soft combines e_bits into the d_bits given by a rate
+                 matching table, starting at the redundancy version
 
-    return(err);
-}
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void rate_unmatch_scatter(LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT *table,
+                          float                              *e_bits,
+                          uint32                              N_e_bits,
+                          uint32                              rv_idx,
+                          float                              *d_bits);
 
 /*********************************************************************
-    Name: liblte_phy_pdsch_channel_encode
+    Name: turbo_n_fill_bits
 
-    Description: Encodes and modulates the Physical Downlink Shared
-                 Channel
+    Description: Counts the filler bits at the start of the
+                 systematic stream of turbo encoded data
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
-                                                  LIBLTE_PHY_PDCCH_STRUCT    *pdcch,
-                                                  uint32                      N_id_cell,
-                                                  uint8                       N_ant,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            p;
-    uint32            L;
-    uint32            idx;
-    uint32            alloc_idx;
-    uint32            prb_idx;
-    uint32            c_init;
-    uint32            N_bits_tot;
-    uint32            N_bits;
-    uint32            M_symb;
-    uint32            M_layer_symb;
-    uint32            M_ap_symb;
-    uint32            first_sc;
-    uint32            last_sc;
-    uint32            Q_m;
-    uint32            scramb_bits_idx;
+// Defines
+// Enums
+// Structs
+// Functions
+uint32 turbo_n_fill_bits(uint8  *d_bits,
+                         uint32  N_branch_bits);
 
-    if(phy_struct != NULL &&
-       pdcch      != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
-       subframe   != NULL)
-    {
-        // Determine first and last PBCH, PSS, and SSS subcarriers
-        if(phy_struct->N_rb_dl == 6)
-        {
-            first_sc = 0;
-            last_sc  = (6*phy_struct->N_sc_rb_dl)-1;
-        }else if(phy_struct->N_rb_dl == 15){
-            first_sc = (4*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (11*phy_struct->N_sc_rb_dl)-7;
-        }else if(phy_struct->N_rb_dl == 25){
-            first_sc = (9*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (16*phy_struct->N_sc_rb_dl)-7;
-        }else if(phy_struct->N_rb_dl == 50){
-            first_sc = 22*phy_struct->N_sc_rb_dl;
-            last_sc  = (28*phy_struct->N_sc_rb_dl)-1;
-        }else if(phy_struct->N_rb_dl == 75){
-            first_sc = (34*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (41*phy_struct->N_sc_rb_dl)-7;
-        }else{ // phy_struct->N_rb_dl == 100
-            first_sc = 47*phy_struct->N_sc_rb_dl;
-            last_sc  = (53*phy_struct->N_sc_rb_dl)-1;
-        }
+/*********************************************************************
+    Name: code_block_concatenation
 
-        for(alloc_idx=0; alloc_idx<pdcch->N_alloc; alloc_idx++)
-        {
-            if(pdcch->alloc[alloc_idx].chan_type == LIBLTE_PHY_CHAN_TYPE_DLSCH)
-            {
-                // Determine the number of bits available for transmission
-                N_bits_tot = 0;
-                for(i=0; i<pdcch->alloc[alloc_idx].N_prb; i++)
-                {
-                    N_bits_tot += get_num_bits_in_prb(subframe->num,
-                                                      pdcch->N_symbs,
-                                                      pdcch->alloc[alloc_idx].prb[0][i],
-                                                      phy_struct->N_rb_dl,
-                                                      N_ant,
-                                                      pdcch->alloc[alloc_idx].mod_type);
-                }
-                // Determine Q_m
-                if(LIBLTE_PHY_MODULATION_TYPE_BPSK == pdcch->alloc[alloc_idx].mod_type)
-                {
-                    Q_m = 1;
-                }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == pdcch->alloc[alloc_idx].mod_type){
-                    Q_m = 2;
-                }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == pdcch->alloc[alloc_idx].mod_type){
-                    Q_m = 4;
-                }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == pdcch->alloc[alloc_idx].mod_type
-                    Q_m = 6;
-                }
-                scramb_bits_idx = 0;
-                for(i=0; i<pdcch->alloc[alloc_idx].N_codewords; i++)
-                {
-                    // Encode the PDSCH
-                    dlsch_channel_encode(phy_struct,
-                                         pdcch->alloc[alloc_idx].msg[i].msg,
-                                         pdcch->alloc[alloc_idx].msg[i].N_bits,
-                                         pdcch->alloc[alloc_idx].tbs,
-                                         pdcch->alloc[alloc_idx].tx_mode,
-                                         pdcch->alloc[alloc_idx].rv_idx,
-                                         N_bits_tot,
-                                         2,
-                                         Q_m,
-                                         8,
-                                         250368,
-                                         phy_struct->pdsch_encode_bits,
-                                         &N_bits);
-                    c_init = (pdcch->alloc[alloc_idx].rnti << 14) | (i << 13) | (subframe->num << 9) | N_id_cell;
-                    generate_prs_c(c_init, N_bits, phy_struct->pdsch_c);
-                    for(j=0; j<N_bits; j++)
-                    {
-                        phy_struct->pdsch_scramb_bits[scramb_bits_idx++] = phy_struct->pdsch_encode_bits[j] ^ phy_struct->pdsch_c[j];
-                    }
-                }
-                modulation_mapper(phy_struct->pdsch_scramb_bits,
-                                  N_bits,
-                                  pdcch->alloc[alloc_idx].mod_type,
-                                  phy_struct->pdsch_d_re,
-                                  phy_struct->pdsch_d_im,
-                                  &M_symb);
-                layer_mapper_dl(phy_struct->pdsch_d_re,
-                                phy_struct->pdsch_d_im,
-                                M_symb,
-                                N_ant,
-                                pdcch->alloc[alloc_idx].N_codewords,
-                                pdcch->alloc[alloc_idx].pre_coder_type,
-                                phy_struct->pdsch_x_re,
-                                phy_struct->pdsch_x_im,
-                                &M_layer_symb);
-                pre_coder_dl(phy_struct->pdsch_x_re,
-                             phy_struct->pdsch_x_im,
-                             M_layer_symb,
-                             N_ant,
-                             pdcch->alloc[alloc_idx].pre_coder_type,
-                             phy_struct->pdsch_y_re[0],
-                             phy_struct->pdsch_y_im[0],
-                             5000,
-                             &M_ap_symb);
+    Description: Performs code block concatenation for turbo coded
+                 channels
 
-                // Map the symbols to resource elements 3GPP TS 36.211 v10.1.0 section 6.3.5
-                for(p=0; p<N_ant; p++)
-                {
-                    idx = 0;
-                    for(L=pdcch->N_symbs; L<14; L++)
-                    {
-                        for(prb_idx=0; prb_idx<pdcch->alloc[alloc_idx].N_prb; prb_idx++)
-                        {
-                            i = pdcch->alloc[alloc_idx].prb[L/7][prb_idx];
-                            for(j=0; j<phy_struct->N_sc_rb_dl; j++)
-                            {
-                                if(N_ant           == 1 &&
-                                   (L % 7)         == 0 &&
-                                   (N_id_cell % 6) == (j % 6))
-                                {
-                                    // Skip CRS
-                                }else if(N_ant               == 1 &&
-                                         (L % 7)             == 4 &&
-                                         ((N_id_cell+3) % 6) == (j % 6)){
-                                    // Skip CRS
-                                }else if((N_ant          == 2  ||
-                                          N_ant          == 4) &&
-                                         ((L % 7)        == 0  ||
-                                          (L % 7)        == 4) &&
-                                         (N_id_cell % 3) == (j % 3)){
-                                    // Skip CRS
-                                }else if(N_ant           == 4 &&
-                                         (L % 7)         == 1 &&
-                                         (N_id_cell % 3) == (j % 3)){
-                                    // Skip CRS
-                                }else if(subframe->num                == 0        &&
-                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                                         L                            >= 7        &&
-                                         L                            <= 10){
-                                    // Skip PBCH
-                                }else if((subframe->num               == 0        ||
-                                          subframe->num               == 5)       &&
-                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                                         L                            == 6){
-                                    // Skip PSS
-                                }else if((subframe->num               == 0        ||
-                                          subframe->num               == 5)       &&
-                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                                         L                            == 5){
-                                    // Skip SSS
-                                }else{
-                                    subframe->tx_symb_re[p][L][i*phy_struct->N_sc_rb_dl+j] = phy_struct->pdsch_y_re[p][idx];
-                                    subframe->tx_symb_im[p][L][i*phy_struct->N_sc_rb_dl+j] = phy_struct->pdsch_y_im[p][idx];
-                                    idx++;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        err = LIBLTE_SUCCESS;
-    }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void code_block_concatenation(uint8  *e_bits,
+                              uint32 *N_e_bits,
+                              uint32  N_e_bits_max,
+                              uint32  N_codeblocks,
+                              uint8  *f_bits,
+                              uint32 *N_f_bits);
 
-    return(err);
-}
+/*********************************************************************
+    Name: code_block_deconcatenation
+
+    Description: Performs code block deconcatenation for turbo coded
+                 channels, determining the number of e_bits of each
+                 code block.  The e_bits of the code blocks follow
+                 each other in the f_bits.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.4.1.2 and
+                        5.1.5
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void code_block_deconcatenation(uint32  N_f_bits,
+                                uint32  tbs,
+                                uint32  N_l,
+                                uint32  Q_m,
+                                uint32 *N_e_bits,
+                                uint32 *N_codeblocks);
 
 /*********************************************************************
-    Name: liblte_phy_pdsch_channel_decode
+    Name: decode_code_blocks
 
-    Description: Demodulates and decodes the Physical Downlink Shared
-                 Channel
+    Description: Rate unmatches and turbo decodes the code blocks
+                 described by the first N_tasks entries of cbd_task,
+                 spreading them across the calling thread and the
+                 code block decoding workers, and fills in td_stats
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.3.2 and
+                        5.1.4.1
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT            *phy_struct,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
-                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
-                                                  uint32                        N_pdcch_symbs,
-                                                  uint32                        N_id_cell,
-                                                  uint8                         N_ant,
-                                                  uint8                        *out_bits,
-                                                  uint32                       *N_out_bits)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            p;
-    uint32            L;
-    uint32            prb_idx;
-    uint32            idx;
-    uint32            c_init;
-    uint32            M_layer_symb;
-    uint32            M_symb;
-    uint32            N_bits;
-    uint32            first_sc;
-    uint32            last_sc;
+// Defines
+#define CB_DECODE_CLAIM_IDX_MASK  0xFFFF
+#define CB_DECODE_CLAIM_N_SHIFT   16
+#define CB_DECODE_CLAIM_RND_SHIFT 32
+#define CB_DECODE_N_SPINS         1000
+// Enums
+// Structs
+// Functions
+void decode_code_blocks(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint32             N_tasks);
 
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
-       out_bits   != NULL &&
-       N_out_bits != NULL)
-    {
-        err = LIBLTE_ERROR_DECODE_FAIL;
+/*********************************************************************
+    Name: decode_code_block_tasks
 
-        // Determine first and last PBCH, PSS, and SSS subcarriers
-        if(phy_struct->N_rb_dl == 6)
-        {
-            first_sc = 0;
-            last_sc  = (6*phy_struct->N_sc_rb_dl)-1;
-        }else if(phy_struct->N_rb_dl == 15){
-            first_sc = (4*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (11*phy_struct->N_sc_rb_dl)-7;
-        }else if(phy_struct->N_rb_dl == 25){
-            first_sc = (9*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (16*phy_struct->N_sc_rb_dl)-7;
-        }else if(phy_struct->N_rb_dl == 50){
-            first_sc = 22*phy_struct->N_sc_rb_dl;
-            last_sc  = (28*phy_struct->N_sc_rb_dl)-1;
-        }else if(phy_struct->N_rb_dl == 75){
-            first_sc = (34*phy_struct->N_sc_rb_dl)+6;
-            last_sc  = (41*phy_struct->N_sc_rb_dl)-7;
-        }else{ // phy_struct->N_rb_dl == 100
-            first_sc = 47*phy_struct->N_sc_rb_dl;
-            last_sc  = (53*phy_struct->N_sc_rb_dl)-1;
-        }
+    Description: Claims and decodes code block tasks until none are
+                 left in the current round
 
-        // Extract resource elements and channel estimate 3GPP TS 36.211 v10.1.0 section 6.3.5
-        idx = 0;
-        for(L=N_pdcch_symbs; L<14; L++)
-        {
-            for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
-            {
-                i = alloc->prb[L/7][prb_idx];
-                for(j=0; j<phy_struct->N_sc_rb_dl; j++)
-                {
-                    if(N_ant           == 1 &&
-                       (L % 7)         == 0 &&
-                       (N_id_cell % 6) == (j % 6))
-                    {
-                        // Skip CRS
-                    }else if(N_ant               == 1 &&
-                             (L % 7)             == 4 &&
-                             ((N_id_cell+3) % 6) == (j % 6)){
-                        // Skip CRS
-                    }else if((N_ant          == 2  ||
-                              N_ant          == 4) &&
-                             ((L % 7)        == 0  ||
-                              (L % 7)        == 4) &&
-                             (N_id_cell % 3) == (j % 3)){
-                        // Skip CRS
-                    }else if(N_ant           == 4 &&
-                             (L % 7)         == 1 &&
-                             (N_id_cell % 3) == (j % 3)){
-                        // Skip CRS
-                    }else if(subframe->num                == 0        &&
-                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                             L                            >= 7        &&
-                             L                            <= 10){
-                        // Skip PBCH
-                    }else if((subframe->num               == 0        ||
-                              subframe->num               == 5)       &&
-                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                             L                            == 6){
-                        // Skip PSS
-                    }else if((subframe->num               == 0        ||
-                              subframe->num               == 5)       &&
-                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                             L                            == 5){
-                        // Skip SSS
-                    }else{
-                        phy_struct->pdsch_y_est_re[idx] = subframe->rx_symb_re[L][i*phy_struct->N_sc_rb_dl+j];
-                        phy_struct->pdsch_y_est_im[idx] = subframe->rx_symb_im[L][i*phy_struct->N_sc_rb_dl+j];
-                        for(p=0; p<N_ant; p++)
-                        {
-                            phy_struct->pdsch_c_est_re[p][idx] = subframe->rx_ce_re[p][L][i*phy_struct->N_sc_rb_dl+j];
-                            phy_struct->pdsch_c_est_im[p][idx] = subframe->rx_ce_im[p][L][i*phy_struct->N_sc_rb_dl+j];
-                        }
-                        idx++;
-                    }
-                }
-            }
-        }
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void decode_code_block_tasks(LIBLTE_PHY_STRUCT                  *phy_struct,
+                             LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT *ctx);
 
-        pre_decoder_and_matched_filter_dl(phy_struct->pdsch_y_est_re,
-                                          phy_struct->pdsch_y_est_im,
-                                          phy_struct->pdsch_c_est_re[0],
-                                          phy_struct->pdsch_c_est_im[0],
-                                          5000,
-                                          idx,
-                                          N_ant,
-                                          alloc->pre_coder_type,
-                                          phy_struct->pdsch_x_re,
-                                          phy_struct->pdsch_x_im,
-                                          &M_layer_symb);
-        layer_demapper_dl(phy_struct->pdsch_x_re,
-                          phy_struct->pdsch_x_im,
-                          M_layer_symb,
-                          N_ant,
-                          alloc->N_codewords,
-                          alloc->pre_coder_type,
-                          phy_struct->pdsch_d_re,
-                          phy_struct->pdsch_d_im,
-                          &M_symb);
-        modulation_demapper(phy_struct->pdsch_d_re,
-                            phy_struct->pdsch_d_im,
-                            M_symb,
-                            alloc->mod_type,
-                            phy_struct->pdsch_soft_bits,
-                            &N_bits);
-        // FIXME: Only handling 1 codeword
-        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
-        generate_prs_c(c_init, N_bits, phy_struct->pdsch_c);
-        for(i=0; i<N_bits; i++)
-        {
-            phy_struct->pdsch_descramb_bits[i] = (float)phy_struct->pdsch_soft_bits[i]*(1-2*(float)phy_struct->pdsch_c[i]);
-        }
-        if(LIBLTE_SUCCESS == dlsch_channel_decode(phy_struct,
-                                                  phy_struct->pdsch_descramb_bits,
-                                                  N_bits,
-                                                  alloc->tbs,
-                                                  alloc->tx_mode,
-                                                  alloc->rv_idx,
-                                                  8,
-                                                  250368, // FIXME: Using N_soft from a cat 1 UE (3GPP TS 36.306)
-                                                  out_bits,
-                                                  N_out_bits))
-        {
-            err = LIBLTE_SUCCESS;
-        }
-    }
+/*********************************************************************
+    Name: decode_code_block_worker
 
-    return(err);
-}
+    Description: Code block decoding worker thread, waits to be woken
+                 for each transport block
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void* decode_code_block_worker(void *inputs);
 
 /*********************************************************************
-    Name: liblte_phy_bch_channel_encode
+    Name: stop_code_block_workers
 
-    Description: Encodes and modulates the Physical Broadcast
-                 Channel
+    Description: Stops and frees the code block decoding workers
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.6
+    Document Reference: N/A
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_bch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
-                                                uint8                      *in_bits,
-                                                uint32                      N_in_bits,
-                                                uint32                      N_id_cell,
-                                                uint8                       N_ant,
-                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
-                                                uint32                      sfn)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            k;
-    uint32            p;
-    uint32            offset;
-    uint32            idx;
-    uint32            M_symb;
-    uint32            M_layer_symb;
-    uint32            M_ap_symb;
+// Defines
+// Enums
+// Structs
+// Functions
+void stop_code_block_workers(LIBLTE_PHY_STRUCT *phy_struct);
 
-    if(phy_struct != NULL &&
-       in_bits    != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
-       subframe   != NULL)
-    {
-        // Encode the bits to symbols
-        if(0 == phy_struct->bch_N_bits)
-        {
-            bch_channel_encode(phy_struct,
-                               in_bits,
-                               N_in_bits,
-                               N_ant,
-                               phy_struct->bch_encode_bits,
-                               &phy_struct->bch_N_bits);
-            generate_prs_c(N_id_cell, phy_struct->bch_N_bits, phy_struct->bch_c);
-        }
-        for(i=0; i<480; i++)
-        {
-            offset                         = (sfn % 4)*480;
-            phy_struct->bch_scramb_bits[i] = phy_struct->bch_encode_bits[offset+i] ^ phy_struct->bch_c[offset + i];
-        }
-        if(3 == (sfn % 4))
-        {
-            phy_struct->bch_N_bits = 0;
-        }
-        modulation_mapper(phy_struct->bch_scramb_bits,
-                          480,
-                          LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                          phy_struct->bch_d_re,
-                          phy_struct->bch_d_im,
-                          &M_symb);
-        layer_mapper_dl(phy_struct->bch_d_re,
-                        phy_struct->bch_d_im,
-                        M_symb,
-                        N_ant,
-                        1,
-                        LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                        phy_struct->bch_x_re,
-                        phy_struct->bch_x_im,
-                        &M_layer_symb);
-        pre_coder_dl(phy_struct->bch_x_re,
-                     phy_struct->bch_x_im,
-                     M_layer_symb,
-                     N_ant,
-                     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                     phy_struct->bch_y_re[0],
-                     phy_struct->bch_y_im[0],
-                     240,
-                     &M_ap_symb);
+/*********************************************************************
+    Name: ulsch_data_control_multiplexing
 
-        // Map the symbols to resource elements
-        idx = 0;
-        for(p=0; p<N_ant; p++)
-        {
-            for(i=0; i<72; i++)
-            {
-                k = (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2 - 36 + i;
-                if((N_id_cell % 3) != (i % 3))
-                {
-                    subframe->tx_symb_re[p][7][k] = phy_struct->bch_y_re[p][idx];
-                    subframe->tx_symb_im[p][7][k] = phy_struct->bch_y_im[p][idx];
-                    subframe->tx_symb_re[p][8][k] = phy_struct->bch_y_re[p][idx+48];
-                    subframe->tx_symb_im[p][8][k] = phy_struct->bch_y_im[p][idx+48];
-                    idx++;
-                }
-                subframe->tx_symb_re[p][9][k]  = phy_struct->bch_y_re[p][i+96];
-                subframe->tx_symb_im[p][9][k]  = phy_struct->bch_y_im[p][i+96];
-                subframe->tx_symb_re[p][10][k] = phy_struct->bch_y_re[p][i+168];
-                subframe->tx_symb_im[p][10][k] = phy_struct->bch_y_im[p][i+168];
-            }
-        }
+    Description: Multiplexes the control and data bits for Uplink
+                 Shared Channel
 
-        err = LIBLTE_SUCCESS;
-    }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void ulsch_data_control_multiplexing(uint8  *f_bits,
+                                     uint32  N_f_bits,
+                                     uint8  *cqi_bits,
+                                     uint32  N_cqi_bits,
+                                     uint32  N_l,
+                                     uint32  Q_m,
+                                     uint8  *g_bits,
+                                     uint32 *N_g_bits);
 
-    return(err);
-}
+/*********************************************************************
+    Name: ulsch_data_control_demultiplexing
+
+    Description: Demultiplexes the control and data bits for Uplink
+                 Shared Channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.7
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void ulsch_data_control_demultiplexing(float  *g_bits,
+                                       uint32  N_g_bits,
+                                       uint32  N_cqi_bits,
+                                       uint32  N_l,
+                                       uint32  Q_m,
+                                       float  *f_bits,
+                                       uint32 *N_f_bits,
+                                       float  *cqi_bits);
 
 /*********************************************************************
-    Name: liblte_phy_bch_channel_decode
+    Name: ulsch_channel_interleaver
 
-    Description: Demodulates and decodes the Physical Broadcast
-                 Channel
+    Description: Interleaves Uplink Shared Channel data with RI and
+                 ACK control information
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.6
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_bch_channel_decode(LIBLTE_PHY_STRUCT          *phy_struct,
-                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
-                                                uint32                      N_id_cell,
-                                                uint8                      *N_ant,
-                                                uint8                      *out_bits,
-                                                uint32                     *N_out_bits,
-                                                uint8                      *offset)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            p;
-    uint32            in_idx;
-    uint32            idx;
-    uint32            M_layer_symb;
-    uint32            M_symb;
-    uint32            N_bits;
+// Defines
+// Enums
+// Structs
+// Functions
+void ulsch_channel_interleaver(LIBLTE_PHY_STRUCT *phy_struct,
+                               uint8             *g_bits,
+                               uint32             N_g_bits,
+                               uint8             *ri_bits,
+                               uint32             N_ri_bits,
+                               uint8             *ack_bits,
+                               uint32             N_ack_bits,
+                               uint32             N_l,
+                               uint32             Q_m,
+                               uint8             *h_bits,
+                               uint32            *N_h_bits);
 
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
-       N_ant      != NULL &&
-       out_bits   != NULL &&
-       N_out_bits != NULL &&
-       offset     != NULL)
-    {
-        err = LIBLTE_ERROR_DECODE_FAIL;
+/*********************************************************************
+    Name: ulsch_channel_deinterleaver
 
-        // Unmap PBCH and channel estimates from resource elements
-        idx = 0;
-        for(i=0; i<72; i++)
-        {
-            in_idx = phy_struct->N_sc_rb_dl*phy_struct->N_rb_dl/2 - 36 + i;
-            if((N_id_cell % 3) != (i % 3))
-            {
-                phy_struct->bch_y_est_re[idx]    = subframe->rx_symb_re[7][in_idx];
-                phy_struct->bch_y_est_im[idx]    = subframe->rx_symb_im[7][in_idx];
-                phy_struct->bch_y_est_re[idx+48] = subframe->rx_symb_re[8][in_idx];
-                phy_struct->bch_y_est_im[idx+48] = subframe->rx_symb_im[8][in_idx];
-                for(p=0; p<4; p++)
-                {
-                    phy_struct->bch_c_est_re[p][idx]    = subframe->rx_ce_re[p][7][in_idx];
-                    phy_struct->bch_c_est_im[p][idx]    = subframe->rx_ce_im[p][7][in_idx];
-                    phy_struct->bch_c_est_re[p][idx+48] = subframe->rx_ce_re[p][8][in_idx];
-                    phy_struct->bch_c_est_im[p][idx+48] = subframe->rx_ce_im[p][8][in_idx];
-                }
-                idx++;
-            }
-            phy_struct->bch_y_est_re[i+96]  = subframe->rx_symb_re[9][in_idx];
-            phy_struct->bch_y_est_im[i+96]  = subframe->rx_symb_im[9][in_idx];
-            phy_struct->bch_y_est_re[i+168] = subframe->rx_symb_re[10][in_idx];
-            phy_struct->bch_y_est_im[i+168] = subframe->rx_symb_im[10][in_idx];
-            for(p=0; p<4; p++)
-            {
-                phy_struct->bch_c_est_re[p][i+96]  = subframe->rx_ce_re[p][9][in_idx];
-                phy_struct->bch_c_est_im[p][i+96]  = subframe->rx_ce_im[p][9][in_idx];
-                phy_struct->bch_c_est_re[p][i+168] = subframe->rx_ce_re[p][10][in_idx];
-                phy_struct->bch_c_est_im[p][i+168] = subframe->rx_ce_im[p][10][in_idx];
-            }
-        }
+    Description: Deinterleaves Uplink Shared Channel data from RI and
+                 ACK control information
 
-        // Generate the scrambling sequence
-        generate_prs_c(N_id_cell, 1920, phy_struct->bch_c);
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2.8
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void ulsch_channel_deinterleaver(LIBLTE_PHY_STRUCT *phy_struct,
+                                 float             *h_bits,
+                                 uint32             N_h_bits,
+                                 uint32             N_ri_bits,
+                                 uint32             N_ack_bits,
+                                 uint32             N_l,
+                                 uint32             Q_m,
+                                 float             *g_bits,
+                                 uint32            *N_g_bits,
+                                 float             *ri_bits,
+                                 float             *ack_bits);
 
-        // Try decoding with 1, 2, and 4 antenna configs,
-        // and for each antenna config, try decoding with 0 to 3 offset
-        *N_ant = 0;
-        for(p=1; p<5; p++)
-        {
-            if(p != 3)
-            {
-                pre_decoder_and_matched_filter_dl(phy_struct->bch_y_est_re,
-                                                  phy_struct->bch_y_est_im,
-                                                  phy_struct->bch_c_est_re[0],
-                                                  phy_struct->bch_c_est_im[0],
-                                                  240,
-                                                  240,
-                                                  p,
-                                                  LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                                  phy_struct->bch_x_re,
-                                                  phy_struct->bch_x_im,
-                                                  &M_layer_symb);
-                layer_demapper_dl(phy_struct->bch_x_re,
-                                  phy_struct->bch_x_im,
-                                  M_layer_symb,
-                                  p,
-                                  1,
-                                  LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                  phy_struct->bch_d_re,
-                                  phy_struct->bch_d_im,
-                                  &M_symb);
-                modulation_demapper(phy_struct->bch_d_re,
-                                    phy_struct->bch_d_im,
-                                    M_symb,
-                                    LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                                    phy_struct->bch_soft_bits,
-                                    &N_bits);
+/*********************************************************************
+    Name: ulsch_channel_encode
 
-                // Try decoding at each offset
-                for(i=0; i<4; i++)
-                {
-                    for(j=0; j<1920; j++)
-                    {
-                        phy_struct->bch_descramb_bits[j] = RX_NULL_BIT;
-                    }
-                    for(j=0; j<480; j++)
-                    {
-                        phy_struct->bch_descramb_bits[(i*480)+j] = (float)phy_struct->bch_soft_bits[j]*(1-2*(float)phy_struct->bch_c[(i*480)+j]);
-                    }
-                    if(LIBLTE_SUCCESS == bch_channel_decode(phy_struct,
-                                                            phy_struct->bch_descramb_bits,
-                                                            1920,
-                                                            p,
-                                                            out_bits,
-                                                            N_out_bits))
-                    {
-                        *offset = i;
-                        *N_ant  = p;
-                        break;
-                    }
-                }
-                if(*N_ant != 0)
-                {
-                    err = LIBLTE_SUCCESS;
-                    break;
-                }
-            }
-        }
-    }
+    Description: Channel encodes the Uplink Shared Channel
 
-    return(err);
-}
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
+
+    Notes: Not handling control bits
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                          uint8             *in_bits,
+                          uint32             N_in_bits,
+                          uint32             tbs,
+                          uint32             tx_mode,
+                          uint32             G,
+                          uint32             N_l,
+                          uint32             Q_m,
+                          uint32             rv_idx,
+                          uint8             *out_bits,
+                          uint32            *N_out_bits);
 
 /*********************************************************************
-    Name: liblte_phy_pdcch_channel_encode
+    Name: ulsch_channel_decode
 
-    Description: Encodes and modulates all of the Physical Downlink
-                 Control Channels (PCFICH, PHICH, and PDCCH)
+    Description: Channel decodes the Uplink Shared Channel
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.7, 6.8, and
-                        6.9
-                        3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
-                        3GPP TS 36.213 v10.3.0 section 7.1 and 9.1.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.2.2
+
+    Notes: Not handling control bits
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT              *phy_struct,
-                                                  LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
-                                                  LIBLTE_PHY_PHICH_STRUCT        *phich,
-                                                  LIBLTE_PHY_PDCCH_STRUCT        *pdcch,
-                                                  uint32                          N_id_cell,
-                                                  uint8                           N_ant,
-                                                  float                           phich_res,
-                                                  LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT     *subframe)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            j;
-    uint32            k;
-    uint32            p;
-    uint32            idx;
-    uint32            a_idx;
-    uint32            css_idx;
-    uint32            uss_idx;
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                       float             *in_bits,
+                                       uint32             N_in_bits,
+                                       uint32             tbs,
+                                       uint32             tx_mode,
+                                       uint32             N_l,
+                                       uint32             Q_m,
+                                       uint32             rv_idx,
+                                       uint8             *out_bits,
+                                       uint32            *N_out_bits);
+
+/*********************************************************************
+    Name: bch_channel_encode
+
+    Description: Channel encodes the broadcast channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void bch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint8             *in_bits,
+                        uint32             N_in_bits,
+                        uint8              N_ant,
+                        uint8             *out_bits,
+                        uint32            *N_out_bits);
+
+/*********************************************************************
+    Name: bch_channel_decode
+
+    Description: Channel decodes the broadcast channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.1
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM bch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                     float             *in_bits,
+                                     uint32             N_in_bits,
+                                     uint8              N_ant,
+                                     uint8             *out_bits,
+                                     uint32            *N_out_bits);
+
+/*********************************************************************
+    Name: dlsch_channel_encode
+
+    Description: Channel encodes the Downlink Shared Channel.  All
+                 stages operate on packed bits and the output is
+                 packed, most significant bit first.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                          uint8             *in_bits,
+                          uint32             N_in_bits,
+                          uint32             tbs,
+                          uint32             tx_mode,
+                          uint32             rv_idx,
+                          uint32             G,
+                          uint32             N_l,
+                          uint32             Q_m,
+                          uint32             M_dl_harq,
+                          uint32             N_soft,
+                          uint8             *out_bytes,
+                          uint32            *N_out_bits);
+
+/*********************************************************************
+    Name: dlsch_channel_decode
+
+    Description: Channel decodes the Downlink Shared Channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                       float             *in_bits,
+                                       uint32             N_in_bits,
+                                       uint32             tbs,
+                                       uint32             tx_mode,
+                                       uint32             rv_idx,
+                                       uint32             N_l,
+                                       uint32             Q_m,
+                                       uint32             M_dl_harq,
+                                       uint32             N_soft,
+                                       uint8             *out_bits,
+                                       uint32            *N_out_bits);
+
+/*********************************************************************
+    Name: dci_channel_encode
+
+    Description: Channel encodes the Downlink Control Information
+                 channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dci_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint8             *in_bits,
+                        uint32             N_in_bits,
+                        uint16             rnti,
+                        uint8              ue_ant,
+                        uint32             N_out_bits,
+                        uint8             *out_bits);
+
+/*********************************************************************
+    Name: dci_channel_decode
+
+    Description: Channel decodes the Downlink Control Information
+                 channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                     float             *in_bits,
+                                     uint32             N_in_bits,
+                                     uint16             rnti_start,
+                                     uint16             rnti_range,
+                                     uint8              ue_ant,
+                                     uint8             *out_bits,
+                                     uint32             N_out_bits,
+                                     uint16            *rnti_found);
+
+/*********************************************************************
+    Name: dci_0_pack
+
+    Description: Packs all of the fields into the Downlink Control
+                 Information format 0
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.6
+
+    Notes: Currently only handles non-hopping single-cluster
+           assignments
+*********************************************************************/
+// Defines
+#define DCI_0_1A_FLAG_0          0
+#define DCI_0_1A_FLAG_1A         1
+#define DCI_VRB_TYPE_LOCALIZED   0
+#define DCI_VRB_TYPE_DISTRIBUTED 1
+// Enums
+// Structs
+// Functions
+void dci_0_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
+                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                uint32                           N_rb_ul,
+                uint8                            N_ant,
+                uint8                           *out_bits,
+                uint32                          *N_out_bits);
+
+/*********************************************************************
+    Name: dci_0_unpack
+
+    Description: Unpacks all of the fields from the Downlink Control
+                 Information format 0
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.1.1
+                        3GPP TS 36.213 v10.3.0 section 8.6
+
+    Notes: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+// FIXME
+
+/*********************************************************************
+    Name: dci_1a_pack
+
+    Description: Packs all of the fields into the Downlink Control
+                 Information format 1A
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
+
+    Notes: Currently only handles localized virtual resource blocks
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void dci_1a_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
+                 LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                 uint32                           N_rb_dl,
+                 uint8                            N_ant,
+                 uint8                           *out_bits,
+                 uint32                          *N_out_bits);
+
+/*********************************************************************
+    Name: dci_1a_unpack
+
+    Description: Unpacks all of the fields from the Downlink Control
+                 Information format 1A
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
+
+    Notes: Currently only handles localized virtual resource blocks
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM dci_1a_unpack(uint8                           *in_bits,
+                                uint32                           N_in_bits,
+                                LIBLTE_PHY_DCI_CA_PRESENCE_ENUM  ca_presence,
+                                uint16                           rnti,
+                                uint32                           N_rb_dl,
+                                uint8                            N_ant,
+                                LIBLTE_PHY_ALLOCATION_STRUCT    *alloc);
+
+/*********************************************************************
+    Name: dci_1c_pack
+
+    Description: Packs all of the fields into the Downlink Control
+                 Information format 1C
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+// FIXME
+
+/*********************************************************************
+    Name: dci_1c_unpack
+
+    Description: Unpacks all of the fields from the Downlink Control
+                 Information format 1C
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.3.1.4
+                        3GPP TS 36.213 v10.3.0 section 7.1.6.3
+                        3GPP TS 36.213 v10.3.0 section 7.1.7
+
+    Notes: Currently only handling SI-RNTI, P-RNTI, and RA-RNTI
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM dci_1c_unpack(uint8                        *in_bits,
+                                uint32                        N_in_bits,
+                                uint16                        rnti,
+                                uint32                        N_rb_dl,
+                                uint8                         N_ant,
+                                LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
+
+/*********************************************************************
+    Name: cfi_channel_encode
+
+    Description: Channel encodes the Control Format Indicator channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void cfi_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint32             cfi,
+                        uint8             *out_bits,
+                        uint32            *N_out_bits);
+
+/*********************************************************************
+    Name: cfi_channel_decode
+
+    Description: Channel decodes the Control Format Indicator channel
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.4
+*********************************************************************/
+// Defines
+#define CFI_N_ACCEPTABLE_BERS 4
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM cfi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                                     float             *in_bits,
+                                     uint32             N_in_bits,
+                                     uint32            *cfi);
+
+/*********************************************************************
+    Name: get_ulsch_ce
+
+    Description: Resolves channel estimates for the uplink shared
+                 channel and the noise variance of the equalized
+                 symbols.  The noise is estimated from the difference
+                 between adjacent subcarrier DMRS estimates.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void get_ulsch_ce(LIBLTE_PHY_STRUCT *phy_struct,
+                  float             *c_est_0_re,
+                  float             *c_est_0_im,
+                  float             *c_est_1_re,
+                  float             *c_est_1_im,
+                  uint32             N_prb,
+                  uint32             N_subfr,
+                  float             *c_est_re,
+                  float             *c_est_im,
+                  float             *noise_var);
+
+/*********************************************************************
+    Name: get_ulcch_ce
+
+    Description: Resolves channel estimates for the uplink control
+                 channel
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void get_ulcch_ce(LIBLTE_PHY_STRUCT *phy_struct,
+                  float             *c_est_0_re,
+                  float             *c_est_0_im,
+                  float             *c_est_1_re,
+                  float             *c_est_1_im,
+                  uint32             N_subfr,
+                  uint32             N_1_p_pucch,
+                  float             *c_est_re,
+                  float             *c_est_im);
+
+/*********************************************************************
+    Name: get_soft_decision
+
+    Description: Determines the magnitude of the soft decision
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+float get_soft_decision(float rx_re,
+                        float rx_im,
+                        float exp_re,
+                        float exp_im,
+                        float max_dist);
+float get_soft_decision(float rx,
+                        float exp,
+                        float max_dist);
+
+/*********************************************************************
+    Name: get_num_bits_in_prb
+
+    Description: Determines the number of bits available in a
+                 particular PRB with a particular modulation type
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+uint32 get_num_bits_in_prb(uint32                          N_subframe,
+                           uint32                          N_ctrl_symbs,
+                           uint32                          prb,
+                           uint32                          N_rb_dl,
+                           uint8                           N_ant,
+                           LIBLTE_PHY_MODULATION_TYPE_ENUM mod_type);
+
+/*********************************************************************
+    Name: wrap_phase
+
+    Description: Checks the phase difference between two angles and
+                 wraps one to make the difference less than 2*pi.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void wrap_phase(float *phase_1,
+                float  phase_2);
+
+/*******************************************************************************
+                              LIBRARY FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: liblte_phy_init
+
+    Description: Initializes the LTE Physical Layer library.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_init(LIBLTE_PHY_STRUCT  **phy_struct,
+                                  LIBLTE_PHY_FS_ENUM   fs,
+                                  uint16               N_id_cell,
+                                  uint8                N_ant,
+                                  uint32               N_rb_dl,
+                                  uint32               N_sc_rb_dl,
+                                  float                phich_res)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            N_bits;
+    uint32            N_reg;
+    uint32            N_cce;
+    uint32            N_sc;
+    uint32            size;
+    int               N_fft;
+    bool              huge_pages;
+
+    if(phy_struct != NULL)
+    {
+        *phy_struct                  = (LIBLTE_PHY_STRUCT *)phy_mem_alloc(sizeof(LIBLTE_PHY_STRUCT), &huge_pages);
+        (*phy_struct)->huge_pages    = huge_pages;
+        (*phy_struct)->mem_footprint = sizeof(LIBLTE_PHY_STRUCT);
+
+        // Generic
+        switch(fs)
+        {
+        case LIBLTE_PHY_FS_30_72MHZ:
+            (*phy_struct)->fs                = 30720000;
+            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ;
+            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_30_72MHZ;
+            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_30_72MHZ;
+            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ;
+            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ;
+            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_30_72MHZ;
+            (*phy_struct)->N_rb_max          = LIBLTE_PHY_N_RB_DL_20MHZ;
+            break;
+        case LIBLTE_PHY_FS_15_36MHZ:
+            (*phy_struct)->fs                = 15360000;
+            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_15_36MHZ;
+            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_15_36MHZ;
+            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_15_36MHZ;
+            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_15_36MHZ;
+            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_15_36MHZ;
+            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_15_36MHZ;
+            (*phy_struct)->N_rb_max          = LIBLTE_PHY_N_RB_DL_10MHZ;
+            break;
+        case LIBLTE_PHY_FS_7_68MHZ:
+            (*phy_struct)->fs                = 7680000;
+            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_7_68MHZ;
+            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_7_68MHZ;
+            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_7_68MHZ;
+            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_7_68MHZ;
+            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_7_68MHZ;
+            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_7_68MHZ;
+            (*phy_struct)->N_rb_max          = LIBLTE_PHY_N_RB_DL_5MHZ;
+            break;
+        case LIBLTE_PHY_FS_3_84MHZ:
+            (*phy_struct)->fs                = 3840000;
+            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_3_84MHZ;
+            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_3_84MHZ;
+            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_3_84MHZ;
+            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_3_84MHZ;
+            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_3_84MHZ;
+            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_3_84MHZ;
+            (*phy_struct)->N_rb_max          = LIBLTE_PHY_N_RB_DL_3MHZ;
+            break;
+        case LIBLTE_PHY_FS_1_92MHZ:
+            (*phy_struct)->fs                = 1920000;
+            (*phy_struct)->N_samps_per_symb  = LIBLTE_PHY_N_SAMPS_PER_SYMB_1_92MHZ;
+            (*phy_struct)->N_samps_cp_l_0    = LIBLTE_PHY_N_SAMPS_CP_L_0_1_92MHZ;
+            (*phy_struct)->N_samps_cp_l_else = LIBLTE_PHY_N_SAMPS_CP_L_ELSE_1_92MHZ;
+            (*phy_struct)->N_samps_per_slot  = LIBLTE_PHY_N_SAMPS_PER_SLOT_1_92MHZ;
+            (*phy_struct)->N_samps_per_subfr = LIBLTE_PHY_N_SAMPS_PER_SUBFR_1_92MHZ;
+            (*phy_struct)->N_samps_per_frame = LIBLTE_PHY_N_SAMPS_PER_FRAME_1_92MHZ;
+            (*phy_struct)->N_rb_max          = LIBLTE_PHY_N_RB_DL_1_4MHZ;
+            break;
+        }
+        (*phy_struct)->N_sc_rb_dl = N_sc_rb_dl;
+        (*phy_struct)->N_sc_rb_ul = LIBLTE_PHY_N_SC_RB_UL;
+
+        // DL channel estimate, the interpolation weights are generated
+        // by liblte_phy_update_n_rb_dl
+        (*phy_struct)->dl_ce_interp        = LIBLTE_PHY_DL_CE_INTERP_LINEAR;
+        (*phy_struct)->dl_ce_avg_alpha     = 1;
+        (*phy_struct)->dl_ce_avg_N_id_cell = LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN;
+        for(i=0; i<LIBLTE_PHY_N_ANT_MAX; i++)
+        {
+            (*phy_struct)->dl_ce_avg_valid[i] = false;
+        }
+
+        // DL scratch, each PRB carries at most 168 PDSCH resource
+        // elements per antenna, 6 bits in each for up to 2 codewords,
+        // and 11 PDCCH REGs.  The PDCCH encoder always fills the 16
+        // CCEs of the common search space.
+        (*phy_struct)->pdsch_N_re_max = (*phy_struct)->N_rb_max*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP*14;
+        N_bits                        = 6*(*phy_struct)->pdsch_N_re_max;
+        N_reg                         = 11*(*phy_struct)->N_rb_max;
+        if(N_reg > LIBLTE_PHY_PDCCH_N_REGS_MAX)
+        {
+            N_reg = LIBLTE_PHY_PDCCH_N_REGS_MAX;
+        }
+        N_cce = N_reg/LIBLTE_PHY_PDCCH_N_REG_CCE;
+        if(N_cce < 16)
+        {
+            N_cce = 16;
+        }
+        N_sc  = (*phy_struct)->N_rb_max*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP;
+        size  = 2*PHY_ARENA_ROUND(sizeof(float)*(*phy_struct)->pdsch_N_re_max);
+        size += 4*PHY_ARENA_ROUND(sizeof(float)*LIBLTE_PHY_N_ANT_MAX*(*phy_struct)->pdsch_N_re_max);
+        size += 4*PHY_ARENA_ROUND(sizeof(float)*(*phy_struct)->pdsch_N_re_max);
+        size += PHY_ARENA_ROUND(sizeof(float)*N_bits) + PHY_ARENA_ROUND(sizeof(uint32)*N_bits) + PHY_ARENA_ROUND(N_bits);
+        size += 2*PHY_ARENA_ROUND(N_bits/8) + PHY_ARENA_ROUND(2*N_bits/8);
+        size += 6*PHY_ARENA_ROUND(sizeof(float)*4*N_reg);
+        size += 12*LIBLTE_PHY_N_ANT_MAX*PHY_ARENA_ROUND(sizeof(float)*4*N_reg);
+        size += 2*PHY_ARENA_ROUND(sizeof(float)*LIBLTE_PHY_PDCCH_N_RE_CCE*N_cce);
+        size += 4*LIBLTE_PHY_N_ANT_MAX*PHY_ARENA_ROUND(sizeof(float)*LIBLTE_PHY_PDCCH_N_RE_CCE*N_cce);
+        size += (2*5 + 2*6*LIBLTE_PHY_DL_CE_N_TAPS_MAX + 2*LIBLTE_PHY_N_ANT_MAX*5)*PHY_ARENA_ROUND(sizeof(float)*N_sc);
+        size += 6*PHY_ARENA_ROUND(sizeof(uint16)*N_sc);
+        phy_arena_init(&(*phy_struct)->dl_arena, size);
+        (*phy_struct)->mem_footprint += (*phy_struct)->dl_arena.size;
+        (*phy_struct)->pdsch_y_est_re    = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*(*phy_struct)->pdsch_N_re_max);
+        (*phy_struct)->pdsch_y_est_im    = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*(*phy_struct)->pdsch_N_re_max);
+        (*phy_struct)->pdsch_c_est_re[0] = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*LIBLTE_PHY_N_ANT_MAX*(*phy_struct)->pdsch_N_re_max);
+        (*phy_struct)->pdsch_c_est_im[0] = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*LIBLTE_PHY_N_ANT_MAX*(*phy_struct)->pdsch_N_re_max);
+        (*phy_struct)->pdsch_y_re[0]     = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*LIBLTE_PHY_N_ANT_MAX*(*phy_struct)->pdsch_N_re_max);
+        (*phy_struct)->pdsch_y_im[0]     = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*LIBLTE_PHY_N_ANT_MAX*(*phy_struct)->pdsch_N_re_max);
+        for(i=1; i<LIBLTE_PHY_N_ANT_MAX; i++)
+        {
+            (*phy_struct)->pdsch_c_est_re[i] = &(*phy_struct)->pdsch_c_est_re[0][i*(*phy_struct)->pdsch_N_re_max];
+            (*phy_struct)->pdsch_c_est_im[i] = &(*phy_struct)->pdsch_c_est_im[0][i*(*phy_struct)->pdsch_N_re_max];
+            (*phy_struct)->pdsch_y_re[i]     = &(*phy_struct)->pdsch_y_re[0][i*(*phy_struct)->pdsch_N_re_max];
+            (*phy_struct)->pdsch_y_im[i]     = &(*phy_struct)->pdsch_y_im[0][i*(*phy_struct)->pdsch_N_re_max];
+        }
+        (*phy_struct)->pdsch_x_re           = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*(*phy_struct)->pdsch_N_re_max);
+        (*phy_struct)->pdsch_x_im           = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*(*phy_struct)->pdsch_N_re_max);
+        (*phy_struct)->pdsch_d_re           = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*(*phy_struct)->pdsch_N_re_max);
+        (*phy_struct)->pdsch_d_im           = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*(*phy_struct)->pdsch_N_re_max);
+        (*phy_struct)->pdsch_descramb_bits  = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*N_bits);
+        (*phy_struct)->pdsch_c              = (uint32 *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(uint32)*N_bits);
+        (*phy_struct)->pdsch_soft_bits      = (int8 *)phy_arena_get(&(*phy_struct)->dl_arena, N_bits);
+        (*phy_struct)->pdsch_c_bytes        = (uint8 *)phy_arena_get(&(*phy_struct)->dl_arena, N_bits/8);
+        (*phy_struct)->pdsch_encode_bytes   = (uint8 *)phy_arena_get(&(*phy_struct)->dl_arena, N_bits/8);
+        (*phy_struct)->pdsch_scramb_bytes   = (uint8 *)phy_arena_get(&(*phy_struct)->dl_arena, 2*N_bits/8);
+        (*phy_struct)->pdcch_reg_y_est_re   = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+        (*phy_struct)->pdcch_reg_y_est_im   = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+        (*phy_struct)->pdcch_shift_y_est_re = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+        (*phy_struct)->pdcch_shift_y_est_im = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+        (*phy_struct)->pdcch_perm_y_est_re  = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+        (*phy_struct)->pdcch_perm_y_est_im  = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+        (*phy_struct)->pdcch_cce_y_est_re   = (float (*)[LIBLTE_PHY_PDCCH_N_RE_CCE])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*LIBLTE_PHY_PDCCH_N_RE_CCE*N_cce);
+        (*phy_struct)->pdcch_cce_y_est_im   = (float (*)[LIBLTE_PHY_PDCCH_N_RE_CCE])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*LIBLTE_PHY_PDCCH_N_RE_CCE*N_cce);
+        for(i=0; i<LIBLTE_PHY_N_ANT_MAX; i++)
+        {
+            (*phy_struct)->pdcch_reg_c_est_re[i]   = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_reg_c_est_im[i]   = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_shift_c_est_re[i] = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_shift_c_est_im[i] = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_perm_c_est_re[i]  = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_perm_c_est_im[i]  = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_reg_re[i]         = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_reg_im[i]         = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_perm_re[i]        = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_perm_im[i]        = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_shift_re[i]       = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_shift_im[i]       = (float (*)[4])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*4*N_reg);
+            (*phy_struct)->pdcch_cce_c_est_re[i]   = (float (*)[LIBLTE_PHY_PDCCH_N_RE_CCE])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*LIBLTE_PHY_PDCCH_N_RE_CCE*N_cce);
+            (*phy_struct)->pdcch_cce_c_est_im[i]   = (float (*)[LIBLTE_PHY_PDCCH_N_RE_CCE])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*LIBLTE_PHY_PDCCH_N_RE_CCE*N_cce);
+            (*phy_struct)->pdcch_cce_re[i]         = (float (*)[LIBLTE_PHY_PDCCH_N_RE_CCE])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*LIBLTE_PHY_PDCCH_N_RE_CCE*N_cce);
+            (*phy_struct)->pdcch_cce_im[i]         = (float (*)[LIBLTE_PHY_PDCCH_N_RE_CCE])phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*LIBLTE_PHY_PDCCH_N_RE_CCE*N_cce);
+            for(j=0; j<5; j++)
+            {
+                (*phy_struct)->dl_ce_avg_re[i][j] = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*N_sc);
+                (*phy_struct)->dl_ce_avg_im[i][j] = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*N_sc);
+            }
+        }
+        for(i=0; i<5; i++)
+        {
+            (*phy_struct)->dl_ce_re[i] = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*N_sc);
+            (*phy_struct)->dl_ce_im[i] = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*N_sc);
+        }
+        for(i=0; i<6; i++)
+        {
+            for(j=0; j<LIBLTE_PHY_DL_CE_N_TAPS_MAX; j++)
+            {
+                (*phy_struct)->dl_ce_w_re[i][j] = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*N_sc);
+                (*phy_struct)->dl_ce_w_im[i][j] = (float *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(float)*N_sc);
+            }
+            (*phy_struct)->dl_ce_w_idx[i] = (uint16 *)phy_arena_get(&(*phy_struct)->dl_arena, sizeof(uint16)*N_sc);
+        }
+
+        liblte_phy_update_n_rb_dl((*phy_struct), N_rb_dl);
+        (*phy_struct)->N_ant   = N_ant;
+        (*phy_struct)->ul_init = false;
+
+        // PHICH
+        if(LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP == (*phy_struct)->N_sc_rb_dl)
+        {
+            (*phy_struct)->N_group_phich = (uint32)ceilf((float)phich_res*((float)(*phy_struct)->N_rb_dl/(float)8));
+            (*phy_struct)->N_sf_phich    = 4;
+        }else{
+            (*phy_struct)->N_group_phich = 2*(uint32)ceilf((float)phich_res*((float)(*phy_struct)->N_rb_dl/(float)8));
+            (*phy_struct)->N_sf_phich    = 2;
+        }
+
+        // PDCCH Permutation, one per number of PDCCH symbols, recalculated
+        // by liblte_phy_pdcch_channel_encode if the number of REGs changes
+        for(i=1; i<=3; i++)
+        {
+            pdcch_permute_pre_calc(*phy_struct,
+                                   i,
+                                   i*((*phy_struct)->N_rb_dl*3) - (*phy_struct)->N_rb_dl - 4 - (*phy_struct)->N_group_phich*3);
+        }
+        (*phy_struct)->pdcch_permute_N_reg[3] = 0;
+
+        // Turbo decode
+        (*phy_struct)->td_type           = LIBLTE_PHY_TURBO_DECODER_MAX_LOG_MAP;
+        (*phy_struct)->td_kernel         = turbo_kernel_detect();
+        (*phy_struct)->td_max_iterations = LIBLTE_PHY_TURBO_DEFAULT_MAX_ITERATIONS;
+        memset(&(*phy_struct)->td_stats, 0, sizeof(LIBLTE_PHY_TURBO_DECODE_STATS_STRUCT));
+
+        // Code block decoding, workers are started by
+        // liblte_phy_set_decode_threads
+        (*phy_struct)->cbd_ctx.pi_K   = 0;
+        (*phy_struct)->cbd_worker     = NULL;
+        (*phy_struct)->cbd_claim      = 0;
+        (*phy_struct)->cbd_N_workers  = 0;
+        (*phy_struct)->cbd_shutdown   = false;
+
+        // Viterbi decode, tables are calculated on first use
+        memset((*phy_struct)->vd_k7_g, 0, sizeof((*phy_struct)->vd_k7_g));
+
+        // Rate match/unmatch, tables are built on first use
+        for(i=0; i<LIBLTE_PHY_RATE_MATCH_N_TABLES; i++)
+        {
+            (*phy_struct)->rm_table[i].valid = false;
+        }
+        (*phy_struct)->rm_use_count      = 0;
+        (*phy_struct)->rm_N_table_hits   = 0;
+        (*phy_struct)->rm_N_table_misses = 0;
+
+        // PDCCH blind decoding
+        (*phy_struct)->pdcch_N_ue_rntis = 0;
+        memset(&(*phy_struct)->pdcch_stats, 0, sizeof(LIBLTE_PHY_PDCCH_DECODE_STATS_STRUCT));
+
+        // CRS Storage, filled per slot on first use for other cells
+        (*phy_struct)->N_id_cell_crs     = N_id_cell;
+        (*phy_struct)->crs_storage_valid = 0;
+        if(LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN != N_id_cell)
+        {
+            for(i=0; i<20; i++)
+            {
+                generate_crs(i, 0, N_id_cell, N_sc_rb_dl, (*phy_struct)->crs_re_storage[i][0], (*phy_struct)->crs_im_storage[i][0]);
+                generate_crs(i, 1, N_id_cell, N_sc_rb_dl, (*phy_struct)->crs_re_storage[i][1], (*phy_struct)->crs_im_storage[i][1]);
+                generate_crs(i, 4, N_id_cell, N_sc_rb_dl, (*phy_struct)->crs_re_storage[i][2], (*phy_struct)->crs_im_storage[i][2]);
+                (*phy_struct)->crs_storage_valid |= 1 << i;
+            }
+        }
+
+        // Coarse timing, the PSS correlator is allocated when selected
+        (*phy_struct)->dl_timing_method      = LIBLTE_PHY_COARSE_TIMING_METHOD_CP_CORR;
+        (*phy_struct)->dl_pss_corr_in        = NULL;
+        (*phy_struct)->dl_pss_corr_out       = NULL;
+        (*phy_struct)->dl_pss_corr_dec_in    = NULL;
+        (*phy_struct)->dl_pss_corr_dec_out   = NULL;
+
+        // Samples to symbols
+        (*phy_struct)->s2s_in                 = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*(*phy_struct)->N_samps_per_symb*2*20);
+        (*phy_struct)->s2s_out                = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*(*phy_struct)->N_samps_per_symb*2*20);
+        (*phy_struct)->mem_footprint         += 2*sizeof(fftwf_complex)*(*phy_struct)->N_samps_per_symb*2*20;
+        (*phy_struct)->symbs_to_samps_dl_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb,
+                                                                  (*phy_struct)->s2s_in,
+                                                                  (*phy_struct)->s2s_out,
+                                                                  FFTW_BACKWARD,
+                                                                  FFTW_MEASURE);
+        (*phy_struct)->samps_to_symbs_dl_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb,
+                                                                  (*phy_struct)->s2s_in,
+                                                                  (*phy_struct)->s2s_out,
+                                                                  FFTW_FORWARD,
+                                                                  FFTW_MEASURE);
+        (*phy_struct)->symbs_to_samps_ul_plan = fftwf_plan_dft_1d((*phy_struct)->N_samps_per_symb*2,
+                                                                  (*phy_struct)->s2s_in,
+                                                                  (*phy_struct)->s2s_out,
+                                                                  FFTW_BACKWARD,
+                                                                  FFTW_MEASURE);
+
+        // Whole subframes are demodulated with one batched FFT, 16 DL
+        // symbols (two slots plus two symbols of the next subframe) or
+        // 14 UL symbols, each N_samps_per_symb apart in s2s_in/s2s_out
+        N_fft = (*phy_struct)->N_samps_per_symb;
+        (*phy_struct)->samps_to_symbs_dl_subfr_plan = fftwf_plan_many_dft(1, &N_fft, 16,
+                                                                          (*phy_struct)->s2s_in, NULL, 1, N_fft,
+                                                                          (*phy_struct)->s2s_out, NULL, 1, N_fft,
+                                                                          FFTW_FORWARD,
+                                                                          FFTW_MEASURE);
+        (*phy_struct)->samps_to_symbs_ul_subfr_plan = fftwf_plan_many_dft(1, &N_fft, 14,
+                                                                          (*phy_struct)->s2s_in, NULL, 1, N_fft,
+                                                                          (*phy_struct)->s2s_out, NULL, 1, N_fft,
+                                                                          FFTW_FORWARD,
+                                                                          FFTW_MEASURE);
+
+        // The UL subcarriers sit half a subcarrier off the FFT grid,
+        // shift them onto it in the time domain
+        for(i=0; i<(*phy_struct)->N_samps_per_symb; i++)
+        {
+            (*phy_struct)->s2s_ul_rot_re[i] = cosf(-M_PI*i/(*phy_struct)->N_samps_per_symb);
+            (*phy_struct)->s2s_ul_rot_im[i] = sinf(-M_PI*i/(*phy_struct)->N_samps_per_symb);
+        }
+
+        // Keep any new plans for the next run
+        fftw_wisdom_save();
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_phy_ul_init(LIBLTE_PHY_STRUCT *phy_struct,
+                                     uint16             N_id_cell,
+                                     uint32             prach_root_seq_idx,
+                                     uint32             prach_preamble_format,
+                                     uint32             prach_zczc,
+                                     bool               prach_hs_flag,
+                                     uint8              group_assignment_pusch,
+                                     bool               group_hopping_enabled,
+                                     bool               sequence_hopping_enabled,
+                                     uint8              cyclic_shift,
+                                     uint8              cyclic_shift_dci,
+                                     uint8              N_cs_an,
+                                     uint8              delta_pucch_shift)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            N_symb;
+    uint32            N_bits;
+    uint32            N_sc;
+    uint32            size;
+
+    if(phy_struct != NULL)
+    {
+        // PUSCH
+        phy_struct->transform_precoding_in  = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->N_rb_max*LIBLTE_PHY_N_SC_RB_UL);
+        phy_struct->transform_precoding_out = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->N_rb_max*LIBLTE_PHY_N_SC_RB_UL);
+        phy_struct->mem_footprint          += 2*sizeof(fftwf_complex)*phy_struct->N_rb_max*LIBLTE_PHY_N_SC_RB_UL;
+        for(i=0; i<phy_struct->N_rb_ul; i++)
+        {
+            if((i % 2) == 0 ||
+               (i % 3) == 0 ||
+               (i % 5) == 0)
+            {
+                phy_struct->transform_precoding_plan[i]    = fftwf_plan_dft_1d(i*LIBLTE_PHY_N_SC_RB_UL,
+                                                                               phy_struct->transform_precoding_in,
+                                                                               phy_struct->transform_precoding_out,
+                                                                               FFTW_FORWARD,
+                                                                               FFTW_MEASURE);
+                phy_struct->transform_pre_decoding_plan[i] = fftwf_plan_dft_1d(i*LIBLTE_PHY_N_SC_RB_UL,
+                                                                               phy_struct->transform_precoding_in,
+                                                                               phy_struct->transform_precoding_out,
+                                                                               FFTW_BACKWARD,
+                                                                               FFTW_MEASURE);
+            }
+        }
+
+        // PUSCH scratch, each PRB carries at most 144 data symbols
+        N_symb = phy_struct->N_rb_max*LIBLTE_PHY_N_SC_RB_UL*12;
+        if(N_symb > 14400)
+        {
+            N_symb = 14400;
+        }
+        N_bits = 6*phy_struct->N_rb_max*LIBLTE_PHY_N_SC_RB_UL*12;
+        if(N_bits > 28800)
+        {
+            N_bits = 28800;
+        }
+        N_sc = phy_struct->N_rb_max*LIBLTE_PHY_N_SC_RB_UL;
+
+        // PUSCH DMRS, each N_prb only needs N_prb*N_sc_rb_ul values
+        size = 0;
+        for(j=0; j<=phy_struct->N_rb_max; j++)
+        {
+            size += 4*PHY_ARENA_ROUND(sizeof(float)*j*LIBLTE_PHY_N_SC_RB_UL);
+        }
+        size *= LIBLTE_PHY_N_SUBFR_PER_FRAME;
+        size += (10 + 2*LIBLTE_PHY_N_ANT_MAX)*PHY_ARENA_ROUND(sizeof(float)*N_symb);
+        size += 4*PHY_ARENA_ROUND(sizeof(float)*N_sc);
+        size += PHY_ARENA_ROUND(sizeof(float)*N_bits) + PHY_ARENA_ROUND(sizeof(uint32)*N_bits);
+        size += 3*PHY_ARENA_ROUND(N_bits);
+        phy_arena_init(&phy_struct->ul_arena, size);
+        phy_struct->mem_footprint    += phy_struct->ul_arena.size;
+        phy_struct->pusch_z_est_re    = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        phy_struct->pusch_z_est_im    = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        phy_struct->pusch_c_est_0_re  = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_sc);
+        phy_struct->pusch_c_est_0_im  = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_sc);
+        phy_struct->pusch_c_est_1_re  = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_sc);
+        phy_struct->pusch_c_est_1_im  = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_sc);
+        phy_struct->pusch_c_est_re    = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        phy_struct->pusch_c_est_im    = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        for(i=0; i<LIBLTE_PHY_N_ANT_MAX; i++)
+        {
+            phy_struct->pusch_z_re[i] = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+            phy_struct->pusch_z_im[i] = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        }
+        phy_struct->pusch_y_re          = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        phy_struct->pusch_y_im          = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        phy_struct->pusch_x_re          = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        phy_struct->pusch_x_im          = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        phy_struct->pusch_d_re          = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        phy_struct->pusch_d_im          = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_symb);
+        phy_struct->pusch_descramb_bits = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*N_bits);
+        phy_struct->pusch_c             = (uint32 *)phy_arena_get(&phy_struct->ul_arena, sizeof(uint32)*N_bits);
+        phy_struct->pusch_encode_bits   = (uint8 *)phy_arena_get(&phy_struct->ul_arena, N_bits);
+        phy_struct->pusch_scramb_bits   = (uint8 *)phy_arena_get(&phy_struct->ul_arena, N_bits);
+        phy_struct->pusch_soft_bits     = (int8 *)phy_arena_get(&phy_struct->ul_arena, N_bits);
+        for(i=0; i<LIBLTE_PHY_N_SUBFR_PER_FRAME; i++)
+        {
+            for(j=0; j<LIBLTE_PHY_N_RB_UL_MAX; j++)
+            {
+                phy_struct->pusch_dmrs_0_re[i][j] = NULL;
+                phy_struct->pusch_dmrs_0_im[i][j] = NULL;
+                phy_struct->pusch_dmrs_1_re[i][j] = NULL;
+                phy_struct->pusch_dmrs_1_im[i][j] = NULL;
+            }
+            for(j=0; j<=phy_struct->N_rb_max; j++)
+            {
+                phy_struct->pusch_dmrs_0_re[i][j] = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*j*LIBLTE_PHY_N_SC_RB_UL);
+                phy_struct->pusch_dmrs_0_im[i][j] = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*j*LIBLTE_PHY_N_SC_RB_UL);
+                phy_struct->pusch_dmrs_1_re[i][j] = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*j*LIBLTE_PHY_N_SC_RB_UL);
+                phy_struct->pusch_dmrs_1_im[i][j] = (float *)phy_arena_get(&phy_struct->ul_arena, sizeof(float)*j*LIBLTE_PHY_N_SC_RB_UL);
+                generate_dmrs_pusch(phy_struct,
+                                    i,
+                                    N_id_cell,
+                                    group_assignment_pusch,
+                                    cyclic_shift,
+                                    cyclic_shift_dci,
+                                    j,
+                                    0,
+                                    group_hopping_enabled,
+                                    sequence_hopping_enabled,
+                                    phy_struct->pusch_dmrs_0_re[i][j],
+                                    phy_struct->pusch_dmrs_0_im[i][j],
+                                    phy_struct->pusch_dmrs_1_re[i][j],
+                                    phy_struct->pusch_dmrs_1_im[i][j]);
+            }
+        }
+
+        // PUCCH DMRS
+        for(i=0; i<LIBLTE_PHY_N_SUBFR_PER_FRAME; i++)
+        {
+            for(j=0; j<LIBLTE_PHY_N_RB_UL_MAX/2; j++)
+            {
+                generate_dmrs_pucch(phy_struct,
+                                    i,
+                                    N_id_cell,
+                                    group_assignment_pusch,
+                                    group_hopping_enabled,
+                                    sequence_hopping_enabled,
+                                    N_cs_an,
+                                    j,
+                                    delta_pucch_shift+1,
+                                    phy_struct->N_ant,
+                                    phy_struct->pucch_dmrs_0_re[i][j],
+                                    phy_struct->pucch_dmrs_0_im[i][j],
+                                    phy_struct->pucch_dmrs_1_re[i][j],
+                                    phy_struct->pucch_dmrs_1_im[i][j]);
+            }
+        }
+
+        // PRACH
+        prach_preamble_seq_gen(phy_struct,
+                               prach_root_seq_idx,
+                               prach_preamble_format,
+                               prach_zczc,
+                               prach_hs_flag);
+
+        switch(prach_preamble_format)
+        {
+        case 0:
+            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
+            phy_struct->prach_T_seq      = 24576/(30720000/phy_struct->fs);
+            phy_struct->prach_T_cp       = 3168/(30720000/phy_struct->fs);
+            phy_struct->prach_delta_f_RA = 1250;
+            phy_struct->prach_phi        = 7;
+            break;
+        case 1:
+            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
+            phy_struct->prach_T_seq      = 24576/(30720000/phy_struct->fs);
+            phy_struct->prach_T_cp       = 21024/(30720000/phy_struct->fs);
+            phy_struct->prach_delta_f_RA = 1250;
+            phy_struct->prach_phi        = 7;
+            break;
+        case 2:
+            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
+            phy_struct->prach_T_seq      = 2*24576/(30720000/phy_struct->fs);
+            phy_struct->prach_T_cp       = 6240/(30720000/phy_struct->fs);
+            phy_struct->prach_delta_f_RA = 1250;
+            phy_struct->prach_phi        = 7;
+            break;
+        case 3:
+            phy_struct->prach_T_fft      = 24576/(30720000/phy_struct->fs);
+            phy_struct->prach_T_seq      = 2*24576/(30720000/phy_struct->fs);
+            phy_struct->prach_T_cp       = 21024/(30720000/phy_struct->fs);
+            phy_struct->prach_delta_f_RA = 1250;
+            phy_struct->prach_phi        = 7;
+            break;
+        case 4:
+        default:
+            phy_struct->prach_T_fft      = 4096/(30720000/phy_struct->fs);
+            phy_struct->prach_T_seq      = 4096/(30720000/phy_struct->fs);
+            phy_struct->prach_T_cp       = 448/(30720000/phy_struct->fs);
+            phy_struct->prach_delta_f_RA = 7500;
+            phy_struct->prach_phi        = 2;
+            break;
+        }
+        phy_struct->prach_dft_in    = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_N_zc);
+        phy_struct->prach_dft_out   = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_N_zc);
+        phy_struct->prach_fft_in    = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_T_fft);
+        phy_struct->prach_fft_out   = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_T_fft);
+        phy_struct->mem_footprint  += 2*sizeof(fftwf_complex)*(phy_struct->prach_N_zc + phy_struct->prach_T_fft);
+        phy_struct->prach_dft_plan  = fftwf_plan_dft_1d(phy_struct->prach_N_zc,
+                                                        phy_struct->prach_dft_in,
+                                                        phy_struct->prach_dft_out,
+                                                        FFTW_FORWARD,
+                                                        FFTW_MEASURE);
+        phy_struct->prach_ifft_plan = fftwf_plan_dft_1d(phy_struct->prach_T_fft,
+                                                        phy_struct->prach_fft_in,
+                                                        phy_struct->prach_fft_out,
+                                                        FFTW_BACKWARD,
+                                                        FFTW_MEASURE);
+        phy_struct->prach_idft_plan = fftwf_plan_dft_1d(phy_struct->prach_N_zc,
+                                                        phy_struct->prach_dft_in,
+                                                        phy_struct->prach_dft_out,
+                                                        FFTW_BACKWARD,
+                                                        FFTW_MEASURE);
+        for(i=0; i<phy_struct->prach_N_x_u; i++)
+        {
+            for(j=0; j<phy_struct->prach_N_zc; j++)
+            {
+                phy_struct->prach_dft_in[j][0] = phy_struct->prach_x_u_re[i][j];
+                phy_struct->prach_dft_in[j][1] = phy_struct->prach_x_u_im[i][j];
+            }
+            fftwf_execute(phy_struct->prach_dft_plan);
+            for(j=0; j<phy_struct->prach_N_zc; j++)
+            {
+                phy_struct->prach_x_u_fft_re[i][j] = phy_struct->prach_dft_out[j][0];
+                phy_struct->prach_x_u_fft_im[i][j] = phy_struct->prach_dft_out[j][1];
+            }
+        }
+
+        // PRACH decimating front end, a Blackman windowed sinc low pass
+        // filter that keeps the PRACH band and feeds a 1.92MHz FFT
+        phy_struct->prach_dec_factor = phy_struct->fs/LIBLTE_PHY_PRACH_DEC_FS;
+        phy_struct->prach_dec_N_fft  = phy_struct->prach_T_fft/phy_struct->prach_dec_factor;
+        if(1 == phy_struct->prach_dec_factor)
+        {
+            phy_struct->prach_dec_N_taps = 1;
+        }else{
+            phy_struct->prach_dec_N_taps = LIBLTE_PHY_PRACH_DEC_TAPS_PER_PHASE*phy_struct->prach_dec_factor + 1;
+        }
+        prach_dec_filter_gen(phy_struct);
+        phy_struct->prach_dec_freq_offset = 0xFFFFFFFF;
+        phy_struct->prach_dec_fft_in      = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_dec_N_fft);
+        phy_struct->prach_dec_fft_out     = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*phy_struct->prach_dec_N_fft);
+        phy_struct->mem_footprint        += 2*sizeof(fftwf_complex)*phy_struct->prach_dec_N_fft;
+        phy_struct->prach_dec_fft_plan    = fftwf_plan_dft_1d(phy_struct->prach_dec_N_fft,
+                                                              phy_struct->prach_dec_fft_in,
+                                                              phy_struct->prach_dec_fft_out,
+                                                              FFTW_FORWARD,
+                                                              FFTW_MEASURE);
+        phy_struct->prach_threshold = LIBLTE_PHY_PRACH_DEFAULT_THRESHOLD;
+        memset(&phy_struct->prach_stats, 0, sizeof(LIBLTE_PHY_PRACH_DETECT_STATS_STRUCT));
+
+        // Keep any new plans for the next run
+        fftw_wisdom_save();
+
+        // Generic
+        phy_struct->ul_init = true;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_cleanup
+
+    Description: Cleans up the LTE Physical Layer library.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_cleanup(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL)
+    {
+        // Code block decoding
+        stop_code_block_workers(phy_struct);
+
+        // Samples to symbols
+        fftwf_destroy_plan(phy_struct->samps_to_symbs_dl_plan);
+        fftwf_destroy_plan(phy_struct->symbs_to_samps_dl_plan);
+        fftwf_destroy_plan(phy_struct->symbs_to_samps_ul_plan);
+        fftwf_destroy_plan(phy_struct->samps_to_symbs_dl_subfr_plan);
+        fftwf_destroy_plan(phy_struct->samps_to_symbs_ul_subfr_plan);
+        fftwf_free(phy_struct->s2s_in);
+        fftwf_free(phy_struct->s2s_out);
+
+        // Coarse timing
+        if(NULL != phy_struct->dl_pss_corr_in)
+        {
+            fftwf_destroy_plan(phy_struct->dl_pss_corr_fft_plan);
+            fftwf_destroy_plan(phy_struct->dl_pss_corr_ifft_plan);
+            fftwf_free(phy_struct->dl_pss_corr_in);
+            fftwf_free(phy_struct->dl_pss_corr_out);
+            fftwf_free(phy_struct->dl_pss_corr_dec_in);
+            fftwf_free(phy_struct->dl_pss_corr_dec_out);
+        }
+
+        // DL scratch
+        phy_arena_free(&phy_struct->dl_arena);
+
+        phy_mem_free(phy_struct, sizeof(LIBLTE_PHY_STRUCT), phy_struct->huge_pages);
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_phy_ul_cleanup(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(phy_struct != NULL &&
+       phy_struct->ul_init)
+    {
+        // PRACH
+        fftwf_destroy_plan(phy_struct->prach_idft_plan);
+        fftwf_destroy_plan(phy_struct->prach_dec_fft_plan);
+        fftwf_destroy_plan(phy_struct->prach_ifft_plan);
+        fftwf_destroy_plan(phy_struct->prach_dft_plan);
+        fftwf_free(phy_struct->prach_dft_in);
+        fftwf_free(phy_struct->prach_dft_out);
+        fftwf_free(phy_struct->prach_fft_in);
+        fftwf_free(phy_struct->prach_fft_out);
+        fftwf_free(phy_struct->prach_dec_fft_in);
+        fftwf_free(phy_struct->prach_dec_fft_out);
+
+        // PUSCH
+        for(i=0; i<phy_struct->N_rb_ul; i++)
+        {
+            if((i % 2) == 0 ||
+               (i % 3) == 0 ||
+               (i % 5) == 0)
+            {
+                fftwf_destroy_plan(phy_struct->transform_precoding_plan[i]);
+                fftwf_destroy_plan(phy_struct->transform_pre_decoding_plan[i]);
+            }
+        }
+        fftwf_free(phy_struct->transform_precoding_in);
+        fftwf_free(phy_struct->transform_precoding_out);
+
+        // PUSCH scratch and DMRS
+        phy_struct->mem_footprint -= phy_struct->ul_arena.size;
+        phy_arena_free(&phy_struct->ul_arena);
+
+        // Generic
+        phy_struct->mem_footprint -= 2*sizeof(fftwf_complex)*(phy_struct->N_rb_max*LIBLTE_PHY_N_SC_RB_UL +
+                                                              phy_struct->prach_N_zc                      +
+                                                              phy_struct->prach_T_fft                     +
+                                                              phy_struct->prach_dec_N_fft);
+        phy_struct->ul_init        = false;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_update_n_rb_dl
+
+    Description: Updates N_rb_dl and all associated variables.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_update_n_rb_dl(LIBLTE_PHY_STRUCT *phy_struct,
+                                            uint32             N_rb_dl)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            used_subcarriers;
+
+    if(phy_struct != NULL)
+    {
+        used_subcarriers = N_rb_dl*phy_struct->N_sc_rb_dl;
+        switch(phy_struct->N_samps_per_symb)
+        {
+        case LIBLTE_PHY_N_SAMPS_PER_SYMB_30_72MHZ:
+            phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_30_72MHZ;
+            err                  = LIBLTE_SUCCESS;
+            break;
+        case LIBLTE_PHY_N_SAMPS_PER_SYMB_15_36MHZ:
+            if(LIBLTE_PHY_N_RB_DL_10MHZ  == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_5MHZ   == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
+            {
+                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_15_36MHZ;
+                err                  = LIBLTE_SUCCESS;
+            }
+            break;
+        case LIBLTE_PHY_N_SAMPS_PER_SYMB_7_68MHZ:
+            if(LIBLTE_PHY_N_RB_DL_5MHZ   == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
+            {
+                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_7_68MHZ;
+                err                  = LIBLTE_SUCCESS;
+            }
+            break;
+        case LIBLTE_PHY_N_SAMPS_PER_SYMB_3_84MHZ:
+            if(LIBLTE_PHY_N_RB_DL_3MHZ   == N_rb_dl ||
+               LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
+            {
+                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_3_84MHZ;
+                err                  = LIBLTE_SUCCESS;
+            }
+            break;
+        case LIBLTE_PHY_N_SAMPS_PER_SYMB_1_92MHZ:
+            if(LIBLTE_PHY_N_RB_DL_1_4MHZ == N_rb_dl)
+            {
+                phy_struct->FFT_size = LIBLTE_PHY_FFT_SIZE_1_92MHZ;
+                err                  = LIBLTE_SUCCESS;
+            }
+            break;
+        }
+
+        if(LIBLTE_SUCCESS == err)
+        {
+            phy_struct->N_rb_dl      = N_rb_dl;
+            phy_struct->N_rb_ul      = N_rb_dl;
+            phy_struct->FFT_pad_size = (phy_struct->FFT_size - used_subcarriers)/2;
+            dl_ce_weights_gen(phy_struct);
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_fftw_wisdom_file
+
+    Description: Sets the file used to keep FFTW wisdom between runs
+                 and imports the wisdom already saved in it.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_fftw_wisdom_file(const char *file_name)
+{
+    LIBLTE_ERROR_ENUM  err         = LIBLTE_SUCCESS;
+    FILE              *cpuinfo;
+    FILE              *wisdom;
+    struct stat        st;
+    char              *wisdom_file = fftw_wisdom_file_name();
+    char               line[256];
+    char               cpu[128]    = "unknown";
+    char              *value;
+    uint32             len;
+    uint32             i;
+    int                fd;
+
+    wisdom_file[0] = '\0';
+    if(NULL != file_name &&
+       '\0' != file_name[0])
+    {
+        // Key the file by CPU model and FFTW version, wisdom measured
+        // on one is not valid for the other
+        cpuinfo = fopen("/proc/cpuinfo", "r");
+        if(NULL != cpuinfo)
+        {
+            while(NULL != fgets(line, sizeof(line), cpuinfo))
+            {
+                value = strchr(line, ':');
+                if(0    == strncmp(line, "model name", 10) &&
+                   NULL != value)
+                {
+                    value += strspn(value+1, " \t") + 1;
+                    value[strcspn(value, "\n")] = '\0';
+                    snprintf(cpu, sizeof(cpu), "%s", value);
+                    break;
+                }
+            }
+            fclose(cpuinfo);
+        }
+        len = strlen(file_name);
+        if(len + 1 + strlen(fftwf_version) + 1 + strlen(cpu) < LIBLTE_PHY_FFTW_WISDOM_FILE_NAME_MAX)
+        {
+            snprintf(wisdom_file, LIBLTE_PHY_FFTW_WISDOM_FILE_NAME_MAX, "%s.%s.%s", file_name, fftwf_version, cpu);
+            for(i=len; '\0' != wisdom_file[i]; i++)
+            {
+                if(!((wisdom_file[i] >= '0' && wisdom_file[i] <= '9') ||
+                     (wisdom_file[i] >= 'A' && wisdom_file[i] <= 'Z') ||
+                     (wisdom_file[i] >= 'a' && wisdom_file[i] <= 'z') ||
+                     wisdom_file[i] == '.'                              ||
+                     wisdom_file[i] == '-'))
+                {
+                    wisdom_file[i] = '_';
+                }
+            }
+
+            // The file does not exist until the first save.  Only
+            // import wisdom that no other user could have written
+            fd = open(wisdom_file, O_RDONLY | O_NOFOLLOW);
+            if(-1 != fd)
+            {
+                if(0          == fstat(fd, &st)   &&
+                   S_ISREG(st.st_mode)            &&
+                   geteuid()  == st.st_uid        &&
+                   0          == (st.st_mode & (S_IWGRP | S_IWOTH)) &&
+                   NULL       != (wisdom = fdopen(fd, "r")))
+                {
+                    fftwf_import_wisdom_from_file(wisdom);
+                    fclose(wisdom);
+                }else{
+                    close(fd);
+                }
+            }
+        }else{
+            err = LIBLTE_ERROR_INVALID_INPUTS;
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_plan_all_fftw_wisdom
+
+    Description: Plans the FFTs of every sample rate and bandwidth and
+                 saves the wisdom to the wisdom file.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_plan_all_fftw_wisdom(void)
+{
+    LIBLTE_PHY_STRUCT *phy_struct;
+    LIBLTE_ERROR_ENUM  err                                = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32             N_rb_dl_max[LIBLTE_PHY_FS_N_ITEMS] = {LIBLTE_PHY_N_RB_DL_1_4MHZ,
+                                                             LIBLTE_PHY_N_RB_DL_3MHZ,
+                                                             LIBLTE_PHY_N_RB_DL_5MHZ,
+                                                             LIBLTE_PHY_N_RB_DL_10MHZ,
+                                                             LIBLTE_PHY_N_RB_DL_20MHZ};
+    uint32             i;
+
+    if('\0' != fftw_wisdom_file_name()[0])
+    {
+        // The OFDM and PRACH plans only depend on the sample rate and
+        // the transform precoding plans cover every PUSCH allocation
+        // up to N_rb_ul, so the widest bandwidth of each sample rate
+        // covers all of them
+        for(i=0; i<LIBLTE_PHY_FS_N_ITEMS; i++)
+        {
+            liblte_phy_init(&phy_struct,
+                            (LIBLTE_PHY_FS_ENUM)i,
+                            0,
+                            1,
+                            N_rb_dl_max[i],
+                            LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                            1);
+            liblte_phy_ul_init(phy_struct, 0, 0, 0, 1, false, 0, false, false, 0, 0, 0, 1);
+            liblte_phy_set_coarse_timing_method(phy_struct, LIBLTE_PHY_COARSE_TIMING_METHOD_PSS_CORR);
+            liblte_phy_ul_cleanup(phy_struct);
+            liblte_phy_cleanup(phy_struct);
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_huge_pages
+
+    Description: Selects whether PHY contexts are backed by huge pages.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_huge_pages(bool enable)
+{
+    *phy_huge_pages() = enable;
+
+    return(LIBLTE_SUCCESS);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_turbo_decoder
+
+    Description: Selects the turbo decoder used by the PUSCH and
+                 PDSCH channel decoders and the maximum number of
+                 decoder iterations.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_turbo_decoder(LIBLTE_PHY_STRUCT             *phy_struct,
+                                               LIBLTE_PHY_TURBO_DECODER_ENUM  type,
+                                               uint32                         max_iterations)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct     != NULL                            &&
+       type           <  LIBLTE_PHY_TURBO_DECODER_N_ITEMS &&
+       max_iterations >  0                               &&
+       max_iterations <= LIBLTE_PHY_TURBO_MAX_ITERATIONS)
+    {
+        phy_struct->td_type           = type;
+        phy_struct->td_max_iterations = max_iterations;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_turbo_kernel
+
+    Description: Selects the trellis kernel used by the Max-Log-MAP
+                 turbo decoder and the K=7 Viterbi decoder.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_turbo_kernel(LIBLTE_PHY_STRUCT            *phy_struct,
+                                              LIBLTE_PHY_TURBO_KERNEL_ENUM  kernel)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL &&
+       kernel     <= turbo_kernel_detect())
+    {
+        phy_struct->td_kernel = kernel;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_decode_threads
+
+    Description: Sets the number of threads decoding the code blocks
+                 of a PUSCH or PDSCH transport block in parallel,
+                 including the calling thread.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_decode_threads(LIBLTE_PHY_STRUCT *phy_struct,
+                                                uint32             N_threads,
+                                                int32              first_cpu)
+{
+    LIBLTE_ERROR_ENUM                   err = LIBLTE_ERROR_INVALID_INPUTS;
+    LIBLTE_PHY_CB_DECODE_WORKER_STRUCT *worker;
+    uint32                              N_cpus;
+    uint32                              i;
+
+    if(phy_struct != NULL &&
+       N_threads  >  0    &&
+       N_threads  <= LIBLTE_PHY_MAX_N_CODE_BLOCKS)
+    {
+        stop_code_block_workers(phy_struct);
+
+        if(N_threads > 1)
+        {
+            phy_struct->cbd_mem_size = sizeof(LIBLTE_PHY_CB_DECODE_WORKER_STRUCT)*(N_threads-1);
+            phy_struct->cbd_worker   = (LIBLTE_PHY_CB_DECODE_WORKER_STRUCT *)phy_mem_alloc(phy_struct->cbd_mem_size,
+                                                                                           &phy_struct->cbd_huge_pages);
+            if(NULL == phy_struct->cbd_worker)
+            {
+                return(LIBLTE_ERROR_INVALID_INPUTS);
+            }
+            N_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+            for(i=0; i<N_threads-1; i++)
+            {
+                worker             = &phy_struct->cbd_worker[i];
+                worker->ctx.pi_K   = 0;
+                worker->phy_struct = phy_struct;
+                worker->cpu        = -1;
+                if(first_cpu >= 0)
+                {
+                    worker->cpu = (first_cpu + i) % N_cpus;
+                }
+                sem_init(&worker->start_sem, 0, 0);
+                if(0 != pthread_create(&worker->thread, NULL, decode_code_block_worker, worker))
+                {
+                    sem_destroy(&worker->start_sem);
+                    break;
+                }
+                phy_struct->cbd_N_workers++;
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_coarse_timing_method
+
+    Description: Selects how liblte_phy_dl_find_coarse_timing_and_freq_offset
+                 searches for eNBs.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_coarse_timing_method(LIBLTE_PHY_STRUCT                    *phy_struct,
+                                                      LIBLTE_PHY_COARSE_TIMING_METHOD_ENUM  method)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL &&
+       method     <  LIBLTE_PHY_COARSE_TIMING_METHOD_N_ITEMS)
+    {
+        if(LIBLTE_PHY_COARSE_TIMING_METHOD_PSS_CORR == method &&
+           NULL                                     == phy_struct->dl_pss_corr_in)
+        {
+            pss_corr_init(phy_struct);
+            fftw_wisdom_save();
+        }
+        phy_struct->dl_timing_method = method;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_dl_channel_estimator
+
+    Description: Selects the frequency interpolation used between CRSs
+                 by liblte_phy_get_dl_subframe_and_ce and the weight
+                 given to the current subframe when averaging the CRS
+                 channel estimates across subframes.  A time_avg_alpha
+                 of 1 disables averaging.  Changing either restarts
+                 the averaging.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_dl_channel_estimator(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                      LIBLTE_PHY_DL_CE_INTERP_ENUM  interp,
+                                                      float                         time_avg_alpha)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(phy_struct     != NULL                            &&
+       interp         <  LIBLTE_PHY_DL_CE_INTERP_N_ITEMS &&
+       time_avg_alpha >  0                               &&
+       time_avg_alpha <= 1)
+    {
+        if(interp != phy_struct->dl_ce_interp)
+        {
+            phy_struct->dl_ce_interp = interp;
+            dl_ce_weights_gen(phy_struct);
+        }
+        phy_struct->dl_ce_avg_alpha = time_avg_alpha;
+        for(i=0; i<LIBLTE_PHY_N_ANT_MAX; i++)
+        {
+            phy_struct->dl_ce_avg_valid[i] = false;
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_prach_threshold
+
+    Description: Sets the PRACH detection threshold, as a ratio of the
+                 correlation peak power to the per root noise floor.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_prach_threshold(LIBLTE_PHY_STRUCT *phy_struct,
+                                                 float              threshold)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL &&
+       threshold  >  1)
+    {
+        phy_struct->prach_threshold = threshold;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_set_pdcch_ue_rntis
+
+    Description: Sets the RNTIs whose UE specific search spaces are
+                 searched by liblte_phy_pdcch_channel_decode.
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 9.1.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_set_pdcch_ue_rntis(LIBLTE_PHY_STRUCT *phy_struct,
+                                                uint16            *rntis,
+                                                uint32             N_rntis)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+
+    if(phy_struct != NULL                      &&
+       (rntis     != NULL || 0 == N_rntis)     &&
+       N_rntis    <= LIBLTE_PHY_PDCCH_MAX_UE_RNTIS)
+    {
+        for(i=0; i<N_rntis; i++)
+        {
+            phy_struct->pdcch_ue_rntis[i] = rntis[i];
+        }
+        phy_struct->pdcch_N_ue_rntis = N_rntis;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pusch_channel_encode
+
+    Description: Encodes and modulates the Physical Uplink Shared
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+
+    Notes: Only handling normal CP and N_ant=1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_encode(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                                  uint32                        N_id_cell,
+                                                  uint8                         N_ant,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            p;
+    uint32            L;
+    uint32            idx;
+    uint32            c_init;
+    uint32            N_bits;
+    uint32            M_symb;
+    uint32            M_layer_symb;
+    uint32            M_ap_symb;
+    uint32            M_pusch_sc = alloc->N_prb*phy_struct->N_sc_rb_ul;
+    uint32            Q_m;
+    uint32            N_ul_symb = 7; // FIXME: Only handling normal CP
+
+    if(phy_struct != NULL &&
+       alloc      != NULL &&
+       subframe   != NULL)
+    {
+        // Determine Q_m
+        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
+        {
+            Q_m = 1;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
+            Q_m = 2;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
+            Q_m = 4;
+        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
+            Q_m = 6;
+        }
+
+        // Encode the PUSCH
+        ulsch_channel_encode(phy_struct,
+                             alloc->msg[0].msg,
+                             alloc->msg[0].N_bits,
+                             alloc->tbs,
+                             alloc->tx_mode,
+                             alloc->N_prb*phy_struct->N_sc_rb_ul*(N_ul_symb-1)*2,
+                             alloc->N_layers,
+                             Q_m,
+                             alloc->rv_idx,
+                             phy_struct->pusch_encode_bits,
+                             &N_bits);
+        // FIXME: Only handling 1 codeword
+        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
+        generate_prs_c(c_init, N_bits, phy_struct->pusch_c);
+        for(i=0; i<N_bits; i++)
+        {
+            phy_struct->pusch_scramb_bits[i] = phy_struct->pusch_encode_bits[i] ^ phy_struct->pusch_c[i];
+        }
+        modulation_mapper(phy_struct->pusch_scramb_bits,
+                          N_bits,
+                          alloc->mod_type,
+                          phy_struct->pusch_d_re,
+                          phy_struct->pusch_d_im,
+                          &M_symb);
+        layer_mapper_ul(phy_struct->pusch_d_re,
+                        phy_struct->pusch_d_im,
+                        M_symb,
+                        N_ant,
+                        alloc->N_codewords,
+                        phy_struct->pusch_x_re,
+                        phy_struct->pusch_x_im,
+                        &M_layer_symb);
+        transform_precoding(phy_struct,
+                            phy_struct->pusch_x_re,
+                            phy_struct->pusch_x_im,
+                            M_layer_symb,
+                            alloc->N_prb,
+                            N_ant,
+                            alloc->N_codewords,
+                            phy_struct->pusch_y_re,
+                            phy_struct->pusch_y_im);
+        pre_coder_ul(phy_struct->pusch_y_re,
+                     phy_struct->pusch_y_im,
+                     M_layer_symb,
+                     N_ant,
+                     alloc->N_layers,
+                     phy_struct->pusch_z_re[0],
+                     phy_struct->pusch_z_im[0],
+                     &M_ap_symb);
+
+        // Map to physical resources
+        for(p=0; p<N_ant; p++)
+        {
+            idx = 0;
+            for(L=0; L<14; L++)
+            {
+                if(3 == L)
+                {
+                    // DMRS 0
+                    for(j=0; j<M_pusch_sc; j++)
+                    {
+                        liblte_phy_set_tx_symb(subframe, p, L, j, phy_struct->pusch_dmrs_0_re[subframe->num][alloc->N_prb][j], phy_struct->pusch_dmrs_0_im[subframe->num][alloc->N_prb][j]);
+                    }
+                }else if(10 == L){
+                    // DMRS 1
+                    for(j=0; j<M_pusch_sc; j++)
+                    {
+                        liblte_phy_set_tx_symb(subframe, p, L, j, phy_struct->pusch_dmrs_1_re[subframe->num][alloc->N_prb][j], phy_struct->pusch_dmrs_1_im[subframe->num][alloc->N_prb][j]);
+                    }
+                }else{
+                    // PUSCH
+                    for(j=0; j<M_pusch_sc; j++)
+                    {
+                        liblte_phy_set_tx_symb(subframe, p, L, j, phy_struct->pusch_z_re[p][idx], phy_struct->pusch_z_im[p][idx]);
+                        idx++;
+                    }
+                }
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pusch_channel_decode
+
+    Description: Demodulates and decodes the Physical Uplink Shared
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3
+
+    Notes: Only handles normal CP
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
+                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                                  uint32                        N_id_cell,
+                                                  uint8                         N_ant,
+                                                  uint8                        *out_bits,
+                                                  uint32                       *N_out_bits)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             noise_var;
+    uint32            i;
+    uint32            j;
+    uint32            L;
+    uint32            prb_idx;
+    uint32            z_idx;
+    uint32            c_idx_0;
+    uint32            c_idx_1;
+    uint32            M_layer_symb;
+    uint32            M_symb;
+    uint32            N_bits;
+    uint32            c_init;
+    uint32            Q_m;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL &&
+       alloc      != NULL &&
+       out_bits   != NULL &&
+       N_out_bits != NULL &&
+       phy_struct->ul_init)
+    {
+        // FIXME: Timing
+
+        // Extract resource elements and construct channel estimate
+        z_idx   = 0;
+        c_idx_0 = 0;
+        c_idx_1 = 0;
+        for(L=0; L<14; L++)
+        {
+            for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
+            {
+                i = alloc->prb[L/7][prb_idx];
+                for(j=0; j<phy_struct->N_sc_rb_ul; j++)
+                {
+                    if(3 == L)
+                    {
+                        phy_struct->pusch_c_est_0_re[c_idx_0] = liblte_phy_rx_symb_re(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                        phy_struct->pusch_c_est_0_im[c_idx_0] = liblte_phy_rx_symb_im(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                        c_idx_0++;
+                    }else if(10 == L){
+                        phy_struct->pusch_c_est_1_re[c_idx_1] = liblte_phy_rx_symb_re(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                        phy_struct->pusch_c_est_1_im[c_idx_1] = liblte_phy_rx_symb_im(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                        c_idx_1++;
+                    }else{
+                        phy_struct->pusch_z_est_re[z_idx] = liblte_phy_rx_symb_re(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                        phy_struct->pusch_z_est_im[z_idx] = liblte_phy_rx_symb_im(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                        z_idx++;
+                    }
+                }
+            }
+        }
+        get_ulsch_ce(phy_struct,
+                     phy_struct->pusch_c_est_0_re,
+                     phy_struct->pusch_c_est_0_im,
+                     phy_struct->pusch_c_est_1_re,
+                     phy_struct->pusch_c_est_1_im,
+                     alloc->N_prb,
+                     subframe->num,
+                     phy_struct->pusch_c_est_re,
+                     phy_struct->pusch_c_est_im,
+                     &noise_var);
+        pre_decoder_and_matched_filter_ul(phy_struct->pusch_z_est_re,
+                                          phy_struct->pusch_z_est_im,
+                                          phy_struct->pusch_c_est_re,
+                                          phy_struct->pusch_c_est_im,
+                                          z_idx,
+                                          N_ant,
+                                          alloc->N_layers,
+                                          phy_struct->pusch_y_re,
+                                          phy_struct->pusch_y_im,
+                                          &M_layer_symb);
+        transform_pre_decoding(phy_struct,
+                               phy_struct->pusch_y_re,
+                               phy_struct->pusch_y_im,
+                               M_layer_symb,
+                               alloc->N_prb,
+                               N_ant,
+                               alloc->N_codewords,
+                               phy_struct->pusch_x_re,
+                               phy_struct->pusch_x_im);
+        layer_demapper_ul(phy_struct->pusch_x_re,
+                          phy_struct->pusch_x_im,
+                          M_layer_symb,
+                          N_ant,
+                          alloc->N_codewords,
+                          phy_struct->pusch_d_re,
+                          phy_struct->pusch_d_im,
+                          &M_symb);
+        modulation_demapper(phy_struct->pusch_d_re,
+                            phy_struct->pusch_d_im,
+                            M_symb,
+                            alloc->mod_type,
+                            noise_var,
+                            phy_struct->pusch_soft_bits,
+                            &N_bits);
+        // FIXME: Only handling 1 codewords
+        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
+        generate_prs_c(c_init, N_bits, phy_struct->pusch_c);
+        for(i=0; i<N_bits; i++)
+        {
+            phy_struct->pusch_descramb_bits[i] = (float)phy_struct->pusch_soft_bits[i]*(1-2*(float)phy_struct->pusch_c[i]);
+        }
+        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
+        {
+            Q_m = 1;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
+            Q_m = 2;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
+            Q_m = 4;
+        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
+            Q_m = 6;
+        }
+        if(LIBLTE_SUCCESS == ulsch_channel_decode(phy_struct,
+                                                  phy_struct->pusch_descramb_bits,
+                                                  N_bits,
+                                                  alloc->tbs,
+                                                  alloc->tx_mode,
+                                                  alloc->N_layers,
+                                                  Q_m,
+                                                  alloc->rv_idx,
+                                                  out_bits,
+                                                  N_out_bits))
+        {
+            err = LIBLTE_SUCCESS;
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pucch_format_1_1a_1b_channel_encode
+
+    Description: Encodes and modulates the Physical Uplink Control
+                 Channel for formats 1, 1a, and 1b
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4.1
+                        3GPP TS 36.212 v10.1.0 section 5.2.3
+
+    Notes: Only handling normal CP and N_ant=1
+*********************************************************************/
+// FIXME
+
+/*********************************************************************
+    Name: liblte_phy_pucch_format_1_1a_1b_channel_decode
+
+    Description: Demodulates and decodes the Physical Uplink Control
+                 Channel for formats 1, 1a, and 1b
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4.1
+                        3GPP TS 36.212 v10.1.0 section 5.2.3
+
+    Notes: Only handling normal CP and N_ant=1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pucch_format_1_1a_1b_channel_decode(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                                 LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
+                                                                 LIBLTE_PHY_PUCCH_FORMAT_ENUM  format,
+                                                                 uint32                        N_id_cell,
+                                                                 uint8                         N_ant,
+                                                                 uint32                        N_1_p_pucch,
+                                                                 uint8                        *out_bits,
+                                                                 uint32                       *N_out_bits)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            m_prime;
+    uint32            i;
+    uint32            j;
+    uint32            L;
+    uint32            z_idx;
+    uint32            c_idx_0;
+    uint32            c_idx_1;
+    uint32            M_layer_symb;
+    uint32            idx;
+    uint32            symb_num;
+    uint32            N_pucch_sf = 4;
+    float             s_ns_re[2];
+    float             s_ns_im[2];
+    float             s_w_re;
+    float             s_w_im;
+    float             s_w_r_re;
+    float             s_w_r_im;
+    float             denom;
+    float             d_re;
+    float             d_im;
+    float             sd;
+    float             r_u_v_re;
+    float             r_u_v_im;
+    float             ang;
+
+    if(phy_struct != NULL                        &&
+       subframe   != NULL                        &&
+       (format    == LIBLTE_PHY_PUCCH_FORMAT_1   ||
+        format    == LIBLTE_PHY_PUCCH_FORMAT_1A  ||
+        format    == LIBLTE_PHY_PUCCH_FORMAT_1B) &&
+       out_bits   != NULL                        &&
+       N_out_bits != NULL)
+    {
+        // Extract resource elements and construct channel estimate
+        z_idx   = 0;
+        c_idx_0 = 0;
+        c_idx_1 = 0;
+        for(L=0; L<14; L++)
+        {
+            if(7 > L)
+            {
+                i = N_1_p_pucch;
+            }else{
+                i = phy_struct->N_rb_ul - N_1_p_pucch - 1;
+            }
+            for(j=0; j<phy_struct->N_sc_rb_ul; j++)
+            {
+                if(2 == L || 3 == L || 4 == L)
+                {
+                    phy_struct->pucch_c_est_0_re[c_idx_0] = liblte_phy_rx_symb_re(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                    phy_struct->pucch_c_est_0_im[c_idx_0] = liblte_phy_rx_symb_im(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                    c_idx_0++;
+                }else if(9 == L || 10 == L || 11 == L){
+                    phy_struct->pucch_c_est_1_re[c_idx_1] = liblte_phy_rx_symb_re(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                    phy_struct->pucch_c_est_1_im[c_idx_1] = liblte_phy_rx_symb_im(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                    c_idx_1++;
+                }else{
+                    phy_struct->pucch_z_est_re[z_idx] = liblte_phy_rx_symb_re(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                    phy_struct->pucch_z_est_im[z_idx] = liblte_phy_rx_symb_im(subframe, L, i*phy_struct->N_sc_rb_ul+j);
+                    z_idx++;
+                }
+            }
+        }
+
+        // Recover z using the channel estimate
+        get_ulcch_ce(phy_struct,
+                     phy_struct->pucch_c_est_0_re,
+                     phy_struct->pucch_c_est_0_im,
+                     phy_struct->pucch_c_est_1_re,
+                     phy_struct->pucch_c_est_1_im,
+                     subframe->num,
+                     N_1_p_pucch,
+                     phy_struct->pucch_c_est_re,
+                     phy_struct->pucch_c_est_im);
+        pre_decoder_and_matched_filter_ul(phy_struct->pucch_z_est_re,
+                                          phy_struct->pucch_z_est_im,
+                                          phy_struct->pucch_c_est_re,
+                                          phy_struct->pucch_c_est_im,
+                                          z_idx,
+                                          N_ant,
+                                          1,
+                                          phy_struct->pucch_z_re[0],
+                                          phy_struct->pucch_z_im[0],
+                                          &M_layer_symb);
+
+        // Calculate s_ns
+        for(m_prime=0; m_prime<2; m_prime++)
+        {
+            if((phy_struct->pucch_n_prime_p[subframe->num][N_1_p_pucch][m_prime] % 2) == 0)
+            {
+                s_ns_re[m_prime] = 1;
+                s_ns_im[m_prime] = 0;
+            }else{
+                s_ns_re[m_prime] = cos(M_PI/2);
+                s_ns_im[m_prime] = sin(M_PI/2);
+            }
+        }
+
+        // Recover the bit that was sent
+        d_re = 0;
+        d_im = 0;
+        for(m_prime=0; m_prime<2; m_prime++)
+        {
+            for(i=0; i<N_pucch_sf; i++)
+            {
+                symb_num = i;
+                if(1 < symb_num)
+                {
+                    symb_num += 3;
+                }
+                s_w_re = s_ns_re[m_prime]*W_5_4_1_2[phy_struct->pucch_n_oc_p[subframe->num][N_1_p_pucch][m_prime]][i];
+                s_w_im = s_ns_im[m_prime]*W_5_4_1_2[phy_struct->pucch_n_oc_p[subframe->num][N_1_p_pucch][m_prime]][i];
+                for(j=0; j<LIBLTE_PHY_N_SC_RB_UL; j++)
+                {
+                    r_u_v_re  = phy_struct->pucch_r_u_v_alpha_p_re[subframe->num][N_1_p_pucch][m_prime][symb_num][j];
+                    r_u_v_im  = phy_struct->pucch_r_u_v_alpha_p_im[subframe->num][N_1_p_pucch][m_prime][symb_num][j];
+                    s_w_r_re  = s_w_re*r_u_v_re - s_w_im*r_u_v_im;
+                    s_w_r_im  = s_w_re*r_u_v_im + s_w_im*r_u_v_re;
+                    idx       = m_prime*N_pucch_sf*LIBLTE_PHY_N_SC_RB_UL + i*LIBLTE_PHY_N_SC_RB_UL + j;
+                    denom     = s_w_r_re*s_w_r_re + s_w_r_im*s_w_r_im;
+                    d_re     += (1/denom)*(phy_struct->pucch_z_re[0][idx]*s_w_r_re + phy_struct->pucch_z_im[0][idx]*s_w_r_im);
+                    d_im     += (1/denom)*(-phy_struct->pucch_z_re[0][idx]*s_w_r_im + phy_struct->pucch_z_im[0][idx]*s_w_r_re);
+                }
+            }
+        }
+        d_re /= idx;
+        d_im /= idx;
+        d_re *= sqrt(N_ant);
+        d_im *= sqrt(N_ant);
+
+        // Quantify the bits that were sent
+        if(format == LIBLTE_PHY_PUCCH_FORMAT_1 ||
+           format == LIBLTE_PHY_PUCCH_FORMAT_1A)
+        {
+            if(d_re < 0)
+            {
+                sd = get_soft_decision(d_re, d_im, -1, 0, 1);
+                out_bits[0] = 1;
+            }else{
+                sd = get_soft_decision(d_re, d_im, 1, 0, 1);
+                out_bits[0] = 0;
+            }
+            *N_out_bits = 1;
+            if(sd > 0.5)
+            {
+                err = LIBLTE_SUCCESS;
+            }
+        }else{
+            ang = atan2f(d_im, d_re);
+            if((ang >= M_PI/4) && (ang < 3*M_PI/4))
+            {
+                sd = get_soft_decision(d_re, d_im, 0, 1, 1);
+                out_bits[0] = 1;
+                out_bits[1] = 0;
+            }else if((ang >= -M_PI/4) && (ang < M_PI/4)){
+                sd = get_soft_decision(d_re, d_im, 1, 0, 1);
+                out_bits[0] = 0;
+                out_bits[1] = 0;
+            }else if((ang >= -3*M_PI/4) && (ang < -M_PI/4)){
+                sd = get_soft_decision(d_re, d_im, 0, -1, 1);
+                out_bits[0] = 0;
+                out_bits[1] = 1;
+            }else{
+                sd = get_soft_decision(d_re, d_im, -1, 0, 1);
+                out_bits[0] = 1;
+                out_bits[1] = 1;
+            }
+            *N_out_bits = 2;
+            if(sd > 0.5)
+            {
+                err = LIBLTE_SUCCESS;
+            }
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pucch_format_2_2a_2b_channel_encode
+
+    Description: Encodes and modulates the Physical Uplink Control
+                 Channel for formats 2, 2a, and 2b
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4.2
+                        3GPP TS 36.212 v10.1.0 section 5.2.3
+
+    Notes: Only handling normal CP and N_ant=1
+*********************************************************************/
+// FIXME
+
+/*********************************************************************
+    Name: liblte_phy_pucch_format_2_2a_2b_channel_decode
+
+    Description: Demodulates and decodes the Physical Uplink Control
+                 Channel for formats 2, 2a, and 2b
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.4.2
+                        3GPP TS 36.212 v10.1.0 section 5.2.3
+
+    Notes: Only handling normal CP and N_ant=1
+*********************************************************************/
+// FIXME
+
+/*********************************************************************
+    Name: liblte_phy_pucch_map_sr_config_idx
+
+    Description: Maps SR configuration index to SR periodicity and
+                 SR subframe offset
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 table 10.1.5-1
+*********************************************************************/
+void liblte_phy_pucch_map_sr_config_idx(uint32  i_sr,
+                                        uint32 *sr_periodicity,
+                                        uint32 *N_offset_sr)
+{
+    if(i_sr < 5)
+    {
+        *sr_periodicity = 5;
+        *N_offset_sr    = i_sr;
+    }else if(i_sr < 15){
+        *sr_periodicity = 10;
+        *N_offset_sr    = i_sr - 5;
+    }else if(i_sr < 35){
+        *sr_periodicity = 20;
+        *N_offset_sr    = i_sr - 15;
+    }else if(i_sr < 75){
+        *sr_periodicity = 40;
+        *N_offset_sr    = i_sr - 35;
+    }else if(i_sr < 155){
+        *sr_periodicity = 80;
+        *N_offset_sr    = i_sr - 75;
+    }else if(i_sr < 157){
+        *sr_periodicity = 2;
+        *N_offset_sr    = i_sr - 155;
+    }else{
+        *sr_periodicity = 1;
+        *N_offset_sr    = i_sr - 157;
+    }
+}
+
+/*********************************************************************
+    Name: liblte_phy_generate_prach
+
+    Description: Generates the baseband signal for a PRACH
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_generate_prach(LIBLTE_PHY_STRUCT *phy_struct,
+                                            uint32             preamble_idx,
+                                            uint32             freq_offset,
+                                            float             *samps_re,
+                                            float             *samps_im)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            idx;
+    uint32            N_ra_prb;
+    uint32            k_0;
+    uint32            K;
+    uint32            start;
+
+    if(phy_struct != NULL &&
+       samps_re   != NULL &&
+       samps_im   != NULL &&
+       phy_struct->ul_init)
+    {
+        // Calculate PRACH parameters
+        N_ra_prb = freq_offset;
+        k_0      = N_ra_prb*phy_struct->N_sc_rb_ul - phy_struct->N_rb_ul*phy_struct->N_sc_rb_ul/2 + (phy_struct->FFT_size/2);
+        K        = 15000/phy_struct->prach_delta_f_RA;
+
+        for(i=0; i<phy_struct->prach_N_zc; i++)
+        {
+            phy_struct->prach_dft_in[i][0] = phy_struct->prach_x_u_v_re[preamble_idx][i];
+            phy_struct->prach_dft_in[i][1] = phy_struct->prach_x_u_v_im[preamble_idx][i];
+        }
+        fftwf_execute(phy_struct->prach_dft_plan);
+        for(i=0; i<phy_struct->prach_T_fft; i++)
+        {
+            phy_struct->prach_fft_in[i][0] = 0;
+            phy_struct->prach_fft_in[i][1] = 0;
+        }
+        start = phy_struct->prach_phi + (K*k_0) + (K/2);
+        for(i=0; i<phy_struct->prach_N_zc; i++)
+        {
+            idx                              = (i+start+phy_struct->prach_T_fft/2)%phy_struct->prach_T_fft;
+            phy_struct->prach_fft_in[idx][0] = phy_struct->prach_dft_out[i][0];
+            phy_struct->prach_fft_in[idx][1] = phy_struct->prach_dft_out[i][1];
+        }
+        fftwf_execute(phy_struct->prach_ifft_plan);
+        if(phy_struct->prach_T_fft == phy_struct->prach_T_seq)
+        {
+            for(i=0; i<phy_struct->prach_T_fft; i++)
+            {
+                samps_re[phy_struct->prach_T_cp+i] = phy_struct->prach_fft_out[i][0];
+                samps_im[phy_struct->prach_T_cp+i] = phy_struct->prach_fft_out[i][1];
+            }
+        }else{
+            for(i=0; i<phy_struct->prach_T_fft; i++)
+            {
+                samps_re[phy_struct->prach_T_cp+i]                         = phy_struct->prach_fft_out[i][0];
+                samps_im[phy_struct->prach_T_cp+i]                         = phy_struct->prach_fft_out[i][1];
+                samps_re[phy_struct->prach_T_cp+phy_struct->prach_T_fft+i] = phy_struct->prach_fft_out[i][0];
+                samps_im[phy_struct->prach_T_cp+phy_struct->prach_T_fft+i] = phy_struct->prach_fft_out[i][1];
+            }
+        }
+        for(i=0; i<phy_struct->prach_T_cp; i++)
+        {
+            samps_re[i] = samps_re[phy_struct->prach_T_seq+i];
+            samps_im[i] = samps_im[phy_struct->prach_T_seq+i];
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_detect_prach
+
+    Description: Detects PRACHs from baseband I/Q
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
+
+    Notes: The PRACH band is mixed to DC, filtered and decimated to
+           1.92MHz before a prach_T_fft/prach_dec_factor point FFT.
+           Each root is correlated once and every cyclic shift zone
+           is compared against the noise floor of that root, so all
+           preambles in the occasion are reported.
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
+                                          float             *samps_re,
+                                          float             *samps_im,
+                                          uint32             freq_offset,
+                                          uint32            *N_det_pre,
+                                          uint32            *det_pre,
+                                          uint32            *det_ta)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL &&
+       samps_re   != NULL &&
+       samps_im   != NULL &&
+       N_det_pre  != NULL &&
+       det_pre    != NULL &&
+       det_ta     != NULL &&
+       phy_struct->ul_init)
+    {
+        detect_prach(phy_struct,
+                     samps_re,
+                     samps_im,
+                     1,
+                     freq_offset,
+                     N_det_pre,
+                     det_pre,
+                     det_ta);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_detect_prach_cf
+
+    Description: Detects PRACHs from interleaved complex baseband I/Q
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_detect_prach_cf(LIBLTE_PHY_STRUCT    *phy_struct,
+                                             LIBLTE_PHY_CF_STRUCT *samps,
+                                             uint32                freq_offset,
+                                             uint32               *N_det_pre,
+                                             uint32               *det_pre,
+                                             uint32               *det_ta)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL &&
+       samps      != NULL &&
+       N_det_pre  != NULL &&
+       det_pre    != NULL &&
+       det_ta     != NULL &&
+       phy_struct->ul_init)
+    {
+        detect_prach(phy_struct,
+                     &samps[0].re,
+                     &samps[0].im,
+                     2,
+                     freq_offset,
+                     N_det_pre,
+                     det_pre,
+                     det_ta);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pdsch_channel_encode
+
+    Description: Encodes and modulates the Physical Downlink Shared
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                  LIBLTE_PHY_PDCCH_STRUCT    *pdcch,
+                                                  uint32                      N_id_cell,
+                                                  uint8                       N_ant,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            p;
+    uint32            L;
+    uint32            idx;
+    uint32            alloc_idx;
+    uint32            prb_idx;
+    uint32            c_init;
+    uint32            N_bits_tot;
+    uint32            N_bits;
+    uint32            M_symb;
+    uint32            M_layer_symb;
+    uint32            M_ap_symb;
+    uint32            first_sc;
+    uint32            last_sc;
+    uint32            Q_m;
+    uint32            scramb_bits_idx;
+
+    if(phy_struct != NULL &&
+       pdcch      != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       subframe   != NULL)
+    {
+        // Determine first and last PBCH, PSS, and SSS subcarriers
+        if(phy_struct->N_rb_dl == 6)
+        {
+            first_sc = 0;
+            last_sc  = (6*phy_struct->N_sc_rb_dl)-1;
+        }else if(phy_struct->N_rb_dl == 15){
+            first_sc = (4*phy_struct->N_sc_rb_dl)+6;
+            last_sc  = (11*phy_struct->N_sc_rb_dl)-7;
+        }else if(phy_struct->N_rb_dl == 25){
+            first_sc = (9*phy_struct->N_sc_rb_dl)+6;
+            last_sc  = (16*phy_struct->N_sc_rb_dl)-7;
+        }else if(phy_struct->N_rb_dl == 50){
+            first_sc = 22*phy_struct->N_sc_rb_dl;
+            last_sc  = (28*phy_struct->N_sc_rb_dl)-1;
+        }else if(phy_struct->N_rb_dl == 75){
+            first_sc = (34*phy_struct->N_sc_rb_dl)+6;
+            last_sc  = (41*phy_struct->N_sc_rb_dl)-7;
+        }else{ // phy_struct->N_rb_dl == 100
+            first_sc = 47*phy_struct->N_sc_rb_dl;
+            last_sc  = (53*phy_struct->N_sc_rb_dl)-1;
+        }
+
+        for(alloc_idx=0; alloc_idx<pdcch->N_alloc; alloc_idx++)
+        {
+            if(pdcch->alloc[alloc_idx].chan_type == LIBLTE_PHY_CHAN_TYPE_DLSCH)
+            {
+                // Determine the number of bits available for transmission
+                N_bits_tot = 0;
+                for(i=0; i<pdcch->alloc[alloc_idx].N_prb; i++)
+                {
+                    N_bits_tot += get_num_bits_in_prb(subframe->num,
+                                                      pdcch->N_symbs,
+                                                      pdcch->alloc[alloc_idx].prb[0][i],
+                                                      phy_struct->N_rb_dl,
+                                                      N_ant,
+                                                      pdcch->alloc[alloc_idx].mod_type);
+                }
+                // Determine Q_m
+                if(LIBLTE_PHY_MODULATION_TYPE_BPSK == pdcch->alloc[alloc_idx].mod_type)
+                {
+                    Q_m = 1;
+                }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == pdcch->alloc[alloc_idx].mod_type){
+                    Q_m = 2;
+                }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == pdcch->alloc[alloc_idx].mod_type){
+                    Q_m = 4;
+                }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == pdcch->alloc[alloc_idx].mod_type
+                    Q_m = 6;
+                }
+                scramb_bits_idx = 0;
+                for(i=0; i<pdcch->alloc[alloc_idx].N_codewords; i++)
+                {
+                    // Encode the PDSCH
+                    dlsch_channel_encode(phy_struct,
+                                         pdcch->alloc[alloc_idx].msg[i].msg,
+                                         pdcch->alloc[alloc_idx].msg[i].N_bits,
+                                         pdcch->alloc[alloc_idx].tbs,
+                                         pdcch->alloc[alloc_idx].tx_mode,
+                                         pdcch->alloc[alloc_idx].rv_idx,
+                                         N_bits_tot,
+                                         2,
+                                         Q_m,
+                                         8,
+                                         250368,
+                                         phy_struct->pdsch_encode_bytes,
+                                         &N_bits);
+                    c_init = (pdcch->alloc[alloc_idx].rnti << 14) | (i << 13) | (subframe->num << 9) | N_id_cell;
+                    generate_prs_c_packed(c_init, N_bits, phy_struct->pdsch_c_bytes);
+                    for(j=0; j<(N_bits+7)/8; j++)
+                    {
+                        phy_struct->pdsch_encode_bytes[j] ^= phy_struct->pdsch_c_bytes[j];
+                    }
+                    bit_copy(phy_struct->pdsch_encode_bytes,
+                             0,
+                             phy_struct->pdsch_scramb_bytes,
+                             scramb_bits_idx,
+                             N_bits);
+                    scramb_bits_idx += N_bits;
+                }
+                liblte_phy_modulation_mapper_packed(phy_struct->pdsch_scramb_bytes,
+                                                    N_bits,
+                                                    pdcch->alloc[alloc_idx].mod_type,
+                                                    phy_struct->pdsch_d_re,
+                                                    phy_struct->pdsch_d_im,
+                                                    &M_symb);
+                layer_mapper_dl(phy_struct->pdsch_d_re,
+                                phy_struct->pdsch_d_im,
+                                M_symb,
+                                N_ant,
+                                pdcch->alloc[alloc_idx].N_codewords,
+                                pdcch->alloc[alloc_idx].pre_coder_type,
+                                phy_struct->pdsch_x_re,
+                                phy_struct->pdsch_x_im,
+                                &M_layer_symb);
+                pre_coder_dl(phy_struct->pdsch_x_re,
+                             phy_struct->pdsch_x_im,
+                             M_layer_symb,
+                             N_ant,
+                             pdcch->alloc[alloc_idx].pre_coder_type,
+                             phy_struct->pdsch_y_re[0],
+                             phy_struct->pdsch_y_im[0],
+                             phy_struct->pdsch_N_re_max,
+                             &M_ap_symb);
+
+                // Map the symbols to resource elements 3GPP TS 36.211 v10.1.0 section 6.3.5
+                for(p=0; p<N_ant; p++)
+                {
+                    idx = 0;
+                    for(L=pdcch->N_symbs; L<14; L++)
+                    {
+                        for(prb_idx=0; prb_idx<pdcch->alloc[alloc_idx].N_prb; prb_idx++)
+                        {
+                            i = pdcch->alloc[alloc_idx].prb[L/7][prb_idx];
+                            for(j=0; j<phy_struct->N_sc_rb_dl; j++)
+                            {
+                                if(N_ant           == 1 &&
+                                   (L % 7)         == 0 &&
+                                   (N_id_cell % 6) == (j % 6))
+                                {
+                                    // Skip CRS
+                                }else if(N_ant               == 1 &&
+                                         (L % 7)             == 4 &&
+                                         ((N_id_cell+3) % 6) == (j % 6)){
+                                    // Skip CRS
+                                }else if((N_ant          == 2  ||
+                                          N_ant          == 4) &&
+                                         ((L % 7)        == 0  ||
+                                          (L % 7)        == 4) &&
+                                         (N_id_cell % 3) == (j % 3)){
+                                    // Skip CRS
+                                }else if(N_ant           == 4 &&
+                                         (L % 7)         == 1 &&
+                                         (N_id_cell % 3) == (j % 3)){
+                                    // Skip CRS
+                                }else if(subframe->num                == 0        &&
+                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
+                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
+                                         L                            >= 7        &&
+                                         L                            <= 10){
+                                    // Skip PBCH
+                                }else if((subframe->num               == 0        ||
+                                          subframe->num               == 5)       &&
+                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
+                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
+                                         L                            == 6){
+                                    // Skip PSS
+                                }else if((subframe->num               == 0        ||
+                                          subframe->num               == 5)       &&
+                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
+                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
+                                         L                            == 5){
+                                    // Skip SSS
+                                }else{
+                                    liblte_phy_set_tx_symb(subframe, p, L, i*phy_struct->N_sc_rb_dl+j, phy_struct->pdsch_y_re[p][idx], phy_struct->pdsch_y_im[p][idx]);
+                                    idx++;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pdsch_channel_decode
+
+    Description: Demodulates and decodes the Physical Downlink Shared
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_decode(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
+                                                  LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                                  uint32                        N_pdcch_symbs,
+                                                  uint32                        N_id_cell,
+                                                  uint8                         N_ant,
+                                                  uint8                        *out_bits,
+                                                  uint32                       *N_out_bits)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            p;
+    uint32            L;
+    uint32            prb_idx;
+    uint32            idx;
+    uint32            c_init;
+    uint32            M_layer_symb;
+    uint32            M_symb;
+    uint32            N_bits;
+    uint32            first_sc;
+    uint32            last_sc;
+    uint32            Q_m;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       out_bits   != NULL &&
+       N_out_bits != NULL)
+    {
+        err = LIBLTE_ERROR_DECODE_FAIL;
+
+        // Determine first and last PBCH, PSS, and SSS subcarriers
+        if(phy_struct->N_rb_dl == 6)
+        {
+            first_sc = 0;
+            last_sc  = (6*phy_struct->N_sc_rb_dl)-1;
+        }else if(phy_struct->N_rb_dl == 15){
+            first_sc = (4*phy_struct->N_sc_rb_dl)+6;
+            last_sc  = (11*phy_struct->N_sc_rb_dl)-7;
+        }else if(phy_struct->N_rb_dl == 25){
+            first_sc = (9*phy_struct->N_sc_rb_dl)+6;
+            last_sc  = (16*phy_struct->N_sc_rb_dl)-7;
+        }else if(phy_struct->N_rb_dl == 50){
+            first_sc = 22*phy_struct->N_sc_rb_dl;
+            last_sc  = (28*phy_struct->N_sc_rb_dl)-1;
+        }else if(phy_struct->N_rb_dl == 75){
+            first_sc = (34*phy_struct->N_sc_rb_dl)+6;
+            last_sc  = (41*phy_struct->N_sc_rb_dl)-7;
+        }else{ // phy_struct->N_rb_dl == 100
+            first_sc = 47*phy_struct->N_sc_rb_dl;
+            last_sc  = (53*phy_struct->N_sc_rb_dl)-1;
+        }
+
+        // Extract resource elements and channel estimate 3GPP TS 36.211 v10.1.0 section 6.3.5
+        idx = 0;
+        for(L=N_pdcch_symbs; L<14; L++)
+        {
+            for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
+            {
+                i = alloc->prb[L/7][prb_idx];
+                for(j=0; j<phy_struct->N_sc_rb_dl; j++)
+                {
+                    if(N_ant           == 1 &&
+                       (L % 7)         == 0 &&
+                       (N_id_cell % 6) == (j % 6))
+                    {
+                        // Skip CRS
+                    }else if(N_ant               == 1 &&
+                             (L % 7)             == 4 &&
+                             ((N_id_cell+3) % 6) == (j % 6)){
+                        // Skip CRS
+                    }else if((N_ant          == 2  ||
+                              N_ant          == 4) &&
+                             ((L % 7)        == 0  ||
+                              (L % 7)        == 4) &&
+                             (N_id_cell % 3) == (j % 3)){
+                        // Skip CRS
+                    }else if(N_ant           == 4 &&
+                             (L % 7)         == 1 &&
+                             (N_id_cell % 3) == (j % 3)){
+                        // Skip CRS
+                    }else if(subframe->num                == 0        &&
+                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
+                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
+                             L                            >= 7        &&
+                             L                            <= 10){
+                        // Skip PBCH
+                    }else if((subframe->num               == 0        ||
+                              subframe->num               == 5)       &&
+                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
+                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
+                             L                            == 6){
+                        // Skip PSS
+                    }else if((subframe->num               == 0        ||
+                              subframe->num               == 5)       &&
+                             (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
+                             (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
+                             L                            == 5){
+                        // Skip SSS
+                    }else{
+                        phy_struct->pdsch_y_est_re[idx] = liblte_phy_rx_symb_re(subframe, L, i*phy_struct->N_sc_rb_dl+j);
+                        phy_struct->pdsch_y_est_im[idx] = liblte_phy_rx_symb_im(subframe, L, i*phy_struct->N_sc_rb_dl+j);
+                        for(p=0; p<N_ant; p++)
+                        {
+                            phy_struct->pdsch_c_est_re[p][idx] = liblte_phy_rx_ce_re(subframe, p, L, i*phy_struct->N_sc_rb_dl+j);
+                            phy_struct->pdsch_c_est_im[p][idx] = liblte_phy_rx_ce_im(subframe, p, L, i*phy_struct->N_sc_rb_dl+j);
+                        }
+                        idx++;
+                    }
+                }
+            }
+        }
+
+        pre_decoder_and_matched_filter_dl(phy_struct->pdsch_y_est_re,
+                                          phy_struct->pdsch_y_est_im,
+                                          phy_struct->pdsch_c_est_re[0],
+                                          phy_struct->pdsch_c_est_im[0],
+                                          phy_struct->pdsch_N_re_max,
+                                          idx,
+                                          N_ant,
+                                          alloc->pre_coder_type,
+                                          phy_struct->pdsch_x_re,
+                                          phy_struct->pdsch_x_im,
+                                          &M_layer_symb);
+        layer_demapper_dl(phy_struct->pdsch_x_re,
+                          phy_struct->pdsch_x_im,
+                          M_layer_symb,
+                          N_ant,
+                          alloc->N_codewords,
+                          alloc->pre_coder_type,
+                          phy_struct->pdsch_d_re,
+                          phy_struct->pdsch_d_im,
+                          &M_symb);
+        modulation_demapper(phy_struct->pdsch_d_re,
+                            phy_struct->pdsch_d_im,
+                            M_symb,
+                            alloc->mod_type,
+                            LLR_DEFAULT_NOISE_VAR,
+                            phy_struct->pdsch_soft_bits,
+                            &N_bits);
+        // FIXME: Only handling 1 codeword
+        c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
+        generate_prs_c(c_init, N_bits, phy_struct->pdsch_c);
+        for(i=0; i<N_bits; i++)
+        {
+            phy_struct->pdsch_descramb_bits[i] = (float)phy_struct->pdsch_soft_bits[i]*(1-2*(float)phy_struct->pdsch_c[i]);
+        }
+        if(LIBLTE_PHY_MODULATION_TYPE_BPSK == alloc->mod_type)
+        {
+            Q_m = 1;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == alloc->mod_type){
+            Q_m = 2;
+        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == alloc->mod_type){
+            Q_m = 4;
+        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == alloc->mod_type
+            Q_m = 6;
+        }
+        // N_l matches liblte_phy_pdsch_channel_encode
+        if(LIBLTE_SUCCESS == dlsch_channel_decode(phy_struct,
+                                                  phy_struct->pdsch_descramb_bits,
+                                                  N_bits,
+                                                  alloc->tbs,
+                                                  alloc->tx_mode,
+                                                  alloc->rv_idx,
+                                                  2,
+                                                  Q_m,
+                                                  8,
+                                                  250368, // FIXME: Using N_soft from a cat 1 UE (3GPP TS 36.306)
+                                                  out_bits,
+                                                  N_out_bits))
+        {
+            err = LIBLTE_SUCCESS;
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_bch_channel_encode
+
+    Description: Encodes and modulates the Physical Broadcast
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.6
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_bch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                uint8                      *in_bits,
+                                                uint32                      N_in_bits,
+                                                uint32                      N_id_cell,
+                                                uint8                       N_ant,
+                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                                uint32                      sfn)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            k;
+    uint32            p;
+    uint32            offset;
+    uint32            idx;
+    uint32            M_symb;
+    uint32            M_layer_symb;
+    uint32            M_ap_symb;
+
+    if(phy_struct != NULL &&
+       in_bits    != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       subframe   != NULL)
+    {
+        // Encode the bits to symbols
+        if(0 == phy_struct->bch_N_bits)
+        {
+            bch_channel_encode(phy_struct,
+                               in_bits,
+                               N_in_bits,
+                               N_ant,
+                               phy_struct->bch_encode_bits,
+                               &phy_struct->bch_N_bits);
+            generate_prs_c(N_id_cell, phy_struct->bch_N_bits, phy_struct->bch_c);
+        }
+        for(i=0; i<480; i++)
+        {
+            offset                         = (sfn % 4)*480;
+            phy_struct->bch_scramb_bits[i] = phy_struct->bch_encode_bits[offset+i] ^ phy_struct->bch_c[offset + i];
+        }
+        if(3 == (sfn % 4))
+        {
+            phy_struct->bch_N_bits = 0;
+        }
+        modulation_mapper(phy_struct->bch_scramb_bits,
+                          480,
+                          LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                          phy_struct->bch_d_re,
+                          phy_struct->bch_d_im,
+                          &M_symb);
+        layer_mapper_dl(phy_struct->bch_d_re,
+                        phy_struct->bch_d_im,
+                        M_symb,
+                        N_ant,
+                        1,
+                        LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                        phy_struct->bch_x_re,
+                        phy_struct->bch_x_im,
+                        &M_layer_symb);
+        pre_coder_dl(phy_struct->bch_x_re,
+                     phy_struct->bch_x_im,
+                     M_layer_symb,
+                     N_ant,
+                     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                     phy_struct->bch_y_re[0],
+                     phy_struct->bch_y_im[0],
+                     240,
+                     &M_ap_symb);
+
+        // Map the symbols to resource elements
+        idx = 0;
+        for(p=0; p<N_ant; p++)
+        {
+            for(i=0; i<72; i++)
+            {
+                k = (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2 - 36 + i;
+                if((N_id_cell % 3) != (i % 3))
+                {
+                    liblte_phy_set_tx_symb(subframe, p, 7, k, phy_struct->bch_y_re[p][idx], phy_struct->bch_y_im[p][idx]);
+                    liblte_phy_set_tx_symb(subframe, p, 8, k, phy_struct->bch_y_re[p][idx+48], phy_struct->bch_y_im[p][idx+48]);
+                    idx++;
+                }
+                liblte_phy_set_tx_symb(subframe, p, 9, k, phy_struct->bch_y_re[p][i+96], phy_struct->bch_y_im[p][i+96]);
+                liblte_phy_set_tx_symb(subframe, p, 10, k, phy_struct->bch_y_re[p][i+168], phy_struct->bch_y_im[p][i+168]);
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_bch_channel_decode
+
+    Description: Demodulates and decodes the Physical Broadcast
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.6
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_bch_channel_decode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                                uint32                      N_id_cell,
+                                                uint8                      *N_ant,
+                                                uint8                      *out_bits,
+                                                uint32                     *N_out_bits,
+                                                uint8                      *offset)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            p;
+    uint32            in_idx;
+    uint32            idx;
+    uint32            M_layer_symb;
+    uint32            M_symb;
+    uint32            N_bits;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       N_ant      != NULL &&
+       out_bits   != NULL &&
+       N_out_bits != NULL &&
+       offset     != NULL)
+    {
+        err = LIBLTE_ERROR_DECODE_FAIL;
+
+        // Unmap PBCH and channel estimates from resource elements
+        idx = 0;
+        for(i=0; i<72; i++)
+        {
+            in_idx = phy_struct->N_sc_rb_dl*phy_struct->N_rb_dl/2 - 36 + i;
+            if((N_id_cell % 3) != (i % 3))
+            {
+                phy_struct->bch_y_est_re[idx]    = liblte_phy_rx_symb_re(subframe, 7, in_idx);
+                phy_struct->bch_y_est_im[idx]    = liblte_phy_rx_symb_im(subframe, 7, in_idx);
+                phy_struct->bch_y_est_re[idx+48] = liblte_phy_rx_symb_re(subframe, 8, in_idx);
+                phy_struct->bch_y_est_im[idx+48] = liblte_phy_rx_symb_im(subframe, 8, in_idx);
+                for(p=0; p<4; p++)
+                {
+                    phy_struct->bch_c_est_re[p][idx]    = liblte_phy_rx_ce_re(subframe, p, 7, in_idx);
+                    phy_struct->bch_c_est_im[p][idx]    = liblte_phy_rx_ce_im(subframe, p, 7, in_idx);
+                    phy_struct->bch_c_est_re[p][idx+48] = liblte_phy_rx_ce_re(subframe, p, 8, in_idx);
+                    phy_struct->bch_c_est_im[p][idx+48] = liblte_phy_rx_ce_im(subframe, p, 8, in_idx);
+                }
+                idx++;
+            }
+            phy_struct->bch_y_est_re[i+96]  = liblte_phy_rx_symb_re(subframe, 9, in_idx);
+            phy_struct->bch_y_est_im[i+96]  = liblte_phy_rx_symb_im(subframe, 9, in_idx);
+            phy_struct->bch_y_est_re[i+168] = liblte_phy_rx_symb_re(subframe, 10, in_idx);
+            phy_struct->bch_y_est_im[i+168] = liblte_phy_rx_symb_im(subframe, 10, in_idx);
+            for(p=0; p<4; p++)
+            {
+                phy_struct->bch_c_est_re[p][i+96]  = liblte_phy_rx_ce_re(subframe, p, 9, in_idx);
+                phy_struct->bch_c_est_im[p][i+96]  = liblte_phy_rx_ce_im(subframe, p, 9, in_idx);
+                phy_struct->bch_c_est_re[p][i+168] = liblte_phy_rx_ce_re(subframe, p, 10, in_idx);
+                phy_struct->bch_c_est_im[p][i+168] = liblte_phy_rx_ce_im(subframe, p, 10, in_idx);
+            }
+        }
+
+        // Generate the scrambling sequence
+        generate_prs_c(N_id_cell, 1920, phy_struct->bch_c);
+
+        // Try decoding with 1, 2, and 4 antenna configs,
+        // and for each antenna config, try decoding with 0 to 3 offset
+        *N_ant = 0;
+        for(p=1; p<5; p++)
+        {
+            if(p != 3)
+            {
+                pre_decoder_and_matched_filter_dl(phy_struct->bch_y_est_re,
+                                                  phy_struct->bch_y_est_im,
+                                                  phy_struct->bch_c_est_re[0],
+                                                  phy_struct->bch_c_est_im[0],
+                                                  240,
+                                                  240,
+                                                  p,
+                                                  LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                                                  phy_struct->bch_x_re,
+                                                  phy_struct->bch_x_im,
+                                                  &M_layer_symb);
+                layer_demapper_dl(phy_struct->bch_x_re,
+                                  phy_struct->bch_x_im,
+                                  M_layer_symb,
+                                  p,
+                                  1,
+                                  LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                                  phy_struct->bch_d_re,
+                                  phy_struct->bch_d_im,
+                                  &M_symb);
+                modulation_demapper(phy_struct->bch_d_re,
+                                    phy_struct->bch_d_im,
+                                    M_symb,
+                                    LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                                    LLR_DEFAULT_NOISE_VAR,
+                                    phy_struct->bch_soft_bits,
+                                    &N_bits);
+
+                // Try decoding at each offset
+                for(i=0; i<4; i++)
+                {
+                    for(j=0; j<1920; j++)
+                    {
+                        phy_struct->bch_descramb_bits[j] = RX_NULL_BIT;
+                    }
+                    for(j=0; j<480; j++)
+                    {
+                        phy_struct->bch_descramb_bits[(i*480)+j] = (float)phy_struct->bch_soft_bits[j]*(1-2*(float)phy_struct->bch_c[(i*480)+j]);
+                    }
+                    if(LIBLTE_SUCCESS == bch_channel_decode(phy_struct,
+                                                            phy_struct->bch_descramb_bits,
+                                                            1920,
+                                                            p,
+                                                            out_bits,
+                                                            N_out_bits))
+                    {
+                        *offset = i;
+                        *N_ant  = p;
+                        break;
+                    }
+                }
+                if(*N_ant != 0)
+                {
+                    err = LIBLTE_SUCCESS;
+                    break;
+                }
+            }
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pdcch_channel_encode
+
+    Description: Encodes and modulates all of the Physical Downlink
+                 Control Channels (PCFICH, PHICH, and PDCCH)
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.7, 6.8, and
+                        6.9
+                        3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+                        3GPP TS 36.213 v10.3.0 section 7.1 and 9.1.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_encode(LIBLTE_PHY_STRUCT              *phy_struct,
+                                                  LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
+                                                  LIBLTE_PHY_PHICH_STRUCT        *phich,
+                                                  LIBLTE_PHY_PDCCH_STRUCT        *pdcch,
+                                                  uint32                          N_id_cell,
+                                                  uint8                           N_ant,
+                                                  float                           phich_res,
+                                                  LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT     *subframe)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            k;
+    uint32            p;
+    uint32            idx;
+    uint32            a_idx;
+    uint32            css_idx;
+    uint32            uss_idx;
     uint32            actual_idx;
     uint32            c_init;
-    uint32            N_bits;
-    uint32            M_symb;
+    uint32            N_bits;
+    uint32            M_symb;
+    uint32            M_layer_symb;
+    uint32            M_ap_symb;
+    uint32            N_reg_rb;
+    uint32            N_reg_pdcch;
+    uint32            N_cce_pdcch;
+    uint32            dci_size;
+    uint32            N_dummy;
+    uint32            C_cc_sb;
+    uint32            R_cc_sb;
+    uint32            K_pi;
+    uint32            shift_idx;
+    uint32            k_prime;
+    uint32            l_prime;
+    uint32            m_prime;
+    uint32            Y_k;
+    bool              valid_reg;
+
+    if(phy_struct != NULL &&
+       pcfich     != NULL &&
+       phich      != NULL &&
+       pdcch      != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       subframe   != NULL)
+    {
+        // PCFICH
+        pcfich_channel_map(phy_struct, pcfich, N_id_cell, N_ant, subframe);
+
+        // PHICH
+        phich_channel_map(phy_struct, phich, pcfich, N_id_cell, N_ant, phich_res, phich_dur, subframe);
+
+        // PDCCH
+        if(pdcch->N_alloc != 0)
+        {
+            // Calculate number of symbols, 3GPP TS 36.211 v10.1.0 section 6.7
+            pdcch->N_symbs = pcfich->cfi;
+            if(phy_struct->N_rb_dl <= 10)
+            {
+                pdcch->N_symbs++;
+            }
+            // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.8.1
+            N_reg_rb    = 3;
+            N_reg_pdcch = pdcch->N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - pcfich->N_reg - phich->N_reg;
+            if(N_ant == 4)
+            {
+                // Remove CRS
+                N_reg_pdcch -= phy_struct->N_rb_dl;
+            }
+            N_cce_pdcch = N_reg_pdcch/LIBLTE_PHY_PDCCH_N_REG_CCE;
+
+            // Initialize the search space
+            for(p=0; p<N_ant; p++)
+            {
+                for(i=0; i<N_cce_pdcch; i++)
+                {
+                    for(j=0; j<4*LIBLTE_PHY_PDCCH_N_REG_CCE; j++)
+                    {
+                        phy_struct->pdcch_cce_re[p][i][j] = 0;
+                        phy_struct->pdcch_cce_im[p][i][j] = 0;
+                    }
+                    phy_struct->pdcch_cce_used[i] = false;
+                }
+            }
+
+            // Generate the scrambling sequence
+            c_init = (subframe->num << 9) + N_id_cell;
+            generate_prs_c(c_init, LIBLTE_PHY_PDCCH_N_BITS_MAX * 2, phy_struct->pdcch_c);
+
+            // Add the DCIs
+            for(a_idx=0; a_idx<pdcch->N_alloc; a_idx++)
+            {
+                // Encode the DCI
+                if(LIBLTE_PHY_CHAN_TYPE_DLSCH == pdcch->alloc[a_idx].chan_type)
+                {
+                    dci_1a_pack(&pdcch->alloc[a_idx],
+                                LIBLTE_PHY_DCI_CA_NOT_PRESENT,
+                                phy_struct->N_rb_dl,
+                                N_ant,
+                                phy_struct->pdcch_dci,
+                                &dci_size);
+                }else{ // LIBLTE_PHY_CHAN_TYPE_ULSCH == pdcch->alloc[a_idx].chan_type
+                    dci_0_pack(&pdcch->alloc[a_idx],
+                               LIBLTE_PHY_DCI_CA_NOT_PRESENT,
+                               phy_struct->N_rb_ul,
+                               N_ant,
+                               phy_struct->pdcch_dci,
+                               &dci_size);
+                }
+                N_bits = 288; // Using aggregation level 4 (4*9*4*2 = 288)
+                dci_channel_encode(phy_struct,
+                                   phy_struct->pdcch_dci,
+                                   dci_size,
+                                   pdcch->alloc[a_idx].rnti,
+                                   0,
+                                   N_bits,
+                                   phy_struct->pdcch_encode_bits);
+
+// FIXME: User Specific search space does not work
+//                // Add the DCIs to the search space
+//                if(LIBLTE_MAC_SI_RNTI        == pdcch->alloc[a_idx].rnti ||
+//                   LIBLTE_MAC_P_RNTI         == pdcch->alloc[a_idx].rnti ||
+//                   (LIBLTE_MAC_RA_RNTI_START <= pdcch->alloc[a_idx].rnti &&
+//                    LIBLTE_MAC_RA_RNTI_END   >= pdcch->alloc[a_idx].rnti))
+//                {
+                    // Add to the common search space, using aggregation level of 4
+                    for(css_idx=0; css_idx<4; css_idx++)
+                    {
+                        if(!phy_struct->pdcch_cce_used[4*css_idx+0] &&
+                           !phy_struct->pdcch_cce_used[4*css_idx+1] &&
+                           !phy_struct->pdcch_cce_used[4*css_idx+2] &&
+                           !phy_struct->pdcch_cce_used[4*css_idx+3])
+                        {
+                            for(i=0; i<N_bits; i++)
+                            {
+                                phy_struct->pdcch_scramb_bits[i] = phy_struct->pdcch_encode_bits[i] ^ phy_struct->pdcch_c[4*css_idx*LIBLTE_PHY_PDCCH_N_REG_CCE*4*2 + i];
+                            }
+                            modulation_mapper(phy_struct->pdcch_scramb_bits,
+                                              N_bits,
+                                              LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                                              phy_struct->pdcch_d_re,
+                                              phy_struct->pdcch_d_im,
+                                              &M_symb);
+                            layer_mapper_dl(phy_struct->pdcch_d_re,
+                                            phy_struct->pdcch_d_im,
+                                            M_symb,
+                                            N_ant,
+                                            1,
+                                            LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                                            phy_struct->pdcch_x_re,
+                                            phy_struct->pdcch_x_im,
+                                            &M_layer_symb);
+                            pre_coder_dl(phy_struct->pdcch_x_re,
+                                         phy_struct->pdcch_x_im,
+                                         M_layer_symb,
+                                         N_ant,
+                                         LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                                         phy_struct->pdcch_y_re[0],
+                                         phy_struct->pdcch_y_im[0],
+                                         LIBLTE_PHY_PDCCH_N_BITS_MAX / 2,
+                                         &M_ap_symb);
+                            for(p=0; p<N_ant; p++)
+                            {
+                                idx = 0;
+                                for(i=0; i<4; i++)
+                                {
+                                    for(j=0; j<(4*LIBLTE_PHY_PDCCH_N_REG_CCE); j++)
+                                    {
+                                        phy_struct->pdcch_cce_re[p][4*css_idx+i][j] = phy_struct->pdcch_y_re[p][idx];
+                                        phy_struct->pdcch_cce_im[p][4*css_idx+i][j] = phy_struct->pdcch_y_im[p][idx];
+                                        idx++;
+                                    }
+                                    phy_struct->pdcch_cce_used[4*css_idx+i] = true;
+                                }
+                            }
+                            break;
+                        }
+                    }
+// FIXME: User Specific search space does not work
+//                }else{
+//                    // Add to the user search space, using aggregation level of 4
+//                    Y_k = pdcch->alloc[a_idx].rnti;
+//                    for(i=0; i<=subframe->num; i++)
+//                    {
+//                        Y_k = (39827 * Y_k) % 65537;
+//                    }
+//                    for(uss_idx=0; uss_idx<2; uss_idx++)
+//                    {
+//                        actual_idx = 4*((Y_k+uss_idx) % (N_cce_pdcch/4));
+//                        if(!phy_struct->pdcch_cce_used[actual_idx+0] &&
+//                           !phy_struct->pdcch_cce_used[actual_idx+1] &&
+//                           !phy_struct->pdcch_cce_used[actual_idx+2] &&
+//                           !phy_struct->pdcch_cce_used[actual_idx+3])
+//                        {
+//                            for(i=0; i<N_bits; i++)
+//                            {
+//                                phy_struct->pdcch_scramb_bits[i] = phy_struct->pdcch_encode_bits[i] ^ phy_struct->pdcch_c[4*actual_idx*LIBLTE_PHY_PDCCH_N_REG_CCE*4*2 + i];
+//                            }
+//                            modulation_mapper(phy_struct->pdcch_scramb_bits,
+//                                              N_bits,
+//                                              LIBLTE_PHY_MODULATION_TYPE_QPSK,
+//                                              phy_struct->pdcch_d_re,
+//                                              phy_struct->pdcch_d_im,
+//                                              &M_symb);
+//                            layer_mapper_dl(phy_struct->pdcch_d_re,
+//                                            phy_struct->pdcch_d_im,
+//                                            M_symb,
+//                                            N_ant,
+//                                            1,
+//                                            LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+//                                            phy_struct->pdcch_x_re,
+//                                            phy_struct->pdcch_x_im,
+//                                            &M_layer_symb);
+//                            pre_coder_dl(phy_struct->pdcch_x_re,
+//                                         phy_struct->pdcch_x_im,
+//                                         M_layer_symb,
+//                                         N_ant,
+//                                         LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+//                                         phy_struct->pdcch_y_re[0],
+//                                         phy_struct->pdcch_y_im[0],
+//                                         576,
+//                                         &M_ap_symb);
+//                            for(p=0; p<N_ant; p++)
+//                            {
+//                                idx = 0;
+//                                for(i=0; i<4; i++)
+//                                {
+//                                    for(j=0; j<(4*LIBLTE_PHY_PDCCH_N_REG_CCE); j++)
+//                                    {
+//                                        phy_struct->pdcch_cce_re[p][actual_idx+i][j] = phy_struct->pdcch_y_re[p][idx];
+//                                        phy_struct->pdcch_cce_im[p][actual_idx+i][j] = phy_struct->pdcch_y_im[p][idx];
+//                                        idx++;
+//                                    }
+//                                    phy_struct->pdcch_cce_used[actual_idx+i] = true;
+//                                }
+//                            }
+//                            break;
+//                        }
+//                    }
+//                }
+            }
+            // Construct REGs
+            for(p=0; p<N_ant; p++)
+            {
+                for(i=0; i<N_cce_pdcch; i++)
+                {
+                    for(j=0; j<LIBLTE_PHY_PDCCH_N_REG_CCE; j++)
+                    {
+                        for(k=0; k<4; k++)
+                        {
+                            phy_struct->pdcch_reg_re[p][i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k] = phy_struct->pdcch_cce_re[p][i][j*4+k];
+                            phy_struct->pdcch_reg_im[p][i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k] = phy_struct->pdcch_cce_im[p][i][j*4+k];
+                        }
+                    }
+                }
+            }
+            // Permute the REGs, 3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+            if(phy_struct->pdcch_permute_N_reg[pdcch->N_symbs-1] != N_reg_pdcch)
+            {
+                pdcch_permute_pre_calc(phy_struct, pdcch->N_symbs, N_reg_pdcch);
+            }
+            for(p=0; p<N_ant; p++)
+            {
+                for(i=0; i<N_reg_pdcch; i++)
+                {
+                    for(j=0; j<4; j++)
+                    {
+                        phy_struct->pdcch_perm_re[p][i][j] = phy_struct->pdcch_reg_re[p][phy_struct->pdcch_permute_map[pdcch->N_symbs-1][i]][j];
+                        phy_struct->pdcch_perm_im[p][i][j] = phy_struct->pdcch_reg_im[p][phy_struct->pdcch_permute_map[pdcch->N_symbs-1][i]][j];
+                    }
+                }
+            }
+            // Cyclic shift the REGs
+            for(p=0; p<N_ant; p++)
+            {
+                for(i=0; i<N_reg_pdcch; i++)
+                {
+                    shift_idx = (i+N_id_cell) % N_reg_pdcch;
+                    for(j=0; j<4; j++)
+                    {
+                        phy_struct->pdcch_shift_re[p][i][j] = phy_struct->pdcch_perm_re[p][shift_idx][j];
+                        phy_struct->pdcch_shift_im[p][i][j] = phy_struct->pdcch_perm_im[p][shift_idx][j];
+                    }
+                }
+            }
+            // Map the REGs to resource elements, 3GPP TS 36.211 v10.1.0 section 6.8.5
+            // Step 1 and 2
+            m_prime = 0;
+            k_prime = 0;
+            // Step 10
+            while(k_prime < (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl))
+            {
+                // Step 3
+                l_prime = 0;
+                // Step 8
+                while(l_prime < pdcch->N_symbs)
+                {
+                    if(l_prime == 0)
+                    {
+                        // Step 4
+                        // Avoid PCFICH and PHICH
+                        valid_reg = true;
+                        for(i=0; i<pcfich->N_reg; i++)
+                        {
+                            if(k_prime == pcfich->k[i])
+                            {
+                                valid_reg = false;
+                            }
+                        }
+                        for(i=0; i<phich->N_reg; i++)
+                        {
+                            if(k_prime == phich->k[i])
+                            {
+                                valid_reg = false;
+                            }
+                        }
+                        if((k_prime % 6) == 0 && valid_reg == true)
+                        {
+                            if(m_prime < N_reg_pdcch)
+                            {
+                                // Step 5
+                                idx = 0;
+                                for(i=0; i<6; i++)
+                                {
+                                    // Avoid CRS
+                                    if((N_id_cell % 3) != (i % 3))
+                                    {
+                                        for(p=0; p<N_ant; p++)
+                                        {
+                                            liblte_phy_set_tx_symb(subframe, p, l_prime, k_prime+i, phy_struct->pdcch_shift_re[p][m_prime][idx], phy_struct->pdcch_shift_im[p][m_prime][idx]);
+                                        }
+                                        idx++;
+                                    }
+                                }
+                                // Step 6
+                                m_prime++;
+                            }
+                        }
+                    }else if(l_prime == 1 && N_ant == 4){
+                        // Step 4
+                        if((k_prime % 6) == 0)
+                        {
+                            if(m_prime < N_reg_pdcch)
+                            {
+                                // Step 5
+                                idx = 0;
+                                for(i=0; i<6; i++)
+                                {
+                                    // Avoid CRS
+                                    if((N_id_cell % 3) != (i % 3))
+                                    {
+                                        for(p=0; p<N_ant; p++)
+                                        {
+                                            liblte_phy_set_tx_symb(subframe, p, l_prime, k_prime+i, phy_struct->pdcch_shift_re[p][m_prime][idx], phy_struct->pdcch_shift_im[p][m_prime][idx]);
+                                        }
+                                        idx++;
+                                    }
+                                }
+                                // Step 6
+                                m_prime++;
+                            }
+                        }
+                    }else{
+                        // Step 4
+                        if((k_prime % 4) == 0)
+                        {
+                            if(m_prime < N_reg_pdcch)
+                            {
+                                // Step 5
+                                for(i=0; i<4; i++)
+                                {
+                                    for(p=0; p<N_ant; p++)
+                                    {
+                                        liblte_phy_set_tx_symb(subframe, p, l_prime, k_prime+i, phy_struct->pdcch_shift_re[p][m_prime][i], phy_struct->pdcch_shift_im[p][m_prime][i]);
+                                    }
+                                }
+                                // Step 6
+                                m_prime++;
+                            }
+                        }
+                    }
+                    // Step 7
+                    l_prime++;
+                }
+                // Step 9
+                k_prime++;
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_pdcch_channel_decode
+
+    Description: Demodulates and decodes all of the Physical Downlink
+                 Control Channels (PCFICH, PHICH, and PDCCH)
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.7, 6.8, and
+                        6.9
+                        3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT              *phy_struct,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT     *subframe,
+                                                  uint32                          N_id_cell,
+                                                  uint8                           N_ant,
+                                                  float                           phich_res,
+                                                  LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
+                                                  LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
+                                                  LIBLTE_PHY_PHICH_STRUCT        *phich,
+                                                  LIBLTE_PHY_PDCCH_STRUCT        *pdcch)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            k;
+    uint32            p;
+    uint32            idx;
+    uint32            c_init;
     uint32            M_layer_symb;
-    uint32            M_ap_symb;
+    uint32            M_symb;
+    uint32            N_bits;
+    uint32            k_prime;
+    uint32            l_prime;
+    uint32            m_prime;
+    uint32            dci_1a_size;
+    uint32            dci_1c_size;
     uint32            N_reg_rb;
-    uint32            N_reg_pdcch;
-    uint32            N_cce_pdcch;
-    uint32            dci_size;
-    uint32            N_dummy;
+    uint32            shift_idx;
     uint32            C_cc_sb;
     uint32            R_cc_sb;
     uint32            K_pi;
-    uint32            shift_idx;
-    uint32            k_prime;
-    uint32            l_prime;
-    uint32            m_prime;
+    uint32            N_dummy;
+    uint32            N_reg_pdcch;
+    uint32            N_cce_pdcch;
+    uint32            L;
+    uint32            l_idx;
+    uint32            m;
+    uint32            N_cand;
+    uint32            M_L_ue[4] = {6, 6, 2, 2};
     uint32            Y_k;
+    uint32            r;
+    float             y_pow;
+    float             c_pow;
+    uint16            rnti;
     bool              valid_reg;
+    bool              found;
+    struct timespec   time_start;
+    struct timespec   time_end;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL &&
+       pcfich     != NULL &&
+       phich      != NULL &&
+       pdcch      != NULL)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &time_start);
+        memset(&phy_struct->pdcch_stats, 0, sizeof(LIBLTE_PHY_PDCCH_DECODE_STATS_STRUCT));
+
+        // PCFICH
+        pcfich_channel_demap(phy_struct, subframe, N_id_cell, N_ant, pcfich, &N_bits);
+        if(LIBLTE_SUCCESS != cfi_channel_decode(phy_struct,
+                                                phy_struct->pdcch_descramb_bits,
+                                                N_bits,
+                                                &pcfich->cfi))
+        {
+            err = LIBLTE_ERROR_INVALID_CRC;
+            return(err);
+        }
+
+        // PHICH
+        phich_channel_demap(phy_struct, pcfich, subframe, N_id_cell, N_ant, phich_res, phich_dur, phich);
+
+        // PDCCH
+        // Calculate number of symbols, 3GPP TS 36.211 v10.1.0 section 6.7
+        pdcch->N_symbs = pcfich->cfi;
+        if(phy_struct->N_rb_dl <= 10)
+        {
+            pdcch->N_symbs++;
+        }
+        // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.8.1
+        N_reg_rb    = 3;
+        N_reg_pdcch = pdcch->N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - pcfich->N_reg - phich->N_reg;
+        if(N_ant == 4)
+        {
+            // Remove CRS
+            N_reg_pdcch -= phy_struct->N_rb_dl;
+        }
+        N_cce_pdcch = N_reg_pdcch/9;
+        // Extract resource elements and channel estimate, 3GPP TS 36.211 v10.1.0 section 6.8.5
+        // Step 1 and 2
+        m_prime = 0;
+        k_prime = 0;
+        // Step 10
+        while(k_prime < (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl))
+        {
+            // Step 3
+            l_prime = 0;
+            // Step 8
+            while(l_prime < pdcch->N_symbs)
+            {
+                if(l_prime == 0)
+                {
+                    // Step 4
+                    // Avoid PCFICH and PHICH
+                    valid_reg = true;
+                    for(i=0; i<pcfich->N_reg; i++)
+                    {
+                        if(k_prime == pcfich->k[i])
+                        {
+                            valid_reg = false;
+                        }
+                    }
+                    for(i=0; i<phich->N_reg; i++)
+                    {
+                        if(k_prime == phich->k[i])
+                        {
+                            valid_reg = false;
+                        }
+                    }
+                    if((k_prime % 6) == 0 && valid_reg == true)
+                    {
+                        if(m_prime < N_reg_pdcch)
+                        {
+                            // Step 5
+                            idx = 0;
+                            for(i=0; i<6; i++)
+                            {
+                                // Avoid CRS
+                                if((N_id_cell % 3) != (i % 3))
+                                {
+                                    phy_struct->pdcch_reg_y_est_re[m_prime][idx] = liblte_phy_rx_symb_re(subframe, l_prime, k_prime+i);
+                                    phy_struct->pdcch_reg_y_est_im[m_prime][idx] = liblte_phy_rx_symb_im(subframe, l_prime, k_prime+i);
+                                    for(p=0; p<N_ant; p++)
+                                    {
+                                        phy_struct->pdcch_reg_c_est_re[p][m_prime][idx] = liblte_phy_rx_ce_re(subframe, p, l_prime, k_prime+i);
+                                        phy_struct->pdcch_reg_c_est_im[p][m_prime][idx] = liblte_phy_rx_ce_im(subframe, p, l_prime, k_prime+i);
+                                    }
+                                    idx++;
+                                }
+                            }
+                            // Step 6
+                            m_prime++;
+                        }
+                    }
+                }else if(l_prime == 1 && N_ant == 4){
+                    // Step 4
+                    if((k_prime % 6) == 0)
+                    {
+                        if(m_prime < N_reg_pdcch)
+                        {
+                            // Step 5
+                            idx = 0;
+                            for(i=0; i<6; i++)
+                            {
+                                // Avoid CRS
+                                if((N_id_cell % 3) != (i % 3))
+                                {
+                                    phy_struct->pdcch_reg_y_est_re[m_prime][idx] = liblte_phy_rx_symb_re(subframe, l_prime, k_prime+i);
+                                    phy_struct->pdcch_reg_y_est_im[m_prime][idx] = liblte_phy_rx_symb_im(subframe, l_prime, k_prime+i);
+                                    for(p=0; p<N_ant; p++)
+                                    {
+                                        phy_struct->pdcch_reg_c_est_re[p][m_prime][idx] = liblte_phy_rx_ce_re(subframe, p, l_prime, k_prime+i);
+                                        phy_struct->pdcch_reg_c_est_im[p][m_prime][idx] = liblte_phy_rx_ce_im(subframe, p, l_prime, k_prime+i);
+                                    }
+                                    idx++;
+                                }
+                            }
+                            // Step 6
+                            m_prime++;
+                        }
+                    }
+                }else{
+                    // Step 4
+                    if((k_prime % 4) == 0)
+                    {
+                        if(m_prime < N_reg_pdcch)
+                        {
+                            // Step 5
+                            for(i=0; i<4; i++)
+                            {
+                                phy_struct->pdcch_reg_y_est_re[m_prime][i] = liblte_phy_rx_symb_re(subframe, l_prime, k_prime+i);
+                                phy_struct->pdcch_reg_y_est_im[m_prime][i] = liblte_phy_rx_symb_im(subframe, l_prime, k_prime+i);
+                                for(p=0; p<N_ant; p++)
+                                {
+                                    phy_struct->pdcch_reg_c_est_re[p][m_prime][i] = liblte_phy_rx_ce_re(subframe, p, l_prime, k_prime+i);
+                                    phy_struct->pdcch_reg_c_est_im[p][m_prime][i] = liblte_phy_rx_ce_im(subframe, p, l_prime, k_prime+i);
+                                }
+                            }
+                            // Step 6
+                            m_prime++;
+                        }
+                    }
+                }
+                // Step 7
+                l_prime++;
+            }
+            // Step 9
+            k_prime++;
+        }
+        // Undo cyclic shift of the REGs
+        for(i=0; i<N_reg_pdcch; i++)
+        {
+            shift_idx = (i+N_id_cell) % N_reg_pdcch;
+            for(j=0; j<4; j++)
+            {
+                phy_struct->pdcch_shift_y_est_re[shift_idx][j] = phy_struct->pdcch_reg_y_est_re[i][j];
+                phy_struct->pdcch_shift_y_est_im[shift_idx][j] = phy_struct->pdcch_reg_y_est_im[i][j];
+                for(p=0; p<N_ant; p++)
+                {
+                    phy_struct->pdcch_shift_c_est_re[p][shift_idx][j] = phy_struct->pdcch_reg_c_est_re[p][i][j];
+                    phy_struct->pdcch_shift_c_est_im[p][shift_idx][j] = phy_struct->pdcch_reg_c_est_im[p][i][j];
+                }
+            }
+        }
+        // Undo permutation of the REGs, 3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+        for(i=0; i<N_reg_pdcch; i++)
+        {
+            phy_struct->pdcch_reg_vec[i] = i;
+        }
+        // In order to recreate circular buffer, a dummy block must be
+        // sub block interleaved to determine where NULL bits are to be
+        // inserted
+        // Step 1
+        C_cc_sb = 32;
+        // Step 2
+        R_cc_sb = 0;
+        while(N_reg_pdcch > (C_cc_sb*R_cc_sb))
+        {
+            R_cc_sb++;
+        }
+        // Step 3
+        if(N_reg_pdcch < (C_cc_sb*R_cc_sb))
+        {
+            N_dummy = C_cc_sb*R_cc_sb - N_reg_pdcch;
+        }else{
+            N_dummy = 0;
+        }
+        for(i=0; i<N_dummy; i++)
+        {
+            phy_struct->ruc_tmp[i] = RX_NULL_BIT;
+        }
+        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
+        {
+            phy_struct->ruc_tmp[i] = 0;
+        }
+        idx = 0;
+        for(i=0; i<R_cc_sb; i++)
+        {
+            for(j=0; j<C_cc_sb; j++)
+            {
+                phy_struct->ruc_sb_mat[i][j] = phy_struct->ruc_tmp[idx++];
+            }
+        }
+        // Step 4
+        for(i=0; i<R_cc_sb; i++)
+        {
+            for(j=0; j<C_cc_sb; j++)
+            {
+                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]];
+            }
+        }
+        // Step 5
+        idx = 0;
+        for(j=0; j<C_cc_sb; j++)
+        {
+            for(i=0; i<R_cc_sb; i++)
+            {
+                phy_struct->ruc_v[0][idx++] = phy_struct->ruc_sb_perm_mat[i][j];
+            }
+        }
+        // Recreate circular buffer
+        K_pi = R_cc_sb*C_cc_sb;
+        k    = 0;
+        j    = 0;
+        while(k < N_reg_pdcch)
+        {
+            if(phy_struct->ruc_v[0][j%K_pi] != RX_NULL_BIT)
+            {
+                phy_struct->ruc_v[0][j%K_pi] = phy_struct->pdcch_reg_vec[k++];
+            }
+            j++;
+        }
+        // Sub block deinterleaving
+        // Step 5
+        idx = 0;
+        for(j=0; j<C_cc_sb; j++)
+        {
+            for(i=0; i<R_cc_sb; i++)
+            {
+                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_v[0][idx++];
+            }
+        }
+        // Step 4
+        for(i=0; i<R_cc_sb; i++)
+        {
+            for(j=0; j<C_cc_sb; j++)
+            {
+                phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]] = phy_struct->ruc_sb_perm_mat[i][j];
+            }
+        }
+        // Step 3
+        idx = 0;
+        for(i=0; i<R_cc_sb; i++)
+        {
+            for(j=0; j<C_cc_sb; j++)
+            {
+                phy_struct->ruc_tmp[idx++] = phy_struct->ruc_sb_mat[i][j];
+            }
+        }
+        for(i=0; i<N_reg_pdcch; i++)
+        {
+            for(j=0; j<4; j++)
+            {
+                phy_struct->pdcch_perm_y_est_re[i][j] = phy_struct->pdcch_shift_y_est_re[(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
+                phy_struct->pdcch_perm_y_est_im[i][j] = phy_struct->pdcch_shift_y_est_im[(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
+                for(p=0; p<N_ant; p++)
+                {
+                    phy_struct->pdcch_perm_c_est_re[p][i][j] = phy_struct->pdcch_shift_c_est_re[p][(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
+                    phy_struct->pdcch_perm_c_est_im[p][i][j] = phy_struct->pdcch_shift_c_est_im[p][(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
+                }
+            }
+        }
+        // Construct CCEs
+        for(i=0; i<N_cce_pdcch; i++)
+        {
+            for(j=0; j<LIBLTE_PHY_PDCCH_N_REG_CCE; j++)
+            {
+                for(k=0; k<4; k++)
+                {
+                    phy_struct->pdcch_cce_y_est_re[i][j*4+k] = phy_struct->pdcch_perm_y_est_re[i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k];
+                    phy_struct->pdcch_cce_y_est_im[i][j*4+k] = phy_struct->pdcch_perm_y_est_im[i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k];
+                    for(p=0; p<N_ant; p++)
+                    {
+                        phy_struct->pdcch_cce_c_est_re[p][i][j*4+k] = phy_struct->pdcch_perm_c_est_re[p][i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k];
+                        phy_struct->pdcch_cce_c_est_im[p][i][j*4+k] = phy_struct->pdcch_perm_c_est_im[p][i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k];
+                    }
+                }
+            }
+        }
+
+        // Generate the scrambling sequence
+        c_init = (subframe->num << 9) + N_id_cell;
+        generate_prs_c(c_init, N_cce_pdcch*LIBLTE_PHY_PDCCH_N_BITS_CCE, phy_struct->pdcch_c);
+
+        // Determine the size of DCI 1A and 1C FIXME: Clean this up
+        if(phy_struct->N_rb_dl == 6)
+        {
+            dci_1a_size = 21;
+            dci_1c_size = 9;
+        }else if(phy_struct->N_rb_dl == 15){
+            dci_1a_size = 22;
+            dci_1c_size = 11;
+        }else if(phy_struct->N_rb_dl == 25){
+            dci_1a_size = 25;
+            dci_1c_size = 13;
+        }else if(phy_struct->N_rb_dl == 50){
+            dci_1a_size = 27;
+            dci_1c_size = 13;
+        }else if(phy_struct->N_rb_dl == 75){
+            dci_1a_size = 27;
+            dci_1c_size = 14;
+        }else{ // phy_struct->N_rb_dl == 100
+            dci_1a_size = 28;
+            dci_1c_size = 15;
+        }
+
+        // Demodulate and descramble each CCE once, the candidates of all
+        // aggregation levels and search spaces share these soft bits.
+        // CCEs with too little energy to carry a PDCCH are marked so
+        // that candidates using them are rejected without decoding.
+        for(i=0; i<N_cce_pdcch; i++)
+        {
+            y_pow = 0;
+            c_pow = 0;
+            for(k=0; k<LIBLTE_PHY_PDCCH_N_RE_CCE; k++)
+            {
+                phy_struct->pdcch_y_est_re[k]  = phy_struct->pdcch_cce_y_est_re[i][k];
+                phy_struct->pdcch_y_est_im[k]  = phy_struct->pdcch_cce_y_est_im[i][k];
+                y_pow                         += (phy_struct->pdcch_y_est_re[k]*phy_struct->pdcch_y_est_re[k] +
+                                                  phy_struct->pdcch_y_est_im[k]*phy_struct->pdcch_y_est_im[k]);
+                for(p=0; p<N_ant; p++)
+                {
+                    phy_struct->pdcch_c_est_re[p][k]  = phy_struct->pdcch_cce_c_est_re[p][i][k];
+                    phy_struct->pdcch_c_est_im[p][k]  = phy_struct->pdcch_cce_c_est_im[p][i][k];
+                    c_pow                            += (phy_struct->pdcch_c_est_re[p][k]*phy_struct->pdcch_c_est_re[p][k] +
+                                                         phy_struct->pdcch_c_est_im[p][k]*phy_struct->pdcch_c_est_im[p][k]);
+                }
+            }
+            // A PDCCH is sent with an average power of c_pow/N_ant per
+            // resource element
+            phy_struct->pdcch_cce_used[i]   = false;
+            phy_struct->pdcch_cce_active[i] = (y_pow*N_ant >= PDCCH_CCE_MIN_ENERGY*c_pow);
+            if(!phy_struct->pdcch_cce_active[i])
+            {
+                continue;
+            }
+            phy_struct->pdcch_stats.N_cce_active++;
+
+            pre_decoder_and_matched_filter_dl(phy_struct->pdcch_y_est_re,
+                                              phy_struct->pdcch_y_est_im,
+                                              phy_struct->pdcch_c_est_re[0],
+                                              phy_struct->pdcch_c_est_im[0],
+                                              LIBLTE_PHY_PDCCH_N_BITS_MAX / 2,
+                                              LIBLTE_PHY_PDCCH_N_RE_CCE,
+                                              N_ant,
+                                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                                              phy_struct->pdcch_x_re,
+                                              phy_struct->pdcch_x_im,
+                                              &M_layer_symb);
+            layer_demapper_dl(phy_struct->pdcch_x_re,
+                              phy_struct->pdcch_x_im,
+                              M_layer_symb,
+                              N_ant,
+                              1,
+                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                              phy_struct->pdcch_d_re,
+                              phy_struct->pdcch_d_im,
+                              &M_symb);
+            modulation_demapper(phy_struct->pdcch_d_re,
+                                phy_struct->pdcch_d_im,
+                                M_symb,
+                                LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                                LLR_DEFAULT_NOISE_VAR,
+                                phy_struct->pdcch_soft_bits,
+                                &N_bits);
+            for(j=0; j<N_bits; j++)
+            {
+                idx                                  = i*LIBLTE_PHY_PDCCH_N_BITS_CCE + j;
+                phy_struct->pdcch_cce_soft_bits[idx] = (float)phy_struct->pdcch_soft_bits[j]*(1-2*(float)phy_struct->pdcch_c[idx]);
+            }
+        }
+
+        // Common search space, 3GPP TS 36.213 v10.3.0 section 9.1.1
+        pdcch->N_alloc = 0;
+        for(L=4; L<=8; L*=2)
+        {
+            N_cand = N_cce_pdcch/L;
+            if(N_cand > 16/L)
+            {
+                N_cand = 16/L;
+            }
+            for(m=0; m<N_cand; m++)
+            {
+                pdcch_candidate_decode(phy_struct,
+                                       m*L,
+                                       L,
+                                       0,
+                                       N_ant,
+                                       dci_1a_size,
+                                       dci_1c_size,
+                                       pdcch);
+            }
+        }
+
+        // UE specific search spaces, stopping at the first allocation
+        // for each RNTI, 3GPP TS 36.213 v10.3.0 section 9.1.1
+        for(r=0; r<phy_struct->pdcch_N_ue_rntis; r++)
+        {
+            rnti  = phy_struct->pdcch_ue_rntis[r];
+            found = false;
+            for(i=0; i<pdcch->N_alloc; i++)
+            {
+                if(rnti == pdcch->alloc[i].rnti)
+                {
+                    found = true;
+                }
+            }
+            Y_k = rnti;
+            for(i=0; i<=subframe->num; i++)
+            {
+                Y_k = (39827 * Y_k) % 65537;
+            }
+            for(l_idx=0; l_idx<4 && !found; l_idx++)
+            {
+                L      = 1 << l_idx;
+                N_cand = N_cce_pdcch/L;
+                if(N_cand > M_L_ue[l_idx])
+                {
+                    N_cand = M_L_ue[l_idx];
+                }
+                for(m=0; m<N_cand && !found; m++)
+                {
+                    found = pdcch_candidate_decode(phy_struct,
+                                                   L*((Y_k + m) % (N_cce_pdcch/L)),
+                                                   L,
+                                                   rnti,
+                                                   N_ant,
+                                                   dci_1a_size,
+                                                   dci_1c_size,
+                                                   pdcch);
+                }
+            }
+        }
+
+        if(0 < pdcch->N_alloc)
+        {
+            err = LIBLTE_SUCCESS;
+        }else{
+            err = LIBLTE_ERROR_INVALID_CRC;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &time_end);
+        phy_struct->pdcch_stats.decode_time_us = ((time_end.tv_sec - time_start.tv_sec)*1000000 +
+                                                  (time_end.tv_nsec - time_start.tv_nsec)/1000);
+        phy_struct->pdcch_stats.N_cce          = N_cce_pdcch;
+        phy_struct->pdcch_stats.N_found        = pdcch->N_alloc;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_map_crs
+
+    Description: Maps the Cell Specific Reference Signals to the
+                 subframe
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.10.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_map_crs(LIBLTE_PHY_STRUCT          *phy_struct,
+                                     LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                     uint32                      N_id_cell,
+                                     uint8                       N_ant)
+{
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             *crs_re[14];
+    float             *crs_im[14];
+    uint32             p;
+    uint32             i;
+    uint32             j;
+    uint32             k;
+    uint32             m_prime;
+    uint32             v_shift = N_id_cell % 6;
+    uint32             v[4];
+    uint32             sym[4];
+    uint32             N_sym;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503)
+    {
+        // Get cell specific reference signals
+        crs_cache_get(phy_struct, subframe->num*2,   0, N_id_cell, &crs_re[0],  &crs_im[0]);
+        crs_cache_get(phy_struct, subframe->num*2,   1, N_id_cell, &crs_re[1],  &crs_im[1]);
+        crs_cache_get(phy_struct, subframe->num*2,   4, N_id_cell, &crs_re[4],  &crs_im[4]);
+        crs_cache_get(phy_struct, subframe->num*2+1, 0, N_id_cell, &crs_re[7],  &crs_im[7]);
+        crs_cache_get(phy_struct, subframe->num*2+1, 1, N_id_cell, &crs_re[8],  &crs_im[8]);
+        crs_cache_get(phy_struct, subframe->num*2+1, 4, N_id_cell, &crs_re[11], &crs_im[11]);
+
+        for(p=0; p<N_ant; p++)
+        {
+            if(p == 0)
+            {
+                v[0]   = 0;
+                v[1]   = 3;
+                v[2]   = 0;
+                v[3]   = 3;
+                sym[0] = 0;
+                sym[1] = 4;
+                sym[2] = 7;
+                sym[3] = 11;
+                N_sym  = 4;
+            }else if(p == 1){
+                v[0]   = 3;
+                v[1]   = 0;
+                v[2]   = 3;
+                v[3]   = 0;
+                sym[0] = 0;
+                sym[1] = 4;
+                sym[2] = 7;
+                sym[3] = 11;
+                N_sym  = 4;
+            }else if(p == 2){
+                v[0]   = 0;
+                v[1]   = 3;
+                sym[0] = 1;
+                sym[1] = 8;
+                N_sym  = 2;
+            }else{ // p == 3
+                v[0]   = 3;
+                v[1]   = 6;
+                sym[0] = 1;
+                sym[1] = 8;
+                N_sym  = 2;
+            }
+            for(i=0; i<N_sym; i++)
+            {
+                for(j=0; j<2*phy_struct->N_rb_dl; j++)
+                {
+                    k                                  = 6*j + (v[i] + v_shift)%6;
+                    m_prime                            = j + LIBLTE_PHY_N_RB_DL_MAX - phy_struct->N_rb_dl;
+                    liblte_phy_set_tx_symb(subframe, p, sym[i], k, crs_re[sym[i]][m_prime], crs_im[sym[i]][m_prime]);
+                }
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_map_pss
+
+    Description: Maps the Primary Synchronization Signal to the
+                 subframe.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_map_pss(LIBLTE_PHY_STRUCT          *phy_struct,
+                                     LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                     uint32                      N_id_2,
+                                     uint8                       N_ant)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             pss_re[63];
+    float             pss_im[63];
+    uint32            p;
+    uint32            i;
+    uint32            k;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL)
+    {
+        generate_pss(N_id_2, pss_re, pss_im);
+
+        for(p=0; p<N_ant; p++)
+        {
+            for(i=0; i<62; i++)
+            {
+                k                             = i - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
+                liblte_phy_set_tx_symb(subframe, p, 6, k, pss_re[i], pss_im[i]);
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_find_pss_and_fine_timing
+
+    Description: Searches for the Primary Synchronization Signal and
+                 determines fine timing.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_find_pss_and_fine_timing(LIBLTE_PHY_STRUCT *phy_struct,
+                                                      float             *i_samps,
+                                                      float             *q_samps,
+                                                      uint32            *symb_starts,
+                                                      uint32            *N_id_2,
+                                                      uint32            *pss_symb,
+                                                      float             *pss_thresh,
+                                                      float             *freq_offset)
+{
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
+    float              corr_re_n1;
+    float              corr_im_n1;
+    float              corr_re;
+    float              corr_im;
+    float              corr_re_p1;
+    float              corr_im_p1;
+    float              abs_corr_n1;
+    float              abs_corr;
+    float              abs_corr_p1;
+    float              corr_max;
+    float              pss_re[63];
+    float              pss_im[63];
+    float             *pss_mod_re;
+    float             *pss_mod_im;
+    int32              i;
+    int32              idx;
+    uint32             j;
+    uint32             k;
+    uint32             z;
+    uint32             N_s;
+    uint32             N_symb;
+    uint32             pss_timing_idx;
+    int8               timing;
+
+    if(phy_struct  != NULL &&
+       i_samps     != NULL &&
+       q_samps     != NULL &&
+       symb_starts != NULL &&
+       N_id_2      != NULL &&
+       pss_symb    != NULL &&
+       pss_thresh  != NULL)
+    {
+        // Generate PSS
+        for(i=0; i<3; i++)
+        {
+            for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
+            {
+                phy_struct->pss_mod_re[i][j] = 0;
+                phy_struct->pss_mod_im[i][j] = 0;
+            }
+            generate_pss(i, pss_re, pss_im);
+            for(j=0; j<62; j++)
+            {
+                k                                 = j - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
+                phy_struct->pss_mod_re_n1[i][k-1] = pss_re[j];
+                phy_struct->pss_mod_im_n1[i][k-1] = pss_im[j];
+                phy_struct->pss_mod_re[i][k]      = pss_re[j];
+                phy_struct->pss_mod_im[i][k]      = pss_im[j];
+                phy_struct->pss_mod_re_p1[i][k+1] = pss_re[j];
+                phy_struct->pss_mod_im_p1[i][k+1] = pss_im[j];
+            }
+        }
+
+        // Demod symbols and correlate with PSS
+        corr_max = 0;
+        for(i=0; i<12; i++)
+        {
+            for(j=0; j<N_SYMB_DL_NORMAL_CP; j++)
+            {
+                samples_to_symbols_dl(phy_struct,
+                                      i_samps,
+                                      q_samps,
+                                      symb_starts[j]+(phy_struct->N_samps_per_slot*i),
+                                      0,
+                                      phy_struct->rx_symb_re,
+                                      phy_struct->rx_symb_im);
+
+                for(k=0; k<3; k++)
+                {
+                    corr_re_n1 = 0;
+                    corr_im_n1 = 0;
+                    corr_re    = 0;
+                    corr_im    = 0;
+                    corr_re_p1 = 0;
+                    corr_im_p1 = 0;
+                    for(z=0; z<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; z++)
+                    {
+                        corr_re_n1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_re_n1[k][z] +
+                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_im_n1[k][z]);
+                        corr_im_n1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_im_n1[k][z] -
+                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_re_n1[k][z]);
+                        corr_re    += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_re[k][z] +
+                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_im[k][z]);
+                        corr_im    += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_im[k][z] -
+                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_re[k][z]);
+                        corr_re_p1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_re_p1[k][z] +
+                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_im_p1[k][z]);
+                        corr_im_p1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_im_p1[k][z] -
+                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_re_p1[k][z]);
+                    }
+                    abs_corr_n1 = sqrt(corr_re_n1*corr_re_n1 + corr_im_n1*corr_im_n1);
+                    abs_corr    = sqrt(corr_re*corr_re + corr_im*corr_im);
+                    abs_corr_p1 = sqrt(corr_re_p1*corr_re_p1 + corr_im_p1*corr_im_p1);
+                    if(abs_corr_n1 > corr_max)
+                    {
+                        idx       = -1;
+                        corr_max  = abs_corr_n1;
+                        *pss_symb = (i*N_SYMB_DL_NORMAL_CP)+j;
+                        *N_id_2   = k;
+                    }
+                    if(abs_corr > corr_max)
+                    {
+                        idx       = 0;
+                        corr_max  = abs_corr;
+                        *pss_symb = (i*N_SYMB_DL_NORMAL_CP)+j;
+                        *N_id_2   = k;
+                    }
+                    if(abs_corr_p1 > corr_max)
+                    {
+                        idx       = 1;
+                        corr_max  = abs_corr_p1;
+                        *pss_symb = (i*N_SYMB_DL_NORMAL_CP)+j;
+                        *N_id_2   = k;
+                    }
+                }
+            }
+        }
+        if(-1 == idx)
+        {
+            pss_mod_re   = &phy_struct->pss_mod_re_n1[*N_id_2][0];
+            pss_mod_im   = &phy_struct->pss_mod_im_n1[*N_id_2][0];
+            *freq_offset = -15000; // FIXME
+        }else if(0 == idx){
+            pss_mod_re   = &phy_struct->pss_mod_re[*N_id_2][0];
+            pss_mod_im   = &phy_struct->pss_mod_im[*N_id_2][0];
+            *freq_offset = 0;
+        }else{
+            pss_mod_re   = &phy_struct->pss_mod_re_p1[*N_id_2][0];
+            pss_mod_im   = &phy_struct->pss_mod_im_p1[*N_id_2][0];
+            *freq_offset = 15000; // FIXME
+        }
+
+        // Find optimal timing
+        N_s      = (*pss_symb)/7;
+        N_symb   = (*pss_symb)%7;
+        corr_max = 0;
+        timing   = 0;
+        for(i=-40; i<40; i++)
+        {
+            idx = symb_starts[N_symb] + (phy_struct->N_samps_per_slot*N_s);
+            if(i < 0)
+            {
+                if(idx >= -i)
+                {
+                    idx += i;
+                }
+            }else{
+                idx += i;
+            }
+
+            samples_to_symbols_dl(phy_struct,
+                                  i_samps,
+                                  q_samps,
+                                  idx,
+                                  0,
+                                  phy_struct->rx_symb_re,
+                                  phy_struct->rx_symb_im);
+
+            corr_re = 0;
+            corr_im = 0;
+            for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
+            {
+                corr_re += (phy_struct->rx_symb_re[j]*pss_mod_re[j] +
+                            phy_struct->rx_symb_im[j]*pss_mod_im[j]);
+                corr_im += (phy_struct->rx_symb_re[j]*pss_mod_im[j] -
+                            phy_struct->rx_symb_im[j]*pss_mod_re[j]);
+            }
+            abs_corr = sqrt(corr_re*corr_re + corr_im*corr_im);
+            if(abs_corr > corr_max)
+            {
+                corr_max = abs_corr;
+                timing   = i;
+            }
+        }
+        *pss_thresh = corr_max;
+
+        // Construct fine symbol start locations
+        pss_timing_idx = symb_starts[N_symb]+(phy_struct->N_samps_per_slot*N_s)+timing;
+        while((pss_timing_idx + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else) < phy_struct->N_samps_per_slot)
+        {
+            pss_timing_idx += phy_struct->N_samps_per_frame;
+        }
+        symb_starts[0] = pss_timing_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*1 - phy_struct->N_samps_per_slot;
+        for(i=1; i<7; i++)
+        {
+            symb_starts[i] = pss_timing_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*i + phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_0 - phy_struct->N_samps_per_slot;
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_map_sss
+
+    Description: Maps the Secondary Synchronization Signal to the
+                 subframe.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.2
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_map_sss(LIBLTE_PHY_STRUCT          *phy_struct,
+                                     LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                     uint32                      N_id_1,
+                                     uint32                      N_id_2,
+                                     uint8                       N_ant)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            p;
+    uint32            i;
+    uint32            k;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL)
+    {
+        generate_sss(phy_struct,
+                     N_id_1,
+                     N_id_2,
+                     phy_struct->sss_mod_re_0[0],
+                     phy_struct->sss_mod_im_0[0],
+                     phy_struct->sss_mod_re_5[0],
+                     phy_struct->sss_mod_im_5[0]);
+
+        if(subframe->num == 0)
+        {
+            for(p=0; p<N_ant; p++)
+            {
+                for(i=0; i<62; i++)
+                {
+                    k                             = i - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
+                    liblte_phy_set_tx_symb(subframe, p, 5, k, phy_struct->sss_mod_re_0[0][i], phy_struct->sss_mod_im_0[0][i]);
+                }
+            }
+        }else if(subframe->num == 5){
+            for(p=0; p<N_ant; p++)
+            {
+                for(i=0; i<62; i++)
+                {
+                    k                             = i - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
+                    liblte_phy_set_tx_symb(subframe, p, 5, k, phy_struct->sss_mod_re_5[0][i], phy_struct->sss_mod_im_5[0][i]);
+                }
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_find_sss
+
+    Description: Searches for the Secondary Synchronization Signal.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.2
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_find_sss(LIBLTE_PHY_STRUCT *phy_struct,
+                                      float             *i_samps,
+                                      float             *q_samps,
+                                      uint32             N_id_2,
+                                      uint32            *symb_starts,
+                                      float              pss_thresh,
+                                      uint32            *N_id_1,
+                                      uint32            *frame_start_idx)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             sss_thresh;
+    float             corr_re;
+    float             corr_im;
+    float             abs_corr;
+    uint32            i;
+    uint32            j;
+    uint32            k;
+
+    if(phy_struct      != NULL &&
+       i_samps         != NULL &&
+       q_samps         != NULL &&
+       symb_starts     != NULL &&
+       N_id_1          != NULL &&
+       frame_start_idx != NULL)
+    {
+        // Generate secondary synchronization signals, only the 62
+        // center subcarriers are non zero so only those are correlated
+        for(i=0; i<168; i++)
+        {
+            generate_sss(phy_struct,
+                         i,
+                         N_id_2,
+                         phy_struct->sss_mod_re_0[i],
+                         phy_struct->sss_mod_im_0[i],
+                         phy_struct->sss_mod_re_5[i],
+                         phy_struct->sss_mod_im_5[i]);
+        }
+        k = (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2 - 31;
+        sss_thresh = pss_thresh * 0.9;
+
+        // Demod symbol and search for secondary synchronization signals
+        samples_to_symbols_dl(phy_struct,
+                              i_samps,
+                              q_samps,
+                              symb_starts[5],
+                              0,
+                              phy_struct->rx_symb_re,
+                              phy_struct->rx_symb_im);
+        for(i=0; i<168; i++)
+        {
+            corr_re = 0;
+            corr_im = 0;
+            for(j=0; j<62; j++)
+            {
+                corr_re += (phy_struct->rx_symb_re[k+j]*phy_struct->sss_mod_re_0[i][j] +
+                            phy_struct->rx_symb_im[k+j]*phy_struct->sss_mod_im_0[i][j]);
+                corr_im += (phy_struct->rx_symb_re[k+j]*phy_struct->sss_mod_im_0[i][j] -
+                            phy_struct->rx_symb_im[k+j]*phy_struct->sss_mod_re_0[i][j]);
+            }
+            abs_corr = sqrt(corr_re*corr_re + corr_im*corr_im);
+            if(abs_corr > sss_thresh)
+            {
+                while(symb_starts[5] < ((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0))
+                {
+                    symb_starts[5] += phy_struct->N_samps_per_frame;
+                }
+                *N_id_1          = i;
+                *frame_start_idx = symb_starts[5] - ((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0);
+                err              = LIBLTE_SUCCESS;
+                break;
+            }
+
+            corr_re = 0;
+            corr_im = 0;
+            for(j=0; j<62; j++)
+            {
+                corr_re += (phy_struct->rx_symb_re[k+j]*phy_struct->sss_mod_re_5[i][j] +
+                            phy_struct->rx_symb_im[k+j]*phy_struct->sss_mod_im_5[i][j]);
+                corr_im += (phy_struct->rx_symb_re[k+j]*phy_struct->sss_mod_im_5[i][j] -
+                            phy_struct->rx_symb_im[k+j]*phy_struct->sss_mod_re_5[i][j]);
+            }
+            abs_corr = sqrt(corr_re*corr_re + corr_im*corr_im);
+            if(abs_corr > sss_thresh)
+            {
+                while(symb_starts[5] < (((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0) + phy_struct->N_samps_per_slot*10))
+                {
+                    symb_starts[5] += phy_struct->N_samps_per_frame;
+                }
+                *N_id_1          = i;
+                *frame_start_idx = symb_starts[5] - ((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0) - phy_struct->N_samps_per_slot*10;
+                err              = LIBLTE_SUCCESS;
+                break;
+            }
+        }
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_dl_find_coarse_timing_and_freq_offset
+
+    Description: Finds coarse time syncronization and frequency offset
+                 by auto-correlating to find the cyclic prefix on
+                 reference signal symbols of the downlink, or by
+                 correlating with the PSS if selected with
+                 liblte_phy_set_coarse_timing_method
+
+    Document Reference: 3GPP TS 36.211 v10.1.0
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_dl_find_coarse_timing_and_freq_offset(LIBLTE_PHY_STRUCT               *phy_struct,
+                                                                   float                           *i_samps,
+                                                                   float                           *q_samps,
+                                                                   uint32                           N_slots,
+                                                                   LIBLTE_PHY_COARSE_TIMING_STRUCT *timing_struct)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    double            corr_acc_re;
+    double            corr_acc_im;
+    float             corr_re;
+    float             corr_im;
+    float             corr_mean = 0;
+    float             abs_corr_max;
+    float             freq_err[LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS];
+    int32             abs_corr_idx[LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS];
+    int32             tmp_idx;
+    uint32            slot;
+    uint32            i;
+    uint32            j;
+    uint32            k;
+    uint32            idx;
+    uint32            N_samps_per_symb_else = phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else;
+    uint32            N_samps_to_blank      = N_samps_per_symb_else/10;
+
+    if(phy_struct    != NULL &&
+       i_samps       != NULL &&
+       q_samps       != NULL &&
+       timing_struct != NULL)
+    {
+        if(LIBLTE_PHY_COARSE_TIMING_METHOD_PSS_CORR == phy_struct->dl_timing_method)
+        {
+            pss_coarse_timing_search(phy_struct,
+                                     i_samps,
+                                     q_samps,
+                                     N_slots,
+                                     abs_corr_idx,
+                                     &timing_struct->n_corr_peaks);
+        }else{
+            // Timing correlation
+            for(i=0; i<phy_struct->N_samps_per_slot; i++)
+            {
+                phy_struct->dl_timing_abs_corr[i] = 0;
+            }
+            for(slot=0; slot<N_slots; slot++)
+            {
+                // Products of each sample with the sample one symbol later
+                for(i=0; i<phy_struct->N_samps_per_slot+phy_struct->N_samps_cp_l_else-1; i++)
+                {
+                    idx                              = (slot*phy_struct->N_samps_per_slot) + i;
+                    phy_struct->dl_timing_prod_re[i] = i_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb] + q_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb];
+                    phy_struct->dl_timing_prod_im[i] = i_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb] - q_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb];
+                }
+
+                // Running sum over a CP length window
+                corr_acc_re = 0;
+                corr_acc_im = 0;
+                for(j=0; j<phy_struct->N_samps_cp_l_else; j++)
+                {
+                    corr_acc_re += phy_struct->dl_timing_prod_re[j];
+                    corr_acc_im += phy_struct->dl_timing_prod_im[j];
+                }
+                for(i=0; i<phy_struct->N_samps_per_slot; i++)
+                {
+                    if(i > 0)
+                    {
+                        corr_acc_re += phy_struct->dl_timing_prod_re[i+phy_struct->N_samps_cp_l_else-1] - phy_struct->dl_timing_prod_re[i-1];
+                        corr_acc_im += phy_struct->dl_timing_prod_im[i+phy_struct->N_samps_cp_l_else-1] - phy_struct->dl_timing_prod_im[i-1];
+                    }
+                    phy_struct->dl_timing_abs_corr[i] += corr_acc_re*corr_acc_re + corr_acc_im*corr_acc_im;
+                }
+            }
+
+            // Find mean of correlation and gate correlation results
+            for(i=0; i<phy_struct->N_samps_per_slot; i++)
+            {
+                corr_mean                                                      += phy_struct->dl_timing_abs_corr[i];
+                phy_struct->dl_timing_abs_corr[i+phy_struct->N_samps_per_slot]  = phy_struct->dl_timing_abs_corr[i];
+            }
+            corr_mean /= phy_struct->N_samps_per_slot;
+            for(i=0; i<phy_struct->N_samps_per_slot; i++)
+            {
+                if(phy_struct->dl_timing_abs_corr[i] <= corr_mean)
+                {
+                    phy_struct->dl_timing_abs_corr[i]                              = 0;
+                    phy_struct->dl_timing_abs_corr[i+phy_struct->N_samps_per_slot] = 0;
+                }
+            }
+
+            // Multiply to get (first_symbol * fourth_symbol)
+            for(i=0; i<phy_struct->N_samps_per_slot; i++)
+            {
+                phy_struct->dl_timing_abs_corr[i] *= phy_struct->dl_timing_abs_corr[(phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_0+(phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*3)+i];
+            }
+
+            // Search for all of the eNB signals
+            timing_struct->n_corr_peaks = LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS;
+            for(i=0; i<LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS; i++)
+            {
+                abs_corr_max    = 0;
+                abs_corr_idx[i] = 0;
+                for(j=0; j<phy_struct->N_samps_per_slot; j++)
+                {
+                    if(phy_struct->dl_timing_abs_corr[j] > abs_corr_max)
+                    {
+                        abs_corr_max    = phy_struct->dl_timing_abs_corr[j];
+                        abs_corr_idx[i] = j;
+                    }
+                }
+
+                if(0 == abs_corr_max)
+                {
+                    timing_struct->n_corr_peaks = i;
+                    break;
+                }else{
+                    // Get rid of max and peaks
+                    tmp_idx = abs_corr_idx[i];
+                    while(tmp_idx > 0)
+                    {
+                        tmp_idx -= N_samps_per_symb_else;
+                    }
+                    for(j=0; j<7; j++)
+                    {
+                        tmp_idx += N_samps_per_symb_else;
+                        for(k=0; k<N_samps_to_blank; k++)
+                        {
+                            idx = tmp_idx - (N_samps_to_blank/2) + k;
+                            if(idx >= 0 &&
+                               idx <= (LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ*2))
+                            {
+                                phy_struct->dl_timing_abs_corr[idx] = 0;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Determine frequency offset
+        for(i=0; i<timing_struct->n_corr_peaks; i++)
+        {
+            freq_err[i] = 0;
+        }
+        for(slot=0; slot<N_slots; slot++)
+        {
+            for(i=0; i<timing_struct->n_corr_peaks; i++)
+            {
+                corr_re = 0;
+                corr_im = 0;
+                for(j=0; j<phy_struct->N_samps_cp_l_else; j++)
+                {
+                    idx      = (slot*phy_struct->N_samps_per_slot) + abs_corr_idx[i] + j;
+                    corr_re += i_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb] + q_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb];
+                    corr_im += i_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb] - q_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb];
+                }
+                freq_err[i] += atan2f(corr_im, corr_re)/(phy_struct->N_samps_per_symb*2*M_PI*(0.0005/phy_struct->N_samps_per_slot));
+            }
+        }
+        for(i=0; i<timing_struct->n_corr_peaks; i++)
+        {
+            // FIXME: No integer offset is calculated
+            timing_struct->freq_offset[i] = freq_err[i]/N_slots;
+        }
+
+        // Determine the symbol start locations
+        for(i=0; i<timing_struct->n_corr_peaks; i++)
+        {
+            while(abs_corr_idx[i] > 0)
+            {
+                abs_corr_idx[i] -= N_samps_per_symb_else;
+            }
+            for(j=0; j<7; j++)
+            {
+                timing_struct->symb_starts[i][j] = abs_corr_idx[i] + ((j+1)*N_samps_per_symb_else);
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_create_dl_subframe
+
+    Description: Creates the baseband signal for a particular
+                 downlink subframe
+
+    Document Reference: 3GPP TS 36.211 v10.1.0
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_create_dl_subframe(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                                uint8                       ant,
+                                                float                      *i_samps,
+                                                float                      *q_samps)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            idx     = 0;
+    uint32            N_samps = 0;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL &&
+       i_samps    != NULL &&
+       q_samps    != NULL)
+    {
+        // Modulate symbols
+        for(i=0; i<14; i++)
+        {
+            idx += N_samps;
+            symbols_to_samples_dl(phy_struct,
+                                  subframe,
+                                  ant,
+                                  i,
+                                  &i_samps[idx],
+                                  &q_samps[idx],
+                                  &N_samps);
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_create_dl_subframe_cf
+
+    Description: Creates the interleaved complex baseband signal for a
+                 particular downlink subframe
+
+    Document Reference: 3GPP TS 36.211 v10.1.0
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_create_dl_subframe_cf(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                   LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                                   uint8                       ant,
+                                                   LIBLTE_PHY_CF_STRUCT       *samps)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            idx     = 0;
+    uint32            N_samps = 0;
+
+    if(phy_struct != NULL &&
+       subframe   != NULL &&
+       samps      != NULL)
+    {
+        // Modulate symbols
+        for(i=0; i<14; i++)
+        {
+            idx += N_samps;
+            symbols_to_samples_dl_cf(phy_struct,
+                                     subframe,
+                                     ant,
+                                     i,
+                                     &samps[idx],
+                                     &N_samps);
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_get_dl_subframe_and_ce
+
+    Description: Resolves all symbols and channel estimates for a
+                 particular downlink subframe
+
+    Document Reference: 3GPP TS 36.211 v10.1.0
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_get_dl_subframe_and_ce(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                    float                      *i_samps,
+                                                    float                      *q_samps,
+                                                    uint32                      frame_start_idx,
+                                                    uint8                       subfr_num,
+                                                    uint32                      N_id_cell,
+                                                    uint8                       N_ant,
+                                                    LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+{
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             *crs_re[16];
+    float             *crs_im[16];
+    float             *rs_re;
+    float             *rs_im;
+    float             *ce_re[5];
+    float             *ce_im[5];
+    float              sym_re;
+    float              sym_im;
+    uint32             v_shift         = N_id_cell % 6;
+    uint32             subfr_start_idx = frame_start_idx + subfr_num*phy_struct->N_samps_per_subfr;
+    uint32             N_sc            = phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl;
+    uint32             N_sym;
+    uint32             m_prime;
+    uint32             i;
+    uint32             j;
+    uint32             k;
+    uint32             p;
+    uint32             v[5];
+    uint32             sym[5];
+    uint32             z;
 
     if(phy_struct != NULL &&
-       pcfich     != NULL &&
-       phich      != NULL &&
-       pdcch      != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503  &&
+       i_samps    != NULL &&
+       q_samps    != NULL &&
+       (N_ant     == 1    ||
+        N_ant     == 2    ||
+        N_ant     == 4)   &&
        subframe   != NULL)
     {
-        // PCFICH
-        pcfich_channel_map(phy_struct, pcfich, N_id_cell, N_ant, subframe);
-
-        // PHICH
-        phich_channel_map(phy_struct, phich, pcfich, N_id_cell, N_ant, phich_res, phich_dur, subframe);
-
-        // PDCCH
-        if(pdcch->N_alloc != 0)
-        {
-            // Calculate number of symbols, 3GPP TS 36.211 v10.1.0 section 6.7
-            pdcch->N_symbs = pcfich->cfi;
-            if(phy_struct->N_rb_dl <= 10)
-            {
-                pdcch->N_symbs++;
-            }
-            // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.8.1
-            N_reg_rb    = 3;
-            N_reg_pdcch = pdcch->N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - pcfich->N_reg - phich->N_reg;
-            if(N_ant == 4)
-            {
-                // Remove CRS
-                N_reg_pdcch -= phy_struct->N_rb_dl;
-            }
-            N_cce_pdcch = N_reg_pdcch/LIBLTE_PHY_PDCCH_N_REG_CCE;
+        subframe->num = subfr_num;
 
-            // Initialize the search space
-            for(p=0; p<N_ant; p++)
+        // Demodulate symbols
+        samples_to_subframe_dl(phy_struct,
+                               i_samps,
+                               q_samps,
+                               subfr_start_idx,
+                               subframe);
+
+        // Get cell specific reference signals
+        crs_cache_get(phy_struct, (subfr_num*2+0)%20, 0, N_id_cell, &crs_re[0],  &crs_im[0]);
+        crs_cache_get(phy_struct, (subfr_num*2+0)%20, 1, N_id_cell, &crs_re[1],  &crs_im[1]);
+        crs_cache_get(phy_struct, (subfr_num*2+0)%20, 4, N_id_cell, &crs_re[4],  &crs_im[4]);
+        crs_cache_get(phy_struct, (subfr_num*2+1)%20, 0, N_id_cell, &crs_re[7],  &crs_im[7]);
+        crs_cache_get(phy_struct, (subfr_num*2+1)%20, 1, N_id_cell, &crs_re[8],  &crs_im[8]);
+        crs_cache_get(phy_struct, (subfr_num*2+1)%20, 4, N_id_cell, &crs_re[11], &crs_im[11]);
+        crs_cache_get(phy_struct, (subfr_num*2+2)%20, 0, N_id_cell, &crs_re[14], &crs_im[14]);
+        crs_cache_get(phy_struct, (subfr_num*2+2)%20, 1, N_id_cell, &crs_re[15], &crs_im[15]);
+
+        // Averaging restarts when the cell changes
+        if(phy_struct->dl_ce_avg_N_id_cell != N_id_cell)
+        {
+            for(p=0; p<LIBLTE_PHY_N_ANT_MAX; p++)
             {
-                for(i=0; i<N_cce_pdcch; i++)
-                {
-                    for(j=0; j<4*LIBLTE_PHY_PDCCH_N_REG_CCE; j++)
-                    {
-                        phy_struct->pdcch_cce_re[p][i][j] = 0;
-                        phy_struct->pdcch_cce_im[p][i][j] = 0;
-                    }
-                    phy_struct->pdcch_cce_used[i] = false;
-                }
+                phy_struct->dl_ce_avg_valid[p] = false;
             }
+            phy_struct->dl_ce_avg_N_id_cell = N_id_cell;
+        }
 
-            // Generate the scrambling sequence
-            c_init = (subframe->num << 9) + N_id_cell;
-            generate_prs_c(c_init, LIBLTE_PHY_PDCCH_N_BITS_MAX * 2, phy_struct->pdcch_c);
-
-            // Add the DCIs
-            for(a_idx=0; a_idx<pdcch->N_alloc; a_idx++)
+        // Determine channel estimates
+        for(p=0; p<N_ant; p++)
+        {
+            // Define v, sym, and N_sym
+            if(p == 0)
             {
-                // Encode the DCI
-                if(LIBLTE_PHY_CHAN_TYPE_DLSCH == pdcch->alloc[a_idx].chan_type)
-                {
-                    dci_1a_pack(&pdcch->alloc[a_idx],
-                                LIBLTE_PHY_DCI_CA_NOT_PRESENT,
-                                phy_struct->N_rb_dl,
-                                N_ant,
-                                phy_struct->pdcch_dci,
-                                &dci_size);
-                }else{ // LIBLTE_PHY_CHAN_TYPE_ULSCH == pdcch->alloc[a_idx].chan_type
-                    dci_0_pack(&pdcch->alloc[a_idx],
-                               LIBLTE_PHY_DCI_CA_NOT_PRESENT,
-                               phy_struct->N_rb_ul,
-                               N_ant,
-                               phy_struct->pdcch_dci,
-                               &dci_size);
-                }
-                N_bits = 288; // Using aggregation level 4 (4*9*4*2 = 288)
-                dci_channel_encode(phy_struct,
-                                   phy_struct->pdcch_dci,
-                                   dci_size,
-                                   pdcch->alloc[a_idx].rnti,
-                                   0,
-                                   N_bits,
-                                   phy_struct->pdcch_encode_bits);
-
-// FIXME: User Specific search space does not work
-//                // Add the DCIs to the search space
-//                if(LIBLTE_MAC_SI_RNTI        == pdcch->alloc[a_idx].rnti ||
-//                   LIBLTE_MAC_P_RNTI         == pdcch->alloc[a_idx].rnti ||
-//                   (LIBLTE_MAC_RA_RNTI_START <= pdcch->alloc[a_idx].rnti &&
-//                    LIBLTE_MAC_RA_RNTI_END   >= pdcch->alloc[a_idx].rnti))
-//                {
-                    // Add to the common search space, using aggregation level of 4
-                    for(css_idx=0; css_idx<4; css_idx++)
-                    {
-                        if(!phy_struct->pdcch_cce_used[4*css_idx+0] &&
-                           !phy_struct->pdcch_cce_used[4*css_idx+1] &&
-                           !phy_struct->pdcch_cce_used[4*css_idx+2] &&
-                           !phy_struct->pdcch_cce_used[4*css_idx+3])
-                        {
-                            for(i=0; i<N_bits; i++)
-                            {
-                                phy_struct->pdcch_scramb_bits[i] = phy_struct->pdcch_encode_bits[i] ^ phy_struct->pdcch_c[4*css_idx*LIBLTE_PHY_PDCCH_N_REG_CCE*4*2 + i];
-                            }
-                            modulation_mapper(phy_struct->pdcch_scramb_bits,
-                                              N_bits,
-                                              LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                                              phy_struct->pdcch_d_re,
-                                              phy_struct->pdcch_d_im,
-                                              &M_symb);
-                            layer_mapper_dl(phy_struct->pdcch_d_re,
-                                            phy_struct->pdcch_d_im,
-                                            M_symb,
-                                            N_ant,
-                                            1,
-                                            LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                            phy_struct->pdcch_x_re,
-                                            phy_struct->pdcch_x_im,
-                                            &M_layer_symb);
-                            pre_coder_dl(phy_struct->pdcch_x_re,
-                                         phy_struct->pdcch_x_im,
-                                         M_layer_symb,
-                                         N_ant,
-                                         LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                         phy_struct->pdcch_y_re[0],
-                                         phy_struct->pdcch_y_im[0],
-                                         576,
-                                         &M_ap_symb);
-                            for(p=0; p<N_ant; p++)
-                            {
-                                idx = 0;
-                                for(i=0; i<4; i++)
-                                {
-                                    for(j=0; j<(4*LIBLTE_PHY_PDCCH_N_REG_CCE); j++)
-                                    {
-                                        phy_struct->pdcch_cce_re[p][4*css_idx+i][j] = phy_struct->pdcch_y_re[p][idx];
-                                        phy_struct->pdcch_cce_im[p][4*css_idx+i][j] = phy_struct->pdcch_y_im[p][idx];
-                                        idx++;
-                                    }
-                                    phy_struct->pdcch_cce_used[4*css_idx+i] = true;
-                                }
-                            }
-                            break;
-                        }
-                    }
-// FIXME: User Specific search space does not work
-//                }else{
-//                    // Add to the user search space, using aggregation level of 4
-//                    Y_k = pdcch->alloc[a_idx].rnti;
-//                    for(i=0; i<=subframe->num; i++)
-//                    {
-//                        Y_k = (39827 * Y_k) % 65537;
-//                    }
-//                    for(uss_idx=0; uss_idx<2; uss_idx++)
-//                    {
-//                        actual_idx = 4*((Y_k+uss_idx) % (N_cce_pdcch/4));
-//                        if(!phy_struct->pdcch_cce_used[actual_idx+0] &&
-//                           !phy_struct->pdcch_cce_used[actual_idx+1] &&
-//                           !phy_struct->pdcch_cce_used[actual_idx+2] &&
-//                           !phy_struct->pdcch_cce_used[actual_idx+3])
-//                        {
-//                            for(i=0; i<N_bits; i++)
-//                            {
-//                                phy_struct->pdcch_scramb_bits[i] = phy_struct->pdcch_encode_bits[i] ^ phy_struct->pdcch_c[4*actual_idx*LIBLTE_PHY_PDCCH_N_REG_CCE*4*2 + i];
-//                            }
-//                            modulation_mapper(phy_struct->pdcch_scramb_bits,
-//                                              N_bits,
-//                                              LIBLTE_PHY_MODULATION_TYPE_QPSK,
-//                                              phy_struct->pdcch_d_re,
-//                                              phy_struct->pdcch_d_im,
-//                                              &M_symb);
-//                            layer_mapper_dl(phy_struct->pdcch_d_re,
-//                                            phy_struct->pdcch_d_im,
-//                                            M_symb,
-//                                            N_ant,
-//                                            1,
-//                                            LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-//                                            phy_struct->pdcch_x_re,
-//                                            phy_struct->pdcch_x_im,
-//                                            &M_layer_symb);
-//                            pre_coder_dl(phy_struct->pdcch_x_re,
-//                                         phy_struct->pdcch_x_im,
-//                                         M_layer_symb,
-//                                         N_ant,
-//                                         LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-//                                         phy_struct->pdcch_y_re[0],
-//                                         phy_struct->pdcch_y_im[0],
-//                                         576,
-//                                         &M_ap_symb);
-//                            for(p=0; p<N_ant; p++)
-//                            {
-//                                idx = 0;
-//                                for(i=0; i<4; i++)
-//                                {
-//                                    for(j=0; j<(4*LIBLTE_PHY_PDCCH_N_REG_CCE); j++)
-//                                    {
-//                                        phy_struct->pdcch_cce_re[p][actual_idx+i][j] = phy_struct->pdcch_y_re[p][idx];
-//                                        phy_struct->pdcch_cce_im[p][actual_idx+i][j] = phy_struct->pdcch_y_im[p][idx];
-//                                        idx++;
-//                                    }
-//                                    phy_struct->pdcch_cce_used[actual_idx+i] = true;
-//                                }
-//                            }
-//                            break;
-//                        }
-//                    }
-//                }
+                v[0]   = 0;
+                v[1]   = 3;
+                v[2]   = 0;
+                v[3]   = 3;
+                v[4]   = 0;
+                sym[0] = 0;
+                sym[1] = 4;
+                sym[2] = 7;
+                sym[3] = 11;
+                sym[4] = 14;
+                N_sym  = 5;
+            }else if(p == 1){
+                v[0]   = 3;
+                v[1]   = 0;
+                v[2]   = 3;
+                v[3]   = 0;
+                v[4]   = 3;
+                sym[0] = 0;
+                sym[1] = 4;
+                sym[2] = 7;
+                sym[3] = 11;
+                sym[4] = 14;
+                N_sym  = 5;
+            }else if(p == 2){
+                v[0]   = 0;
+                v[1]   = 3;
+                v[2]   = 0;
+                sym[0] = 1;
+                sym[1] = 8;
+                sym[2] = 15;
+                N_sym  = 3;
+            }else{ // p == 3
+                v[0]   = 3;
+                v[1]   = 6;
+                v[2]   = 3;
+                sym[0] = 1;
+                sym[1] = 8;
+                sym[2] = 15;
+                N_sym  = 3;
             }
-            // Construct REGs
-            for(p=0; p<N_ant; p++)
+
+            for(i=0; i<N_sym; i++)
             {
-                for(i=0; i<N_cce_pdcch; i++)
+                rs_re = crs_re[sym[i]];
+                rs_im = crs_im[sym[i]];
+
+                // Channel estimates at the CRSs
+                for(j=0; j<2*phy_struct->N_rb_dl; j++)
                 {
-                    for(j=0; j<LIBLTE_PHY_PDCCH_N_REG_CCE; j++)
+                    k                              = 6*j + (v[i] + v_shift)%6;
+                    m_prime                        = j + LIBLTE_PHY_N_RB_DL_MAX - phy_struct->N_rb_dl;
+                    sym_re                         = liblte_phy_rx_symb_re(subframe, sym[i], k);
+                    sym_im                         = liblte_phy_rx_symb_im(subframe, sym[i], k);
+                    phy_struct->dl_ce_crs_re[i][j] = sym_re*rs_re[m_prime] + sym_im*rs_im[m_prime];
+                    phy_struct->dl_ce_crs_im[i][j] = sym_im*rs_re[m_prime] - sym_re*rs_im[m_prime];
+                }
+
+                // Interpolate between CRSs
+                dl_ce_interp_freq(phy_struct,
+                                  (v[i] + v_shift)%6,
+                                  phy_struct->dl_ce_crs_re[i],
+                                  phy_struct->dl_ce_crs_im[i],
+                                  phy_struct->dl_ce_re[i],
+                                  phy_struct->dl_ce_im[i]);
+                ce_re[i] = phy_struct->dl_ce_re[i];
+                ce_im[i] = phy_struct->dl_ce_im[i];
+
+                // Average across subframes
+                if(phy_struct->dl_ce_avg_alpha < 1)
+                {
+                    if(phy_struct->dl_ce_avg_valid[p])
                     {
-                        for(k=0; k<4; k++)
-                        {
-                            phy_struct->pdcch_reg_re[p][i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k] = phy_struct->pdcch_cce_re[p][i][j*4+k];
-                            phy_struct->pdcch_reg_im[p][i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k] = phy_struct->pdcch_cce_im[p][i][j*4+k];
-                        }
+                        dl_ce_interp_time(phy_struct->dl_ce_avg_re[p][i],
+                                          phy_struct->dl_ce_avg_im[p][i],
+                                          ce_re[i],
+                                          ce_im[i],
+                                          phy_struct->dl_ce_avg_alpha,
+                                          N_sc,
+                                          phy_struct->dl_ce_avg_re[p][i],
+                                          phy_struct->dl_ce_avg_im[p][i]);
+                    }else{
+                        memcpy(phy_struct->dl_ce_avg_re[p][i], ce_re[i], sizeof(float)*N_sc);
+                        memcpy(phy_struct->dl_ce_avg_im[p][i], ce_im[i], sizeof(float)*N_sc);
                     }
+                    ce_re[i] = phy_struct->dl_ce_avg_re[p][i];
+                    ce_im[i] = phy_struct->dl_ce_avg_im[p][i];
                 }
             }
-            // Permute the REGs, 3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
-            for(p=0; p<N_ant; p++)
+            if(phy_struct->dl_ce_avg_alpha < 1)
             {
-                for(i=0; i<N_reg_pdcch; i++)
+                phy_struct->dl_ce_avg_valid[p] = true;
+            }
+
+            // Interpolate between symbols to construct all channel
+            // estimates, extrapolating before the first CRS symbol
+            // FIXME: Use previous slot to do symbol 0 correctly for p 2 and 3
+            i = 0;
+            for(z=0; z<14; z++)
+            {
+                while(i < N_sym-2 && sym[i+1] <= z)
                 {
-                    for(j=0; j<4; j++)
-                    {
-                        phy_struct->pdcch_perm_re[p][i][j] = phy_struct->pdcch_reg_re[p][phy_struct->pdcch_permute_map[N_reg_pdcch][i]][j];
-                        phy_struct->pdcch_perm_im[p][i][j] = phy_struct->pdcch_reg_im[p][phy_struct->pdcch_permute_map[N_reg_pdcch][i]][j];
-                    }
+                    i++;
                 }
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+                dl_ce_interp_time_cf(ce_re[i],
+                                     ce_im[i],
+                                     ce_re[i+1],
+                                     ce_im[i+1],
+                                     ((float)z - (float)sym[i])/(float)(sym[i+1] - sym[i]),
+                                     N_sc,
+                                     &subframe->rx_ce[p][z][0]);
+#else
+                dl_ce_interp_time(ce_re[i],
+                                  ce_im[i],
+                                  ce_re[i+1],
+                                  ce_im[i+1],
+                                  ((float)z - (float)sym[i])/(float)(sym[i+1] - sym[i]),
+                                  N_sc,
+                                  &subframe->rx_ce_re[p][z][0],
+                                  &subframe->rx_ce_im[p][z][0]);
+#endif
             }
-            // Cyclic shift the REGs
-            for(p=0; p<N_ant; p++)
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_get_ul_subframe
+
+    Description: Resolves all symbols for a particular uplink subframe
+
+    Document Reference: 3GPP TS 36.211 v10.1.0
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_get_ul_subframe(LIBLTE_PHY_STRUCT          *phy_struct,
+                                             float                      *i_samps,
+                                             float                      *q_samps,
+                                             LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL &&
+       i_samps    != NULL &&
+       q_samps    != NULL &&
+       subframe   != NULL)
+    {
+        // Demodulate symbols
+        samples_to_subframe_ul(phy_struct,
+                               i_samps,
+                               q_samps,
+                               1,
+                               subframe);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_get_ul_subframe_cf
+
+    Description: Resolves all symbols for a particular uplink subframe
+                 from interleaved complex samples
+
+    Document Reference: 3GPP TS 36.211 v10.1.0
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_get_ul_subframe_cf(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                LIBLTE_PHY_CF_STRUCT       *samps,
+                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(phy_struct != NULL &&
+       samps      != NULL &&
+       subframe   != NULL)
+    {
+        // Demodulate symbols
+        samples_to_subframe_ul(phy_struct,
+                               &samps[0].re,
+                               &samps[0].im,
+                               2,
+                               subframe);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_get_tbs_mcs_and_n_prb_for_dl
+
+    Description: Determines the transport block size, modulation and
+                 coding scheme, and the number of PRBs needed to send
+                 the specified number of DL bits
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 7.1.7
+
+    NOTES: Currently only supports DCI format 1A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_get_tbs_mcs_and_n_prb_for_dl(uint32  N_bits,
+                                                          uint32  N_subframe,
+                                                          uint32  N_rb_dl,
+                                                          uint16  rnti,
+                                                          uint32 *tbs,
+                                                          uint8  *mcs,
+                                                          uint32 *N_prb)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            i;
+    uint32            j;
+    uint32            code_rate;
+    uint32            N_prb_tmp;
+    uint32            N_bits_per_prb;
+    uint32            I_tbs;
+
+    if(tbs   != NULL &&
+       mcs   != NULL &&
+       N_prb != NULL)
+    {
+        if(LIBLTE_MAC_SI_RNTI        == rnti ||
+           LIBLTE_MAC_P_RNTI         == rnti ||
+           (LIBLTE_MAC_RA_RNTI_START <= rnti &&
+            LIBLTE_MAC_RA_RNTI_END   >= rnti))
+        {
+            // Choose N_prb == 2 to give the largest possible tbs
+            N_prb_tmp = 2;
+            for(i=0; i<27; i++)
             {
-                for(i=0; i<N_reg_pdcch; i++)
+                if(N_bits <= TBS_71721[i][N_prb_tmp])
                 {
-                    shift_idx = (i+N_id_cell) % N_reg_pdcch;
-                    for(j=0; j<4; j++)
-                    {
-                        phy_struct->pdcch_shift_re[p][i][j] = phy_struct->pdcch_perm_re[p][shift_idx][j];
-                        phy_struct->pdcch_shift_im[p][i][j] = phy_struct->pdcch_perm_im[p][shift_idx][j];
-                    }
+                    *tbs = TBS_71721[i][N_prb_tmp];
+                    *mcs = i;
+                    break;
                 }
             }
-            // Map the REGs to resource elements, 3GPP TS 36.211 v10.1.0 section 6.8.5
-            // Step 1 and 2
-            m_prime = 0;
-            k_prime = 0;
-            // Step 10
-            while(k_prime < (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl))
+
+            // Target coding rate is 4:1, will allow down to 3:1
+            N_bits_per_prb = get_num_bits_in_prb(N_subframe, 3, N_rb_dl/2, N_rb_dl, 2, LIBLTE_PHY_MODULATION_TYPE_QPSK);
+            *N_prb         = 0;
+            for(code_rate=4; code_rate>2; code_rate--)
             {
-                // Step 3
-                l_prime = 0;
-                // Step 8
-                while(l_prime < pdcch->N_symbs)
+                for(i=1; i<=N_rb_dl; i++)
                 {
-                    if(l_prime == 0)
+                    if((*tbs * code_rate) < (N_bits_per_prb*i))
                     {
-                        // Step 4
-                        // Avoid PCFICH and PHICH
-                        valid_reg = true;
-                        for(i=0; i<pcfich->N_reg; i++)
-                        {
-                            if(k_prime == pcfich->k[i])
-                            {
-                                valid_reg = false;
-                            }
-                        }
-                        for(i=0; i<phich->N_reg; i++)
-                        {
-                            if(k_prime == phich->k[i])
-                            {
-                                valid_reg = false;
-                            }
-                        }
-                        if((k_prime % 6) == 0 && valid_reg == true)
-                        {
-                            if(m_prime < N_reg_pdcch)
-                            {
-                                // Step 5
-                                idx = 0;
-                                for(i=0; i<6; i++)
-                                {
-                                    // Avoid CRS
-                                    if((N_id_cell % 3) != (i % 3))
-                                    {
-                                        for(p=0; p<N_ant; p++)
-                                        {
-                                            subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_re[p][m_prime][idx];
-                                            subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_im[p][m_prime][idx];
-                                        }
-                                        idx++;
-                                    }
-                                }
-                                // Step 6
-                                m_prime++;
-                            }
-                        }
-                    }else if(l_prime == 1 && N_ant == 4){
-                        // Step 4
-                        if((k_prime % 6) == 0)
-                        {
-                            if(m_prime < N_reg_pdcch)
-                            {
-                                // Step 5
-                                idx = 0;
-                                for(i=0; i<6; i++)
-                                {
-                                    // Avoid CRS
-                                    if((N_id_cell % 3) != (i % 3))
-                                    {
-                                        for(p=0; p<N_ant; p++)
-                                        {
-                                            subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_re[p][m_prime][idx];
-                                            subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_im[p][m_prime][idx];
-                                        }
-                                        idx++;
-                                    }
-                                }
-                                // Step 6
-                                m_prime++;
-                            }
-                        }
+                        *N_prb = i;
+                        break;
+                    }
+                }
+                if(*N_prb != 0)
+                {
+                    break;
+                }
+            }
+            if(*N_prb != 0)
+            {
+                err = LIBLTE_SUCCESS;
+            }
+        }else{
+            *N_prb = 0;
+            for(i=0; i<27; i++)
+            {
+                for(j=0; j<N_rb_dl; j++)
+                {
+                    if(N_bits <= TBS_71721[i][j])
+                    {
+                        *tbs   = TBS_71721[i][j];
+                        I_tbs  = i;
+                        *N_prb = j + 1;
+                        break;
+                    }
+                }
+                if(*N_prb != 0)
+                {
+                    if(9 >= I_tbs)
+                    {
+                        *mcs = I_tbs;
+                    }else if(15 >= I_tbs){
+                        *mcs = I_tbs + 1;
                     }else{
-                        // Step 4
-                        if((k_prime % 4) == 0)
-                        {
-                            if(m_prime < N_reg_pdcch)
-                            {
-                                // Step 5
-                                for(i=0; i<4; i++)
-                                {
-                                    for(p=0; p<N_ant; p++)
-                                    {
-                                        subframe->tx_symb_re[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_re[p][m_prime][i];
-                                        subframe->tx_symb_im[p][l_prime][k_prime+i] = phy_struct->pdcch_shift_im[p][m_prime][i];
-                                    }
-                                }
-                                // Step 6
-                                m_prime++;
-                            }
-                        }
+                        *mcs = I_tbs + 2;
                     }
-                    // Step 7
-                    l_prime++;
+                    break;
                 }
-                // Step 9
-                k_prime++;
+            }
+            if(*N_prb != 0)
+            {
+                err = LIBLTE_SUCCESS;
             }
         }
-
-        err = LIBLTE_SUCCESS;
     }
 
     return(err);
 }
 
 /*********************************************************************
-    Name: liblte_phy_pdcch_channel_decode
+    Name: liblte_phy_get_tbs_and_n_prb_for_dl
 
-    Description: Demodulates and decodes all of the Physical Downlink
-                 Control Channels (PCFICH, PHICH, and PDCCH)
+    Description: Determines the transport block size and the number of
+                 PRBs needed to send the specified number of DL bits
+                 according to the specified modulation and coding
+                 scheme
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.7, 6.8, and
-                        6.9
-                        3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 7.1.7
+
+    NOTES: Currently only supports single layer transport blocks
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pdcch_channel_decode(LIBLTE_PHY_STRUCT              *phy_struct,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT     *subframe,
-                                                  uint32                          N_id_cell,
-                                                  uint8                           N_ant,
-                                                  float                           phich_res,
-                                                  LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
-                                                  LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
-                                                  LIBLTE_PHY_PHICH_STRUCT        *phich,
-                                                  LIBLTE_PHY_PDCCH_STRUCT        *pdcch)
+LIBLTE_ERROR_ENUM liblte_phy_get_tbs_and_n_prb_for_dl(uint32  N_bits,
+                                                      uint32  N_rb_dl,
+                                                      uint8   mcs,
+                                                      uint32 *tbs,
+                                                      uint32 *N_prb)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            I_tbs;
     uint32            i;
-    uint32            j;
-    uint32            k;
-    uint32            p;
-    uint32            idx;
-    uint32            c_init;
-    uint32            M_layer_symb;
-    uint32            M_symb;
-    uint32            N_bits;
-    uint32            k_prime;
-    uint32            l_prime;
-    uint32            m_prime;
-    uint32            dci_1a_size;
-    uint32            dci_1c_size;
-    uint32            N_reg_rb;
-    uint32            shift_idx;
-    uint32            C_cc_sb;
-    uint32            R_cc_sb;
-    uint32            K_pi;
-    uint32            N_dummy;
-    uint32            N_reg_pdcch;
-    uint32            N_cce_pdcch;
-    uint16            rnti = 0;
-    bool              valid_reg;
 
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       pcfich     != NULL &&
-       phich      != NULL &&
-       pdcch      != NULL)
+    if(tbs   != NULL &&
+       N_prb != NULL &&
+       mcs   <= 28)
     {
-        // PCFICH
-        pcfich_channel_demap(phy_struct, subframe, N_id_cell, N_ant, pcfich, &N_bits);
-        if(LIBLTE_SUCCESS != cfi_channel_decode(phy_struct,
-                                                phy_struct->pdcch_descramb_bits,
-                                                N_bits,
-                                                &pcfich->cfi))
+        // Determine I_tbs
+        if(9 >= mcs)
         {
-            err = LIBLTE_ERROR_INVALID_CRC;
-            return(err);
+            I_tbs = mcs;
+        }else if(16 >= mcs){
+            I_tbs = mcs - 1;
+        }else{
+            I_tbs = mcs - 2;
         }
 
-        // PHICH
-        phich_channel_demap(phy_struct, pcfich, subframe, N_id_cell, N_ant, phich_res, phich_dur, phich);
-
-        // PDCCH
-        // Calculate number of symbols, 3GPP TS 36.211 v10.1.0 section 6.7
-        pdcch->N_symbs = pcfich->cfi;
-        if(phy_struct->N_rb_dl <= 10)
-        {
-            pdcch->N_symbs++;
-        }
-        // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.8.1
-        N_reg_rb    = 3;
-        N_reg_pdcch = pdcch->N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - pcfich->N_reg - phich->N_reg;
-        if(N_ant == 4)
+        // Determine N_prb
+        for(i=0; i<N_rb_dl; i++)
         {
-            // Remove CRS
-            N_reg_pdcch -= phy_struct->N_rb_dl;
+            if(N_bits <= TBS_71721[I_tbs][i])
+            {
+                *tbs   = TBS_71721[I_tbs][i];
+                *N_prb = i + 1;
+                break;
+            }
         }
-        N_cce_pdcch = N_reg_pdcch/9;
-        // Extract resource elements and channel estimate, 3GPP TS 36.211 v10.1.0 section 6.8.5
-        // Step 1 and 2
-        m_prime = 0;
-        k_prime = 0;
-        // Step 10
-        while(k_prime < (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl))
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_get_tbs_mcs_and_n_prb_for_ul
+
+    Description: Determines the transport block size, modulation and
+                 coding scheme, and the number of PRBs needed to send
+                 the specified number of UL bits
+
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 7.1.7
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_get_tbs_mcs_and_n_prb_for_ul(uint32  N_bits,
+                                                          uint32  N_rb_ul,
+                                                          uint32 *tbs,
+                                                          uint8  *mcs,
+                                                          uint32 *N_prb)
+{
+    LIBLTE_ERROR_ENUM err   = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            I_tbs = 1000;
+    uint32            i;
+    uint32            j;
+
+    if(tbs   != NULL &&
+       mcs   != NULL &&
+       N_prb != NULL)
+    {
+        // Determine I_tbs and N_prb
+        for(i=0; i<27; i++)
         {
-            // Step 3
-            l_prime = 0;
-            // Step 8
-            while(l_prime < pdcch->N_symbs)
+//            for(j=0; j<N_rb_ul; j++)
+            // FIXME: This keeps processing reasonable
+            for(j=0; j<11; j++)
             {
-                if(l_prime == 0)
+                if(N_bits <= TBS_71721[i][j])
                 {
-                    // Step 4
-                    // Avoid PCFICH and PHICH
-                    valid_reg = true;
-                    for(i=0; i<pcfich->N_reg; i++)
-                    {
-                        if(k_prime == pcfich->k[i])
-                        {
-                            valid_reg = false;
-                        }
-                    }
-                    for(i=0; i<phich->N_reg; i++)
-                    {
-                        if(k_prime == phich->k[i])
-                        {
-                            valid_reg = false;
-                        }
-                    }
-                    if((k_prime % 6) == 0 && valid_reg == true)
-                    {
-                        if(m_prime < N_reg_pdcch)
-                        {
-                            // Step 5
-                            idx = 0;
-                            for(i=0; i<6; i++)
-                            {
-                                // Avoid CRS
-                                if((N_id_cell % 3) != (i % 3))
-                                {
-                                    phy_struct->pdcch_reg_y_est_re[m_prime][idx] = subframe->rx_symb_re[l_prime][k_prime+i];
-                                    phy_struct->pdcch_reg_y_est_im[m_prime][idx] = subframe->rx_symb_im[l_prime][k_prime+i];
-                                    for(p=0; p<N_ant; p++)
-                                    {
-                                        phy_struct->pdcch_reg_c_est_re[p][m_prime][idx] = subframe->rx_ce_re[p][l_prime][k_prime+i];
-                                        phy_struct->pdcch_reg_c_est_im[p][m_prime][idx] = subframe->rx_ce_im[p][l_prime][k_prime+i];
-                                    }
-                                    idx++;
-                                }
-                            }
-                            // Step 6
-                            m_prime++;
-                        }
-                    }
-                }else if(l_prime == 1 && N_ant == 4){
-                    // Step 4
-                    if((k_prime % 6) == 0)
-                    {
-                        if(m_prime < N_reg_pdcch)
-                        {
-                            // Step 5
-                            idx = 0;
-                            for(i=0; i<6; i++)
-                            {
-                                // Avoid CRS
-                                if((N_id_cell % 3) != (i % 3))
-                                {
-                                    phy_struct->pdcch_reg_y_est_re[m_prime][idx] = subframe->rx_symb_re[l_prime][k_prime+i];
-                                    phy_struct->pdcch_reg_y_est_im[m_prime][idx] = subframe->rx_symb_im[l_prime][k_prime+i];
-                                    for(p=0; p<N_ant; p++)
-                                    {
-                                        phy_struct->pdcch_reg_c_est_re[p][m_prime][idx] = subframe->rx_ce_re[p][l_prime][k_prime+i];
-                                        phy_struct->pdcch_reg_c_est_im[p][m_prime][idx] = subframe->rx_ce_im[p][l_prime][k_prime+i];
-                                    }
-                                    idx++;
-                                }
-                            }
-                            // Step 6
-                            m_prime++;
-                        }
-                    }
-                }else{
-                    // Step 4
-                    if((k_prime % 4) == 0)
+                    if(((j + 1) % 2) == 0 ||
+                       ((j + 1) % 3) == 0 ||
+                       ((j + 1) % 5) == 0)
                     {
-                        if(m_prime < N_reg_pdcch)
-                        {
-                            // Step 5
-                            for(i=0; i<4; i++)
-                            {
-                                phy_struct->pdcch_reg_y_est_re[m_prime][i] = subframe->rx_symb_re[l_prime][k_prime+i];
-                                phy_struct->pdcch_reg_y_est_im[m_prime][i] = subframe->rx_symb_im[l_prime][k_prime+i];
-                                for(p=0; p<N_ant; p++)
-                                {
-                                    phy_struct->pdcch_reg_c_est_re[p][m_prime][i] = subframe->rx_ce_re[p][l_prime][k_prime+i];
-                                    phy_struct->pdcch_reg_c_est_im[p][m_prime][i] = subframe->rx_ce_im[p][l_prime][k_prime+i];
-                                }
-                            }
-                            // Step 6
-                            m_prime++;
-                        }
+                        I_tbs  = i;
+                        *tbs   = TBS_71721[i][j];
+                        *N_prb = j + 1;
+                        break;
                     }
                 }
-                // Step 7
-                l_prime++;
             }
-            // Step 9
-            k_prime++;
-        }
-        // Undo cyclic shift of the REGs
-        for(i=0; i<N_reg_pdcch; i++)
-        {
-            shift_idx = (i+N_id_cell) % N_reg_pdcch;
-            for(j=0; j<4; j++)
+            if(I_tbs != 1000)
             {
-                phy_struct->pdcch_shift_y_est_re[shift_idx][j] = phy_struct->pdcch_reg_y_est_re[i][j];
-                phy_struct->pdcch_shift_y_est_im[shift_idx][j] = phy_struct->pdcch_reg_y_est_im[i][j];
-                for(p=0; p<N_ant; p++)
-                {
-                    phy_struct->pdcch_shift_c_est_re[p][shift_idx][j] = phy_struct->pdcch_reg_c_est_re[p][i][j];
-                    phy_struct->pdcch_shift_c_est_im[p][shift_idx][j] = phy_struct->pdcch_reg_c_est_im[p][i][j];
-                }
+                break;
             }
         }
-        // Undo permutation of the REGs, 3GPP TS 36.212 v10.1.0 section 5.1.4.2.1
-        for(i=0; i<N_reg_pdcch; i++)
-        {
-            phy_struct->pdcch_reg_vec[i] = i;
-        }
-        // In order to recreate circular buffer, a dummy block must be
-        // sub block interleaved to determine where NULL bits are to be
-        // inserted
-        // Step 1
-        C_cc_sb = 32;
-        // Step 2
-        R_cc_sb = 0;
-        while(N_reg_pdcch > (C_cc_sb*R_cc_sb))
-        {
-            R_cc_sb++;
-        }
-        // Step 3
-        if(N_reg_pdcch < (C_cc_sb*R_cc_sb))
+
+        if(I_tbs != 1000)
         {
-            N_dummy = C_cc_sb*R_cc_sb - N_reg_pdcch;
-        }else{
-            N_dummy = 0;
+            // Determine mcs
+            if(10 >= I_tbs)
+            {
+                *mcs = I_tbs;
+            }else if(19 >= I_tbs){
+                *mcs = I_tbs + 1;
+            }else{
+                *mcs = I_tbs + 2;
+            }
+
+            err = LIBLTE_SUCCESS;
         }
-        for(i=0; i<N_dummy; i++)
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_get_n_cce
+
+    Description: Determines the number of control channel elements
+                 available in the specified subframe
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.8.1
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_get_n_cce(LIBLTE_PHY_STRUCT *phy_struct,
+                                       float              phich_res,
+                                       uint32             N_pdcch_symbs,
+                                       uint8              N_ant,
+                                       uint32            *N_cce)
+{
+    uint32 N_reg_phich;
+    uint32 N_reg_pcfich = 4;
+    uint32 N_reg_rb     = 3;
+    uint32 N_reg_pdcch;
+
+    N_reg_phich = phy_struct->N_group_phich*3;
+    N_reg_pdcch = N_pdcch_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - N_reg_pcfich - N_reg_phich;
+    if(N_ant == 4)
+    {
+        N_reg_pdcch -= phy_struct->N_rb_dl;
+    }
+
+    *N_cce = N_reg_pdcch/LIBLTE_PHY_PDCCH_N_REG_CCE;
+
+    return(LIBLTE_SUCCESS);
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: layer_mapper_ul
+
+    Description: Maps complex-valued modulation symbols onto one or
+                 several uplink layers
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.2A
+
+    Notes: Currently only supports single antenna
+*********************************************************************/
+void layer_mapper_ul(float  *d_re,
+                     float  *d_im,
+                     uint32  M_symb,
+                     uint8   N_ant,
+                     uint32  N_codewords,
+                     float  *x_re,
+                     float  *x_im,
+                     uint32 *M_layer_symb)
+{
+    uint32 i;
+
+    if(N_ant       == 1 &&
+       N_codewords == 1)
+    {
+        // 3GPP TS 36.211 v10.1.0 section 5.3.2A.1 and 5.3.2A.2
+        *M_layer_symb = M_symb;
+        for(i=0; i<M_symb; i++)
         {
-            phy_struct->ruc_tmp[i] = RX_NULL_BIT;
+            x_re[i] = d_re[i];
+            x_im[i] = d_im[i];
         }
-        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
+    }else{
+        // FIXME
+    }
+}
+
+/*********************************************************************
+    Name: layer_demapper_ul
+
+    Description: De-maps one or several uplink layers into complex-
+                 valued modulation symbols
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.2A
+
+    Notes: Currently only supports single antenna
+*********************************************************************/
+void layer_demapper_ul(float  *x_re,
+                       float  *x_im,
+                       uint32  M_layer_symb,
+                       uint8   N_ant,
+                       uint32  N_codewords,
+                       float  *d_re,
+                       float  *d_im,
+                       uint32 *M_symb)
+{
+    uint32 i;
+
+    if(N_ant       == 1 &&
+       N_codewords == 1)
+    {
+        // 3GPP TS 36.211 v10.1.0 section 5.3.2A.1 and 5.3.2A.2
+        *M_symb = M_layer_symb;
+        for(i=0; i<M_layer_symb; i++)
         {
-            phy_struct->ruc_tmp[i] = 0;
+            d_re[i] = x_re[i];
+            d_im[i] = x_im[i];
         }
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
+    }else{
+        // FIXME
+    }
+}
+
+/*********************************************************************
+    Name: transform_precoding
+
+    Description: DFT spreads the complex-valued symbols onto the
+                 entire uplink bandwidth
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.3
+*********************************************************************/
+void transform_precoding(LIBLTE_PHY_STRUCT *phy_struct,
+                         float             *x_re,
+                         float             *x_im,
+                         uint32             M_layer_symb,
+                         uint32             N_prb,
+                         uint8              N_ant,
+                         uint32             N_codewords,
+                         float             *y_re,
+                         float             *y_im)
+{
+    float  one_over_sqrt_M_pusch_sc;
+    uint32 M_pusch_sc;
+    uint32 i;
+    uint32 j;
+
+    // Calculate M_pusch_sc and 1/sqrt(M_pusch_sc)
+    M_pusch_sc               = N_prb * phy_struct->N_sc_rb_ul;
+    one_over_sqrt_M_pusch_sc = 1/sqrt(M_pusch_sc);
+
+    for(i=0; i<12; i++)
+    {
+        for(j=0; j<M_pusch_sc; j++)
         {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_mat[i][j] = phy_struct->ruc_tmp[idx++];
-            }
+            phy_struct->transform_precoding_in[j][0] = x_re[i*M_pusch_sc + j];
+            phy_struct->transform_precoding_in[j][1] = x_im[i*M_pusch_sc + j];
         }
-        // Step 4
-        for(i=0; i<R_cc_sb; i++)
+        fftwf_execute(phy_struct->transform_precoding_plan[N_prb]);
+        for(j=0; j<M_pusch_sc; j++)
         {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]];
-            }
+            y_re[i*M_pusch_sc + j] = one_over_sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][0];
+            y_im[i*M_pusch_sc + j] = one_over_sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][1];
         }
-        // Step 5
-        idx = 0;
-        for(j=0; j<C_cc_sb; j++)
+    }
+}
+
+/*********************************************************************
+    Name: transform_pre_decoding
+
+    Description: DFT despreads the entire uplink bandwidth into
+                 complex-valued modulation symbols
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.3
+*********************************************************************/
+void transform_pre_decoding(LIBLTE_PHY_STRUCT *phy_struct,
+                            float             *y_re,
+                            float             *y_im,
+                            uint32             M_layer_symb,
+                            uint32             N_prb,
+                            uint8              N_ant,
+                            uint32             N_codewords,
+                            float             *x_re,
+                            float             *x_im)
+{
+    float  one_over_sqrt_M_pusch_sc;
+    uint32 M_pusch_sc;
+    uint32 i;
+    uint32 j;
+
+    // Calculate M_pusch_sc and 1/sqrt(M_pusch_sc)
+    M_pusch_sc               = N_prb * phy_struct->N_sc_rb_ul;
+    one_over_sqrt_M_pusch_sc = 1/sqrt(M_pusch_sc);
+
+    for(i=0; i<12; i++)
+    {
+        for(j=0; j<M_pusch_sc; j++)
         {
-            for(i=0; i<R_cc_sb; i++)
-            {
-                phy_struct->ruc_v[0][idx++] = phy_struct->ruc_sb_perm_mat[i][j];
-            }
+            phy_struct->transform_precoding_in[j][0] = y_re[i*M_pusch_sc + j];
+            phy_struct->transform_precoding_in[j][1] = y_im[i*M_pusch_sc + j];
         }
-        // Recreate circular buffer
-        K_pi = R_cc_sb*C_cc_sb;
-        k    = 0;
-        j    = 0;
-        while(k < N_reg_pdcch)
+        fftwf_execute(phy_struct->transform_pre_decoding_plan[N_prb]);
+        for(j=0; j<M_pusch_sc; j++)
         {
-            if(phy_struct->ruc_v[0][j%K_pi] != RX_NULL_BIT)
-            {
-                phy_struct->ruc_v[0][j%K_pi] = phy_struct->pdcch_reg_vec[k++];
-            }
-            j++;
+            x_re[i*M_pusch_sc + j] = one_over_sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][0];
+            x_im[i*M_pusch_sc + j] = one_over_sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][1];
         }
-        // Sub block deinterleaving
-        // Step 5
-        idx = 0;
-        for(j=0; j<C_cc_sb; j++)
+    }
+}
+
+/*********************************************************************
+    Name: pre_coder_ul
+
+    Description: Generates a block of vectors to be mapped onto
+                 resources on each uplink antenna port
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.3A
+
+    Notes: Currently only supports single antenna
+*********************************************************************/
+void pre_coder_ul(float  *y_re,
+                  float  *y_im,
+                  uint32  M_layer_symb,
+                  uint8   N_ant,
+                  uint8   N_layers,
+                  float  *z_re,
+                  float  *z_im,
+                  uint32 *M_ap_symb)
+{
+    uint32 i;
+
+    if(N_ant    == 1 &&
+       N_layers == 1)
+    {
+        // 3GPP TS 36.211 v10.1.0 section 5.3.3A.1
+        *M_ap_symb = M_layer_symb;
+        for(i=0; i<M_layer_symb; i++)
         {
-            for(i=0; i<R_cc_sb; i++)
-            {
-                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_v[0][idx++];
-            }
+            z_re[i] = y_re[i];
+            z_im[i] = y_im[i];
         }
-        // Step 4
-        for(i=0; i<R_cc_sb; i++)
+    }else{
+        // FIXME
+    }
+}
+
+/*********************************************************************
+    Name: pre_decoder_and_matched_filter_ul
+
+    Description: Matched filters and unmaps a block of vectors from
+                 resources on each uplink antenna port
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.3A
+
+    Notes: Currently only supports single antenna
+*********************************************************************/
+void pre_decoder_and_matched_filter_ul(float  *z_re,
+                                       float  *z_im,
+                                       float  *h_re,
+                                       float  *h_im,
+                                       uint32  M_ap_symb,
+                                       uint8   N_ant,
+                                       uint8   N_layers,
+                                       float  *y_re,
+                                       float  *y_im,
+                                       uint32 *M_layer_symb)
+{
+    float  h_norm;
+    uint32 i;
+
+    if(N_ant    == 1 &&
+       N_layers == 1)
+    {
+        // 3GPP TS 36.211 v10.1.0 section 5.3.3A.1
+        *M_layer_symb = M_ap_symb;
+        for(i=0; i<M_ap_symb; i++)
         {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]] = phy_struct->ruc_sb_perm_mat[i][j];
-            }
+            h_norm  = h_re[i] * h_re[i] + h_im[i] * h_im[i];
+            y_re[i] = (z_re[i]*h_re[i] + z_im[i]*h_im[i]) / h_norm;
+            y_im[i] = (z_im[i]*h_re[i] - z_re[i]*h_im[i]) / h_norm;
         }
-        // Step 3
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
+    }else{
+        // FIXME
+    }
+}
+
+/*********************************************************************
+    Name: generate_ul_rs
+
+    Description: Generates uplink reference signals
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.5.1
+*********************************************************************/
+void generate_ul_rs(LIBLTE_PHY_STRUCT         *phy_struct,
+                    uint32                     N_slot,
+                    uint32                     N_id_cell,
+                    LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                    uint32                     delta_ss,
+                    uint32                     N_prb,
+                    float                      alpha,
+                    bool                       group_hopping_enabled,
+                    bool                       sequence_hopping_enabled,
+                    float                     *ul_rs_re,
+                    float                     *ul_rs_im)
+{
+    float  q_bar;
+    uint32 M_sc_rs;
+    uint32 N_zc_rs;
+    uint32 i;
+    uint32 j;
+    uint32 f_ss;
+    uint32 f_gh;
+    uint32 v;
+    uint32 u;
+    int32  q;
+
+    // Calculate M_sc_rs
+    M_sc_rs = N_prb * LIBLTE_PHY_N_SC_RB_UL;
+
+    // Determine N_zc_rs
+    for(i=UL_RS_PRIMES_LESS_THAN_2048_LEN-1; i>0; i--)
+    {
+        if(UL_RS_PRIMES_LESS_THAN_2048[i] < M_sc_rs)
         {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_tmp[idx++] = phy_struct->ruc_sb_mat[i][j];
-            }
+            N_zc_rs = UL_RS_PRIMES_LESS_THAN_2048[i];
+            break;
         }
-        for(i=0; i<N_reg_pdcch; i++)
+    }
+
+    // Determine f_ss
+    if(LIBLTE_PHY_CHAN_TYPE_ULSCH == chan_type)
+    {
+        f_ss = ((N_id_cell % 30) + delta_ss) % 30;
+    }else{
+        f_ss = N_id_cell % 30;
+    }
+
+    // Determine u
+    if(group_hopping_enabled)
+    {
+        generate_prs_c(N_id_cell/30, 160, phy_struct->ulrs_c);
+        f_gh = 0;
+        for(i=0; i<8; i++)
         {
-            for(j=0; j<4; j++)
-            {
-                phy_struct->pdcch_perm_y_est_re[i][j] = phy_struct->pdcch_shift_y_est_re[(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
-                phy_struct->pdcch_perm_y_est_im[i][j] = phy_struct->pdcch_shift_y_est_im[(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
-                for(p=0; p<N_ant; p++)
-                {
-                    phy_struct->pdcch_perm_c_est_re[p][i][j] = phy_struct->pdcch_shift_c_est_re[p][(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
-                    phy_struct->pdcch_perm_c_est_im[p][i][j] = phy_struct->pdcch_shift_c_est_im[p][(uint32)phy_struct->ruc_tmp[N_dummy+i]][j];
-                }
-            }
+            f_gh += phy_struct->ulrs_c[8*N_slot + i] << i;
         }
-        // Construct CCEs
-        for(i=0; i<N_cce_pdcch; i++)
+        f_gh %= 30;
+        u     = (f_gh + f_ss) % 30;
+    }else{
+        u = f_ss % 30;
+    }
+
+    // Determine v
+    if(M_sc_rs < 6*LIBLTE_PHY_N_SC_RB_UL)
+    {
+        v = 0;
+    }else{
+        if(!group_hopping_enabled && sequence_hopping_enabled)
         {
-            for(j=0; j<LIBLTE_PHY_PDCCH_N_REG_CCE; j++)
-            {
-                for(k=0; k<4; k++)
-                {
-                    phy_struct->pdcch_cce_y_est_re[i][j*4+k] = phy_struct->pdcch_perm_y_est_re[i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k];
-                    phy_struct->pdcch_cce_y_est_im[i][j*4+k] = phy_struct->pdcch_perm_y_est_im[i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k];
-                    for(p=0; p<N_ant; p++)
-                    {
-                        phy_struct->pdcch_cce_c_est_re[p][i][j*4+k] = phy_struct->pdcch_perm_c_est_re[p][i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k];
-                        phy_struct->pdcch_cce_c_est_im[p][i][j*4+k] = phy_struct->pdcch_perm_c_est_im[p][i*LIBLTE_PHY_PDCCH_N_REG_CCE+j][k];
-                    }
-                }
-            }
+            generate_prs_c(((N_id_cell/30) << 5) + f_ss, 20, phy_struct->ulrs_c);
+            v = phy_struct->ulrs_c[N_slot];
+        }else{
+            v = 0;
         }
+    }
 
-        // Generate the scrambling sequence
-        c_init = (subframe->num << 9) + N_id_cell;
-        generate_prs_c(c_init, LIBLTE_PHY_PDCCH_N_BITS_MAX * 2, phy_struct->pdcch_c);
-
-        // Determine the size of DCI 1A and 1C FIXME: Clean this up
-        if(phy_struct->N_rb_dl == 6)
+    // Determine r_bar_u_v
+    if(M_sc_rs >= 3*LIBLTE_PHY_N_SC_RB_UL)
+    {
+        q_bar = (float)N_zc_rs*(float)(u+1)/(float)31;
+        if((((uint32)(2*q_bar)) % 2) == 0)
         {
-            dci_1a_size = 21;
-            dci_1c_size = 9;
-        }else if(phy_struct->N_rb_dl == 15){
-            dci_1a_size = 22;
-            dci_1c_size = 11;
-        }else if(phy_struct->N_rb_dl == 25){
-            dci_1a_size = 25;
-            dci_1c_size = 13;
-        }else if(phy_struct->N_rb_dl == 50){
-            dci_1a_size = 27;
-            dci_1c_size = 13;
-        }else if(phy_struct->N_rb_dl == 75){
-            dci_1a_size = 27;
-            dci_1c_size = 14;
-        }else{ // phy_struct->N_rb_dl == 100
-            dci_1a_size = 28;
-            dci_1c_size = 15;
+            q = (uint32)(q_bar + 0.5) + v;
+        }else{
+            q = (uint32)(q_bar + 0.5) - v;
+        }
+        for(i=0; i<N_zc_rs; i++)
+        {
+            phy_struct->ulrs_x_q_re[i] = cos(-M_PI*q*i*(i+1)/N_zc_rs);
+            phy_struct->ulrs_x_q_im[i] = sin(-M_PI*q*i*(i+1)/N_zc_rs);
         }
-
-        // Try decoding DCI 1A and 1C for SI in the common search space
-        pdcch->N_alloc = 0;
-        for(i=0; i<4; i++)
+        for(i=0; i<M_sc_rs; i++)
         {
-            idx = 0;
-            for(j=0; j<4; j++)
-            {
-                for(k=0; k<36; k++)
-                {
-                    phy_struct->pdcch_y_est_re[idx] = phy_struct->pdcch_cce_y_est_re[i*4+j][k];
-                    phy_struct->pdcch_y_est_im[idx] = phy_struct->pdcch_cce_y_est_im[i*4+j][k];
-                    for(p=0; p<N_ant; p++)
-                    {
-                        phy_struct->pdcch_c_est_re[p][idx] = phy_struct->pdcch_cce_c_est_re[p][i*4+j][k];
-                        phy_struct->pdcch_c_est_im[p][idx] = phy_struct->pdcch_cce_c_est_im[p][i*4+j][k];
-                    }
-                    idx++;
-                }
-            }
-
-            pre_decoder_and_matched_filter_dl(phy_struct->pdcch_y_est_re,
-                                              phy_struct->pdcch_y_est_im,
-                                              phy_struct->pdcch_c_est_re[0],
-                                              phy_struct->pdcch_c_est_im[0],
-                                              576,
-                                              idx,
-                                              N_ant,
-                                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                              phy_struct->pdcch_x_re,
-                                              phy_struct->pdcch_x_im,
-                                              &M_layer_symb);
-            layer_demapper_dl(phy_struct->pdcch_x_re,
-                              phy_struct->pdcch_x_im,
-                              M_layer_symb,
-                              N_ant,
-                              1,
-                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                              phy_struct->pdcch_d_re,
-                              phy_struct->pdcch_d_im,
-                              &M_symb);
-            modulation_demapper(phy_struct->pdcch_d_re,
-                                phy_struct->pdcch_d_im,
-                                M_symb,
-                                LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                                phy_struct->pdcch_soft_bits,
-                                &N_bits);
-            for(j=0; j<N_bits; j++)
-            {
-                phy_struct->pdcch_descramb_bits[j] = (float)phy_struct->pdcch_soft_bits[j]*(1-2*(float)phy_struct->pdcch_c[i*288+j]);
-            }
-            if(pdcch->N_alloc  <  LIBLTE_PHY_PDCCH_MAX_ALLOC &&
-               (LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_SI_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_P_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_RA_RNTI_START,
-                                                     LIBLTE_MAC_RA_RNTI_END - LIBLTE_MAC_RA_RNTI_START + 1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti)))
-            {
-                err = dci_1a_unpack(phy_struct->pdcch_dci,
-                                    dci_1a_size,
-                                    LIBLTE_PHY_DCI_CA_NOT_PRESENT,
-                                    rnti,
-                                    phy_struct->N_rb_dl,
-                                    N_ant,
-                                    &pdcch->alloc[pdcch->N_alloc]);
-                if(LIBLTE_SUCCESS == err)
-                {
-                    pdcch->N_alloc++;
-                }
-            }
-            if(pdcch->N_alloc  <  LIBLTE_PHY_PDCCH_MAX_ALLOC &&
-               (LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_SI_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_P_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_RA_RNTI_START,
-                                                     LIBLTE_MAC_RA_RNTI_END - LIBLTE_MAC_RA_RNTI_START + 1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti)))
-            {
-                err = dci_1c_unpack(phy_struct->pdcch_dci,
-                                    dci_1c_size,
-                                    rnti,
-                                    phy_struct->N_rb_dl,
-                                    N_ant,
-                                    &pdcch->alloc[pdcch->N_alloc]);
-                if(LIBLTE_SUCCESS == err)
-                {
-                    pdcch->N_alloc++;
-                }
-            }
+            phy_struct->ulrs_r_bar_u_v_re[i] = phy_struct->ulrs_x_q_re[i % N_zc_rs];
+            phy_struct->ulrs_r_bar_u_v_im[i] = phy_struct->ulrs_x_q_im[i % N_zc_rs];
         }
-        for(i=0; i<2; i++)
+    }else if(M_sc_rs == LIBLTE_PHY_N_SC_RB_UL){
+        for(i=0; i<M_sc_rs; i++)
         {
-            idx = 0;
-            for(j=0; j<8; j++)
-            {
-                for(k=0; k<36; k++)
-                {
-                    phy_struct->pdcch_y_est_re[idx] = phy_struct->pdcch_cce_y_est_re[i*8+j][k];
-                    phy_struct->pdcch_y_est_im[idx] = phy_struct->pdcch_cce_y_est_im[i*8+j][k];
-                    for(p=0; p<N_ant; p++)
-                    {
-                        phy_struct->pdcch_c_est_re[p][idx] = phy_struct->pdcch_cce_c_est_re[p][i*8+j][k];
-                        phy_struct->pdcch_c_est_im[p][idx] = phy_struct->pdcch_cce_c_est_im[p][i*8+j][k];
-                    }
-                    idx++;
-                }
-            }
-
-            pre_decoder_and_matched_filter_dl(phy_struct->pdcch_y_est_re,
-                                              phy_struct->pdcch_y_est_im,
-                                              phy_struct->pdcch_c_est_re[0],
-                                              phy_struct->pdcch_c_est_im[0],
-                                              576,
-                                              idx,
-                                              N_ant,
-                                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                              phy_struct->pdcch_x_re,
-                                              phy_struct->pdcch_x_im,
-                                              &M_layer_symb);
-            layer_demapper_dl(phy_struct->pdcch_x_re,
-                              phy_struct->pdcch_x_im,
-                              M_layer_symb,
-                              N_ant,
-                              1,
-                              LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                              phy_struct->pdcch_d_re,
-                              phy_struct->pdcch_d_im,
-                              &M_symb);
-            modulation_demapper(phy_struct->pdcch_d_re,
-                                phy_struct->pdcch_d_im,
-                                M_symb,
-                                LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                                phy_struct->pdcch_soft_bits,
-                                &N_bits);
-            for(j=0; j<N_bits; j++)
-            {
-                phy_struct->pdcch_descramb_bits[j] = (float)phy_struct->pdcch_soft_bits[j]*(1-2*(float)phy_struct->pdcch_c[i*576+j]);
-            }
-            if(pdcch->N_alloc  <  LIBLTE_PHY_PDCCH_MAX_ALLOC &&
-               (LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_SI_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_P_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_RA_RNTI_START,
-                                                     LIBLTE_MAC_RA_RNTI_END - LIBLTE_MAC_RA_RNTI_START + 1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1a_size,
-                                                     &rnti)))
-            {
-                err = dci_1a_unpack(phy_struct->pdcch_dci,
-                                    dci_1a_size,
-                                    LIBLTE_PHY_DCI_CA_NOT_PRESENT,
-                                    rnti,
-                                    phy_struct->N_rb_dl,
-                                    N_ant,
-                                    &pdcch->alloc[pdcch->N_alloc]);
-                if(LIBLTE_SUCCESS == err)
-                {
-                    pdcch->N_alloc++;
-                }
-            }
-            if(pdcch->N_alloc  <  LIBLTE_PHY_PDCCH_MAX_ALLOC &&
-               (LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_SI_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_P_RNTI,
-                                                     1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti) ||
-                LIBLTE_SUCCESS == dci_channel_decode(phy_struct,
-                                                     phy_struct->pdcch_descramb_bits,
-                                                     N_bits,
-                                                     LIBLTE_MAC_RA_RNTI_START,
-                                                     LIBLTE_MAC_RA_RNTI_END - LIBLTE_MAC_RA_RNTI_START + 1,
-                                                     0,
-                                                     phy_struct->pdcch_dci,
-                                                     dci_1c_size,
-                                                     &rnti)))
-            {
-                err = dci_1c_unpack(phy_struct->pdcch_dci,
-                                    dci_1c_size,
-                                    rnti,
-                                    phy_struct->N_rb_dl,
-                                    N_ant,
-                                    &pdcch->alloc[pdcch->N_alloc]);
-                if(LIBLTE_SUCCESS == err)
-                {
-                    pdcch->N_alloc++;
-                }
-            }
+            phy_struct->ulrs_r_bar_u_v_re[i] = cos(UL_RS_5_5_1_2_1[u][i]*M_PI/4);
+            phy_struct->ulrs_r_bar_u_v_im[i] = sin(UL_RS_5_5_1_2_1[u][i]*M_PI/4);
+        }
+    }else{ // M_sc_rs == 2*LIBLTE_PHY_N_SC_RB_UL
+        for(i=0; i<M_sc_rs; i++)
+        {
+            phy_struct->ulrs_r_bar_u_v_re[i] = cos(UL_RS_5_5_1_2_2[u][i]*M_PI/4);
+            phy_struct->ulrs_r_bar_u_v_im[i] = sin(UL_RS_5_5_1_2_2[u][i]*M_PI/4);
         }
     }
 
-    return(err);
+    // Calculate r_u_v (ul_rs_re and ul_rs_im)
+    for(i=0; i<M_sc_rs; i++)
+    {
+        ul_rs_re[i] = cos(alpha*i)*phy_struct->ulrs_r_bar_u_v_re[i] - sin(alpha*i)*phy_struct->ulrs_r_bar_u_v_im[i];
+        ul_rs_im[i] = sin(alpha*i)*phy_struct->ulrs_r_bar_u_v_re[i] + cos(alpha*i)*phy_struct->ulrs_r_bar_u_v_im[i];
+    }
+}
+
+/*********************************************************************
+    Name: generate_dmrs_pusch
+
+    Description: Generates demodulation reference signals for the
+                 uplink shared channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.5.2
+*********************************************************************/
+void generate_dmrs_pusch(LIBLTE_PHY_STRUCT *phy_struct,
+                         uint32             N_subfr,
+                         uint32             N_id_cell,
+                         uint32             delta_ss,
+                         uint32             cyclic_shift,
+                         uint32             cyclic_shift_dci,
+                         uint32             N_prb,
+                         uint32             layer,
+                         bool               group_hopping_enabled,
+                         bool               sequence_hopping_enabled,
+                         float             *dmrs_0_re,
+                         float             *dmrs_0_im,
+                         float             *dmrs_1_re,
+                         float             *dmrs_1_im)
+{
+    uint32 N_slot;
+    uint32 lambda;
+    uint32 f_ss_pusch;
+    uint32 n_pn_ns_1;
+    uint32 n_pn_ns_2;
+    uint32 n_1_dmrs;
+    uint32 n_2_dmrs_lambda;
+    uint32 n_cs_lambda_1;
+    uint32 n_cs_lambda_2;
+    uint32 M_sc_rb   = N_prb * LIBLTE_PHY_N_SC_RB_UL;
+    uint32 N_ul_symb = 7; // FIXME: Only handling normal CP
+    uint32 i;
+    uint32 j;
+    float  alpha_lambda_1;
+    float  alpha_lambda_2;
+    float  r_u_v_alpha_lambda_re[2][M_sc_rb];
+    float  r_u_v_alpha_lambda_im[2][M_sc_rb];
+    int32  w_vector[2];
+
+    // Calculate N_slot
+    N_slot = N_subfr*2;
+
+    // Set lambda
+    lambda = layer;
+
+    // Calculate f_ss_pusch
+    f_ss_pusch = ((N_id_cell % 30) + delta_ss) % 30;
+
+    // Generate c
+    generate_prs_c(((N_id_cell/30) << 5) + f_ss_pusch, 8*N_ul_symb*20, phy_struct->pusch_dmrs_c);
+
+    // Calculate n_pn_ns
+    n_pn_ns_1 = 0;
+    n_pn_ns_2 = 0;
+    for(i=0; i<8; i++)
+    {
+        n_pn_ns_1 += phy_struct->pusch_dmrs_c[8*N_ul_symb*N_slot + i] << i;
+        n_pn_ns_2 += phy_struct->pusch_dmrs_c[8*N_ul_symb*(N_slot+1) + i] << i;
+    }
+
+    // Determine n_1_dmrs
+    n_1_dmrs = N_1_DMRS_5_5_2_1_1_2[cyclic_shift];
+
+    // Determine n_2_dmrs_lambda
+    n_2_dmrs_lambda = N_2_DMRS_LAMBDA_5_5_2_1_1_1[cyclic_shift_dci][lambda];
+
+    // Calculate n_cs_lambda
+    n_cs_lambda_1 = (n_1_dmrs + n_2_dmrs_lambda + n_pn_ns_1) % 12;
+    n_cs_lambda_2 = (n_1_dmrs + n_2_dmrs_lambda + n_pn_ns_2) % 12;
+
+    // Calculate alpha_lambda
+    alpha_lambda_1 = 2*M_PI*n_cs_lambda_1/12;
+    alpha_lambda_2 = 2*M_PI*n_cs_lambda_2/12;
+
+    // Generate the base reference signal
+    generate_ul_rs(phy_struct,
+                   N_slot,
+                   N_id_cell,
+                   LIBLTE_PHY_CHAN_TYPE_ULSCH,
+                   delta_ss,
+                   N_prb,
+                   alpha_lambda_1,
+                   group_hopping_enabled,
+                   sequence_hopping_enabled,
+                   r_u_v_alpha_lambda_re[0],
+                   r_u_v_alpha_lambda_im[0]);
+    generate_ul_rs(phy_struct,
+                   N_slot+1,
+                   N_id_cell,
+                   LIBLTE_PHY_CHAN_TYPE_ULSCH,
+                   delta_ss,
+                   N_prb,
+                   alpha_lambda_2,
+                   group_hopping_enabled,
+                   sequence_hopping_enabled,
+                   r_u_v_alpha_lambda_re[1],
+                   r_u_v_alpha_lambda_im[1]);
+
+    // Determine w vector
+    // FIXME: Handle fixed values
+    w_vector[0] = 1;
+    w_vector[1] = W_1_5_5_2_1_1_1[cyclic_shift_dci][lambda];
+
+    // Generate the PUSCH demodulation reference signal sequence
+    for(i=0; i<M_sc_rb; i++)
+    {
+        dmrs_0_re[i] = w_vector[0]*r_u_v_alpha_lambda_re[0][i];
+        dmrs_0_im[i] = w_vector[0]*r_u_v_alpha_lambda_im[0][i];
+        dmrs_1_re[i] = w_vector[1]*r_u_v_alpha_lambda_re[1][i];
+        dmrs_1_im[i] = w_vector[1]*r_u_v_alpha_lambda_im[1][i];
+    }
+
+    // FIXME: Add precoding to arrive at r_tilda
 }
 
-/*********************************************************************
-    Name: liblte_phy_map_crs
+/*********************************************************************
+    Name: generate_dmrs_pucch
+
+    Description: Generates demodulation reference signals for the
+                 uplink control channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.5.2
+*********************************************************************/
+void generate_dmrs_pucch(LIBLTE_PHY_STRUCT *phy_struct,
+                         uint32             N_subfr,
+                         uint32             N_id_cell,
+                         uint32             delta_ss,
+                         bool               group_hopping_enabled,
+                         bool               sequence_hopping_enabled,
+                         uint8              N_cs_1,
+                         uint8              N_1_p_pucch,
+                         uint8              delta_pucch_shift,
+                         uint8              N_ant,
+                         float             *dmrs_0_re,
+                         float             *dmrs_0_im,
+                         float             *dmrs_1_re,
+                         float             *dmrs_1_im)
+{
+    uint32  N_slot;
+    uint32  i;
+    uint32  j;
+    uint32  k;
+    uint32  idx;
+    uint32  N_prime;
+    uint32  h_p;
+    uint32  N_ul_symb = 7; // FIXME: Only handling normal CP
+    uint32  n_cs_cell[2][N_ul_symb];
+    uint32  n_cs_p[2][N_ul_symb];
+    float   alpha_p[2][N_ul_symb];
+    float   w_re;
+    float   w_im;
+    float   alpha_re;
+    float   alpha_im;
+    float  *dmrs_re;
+    float  *dmrs_im;
+
+    // Calculate N_slot
+    N_slot = N_subfr*2;
 
-    Description: Maps the Cell Specific Reference Signals to the
-                 subframe
+    // Calculate N_prime
+    if(N_1_p_pucch < (3*N_cs_1/delta_pucch_shift))
+    {
+        N_prime = N_cs_1;
+    }else{
+        N_prime = LIBLTE_PHY_N_SC_RB_UL;
+    }
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.10.1
-*********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_map_crs(LIBLTE_PHY_STRUCT          *phy_struct,
-                                     LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
-                                     uint32                      N_id_cell,
-                                     uint8                       N_ant)
-{
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
-    float             *crs_re[14];
-    float             *crs_im[14];
-    uint32             p;
-    uint32             i;
-    uint32             j;
-    uint32             k;
-    uint32             m_prime;
-    uint32             v_shift = N_id_cell % 6;
-    uint32             v[4];
-    uint32             sym[4];
-    uint32             N_sym;
+    // Calculate n_prime_p
+    // FIXME: Only supporting normal cyclic prefix
+    if(N_1_p_pucch < (3*N_cs_1/delta_pucch_shift))
+    {
+        phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][0] = N_1_p_pucch;
+        h_p                                                  = (phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][0] + 2) % (3*N_prime/delta_pucch_shift);
+        phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][1] = (h_p/3) + (h_p%3)*N_prime/delta_pucch_shift;
+    }else{
+        phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][0] = (N_1_p_pucch - 3*N_cs_1/delta_pucch_shift) % (3*LIBLTE_PHY_N_SC_RB_UL/delta_pucch_shift);
+        phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][1] = ((3*(phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][0]+1)) % ((3*LIBLTE_PHY_N_SC_RB_UL/delta_pucch_shift)+1)) - 1;
+    }
 
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       N_id_cell  >= 0    &&
-       N_id_cell  <= 503)
+    // Calculate N_oc_p
+    for(i=0; i<2; i++)
     {
-        // Generate cell specific reference signals
-        if(phy_struct->N_id_cell_crs == N_id_cell)
-        {
-            crs_re[0]  = &phy_struct->crs_re_storage[subframe->num*2  ][0][0];
-            crs_im[0]  = &phy_struct->crs_im_storage[subframe->num*2  ][0][0];
-            crs_re[1]  = &phy_struct->crs_re_storage[subframe->num*2  ][1][0];
-            crs_im[1]  = &phy_struct->crs_im_storage[subframe->num*2  ][1][0];
-            crs_re[4]  = &phy_struct->crs_re_storage[subframe->num*2  ][2][0];
-            crs_im[4]  = &phy_struct->crs_im_storage[subframe->num*2  ][2][0];
-            crs_re[7]  = &phy_struct->crs_re_storage[subframe->num*2+1][0][0];
-            crs_im[7]  = &phy_struct->crs_im_storage[subframe->num*2+1][0][0];
-            crs_re[8]  = &phy_struct->crs_re_storage[subframe->num*2+1][1][0];
-            crs_im[8]  = &phy_struct->crs_im_storage[subframe->num*2+1][1][0];
-            crs_re[11] = &phy_struct->crs_re_storage[subframe->num*2+1][2][0];
-            crs_im[11] = &phy_struct->crs_im_storage[subframe->num*2+1][2][0];
-        }else{
-            generate_crs(subframe->num*2,   0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[0],  phy_struct->crs_im[0]);
-            generate_crs(subframe->num*2,   1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[1],  phy_struct->crs_im[1]);
-            generate_crs(subframe->num*2,   4, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[4],  phy_struct->crs_im[4]);
-            generate_crs(subframe->num*2+1, 0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[7],  phy_struct->crs_im[7]);
-            generate_crs(subframe->num*2+1, 1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[8],  phy_struct->crs_im[8]);
-            generate_crs(subframe->num*2+1, 4, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re[11], phy_struct->crs_im[11]);
-            crs_re[0]  = &phy_struct->crs_re[0 ][0];
-            crs_im[0]  = &phy_struct->crs_im[0 ][0];
-            crs_re[1]  = &phy_struct->crs_re[1 ][0];
-            crs_im[1]  = &phy_struct->crs_im[1 ][0];
-            crs_re[4]  = &phy_struct->crs_re[4 ][0];
-            crs_im[4]  = &phy_struct->crs_im[4 ][0];
-            crs_re[7]  = &phy_struct->crs_re[7 ][0];
-            crs_im[7]  = &phy_struct->crs_im[7 ][0];
-            crs_re[8]  = &phy_struct->crs_re[8 ][0];
-            crs_im[8]  = &phy_struct->crs_im[8 ][0];
-            crs_re[11] = &phy_struct->crs_re[11][0];
-            crs_im[11] = &phy_struct->crs_im[11][0];
-        }
+        phy_struct->pucch_n_oc_p[N_subfr][N_1_p_pucch][i] = phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][i]*delta_pucch_shift/N_prime;
+    }
 
-        for(p=0; p<N_ant; p++)
+    // Generate c
+    generate_prs_c(N_id_cell, 8*N_ul_symb*20, phy_struct->pucch_dmrs_c);
+
+    // Calculate N_cs_cell
+    for(i=0; i<2; i++)
+    {
+        for(j=0; j<N_ul_symb; j++)
         {
-            if(p == 0)
-            {
-                v[0]   = 0;
-                v[1]   = 3;
-                v[2]   = 0;
-                v[3]   = 3;
-                sym[0] = 0;
-                sym[1] = 4;
-                sym[2] = 7;
-                sym[3] = 11;
-                N_sym  = 4;
-            }else if(p == 1){
-                v[0]   = 3;
-                v[1]   = 0;
-                v[2]   = 3;
-                v[3]   = 0;
-                sym[0] = 0;
-                sym[1] = 4;
-                sym[2] = 7;
-                sym[3] = 11;
-                N_sym  = 4;
-            }else if(p == 2){
-                v[0]   = 0;
-                v[1]   = 3;
-                sym[0] = 1;
-                sym[1] = 8;
-                N_sym  = 2;
-            }else{ // p == 3
-                v[0]   = 3;
-                v[1]   = 6;
-                sym[0] = 1;
-                sym[1] = 8;
-                N_sym  = 2;
-            }
-            for(i=0; i<N_sym; i++)
+            n_cs_cell[i][j] = 0;
+            for(idx=0; idx<8; idx++)
             {
-                for(j=0; j<2*phy_struct->N_rb_dl; j++)
-                {
-                    k                                  = 6*j + (v[i] + v_shift)%6;
-                    m_prime                            = j + LIBLTE_PHY_N_RB_DL_MAX - phy_struct->N_rb_dl;
-                    subframe->tx_symb_re[p][sym[i]][k] = crs_re[sym[i]][m_prime];
-                    subframe->tx_symb_im[p][sym[i]][k] = crs_im[sym[i]][m_prime];
-                }
+                n_cs_cell[i][j] += phy_struct->pucch_dmrs_c[8*N_ul_symb*(N_slot+i) + 8*j + idx] << idx;
             }
         }
-
-        err = LIBLTE_SUCCESS;
     }
 
-    return(err);
-}
-
-/*********************************************************************
-    Name: liblte_phy_map_pss
-
-    Description: Maps the Primary Synchronization Signal to the
-                 subframe.
+    // Calculate N_cs_p
+    // FIXME: Only supporting normal cyclic prefix
+    for(i=0; i<2; i++)
+    {
+        for(j=0; j<N_ul_symb; j++)
+        {
+            n_cs_p[i][j] = (n_cs_cell[i][j] + ((phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][i]*delta_pucch_shift + (phy_struct->pucch_n_oc_p[N_subfr][N_1_p_pucch][i] % delta_pucch_shift)) % N_prime)) % LIBLTE_PHY_N_SC_RB_UL;
+        }
+    }
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1
-*********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_map_pss(LIBLTE_PHY_STRUCT          *phy_struct,
-                                     LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
-                                     uint32                      N_id_2,
-                                     uint8                       N_ant)
-{
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    float             pss_re[63];
-    float             pss_im[63];
-    uint32            p;
-    uint32            i;
-    uint32            k;
+    // Calculate alpha_p
+    for(i=0; i<2; i++)
+    {
+        for(j=0; j<N_ul_symb; j++)
+        {
+            alpha_p[i][j] = 2*M_PI*n_cs_p[i][j]/LIBLTE_PHY_N_SC_RB_UL;
+        }
+    }
 
-    if(phy_struct != NULL &&
-       subframe   != NULL)
+    // Generate the base reference signal
+    for(i=0; i<2; i++)
     {
-        generate_pss(N_id_2, pss_re, pss_im);
+        for(j=0; j<N_ul_symb; j++)
+        {
+            generate_ul_rs(phy_struct,
+                           N_slot + i,
+                           N_id_cell,
+                           LIBLTE_PHY_CHAN_TYPE_ULCCH,
+                           delta_ss,
+                           1,
+                           alpha_p[i][j],
+                           group_hopping_enabled,
+                           sequence_hopping_enabled,
+                           phy_struct->pucch_r_u_v_alpha_p_re[N_subfr][N_1_p_pucch][i][j],
+                           phy_struct->pucch_r_u_v_alpha_p_im[N_subfr][N_1_p_pucch][i][j]);
+        }
+    }
 
-        for(p=0; p<N_ant; p++)
+    // Generate the PUCCH demodulation reference signal sequence
+    for(i=0; i<2; i++)
+    {
+        if(0 == i)
         {
-            for(i=0; i<62; i++)
+            dmrs_re = dmrs_0_re;
+            dmrs_im = dmrs_0_im;
+        }else{
+            dmrs_re = dmrs_1_re;
+            dmrs_im = dmrs_1_im;
+        }
+        for(j=0; j<LIBLTE_PHY_M_PUCCH_RS; j++)
+        {
+            w_re = cos(W_5_5_2_2_1_2_phase[phy_struct->pucch_n_oc_p[N_subfr][N_1_p_pucch][i]][j]);
+            w_im = sin(W_5_5_2_2_1_2_phase[phy_struct->pucch_n_oc_p[N_subfr][N_1_p_pucch][i]][j]);
+            for(k=0; k<LIBLTE_PHY_N_SC_RB_UL; k++)
             {
-                k                             = i - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
-                subframe->tx_symb_re[p][6][k] = pss_re[i];
-                subframe->tx_symb_im[p][6][k] = pss_im[i];
+                alpha_re = phy_struct->pucch_r_u_v_alpha_p_re[N_subfr][N_1_p_pucch][i][j+2][k];
+                alpha_im = phy_struct->pucch_r_u_v_alpha_p_im[N_subfr][N_1_p_pucch][i][j+2][k];
+                // z(m) = 1
+                dmrs_re[j*LIBLTE_PHY_N_SC_RB_UL + k] = (1/sqrt(N_ant))*(w_re*alpha_re - w_im*alpha_im);
+                dmrs_im[j*LIBLTE_PHY_N_SC_RB_UL + k] = (1/sqrt(N_ant))*(w_re*alpha_im + w_im*alpha_re);
             }
         }
-
-        err = LIBLTE_SUCCESS;
     }
-
-    return(err);
 }
 
 /*********************************************************************
-    Name: liblte_phy_find_pss_and_fine_timing
+    Name: prach_preamble_seq_gen
 
-    Description: Searches for the Primary Synchronization Signal and
-                 determines fine timing.
+    Description: Generates all 64 PRACH preamble sequences
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_find_pss_and_fine_timing(LIBLTE_PHY_STRUCT *phy_struct,
-                                                      float             *i_samps,
-                                                      float             *q_samps,
-                                                      uint32            *symb_starts,
-                                                      uint32            *N_id_2,
-                                                      uint32            *pss_symb,
-                                                      float             *pss_thresh,
-                                                      float             *freq_offset)
+void prach_preamble_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
+                            uint32             root_seq_idx,
+                            uint32             pre_format,
+                            uint32             zczc,
+                            bool               hs_flag)
 {
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
-    float              corr_re_n1;
-    float              corr_im_n1;
-    float              corr_re;
-    float              corr_im;
-    float              corr_re_p1;
-    float              corr_im_p1;
-    float              abs_corr_n1;
-    float              abs_corr;
-    float              abs_corr_p1;
-    float              corr_max;
-    float              pss_re[63];
-    float              pss_im[63];
-    float             *pss_mod_re;
-    float             *pss_mod_im;
-    int32              i;
-    int32              idx;
-    uint32             j;
-    uint32             k;
-    uint32             z;
-    uint32             N_s;
-    uint32             N_symb;
-    uint32             pss_timing_idx;
-    int8               timing;
+    double phase;
+    uint32 N_gen_pre = 0;
+    uint32 u;
+    uint32 N_cs;
+    uint32 i;
+    uint32 p;
+    uint32 v;
+    uint32 v_max;
+    uint32 d_u;
+    uint32 d_start;
+    uint32 N_RA_shift;
+    uint32 N_RA_group;
+    uint32 N_neg_RA_shift;
+    uint32 C_v;
 
-    if(phy_struct  != NULL &&
-       i_samps     != NULL &&
-       q_samps     != NULL &&
-       symb_starts != NULL &&
-       N_id_2      != NULL &&
-       pss_symb    != NULL &&
-       pss_thresh  != NULL)
+    phy_struct->prach_root_seq_idx    = root_seq_idx;
+    phy_struct->prach_preamble_format = pre_format;
+    phy_struct->prach_zczc            = zczc;
+    phy_struct->prach_hs_flag         = hs_flag;
+
+    phy_struct->prach_N_x_u = 0;
+    while(N_gen_pre < 64)
     {
-        // Generate PSS
-        for(i=0; i<3; i++)
+        // Determine u and N_zc
+        if(4 == pre_format)
         {
-            for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
-            {
-                phy_struct->pss_mod_re[i][j] = 0;
-                phy_struct->pss_mod_im[i][j] = 0;
-            }
-            generate_pss(i, pss_re, pss_im);
-            for(j=0; j<62; j++)
+            u                      = PRACH_5_7_2_5[root_seq_idx+phy_struct->prach_N_x_u];
+            phy_struct->prach_N_zc = 139;
+        }else{
+            u                      = PRACH_5_7_2_4[root_seq_idx+phy_struct->prach_N_x_u];
+            phy_struct->prach_N_zc = 839;
+        }
+
+        // Generate x_u
+        for(i=0; i<phy_struct->prach_N_zc; i++)
+        {
+            phase                                                = -M_PI*u*i*(i+1)/phy_struct->prach_N_zc;
+            phy_struct->prach_x_u_re[phy_struct->prach_N_x_u][i] = cos(phase);
+            phy_struct->prach_x_u_im[phy_struct->prach_N_x_u][i] = sin(phase);
+        }
+
+        // Determine N_cs
+        if(4 == pre_format)
+        {
+            N_cs = PRACH_5_7_2_3[zczc];
+        }else{
+            if(hs_flag)
             {
-                k                                 = j - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
-                phy_struct->pss_mod_re_n1[i][k-1] = pss_re[j];
-                phy_struct->pss_mod_im_n1[i][k-1] = pss_im[j];
-                phy_struct->pss_mod_re[i][k]      = pss_re[j];
-                phy_struct->pss_mod_im[i][k]      = pss_im[j];
-                phy_struct->pss_mod_re_p1[i][k+1] = pss_re[j];
-                phy_struct->pss_mod_im_p1[i][k+1] = pss_im[j];
+                N_cs = PRACH_5_7_2_2_RS[zczc];
+            }else{
+                N_cs = PRACH_5_7_2_2_URS[zczc];
             }
         }
 
-        // Demod symbols and correlate with PSS
-        corr_max = 0;
-        for(i=0; i<12; i++)
+        // Determine v_max
+        if(hs_flag)
         {
-            for(j=0; j<N_SYMB_DL_NORMAL_CP; j++)
+            // Determine d_u
+            for(p=1; p<=phy_struct->prach_N_zc; p++)
             {
-                samples_to_symbols_dl(phy_struct,
-                                      i_samps,
-                                      q_samps,
-                                      symb_starts[j]+(phy_struct->N_samps_per_slot*i),
-                                      0,
-                                      0,
-                                      phy_struct->rx_symb_re,
-                                      phy_struct->rx_symb_im);
+                if(((p*u) % phy_struct->prach_N_zc) == 1)
+                {
+                    break;
+                }
+            }
+            if(p >= 0 && p < phy_struct->prach_N_zc/2)
+            {
+                d_u = p;
+            }else{
+                d_u = phy_struct->prach_N_zc - p;
+            }
 
-                for(k=0; k<3; k++)
+            // Determine N_RA_shift, d_start, N_RA_group, and N_neg_RA_shift
+            if(d_u >= N_cs && d_u < phy_struct->prach_N_zc/3)
+            {
+                N_RA_shift     = d_u/N_cs;
+                d_start        = 2*d_u + N_RA_shift*N_cs;
+                N_RA_group     = phy_struct->prach_N_zc/d_start;
+                N_neg_RA_shift = (phy_struct->prach_N_zc - 2*d_u - N_RA_group*d_start)/N_cs;
+                if(N_neg_RA_shift < 0)
                 {
-                    corr_re_n1 = 0;
-                    corr_im_n1 = 0;
-                    corr_re    = 0;
-                    corr_im    = 0;
-                    corr_re_p1 = 0;
-                    corr_im_p1 = 0;
-                    for(z=0; z<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; z++)
-                    {
-                        corr_re_n1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_re_n1[k][z] +
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_im_n1[k][z]);
-                        corr_im_n1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_im_n1[k][z] -
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_re_n1[k][z]);
-                        corr_re    += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_re[k][z] +
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_im[k][z]);
-                        corr_im    += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_im[k][z] -
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_re[k][z]);
-                        corr_re_p1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_re_p1[k][z] +
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_im_p1[k][z]);
-                        corr_im_p1 += (phy_struct->rx_symb_re[z]*phy_struct->pss_mod_im_p1[k][z] -
-                                       phy_struct->rx_symb_im[z]*phy_struct->pss_mod_re_p1[k][z]);
-                    }
-                    abs_corr_n1 = sqrt(corr_re_n1*corr_re_n1 + corr_im_n1*corr_im_n1);
-                    abs_corr    = sqrt(corr_re*corr_re + corr_im*corr_im);
-                    abs_corr_p1 = sqrt(corr_re_p1*corr_re_p1 + corr_im_p1*corr_im_p1);
-                    if(abs_corr_n1 > corr_max)
-                    {
-                        idx       = -1;
-                        corr_max  = abs_corr_n1;
-                        *pss_symb = (i*N_SYMB_DL_NORMAL_CP)+j;
-                        *N_id_2   = k;
-                    }
-                    if(abs_corr > corr_max)
-                    {
-                        idx       = 0;
-                        corr_max  = abs_corr;
-                        *pss_symb = (i*N_SYMB_DL_NORMAL_CP)+j;
-                        *N_id_2   = k;
-                    }
-                    if(abs_corr_p1 > corr_max)
-                    {
-                        idx       = 1;
-                        corr_max  = abs_corr_p1;
-                        *pss_symb = (i*N_SYMB_DL_NORMAL_CP)+j;
-                        *N_id_2   = k;
-                    }
+                    N_neg_RA_shift = 0;
+                }
+            }else{
+                N_RA_shift     = (phy_struct->prach_N_zc - 2*d_u)/N_cs;
+                d_start        = phy_struct->prach_N_zc - 2*d_u + N_RA_shift*N_cs;
+                N_RA_group     = d_u/d_start;
+                N_neg_RA_shift = (d_u - N_RA_group*d_start)/N_cs;
+                if(N_neg_RA_shift < 0)
+                {
+                    N_neg_RA_shift = 0;
+                }
+                if(N_neg_RA_shift > N_RA_shift)
+                {
+                    N_neg_RA_shift = N_RA_shift;
                 }
             }
-        }
-        if(-1 == idx)
-        {
-            pss_mod_re   = &phy_struct->pss_mod_re_n1[*N_id_2][0];
-            pss_mod_im   = &phy_struct->pss_mod_im_n1[*N_id_2][0];
-            *freq_offset = -15000; // FIXME
-        }else if(0 == idx){
-            pss_mod_re   = &phy_struct->pss_mod_re[*N_id_2][0];
-            pss_mod_im   = &phy_struct->pss_mod_im[*N_id_2][0];
-            *freq_offset = 0;
+
+            // Restricted set
+            v_max = N_RA_shift*N_RA_group + N_neg_RA_shift - 1;
         }else{
-            pss_mod_re   = &phy_struct->pss_mod_re_p1[*N_id_2][0];
-            pss_mod_im   = &phy_struct->pss_mod_im_p1[*N_id_2][0];
-            *freq_offset = 15000; // FIXME
+            // Unrestricted set
+            if(0 == N_cs)
+            {
+                v_max = 0;
+            }else{
+                v_max = (phy_struct->prach_N_zc/N_cs)-1;
+            }
         }
+        phy_struct->prach_N_cs = N_cs;
 
-        // Find optimal timing
-        N_s      = (*pss_symb)/7;
-        N_symb   = (*pss_symb)%7;
-        corr_max = 0;
-        timing   = 0;
-        for(i=-40; i<40; i++)
+        // Generate x_u_v
+        for(v=0; v<=v_max; v++)
         {
-            idx = symb_starts[N_symb] + (phy_struct->N_samps_per_slot*N_s);
-            if(i < 0)
+            if(hs_flag)
             {
-                if(idx >= -i)
-                {
-                    idx += i;
-                }
+                // Restricted set
+                C_v = d_start*floor(v/N_RA_shift) + (v % N_RA_shift)*N_cs;
             }else{
-                idx += i;
+                // Unrestricted set
+                C_v = v*N_cs;
             }
 
-            samples_to_symbols_dl(phy_struct,
-                                  i_samps,
-                                  q_samps,
-                                  idx,
-                                  0,
-                                  0,
-                                  phy_struct->rx_symb_re,
-                                  phy_struct->rx_symb_im);
-
-            corr_re = 0;
-            corr_im = 0;
-            for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
+            phy_struct->prach_C_v[N_gen_pre]  = C_v;
+            phy_struct->prach_root[N_gen_pre] = phy_struct->prach_N_x_u;
+            for(i=0; i<phy_struct->prach_N_zc; i++)
             {
-                corr_re += (phy_struct->rx_symb_re[j]*pss_mod_re[j] +
-                            phy_struct->rx_symb_im[j]*pss_mod_im[j]);
-                corr_im += (phy_struct->rx_symb_re[j]*pss_mod_im[j] -
-                            phy_struct->rx_symb_im[j]*pss_mod_re[j]);
+                phy_struct->prach_x_u_v_re[N_gen_pre][i] = phy_struct->prach_x_u_re[phy_struct->prach_N_x_u][(i+C_v) % phy_struct->prach_N_zc];
+                phy_struct->prach_x_u_v_im[N_gen_pre][i] = phy_struct->prach_x_u_im[phy_struct->prach_N_x_u][(i+C_v) % phy_struct->prach_N_zc];
             }
-            abs_corr = sqrt(corr_re*corr_re + corr_im*corr_im);
-            if(abs_corr > corr_max)
+
+            // Determine if enough preambles are generated
+            N_gen_pre++;
+            if(N_gen_pre >= 64)
             {
-                corr_max = abs_corr;
-                timing   = i;
+                break;
             }
         }
-        *pss_thresh = corr_max;
 
-        // Construct fine symbol start locations
-        pss_timing_idx = symb_starts[N_symb]+(phy_struct->N_samps_per_slot*N_s)+timing;
-        while((pss_timing_idx + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else) < phy_struct->N_samps_per_slot)
-        {
-            pss_timing_idx += phy_struct->N_samps_per_frame;
-        }
-        symb_starts[0] = pss_timing_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*1 - phy_struct->N_samps_per_slot;
-        for(i=1; i<7; i++)
+        // Move to the next root sequence
+        phy_struct->prach_N_x_u++;
+    }
+}
+
+/*********************************************************************
+    Name: prach_dec_filter_gen
+
+    Description: Generates the PRACH decimation filter and the per
+                 subcarrier compensation of its passband droop
+
+    Document Reference: N/A
+*********************************************************************/
+void prach_dec_filter_gen(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    float  h_sum = 0;
+    float  H;
+    float  f;
+    int32  n;
+    uint32 D = phy_struct->prach_dec_factor;
+    uint32 L = phy_struct->prach_dec_N_taps;
+    uint32 i;
+    uint32 k;
+
+    // Cutoff at half the decimated sample rate
+    for(k=0; k<L; k++)
+    {
+        n = (int32)k - (int32)(L-1)/2;
+        if(0 == n)
         {
-            symb_starts[i] = pss_timing_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*i + phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_0 - phy_struct->N_samps_per_slot;
+            phy_struct->prach_dec_h[k] = 1;
+        }else{
+            phy_struct->prach_dec_h[k]  = sin(M_PI*n/D)/(M_PI*n/D);
+            phy_struct->prach_dec_h[k] *= 0.42 - 0.5*cos(2*M_PI*k/(L-1)) + 0.08*cos(4*M_PI*k/(L-1));
         }
-
-        err = LIBLTE_SUCCESS;
+        h_sum += phy_struct->prach_dec_h[k];
+    }
+    for(k=0; k<L; k++)
+    {
+        phy_struct->prach_dec_h[k] /= h_sum;
     }
 
-    return(err);
+    // Subcarrier i sits (i - N_zc/2) PRACH subcarriers from the center
+    for(i=0; i<phy_struct->prach_N_zc; i++)
+    {
+        f = ((int32)i - (int32)phy_struct->prach_N_zc/2)/(float)phy_struct->prach_T_fft;
+        H = 0;
+        for(k=0; k<L; k++)
+        {
+            H += phy_struct->prach_dec_h[k]*cos(2*M_PI*f*((int32)k - (int32)(L-1)/2));
+        }
+        phy_struct->prach_dec_comp[i] = 1/H;
+    }
 }
 
 /*********************************************************************
-    Name: liblte_phy_map_sss
+    Name: detect_prach
 
-    Description: Maps the Secondary Synchronization Signal to the
-                 subframe.
+    Description: Detects PRACHs from baseband I/Q, reading every
+                 stride'th float so that both split and interleaved
+                 sample buffers can be used
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2 and 5.7.3
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_map_sss(LIBLTE_PHY_STRUCT          *phy_struct,
-                                     LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
-                                     uint32                      N_id_1,
-                                     uint32                      N_id_2,
-                                     uint8                       N_ant)
+void detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
+                  float             *samps_re,
+                  float             *samps_im,
+                  uint32             stride,
+                  uint32             freq_offset,
+                  uint32            *N_det_pre,
+                  uint32            *det_pre,
+                  uint32            *det_ta)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            p;
-    uint32            i;
-    uint32            k;
-
-    if(phy_struct != NULL &&
-       subframe   != NULL)
-    {
-        generate_sss(phy_struct,
-                     N_id_1,
-                     N_id_2,
-                     &phy_struct->sss_mod_re_0[0][0],
-                     &phy_struct->sss_mod_im_0[0][0],
-                     &phy_struct->sss_mod_re_5[0][0],
-                     &phy_struct->sss_mod_im_5[0][0]);
+    struct timespec time_start;
+    struct timespec time_end;
+    float           acc_re;
+    float           acc_im;
+    float           noise;
+    float           noise_sum;
+    float           max_val;
+    float           phase;
+    int32           b_0;
+    int32           bin;
+    uint32          i;
+    uint32          j;
+    uint32          k;
+    uint32          r;
+    uint32          p;
+    uint32          D;
+    uint32          c;
+    uint32          W;
+    uint32          N_noise;
+    uint32          N_ra_prb;
+    uint32          k_0;
+    uint32          K;
+    uint32          start;
+    uint32          max_lag;
+    uint32          max_idx;
+
+    clock_gettime(CLOCK_MONOTONIC, &time_start);
+
+    // Calculate PRACH parameters
+    N_ra_prb = freq_offset;
+    k_0      = N_ra_prb*phy_struct->N_sc_rb_ul - phy_struct->N_rb_ul*phy_struct->N_sc_rb_ul/2 + (phy_struct->FFT_size/2);
+    K        = 15000/phy_struct->prach_delta_f_RA;
+    start    = phy_struct->prach_phi + (K*k_0) + (K/2);
+    D        = phy_struct->prach_dec_factor;
+    c        = (phy_struct->prach_dec_N_taps - 1)/2;
+
+    // Mix the center of the PRACH band to DC as part of the filter taps
+    if(freq_offset != phy_struct->prach_dec_freq_offset)
+    {
+        b_0 = (int32)(start + phy_struct->prach_N_zc/2) - (int32)(phy_struct->prach_T_fft/2);
+        for(k=0; k<phy_struct->prach_dec_N_taps; k++)
+        {
+            phase                         = -2*M_PI*b_0*((int32)k - (int32)c)/(float)phy_struct->prach_T_fft;
+            phy_struct->prach_dec_g_re[k] = phy_struct->prach_dec_h[k]*cosf(phase);
+            phy_struct->prach_dec_g_im[k] = phy_struct->prach_dec_h[k]*sinf(phase);
+        }
+        phy_struct->prach_dec_freq_offset = freq_offset;
+    }
+
+    // Filter and decimate, the sequence is cyclic over prach_T_fft
+    for(i=0; i<phy_struct->prach_T_fft+phy_struct->prach_dec_N_taps-1; i++)
+    {
+        j                             = phy_struct->prach_T_cp + (i + phy_struct->prach_T_fft - c)%phy_struct->prach_T_fft;
+        phy_struct->prach_dec_x_re[i] = samps_re[j*stride];
+        phy_struct->prach_dec_x_im[i] = samps_im[j*stride];
+    }
+    for(i=0; i<phy_struct->prach_dec_N_fft; i++)
+    {
+        acc_re = 0;
+        acc_im = 0;
+        for(k=0; k<phy_struct->prach_dec_N_taps; k++)
+        {
+            acc_re += (phy_struct->prach_dec_g_re[k]*phy_struct->prach_dec_x_re[i*D+k] -
+                       phy_struct->prach_dec_g_im[k]*phy_struct->prach_dec_x_im[i*D+k]);
+            acc_im += (phy_struct->prach_dec_g_re[k]*phy_struct->prach_dec_x_im[i*D+k] +
+                       phy_struct->prach_dec_g_im[k]*phy_struct->prach_dec_x_re[i*D+k]);
+        }
+        phy_struct->prach_dec_fft_in[i][0] = acc_re;
+        phy_struct->prach_dec_fft_in[i][1] = acc_im;
+    }
+    fftwf_execute(phy_struct->prach_dec_fft_plan);
+    for(i=0; i<phy_struct->prach_N_zc; i++)
+    {
+        bin = ((int32)(i + start) - (int32)(phy_struct->prach_T_fft/2)) % (int32)phy_struct->prach_dec_N_fft;
+        if(bin < 0)
+        {
+            bin += phy_struct->prach_dec_N_fft;
+        }
+        phy_struct->prach_x_hat_re[i] = phy_struct->prach_dec_fft_out[bin][0]*phy_struct->prach_dec_comp[i];
+        phy_struct->prach_x_hat_im[i] = phy_struct->prach_dec_fft_out[bin][1]*phy_struct->prach_dec_comp[i];
+    }
+
+    // Correlate with all available roots
+    W          = (0 == phy_struct->prach_N_cs) ? phy_struct->prach_N_zc : phy_struct->prach_N_cs;
+    *N_det_pre = 0;
+    p          = 0;
+    for(r=0; r<phy_struct->prach_N_x_u; r++)
+    {
+        for(j=0; j<phy_struct->prach_N_zc; j++)
+        {
+            phy_struct->prach_dft_in[j][0] = phy_struct->prach_x_u_fft_re[r][j]*phy_struct->prach_x_hat_re[j] + phy_struct->prach_x_u_fft_im[r][j]*phy_struct->prach_x_hat_im[j];
+            phy_struct->prach_dft_in[j][1] = phy_struct->prach_x_u_fft_im[r][j]*phy_struct->prach_x_hat_re[j] - phy_struct->prach_x_u_fft_re[r][j]*phy_struct->prach_x_hat_im[j];
+        }
+        fftwf_execute(phy_struct->prach_idft_plan);
+        noise_sum = 0;
+        for(j=0; j<phy_struct->prach_N_zc; j++)
+        {
+            phy_struct->prach_corr[j]  = (phy_struct->prach_dft_out[j][0]*phy_struct->prach_dft_out[j][0] +
+                                          phy_struct->prach_dft_out[j][1]*phy_struct->prach_dft_out[j][1]);
+            noise_sum                 += phy_struct->prach_corr[j];
+        }
+
+        // Noise floor, leaving out the lags that already stand out
+        noise     = noise_sum/phy_struct->prach_N_zc;
+        noise_sum = 0;
+        N_noise   = 0;
+        for(j=0; j<phy_struct->prach_N_zc; j++)
+        {
+            if(phy_struct->prach_corr[j] < phy_struct->prach_threshold*noise)
+            {
+                noise_sum += phy_struct->prach_corr[j];
+                N_noise++;
+            }
+        }
+        if(0 != N_noise)
+        {
+            noise = noise_sum/N_noise;
+        }
 
-        if(subframe->num == 0)
+        // A delay of d moves the peak of preamble p to lag C_v - d
+        for(; p<LIBLTE_PHY_PRACH_N_PREAMBLES && r == phy_struct->prach_root[p]; p++)
         {
-            for(p=0; p<N_ant; p++)
+            max_val = 0;
+            max_lag = 0;
+            max_idx = 0;
+            for(j=0; j<W; j++)
             {
-                for(i=0; i<62; i++)
+                k = (phy_struct->prach_C_v[p] + phy_struct->prach_N_zc - j) % phy_struct->prach_N_zc;
+                if(phy_struct->prach_corr[k] > max_val)
                 {
-                    k                             = i - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
-                    subframe->tx_symb_re[p][5][k] = phy_struct->sss_mod_re_0[0][i];
-                    subframe->tx_symb_im[p][5][k] = phy_struct->sss_mod_im_0[0][i];
+                    max_val = phy_struct->prach_corr[k];
+                    max_lag = j;
+                    max_idx = k;
                 }
             }
-        }else if(subframe->num == 5){
-            for(p=0; p<N_ant; p++)
+
+            // Skip zone edge peaks that are the skirt of a peak in a neighboring zone
+            if(phy_struct->prach_corr[(max_idx + 1) % phy_struct->prach_N_zc]                           > max_val ||
+               phy_struct->prach_corr[(max_idx + phy_struct->prach_N_zc - 1) % phy_struct->prach_N_zc] > max_val)
             {
-                for(i=0; i<62; i++)
-                {
-                    k                             = i - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
-                    subframe->tx_symb_re[p][5][k] = phy_struct->sss_mod_re_5[0][i];
-                    subframe->tx_symb_im[p][5][k] = phy_struct->sss_mod_im_5[0][i];
-                }
+                continue;
+            }
+            if(max_val != 0 &&
+               max_val >= phy_struct->prach_threshold*noise)
+            {
+                // Timing advance is in units of 16*Ts
+                det_pre[*N_det_pre]                               = p;
+                det_ta[*N_det_pre]                                = (uint32)roundf((float)max_lag*phy_struct->prach_T_fft*(30720000/phy_struct->fs)/(16*phy_struct->prach_N_zc));
+                phy_struct->prach_stats.peak_to_noise[*N_det_pre] = max_val/noise;
+                (*N_det_pre)++;
             }
         }
-
-        err = LIBLTE_SUCCESS;
     }
 
-    return(err);
+    clock_gettime(CLOCK_MONOTONIC, &time_end);
+    phy_struct->prach_stats.detect_time_us = ((time_end.tv_sec - time_start.tv_sec)*1000000 +
+                                              (time_end.tv_nsec - time_start.tv_nsec)/1000);
+    phy_struct->prach_stats.N_roots        = phy_struct->prach_N_x_u;
+    phy_struct->prach_stats.N_detected     = *N_det_pre;
 }
 
 /*********************************************************************
-    Name: liblte_phy_find_sss
+    Name: layer_mapper_dl
 
-    Description: Searches for the Secondary Synchronization Signal.
+    Description: Maps complex-valued modulation symbols onto one or
+                 several downlink layers
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.3
+
+    NOTES: Currently only supports single antenna or TX diversity
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_find_sss(LIBLTE_PHY_STRUCT *phy_struct,
-                                      float             *i_samps,
-                                      float             *q_samps,
-                                      uint32             N_id_2,
-                                      uint32            *symb_starts,
-                                      float              pss_thresh,
-                                      uint32            *N_id_1,
-                                      uint32            *frame_start_idx)
+void layer_mapper_dl(float                          *d_re,
+                     float                          *d_im,
+                     uint32                          M_symb,
+                     uint8                           N_ant,
+                     uint32                          N_codewords,
+                     LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                     float                          *x_re,
+                     float                          *x_im,
+                     uint32                         *M_layer_symb)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    float             sss_thresh;
-    float             corr_re;
-    float             corr_im;
-    float             abs_corr;
-    uint32            i;
-    uint32            j;
-    uint32            k;
+    uint32 i;
 
-    if(phy_struct      != NULL &&
-       i_samps         != NULL &&
-       q_samps         != NULL &&
-       symb_starts     != NULL &&
-       N_id_1          != NULL &&
-       frame_start_idx != NULL)
+    if(N_ant       == 1 &&
+       N_codewords == 1)
     {
-        // Generate secondary synchronization signals
-        memset(phy_struct->sss_mod_re_0, 0, sizeof(float)*168*LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
-        memset(phy_struct->sss_mod_im_0, 0, sizeof(float)*168*LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
-        memset(phy_struct->sss_mod_re_5, 0, sizeof(float)*168*LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
-        memset(phy_struct->sss_mod_im_5, 0, sizeof(float)*168*LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP);
-        for(i=0; i<168; i++)
+        // 3GPP TS 36.211 v10.1.0 section 6.3.3.1
+        *M_layer_symb = M_symb;
+        for(i=0; i<M_symb; i++)
         {
-            generate_sss(phy_struct,
-                         i,
-                         N_id_2,
-                         phy_struct->sss_re_0,
-                         phy_struct->sss_im_0,
-                         phy_struct->sss_re_5,
-                         phy_struct->sss_im_5);
-            for(j=0; j<62; j++)
-            {
-                k                              = j - 31 + (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl)/2;
-                phy_struct->sss_mod_re_0[i][k] = phy_struct->sss_re_0[j];
-                phy_struct->sss_mod_im_0[i][k] = phy_struct->sss_im_0[j];
-                phy_struct->sss_mod_re_5[i][k] = phy_struct->sss_re_5[j];
-                phy_struct->sss_mod_im_5[i][k] = phy_struct->sss_im_5[j];
-            }
+            x_re[i] = d_re[i];
+            x_im[i] = d_im[i];
         }
-        sss_thresh = pss_thresh * 0.9;
-
-        // Demod symbol and search for secondary synchronization signals
-        samples_to_symbols_dl(phy_struct,
-                              i_samps,
-                              q_samps,
-                              symb_starts[5],
-                              0,
-                              0,
-                              phy_struct->rx_symb_re,
-                              phy_struct->rx_symb_im);
-        for(i=0; i<168; i++)
+    }else{
+        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type)
         {
-            corr_re = 0;
-            corr_im = 0;
-            for(j=0; j<(phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl); j++)
-            {
-                corr_re += (phy_struct->rx_symb_re[j]*phy_struct->sss_mod_re_0[i][j] +
-                            phy_struct->rx_symb_im[j]*phy_struct->sss_mod_im_0[i][j]);
-                corr_im += (phy_struct->rx_symb_re[j]*phy_struct->sss_mod_im_0[i][j] -
-                            phy_struct->rx_symb_im[j]*phy_struct->sss_mod_re_0[i][j]);
-            }
-            abs_corr = sqrt(corr_re*corr_re + corr_im*corr_im);
-            if(abs_corr > sss_thresh)
+            // 3GPP TS 36.211 v10.1.0 section 6.3.3.3
+            if(N_ant == 2)
             {
-                while(symb_starts[5] < ((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0))
+                *M_layer_symb = M_symb/2;
+                for(i=0; i<*M_layer_symb; i++)
                 {
-                    symb_starts[5] += phy_struct->N_samps_per_frame;
+                    x_re[i]               = d_re[2*i];
+                    x_im[i]               = d_im[2*i];
+                    x_re[*M_layer_symb+i] = d_re[2*i+1];
+                    x_im[*M_layer_symb+i] = d_im[2*i+1];
+                }
+            }else{ // N_ant == 4
+                if((M_symb % 4) == 0)
+                {
+                    *M_layer_symb = M_symb/4;
+                }else{
+                    *M_layer_symb = (M_symb+2)/4;
+                }
+                for(i=0; i<*M_layer_symb; i++)
+                {
+                    x_re[i]                   = d_re[4*i];
+                    x_im[i]                   = d_im[4*i];
+                    x_re[*M_layer_symb+i]     = d_re[4*i+1];
+                    x_im[*M_layer_symb+i]     = d_im[4*i+1];
+                    x_re[2*(*M_layer_symb)+i] = d_re[4*i+2];
+                    x_im[2*(*M_layer_symb)+i] = d_im[4*i+2];
+                    x_re[3*(*M_layer_symb)+i] = d_re[4*i+3];
+                    x_im[3*(*M_layer_symb)+i] = d_im[4*i+3];
                 }
-                *N_id_1          = i;
-                *frame_start_idx = symb_starts[5] - ((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0);
-                err              = LIBLTE_SUCCESS;
-                break;
-            }
-
-            corr_re = 0;
-            corr_im = 0;
-            for(j=0; j<(phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl); j++)
-            {
-                corr_re += (phy_struct->rx_symb_re[j]*phy_struct->sss_mod_re_5[i][j] +
-                            phy_struct->rx_symb_im[j]*phy_struct->sss_mod_im_5[i][j]);
-                corr_im += (phy_struct->rx_symb_re[j]*phy_struct->sss_mod_im_5[i][j] -
-                            phy_struct->rx_symb_im[j]*phy_struct->sss_mod_re_5[i][j]);
             }
-            abs_corr = sqrt(corr_re*corr_re + corr_im*corr_im);
-            if(abs_corr > sss_thresh)
+        }else{
+            if(N_ant == 2)
             {
-                while(symb_starts[5] < (((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0) + phy_struct->N_samps_per_slot*10))
+                if(N_codewords == 1)
+                {
+                    *M_layer_symb = M_symb/2;
+                    for(i=0; i<*M_layer_symb; i++)
+                    {
+                        x_re[i]               = d_re[2*i];
+                        x_im[i]               = d_im[2*i];
+                        x_re[*M_layer_symb+i] = d_re[2*i+1];
+                        x_im[*M_layer_symb+i] = d_im[2*i+1];
+                    }
+                }else{ // N_codewords == 2
+                    *M_layer_symb = M_symb;
+                    for(i=0; i<*M_layer_symb; i++)
+                    {
+                        x_re[i]               = d_re[i];
+                        x_im[i]               = d_im[i];
+                        x_re[*M_layer_symb+i] = d_re[M_symb+i];
+                        x_im[*M_layer_symb+i] = d_im[M_symb+i];
+                    }
+                }
+            }else if(N_ant == 3){
+                if(N_codewords == 1)
+                {
+                    *M_layer_symb = M_symb/3;
+                    for(i=0; i<*M_layer_symb; i++)
+                    {
+                        x_re[i]                   = d_re[3*i];
+                        x_im[i]                   = d_im[3*i];
+                        x_re[*M_layer_symb+i]     = d_re[3*i+1];
+                        x_im[*M_layer_symb+i]     = d_im[3*i+1];
+                        x_re[2*(*M_layer_symb)+i] = d_re[3*i+2];
+                        x_im[2*(*M_layer_symb)+i] = d_im[3*i+2];
+                    }
+                }else{ // N_codewords == 2
+                    // FIXME
+                }
+            }else if(N_ant == 4){
+                if(N_codewords == 1)
+                {
+                    *M_layer_symb = M_symb/4;
+                    for(i=0; i<*M_layer_symb; i++)
+                    {
+                        x_re[i]                   = d_re[4*i];
+                        x_im[i]                   = d_im[4*i];
+                        x_re[*M_layer_symb+i]     = d_re[4*i+1];
+                        x_im[*M_layer_symb+i]     = d_im[4*i+1];
+                        x_re[2*(*M_layer_symb)+i] = d_re[4*i+2];
+                        x_im[2*(*M_layer_symb)+i] = d_im[4*i+2];
+                        x_re[3*(*M_layer_symb)+i] = d_re[4*i+3];
+                        x_im[3*(*M_layer_symb)+i] = d_im[4*i+3];
+                    }
+                }else{ // N_codewords == 2
+                    *M_layer_symb = M_symb/2;
+                    for(i=0; i<*M_layer_symb; i++)
+                    {
+                        x_re[i]                   = d_re[2*i];
+                        x_im[i]                   = d_im[2*i];
+                        x_re[*M_layer_symb+i]     = d_re[2*i+1];
+                        x_im[*M_layer_symb+i]     = d_im[2*i+1];
+                        x_re[2*(*M_layer_symb)+i] = d_re[M_symb+2*i];
+                        x_im[2*(*M_layer_symb)+i] = d_im[M_symb+2*i];
+                        x_re[3*(*M_layer_symb)+i] = d_re[M_symb+2*i+1];
+                        x_im[3*(*M_layer_symb)+i] = d_im[M_symb+2*i+1];
+                    }
+                }
+            }else if(N_ant == 5){
+                // FIXME
+            }else if(N_ant == 6){
+                *M_layer_symb = M_symb/3;
+                for(i=0; i<*M_layer_symb; i++)
+                {
+                    x_re[i]                   = d_re[3*i];
+                    x_im[i]                   = d_im[3*i];
+                    x_re[*M_layer_symb+i]     = d_re[3*i+1];
+                    x_im[*M_layer_symb+i]     = d_im[3*i+1];
+                    x_re[2*(*M_layer_symb)+i] = d_re[3*i+2];
+                    x_im[2*(*M_layer_symb)+i] = d_im[3*i+2];
+                    x_re[3*(*M_layer_symb)+i] = d_re[M_symb+3*i];
+                    x_im[3*(*M_layer_symb)+i] = d_im[M_symb+3*i];
+                    x_re[4*(*M_layer_symb)+i] = d_re[M_symb+3*i+1];
+                    x_im[4*(*M_layer_symb)+i] = d_im[M_symb+3*i+1];
+                    x_re[5*(*M_layer_symb)+i] = d_re[M_symb+3*i+2];
+                    x_im[5*(*M_layer_symb)+i] = d_im[M_symb+3*i+2];
+                }
+            }else if(N_ant == 7){
+                // FIXME
+            }else{ // N_ant == 8
+                *M_layer_symb = M_symb/4;
+                for(i=0; i<*M_layer_symb; i++)
                 {
-                    symb_starts[5] += phy_struct->N_samps_per_frame;
+                    x_re[i]                   = d_re[4*i];
+                    x_im[i]                   = d_im[4*i];
+                    x_re[*M_layer_symb+i]     = d_re[4*i+1];
+                    x_im[*M_layer_symb+i]     = d_im[4*i+1];
+                    x_re[2*(*M_layer_symb)+i] = d_re[4*i+2];
+                    x_im[2*(*M_layer_symb)+i] = d_im[4*i+2];
+                    x_re[3*(*M_layer_symb)+i] = d_re[4*i+3];
+                    x_im[3*(*M_layer_symb)+i] = d_im[4*i+3];
+                    x_re[4*(*M_layer_symb)+i] = d_re[M_symb+4*i];
+                    x_im[4*(*M_layer_symb)+i] = d_im[M_symb+4*i];
+                    x_re[5*(*M_layer_symb)+i] = d_re[M_symb+4*i+1];
+                    x_im[5*(*M_layer_symb)+i] = d_im[M_symb+4*i+1];
+                    x_re[6*(*M_layer_symb)+i] = d_re[M_symb+4*i+2];
+                    x_im[6*(*M_layer_symb)+i] = d_im[M_symb+4*i+2];
+                    x_re[7*(*M_layer_symb)+i] = d_re[M_symb+4*i+3];
+                    x_im[7*(*M_layer_symb)+i] = d_im[M_symb+4*i+3];
                 }
-                *N_id_1          = i;
-                *frame_start_idx = symb_starts[5] - ((phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else)*4 + phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_0) - phy_struct->N_samps_per_slot*10;
-                err              = LIBLTE_SUCCESS;
-                break;
             }
         }
     }
+}
 
-    return(err);
+/*********************************************************************
+    Name: layer_demapper_dl
+
+    Description: De-maps one or several downlink layers into complex-
+                 valued modulation symbols
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.3
+
+    NOTES: Currently only supports single antenna or TX diversity
+*********************************************************************/
+void layer_demapper_dl(float                          *x_re,
+                       float                          *x_im,
+                       uint32                          M_layer_symb,
+                       uint8                           N_ant,
+                       uint32                          N_codewords,
+                       LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                       float                          *d_re,
+                       float                          *d_im,
+                       uint32                         *M_symb)
+{
+    float  *x_re_ptr[N_ant];
+    float  *x_im_ptr[N_ant];
+    uint32  i;
+    uint32  p;
+
+    // FIXME: Only supports TX diversity
+    // Index all arrays
+    for(p=0; p<N_ant; p++)
+    {
+        x_re_ptr[p] = &x_re[p*M_layer_symb];
+        x_im_ptr[p] = &x_im[p*M_layer_symb];
+    }
+
+    // 3GPP TS 36.211 v10.1.0 sections 6.3.3.1 and 6.3.3.3
+    *M_symb = M_layer_symb*N_ant;
+    if(N_ant                       == 4            &&
+       x_re_ptr[2][M_layer_symb-1] == RX_NULL_SYMB &&
+       x_im_ptr[2][M_layer_symb-1] == RX_NULL_SYMB &&
+       x_re_ptr[3][M_layer_symb-1] == RX_NULL_SYMB &&
+       x_im_ptr[3][M_layer_symb-1] == RX_NULL_SYMB)
+    {
+        *M_symb = *M_symb - 2;
+    }
+    for(i=0; i<M_layer_symb; i++)
+    {
+        for(p=0; p<N_ant; p++)
+        {
+            d_re[i*N_ant+p] = x_re_ptr[p][i];
+            d_im[i*N_ant+p] = x_im_ptr[p][i];
+        }
+    }
 }
 
 /*********************************************************************
-    Name: liblte_phy_dl_find_coarse_timing_and_freq_offset
+    Name: pre_coder_dl
 
-    Description: Finds coarse time syncronization and frequency offset
-                 by auto-correlating to find the cyclic prefix on
-                 reference signal symbols of the downlink
+    Description: Generates a block of vectors to be mapped onto
+                 resources on each downlink antenna port
 
-    Document Reference: 3GPP TS 36.211 v10.1.0
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
+
+    NOTES: Currently only supports signle antenna or TX diversity
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_dl_find_coarse_timing_and_freq_offset(LIBLTE_PHY_STRUCT               *phy_struct,
-                                                                   float                           *i_samps,
-                                                                   float                           *q_samps,
-                                                                   uint32                           N_slots,
-                                                                   LIBLTE_PHY_COARSE_TIMING_STRUCT *timing_struct)
+void pre_coder_dl(float                          *x_re,
+                  float                          *x_im,
+                  uint32                          M_layer_symb,
+                  uint8                           N_ant,
+                  LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                  float                          *y_re,
+                  float                          *y_im,
+                  uint32                          y_len,
+                  uint32                         *M_ap_symb)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    float             corr_re;
-    float             corr_im;
-    float             corr_mean = 0;
-    float             abs_corr_max;
-    float             freq_err[LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS];
-    int32             abs_corr_idx[LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS];
-    int32             tmp_idx;
-    uint32            slot;
-    uint32            i;
-    uint32            j;
-    uint32            k;
-    uint32            idx;
-    uint32            N_samps_per_symb_else = phy_struct->N_samps_per_symb + phy_struct->N_samps_cp_l_else;
-    uint32            N_samps_to_blank      = N_samps_per_symb_else/10;
+    float  *x_re_ptr[N_ant];
+    float  *x_im_ptr[N_ant];
+    float  *y_re_ptr[N_ant];
+    float  *y_im_ptr[N_ant];
+    float   one_over_sqrt_2 = 1/sqrt(2);
+    uint32  i;
+    uint32  p;
 
-    if(phy_struct    != NULL &&
-       i_samps       != NULL &&
-       q_samps       != NULL &&
-       timing_struct != NULL)
+    // Index all arrays
+    for(p=0; p<N_ant; p++)
     {
-        // Timing correlation
-        for(i=0; i<phy_struct->N_samps_per_slot; i++)
+        x_re_ptr[p] = &x_re[p*M_layer_symb];
+        x_im_ptr[p] = &x_im[p*M_layer_symb];
+        y_re_ptr[p] = &y_re[p*y_len];
+        y_im_ptr[p] = &y_im[p*y_len];
+    }
+
+    if(N_ant == 1)
+    {
+        // 3GPP TS 36.211 v10.1.0 section 6.3.4.1
+        *M_ap_symb = M_layer_symb;
+        for(i=0; i<*M_ap_symb; i++)
         {
-            phy_struct->dl_timing_abs_corr[i] = 0;
+            y_re_ptr[0][i] = x_re_ptr[0][i];
+            y_im_ptr[0][i] = x_im_ptr[0][i];
         }
-        for(slot=0; slot<N_slots; slot++)
+    }else if(N_ant == 2){
+        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type)
         {
-            for(i=0; i<phy_struct->N_samps_per_slot; i++)
+            // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
+            *M_ap_symb = 2*M_layer_symb;
+            for(i=0; i<M_layer_symb; i++)
             {
-                corr_re = 0;
-                corr_im = 0;
-                for(j=0; j<phy_struct->N_samps_cp_l_else; j++)
-                {
-                    idx      = (slot*phy_struct->N_samps_per_slot) + i + j;
-                    corr_re += i_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb] + q_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb];
-                    corr_im += i_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb] - q_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb];
-                }
-                phy_struct->dl_timing_abs_corr[i] += corr_re*corr_re + corr_im*corr_im;
+                y_re_ptr[0][2*i+0] = +one_over_sqrt_2 * x_re_ptr[0][i];
+                y_im_ptr[0][2*i+0] = +one_over_sqrt_2 * x_im_ptr[0][i];
+                y_re_ptr[1][2*i+0] = -one_over_sqrt_2 * x_re_ptr[1][i];
+                y_im_ptr[1][2*i+0] = +one_over_sqrt_2 * x_im_ptr[1][i];
+                y_re_ptr[0][2*i+1] = +one_over_sqrt_2 * x_re_ptr[1][i];
+                y_im_ptr[0][2*i+1] = +one_over_sqrt_2 * x_im_ptr[1][i];
+                y_re_ptr[1][2*i+1] = +one_over_sqrt_2 * x_re_ptr[0][i];
+                y_im_ptr[1][2*i+1] = -one_over_sqrt_2 * x_im_ptr[0][i];
             }
+        }else{
+            // FIXME: Currently only supporting TX Diversity
         }
-
-        // Find mean of correlation and gate correlation results
-        for(i=0; i<phy_struct->N_samps_per_slot; i++)
-        {
-            corr_mean                                                      += phy_struct->dl_timing_abs_corr[i];
-            phy_struct->dl_timing_abs_corr[i+phy_struct->N_samps_per_slot]  = phy_struct->dl_timing_abs_corr[i];
-        }
-        corr_mean /= phy_struct->N_samps_per_slot;
-        for(i=0; i<phy_struct->N_samps_per_slot; i++)
+    }else{
+        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type)
         {
-            if(phy_struct->dl_timing_abs_corr[i] <= corr_mean)
+            // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
+            if(x_re_ptr[2][M_layer_symb-1] == TX_NULL_SYMB &&
+               x_im_ptr[2][M_layer_symb-1] == TX_NULL_SYMB &&
+               x_re_ptr[3][M_layer_symb-1] == TX_NULL_SYMB &&
+               x_im_ptr[3][M_layer_symb-1] == TX_NULL_SYMB)
+            {
+                *M_ap_symb = 4*M_layer_symb - 2;
+            }else{
+                *M_ap_symb = 4*M_layer_symb;
+            }
+            for(i=0; i<M_layer_symb; i++)
             {
-                phy_struct->dl_timing_abs_corr[i]                              = 0;
-                phy_struct->dl_timing_abs_corr[i+phy_struct->N_samps_per_slot] = 0;
+                y_re_ptr[0][4*i+0] = +one_over_sqrt_2 * x_re_ptr[0][i];
+                y_im_ptr[0][4*i+0] = +one_over_sqrt_2 * x_im_ptr[0][i];
+                y_re_ptr[1][4*i+0] = 0;
+                y_im_ptr[1][4*i+0] = 0;
+                y_re_ptr[2][4*i+0] = -one_over_sqrt_2 * x_re_ptr[1][i];
+                y_im_ptr[2][4*i+0] = +one_over_sqrt_2 * x_im_ptr[1][i];
+                y_re_ptr[3][4*i+0] = 0;
+                y_im_ptr[3][4*i+0] = 0;
+                y_re_ptr[0][4*i+1] = +one_over_sqrt_2 * x_re_ptr[1][i];
+                y_im_ptr[0][4*i+1] = +one_over_sqrt_2 * x_im_ptr[1][i];
+                y_re_ptr[1][4*i+1] = 0;
+                y_im_ptr[1][4*i+1] = 0;
+                y_re_ptr[2][4*i+1] = +one_over_sqrt_2 * x_re_ptr[0][i];
+                y_im_ptr[2][4*i+1] = -one_over_sqrt_2 * x_im_ptr[0][i];
+                y_re_ptr[3][4*i+1] = 0;
+                y_im_ptr[3][4*i+1] = 0;
+                y_re_ptr[0][4*i+2] = 0;
+                y_im_ptr[0][4*i+2] = 0;
+                y_re_ptr[1][4*i+2] = +one_over_sqrt_2 * x_re_ptr[2][i];
+                y_im_ptr[1][4*i+2] = +one_over_sqrt_2 * x_im_ptr[2][i];
+                y_re_ptr[2][4*i+2] = 0;
+                y_im_ptr[2][4*i+2] = 0;
+                y_re_ptr[3][4*i+2] = -one_over_sqrt_2 * x_re_ptr[3][i];
+                y_im_ptr[3][4*i+2] = +one_over_sqrt_2 * x_im_ptr[3][i];
+                y_re_ptr[0][4*i+3] = 0;
+                y_im_ptr[0][4*i+3] = 0;
+                y_re_ptr[1][4*i+3] = +one_over_sqrt_2 * x_re_ptr[3][i];
+                y_im_ptr[1][4*i+3] = +one_over_sqrt_2 * x_im_ptr[3][i];
+                y_re_ptr[2][4*i+3] = 0;
+                y_im_ptr[2][4*i+3] = 0;
+                y_re_ptr[3][4*i+3] = +one_over_sqrt_2 * x_re_ptr[2][i];
+                y_im_ptr[3][4*i+3] = -one_over_sqrt_2 * x_im_ptr[2][i];
             }
+        }else{
+            // FIXME: Currently only supporting TX Diversity
         }
+    }
+}
 
-        // Multiply to get (first_symbol * fourth_symbol)
-        for(i=0; i<phy_struct->N_samps_per_slot; i++)
-        {
-            phy_struct->dl_timing_abs_corr[i] *= phy_struct->dl_timing_abs_corr[(phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_0+(phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*3)+i];
-        }
+/*********************************************************************
+    Name: pre_decoder_and_matched_filter_dl
 
-        // Search for all of the eNB signals
-        timing_struct->n_corr_peaks = LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS;
-        for(i=0; i<LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS; i++)
-        {
-            abs_corr_max    = 0;
-            abs_corr_idx[i] = 0;
-            for(j=0; j<phy_struct->N_samps_per_slot; j++)
-            {
-                if(phy_struct->dl_timing_abs_corr[j] > abs_corr_max)
-                {
-                    abs_corr_max    = phy_struct->dl_timing_abs_corr[j];
-                    abs_corr_idx[i] = j;
-                }
-            }
+    Description: Matched filters and unmaps a block of vectors from
+                 resources on each downlink antenna port
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
+
+    NOTES: Currently only supports single antenna or TX diversity
+*********************************************************************/
+void pre_decoder_and_matched_filter_dl(float                          *y_re,
+                                       float                          *y_im,
+                                       float                          *h_re,
+                                       float                          *h_im,
+                                       uint32                          h_len,
+                                       uint32                          M_ap_symb,
+                                       uint8                           N_ant,
+                                       LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
+                                       float                          *x_re,
+                                       float                          *x_im,
+                                       uint32                         *M_layer_symb)
+{
+    float  *h_re_ptr[N_ant];
+    float  *h_im_ptr[N_ant];
+    float  *x_re_ptr[N_ant];
+    float  *x_im_ptr[N_ant];
+    float   h0_abs;
+    float   h1_abs;
+    float   h2_abs;
+    float   h3_abs;
+    float   h_norm;
+    float   h_norm_0_2;
+    float   h_norm_1_3;
+    uint32  i;
+    uint32  p;
 
-            if(0 == abs_corr_max)
-            {
-                timing_struct->n_corr_peaks = i;
-                break;
-            }else{
-                // Get rid of max and peaks
-                tmp_idx = abs_corr_idx[i];
-                while(tmp_idx > 0)
-                {
-                    tmp_idx -= N_samps_per_symb_else;
-                }
-                for(j=0; j<7; j++)
-                {
-                    tmp_idx += N_samps_per_symb_else;
-                    for(k=0; k<N_samps_to_blank; k++)
-                    {
-                        idx = tmp_idx - (N_samps_to_blank/2) + k;
-                        if(idx >= 0 &&
-                           idx <= (LIBLTE_PHY_N_SAMPS_PER_SLOT_30_72MHZ*2))
-                        {
-                            phy_struct->dl_timing_abs_corr[idx] = 0;
-                        }
-                    }
-                }
-            }
-        }
+    // Index all arrays
+    for(p=0; p<N_ant; p++)
+    {
+        h_re_ptr[p] = &h_re[p*h_len];
+        h_im_ptr[p] = &h_im[p*h_len];
+        x_re_ptr[p] = &x_re[p*(M_ap_symb/N_ant)];
+        x_im_ptr[p] = &x_im[p*(M_ap_symb/N_ant)];
+    }
 
-        // Determine frequency offset
-        for(i=0; i<timing_struct->n_corr_peaks; i++)
+    if(N_ant == 1)
+    {
+        // 3GPP TS 36.211 v10.1.0 section 6.3.4.1
+        *M_layer_symb = M_ap_symb;
+        for(i=0; i<*M_layer_symb; i++)
         {
-            freq_err[i] = 0;
+            h_norm         = (h_re_ptr[0][i] * h_re_ptr[0][i] +
+                              h_im_ptr[0][i] * h_im_ptr[0][i]);
+            x_re_ptr[0][i] = (y_re[i]*h_re_ptr[0][i] + y_im[i]*h_im_ptr[0][i]) / h_norm;
+            x_im_ptr[0][i] = (y_im[i]*h_re_ptr[0][i] - y_re[i]*h_im_ptr[0][i]) / h_norm;
         }
-        for(slot=0; slot<N_slots; slot++)
+    }else if(N_ant == 2){
+        // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
+        *M_layer_symb = M_ap_symb/2;
+        for(i=0; i<*M_layer_symb; i++)
         {
-            for(i=0; i<timing_struct->n_corr_peaks; i++)
-            {
-                corr_re = 0;
-                corr_im = 0;
-                for(j=0; j<phy_struct->N_samps_cp_l_else; j++)
-                {
-                    idx      = (slot*phy_struct->N_samps_per_slot) + abs_corr_idx[i] + j;
-                    corr_re += i_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb] + q_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb];
-                    corr_im += i_samps[idx]*q_samps[idx+phy_struct->N_samps_per_symb] - q_samps[idx]*i_samps[idx+phy_struct->N_samps_per_symb];
-                }
-                freq_err[i] += atan2f(corr_im, corr_re)/(phy_struct->N_samps_per_symb*2*M_PI*(0.0005/phy_struct->N_samps_per_slot));
-            }
+            h0_abs         = (h_re_ptr[0][i*2] * h_re_ptr[0][i*2] +
+                              h_im_ptr[0][i*2] * h_im_ptr[0][i*2]);
+            h1_abs         = (h_re_ptr[1][i*2] * h_re_ptr[1][i*2] +
+                              h_im_ptr[1][i*2] * h_im_ptr[1][i*2]);
+            h_norm         = sqrt(h0_abs*h0_abs + h1_abs*h1_abs);
+            x_re_ptr[0][i] = (h_re_ptr[0][i*2] * y_re[i*2+0] +
+                              h_im_ptr[0][i*2] * y_im[i*2+0] +
+                              h_re_ptr[1][i*2] * y_re[i*2+1] +
+                              h_im_ptr[1][i*2] * y_im[i*2+1]) / h_norm;
+            x_im_ptr[0][i] = (h_re_ptr[0][i*2] * y_im[i*2+0] -
+                              h_im_ptr[0][i*2] * y_re[i*2+0] -
+                              h_re_ptr[1][i*2] * y_im[i*2+1] +
+                              h_im_ptr[1][i*2] * y_re[i*2+1]) / h_norm;
+            x_re_ptr[1][i] = (-h_re_ptr[1][i*2] * y_re[i*2+0] -
+                              h_im_ptr[1][i*2] * y_im[i*2+0] +
+                              h_re_ptr[0][i*2] * y_re[i*2+1] +
+                              h_im_ptr[0][i*2] * y_im[i*2+1]) / h_norm;
+            x_im_ptr[1][i] = (h_re_ptr[1][i*2] * y_im[i*2+0] -
+                              h_im_ptr[1][i*2] * y_re[i*2+0] +
+                              h_re_ptr[0][i*2] * y_im[i*2+1] -
+                              h_im_ptr[0][i*2] * y_re[i*2+1]) / h_norm;
         }
-        for(i=0; i<timing_struct->n_corr_peaks; i++)
+    }else{ // N_ant == 4
+        // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
+        *M_layer_symb = M_ap_symb/4;
+        for(i=0; i<*M_layer_symb; i++)
         {
-            // FIXME: No integer offset is calculated
-            timing_struct->freq_offset[i] = freq_err[i]/N_slots;
+            h0_abs         = (h_re_ptr[0][i*4+0] * h_re_ptr[0][i*4+0] +
+                              h_im_ptr[0][i*4+0] * h_im_ptr[0][i*4+0]);
+            h1_abs         = (h_re_ptr[1][i*4+2] * h_re_ptr[1][i*4+2] +
+                              h_im_ptr[1][i*4+2] * h_im_ptr[1][i*4+2]);
+            h2_abs         = (h_re_ptr[2][i*4+0] * h_re_ptr[2][i*4+0] +
+                              h_im_ptr[2][i*4+0] * h_im_ptr[2][i*4+0]);
+            h3_abs         = (h_re_ptr[3][i*4+2] * h_re_ptr[3][i*4+2] +
+                              h_im_ptr[3][i*4+2] * h_im_ptr[3][i*4+2]);
+            h_norm_0_2     = sqrt(h0_abs*h0_abs + h2_abs*h2_abs);
+            h_norm_1_3     = sqrt(h1_abs*h1_abs + h3_abs*h3_abs);
+            x_re_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_re[i*4+0] +
+                              h_im_ptr[0][i*4+0] * y_im[i*4+0] +
+                              h_re_ptr[2][i*4+0] * y_re[i*4+1] +
+                              h_im_ptr[2][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
+            x_im_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_im[i*4+0] -
+                              h_im_ptr[0][i*4+0] * y_re[i*4+0] -
+                              h_re_ptr[2][i*4+0] * y_im[i*4+1] +
+                              h_im_ptr[2][i*4+0] * y_re[i*4+1]) / h_norm_0_2;
+            x_re_ptr[1][i] = (-h_re_ptr[2][i*4+0] * y_re[i*4+0] -
+                              h_im_ptr[2][i*4+0] * y_im[i*4+0] +
+                              h_re_ptr[0][i*4+0] * y_re[i*4+1] +
+                              h_im_ptr[0][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
+            x_im_ptr[1][i] = -(-h_re_ptr[2][i*4+0] * y_im[i*4+0] +
+                               h_im_ptr[2][i*4+0] * y_re[i*4+0] -
+                               h_re_ptr[0][i*4+0] * y_im[i*4+1] +
+                               h_im_ptr[0][i*4+0] * y_re[i*4+1]) / h_norm_0_2;
+            x_re_ptr[2][i] = (h_re_ptr[1][i*4+2] * y_re[i*4+2] +
+                              h_im_ptr[1][i*4+2] * y_im[i*4+2] +
+                              h_re_ptr[3][i*4+2] * y_re[i*4+3] +
+                              h_im_ptr[3][i*4+2] * y_im[i*4+3]) / h_norm_1_3;
+            x_im_ptr[2][i] = (h_re_ptr[1][i*4+2] * y_im[i*4+2] -
+                              h_im_ptr[1][i*4+2] * y_re[i*4+2] -
+                              h_re_ptr[3][i*4+2] * y_im[i*4+3] +
+                              h_im_ptr[3][i*4+2] * y_re[i*4+3]) / h_norm_1_3;
+            x_re_ptr[3][i] = (-h_re_ptr[3][i*4+2] * y_re[i*4+2] -
+                              h_im_ptr[3][i*4+2] * y_im[i*4+2] +
+                              h_re_ptr[1][i*4+2] * y_re[i*4+3] +
+                              h_im_ptr[1][i*4+2] * y_im[i*4+3]) / h_norm_1_3;
+            x_im_ptr[3][i] = -(-h_re_ptr[3][i*4+2] * y_im[i*4+2] +
+                               h_im_ptr[3][i*4+2] * y_re[i*4+2] -
+                               h_re_ptr[1][i*4+2] * y_im[i*4+3] +
+                               h_im_ptr[1][i*4+2] * y_re[i*4+3]) / h_norm_1_3;
         }
-
-        // Determine the symbol start locations
-        for(i=0; i<timing_struct->n_corr_peaks; i++)
+        if((M_ap_symb % 4) != 0)
         {
-            while(abs_corr_idx[i] > 0)
-            {
-                abs_corr_idx[i] -= N_samps_per_symb_else;
-            }
-            for(j=0; j<7; j++)
-            {
-                timing_struct->symb_starts[i][j] = abs_corr_idx[i] + ((j+1)*N_samps_per_symb_else);
-            }
+            *M_layer_symb  = (M_ap_symb+2)/4;
+            h0_abs         = (h_re_ptr[0][i*4+0] * h_re_ptr[0][i*4+0] +
+                              h_im_ptr[0][i*4+0] * h_im_ptr[0][i*4+0]);
+            h2_abs         = (h_re_ptr[2][i*4+0] * h_re_ptr[2][i*4+0] +
+                              h_im_ptr[2][i*4+0] * h_im_ptr[2][i*4+0]);
+            h_norm_0_2     = sqrt(h0_abs*h0_abs + h2_abs*h2_abs);
+            x_re_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_re[i*4+0] +
+                              h_im_ptr[0][i*4+0] * y_im[i*4+0] +
+                              h_re_ptr[2][i*4+0] * y_re[i*4+1] +
+                              h_im_ptr[2][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
+            x_im_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_im[i*4+0] -
+                              h_im_ptr[0][i*4+0] * y_re[i*4+0] -
+                              h_re_ptr[2][i*4+0] * y_im[i*4+1] +
+                              h_im_ptr[2][i*4+0] * y_re[i*4+1]) / h_norm_0_2;
+            x_re_ptr[1][i] = (-h_re_ptr[2][i*4+0] * y_re[i*4+0] -
+                              h_im_ptr[2][i*4+0] * y_im[i*4+0] +
+                              h_re_ptr[0][i*4+0] * y_re[i*4+1] +
+                              h_im_ptr[0][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
+            x_im_ptr[1][i] = (-h_re_ptr[2][i*4+0] * y_im[i*4+0] +
+                              h_im_ptr[2][i*4+0] * y_re[i*4+0] -
+                              h_re_ptr[0][i*4+0] * y_re[i*4+1] +
+                              h_im_ptr[0][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
+            x_re_ptr[2][i] = RX_NULL_SYMB;
+            x_im_ptr[2][i] = RX_NULL_SYMB;
+            x_re_ptr[3][i] = RX_NULL_SYMB;
+            x_im_ptr[3][i] = RX_NULL_SYMB;
         }
-
-        err = LIBLTE_SUCCESS;
     }
-
-    return(err);
 }
 
 /*********************************************************************
-    Name: liblte_phy_create_dl_subframe
+    Name: pcfich_channel_map
 
-    Description: Creates the baseband signal for a particular
-                 downlink subframe
+    Description: Channel maps the PCFICH
 
-    Document Reference: 3GPP TS 36.211 v10.1.0
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.7
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_create_dl_subframe(LIBLTE_PHY_STRUCT          *phy_struct,
-                                                LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
-                                                uint8                       ant,
-                                                float                      *i_samps,
-                                                float                      *q_samps)
+void pcfich_channel_map(LIBLTE_PHY_STRUCT          *phy_struct,
+                        LIBLTE_PHY_PCFICH_STRUCT   *pcfich,
+                        uint32                      N_id_cell,
+                        uint8                       N_ant,
+                        LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
-    uint32            idx     = 0;
-    uint32            N_samps = 0;
+    uint32 N_bits;
+    uint32 M_symb;
+    uint32 M_layer_symb;
+    uint32 M_ap_symb;
+    uint32 c_init;
+    uint32 k_hat;
+    uint32 i;
+    uint32 j;
+    uint32 p;
+    uint32 idx;
 
-    if(phy_struct != NULL &&
-       subframe   != NULL &&
-       i_samps    != NULL &&
-       q_samps    != NULL)
+    // Encode, 3GPP TS 36.211 v10.1.0 section 6.7
+    cfi_channel_encode(phy_struct,
+                       pcfich->cfi,
+                       phy_struct->pdcch_encode_bits,
+                       &N_bits);
+    c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
+    generate_prs_c(c_init, N_bits, phy_struct->pdcch_c);
+    for(i=0; i<N_bits; i++)
     {
-        // Modulate symbols
-        for(i=0; i<14; i++)
+        phy_struct->pdcch_scramb_bits[i] = phy_struct->pdcch_encode_bits[i] ^ phy_struct->pdcch_c[i];
+    }
+    modulation_mapper(phy_struct->pdcch_scramb_bits,
+                      N_bits,
+                      LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                      phy_struct->pdcch_d_re,
+                      phy_struct->pdcch_d_im,
+                      &M_symb);
+    layer_mapper_dl(phy_struct->pdcch_d_re,
+                    phy_struct->pdcch_d_im,
+                    M_symb,
+                    N_ant,
+                    1,
+                    LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                    phy_struct->pdcch_x_re,
+                    phy_struct->pdcch_x_im,
+                    &M_layer_symb);
+    pre_coder_dl(phy_struct->pdcch_x_re,
+                 phy_struct->pdcch_x_im,
+                 M_layer_symb,
+                 N_ant,
+                 LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                 phy_struct->pdcch_y_re[0],
+                 phy_struct->pdcch_y_im[0],
+                 LIBLTE_PHY_PDCCH_N_BITS_MAX / 2,
+                 &M_ap_symb);
+    // Map the symbols to resource elements, 3GPP TS 36.211 v10.1.0 section 6.7.4
+    pcfich->N_reg = 4;
+    k_hat         = (phy_struct->N_sc_rb_dl/2)*(N_id_cell % (2*phy_struct->N_rb_dl));
+    for(i=0; i<pcfich->N_reg; i++)
+    {
+        pcfich->k[i] = (k_hat + (i*phy_struct->N_rb_dl/2)*phy_struct->N_sc_rb_dl/2) % (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl);
+        pcfich->n[i] = (pcfich->k[i]/6) - 0.5;
+        for(p=0; p<N_ant; p++)
         {
-            idx += N_samps;
-            symbols_to_samples_dl(phy_struct,
-                                  &subframe->tx_symb_re[ant][i][0],
-                                  &subframe->tx_symb_im[ant][i][0],
-                                  i,
-                                  &i_samps[idx],
-                                  &q_samps[idx],
-                                  &N_samps);
+            idx = 0;
+            for(j=0; j<6; j++)
+            {
+                if((N_id_cell % 3) != (j % 3))
+                {
+                    liblte_phy_set_tx_symb(subframe, p, 0, pcfich->k[i]+j, phy_struct->pdcch_y_re[p][idx+(i*4)], phy_struct->pdcch_y_im[p][idx+(i*4)]);
+                    idx++;
+                }
+            }
         }
-
-        err = LIBLTE_SUCCESS;
     }
-
-    return(err);
 }
 
 /*********************************************************************
-    Name: liblte_phy_get_dl_subframe_and_ce
+    Name: pcfich_channel_demap
 
-    Description: Resolves all symbols and channel estimates for a
-                 particular downlink subframe
+    Description: Channel demaps the PCFICH
 
-    Document Reference: 3GPP TS 36.211 v10.1.0
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.7
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_get_dl_subframe_and_ce(LIBLTE_PHY_STRUCT          *phy_struct,
-                                                    float                      *i_samps,
-                                                    float                      *q_samps,
-                                                    uint32                      frame_start_idx,
-                                                    uint8                       subfr_num,
-                                                    uint32                      N_id_cell,
-                                                    uint8                       N_ant,
-                                                    LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
+                          LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                          uint32                      N_id_cell,
+                          uint8                       N_ant,
+                          LIBLTE_PHY_PCFICH_STRUCT   *pcfich,
+                          uint32                     *N_bits)
 {
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
-    float             *sym_re;
-    float             *sym_im;
-    float             *rs_re;
-    float             *rs_im;
-    float              tmp_re;
-    float              tmp_im;
-    float              frac_mag = 0;
-    float              frac_ang = 0;
-    float              ce_mag;
-    float              ce_ang;
-    uint32             v_shift         = N_id_cell % 6;
-    uint32             subfr_start_idx = frame_start_idx + subfr_num*phy_struct->N_samps_per_subfr;
-    uint32             N_sym;
-    uint32             m_prime;
-    uint32             i;
-    uint32             j;
-    uint32             k = 0;
-    uint32             p;
-    uint32             v[5];
-    uint32             sym[5];
-    uint32             z;
+    uint32 M_layer_symb;
+    uint32 M_symb;
+    uint32 c_init;
+    uint32 k_hat;
+    uint32 i;
+    uint32 j;
+    uint32 p;
+    uint32 idx;
 
-    if(phy_struct != NULL &&
-       i_samps    != NULL &&
-       q_samps    != NULL &&
-       (N_ant     == 1    ||
-        N_ant     == 2    ||
-        N_ant     == 4)   &&
-       subframe   != NULL)
+    // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.7.4
+    pcfich->N_reg = 4;
+    k_hat         = (phy_struct->N_sc_rb_dl/2)*(N_id_cell % (2*phy_struct->N_rb_dl));
+    for(i=0; i<pcfich->N_reg; i++)
     {
-        subframe->num = subfr_num;
-        for(i=0; i<16; i++)
-        {
-            // Demodulate symbols
-            samples_to_symbols_dl(phy_struct,
-                                  i_samps,
-                                  q_samps,
-                                  subfr_start_idx + (i/7)*phy_struct->N_samps_per_slot,
-                                  i%7,
-                                  0,
-                                  &subframe->rx_symb_re[i][0],
-                                  &subframe->rx_symb_im[i][0]);
-        }
-
-        // Generate cell specific reference signals
-        generate_crs((subfr_num*2+0)%20, 0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[0],  phy_struct->dl_ce_crs_im[0]);
-        generate_crs((subfr_num*2+0)%20, 1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[1],  phy_struct->dl_ce_crs_im[1]);
-        generate_crs((subfr_num*2+0)%20, 4, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[4],  phy_struct->dl_ce_crs_im[4]);
-        generate_crs((subfr_num*2+1)%20, 0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[7],  phy_struct->dl_ce_crs_im[7]);
-        generate_crs((subfr_num*2+1)%20, 1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[8],  phy_struct->dl_ce_crs_im[8]);
-        generate_crs((subfr_num*2+1)%20, 4, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[11], phy_struct->dl_ce_crs_im[11]);
-        generate_crs((subfr_num*2+2)%20, 0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[14], phy_struct->dl_ce_crs_im[14]);
-        generate_crs((subfr_num*2+2)%20, 1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->dl_ce_crs_re[15], phy_struct->dl_ce_crs_im[15]);
+        pcfich->k[i] = (k_hat + (i*phy_struct->N_rb_dl/2)*phy_struct->N_sc_rb_dl/2) % (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl);
+        pcfich->n[i] = (pcfich->k[i]/6) - 0.5;
 
-        // Determine channel estimates
-        for(p=0; p<N_ant; p++)
+        // Extract resource elements and channel estimate
+        idx = 0;
+        for(j=0; j<6; j++)
         {
-            // Define v, sym, and N_sym
-            if(p == 0)
-            {
-                v[0]   = 0;
-                v[1]   = 3;
-                v[2]   = 0;
-                v[3]   = 3;
-                v[4]   = 0;
-                sym[0] = 0;
-                sym[1] = 4;
-                sym[2] = 7;
-                sym[3] = 11;
-                sym[4] = 14;
-                N_sym  = 5;
-            }else if(p == 1){
-                v[0]   = 3;
-                v[1]   = 0;
-                v[2]   = 3;
-                v[3]   = 0;
-                v[4]   = 3;
-                sym[0] = 0;
-                sym[1] = 4;
-                sym[2] = 7;
-                sym[3] = 11;
-                sym[4] = 14;
-                N_sym  = 5;
-            }else if(p == 2){
-                v[0]   = 0;
-                v[1]   = 3;
-                v[2]   = 0;
-                sym[0] = 1;
-                sym[1] = 8;
-                sym[2] = 15;
-                N_sym  = 3;
-            }else{ // p == 3
-                v[0]   = 3;
-                v[1]   = 6;
-                v[2]   = 3;
-                sym[0] = 1;
-                sym[1] = 8;
-                sym[2] = 15;
-                N_sym  = 3;
-            }
-
-            for(i=0; i<N_sym; i++)
-            {
-                sym_re = &subframe->rx_symb_re[sym[i]][0];
-                sym_im = &subframe->rx_symb_im[sym[i]][0];
-                rs_re  = &phy_struct->dl_ce_crs_re[sym[i]][0];
-                rs_im  = &phy_struct->dl_ce_crs_im[sym[i]][0];
-
-                for(j=0; j<2*phy_struct->N_rb_dl; j++)
-                {
-                    k                           = 6*j + (v[i] + v_shift)%6;
-                    m_prime                     = j + LIBLTE_PHY_N_RB_DL_MAX - phy_struct->N_rb_dl;
-                    tmp_re                      = sym_re[k]*rs_re[m_prime] + sym_im[k]*rs_im[m_prime];
-                    tmp_im                      = sym_im[k]*rs_re[m_prime] - sym_re[k]*rs_im[m_prime];
-                    phy_struct->dl_ce_mag[i][k] = sqrt(tmp_re*tmp_re + tmp_im*tmp_im);
-                    phy_struct->dl_ce_ang[i][k] = atan2f(tmp_im, tmp_re);
-
-                    // Unwrap phase
-                    if(j > 0)
-                    {
-                        wrap_phase(&phy_struct->dl_ce_ang[i][k], phy_struct->dl_ce_ang[i][k-6]);
-
-                        // Linearly interpolate between CRSs
-                        frac_mag = (phy_struct->dl_ce_mag[i][k] - phy_struct->dl_ce_mag[i][k-6])/6;
-                        frac_ang = (phy_struct->dl_ce_ang[i][k] - phy_struct->dl_ce_ang[i][k-6])/6;
-                        for(z=1; z<6; z++)
-                        {
-                            phy_struct->dl_ce_mag[i][k-z] = phy_struct->dl_ce_mag[i][k-(z-1)] - frac_mag;
-                            phy_struct->dl_ce_ang[i][k-z] = phy_struct->dl_ce_ang[i][k-(z-1)] - frac_ang;
-                        }
-                    }
-
-                    // Linearly interpolate before 1st CRS
-                    if(j == 1)
-                    {
-                        for(z=1; z<((v[i] + v_shift)%6)+1; z++)
-                        {
-                            phy_struct->dl_ce_mag[i][k-6-z] = phy_struct->dl_ce_mag[i][k-6-(z-1)] - frac_mag;
-                            phy_struct->dl_ce_ang[i][k-6-z] = phy_struct->dl_ce_ang[i][k-6-(z-1)] - frac_ang;
-                        }
-                    }
-                }
-
-                // Linearly interpolate after last CRS
-                for(z=1; z<(5-(v[i] + v_shift)%6)+1; z++)
-                {
-                    phy_struct->dl_ce_mag[i][k+z] = phy_struct->dl_ce_mag[i][k+(z-1)] - frac_mag;
-                    phy_struct->dl_ce_ang[i][k+z] = phy_struct->dl_ce_ang[i][k+(z-1)] - frac_ang;
-                }
-            }
-
-            // Linearly interpolate between symbols to construct all channel estimates
-            if(N_sym == 3)
+            if((N_id_cell % 3) != (j % 3))
             {
-                for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
-                {
-                    // Construct symbol 1 and 8 channel estimates directly
-                    subframe->rx_ce_re[p][1][j] = phy_struct->dl_ce_mag[0][j]*cosf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_im[p][1][j] = phy_struct->dl_ce_mag[0][j]*sinf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_re[p][8][j] = phy_struct->dl_ce_mag[1][j]*cosf(phy_struct->dl_ce_ang[1][j]);
-                    subframe->rx_ce_im[p][8][j] = phy_struct->dl_ce_mag[1][j]*sinf(phy_struct->dl_ce_ang[1][j]);
-
-                    // Interpolate for symbol 2, 3, 4, 5, 6, and 7 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[1][j] - phy_struct->dl_ce_mag[0][j])/7;
-                    wrap_phase(&phy_struct->dl_ce_ang[1][j], phy_struct->dl_ce_ang[0][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[1][j] - phy_struct->dl_ce_ang[0][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 7;
-                    ce_mag    = phy_struct->dl_ce_mag[1][j];
-                    ce_ang    = phy_struct->dl_ce_ang[1][j];
-                    for(z=7; z>1; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-
-                    // Interpolate for symbol 0 channel estimate
-                    // FIXME: Use previous slot to do this correctly
-                    ce_mag                      = phy_struct->dl_ce_mag[0][j] - frac_mag;
-                    ce_ang                      = phy_struct->dl_ce_ang[0][j] - frac_ang;
-                    subframe->rx_ce_re[p][0][j] = ce_mag*cosf(ce_ang);
-                    subframe->rx_ce_im[p][0][j] = ce_mag*sinf(ce_ang);
-
-                    // Interpolate for symbol 9, 10, 11, 12, and 13 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[2][j] - phy_struct->dl_ce_mag[1][j])/7;
-                    wrap_phase(&phy_struct->dl_ce_ang[2][j], phy_struct->dl_ce_ang[1][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[2][j] - phy_struct->dl_ce_ang[1][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 7;
-                    ce_mag    = phy_struct->dl_ce_mag[2][j] - frac_mag;
-                    ce_ang    = phy_struct->dl_ce_ang[2][j] - frac_ang;
-                    for(z=13; z>8; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-                }
-            }else{
-                for(j=0; j<phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl; j++)
+                phy_struct->pdcch_y_est_re[idx+(i*4)] = liblte_phy_rx_symb_re(subframe, 0, pcfich->k[i]+j);
+                phy_struct->pdcch_y_est_im[idx+(i*4)] = liblte_phy_rx_symb_im(subframe, 0, pcfich->k[i]+j);
+                for(p=0; p<N_ant; p++)
                 {
-                    // Construct symbol 0, 4, 7, and 11 channel estimates directly
-                    subframe->rx_ce_re[p][0][j]  = phy_struct->dl_ce_mag[0][j]*cosf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_im[p][0][j]  = phy_struct->dl_ce_mag[0][j]*sinf(phy_struct->dl_ce_ang[0][j]);
-                    subframe->rx_ce_re[p][4][j]  = phy_struct->dl_ce_mag[1][j]*cosf(phy_struct->dl_ce_ang[1][j]);
-                    subframe->rx_ce_im[p][4][j]  = phy_struct->dl_ce_mag[1][j]*sinf(phy_struct->dl_ce_ang[1][j]);
-                    subframe->rx_ce_re[p][7][j]  = phy_struct->dl_ce_mag[2][j]*cosf(phy_struct->dl_ce_ang[2][j]);
-                    subframe->rx_ce_im[p][7][j]  = phy_struct->dl_ce_mag[2][j]*sinf(phy_struct->dl_ce_ang[2][j]);
-                    subframe->rx_ce_re[p][11][j] = phy_struct->dl_ce_mag[3][j]*cosf(phy_struct->dl_ce_ang[3][j]);
-                    subframe->rx_ce_im[p][11][j] = phy_struct->dl_ce_mag[3][j]*sinf(phy_struct->dl_ce_ang[3][j]);
-
-                    // Interpolate for symbol 1, 2, and 3 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[1][j] - phy_struct->dl_ce_mag[0][j])/4;
-                    wrap_phase(&phy_struct->dl_ce_ang[1][j], phy_struct->dl_ce_ang[0][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[1][j] - phy_struct->dl_ce_ang[0][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 4;
-                    ce_mag    = phy_struct->dl_ce_mag[1][j];
-                    ce_ang    = phy_struct->dl_ce_ang[1][j];
-                    for(z=3; z>0; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-
-                    // Interpolate for symbol 5 and 6 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[2][j] - phy_struct->dl_ce_mag[1][j])/3;
-                    wrap_phase(&phy_struct->dl_ce_ang[2][j], phy_struct->dl_ce_ang[1][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[2][j] - phy_struct->dl_ce_ang[1][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 3;
-                    ce_mag    = phy_struct->dl_ce_mag[2][j];
-                    ce_ang    = phy_struct->dl_ce_ang[2][j];
-                    for(z=6; z>4; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-
-                    // Interpolate for symbol 8, 9, and 10 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[3][j] - phy_struct->dl_ce_mag[2][j])/4;
-                    wrap_phase(&phy_struct->dl_ce_ang[3][j], phy_struct->dl_ce_ang[2][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[3][j] - phy_struct->dl_ce_ang[2][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 4;
-                    ce_mag    = phy_struct->dl_ce_mag[3][j];
-                    ce_ang    = phy_struct->dl_ce_ang[3][j];
-                    for(z=10; z>7; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
-
-                    // Interpolate for symbol 12 and 13 channel estimates
-                    frac_mag = (phy_struct->dl_ce_mag[4][j] - phy_struct->dl_ce_mag[3][j])/3;
-                    wrap_phase(&phy_struct->dl_ce_ang[4][j], phy_struct->dl_ce_ang[3][j]);
-                    frac_ang = (phy_struct->dl_ce_ang[4][j] - phy_struct->dl_ce_ang[3][j]);
-                    wrap_phase(&frac_ang, 0);
-                    frac_ang /= 3;
-                    ce_mag    = phy_struct->dl_ce_mag[4][j];
-                    ce_ang    = phy_struct->dl_ce_ang[4][j];
-                    for(z=13; z>11; z--)
-                    {
-                        ce_mag                      -= frac_mag;
-                        ce_ang                      -= frac_ang;
-                        subframe->rx_ce_re[p][z][j]  = ce_mag*cosf(ce_ang);
-                        subframe->rx_ce_im[p][z][j]  = ce_mag*sinf(ce_ang);
-                    }
+                    phy_struct->pdcch_c_est_re[p][idx+(i*4)] = liblte_phy_rx_ce_re(subframe, p, 0, pcfich->k[i]+j);
+                    phy_struct->pdcch_c_est_im[p][idx+(i*4)] = liblte_phy_rx_ce_im(subframe, p, 0, pcfich->k[i]+j);
                 }
+                idx++;
             }
         }
-
-        err = LIBLTE_SUCCESS;
     }
-
-    return(err);
+    // Decode, 3GPP TS 36.211 v10.1.0 section 6.7
+    c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
+    generate_prs_c(c_init, 32, phy_struct->pdcch_c);
+    pre_decoder_and_matched_filter_dl(phy_struct->pdcch_y_est_re,
+                                      phy_struct->pdcch_y_est_im,
+                                      phy_struct->pdcch_c_est_re[0],
+                                      phy_struct->pdcch_c_est_im[0],
+                                      LIBLTE_PHY_PDCCH_N_BITS_MAX / 2,
+                                      16,
+                                      N_ant,
+                                      LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                                      phy_struct->pdcch_x_re,
+                                      phy_struct->pdcch_x_im,
+                                      &M_layer_symb);
+    layer_demapper_dl(phy_struct->pdcch_x_re,
+                      phy_struct->pdcch_x_im,
+                      M_layer_symb,
+                      N_ant,
+                      1,
+                      LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                      phy_struct->pdcch_d_re,
+                      phy_struct->pdcch_d_im,
+                      &M_symb);
+    modulation_demapper(phy_struct->pdcch_d_re,
+                        phy_struct->pdcch_d_im,
+                        M_symb,
+                        LIBLTE_PHY_MODULATION_TYPE_QPSK,
+                        LLR_DEFAULT_NOISE_VAR,
+                        phy_struct->pdcch_soft_bits,
+                        N_bits);
+    for(i=0; i<*N_bits; i++)
+    {
+        phy_struct->pdcch_descramb_bits[i] = (float)phy_struct->pdcch_soft_bits[i]*(1-2*(float)phy_struct->pdcch_c[i]);
+    }
 }
 
 /*********************************************************************
-    Name: liblte_phy_get_ul_subframe
+    Name: pdcch_permute_pre_calc
 
-    Description: Resolves all symbols for a particular uplink subframe
+    Description: Pre calculates the PDCCH REG permutation for N_symbs
+                 PDCCH symbols and N_reg_pdcch REGs.
 
-    Document Reference: 3GPP TS 36.211 v10.1.0
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.8.5
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_get_ul_subframe(LIBLTE_PHY_STRUCT          *phy_struct,
-                                             float                      *i_samps,
-                                             float                      *q_samps,
-                                             LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+void pdcch_permute_pre_calc(LIBLTE_PHY_STRUCT *phy_struct,
+                            uint32             N_symbs,
+                            uint32             N_reg_pdcch)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            i;
+    uint32 i;
+    uint32 j;
+    uint32 k;
+    uint32 idx;
+    uint32 C_cc_sb;
+    uint32 R_cc_sb;
+    uint32 N_dummy;
+    uint32 K_pi;
 
-    if(phy_struct != NULL &&
-       i_samps    != NULL &&
-       q_samps    != NULL &&
-       subframe   != NULL)
+    for(i=0; i<N_reg_pdcch; i++)
     {
-        for(i=0; i<14; i++)
+        phy_struct->pdcch_reg_vec[i] = i;
+    }
+    // Sub block interleaving
+    // Step 1
+    C_cc_sb = 32;
+    // Step 2
+    R_cc_sb = 0;
+    while(N_reg_pdcch > (C_cc_sb*R_cc_sb))
+    {
+        R_cc_sb++;
+    }
+    // Step 3
+    if(N_reg_pdcch < (C_cc_sb*R_cc_sb))
+    {
+        N_dummy = C_cc_sb*R_cc_sb - N_reg_pdcch;
+    }else{
+        N_dummy = 0;
+    }
+    for(i=0; i<N_dummy; i++)
+    {
+        phy_struct->ruc_tmp[i] = RX_NULL_BIT;
+    }
+    idx = 0;
+    for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
+    {
+        phy_struct->ruc_tmp[i] = phy_struct->pdcch_reg_vec[idx++];
+    }
+    idx = 0;
+    for(i=0; i<R_cc_sb; i++)
+    {
+        for(j=0; j<C_cc_sb; j++)
         {
-            // Demodulate symbols
-            samples_to_symbols_ul(phy_struct,
-                                  i_samps,
-                                  q_samps,
-                                  (i/7)*phy_struct->N_samps_per_slot,
-                                  i%7,
-                                  &subframe->rx_symb_re[i][0],
-                                  &subframe->rx_symb_im[i][0]);
+            phy_struct->ruc_sb_mat[i][j] = phy_struct->ruc_tmp[idx++];
+        }
+    }
+    // Step 4
+    for(i=0; i<R_cc_sb; i++)
+    {
+        for(j=0; j<C_cc_sb; j++)
+        {
+            phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]];
+        }
+    }
+    // Step 5
+    idx = 0;
+    for(j=0; j<C_cc_sb; j++)
+    {
+        for(i=0; i<R_cc_sb; i++)
+        {
+            phy_struct->ruc_w[idx++] = phy_struct->ruc_sb_perm_mat[i][j];
+        }
+    }
+    K_pi = R_cc_sb*C_cc_sb;
+    k    = 0;
+    j    = 0;
+    while(k < N_reg_pdcch)
+    {
+        if(phy_struct->ruc_w[j%K_pi] != RX_NULL_BIT)
+        {
+            phy_struct->pdcch_reg_perm_vec[k++] = phy_struct->ruc_w[j%K_pi];
         }
-
-        err = LIBLTE_SUCCESS;
+        j++;
     }
-
-    return(err);
+    for(i=0; i<N_reg_pdcch; i++)
+    {
+        phy_struct->pdcch_permute_map[N_symbs-1][i] = phy_struct->pdcch_reg_perm_vec[i];
+    }
+    phy_struct->pdcch_permute_N_reg[N_symbs-1] = N_reg_pdcch;
 }
 
 /*********************************************************************
-    Name: liblte_phy_get_tbs_mcs_and_n_prb_for_dl
-
-    Description: Determines the transport block size, modulation and
-                 coding scheme, and the number of PRBs needed to send
-                 the specified number of DL bits
+    Name: pdcch_candidate_decode
 
-    Document Reference: 3GPP TS 36.213 v10.3.0 section 7.1.7
+    Description: Decodes one PDCCH candidate of L CCEs starting at
+                 cce_idx from the cached CCE soft bits.  Candidates
+                 using an empty CCE or a CCE of an already decoded
+                 PDCCH are rejected without decoding.  A ue_rnti of 0
+                 searches for the common search space RNTIs.  Returns
+                 true if an allocation was added.
 
-    NOTES: Currently only supports DCI format 1A
+    Document Reference: 3GPP TS 36.213 v10.3.0 section 9.1.1
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_get_tbs_mcs_and_n_prb_for_dl(uint32  N_bits,
-                                                          uint32  N_subframe,
-                                                          uint32  N_rb_dl,
-                                                          uint16  rnti,
-                                                          uint32 *tbs,
-                                                          uint8  *mcs,
-                                                          uint32 *N_prb)
+bool pdcch_candidate_decode(LIBLTE_PHY_STRUCT       *phy_struct,
+                            uint32                   cce_idx,
+                            uint32                   L,
+                            uint16                   ue_rnti,
+                            uint8                    N_ant,
+                            uint32                   dci_1a_size,
+                            uint32                   dci_1c_size,
+                            LIBLTE_PHY_PDCCH_STRUCT *pdcch)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    LIBLTE_ERROR_ENUM err;
+    uint32            dci_size[2] = {dci_1a_size, dci_1c_size};
+    uint32            N_sizes;
     uint32            i;
-    uint32            j;
-    uint32            code_rate;
-    uint32            N_prb_tmp;
-    uint32            N_bits_per_prb;
-    uint32            I_tbs;
+    uint32            s;
+    uint16            rnti;
+    bool              valid_rnti;
 
-    if(tbs   != NULL &&
-       mcs   != NULL &&
-       N_prb != NULL)
+    phy_struct->pdcch_stats.N_cand_tried++;
+
+    for(i=cce_idx; i<cce_idx+L; i++)
     {
-        if(LIBLTE_MAC_SI_RNTI        == rnti ||
-           LIBLTE_MAC_P_RNTI         == rnti ||
-           (LIBLTE_MAC_RA_RNTI_START <= rnti &&
-            LIBLTE_MAC_RA_RNTI_END   >= rnti))
+        if(phy_struct->pdcch_cce_used[i] ||
+           !phy_struct->pdcch_cce_active[i])
         {
-            // Choose N_prb == 2 to give the largest possible tbs
-            N_prb_tmp = 2;
-            for(i=0; i<27; i++)
-            {
-                if(N_bits <= TBS_71721[i][N_prb_tmp])
-                {
-                    *tbs = TBS_71721[i][N_prb_tmp];
-                    *mcs = i;
-                    break;
-                }
-            }
+            return(false);
+        }
+    }
 
-            // Target coding rate is 4:1, will allow down to 3:1
-            N_bits_per_prb = get_num_bits_in_prb(N_subframe, 3, N_rb_dl/2, N_rb_dl, 2, LIBLTE_PHY_MODULATION_TYPE_QPSK);
-            *N_prb         = 0;
-            for(code_rate=4; code_rate>2; code_rate--)
-            {
-                for(i=1; i<=N_rb_dl; i++)
-                {
-                    if((*tbs * code_rate) < (N_bits_per_prb*i))
-                    {
-                        *N_prb = i;
-                        break;
-                    }
-                }
-                if(*N_prb != 0)
-                {
-                    break;
-                }
-            }
-            if(*N_prb != 0)
+    // DCI 1C is only sent in the common search space
+    N_sizes = (0 == ue_rnti) ? 2 : 1;
+    for(s=0; s<N_sizes; s++)
+    {
+        if(pdcch->N_alloc >= LIBLTE_PHY_PDCCH_MAX_ALLOC)
+        {
+            break;
+        }
+
+        // One decode recovers the RNTI from the CRC, which is then
+        // checked against every RNTI being searched for
+        phy_struct->pdcch_stats.N_cand_decoded++;
+        if(LIBLTE_SUCCESS != dci_channel_decode(phy_struct,
+                                                &phy_struct->pdcch_cce_soft_bits[cce_idx*LIBLTE_PHY_PDCCH_N_BITS_CCE],
+                                                L*LIBLTE_PHY_PDCCH_N_BITS_CCE,
+                                                1,
+                                                0xFFFF,
+                                                0,
+                                                phy_struct->pdcch_dci,
+                                                dci_size[s],
+                                                &rnti))
+        {
+            continue;
+        }
+        if(0 == ue_rnti)
+        {
+            valid_rnti = (LIBLTE_MAC_SI_RNTI        == rnti ||
+                          LIBLTE_MAC_P_RNTI         == rnti ||
+                          (LIBLTE_MAC_RA_RNTI_START <= rnti &&
+                           LIBLTE_MAC_RA_RNTI_END   >= rnti));
+            for(i=0; i<phy_struct->pdcch_N_ue_rntis && 0 == s; i++)
             {
-                err = LIBLTE_SUCCESS;
+                valid_rnti |= (phy_struct->pdcch_ue_rntis[i] == rnti);
             }
         }else{
-            *N_prb = 0;
-            for(i=0; i<27; i++)
-            {
-                for(j=0; j<N_rb_dl; j++)
-                {
-                    if(N_bits <= TBS_71721[i][j])
-                    {
-                        *tbs   = TBS_71721[i][j];
-                        I_tbs  = i;
-                        *N_prb = j + 1;
-                        break;
-                    }
-                }
-                if(*N_prb != 0)
-                {
-                    if(9 >= I_tbs)
-                    {
-                        *mcs = I_tbs;
-                    }else if(15 >= I_tbs){
-                        *mcs = I_tbs + 1;
-                    }else{
-                        *mcs = I_tbs + 2;
-                    }
-                    break;
-                }
-            }
-            if(*N_prb != 0)
+            valid_rnti = (ue_rnti == rnti);
+        }
+        if(!valid_rnti)
+        {
+            continue;
+        }
+
+        // These CCEs carry this PDCCH, so no other candidate can use them
+        for(i=cce_idx; i<cce_idx+L; i++)
+        {
+            phy_struct->pdcch_cce_used[i] = true;
+        }
+
+        if(0 == s)
+        {
+            // DCI 0 has the same size as DCI 1A
+            if(DCI_0_1A_FLAG_0 == phy_struct->pdcch_dci[0])
             {
-                err = LIBLTE_SUCCESS;
+                return(false);
             }
+            err = dci_1a_unpack(phy_struct->pdcch_dci,
+                                dci_1a_size,
+                                LIBLTE_PHY_DCI_CA_NOT_PRESENT,
+                                rnti,
+                                phy_struct->N_rb_dl,
+                                N_ant,
+                                &pdcch->alloc[pdcch->N_alloc]);
+        }else{
+            err = dci_1c_unpack(phy_struct->pdcch_dci,
+                                dci_1c_size,
+                                rnti,
+                                phy_struct->N_rb_dl,
+                                N_ant,
+                                &pdcch->alloc[pdcch->N_alloc]);
         }
+        if(LIBLTE_SUCCESS == err)
+        {
+            pdcch->N_alloc++;
+            return(true);
+        }
+        return(false);
     }
 
-    return(err);
+    return(false);
 }
 
 /*********************************************************************
-    Name: liblte_phy_get_tbs_and_n_prb_for_dl
-
-    Description: Determines the transport block size and the number of
-                 PRBs needed to send the specified number of DL bits
-                 according to the specified modulation and coding
-                 scheme
+    Name: phich_channel_map
 
-    Document Reference: 3GPP TS 36.213 v10.3.0 section 7.1.7
+    Description: Channel maps the PHICH
 
-    NOTES: Currently only supports single layer transport blocks
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.9
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_get_tbs_and_n_prb_for_dl(uint32  N_bits,
-                                                      uint32  N_rb_dl,
-                                                      uint8   mcs,
-                                                      uint32 *tbs,
-                                                      uint32 *N_prb)
+void phich_channel_map(LIBLTE_PHY_STRUCT              *phy_struct,
+                       LIBLTE_PHY_PHICH_STRUCT        *phich,
+                       LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
+                       uint32                          N_id_cell,
+                       uint8                           N_ant,
+                       float                           phich_res,
+                       LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
+                       LIBLTE_PHY_SUBFRAME_STRUCT     *subframe)
 {
-    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            I_tbs;
-    uint32            i;
+    uint32  m_prime;
+    uint32  l_prime;
+    uint32  n_l_prime;
+    uint32  n_hat[3];
+    uint32  M_symb;
+    uint32  M_layer_symb;
+    uint32  M_ap_symb;
+    uint32  c_init;
+    uint32  seq;
+    uint32  i;
+    uint32  j;
+    uint32  p;
+    uint32  idx;
+    uint32  w_idx;
+    uint32  y_idx;
+    uint32  z_idx;
+    uint8  *bit_seq;
+    uint8   ack_seq[3]  = {1, 1, 1};
+    uint8   nack_seq[3] = {0, 0, 0};
 
-    if(tbs   != NULL &&
-       N_prb != NULL &&
-       mcs   <= 28)
+    // Determine the number of REGs
+    phich->N_reg = phy_struct->N_group_phich*3;
+
+    c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
+    generate_prs_c(c_init, 12, phy_struct->pdcch_c);
+    idx = 0;
+    for(m_prime=0; m_prime<phy_struct->N_group_phich; m_prime++)
     {
-        // Determine I_tbs
-        if(9 >= mcs)
+        for(i=0; i<12; i++)
         {
-            I_tbs = mcs;
-        }else if(16 >= mcs){
-            I_tbs = mcs - 1;
-        }else{
-            I_tbs = mcs - 2;
+            phy_struct->pdcch_d_re[i] = 0;
+            phy_struct->pdcch_d_im[i] = 0;
+        }
+        for(seq=0; seq<8; seq++) // FIXME: Only handling normal CP
+        {
+            if(phich->present[m_prime][seq])
+            {
+                if(phich->b[m_prime][seq])
+                {
+                    bit_seq = ack_seq;
+                }else{
+                    bit_seq = nack_seq;
+                }
+                modulation_mapper(bit_seq,
+                                  3,
+                                  LIBLTE_PHY_MODULATION_TYPE_BPSK,
+                                  phich->z_re,
+                                  phich->z_im,
+                                  &M_symb);
+                for(i=0; i<(3 * phy_struct->N_sf_phich); i++)
+                {
+                    w_idx = i % phy_struct->N_sf_phich;
+                    z_idx = i / phy_struct->N_sf_phich;
+                    if(phy_struct->pdcch_c[i] == 1)
+                    {
+                        phy_struct->pdcch_d_re[i] += PHICH_w_re_normal_cp_6_9_1_2[seq][w_idx]*(-phich->z_re[z_idx]) - PHICH_w_im_normal_cp_6_9_1_2[seq][w_idx]*(-phich->z_im[z_idx]);
+                        phy_struct->pdcch_d_im[i] += PHICH_w_re_normal_cp_6_9_1_2[seq][w_idx]*(-phich->z_im[z_idx]) + PHICH_w_im_normal_cp_6_9_1_2[seq][w_idx]*(-phich->z_re[z_idx]);
+                    }else{
+                        phy_struct->pdcch_d_re[i] += PHICH_w_re_normal_cp_6_9_1_2[seq][w_idx]*phich->z_re[z_idx] - PHICH_w_im_normal_cp_6_9_1_2[seq][w_idx]*phich->z_im[z_idx];
+                        phy_struct->pdcch_d_im[i] += PHICH_w_re_normal_cp_6_9_1_2[seq][w_idx]*phich->z_im[z_idx] + PHICH_w_im_normal_cp_6_9_1_2[seq][w_idx]*phich->z_re[z_idx];
+                    }
+                }
+            }
         }
+        layer_mapper_dl(phy_struct->pdcch_d_re,
+                        phy_struct->pdcch_d_im,
+                        3 * phy_struct->N_sf_phich,
+                        N_ant,
+                        1,
+                        LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                        phy_struct->pdcch_x_re,
+                        phy_struct->pdcch_x_im,
+                        &M_layer_symb);
+        // FIXME: Pre coder for 4 antennas is not correct
+        pre_coder_dl(phy_struct->pdcch_x_re,
+                     phy_struct->pdcch_x_im,
+                     M_layer_symb,
+                     N_ant,
+                     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
+                     phy_struct->pdcch_y_re[0],
+                     phy_struct->pdcch_y_im[0],
+                     LIBLTE_PHY_PDCCH_N_BITS_MAX / 2,
+                     &M_ap_symb);
 
-        // Determine N_prb
-        for(i=0; i<N_rb_dl; i++)
+        // Map the group
+        if(LIBLTE_RRC_PHICH_DURATION_NORMAL == phich_dur)
         {
-            if(N_bits <= TBS_71721[I_tbs][i])
+            // Step 7
+            l_prime = 0;
+            // Step 1, 2, and 3
+            n_l_prime = phy_struct->N_rb_dl*2 - pcfich->N_reg;
+            // Step 8
+            for(i=0; i<3; i++)
+            {
+                n_hat[i] = (N_id_cell + m_prime + i*n_l_prime/3) % n_l_prime;
+            }
+            // Avoid PCFICH
+            for(i=0; i<pcfich->N_reg; i++)
+            {
+                for(j=0; j<3; j++)
+                {
+                    if(n_hat[j] > pcfich->n[i])
+                    {
+                        n_hat[j]++;
+                    }
+                }
+            }
+            // Step 5
+            y_idx = 0;
+            for(i=0; i<3; i++)
             {
-                *tbs   = TBS_71721[I_tbs][i];
-                *N_prb = i + 1;
-                break;
+                phich->k[idx+i] = n_hat[i]*6;
+                for(p=0; p<N_ant; p++)
+                {
+                    for(j=0; j<6; j++)
+                    {
+                        if((N_id_cell % 3) != (j % 3))
+                        {
+                            liblte_phy_set_tx_symb(subframe, p, 0, phich->k[idx+i]+j, phy_struct->pdcch_y_re[p][y_idx], phy_struct->pdcch_y_im[p][y_idx]);
+                            y_idx++;
+                        }
+                    }
+                }
             }
+        }else{
+            // FIXME: Not handling extended PHICH duration
         }
-
-        err = LIBLTE_SUCCESS;
+        idx += 3;
     }
-
-    return(err);
 }
 
 /*********************************************************************
-    Name: liblte_phy_get_tbs_mcs_and_n_prb_for_ul
+    Name: phich_channel_demap
 
-    Description: Determines the transport block size, modulation and
-                 coding scheme, and the number of PRBs needed to send
-                 the specified number of UL bits
+    Description: Channel demaps the PHICH
 
-    Document Reference: 3GPP TS 36.213 v10.3.0 section 7.1.7
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.9
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_get_tbs_mcs_and_n_prb_for_ul(uint32  N_bits,
-                                                          uint32  N_rb_ul,
-                                                          uint32 *tbs,
-                                                          uint8  *mcs,
-                                                          uint32 *N_prb)
+void phich_channel_demap(LIBLTE_PHY_STRUCT              *phy_struct,
+                         LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
+                         LIBLTE_PHY_SUBFRAME_STRUCT     *subframe,
+                         uint32                          N_id_cell,
+                         uint8                           N_ant,
+                         float                           phich_res,
+                         LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
+                         LIBLTE_PHY_PHICH_STRUCT        *phich)
 {
-    LIBLTE_ERROR_ENUM err   = LIBLTE_ERROR_INVALID_INPUTS;
-    uint32            I_tbs = 1000;
-    uint32            i;
-    uint32            j;
+    uint32 m_prime;
+    uint32 l_prime;
+    uint32 n_l_prime;
+    uint32 n_hat[3];
+    uint32 i;
+    uint32 j;
+    uint32 idx;
 
-    if(tbs   != NULL &&
-       mcs   != NULL &&
-       N_prb != NULL)
+    // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.9
+    if(LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP == phy_struct->N_sc_rb_dl)
     {
-        // Determine I_tbs and N_prb
-        for(i=0; i<27; i++)
+        phy_struct->N_group_phich = (uint32)ceilf((float)phich_res*((float)phy_struct->N_rb_dl/(float)8));
+    }else{
+        phy_struct->N_group_phich = 2*(uint32)ceilf((float)phich_res*((float)phy_struct->N_rb_dl/(float)8));
+    }
+    phich->N_reg = phy_struct->N_group_phich*3;
+    // Step 4
+    m_prime = 0;
+    idx     = 0;
+    // Step 10
+    while(m_prime < phy_struct->N_group_phich)
+    {
+        if(phich_dur == LIBLTE_RRC_PHICH_DURATION_NORMAL)
         {
-//            for(j=0; j<N_rb_ul; j++)
-            // FIXME: This keeps processing reasonable
-            for(j=0; j<11; j++)
+            // Step 7
+            l_prime = 0;
+            // Step 1, 2, and 3
+            n_l_prime = phy_struct->N_rb_dl*2 - pcfich->N_reg;
+            // Step 8
+            for(i=0; i<3; i++)
             {
-                if(N_bits <= TBS_71721[i][j])
+                n_hat[i] = (N_id_cell + m_prime + i*n_l_prime/3) % n_l_prime;
+            }
+            // Avoid PCFICH
+            for(i=0; i<pcfich->N_reg; i++)
+            {
+                for(j=0; j<3; j++)
                 {
-                    if(((j + 1) % 2) == 0 ||
-                       ((j + 1) % 3) == 0 ||
-                       ((j + 1) % 5) == 0)
+                    if(n_hat[j] > pcfich->n[i])
                     {
-                        I_tbs  = i;
-                        *tbs   = TBS_71721[i][j];
-                        *N_prb = j + 1;
-                        break;
+                        n_hat[j]++;
                     }
                 }
             }
-            if(I_tbs != 1000)
-            {
-                break;
-            }
-        }
-
-        if(I_tbs != 1000)
-        {
-            // Determine mcs
-            if(10 >= I_tbs)
+            // Step 5
+            for(i=0; i<3; i++)
             {
-                *mcs = I_tbs;
-            }else if(19 >= I_tbs){
-                *mcs = I_tbs + 1;
-            }else{
-                *mcs = I_tbs + 2;
+                phich->k[idx+i] = n_hat[i]*6;
+                // FIXME: Not currently implementing step 6
             }
-
-            err = LIBLTE_SUCCESS;
+            idx += 3;
+        }else{
+            // FIXME: Not handling extended PHICH duration
+            printf("ERROR: Not handling extended PHICH duration\n");
         }
+        // Step 9
+        m_prime++;
     }
-
-    return(err);
 }
 
 /*********************************************************************
-    Name: liblte_phy_get_n_cce
+    Name: generate_crs
 
-    Description: Determines the number of control channel elements
-                 available in the specified subframe
+    Description: Generates LTE cell specific reference signals
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.8.1
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.10.1.1
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_get_n_cce(LIBLTE_PHY_STRUCT *phy_struct,
-                                       float              phich_res,
-                                       uint32             N_pdcch_symbs,
-                                       uint8              N_ant,
-                                       uint32            *N_cce)
+void generate_crs(uint32  N_s,
+                  uint32  L,
+                  uint32  N_id_cell,
+                  uint32  N_sc_rb_dl,
+                  float  *crs_re,
+                  float  *crs_im)
 {
-    uint32 N_reg_phich;
-    uint32 N_reg_pcfich = 4;
-    uint32 N_reg_rb     = 3;
-    uint32 N_reg_pdcch;
+    float  one_over_sqrt_2 = 1/sqrt(2);
+    uint32 N_cp;
+    uint32 c_init;
+    uint32 len = 2*LIBLTE_PHY_N_RB_DL_MAX;
+    uint32 c[2*len];
+    uint32 i;
 
-    N_reg_phich = phy_struct->N_group_phich*3;
-    N_reg_pdcch = N_pdcch_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - N_reg_pcfich - N_reg_phich;
-    if(N_ant == 4)
+    if(LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP == N_sc_rb_dl)
     {
-        N_reg_pdcch -= phy_struct->N_rb_dl;
+        N_cp = 1;
+    }else{
+        N_cp = 0;
     }
 
-    *N_cce = N_reg_pdcch/LIBLTE_PHY_PDCCH_N_REG_CCE;
+    // Calculate c_init
+    c_init = 1024 * (7 * (N_s+1) + L + 1) * (2 * N_id_cell + 1) + 2*N_id_cell + N_cp;
 
-    return(LIBLTE_SUCCESS);
-}
+    // Generate the psuedo random sequence c
+    generate_prs_c(c_init, 2*len, c);
 
-/*******************************************************************************
-                              LOCAL FUNCTIONS
-*******************************************************************************/
+    // Construct the reference signals
+    for(i=0; i<len; i++)
+    {
+        crs_re[i] = one_over_sqrt_2*(1 - 2*(float)c[2*i]);
+        crs_im[i] = one_over_sqrt_2*(1 - 2*(float)c[2*i+1]);
+    }
+}
 
 /*********************************************************************
-    Name: layer_mapper_ul
+    Name: crs_cache_get
 
-    Description: Maps complex-valued modulation symbols onto one or
-                 several uplink layers
+    Description: Returns the cell specific reference signals for a
+                 slot and symbol, generating and caching all symbols
+                 of the slot on first use for N_id_cell
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.2A
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.10.1.1
+*********************************************************************/
+void crs_cache_get(LIBLTE_PHY_STRUCT  *phy_struct,
+                   uint32              N_s,
+                   uint32              L,
+                   uint32              N_id_cell,
+                   float             **crs_re,
+                   float             **crs_im)
+{
+    uint32 L_idx;
 
-    Notes: Currently only supports single antenna
+    if(N_id_cell != phy_struct->N_id_cell_crs)
+    {
+        phy_struct->N_id_cell_crs     = N_id_cell;
+        phy_struct->crs_storage_valid = 0;
+    }
+    if(0 == (phy_struct->crs_storage_valid & (1 << N_s)))
+    {
+        generate_crs(N_s, 0, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re_storage[N_s][0], phy_struct->crs_im_storage[N_s][0]);
+        generate_crs(N_s, 1, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re_storage[N_s][1], phy_struct->crs_im_storage[N_s][1]);
+        generate_crs(N_s, 4, N_id_cell, phy_struct->N_sc_rb_dl, phy_struct->crs_re_storage[N_s][2], phy_struct->crs_im_storage[N_s][2]);
+        phy_struct->crs_storage_valid |= 1 << N_s;
+    }
+
+    if(0 == L)
+    {
+        L_idx = 0;
+    }else if(1 == L){
+        L_idx = 1;
+    }else{ // 4 == L
+        L_idx = 2;
+    }
+    *crs_re = &phy_struct->crs_re_storage[N_s][L_idx][0];
+    *crs_im = &phy_struct->crs_im_storage[N_s][L_idx][0];
+}
+
+/*********************************************************************
+    Name: dl_ce_weights_gen
+
+    Description: Generates the frequency interpolation weights used
+                 between CRSs for each of the 6 CRS subcarrier offsets.
+                 Subcarrier k is estimated as the weighted sum of
+                 dl_ce_n_taps consecutive CRSs starting at
+                 dl_ce_w_idx.  Linear interpolation uses the two
+                 surrounding CRSs.  MMSE interpolation uses the four
+                 nearest CRSs, weighted for an exponential power delay
+                 profile with LIBLTE_PHY_DL_CE_MMSE_DELAY_SPREAD RMS
+                 delay spread at LIBLTE_PHY_DL_CE_MMSE_SNR.
+
+    Document Reference: N/A
 *********************************************************************/
-void layer_mapper_ul(float  *d_re,
-                     float  *d_im,
-                     uint32  M_symb,
-                     uint8   N_ant,
-                     uint32  N_codewords,
-                     float  *x_re,
-                     float  *x_im,
-                     uint32 *M_layer_symb)
+void dl_ce_weights_gen(LIBLTE_PHY_STRUCT *phy_struct)
 {
-    uint32 i;
+    float  A_re[LIBLTE_PHY_DL_CE_N_TAPS_MAX][LIBLTE_PHY_DL_CE_N_TAPS_MAX+1];
+    float  A_im[LIBLTE_PHY_DL_CE_N_TAPS_MAX][LIBLTE_PHY_DL_CE_N_TAPS_MAX+1];
+    float  x;
+    float  tmp_re;
+    float  tmp_im;
+    float  piv_re;
+    float  piv_im;
+    float  piv_mag;
+    uint32 N_crs = 2*phy_struct->N_rb_dl;
+    uint32 N_sc  = phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl;
+    uint32 o;
+    uint32 k;
+    uint32 j;
+    uint32 m;
+    uint32 n;
+    uint32 c;
+    uint32 N_taps;
+    int32  delta;
 
-    if(N_ant       == 1 &&
-       N_codewords == 1)
+    if(LIBLTE_PHY_DL_CE_INTERP_MMSE == phy_struct->dl_ce_interp)
     {
-        // 3GPP TS 36.211 v10.1.0 section 5.3.2A.1 and 5.3.2A.2
-        *M_layer_symb = M_symb;
-        for(i=0; i<M_symb; i++)
+        N_taps = 4;
+    }else{
+        N_taps = 2;
+    }
+    phy_struct->dl_ce_n_taps = N_taps;
+
+    for(o=0; o<6; o++)
+    {
+        for(k=0; k<N_sc; k++)
         {
-            x_re[i] = d_re[i];
-            x_im[i] = d_im[i];
+            // CRS at or below k, extrapolating past both band edges
+            j = (k < o) ? 0 : (k - o)/6;
+            if(4 == N_taps && j > 0)
+            {
+                j--;
+            }
+            if(j > N_crs - N_taps)
+            {
+                j = N_crs - N_taps;
+            }
+            phy_struct->dl_ce_w_idx[o][k] = j;
+
+            if(2 == N_taps)
+            {
+                x                                = ((float)k - (float)(6*j + o))/6;
+                phy_struct->dl_ce_w_re[o][0][k] = 1 - x;
+                phy_struct->dl_ce_w_im[o][0][k] = 0;
+                phy_struct->dl_ce_w_re[o][1][k] = x;
+                phy_struct->dl_ce_w_im[o][1][k] = 0;
+            }else{
+                // Solve transpose(R_crs + I/SNR)*w = r_k, with the
+                // frequency correlation r(delta_f) = 1/(1 + j*2*pi*tau*delta_f)
+                for(m=0; m<N_taps; m++)
+                {
+                    for(n=0; n<=N_taps; n++)
+                    {
+                        delta      = (n < N_taps) ? 6*((int32)n - (int32)m) : ((int32)k - (int32)(6*(j+m) + o));
+                        x          = 2*M_PI*LIBLTE_PHY_DL_CE_MMSE_DELAY_SPREAD*15000*delta;
+                        A_re[m][n] = 1/(1 + x*x);
+                        A_im[m][n] = -x/(1 + x*x);
+                    }
+                    A_re[m][m] += 1/LIBLTE_PHY_DL_CE_MMSE_SNR;
+                }
+                for(c=0; c<N_taps; c++)
+                {
+                    piv_mag = A_re[c][c]*A_re[c][c] + A_im[c][c]*A_im[c][c];
+                    piv_re  = A_re[c][c]/piv_mag;
+                    piv_im  = -A_im[c][c]/piv_mag;
+                    for(n=c; n<=N_taps; n++)
+                    {
+                        tmp_re     = A_re[c][n]*piv_re - A_im[c][n]*piv_im;
+                        tmp_im     = A_re[c][n]*piv_im + A_im[c][n]*piv_re;
+                        A_re[c][n] = tmp_re;
+                        A_im[c][n] = tmp_im;
+                    }
+                    for(m=0; m<N_taps; m++)
+                    {
+                        if(m != c)
+                        {
+                            tmp_re = A_re[m][c];
+                            tmp_im = A_im[m][c];
+                            for(n=c; n<=N_taps; n++)
+                            {
+                                A_re[m][n] -= tmp_re*A_re[c][n] - tmp_im*A_im[c][n];
+                                A_im[m][n] -= tmp_re*A_im[c][n] + tmp_im*A_re[c][n];
+                            }
+                        }
+                    }
+                }
+                for(m=0; m<N_taps; m++)
+                {
+                    phy_struct->dl_ce_w_re[o][m][k] = A_re[m][N_taps];
+                    phy_struct->dl_ce_w_im[o][m][k] = A_im[m][N_taps];
+                }
+            }
         }
-    }else{
-        // FIXME
     }
 }
 
 /*********************************************************************
-    Name: layer_demapper_ul
-
-    Description: De-maps one or several uplink layers into complex-
-                 valued modulation symbols
+    Name: dl_ce_interp_freq
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.2A
+    Description: Interpolates the channel estimates at the CRSs of a
+                 symbol to every subcarrier
 
-    Notes: Currently only supports single antenna
+    Document Reference: N/A
 *********************************************************************/
-void layer_demapper_ul(float  *x_re,
-                       float  *x_im,
-                       uint32  M_layer_symb,
-                       uint8   N_ant,
-                       uint32  N_codewords,
-                       float  *d_re,
-                       float  *d_im,
-                       uint32 *M_symb)
+void dl_ce_interp_freq(LIBLTE_PHY_STRUCT *phy_struct,
+                       uint32             offset,
+                       float             *crs_re,
+                       float             *crs_im,
+                       float             *ce_re,
+                       float             *ce_im)
 {
-    uint32 i;
+    float  *w_re;
+    float  *w_im;
+    uint16 *w_idx = phy_struct->dl_ce_w_idx[offset];
+    uint32  N_sc  = phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl;
+    uint32  k;
+    uint32  m;
 
-    if(N_ant       == 1 &&
-       N_codewords == 1)
+    for(k=0; k<N_sc; k++)
     {
-        // 3GPP TS 36.211 v10.1.0 section 5.3.2A.1 and 5.3.2A.2
-        *M_symb = M_layer_symb;
-        for(i=0; i<M_layer_symb; i++)
+        ce_re[k] = 0;
+        ce_im[k] = 0;
+    }
+    for(m=0; m<phy_struct->dl_ce_n_taps; m++)
+    {
+        w_re = phy_struct->dl_ce_w_re[offset][m];
+        w_im = phy_struct->dl_ce_w_im[offset][m];
+        for(k=0; k<N_sc; k++)
         {
-            d_re[i] = x_re[i];
-            d_im[i] = x_im[i];
+            ce_re[k] += w_re[k]*crs_re[w_idx[k]+m] - w_im[k]*crs_im[w_idx[k]+m];
+            ce_im[k] += w_re[k]*crs_im[w_idx[k]+m] + w_im[k]*crs_re[w_idx[k]+m];
         }
-    }else{
-        // FIXME
     }
 }
 
 /*********************************************************************
-    Name: transform_precoding
+    Name: dl_ce_interp_time
 
-    Description: DFT spreads the complex-valued symbols onto the
-                 entire uplink bandwidth
+    Description: Computes out = a + t*(b - a) for N complex values,
+                 used to interpolate channel estimates across symbols
+                 and to average them across subframes
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.3
+    Document Reference: N/A
 *********************************************************************/
-void transform_precoding(LIBLTE_PHY_STRUCT *phy_struct,
-                         float             *x_re,
-                         float             *x_im,
-                         uint32             M_layer_symb,
-                         uint32             N_prb,
-                         uint8              N_ant,
-                         uint32             N_codewords,
-                         float             *y_re,
-                         float             *y_im)
+void dl_ce_interp_time(float  *a_re,
+                       float  *a_im,
+                       float  *b_re,
+                       float  *b_im,
+                       float   t,
+                       uint32  N,
+                       float  *out_re,
+                       float  *out_im)
 {
-    float  one_over_sqrt_M_pusch_sc;
-    uint32 M_pusch_sc;
-    uint32 i;
-    uint32 j;
-
-    // Calculate M_pusch_sc and 1/sqrt(M_pusch_sc)
-    M_pusch_sc               = N_prb * phy_struct->N_sc_rb_ul;
-    one_over_sqrt_M_pusch_sc = 1/sqrt(M_pusch_sc);
+    // Function scope statics are initialized exactly once, even with
+    // multiple threads
+    static LIBLTE_PHY_TURBO_KERNEL_ENUM kernel = turbo_kernel_detect();
 
-    for(i=0; i<12; i++)
+#if defined(__x86_64__) || defined(__i386__)
+    if(LIBLTE_PHY_TURBO_KERNEL_AVX2 == kernel)
     {
-        for(j=0; j<M_pusch_sc; j++)
-        {
-            phy_struct->transform_precoding_in[j][0] = x_re[i*M_pusch_sc + j];
-            phy_struct->transform_precoding_in[j][1] = x_im[i*M_pusch_sc + j];
-        }
-        fftwf_execute(phy_struct->transform_precoding_plan[N_prb]);
-        for(j=0; j<M_pusch_sc; j++)
-        {
-            y_re[i*M_pusch_sc + j] = one_over_sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][0];
-            y_im[i*M_pusch_sc + j] = one_over_sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][1];
-        }
+        dl_ce_interp_time_avx2(a_re, a_im, b_re, b_im, t, N, out_re, out_im);
+    }else if(LIBLTE_PHY_TURBO_KERNEL_SSE4_1 == kernel){
+        dl_ce_interp_time_sse4_1(a_re, a_im, b_re, b_im, t, N, out_re, out_im);
+    }else{
+        dl_ce_interp_time_scalar(a_re, a_im, b_re, b_im, t, N, out_re, out_im);
     }
+#else
+    (void)kernel;
+    dl_ce_interp_time_scalar(a_re, a_im, b_re, b_im, t, N, out_re, out_im);
+#endif
 }
-
-/*********************************************************************
-    Name: transform_pre_decoding
-
-    Description: DFT despreads the entire uplink bandwidth into
-                 complex-valued modulation symbols
-
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.3
-*********************************************************************/
-void transform_pre_decoding(LIBLTE_PHY_STRUCT *phy_struct,
-                            float             *y_re,
-                            float             *y_im,
-                            uint32             M_layer_symb,
-                            uint32             N_prb,
-                            uint8              N_ant,
-                            uint32             N_codewords,
-                            float             *x_re,
-                            float             *x_im)
+void dl_ce_interp_time_scalar(float  *a_re,
+                              float  *a_im,
+                              float  *b_re,
+                              float  *b_im,
+                              float   t,
+                              uint32  N,
+                              float  *out_re,
+                              float  *out_im)
 {
-    float  sqrt_M_pusch_sc;
-    uint32 M_pusch_sc;
     uint32 i;
-    uint32 j;
-
-    // Calculate M_pusch_sc and sqrt(M_pusch_sc)
-    M_pusch_sc      = N_prb * phy_struct->N_sc_rb_ul;
-    sqrt_M_pusch_sc = sqrt(M_pusch_sc);
 
-    for(i=0; i<12; i++)
+    for(i=0; i<N; i++)
     {
-        for(j=0; j<M_pusch_sc; j++)
-        {
-            phy_struct->transform_precoding_in[j][0] = y_re[i*M_pusch_sc + j];
-            phy_struct->transform_precoding_in[j][1] = y_im[i*M_pusch_sc + j];
-        }
-        fftwf_execute(phy_struct->transform_pre_decoding_plan[N_prb]);
-        for(j=0; j<M_pusch_sc; j++)
-        {
-            x_re[i*M_pusch_sc + j] = sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][0];
-            x_im[i*M_pusch_sc + j] = sqrt_M_pusch_sc * phy_struct->transform_precoding_out[j][1];
-        }
+        out_re[i] = a_re[i] + t*(b_re[i] - a_re[i]);
+        out_im[i] = a_im[i] + t*(b_im[i] - a_im[i]);
     }
 }
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse4.1")))
+void dl_ce_interp_time_sse4_1(float  *a_re,
+                              float  *a_im,
+                              float  *b_re,
+                              float  *b_im,
+                              float   t,
+                              uint32  N,
+                              float  *out_re,
+                              float  *out_im)
+{
+    __m128 t_v = _mm_set1_ps(t);
+    __m128 a;
+    __m128 b;
+    uint32 i;
 
-/*********************************************************************
-    Name: pre_coder_ul
-
-    Description: Generates a block of vectors to be mapped onto
-                 resources on each uplink antenna port
-
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.3A
-
-    Notes: Currently only supports single antenna
-*********************************************************************/
-void pre_coder_ul(float  *y_re,
-                  float  *y_im,
-                  uint32  M_layer_symb,
-                  uint8   N_ant,
-                  uint8   N_layers,
-                  float  *z_re,
-                  float  *z_im,
-                  uint32 *M_ap_symb)
+    for(i=0; i+4<=N; i+=4)
+    {
+        a = _mm_loadu_ps(&a_re[i]);
+        b = _mm_loadu_ps(&b_re[i]);
+        _mm_storeu_ps(&out_re[i], _mm_add_ps(a, _mm_mul_ps(t_v, _mm_sub_ps(b, a))));
+        a = _mm_loadu_ps(&a_im[i]);
+        b = _mm_loadu_ps(&b_im[i]);
+        _mm_storeu_ps(&out_im[i], _mm_add_ps(a, _mm_mul_ps(t_v, _mm_sub_ps(b, a))));
+    }
+    dl_ce_interp_time_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], t, N-i, &out_re[i], &out_im[i]);
+}
+__attribute__((target("avx2")))
+void dl_ce_interp_time_avx2(float  *a_re,
+                            float  *a_im,
+                            float  *b_re,
+                            float  *b_im,
+                            float   t,
+                            uint32  N,
+                            float  *out_re,
+                            float  *out_im)
 {
+    __m256 t_v = _mm256_set1_ps(t);
+    __m256 a;
+    __m256 b;
     uint32 i;
 
-    if(N_ant    == 1 &&
-       N_layers == 1)
+    for(i=0; i+8<=N; i+=8)
     {
-        // 3GPP TS 36.211 v10.1.0 section 5.3.3A.1
-        *M_ap_symb = M_layer_symb;
-        for(i=0; i<M_layer_symb; i++)
-        {
-            z_re[i] = y_re[i];
-            z_im[i] = y_im[i];
-        }
-    }else{
-        // FIXME
+        a = _mm256_loadu_ps(&a_re[i]);
+        b = _mm256_loadu_ps(&b_re[i]);
+        _mm256_storeu_ps(&out_re[i], _mm256_add_ps(a, _mm256_mul_ps(t_v, _mm256_sub_ps(b, a))));
+        a = _mm256_loadu_ps(&a_im[i]);
+        b = _mm256_loadu_ps(&b_im[i]);
+        _mm256_storeu_ps(&out_im[i], _mm256_add_ps(a, _mm256_mul_ps(t_v, _mm256_sub_ps(b, a))));
     }
+    dl_ce_interp_time_scalar(&a_re[i], &a_im[i], &b_re[i], &b_im[i], t, N-i, &out_re[i], &out_im[i]);
 }
+#endif
 
 /*********************************************************************
-    Name: pre_decoder_and_matched_filter_ul
-
-    Description: Matched filters and unmaps a block of vectors from
-                 resources on each uplink antenna port
+    Name: dl_ce_interp_time_cf
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.3.3A
+    Description: Computes out = a + t*(b - a) for N complex values,
+                 writing the result as interleaved complex values
 
-    Notes: Currently only supports single antenna
+    Document Reference: N/A
 *********************************************************************/
-void pre_decoder_and_matched_filter_ul(float  *z_re,
-                                       float  *z_im,
-                                       float  *h_re,
-                                       float  *h_im,
-                                       uint32  M_ap_symb,
-                                       uint8   N_ant,
-                                       uint8   N_layers,
-                                       float  *y_re,
-                                       float  *y_im,
-                                       uint32 *M_layer_symb)
+void dl_ce_interp_time_cf(float                *a_re,
+                          float                *a_im,
+                          float                *b_re,
+                          float                *b_im,
+                          float                 t,
+                          uint32                N,
+                          LIBLTE_PHY_CF_STRUCT *out)
 {
-    float  h_norm;
     uint32 i;
 
-    if(N_ant    == 1 &&
-       N_layers == 1)
+    for(i=0; i<N; i++)
     {
-        // 3GPP TS 36.211 v10.1.0 section 5.3.3A.1
-        *M_layer_symb = M_ap_symb;
-        for(i=0; i<M_ap_symb; i++)
-        {
-            h_norm  = h_re[i] * h_re[i] + h_im[i] * h_im[i];
-            y_re[i] = (z_re[i]*h_re[i] + z_im[i]*h_im[i]) / h_norm;
-            y_im[i] = (z_im[i]*h_re[i] - z_re[i]*h_im[i]) / h_norm;
-        }
-    }else{
-        // FIXME
+        out[i].re = a_re[i] + t*(b_re[i] - a_re[i]);
+        out[i].im = a_im[i] + t*(b_im[i] - a_im[i]);
     }
 }
 
 /*********************************************************************
-    Name: generate_ul_rs
+    Name: generate_pss
 
-    Description: Generates uplink reference signals
+    Description: Generates an LTE primary synchronization signal
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.5.1
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1.1
 *********************************************************************/
-void generate_ul_rs(LIBLTE_PHY_STRUCT         *phy_struct,
-                    uint32                     N_slot,
-                    uint32                     N_id_cell,
-                    LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
-                    uint32                     delta_ss,
-                    uint32                     N_prb,
-                    float                      alpha,
-                    bool                       group_hopping_enabled,
-                    bool                       sequence_hopping_enabled,
-                    float                     *ul_rs_re,
-                    float                     *ul_rs_im)
+void generate_pss(uint32  N_id_2,
+                  float  *pss_re,
+                  float  *pss_im)
 {
-    float  q_bar;
-    uint32 M_sc_rs;
-    uint32 N_zc_rs;
+    float  root_idx;
     uint32 i;
-    uint32 j;
-    uint32 f_ss;
-    uint32 f_gh;
-    uint32 v;
-    uint32 u;
-    int32  q;
-
-    // Calculate M_sc_rs
-    M_sc_rs = N_prb * LIBLTE_PHY_N_SC_RB_UL;
-
-    // Determine N_zc_rs
-    for(i=UL_RS_PRIMES_LESS_THAN_2048_LEN-1; i>0; i--)
-    {
-        if(UL_RS_PRIMES_LESS_THAN_2048[i] < M_sc_rs)
-        {
-            N_zc_rs = UL_RS_PRIMES_LESS_THAN_2048[i];
-            break;
-        }
-    }
 
-    // Determine f_ss
-    if(LIBLTE_PHY_CHAN_TYPE_ULSCH == chan_type)
+    if(N_id_2 == 0)
     {
-        f_ss = ((N_id_cell % 30) + delta_ss) % 30;
+        root_idx = 25;
+    }else if(N_id_2 == 1){
+        root_idx = 29;
     }else{
-        f_ss = N_id_cell % 30;
+        root_idx = 34;
     }
 
-    // Determine u
-    if(group_hopping_enabled)
+    for(i=0; i<31; i++)
     {
-        generate_prs_c(N_id_cell/30, 160, phy_struct->ulrs_c);
-        f_gh = 0;
-        for(i=0; i<8; i++)
-        {
-            f_gh += phy_struct->ulrs_c[8*N_slot + i] << i;
-        }
-        f_gh %= 30;
-        u     = (f_gh + f_ss) % 30;
-    }else{
-        u = f_ss % 30;
+        pss_re[i] = cosf(-M_PI*root_idx*i*(i+1)/63);
+        pss_im[i] = sinf(-M_PI*root_idx*i*(i+1)/63);
     }
-
-    // Determine v
-    if(M_sc_rs < 6*LIBLTE_PHY_N_SC_RB_UL)
+    for(i=31; i<62; i++)
     {
-        v = 0;
-    }else{
-        if(!group_hopping_enabled && sequence_hopping_enabled)
-        {
-            generate_prs_c(((N_id_cell/30) << 5) + f_ss, 20, phy_struct->ulrs_c);
-            v = phy_struct->ulrs_c[N_slot];
-        }else{
-            v = 0;
-        }
+        pss_re[i] = cosf(-M_PI*root_idx*(i+1)*(i+2)/63);
+        pss_im[i] = sinf(-M_PI*root_idx*(i+1)*(i+2)/63);
     }
+}
 
-    // Determine r_bar_u_v
-    if(M_sc_rs >= 3*LIBLTE_PHY_N_SC_RB_UL)
-    {
-        q_bar = (float)N_zc_rs*(float)(u+1)/(float)31;
-        if((((uint32)(2*q_bar)) % 2) == 0)
-        {
-            q = (uint32)(q_bar + 0.5) + v;
-        }else{
-            q = (uint32)(q_bar + 0.5) - v;
-        }
-        for(i=0; i<N_zc_rs; i++)
+/*********************************************************************
+    Name: pss_corr_init
+
+    Description: Allocates the FFT based PSS correlator and generates
+                 the frequency domain PSS replicas
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1.2
+*********************************************************************/
+void pss_corr_init(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    float  pss_re[63];
+    float  pss_im[63];
+    uint32 N = phy_struct->N_samps_per_symb;
+    uint32 M = 4*N;
+    uint32 i;
+    uint32 j;
+    uint32 k;
+
+    phy_struct->dl_pss_corr_in        = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*M);
+    phy_struct->dl_pss_corr_out       = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*M);
+    phy_struct->dl_pss_corr_dec_in    = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*LIBLTE_PHY_PSS_CORR_N_BINS);
+    phy_struct->dl_pss_corr_dec_out   = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*LIBLTE_PHY_PSS_CORR_N_BINS);
+    phy_struct->mem_footprint        += 2*sizeof(fftwf_complex)*(M + LIBLTE_PHY_PSS_CORR_N_BINS);
+    phy_struct->dl_pss_corr_fft_plan  = fftwf_plan_dft_1d(M,
+                                                          phy_struct->dl_pss_corr_in,
+                                                          phy_struct->dl_pss_corr_out,
+                                                          FFTW_FORWARD,
+                                                          FFTW_MEASURE);
+    phy_struct->dl_pss_corr_ifft_plan = fftwf_plan_dft_1d(LIBLTE_PHY_PSS_CORR_N_BINS,
+                                                          phy_struct->dl_pss_corr_dec_in,
+                                                          phy_struct->dl_pss_corr_dec_out,
+                                                          FFTW_BACKWARD,
+                                                          FFTW_MEASURE);
+
+    for(i=0; i<3; i++)
+    {
+        // Time domain PSS symbol, d(0..30) below DC and d(31..61) above
+        generate_pss(i, pss_re, pss_im);
+        for(j=0; j<N; j++)
         {
-            phy_struct->ulrs_x_q_re[i] = cos(-M_PI*q*i*(i+1)/N_zc_rs);
-            phy_struct->ulrs_x_q_im[i] = sin(-M_PI*q*i*(i+1)/N_zc_rs);
+            phy_struct->s2s_in[j][0] = 0;
+            phy_struct->s2s_in[j][1] = 0;
         }
-        for(i=0; i<M_sc_rs; i++)
+        for(j=0; j<62; j++)
         {
-            phy_struct->ulrs_r_bar_u_v_re[i] = phy_struct->ulrs_x_q_re[i % N_zc_rs];
-            phy_struct->ulrs_r_bar_u_v_im[i] = phy_struct->ulrs_x_q_im[i % N_zc_rs];
+            k                        = (j < 31) ? (N + j - 31) : (j - 30);
+            phy_struct->s2s_in[k][0] = pss_re[j];
+            phy_struct->s2s_in[k][1] = pss_im[j];
         }
-    }else if(M_sc_rs == LIBLTE_PHY_N_SC_RB_UL){
-        for(i=0; i<M_sc_rs; i++)
+        fftwf_execute(phy_struct->symbs_to_samps_dl_plan);
+
+        // Zero padded to the correlator block size, keeping only the
+        // bins around DC
+        for(j=0; j<M; j++)
         {
-            phy_struct->ulrs_r_bar_u_v_re[i] = cos(UL_RS_5_5_1_2_1[u][i]*M_PI/4);
-            phy_struct->ulrs_r_bar_u_v_im[i] = sin(UL_RS_5_5_1_2_1[u][i]*M_PI/4);
+            phy_struct->dl_pss_corr_in[j][0] = (j < N) ? phy_struct->s2s_out[j][0] : 0;
+            phy_struct->dl_pss_corr_in[j][1] = (j < N) ? phy_struct->s2s_out[j][1] : 0;
         }
-    }else{ // M_sc_rs == 2*LIBLTE_PHY_N_SC_RB_UL
-        for(i=0; i<M_sc_rs; i++)
+        fftwf_execute(phy_struct->dl_pss_corr_fft_plan);
+        for(j=0; j<LIBLTE_PHY_PSS_CORR_N_BINS; j++)
         {
-            phy_struct->ulrs_r_bar_u_v_re[i] = cos(UL_RS_5_5_1_2_2[u][i]*M_PI/4);
-            phy_struct->ulrs_r_bar_u_v_im[i] = sin(UL_RS_5_5_1_2_2[u][i]*M_PI/4);
+            k                                  = (j < LIBLTE_PHY_PSS_CORR_N_BINS/2) ? j : (M + j - LIBLTE_PHY_PSS_CORR_N_BINS);
+            phy_struct->dl_pss_corr_fd_re[i][j] = phy_struct->dl_pss_corr_out[k][0];
+            phy_struct->dl_pss_corr_fd_im[i][j] = phy_struct->dl_pss_corr_out[k][1];
         }
     }
-
-    // Calculate r_u_v (ul_rs_re and ul_rs_im)
-    for(i=0; i<M_sc_rs; i++)
-    {
-        ul_rs_re[i] = cos(alpha*i)*phy_struct->ulrs_r_bar_u_v_re[i] - sin(alpha*i)*phy_struct->ulrs_r_bar_u_v_im[i];
-        ul_rs_im[i] = sin(alpha*i)*phy_struct->ulrs_r_bar_u_v_re[i] + cos(alpha*i)*phy_struct->ulrs_r_bar_u_v_im[i];
-    }
 }
 
 /*********************************************************************
-    Name: generate_dmrs_pusch
+    Name: pss_coarse_timing_search
 
-    Description: Generates demodulation reference signals for the
-                 uplink shared channel
+    Description: Finds slot starts of eNB signals by correlating with
+                 the PSS, one 4*N_samps_per_symb point FFT per
+                 3*N_samps_per_symb samples and only the bins around
+                 the PSS going back through the inverse FFT
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.5.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1
 *********************************************************************/
-void generate_dmrs_pusch(LIBLTE_PHY_STRUCT *phy_struct,
-                         uint32             N_subfr,
-                         uint32             N_id_cell,
-                         uint32             delta_ss,
-                         uint32             cyclic_shift,
-                         uint32             cyclic_shift_dci,
-                         uint32             N_prb,
-                         uint32             layer,
-                         bool               group_hopping_enabled,
-                         bool               sequence_hopping_enabled,
-                         float             *dmrs_0_re,
-                         float             *dmrs_0_im,
-                         float             *dmrs_1_re,
-                         float             *dmrs_1_im)
+void pss_coarse_timing_search(LIBLTE_PHY_STRUCT *phy_struct,
+                              float             *i_samps,
+                              float             *q_samps,
+                              uint32             N_slots,
+                              int32             *abs_corr_idx,
+                              uint32            *n_corr_peaks)
 {
-    uint32 N_slot;
-    uint32 lambda;
-    uint32 f_ss_pusch;
-    uint32 n_pn_ns_1;
-    uint32 n_pn_ns_2;
-    uint32 n_1_dmrs;
-    uint32 n_2_dmrs_lambda;
-    uint32 n_cs_lambda_1;
-    uint32 n_cs_lambda_2;
-    uint32 M_sc_rb   = N_prb * LIBLTE_PHY_N_SC_RB_UL;
-    uint32 N_ul_symb = 7; // FIXME: Only handling normal CP
+    float  x_re;
+    float  x_im;
+    float  corr_mean = 0;
+    float  abs_corr_max;
+    uint32 N         = phy_struct->N_samps_per_symb;
+    uint32 M         = 4*N;
+    uint32 D         = M/LIBLTE_PHY_PSS_CORR_N_BINS;
+    uint32 N_hop     = 3*N;
+    uint32 N_samps   = N_slots*phy_struct->N_samps_per_slot;
+    uint32 N_blank   = phy_struct->N_samps_cp_l_else/D + 1;
+    uint32 pss_start = phy_struct->N_samps_cp_l_0 + N + 6*phy_struct->N_samps_cp_l_else + 5*N;
+    uint32 max_idx;
+    uint32 b;
     uint32 i;
     uint32 j;
-    float  alpha_lambda_1;
-    float  alpha_lambda_2;
-    float  r_u_v_alpha_lambda_re[2][M_sc_rb];
-    float  r_u_v_alpha_lambda_im[2][M_sc_rb];
-    int32  w_vector[2];
-
-    // Calculate N_slot
-    N_slot = N_subfr*2;
-
-    // Set lambda
-    lambda = layer;
-
-    // Calculate f_ss_pusch
-    f_ss_pusch = ((N_id_cell % 30) + delta_ss) % 30;
-
-    // Generate c
-    generate_prs_c(((N_id_cell/30) << 5) + f_ss_pusch, 8*N_ul_symb*20, phy_struct->pusch_dmrs_c);
+    uint32 k;
+    uint32 idx;
 
-    // Calculate n_pn_ns
-    n_pn_ns_1 = 0;
-    n_pn_ns_2 = 0;
-    for(i=0; i<8; i++)
+    for(k=0; k<3; k++)
     {
-        n_pn_ns_1 += phy_struct->pusch_dmrs_c[8*N_ul_symb*N_slot + i] << i;
-        n_pn_ns_2 += phy_struct->pusch_dmrs_c[8*N_ul_symb*(N_slot+1) + i] << i;
+        for(j=0; j<LIBLTE_PHY_PSS_CORR_N_HALF_FRAME; j++)
+        {
+            phy_struct->dl_pss_corr_abs[k][j] = 0;
+        }
     }
 
-    // Determine n_1_dmrs
-    n_1_dmrs = N_1_DMRS_5_5_2_1_1_2[cyclic_shift];
-
-    // Determine n_2_dmrs_lambda
-    n_2_dmrs_lambda = N_2_DMRS_LAMBDA_5_5_2_1_1_1[cyclic_shift_dci][lambda];
+    // Overlap-save correlation, folded onto one half frame
+    for(b=0; b<N_samps; b+=N_hop)
+    {
+        for(j=0; j<M; j++)
+        {
+            phy_struct->dl_pss_corr_in[j][0] = i_samps[b+j];
+            phy_struct->dl_pss_corr_in[j][1] = q_samps[b+j];
+        }
+        fftwf_execute(phy_struct->dl_pss_corr_fft_plan);
+        for(k=0; k<3; k++)
+        {
+            for(j=0; j<LIBLTE_PHY_PSS_CORR_N_BINS; j++)
+            {
+                idx                                  = (j < LIBLTE_PHY_PSS_CORR_N_BINS/2) ? j : (M + j - LIBLTE_PHY_PSS_CORR_N_BINS);
+                x_re                                 = phy_struct->dl_pss_corr_out[idx][0];
+                x_im                                 = phy_struct->dl_pss_corr_out[idx][1];
+                phy_struct->dl_pss_corr_dec_in[j][0] = x_re*phy_struct->dl_pss_corr_fd_re[k][j] + x_im*phy_struct->dl_pss_corr_fd_im[k][j];
+                phy_struct->dl_pss_corr_dec_in[j][1] = x_im*phy_struct->dl_pss_corr_fd_re[k][j] - x_re*phy_struct->dl_pss_corr_fd_im[k][j];
+            }
+            fftwf_execute(phy_struct->dl_pss_corr_ifft_plan);
+            for(j=0; j<N_hop/D && b+j*D<N_samps; j++)
+            {
+                idx                                  = (b/D + j) % LIBLTE_PHY_PSS_CORR_N_HALF_FRAME;
+                phy_struct->dl_pss_corr_abs[k][idx] += (phy_struct->dl_pss_corr_dec_out[j][0]*phy_struct->dl_pss_corr_dec_out[j][0] +
+                                                        phy_struct->dl_pss_corr_dec_out[j][1]*phy_struct->dl_pss_corr_dec_out[j][1]);
+            }
+        }
+    }
 
-    // Calculate n_cs_lambda
-    n_cs_lambda_1 = (n_1_dmrs + n_2_dmrs_lambda + n_pn_ns_1) % 12;
-    n_cs_lambda_2 = (n_1_dmrs + n_2_dmrs_lambda + n_pn_ns_2) % 12;
+    // Find mean of correlation and gate correlation results
+    for(k=0; k<3; k++)
+    {
+        for(j=0; j<LIBLTE_PHY_PSS_CORR_N_HALF_FRAME; j++)
+        {
+            corr_mean += phy_struct->dl_pss_corr_abs[k][j];
+        }
+    }
+    corr_mean /= 3*LIBLTE_PHY_PSS_CORR_N_HALF_FRAME;
+    for(k=0; k<3; k++)
+    {
+        for(j=0; j<LIBLTE_PHY_PSS_CORR_N_HALF_FRAME; j++)
+        {
+            if(phy_struct->dl_pss_corr_abs[k][j] <= corr_mean)
+            {
+                phy_struct->dl_pss_corr_abs[k][j] = 0;
+            }
+        }
+    }
 
-    // Calculate alpha_lambda
-    alpha_lambda_1 = 2*M_PI*n_cs_lambda_1/12;
-    alpha_lambda_2 = 2*M_PI*n_cs_lambda_2/12;
+    // Search for all of the eNB signals
+    *n_corr_peaks = LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS;
+    for(i=0; i<LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS; i++)
+    {
+        abs_corr_max = 0;
+        max_idx      = 0;
+        for(k=0; k<3; k++)
+        {
+            for(j=0; j<LIBLTE_PHY_PSS_CORR_N_HALF_FRAME; j++)
+            {
+                if(phy_struct->dl_pss_corr_abs[k][j] > abs_corr_max)
+                {
+                    abs_corr_max = phy_struct->dl_pss_corr_abs[k][j];
+                    max_idx      = j;
+                }
+            }
+        }
 
-    // Generate the base reference signal
-    generate_ul_rs(phy_struct,
-                   N_slot,
-                   N_id_cell,
-                   LIBLTE_PHY_CHAN_TYPE_ULSCH,
-                   delta_ss,
-                   N_prb,
-                   alpha_lambda_1,
-                   group_hopping_enabled,
-                   sequence_hopping_enabled,
-                   r_u_v_alpha_lambda_re[0],
-                   r_u_v_alpha_lambda_im[0]);
-    generate_ul_rs(phy_struct,
-                   N_slot+1,
-                   N_id_cell,
-                   LIBLTE_PHY_CHAN_TYPE_ULSCH,
-                   delta_ss,
-                   N_prb,
-                   alpha_lambda_2,
-                   group_hopping_enabled,
-                   sequence_hopping_enabled,
-                   r_u_v_alpha_lambda_re[1],
-                   r_u_v_alpha_lambda_im[1]);
+        if(0 == abs_corr_max)
+        {
+            *n_corr_peaks = i;
+            break;
+        }
 
-    // Determine w vector
-    // FIXME: Handle fixed values
-    w_vector[0] = 1;
-    w_vector[1] = W_1_5_5_2_1_1_1[cyclic_shift_dci][lambda];
+        // The PSS is the last symbol of its slot
+        abs_corr_idx[i] = (max_idx*D + 10*phy_struct->N_samps_per_slot - pss_start) % phy_struct->N_samps_per_slot;
 
-    // Generate the PUSCH demodulation reference signal sequence
-    for(i=0; i<M_sc_rb; i++)
-    {
-        dmrs_0_re[i] = w_vector[0]*r_u_v_alpha_lambda_re[0][i];
-        dmrs_0_im[i] = w_vector[0]*r_u_v_alpha_lambda_im[0][i];
-        dmrs_1_re[i] = w_vector[1]*r_u_v_alpha_lambda_re[1][i];
-        dmrs_1_im[i] = w_vector[1]*r_u_v_alpha_lambda_im[1][i];
+        // Get rid of max and its multipath
+        for(j=0; j<2*N_blank+1; j++)
+        {
+            idx = (max_idx + LIBLTE_PHY_PSS_CORR_N_HALF_FRAME + j - N_blank) % LIBLTE_PHY_PSS_CORR_N_HALF_FRAME;
+            for(k=0; k<3; k++)
+            {
+                phy_struct->dl_pss_corr_abs[k][idx] = 0;
+            }
+        }
     }
-
-    // FIXME: Add precoding to arrive at r_tilda
 }
 
 /*********************************************************************
-    Name: generate_dmrs_pucch
+    Name: generate_sss
 
-    Description: Generates demodulation reference signals for the
-                 uplink control channel
+    Description: Generates LTE secondary synchronization signals
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.5.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.2.1
 *********************************************************************/
-void generate_dmrs_pucch(LIBLTE_PHY_STRUCT *phy_struct,
-                         uint32             N_subfr,
-                         uint32             N_id_cell,
-                         uint32             delta_ss,
-                         bool               group_hopping_enabled,
-                         bool               sequence_hopping_enabled,
-                         uint8              N_cs_1,
-                         uint8              N_1_p_pucch,
-                         uint8              delta_pucch_shift,
-                         uint8              N_ant,
-                         float             *dmrs_0_re,
-                         float             *dmrs_0_im,
-                         float             *dmrs_1_re,
-                         float             *dmrs_1_im)
+void generate_sss(LIBLTE_PHY_STRUCT *phy_struct,
+                  uint32             N_id_1,
+                  uint32             N_id_2,
+                  float             *sss_re_0,
+                  float             *sss_im_0,
+                  float             *sss_re_5,
+                  float             *sss_im_5)
 {
-    uint32  N_slot;
-    uint32  i;
-    uint32  j;
-    uint32  k;
-    uint32  idx;
-    uint32  N_prime;
-    uint32  h_p;
-    uint32  N_ul_symb = 7; // FIXME: Only handling normal CP
-    uint32  n_cs_cell[2][N_ul_symb];
-    uint32  n_cs_p[2][N_ul_symb];
-    float   alpha_p[2][N_ul_symb];
-    float   w_re;
-    float   w_im;
-    float   alpha_re;
-    float   alpha_im;
-    float  *dmrs_re;
-    float  *dmrs_im;
+    uint32 i;
+    uint32 q_prime;
+    uint32 q;
+    uint32 m_prime;
+    uint32 m0;
+    uint32 m1;
 
-    // Calculate N_slot
-    N_slot = N_subfr*2;
+    // Generate m0 and m1
+    q_prime = N_id_1/30;
+    q       = (N_id_1 + (q_prime*(q_prime+1)/2))/30;
+    m_prime = N_id_1 + (q*(q+1)/2);
+    m0      = m_prime % 31;
+    m1      = (m0 + (m_prime/31) + 1) % 31;
 
-    // Calculate N_prime
-    if(N_1_p_pucch < (3*N_cs_1/delta_pucch_shift))
+    // Generate s_tilda
+    memset(phy_struct->sss_x_s_tilda, 0, sizeof(uint8)*31);
+    phy_struct->sss_x_s_tilda[4] = 1;
+    for(i=0; i<26; i++)
     {
-        N_prime = N_cs_1;
-    }else{
-        N_prime = LIBLTE_PHY_N_SC_RB_UL;
+        phy_struct->sss_x_s_tilda[i+5] = (phy_struct->sss_x_s_tilda[i+2] +
+                                          phy_struct->sss_x_s_tilda[i]) % 2;
+    }
+    for(i=0; i<31; i++)
+    {
+        phy_struct->sss_s_tilda[i] = 1 - 2*phy_struct->sss_x_s_tilda[i];
     }
 
-    // Calculate n_prime_p
-    // FIXME: Only supporting normal cyclic prefix
-    if(N_1_p_pucch < (3*N_cs_1/delta_pucch_shift))
+    // Generate c_tilda
+    memset(phy_struct->sss_x_c_tilda, 0, sizeof(uint8)*31);
+    phy_struct->sss_x_c_tilda[4] = 1;
+    for(i=0; i<26; i++)
     {
-        phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][0] = N_1_p_pucch;
-        h_p                                                  = (phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][0] + 2) % (3*N_prime/delta_pucch_shift);
-        phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][1] = (h_p/3) + (h_p%3)*N_prime/delta_pucch_shift;
-    }else{
-        phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][0] = (N_1_p_pucch - 3*N_cs_1/delta_pucch_shift) % (3*LIBLTE_PHY_N_SC_RB_UL/delta_pucch_shift);
-        phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][1] = ((3*(phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][0]+1)) % ((3*LIBLTE_PHY_N_SC_RB_UL/delta_pucch_shift)+1)) - 1;
+        phy_struct->sss_x_c_tilda[i+5] = (phy_struct->sss_x_c_tilda[i+3] +
+                                          phy_struct->sss_x_c_tilda[i]) % 2;
+    }
+    for(i=0; i<31; i++)
+    {
+        phy_struct->sss_c_tilda[i] = 1 - 2*phy_struct->sss_x_c_tilda[i];
     }
 
-    // Calculate N_oc_p
-    for(i=0; i<2; i++)
+    // Generate z_tilda
+    memset(phy_struct->sss_x_z_tilda, 0, sizeof(uint8)*31);
+    phy_struct->sss_x_z_tilda[4] = 1;
+    for(i=0; i<26; i++)
     {
-        phy_struct->pucch_n_oc_p[N_subfr][N_1_p_pucch][i] = phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][i]*delta_pucch_shift/N_prime;
+        phy_struct->sss_x_z_tilda[i+5] = (phy_struct->sss_x_z_tilda[i+4] +
+                                          phy_struct->sss_x_z_tilda[i+2] +
+                                          phy_struct->sss_x_z_tilda[i+1] +
+                                          phy_struct->sss_x_z_tilda[i]) % 2;
     }
-
-    // Generate c
-    generate_prs_c(N_id_cell, 8*N_ul_symb*20, phy_struct->pucch_dmrs_c);
-
-    // Calculate N_cs_cell
-    for(i=0; i<2; i++)
+    for(i=0; i<31; i++)
     {
-        for(j=0; j<N_ul_symb; j++)
-        {
-            n_cs_cell[i][j] = 0;
-            for(idx=0; idx<8; idx++)
-            {
-                n_cs_cell[i][j] += phy_struct->pucch_dmrs_c[8*N_ul_symb*(N_slot+i) + 8*j + idx] << idx;
-            }
-        }
+        phy_struct->sss_z_tilda[i] = 1 - 2*phy_struct->sss_x_z_tilda[i];
     }
 
-    // Calculate N_cs_p
-    // FIXME: Only supporting normal cyclic prefix
-    for(i=0; i<2; i++)
+    // Generate s0_m0 and s1_m1
+    for(i=0; i<31; i++)
     {
-        for(j=0; j<N_ul_symb; j++)
-        {
-            n_cs_p[i][j] = (n_cs_cell[i][j] + ((phy_struct->pucch_n_prime_p[N_subfr][N_1_p_pucch][i]*delta_pucch_shift + (phy_struct->pucch_n_oc_p[N_subfr][N_1_p_pucch][i] % delta_pucch_shift)) % N_prime)) % LIBLTE_PHY_N_SC_RB_UL;
-        }
+        phy_struct->sss_s0_m0[i] = phy_struct->sss_s_tilda[(i + m0) % 31];
+        phy_struct->sss_s1_m1[i] = phy_struct->sss_s_tilda[(i + m1) % 31];
     }
 
-    // Calculate alpha_p
-    for(i=0; i<2; i++)
+    // Generate c0 and c1
+    for(i=0; i<31; i++)
     {
-        for(j=0; j<N_ul_symb; j++)
-        {
-            alpha_p[i][j] = 2*M_PI*n_cs_p[i][j]/LIBLTE_PHY_N_SC_RB_UL;
-        }
+        phy_struct->sss_c0[i] = phy_struct->sss_c_tilda[(i + N_id_2) % 31];
+        phy_struct->sss_c1[i] = phy_struct->sss_c_tilda[(i + N_id_2 + 3) % 31];
     }
 
-    // Generate the base reference signal
-    for(i=0; i<2; i++)
+    // Generate z1_m0 and z1_m1
+    for(i=0; i<31; i++)
     {
-        for(j=0; j<N_ul_symb; j++)
-        {
-            generate_ul_rs(phy_struct,
-                           N_slot + i,
-                           N_id_cell,
-                           LIBLTE_PHY_CHAN_TYPE_ULCCH,
-                           delta_ss,
-                           1,
-                           alpha_p[i][j],
-                           group_hopping_enabled,
-                           sequence_hopping_enabled,
-                           phy_struct->pucch_r_u_v_alpha_p_re[N_subfr][N_1_p_pucch][i][j],
-                           phy_struct->pucch_r_u_v_alpha_p_im[N_subfr][N_1_p_pucch][i][j]);
-        }
+        phy_struct->sss_z1_m0[i] = phy_struct->sss_z_tilda[(i + (m0 % 8)) % 31];
+        phy_struct->sss_z1_m1[i] = phy_struct->sss_z_tilda[(i + (m1 % 8)) % 31];
     }
 
-    // Generate the PUCCH demodulation reference signal sequence
-    for(i=0; i<2; i++)
+    // Generate SSS
+    for(i=0; i<31; i++)
     {
-        if(0 == i)
-        {
-            dmrs_re = dmrs_0_re;
-            dmrs_im = dmrs_0_im;
-        }else{
-            dmrs_re = dmrs_1_re;
-            dmrs_im = dmrs_1_im;
-        }
-        for(j=0; j<LIBLTE_PHY_M_PUCCH_RS; j++)
-        {
-            w_re = cos(W_5_5_2_2_1_2_phase[phy_struct->pucch_n_oc_p[N_subfr][N_1_p_pucch][i]][j]);
-            w_im = sin(W_5_5_2_2_1_2_phase[phy_struct->pucch_n_oc_p[N_subfr][N_1_p_pucch][i]][j]);
-            for(k=0; k<LIBLTE_PHY_N_SC_RB_UL; k++)
-            {
-                alpha_re = phy_struct->pucch_r_u_v_alpha_p_re[N_subfr][N_1_p_pucch][i][j+2][k];
-                alpha_im = phy_struct->pucch_r_u_v_alpha_p_im[N_subfr][N_1_p_pucch][i][j+2][k];
-                // z(m) = 1
-                dmrs_re[j*LIBLTE_PHY_N_SC_RB_UL + k] = (1/sqrt(N_ant))*(w_re*alpha_re - w_im*alpha_im);
-                dmrs_im[j*LIBLTE_PHY_N_SC_RB_UL + k] = (1/sqrt(N_ant))*(w_re*alpha_im + w_im*alpha_re);
-            }
-        }
+        sss_re_0[2*i]   = phy_struct->sss_s0_m0[i]*phy_struct->sss_c0[i];
+        sss_im_0[2*i]   = 0;
+        sss_re_0[2*i+1] = phy_struct->sss_s1_m1[i]*phy_struct->sss_c1[i]*phy_struct->sss_z1_m0[i];
+        sss_im_0[2*i+1] = 0;
+
+        sss_re_5[2*i]   = phy_struct->sss_s1_m1[i]*phy_struct->sss_c0[i];
+        sss_im_5[2*i]   = 0;
+        sss_re_5[2*i+1] = phy_struct->sss_s0_m0[i]*phy_struct->sss_c1[i]*phy_struct->sss_z1_m1[i];
+        sss_im_5[2*i+1] = 0;
     }
 }
 
 /*********************************************************************
-    Name: prach_preamble_seq_gen
+    Name: symbols_to_samples_dl
 
-    Description: Generates all 64 PRACH preamble sequences
+    Description: Converts subcarrier symbols to I/Q samples for the
+                 downlink
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.7.2
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
 *********************************************************************/
-void prach_preamble_seq_gen(LIBLTE_PHY_STRUCT *phy_struct,
-                            uint32             root_seq_idx,
-                            uint32             pre_format,
-                            uint32             zczc,
-                            bool               hs_flag)
+void symbols_to_samples_dl(LIBLTE_PHY_STRUCT          *phy_struct,
+                           LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                           uint8                       ant,
+                           uint32                      symbol_offset,
+                           float                      *samps_re,
+                           float                      *samps_im,
+                           uint32                     *N_samps)
 {
-    double phase;
-    uint32 N_gen_pre = 0;
-    uint32 u;
-    uint32 N_cs;
+    uint32 CP_len;
     uint32 i;
-    uint32 p;
-    uint32 v;
-    uint32 v_max;
-    uint32 d_u;
-    uint32 d_start;
-    uint32 N_RA_shift;
-    uint32 N_RA_group;
-    uint32 N_neg_RA_shift;
-    uint32 C_v;
-
-    phy_struct->prach_root_seq_idx    = root_seq_idx;
-    phy_struct->prach_preamble_format = pre_format;
-    phy_struct->prach_zczc            = zczc;
-    phy_struct->prach_hs_flag         = hs_flag;
 
-    phy_struct->prach_N_x_u = 0;
-    while(N_gen_pre < 64)
+    // Calculate index and CP length
+    if((symbol_offset % 7) == 0)
     {
-        // Determine u and N_zc
-        if(4 == pre_format)
-        {
-            u                      = PRACH_5_7_2_5[root_seq_idx+phy_struct->prach_N_x_u];
-            phy_struct->prach_N_zc = 139;
-        }else{
-            u                      = PRACH_5_7_2_4[root_seq_idx+phy_struct->prach_N_x_u];
-            phy_struct->prach_N_zc = 839;
-        }
+        CP_len = phy_struct->N_samps_cp_l_0;
+    }else{
+        CP_len = phy_struct->N_samps_cp_l_else;
+    }
 
-        // Generate x_u
-        for(i=0; i<phy_struct->prach_N_zc; i++)
-        {
-            phase                                                = -M_PI*u*i*(i+1)/phy_struct->prach_N_zc;
-            phy_struct->prach_x_u_re[phy_struct->prach_N_x_u][i] = cos(phase);
-            phy_struct->prach_x_u_im[phy_struct->prach_N_x_u][i] = sin(phase);
-        }
+    symbol_to_fft_in_dl(phy_struct, subframe, ant, symbol_offset);
+    fftwf_execute(phy_struct->symbs_to_samps_dl_plan);
+    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+    {
+        samps_re[CP_len+i] = phy_struct->s2s_out[i][0];
+        samps_im[CP_len+i] = phy_struct->s2s_out[i][1];
+    }
+    for(i=0; i<CP_len; i++)
+    {
+        samps_re[i] = samps_re[phy_struct->N_samps_per_symb+i];
+        samps_im[i] = samps_im[phy_struct->N_samps_per_symb+i];
+    }
+    *N_samps = phy_struct->N_samps_per_symb + CP_len;
+}
+void symbols_to_samples_dl_cf(LIBLTE_PHY_STRUCT          *phy_struct,
+                              LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                              uint8                       ant,
+                              uint32                      symbol_offset,
+                              LIBLTE_PHY_CF_STRUCT       *samps,
+                              uint32                     *N_samps)
+{
+    fftwf_complex *out = (fftwf_complex *)&samps[0];
+    uint32         N   = phy_struct->N_samps_per_symb;
+    uint32         CP_len;
 
-        // Determine N_cs
-        if(4 == pre_format)
-        {
-            N_cs = PRACH_5_7_2_3[zczc];
-        }else{
-            if(hs_flag)
-            {
-                N_cs = PRACH_5_7_2_2_RS[zczc];
-            }else{
-                N_cs = PRACH_5_7_2_2_URS[zczc];
-            }
-        }
+    // Calculate index and CP length
+    if((symbol_offset % 7) == 0)
+    {
+        CP_len = phy_struct->N_samps_cp_l_0;
+    }else{
+        CP_len = phy_struct->N_samps_cp_l_else;
+    }
 
-        // Determine v_max
-        if(hs_flag)
-        {
-            // Determine d_u
-            for(p=1; p<=phy_struct->prach_N_zc; p++)
-            {
-                if(((p*u) % phy_struct->prach_N_zc) == 1)
-                {
-                    break;
-                }
-            }
-            if(p >= 0 && p < phy_struct->prach_N_zc/2)
-            {
-                d_u = p;
-            }else{
-                d_u = phy_struct->prach_N_zc - p;
-            }
+    // The plan can only write to arrays with the alignment it was
+    // planned with, otherwise go through s2s_out
+    symbol_to_fft_in_dl(phy_struct, subframe, ant, symbol_offset);
+    if(fftwf_alignment_of(&out[CP_len][0]) == fftwf_alignment_of(&phy_struct->s2s_out[0][0]))
+    {
+        fftwf_execute_dft(phy_struct->symbs_to_samps_dl_plan,
+                          phy_struct->s2s_in,
+                          &out[CP_len]);
+    }else{
+        fftwf_execute(phy_struct->symbs_to_samps_dl_plan);
+        memcpy(&samps[CP_len], phy_struct->s2s_out, sizeof(LIBLTE_PHY_CF_STRUCT)*N);
+    }
+    memcpy(&samps[0], &samps[N], sizeof(LIBLTE_PHY_CF_STRUCT)*CP_len);
+    *N_samps = N + CP_len;
+}
+void symbol_to_fft_in_dl(LIBLTE_PHY_STRUCT          *phy_struct,
+                         LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                         uint8                       ant,
+                         uint32                      symbol_offset)
+{
+    fftwf_complex *in   = phy_struct->s2s_in;
+    uint32         N    = phy_struct->N_samps_per_symb;
+    uint32         N_sc = (phy_struct->FFT_size/2) - phy_struct->FFT_pad_size;
+#ifndef LIBLTE_PHY_INTERLEAVED_IQ
+    float         *symb_re = subframe->tx_symb_re[ant][symbol_offset];
+    float         *symb_im = subframe->tx_symb_im[ant][symbol_offset];
+    uint32         i;
+#endif
+
+    // DC and guard band
+    in[0][0] = 0;
+    in[0][1] = 0;
+    memset(&in[N_sc+1], 0, sizeof(fftwf_complex)*(N - 2*N_sc - 1));
+
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    // Positive and negative spectrum are contiguous in the subframe
+    memcpy(&in[1],      &subframe->tx_symb[ant][symbol_offset][N_sc], sizeof(fftwf_complex)*N_sc);
+    memcpy(&in[N-N_sc], &subframe->tx_symb[ant][symbol_offset][0],    sizeof(fftwf_complex)*N_sc);
+#else
+    for(i=0; i<N_sc; i++)
+    {
+        // Positive spectrum
+        in[i+1][0] = symb_re[i+N_sc];
+        in[i+1][1] = symb_im[i+N_sc];
 
-            // Determine N_RA_shift, d_start, N_RA_group, and N_neg_RA_shift
-            if(d_u >= N_cs && d_u < phy_struct->prach_N_zc/3)
-            {
-                N_RA_shift     = d_u/N_cs;
-                d_start        = 2*d_u + N_RA_shift*N_cs;
-                N_RA_group     = phy_struct->prach_N_zc/d_start;
-                N_neg_RA_shift = (phy_struct->prach_N_zc - 2*d_u - N_RA_group*d_start)/N_cs;
-                if(N_neg_RA_shift < 0)
-                {
-                    N_neg_RA_shift = 0;
-                }
-            }else{
-                N_RA_shift     = (phy_struct->prach_N_zc - 2*d_u)/N_cs;
-                d_start        = phy_struct->prach_N_zc - 2*d_u + N_RA_shift*N_cs;
-                N_RA_group     = d_u/d_start;
-                N_neg_RA_shift = (d_u - N_RA_group*d_start)/N_cs;
-                if(N_neg_RA_shift < 0)
-                {
-                    N_neg_RA_shift = 0;
-                }
-                if(N_neg_RA_shift > N_RA_shift)
-                {
-                    N_neg_RA_shift = N_RA_shift;
-                }
-            }
+        // Negative spectrum
+        in[N-i-1][0] = symb_re[N_sc-i-1];
+        in[N-i-1][1] = symb_im[N_sc-i-1];
+    }
+#endif
+}
 
-            // Restricted set
-            v_max = N_RA_shift*N_RA_group + N_neg_RA_shift - 1;
-        }else{
-            // Unrestricted set
-            if(0 == N_cs)
-            {
-                v_max = 0;
-            }else{
-                v_max = (phy_struct->prach_N_zc/N_cs)-1;
-            }
-        }
+/*********************************************************************
+    Name: symbols_to_samples_ul
 
-        // Generate x_u_v
-        for(v=0; v<=v_max; v++)
-        {
-            if(hs_flag)
-            {
-                // Restricted set
-                C_v = d_start*floor(v/N_RA_shift) + (v % N_RA_shift)*N_cs;
-            }else{
-                // Unrestricted set
-                C_v = v*N_cs;
-            }
+    Description: Converts subcarrier symbols to I/Q samples for the
+                 uplink
 
-            for(i=0; i<phy_struct->prach_N_zc; i++)
-            {
-                phy_struct->prach_x_u_v_re[N_gen_pre][i] = phy_struct->prach_x_u_re[phy_struct->prach_N_x_u][(i+C_v) % phy_struct->prach_N_zc];
-                phy_struct->prach_x_u_v_im[N_gen_pre][i] = phy_struct->prach_x_u_im[phy_struct->prach_N_x_u][(i+C_v) % phy_struct->prach_N_zc];
-            }
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
+*********************************************************************/
+void symbols_to_samples_ul(LIBLTE_PHY_STRUCT *phy_struct,
+                           float             *symb_re,
+                           float             *symb_im,
+                           uint32             symbol_offset,
+                           float             *samps_re,
+                           float             *samps_im,
+                           uint32            *N_samps)
+{
+    uint32 CP_len;
+    uint32 i;
+    uint32 idx;
 
-            // Determine if enough preambles are generated
-            N_gen_pre++;
-            if(N_gen_pre >= 64)
-            {
-                break;
-            }
-        }
+    // Calculate index and CP length
+    if((symbol_offset % 7) == 0)
+    {
+        CP_len = phy_struct->N_samps_cp_l_0;
+    }else{
+        CP_len = phy_struct->N_samps_cp_l_else;
+    }
 
-        // Move to the next root sequence
-        phy_struct->prach_N_x_u++;
+    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+    {
+        phy_struct->s2s_in[i][0] = 0;
+        phy_struct->s2s_in[i][1] = 0;
+    }
+    for(i=0; i<phy_struct->FFT_size-(phy_struct->FFT_pad_size/2); i++)
+    {
+        idx                        = ((i*phy_struct->FFT_pad_size+phy_struct->FFT_size/2)*2+1)%(phy_struct->FFT_size*2);
+        phy_struct->s2s_in[idx][0] = symb_re[i];
+        phy_struct->s2s_in[idx][1] = symb_im[i];
+    }
+    fftwf_execute(phy_struct->symbs_to_samps_ul_plan);
+    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+    {
+        samps_re[CP_len+i] = phy_struct->s2s_out[i][0];
+        samps_im[CP_len+i] = phy_struct->s2s_out[i][1];
+    }
+    for(i=0; i<CP_len; i++)
+    {
+        samps_re[i] = samps_re[phy_struct->N_samps_per_symb+i];
+        samps_im[i] = samps_im[phy_struct->N_samps_per_symb+i];
     }
+    *N_samps = phy_struct->N_samps_per_symb + CP_len;
 }
 
 /*********************************************************************
-    Name: layer_mapper_dl
-
-    Description: Maps complex-valued modulation symbols onto one or
-                 several downlink layers
+    Name: samples_to_symbols_dl
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.3
+    Description: Converts I/Q samples to subcarrier symbols for the
+                 downlink
 
-    NOTES: Currently only supports single antenna or TX diversity
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
 *********************************************************************/
-void layer_mapper_dl(float                          *d_re,
-                     float                          *d_im,
-                     uint32                          M_symb,
-                     uint8                           N_ant,
-                     uint32                          N_codewords,
-                     LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
-                     float                          *x_re,
-                     float                          *x_im,
-                     uint32                         *M_layer_symb)
+void samples_to_symbols_dl(LIBLTE_PHY_STRUCT *phy_struct,
+                           float             *samps_re,
+                           float             *samps_im,
+                           uint32             slot_start_idx,
+                           uint32             symbol_offset,
+                           float             *symb_re,
+                           float             *symb_im)
 {
+    uint32 CP_len;
+    uint32 index;
     uint32 i;
 
-    if(N_ant       == 1 &&
-       N_codewords == 1)
+    // Calculate index and CP length
+    if((symbol_offset % 7) == 0)
     {
-        // 3GPP TS 36.211 v10.1.0 section 6.3.3.1
-        *M_layer_symb = M_symb;
-        for(i=0; i<M_symb; i++)
-        {
-            x_re[i] = d_re[i];
-            x_im[i] = d_im[i];
-        }
-    }else{
-        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type)
-        {
-            // 3GPP TS 36.211 v10.1.0 section 6.3.3.3
-            if(N_ant == 2)
-            {
-                *M_layer_symb = M_symb/2;
-                for(i=0; i<*M_layer_symb; i++)
-                {
-                    x_re[i]               = d_re[2*i];
-                    x_im[i]               = d_im[2*i];
-                    x_re[*M_layer_symb+i] = d_re[2*i+1];
-                    x_im[*M_layer_symb+i] = d_im[2*i+1];
-                }
-            }else{ // N_ant == 4
-                if((M_symb % 4) == 0)
-                {
-                    *M_layer_symb = M_symb/4;
-                }else{
-                    *M_layer_symb = (M_symb+2)/4;
-                }
-                for(i=0; i<*M_layer_symb; i++)
-                {
-                    x_re[i]                   = d_re[4*i];
-                    x_im[i]                   = d_im[4*i];
-                    x_re[*M_layer_symb+i]     = d_re[4*i+1];
-                    x_im[*M_layer_symb+i]     = d_im[4*i+1];
-                    x_re[2*(*M_layer_symb)+i] = d_re[4*i+2];
-                    x_im[2*(*M_layer_symb)+i] = d_im[4*i+2];
-                    x_re[3*(*M_layer_symb)+i] = d_re[4*i+3];
-                    x_im[3*(*M_layer_symb)+i] = d_im[4*i+3];
-                }
-            }
-        }else{
-            if(N_ant == 2)
-            {
-                if(N_codewords == 1)
-                {
-                    *M_layer_symb = M_symb/2;
-                    for(i=0; i<*M_layer_symb; i++)
-                    {
-                        x_re[i]               = d_re[2*i];
-                        x_im[i]               = d_im[2*i];
-                        x_re[*M_layer_symb+i] = d_re[2*i+1];
-                        x_im[*M_layer_symb+i] = d_im[2*i+1];
-                    }
-                }else{ // N_codewords == 2
-                    *M_layer_symb = M_symb;
-                    for(i=0; i<*M_layer_symb; i++)
-                    {
-                        x_re[i]               = d_re[i];
-                        x_im[i]               = d_im[i];
-                        x_re[*M_layer_symb+i] = d_re[M_symb+i];
-                        x_im[*M_layer_symb+i] = d_im[M_symb+i];
-                    }
-                }
-            }else if(N_ant == 3){
-                if(N_codewords == 1)
-                {
-                    *M_layer_symb = M_symb/3;
-                    for(i=0; i<*M_layer_symb; i++)
-                    {
-                        x_re[i]                   = d_re[3*i];
-                        x_im[i]                   = d_im[3*i];
-                        x_re[*M_layer_symb+i]     = d_re[3*i+1];
-                        x_im[*M_layer_symb+i]     = d_im[3*i+1];
-                        x_re[2*(*M_layer_symb)+i] = d_re[3*i+2];
-                        x_im[2*(*M_layer_symb)+i] = d_im[3*i+2];
-                    }
-                }else{ // N_codewords == 2
-                    // FIXME
-                }
-            }else if(N_ant == 4){
-                if(N_codewords == 1)
-                {
-                    *M_layer_symb = M_symb/4;
-                    for(i=0; i<*M_layer_symb; i++)
-                    {
-                        x_re[i]                   = d_re[4*i];
-                        x_im[i]                   = d_im[4*i];
-                        x_re[*M_layer_symb+i]     = d_re[4*i+1];
-                        x_im[*M_layer_symb+i]     = d_im[4*i+1];
-                        x_re[2*(*M_layer_symb)+i] = d_re[4*i+2];
-                        x_im[2*(*M_layer_symb)+i] = d_im[4*i+2];
-                        x_re[3*(*M_layer_symb)+i] = d_re[4*i+3];
-                        x_im[3*(*M_layer_symb)+i] = d_im[4*i+3];
-                    }
-                }else{ // N_codewords == 2
-                    *M_layer_symb = M_symb/2;
-                    for(i=0; i<*M_layer_symb; i++)
-                    {
-                        x_re[i]                   = d_re[2*i];
-                        x_im[i]                   = d_im[2*i];
-                        x_re[*M_layer_symb+i]     = d_re[2*i+1];
-                        x_im[*M_layer_symb+i]     = d_im[2*i+1];
-                        x_re[2*(*M_layer_symb)+i] = d_re[M_symb+2*i];
-                        x_im[2*(*M_layer_symb)+i] = d_im[M_symb+2*i];
-                        x_re[3*(*M_layer_symb)+i] = d_re[M_symb+2*i+1];
-                        x_im[3*(*M_layer_symb)+i] = d_im[M_symb+2*i+1];
-                    }
-                }
-            }else if(N_ant == 5){
-                // FIXME
-            }else if(N_ant == 6){
-                *M_layer_symb = M_symb/3;
-                for(i=0; i<*M_layer_symb; i++)
-                {
-                    x_re[i]                   = d_re[3*i];
-                    x_im[i]                   = d_im[3*i];
-                    x_re[*M_layer_symb+i]     = d_re[3*i+1];
-                    x_im[*M_layer_symb+i]     = d_im[3*i+1];
-                    x_re[2*(*M_layer_symb)+i] = d_re[3*i+2];
-                    x_im[2*(*M_layer_symb)+i] = d_im[3*i+2];
-                    x_re[3*(*M_layer_symb)+i] = d_re[M_symb+3*i];
-                    x_im[3*(*M_layer_symb)+i] = d_im[M_symb+3*i];
-                    x_re[4*(*M_layer_symb)+i] = d_re[M_symb+3*i+1];
-                    x_im[4*(*M_layer_symb)+i] = d_im[M_symb+3*i+1];
-                    x_re[5*(*M_layer_symb)+i] = d_re[M_symb+3*i+2];
-                    x_im[5*(*M_layer_symb)+i] = d_im[M_symb+3*i+2];
-                }
-            }else if(N_ant == 7){
-                // FIXME
-            }else{ // N_ant == 8
-                *M_layer_symb = M_symb/4;
-                for(i=0; i<*M_layer_symb; i++)
-                {
-                    x_re[i]                   = d_re[4*i];
-                    x_im[i]                   = d_im[4*i];
-                    x_re[*M_layer_symb+i]     = d_re[4*i+1];
-                    x_im[*M_layer_symb+i]     = d_im[4*i+1];
-                    x_re[2*(*M_layer_symb)+i] = d_re[4*i+2];
-                    x_im[2*(*M_layer_symb)+i] = d_im[4*i+2];
-                    x_re[3*(*M_layer_symb)+i] = d_re[4*i+3];
-                    x_im[3*(*M_layer_symb)+i] = d_im[4*i+3];
-                    x_re[4*(*M_layer_symb)+i] = d_re[M_symb+4*i];
-                    x_im[4*(*M_layer_symb)+i] = d_im[M_symb+4*i];
-                    x_re[5*(*M_layer_symb)+i] = d_re[M_symb+4*i+1];
-                    x_im[5*(*M_layer_symb)+i] = d_im[M_symb+4*i+1];
-                    x_re[6*(*M_layer_symb)+i] = d_re[M_symb+4*i+2];
-                    x_im[6*(*M_layer_symb)+i] = d_im[M_symb+4*i+2];
-                    x_re[7*(*M_layer_symb)+i] = d_re[M_symb+4*i+3];
-                    x_im[7*(*M_layer_symb)+i] = d_im[M_symb+4*i+3];
-                }
-            }
-        }
+        CP_len = phy_struct->N_samps_cp_l_0;
+    }else{
+        CP_len = phy_struct->N_samps_cp_l_else;
+    }
+    index = slot_start_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*symbol_offset;
+    if(symbol_offset > 0)
+    {
+        index += phy_struct->N_samps_cp_l_0 - phy_struct->N_samps_cp_l_else;
+    }
+
+    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+    {
+        phy_struct->s2s_in[i][0] = samps_re[index+CP_len-1+i];
+        phy_struct->s2s_in[i][1] = samps_im[index+CP_len-1+i];
+    }
+    fftwf_execute(phy_struct->samps_to_symbs_dl_plan);
+    for(i=0; i<(phy_struct->FFT_size/2)-phy_struct->FFT_pad_size; i++)
+    {
+        // Positive spectrum
+        symb_re[i+((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)] = phy_struct->s2s_out[i+1][0];
+        symb_im[i+((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)] = phy_struct->s2s_out[i+1][1];
+
+        // Negative spectrum
+        symb_re[((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)-i-1] = phy_struct->s2s_out[phy_struct->N_samps_per_symb-i-1][0];
+        symb_im[((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)-i-1] = phy_struct->s2s_out[phy_struct->N_samps_per_symb-i-1][1];
     }
 }
 
 /*********************************************************************
-    Name: layer_demapper_dl
-
-    Description: De-maps one or several downlink layers into complex-
-                 valued modulation symbols
+    Name: samples_to_subframe_dl
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.3
+    Description: Converts the I/Q samples of a downlink subframe, plus
+                 the first two symbols of the next subframe, to
+                 subcarrier symbols using a single batched FFT
 
-    NOTES: Currently only supports single antenna or TX diversity
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
 *********************************************************************/
-void layer_demapper_dl(float                          *x_re,
-                       float                          *x_im,
-                       uint32                          M_layer_symb,
-                       uint8                           N_ant,
-                       uint32                          N_codewords,
-                       LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
-                       float                          *d_re,
-                       float                          *d_im,
-                       uint32                         *M_symb)
+void samples_to_subframe_dl(LIBLTE_PHY_STRUCT          *phy_struct,
+                            float                      *samps_re,
+                            float                      *samps_im,
+                            uint32                      subfr_start_idx,
+                            LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
 {
-    float  *x_re_ptr[N_ant];
-    float  *x_im_ptr[N_ant];
-    uint32  i;
-    uint32  p;
-
-    // FIXME: Only supports TX diversity
-    // Index all arrays
-    for(p=0; p<N_ant; p++)
+    fftwf_complex *in;
+    fftwf_complex *out;
+    float         *x_re;
+    float         *x_im;
+#ifndef LIBLTE_PHY_INTERLEAVED_IQ
+    float         *symb_re;
+    float         *symb_im;
+#endif
+    uint32         N     = phy_struct->N_samps_per_symb;
+    uint32         N_sc  = (phy_struct->FFT_size/2) - phy_struct->FFT_pad_size;
+    uint32         index;
+    uint32         i;
+    uint32         j;
+
+    // Gather the useful part of every symbol, skipping the CP but
+    // keeping the one sample offset used for timing margin
+    for(i=0; i<16; i++)
     {
-        x_re_ptr[p] = &x_re[p*M_layer_symb];
-        x_im_ptr[p] = &x_im[p*M_layer_symb];
+        index = subfr_start_idx + (i/7)*phy_struct->N_samps_per_slot;
+        index += phy_struct->N_samps_cp_l_0 - 1 + (i%7)*(N + phy_struct->N_samps_cp_l_else);
+        x_re  = &samps_re[index];
+        x_im  = &samps_im[index];
+        in    = &phy_struct->s2s_in[i*N];
+        for(j=0; j<N; j++)
+        {
+            in[j][0] = x_re[j];
+            in[j][1] = x_im[j];
+        }
     }
+    fftwf_execute(phy_struct->samps_to_symbs_dl_subfr_plan);
 
-    // 3GPP TS 36.211 v10.1.0 sections 6.3.3.1 and 6.3.3.3
-    *M_symb = M_layer_symb*N_ant;
-    if(N_ant                       == 4            &&
-       x_re_ptr[2][M_layer_symb-1] == RX_NULL_SYMB &&
-       x_im_ptr[2][M_layer_symb-1] == RX_NULL_SYMB &&
-       x_re_ptr[3][M_layer_symb-1] == RX_NULL_SYMB &&
-       x_im_ptr[3][M_layer_symb-1] == RX_NULL_SYMB)
-    {
-        *M_symb = *M_symb - 2;
-    }
-    for(i=0; i<M_layer_symb; i++)
+    // Map the positive and negative spectrum, skipping DC
+    for(i=0; i<16; i++)
     {
-        for(p=0; p<N_ant; p++)
+        out = &phy_struct->s2s_out[i*N];
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+        memcpy(&subframe->rx_symb[i][N_sc], &out[1],      sizeof(fftwf_complex)*N_sc);
+        memcpy(&subframe->rx_symb[i][0],    &out[N-N_sc], sizeof(fftwf_complex)*N_sc);
+#else
+        symb_re = &subframe->rx_symb_re[i][0];
+        symb_im = &subframe->rx_symb_im[i][0];
+        for(j=0; j<N_sc; j++)
         {
-            d_re[i*N_ant+p] = x_re_ptr[p][i];
-            d_im[i*N_ant+p] = x_im_ptr[p][i];
+            symb_re[N_sc+j]   = out[j+1][0];
+            symb_im[N_sc+j]   = out[j+1][1];
+            symb_re[N_sc-j-1] = out[N-j-1][0];
+            symb_im[N_sc-j-1] = out[N-j-1][1];
         }
+#endif
     }
 }
 
 /*********************************************************************
-    Name: pre_coder_dl
+    Name: samples_to_subframe_ul
 
-    Description: Generates a block of vectors to be mapped onto
-                 resources on each downlink antenna port
+    Description: Converts the I/Q samples of an uplink subframe to
+                 subcarrier symbols using a single batched FFT, reading
+                 every stride'th float so that both split and
+                 interleaved sample buffers can be used
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
+*********************************************************************/
+void samples_to_subframe_ul(LIBLTE_PHY_STRUCT          *phy_struct,
+                            float                      *samps_re,
+                            float                      *samps_im,
+                            uint32                      stride,
+                            LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+{
+    fftwf_complex *in;
+    fftwf_complex *out;
+    float         *x_re;
+    float         *x_im;
+    float         *rot_re = phy_struct->s2s_ul_rot_re;
+    float         *rot_im = phy_struct->s2s_ul_rot_im;
+#ifndef LIBLTE_PHY_INTERLEAVED_IQ
+    float         *symb_re;
+    float         *symb_im;
+#endif
+    uint32         N      = phy_struct->N_samps_per_symb;
+    uint32         N_sc   = phy_struct->FFT_size - (phy_struct->FFT_pad_size*2);
+    uint32         index;
+    uint32         idx;
+    uint32         i;
+    uint32         j;
+
+    // Gather the useful part of every symbol and shift it down by half
+    // a subcarrier, so that the UL subcarriers land on the N point FFT
+    // bins instead of the odd bins of a zero padded 2N point FFT
+    for(i=0; i<14; i++)
+    {
+        index = (i/7)*phy_struct->N_samps_per_slot;
+        index += phy_struct->N_samps_cp_l_0 - 1 + (i%7)*(N + phy_struct->N_samps_cp_l_else);
+        x_re  = &samps_re[index*stride];
+        x_im  = &samps_im[index*stride];
+        in    = &phy_struct->s2s_in[i*N];
+        for(j=0; j<N; j++)
+        {
+            in[j][0] = x_re[j*stride]*rot_re[j] - x_im[j*stride]*rot_im[j];
+            in[j][1] = x_re[j*stride]*rot_im[j] + x_im[j*stride]*rot_re[j];
+        }
+    }
+    fftwf_execute(phy_struct->samps_to_symbs_ul_subfr_plan);
+
+    for(i=0; i<14; i++)
+    {
+        out = &phy_struct->s2s_out[i*N];
+        idx = (phy_struct->FFT_pad_size + phy_struct->FFT_size/2) % phy_struct->FFT_size;
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+        // The band wraps around the end of the FFT at most once
+        j = phy_struct->FFT_size - idx;
+        if(j > N_sc)
+        {
+            j = N_sc;
+        }
+        memcpy(&subframe->rx_symb[i][0], &out[idx], sizeof(fftwf_complex)*j);
+        memcpy(&subframe->rx_symb[i][j], &out[0],   sizeof(fftwf_complex)*(N_sc - j));
+#else
+        symb_re = &subframe->rx_symb_re[i][0];
+        symb_im = &subframe->rx_symb_im[i][0];
+        for(j=0; j<N_sc; j++)
+        {
+            symb_re[j] = out[idx][0];
+            symb_im[j] = out[idx][1];
+            if(++idx == phy_struct->FFT_size)
+            {
+                idx = 0;
+            }
+        }
+#endif
+    }
+}
 
-    NOTES: Currently only supports signle antenna or TX diversity
+/*********************************************************************
+    Name: modulation_mapper
+
+    Description: Maps binary digits to complex-valued modulation
+                 symbols using precomputed constellation tables.  A
+                 partial last symbol is padded with zeros.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
-void pre_coder_dl(float                          *x_re,
-                  float                          *x_im,
-                  uint32                          M_layer_symb,
-                  uint8                           N_ant,
-                  LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
-                  float                          *y_re,
-                  float                          *y_im,
-                  uint32                          y_len,
-                  uint32                         *M_ap_symb)
+void modulation_mapper(uint8                           *bits,
+                       uint32                           N_bits,
+                       LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
+                       float                           *d_re,
+                       float                           *d_im,
+                       uint32                          *M_symb)
 {
-    float  *x_re_ptr[N_ant];
-    float  *x_im_ptr[N_ant];
-    float  *y_re_ptr[N_ant];
-    float  *y_im_ptr[N_ant];
-    float   one_over_sqrt_2 = 1/sqrt(2);
-    uint32  i;
-    uint32  p;
+    MOD_TABLES_STRUCT *tables = mod_tables();
+    uint32             Q_m    = MOD_Q_M[type];
+    uint32             i;
+    uint32             j;
+    uint32             idx;
 
-    // Index all arrays
-    for(p=0; p<N_ant; p++)
+    *M_symb = (N_bits + Q_m - 1)/Q_m;
+    for(i=0; i<*M_symb; i++)
     {
-        x_re_ptr[p] = &x_re[p*M_layer_symb];
-        x_im_ptr[p] = &x_im[p*M_layer_symb];
-        y_re_ptr[p] = &y_re[p*y_len];
-        y_im_ptr[p] = &y_im[p*y_len];
+        idx = 0;
+        for(j=0; j<Q_m; j++)
+        {
+            idx <<= 1;
+            if((i*Q_m + j) < N_bits)
+            {
+                idx |= bits[i*Q_m + j] & 1;
+            }
+        }
+        d_re[i] = tables->symb_re[type][idx];
+        d_im[i] = tables->symb_im[type][idx];
     }
+}
 
-    if(N_ant == 1)
+/*********************************************************************
+    Name: liblte_phy_modulation_mapper_packed
+
+    Description: Maps packed binary digits, most significant bit
+                 first, to complex-valued modulation symbols.  Whole
+                 bytes are mapped to groups of symbols with a single
+                 table lookup.  A partial last symbol is padded with
+                 zeros.
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+*********************************************************************/
+void liblte_phy_modulation_mapper_packed(uint8                           *bytes,
+                                         uint32                           N_bits,
+                                         LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
+                                         float                           *d_re,
+                                         float                           *d_im,
+                                         uint32                          *M_symb)
+{
+    MOD_TABLES_STRUCT *tables = mod_tables();
+    uint32             Q_m    = MOD_Q_M[type];
+    uint32             i      = 0;
+    uint32             j;
+    uint32             k;
+    uint32             idx;
+    uint32             word;
+
+    *M_symb = (N_bits + Q_m - 1)/Q_m;
+    if(LIBLTE_PHY_MODULATION_TYPE_QPSK == type)
     {
-        // 3GPP TS 36.211 v10.1.0 section 6.3.4.1
-        *M_ap_symb = M_layer_symb;
-        for(i=0; i<*M_ap_symb; i++)
+        // 4 symbols per byte
+        for(j=0; j<N_bits/8; j++)
         {
-            y_re_ptr[0][i] = x_re_ptr[0][i];
-            y_im_ptr[0][i] = x_im_ptr[0][i];
+            memcpy(&d_re[i], tables->qpsk_re[bytes[j]], sizeof(float)*4);
+            memcpy(&d_im[i], tables->qpsk_im[bytes[j]], sizeof(float)*4);
+            i += 4;
         }
-    }else if(N_ant == 2){
-        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type)
+    }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == type){
+        // 2 symbols per byte
+        for(j=0; j<N_bits/8; j++)
         {
-            // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
-            *M_ap_symb = 2*M_layer_symb;
-            for(i=0; i<M_layer_symb; i++)
-            {
-                y_re_ptr[0][2*i+0] = +one_over_sqrt_2 * x_re_ptr[0][i];
-                y_im_ptr[0][2*i+0] = +one_over_sqrt_2 * x_im_ptr[0][i];
-                y_re_ptr[1][2*i+0] = -one_over_sqrt_2 * x_re_ptr[1][i];
-                y_im_ptr[1][2*i+0] = +one_over_sqrt_2 * x_im_ptr[1][i];
-                y_re_ptr[0][2*i+1] = +one_over_sqrt_2 * x_re_ptr[1][i];
-                y_im_ptr[0][2*i+1] = +one_over_sqrt_2 * x_im_ptr[1][i];
-                y_re_ptr[1][2*i+1] = +one_over_sqrt_2 * x_re_ptr[0][i];
-                y_im_ptr[1][2*i+1] = -one_over_sqrt_2 * x_im_ptr[0][i];
-            }
-        }else{
-            // FIXME: Currently only supporting TX Diversity
+            memcpy(&d_re[i], tables->qam16_re[bytes[j]], sizeof(float)*2);
+            memcpy(&d_im[i], tables->qam16_im[bytes[j]], sizeof(float)*2);
+            i += 2;
         }
-    }else{
-        if(LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY == type)
+    }else if(LIBLTE_PHY_MODULATION_TYPE_64QAM == type){
+        // 4 symbols per 3 bytes
+        for(j=0; j<N_bits/24; j++)
         {
-            // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
-            if(x_re_ptr[2][M_layer_symb-1] == TX_NULL_SYMB &&
-               x_im_ptr[2][M_layer_symb-1] == TX_NULL_SYMB &&
-               x_re_ptr[3][M_layer_symb-1] == TX_NULL_SYMB &&
-               x_im_ptr[3][M_layer_symb-1] == TX_NULL_SYMB)
+            word = (bytes[j*3] << 16) | (bytes[j*3+1] << 8) | bytes[j*3+2];
+            for(k=0; k<4; k++)
             {
-                *M_ap_symb = 4*M_layer_symb - 2;
-            }else{
-                *M_ap_symb = 4*M_layer_symb;
+                idx       = (word >> (18 - 6*k)) & 0x3F;
+                d_re[i+k] = tables->symb_re[type][idx];
+                d_im[i+k] = tables->symb_im[type][idx];
             }
-            for(i=0; i<M_layer_symb; i++)
+            i += 4;
+        }
+    }
+
+    // Remaining symbols, one at a time
+    for(; i<*M_symb; i++)
+    {
+        idx = 0;
+        for(j=0; j<Q_m; j++)
+        {
+            k     = i*Q_m + j;
+            idx <<= 1;
+            if(k < N_bits)
             {
-                y_re_ptr[0][4*i+0] = +one_over_sqrt_2 * x_re_ptr[0][i];
-                y_im_ptr[0][4*i+0] = +one_over_sqrt_2 * x_im_ptr[0][i];
-                y_re_ptr[1][4*i+0] = 0;
-                y_im_ptr[1][4*i+0] = 0;
-                y_re_ptr[2][4*i+0] = -one_over_sqrt_2 * x_re_ptr[1][i];
-                y_im_ptr[2][4*i+0] = +one_over_sqrt_2 * x_im_ptr[1][i];
-                y_re_ptr[3][4*i+0] = 0;
-                y_im_ptr[3][4*i+0] = 0;
-                y_re_ptr[0][4*i+1] = +one_over_sqrt_2 * x_re_ptr[1][i];
-                y_im_ptr[0][4*i+1] = +one_over_sqrt_2 * x_im_ptr[1][i];
-                y_re_ptr[1][4*i+1] = 0;
-                y_im_ptr[1][4*i+1] = 0;
-                y_re_ptr[2][4*i+1] = +one_over_sqrt_2 * x_re_ptr[0][i];
-                y_im_ptr[2][4*i+1] = -one_over_sqrt_2 * x_im_ptr[0][i];
-                y_re_ptr[3][4*i+1] = 0;
-                y_im_ptr[3][4*i+1] = 0;
-                y_re_ptr[0][4*i+2] = 0;
-                y_im_ptr[0][4*i+2] = 0;
-                y_re_ptr[1][4*i+2] = +one_over_sqrt_2 * x_re_ptr[2][i];
-                y_im_ptr[1][4*i+2] = +one_over_sqrt_2 * x_im_ptr[2][i];
-                y_re_ptr[2][4*i+2] = 0;
-                y_im_ptr[2][4*i+2] = 0;
-                y_re_ptr[3][4*i+2] = -one_over_sqrt_2 * x_re_ptr[3][i];
-                y_im_ptr[3][4*i+2] = +one_over_sqrt_2 * x_im_ptr[3][i];
-                y_re_ptr[0][4*i+3] = 0;
-                y_im_ptr[0][4*i+3] = 0;
-                y_re_ptr[1][4*i+3] = +one_over_sqrt_2 * x_re_ptr[3][i];
-                y_im_ptr[1][4*i+3] = +one_over_sqrt_2 * x_im_ptr[3][i];
-                y_re_ptr[2][4*i+3] = 0;
-                y_im_ptr[2][4*i+3] = 0;
-                y_re_ptr[3][4*i+3] = +one_over_sqrt_2 * x_re_ptr[2][i];
-                y_im_ptr[3][4*i+3] = -one_over_sqrt_2 * x_im_ptr[2][i];
+                idx |= (bytes[k/8] >> (7 - (k%8))) & 1;
             }
-        }else{
-            // FIXME: Currently only supporting TX Diversity
+        }
+        d_re[i] = tables->symb_re[type][idx];
+        d_im[i] = tables->symb_im[type][idx];
+    }
+}
+
+/*********************************************************************
+    Name: mod_tables
+
+    Description: Returns the modulation mapper constellation tables,
+                 calculating them on first use
+
+    Document Reference: N/A
+*********************************************************************/
+MOD_TABLES_STRUCT* mod_tables(void)
+{
+    // Function scope statics are initialized exactly once, even with
+    // multiple threads
+    static MOD_TABLES_STRUCT tables;
+    static bool              tables_ready = mod_tables_pre_calc(&tables);
+
+    (void)tables_ready;
+
+    return(&tables);
+}
+
+/*********************************************************************
+    Name: mod_tables_pre_calc
+
+    Description: Calculates the constellation tables for a single
+                 symbol of each modulation type, and for all symbols
+                 of a byte for QPSK and 16QAM
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+*********************************************************************/
+bool mod_tables_pre_calc(MOD_TABLES_STRUCT *tables)
+{
+    float  one_over_sqrt_2  = 1/sqrt(2);
+    float  one_over_sqrt_10 = 1/sqrt(10);
+    float  one_over_sqrt_42 = 1/sqrt(42);
+    uint32 b[6];
+    uint32 i;
+    uint32 j;
+
+    for(i=0; i<64; i++)
+    {
+        for(j=0; j<6; j++)
+        {
+            b[j] = (i >> (5-j)) & 1;
+        }
+
+        // 3GPP TS 36.211 v10.1.0 section 7.1.1
+        if(i < 2)
+        {
+            tables->symb_re[LIBLTE_PHY_MODULATION_TYPE_BPSK][i] = (1 - 2*(float)b[5])*one_over_sqrt_2;
+            tables->symb_im[LIBLTE_PHY_MODULATION_TYPE_BPSK][i] = (1 - 2*(float)b[5])*one_over_sqrt_2;
+        }
+
+        // 3GPP TS 36.211 v10.1.0 section 7.1.2
+        if(i < 4)
+        {
+            tables->symb_re[LIBLTE_PHY_MODULATION_TYPE_QPSK][i] = (1 - 2*(float)b[4])*one_over_sqrt_2;
+            tables->symb_im[LIBLTE_PHY_MODULATION_TYPE_QPSK][i] = (1 - 2*(float)b[5])*one_over_sqrt_2;
+        }
+
+        // 3GPP TS 36.211 v10.1.0 section 7.1.3
+        if(i < 16)
+        {
+            tables->symb_re[LIBLTE_PHY_MODULATION_TYPE_16QAM][i] = (1 - 2*(float)b[2])*(1 + 2*(float)b[4])*one_over_sqrt_10;
+            tables->symb_im[LIBLTE_PHY_MODULATION_TYPE_16QAM][i] = (1 - 2*(float)b[3])*(1 + 2*(float)b[5])*one_over_sqrt_10;
+        }
+
+        // 3GPP TS 36.211 v10.1.0 section 7.1.4
+        tables->symb_re[LIBLTE_PHY_MODULATION_TYPE_64QAM][i] = (1 - 2*(float)b[0])*(4 - (1 - 2*(float)b[2])*(2 - (1 - 2*(float)b[4])))*one_over_sqrt_42;
+        tables->symb_im[LIBLTE_PHY_MODULATION_TYPE_64QAM][i] = (1 - 2*(float)b[1])*(4 - (1 - 2*(float)b[3])*(2 - (1 - 2*(float)b[5])))*one_over_sqrt_42;
+    }
+
+    for(i=0; i<256; i++)
+    {
+        for(j=0; j<4; j++)
+        {
+            tables->qpsk_re[i][j] = tables->symb_re[LIBLTE_PHY_MODULATION_TYPE_QPSK][(i >> (6-2*j)) & 0x3];
+            tables->qpsk_im[i][j] = tables->symb_im[LIBLTE_PHY_MODULATION_TYPE_QPSK][(i >> (6-2*j)) & 0x3];
+        }
+        for(j=0; j<2; j++)
+        {
+            tables->qam16_re[i][j] = tables->symb_re[LIBLTE_PHY_MODULATION_TYPE_16QAM][(i >> (4-4*j)) & 0xF];
+            tables->qam16_im[i][j] = tables->symb_im[LIBLTE_PHY_MODULATION_TYPE_16QAM][(i >> (4-4*j)) & 0xF];
         }
     }
+
+    return(true);
 }
 
 /*********************************************************************
-    Name: pre_decoder_and_matched_filter_dl
-
-    Description: Matched filters and unmaps a block of vectors from
-                 resources on each downlink antenna port
+    Name: modulation_demapper
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.3.4
+    Description: Maps complex-valued modulation symbols to max-log
+                 LLR soft bits, positive for a 0 bit.  The Gray coded
+                 constellations let each LLR be computed from a single
+                 I or Q component with piecewise linear functions.
+                 noise_var is the noise variance of the symbols and
+                 LLRs are quantized to 1/LLR_INT8_SCALE.
 
-    NOTES: Currently only supports single antenna or TX diversity
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
-void pre_decoder_and_matched_filter_dl(float                          *y_re,
-                                       float                          *y_im,
-                                       float                          *h_re,
-                                       float                          *h_im,
-                                       uint32                          h_len,
-                                       uint32                          M_ap_symb,
-                                       uint8                           N_ant,
-                                       LIBLTE_PHY_PRE_CODER_TYPE_ENUM  type,
-                                       float                          *x_re,
-                                       float                          *x_im,
-                                       uint32                         *M_layer_symb)
+void modulation_demapper(float                           *d_re,
+                         float                           *d_im,
+                         uint32                           M_symb,
+                         LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
+                         float                            noise_var,
+                         int8                            *bits,
+                         uint32                          *N_bits)
 {
-    float  *h_re_ptr[N_ant];
-    float  *h_im_ptr[N_ant];
-    float  *x_re_ptr[N_ant];
-    float  *x_im_ptr[N_ant];
-    float   h0_abs;
-    float   h1_abs;
-    float   h2_abs;
-    float   h3_abs;
-    float   h_norm;
-    float   h_norm_0_2;
-    float   h_norm_1_3;
-    uint32  i;
-    uint32  p;
+    // Function scope statics are initialized exactly once, even with
+    // multiple threads
+    static LIBLTE_PHY_TURBO_KERNEL_ENUM kernel = turbo_kernel_detect();
+    float                               s;
+    float                               gain;
+    float                               T[2] = {0, 0};
+    uint32                              Q_m;
+    uint32                              i;
 
-    // Index all arrays
-    for(p=0; p<N_ant; p++)
+    if(noise_var < LLR_MIN_NOISE_VAR)
     {
-        h_re_ptr[p] = &h_re[p*h_len];
-        h_im_ptr[p] = &h_im[p*h_len];
-        x_re_ptr[p] = &x_re[p*(M_ap_symb/N_ant)];
-        x_im_ptr[p] = &x_im[p*(M_ap_symb/N_ant)];
+        noise_var = LLR_MIN_NOISE_VAR;
     }
 
-    if(N_ant == 1)
+    if(LIBLTE_PHY_MODULATION_TYPE_BPSK == type)
     {
-        // 3GPP TS 36.211 v10.1.0 section 6.3.4.1
-        *M_layer_symb = M_ap_symb;
-        for(i=0; i<*M_layer_symb; i++)
-        {
-            h_norm         = (h_re_ptr[0][i] * h_re_ptr[0][i] +
-                              h_im_ptr[0][i] * h_im_ptr[0][i]);
-            x_re_ptr[0][i] = (y_re[i]*h_re_ptr[0][i] + y_im[i]*h_im_ptr[0][i]) / h_norm;
-            x_im_ptr[0][i] = (y_im[i]*h_re_ptr[0][i] - y_re[i]*h_im_ptr[0][i]) / h_norm;
-        }
-    }else if(N_ant == 2){
-        // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
-        *M_layer_symb = M_ap_symb/2;
-        for(i=0; i<*M_layer_symb; i++)
-        {
-            h0_abs         = (h_re_ptr[0][i*2] * h_re_ptr[0][i*2] +
-                              h_im_ptr[0][i*2] * h_im_ptr[0][i*2]);
-            h1_abs         = (h_re_ptr[1][i*2] * h_re_ptr[1][i*2] +
-                              h_im_ptr[1][i*2] * h_im_ptr[1][i*2]);
-            h_norm         = sqrt(h0_abs*h0_abs + h1_abs*h1_abs);
-            x_re_ptr[0][i] = (h_re_ptr[0][i*2] * y_re[i*2+0] +
-                              h_im_ptr[0][i*2] * y_im[i*2+0] +
-                              h_re_ptr[1][i*2] * y_re[i*2+1] +
-                              h_im_ptr[1][i*2] * y_im[i*2+1]) / h_norm;
-            x_im_ptr[0][i] = (h_re_ptr[0][i*2] * y_im[i*2+0] -
-                              h_im_ptr[0][i*2] * y_re[i*2+0] -
-                              h_re_ptr[1][i*2] * y_im[i*2+1] +
-                              h_im_ptr[1][i*2] * y_re[i*2+1]) / h_norm;
-            x_re_ptr[1][i] = (-h_re_ptr[1][i*2] * y_re[i*2+0] -
-                              h_im_ptr[1][i*2] * y_im[i*2+0] +
-                              h_re_ptr[0][i*2] * y_re[i*2+1] +
-                              h_im_ptr[0][i*2] * y_im[i*2+1]) / h_norm;
-            x_im_ptr[1][i] = (h_re_ptr[1][i*2] * y_im[i*2+0] -
-                              h_im_ptr[1][i*2] * y_re[i*2+0] +
-                              h_re_ptr[0][i*2] * y_im[i*2+1] -
-                              h_im_ptr[0][i*2] * y_re[i*2+1]) / h_norm;
-        }
-    }else{ // N_ant == 4
-        // 3GPP TS 36.211 v10.1.0 section 6.3.4.3
-        *M_layer_symb = M_ap_symb/4;
-        for(i=0; i<*M_layer_symb; i++)
+        // 3GPP TS 36.211 v10.1.0 section 7.1.1, both components carry
+        // the bit
+        s       = 1/sqrt(2);
+        gain    = LLR_INT8_SCALE*4*s/noise_var;
+        *N_bits = M_symb;
+        for(i=0; i<M_symb; i++)
         {
-            h0_abs         = (h_re_ptr[0][i*4+0] * h_re_ptr[0][i*4+0] +
-                              h_im_ptr[0][i*4+0] * h_im_ptr[0][i*4+0]);
-            h1_abs         = (h_re_ptr[1][i*4+2] * h_re_ptr[1][i*4+2] +
-                              h_im_ptr[1][i*4+2] * h_im_ptr[1][i*4+2]);
-            h2_abs         = (h_re_ptr[2][i*4+0] * h_re_ptr[2][i*4+0] +
-                              h_im_ptr[2][i*4+0] * h_im_ptr[2][i*4+0]);
-            h3_abs         = (h_re_ptr[3][i*4+2] * h_re_ptr[3][i*4+2] +
-                              h_im_ptr[3][i*4+2] * h_im_ptr[3][i*4+2]);
-            h_norm_0_2     = sqrt(h0_abs*h0_abs + h2_abs*h2_abs);
-            h_norm_1_3     = sqrt(h1_abs*h1_abs + h3_abs*h3_abs);
-            x_re_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_re[i*4+0] +
-                              h_im_ptr[0][i*4+0] * y_im[i*4+0] +
-                              h_re_ptr[2][i*4+0] * y_re[i*4+1] +
-                              h_im_ptr[2][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
-            x_im_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_im[i*4+0] -
-                              h_im_ptr[0][i*4+0] * y_re[i*4+0] -
-                              h_re_ptr[2][i*4+0] * y_im[i*4+1] +
-                              h_im_ptr[2][i*4+0] * y_re[i*4+1]) / h_norm_0_2;
-            x_re_ptr[1][i] = (-h_re_ptr[2][i*4+0] * y_re[i*4+0] -
-                              h_im_ptr[2][i*4+0] * y_im[i*4+0] +
-                              h_re_ptr[0][i*4+0] * y_re[i*4+1] +
-                              h_im_ptr[0][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
-            x_im_ptr[1][i] = -(-h_re_ptr[2][i*4+0] * y_im[i*4+0] +
-                               h_im_ptr[2][i*4+0] * y_re[i*4+0] -
-                               h_re_ptr[0][i*4+0] * y_im[i*4+1] +
-                               h_im_ptr[0][i*4+0] * y_re[i*4+1]) / h_norm_0_2;
-            x_re_ptr[2][i] = (h_re_ptr[1][i*4+2] * y_re[i*4+2] +
-                              h_im_ptr[1][i*4+2] * y_im[i*4+2] +
-                              h_re_ptr[3][i*4+2] * y_re[i*4+3] +
-                              h_im_ptr[3][i*4+2] * y_im[i*4+3]) / h_norm_1_3;
-            x_im_ptr[2][i] = (h_re_ptr[1][i*4+2] * y_im[i*4+2] -
-                              h_im_ptr[1][i*4+2] * y_re[i*4+2] -
-                              h_re_ptr[3][i*4+2] * y_im[i*4+3] +
-                              h_im_ptr[3][i*4+2] * y_re[i*4+3]) / h_norm_1_3;
-            x_re_ptr[3][i] = (-h_re_ptr[3][i*4+2] * y_re[i*4+2] -
-                              h_im_ptr[3][i*4+2] * y_im[i*4+2] +
-                              h_re_ptr[1][i*4+2] * y_re[i*4+3] +
-                              h_im_ptr[1][i*4+2] * y_im[i*4+3]) / h_norm_1_3;
-            x_im_ptr[3][i] = -(-h_re_ptr[3][i*4+2] * y_im[i*4+2] +
-                               h_im_ptr[3][i*4+2] * y_re[i*4+2] -
-                               h_re_ptr[1][i*4+2] * y_im[i*4+3] +
-                               h_im_ptr[1][i*4+2] * y_re[i*4+3]) / h_norm_1_3;
+            bits[i] = llr_quantize(gain*(d_re[i] + d_im[i]));
         }
-        if((M_ap_symb % 4) != 0)
-        {
-            *M_layer_symb  = (M_ap_symb+2)/4;
-            h0_abs         = (h_re_ptr[0][i*4+0] * h_re_ptr[0][i*4+0] +
-                              h_im_ptr[0][i*4+0] * h_im_ptr[0][i*4+0]);
-            h2_abs         = (h_re_ptr[2][i*4+0] * h_re_ptr[2][i*4+0] +
-                              h_im_ptr[2][i*4+0] * h_im_ptr[2][i*4+0]);
-            h_norm_0_2     = sqrt(h0_abs*h0_abs + h2_abs*h2_abs);
-            x_re_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_re[i*4+0] +
-                              h_im_ptr[0][i*4+0] * y_im[i*4+0] +
-                              h_re_ptr[2][i*4+0] * y_re[i*4+1] +
-                              h_im_ptr[2][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
-            x_im_ptr[0][i] = (h_re_ptr[0][i*4+0] * y_im[i*4+0] -
-                              h_im_ptr[0][i*4+0] * y_re[i*4+0] -
-                              h_re_ptr[2][i*4+0] * y_im[i*4+1] +
-                              h_im_ptr[2][i*4+0] * y_re[i*4+1]) / h_norm_0_2;
-            x_re_ptr[1][i] = (-h_re_ptr[2][i*4+0] * y_re[i*4+0] -
-                              h_im_ptr[2][i*4+0] * y_im[i*4+0] +
-                              h_re_ptr[0][i*4+0] * y_re[i*4+1] +
-                              h_im_ptr[0][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
-            x_im_ptr[1][i] = (-h_re_ptr[2][i*4+0] * y_im[i*4+0] +
-                              h_im_ptr[2][i*4+0] * y_re[i*4+0] -
-                              h_re_ptr[0][i*4+0] * y_re[i*4+1] +
-                              h_im_ptr[0][i*4+0] * y_im[i*4+1]) / h_norm_0_2;
-            x_re_ptr[2][i] = RX_NULL_SYMB;
-            x_im_ptr[2][i] = RX_NULL_SYMB;
-            x_re_ptr[3][i] = RX_NULL_SYMB;
-            x_im_ptr[3][i] = RX_NULL_SYMB;
+    }else{
+        if(LIBLTE_PHY_MODULATION_TYPE_QPSK == type)
+        {
+            // 3GPP TS 36.211 v10.1.0 section 7.1.2
+            Q_m  = 2;
+            s    = 1/sqrt(2);
+        }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == type){
+            // 3GPP TS 36.211 v10.1.0 section 7.1.3
+            Q_m  = 4;
+            s    = 1/sqrt(10);
+            T[0] = 2*s;
+        }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == type
+            // 3GPP TS 36.211 v10.1.0 section 7.1.4
+            Q_m  = 6;
+            s    = 1/sqrt(42);
+            T[0] = 4*s;
+            T[1] = 2*s;
+        }
+        gain    = LLR_INT8_SCALE*4*s/noise_var;
+        *N_bits = M_symb*Q_m;
+
+#if defined(__x86_64__) || defined(__i386__)
+        if(LIBLTE_PHY_TURBO_KERNEL_AVX2 == kernel)
+        {
+            llr_demap_avx2(d_re, d_im, M_symb, Q_m, T, gain, bits);
+        }else if(LIBLTE_PHY_TURBO_KERNEL_SSE4_1 == kernel){
+            llr_demap_sse4_1(d_re, d_im, M_symb, Q_m, T, gain, bits);
+        }else{
+            llr_demap_scalar(d_re, d_im, M_symb, Q_m, T, gain, bits);
         }
+#else
+        (void)kernel;
+        llr_demap_scalar(d_re, d_im, M_symb, Q_m, T, gain, bits);
+#endif
     }
 }
 
 /*********************************************************************
-    Name: pcfich_channel_map
+    Name: llr_demap_scalar
 
-    Description: Channel maps the PCFICH
+    Description: Reference max-log LLR demapper for QPSK, 16QAM, and
+                 64QAM.  The first I/Q LLR pair is g*y and each
+                 following pair is g*(T[k-1] - |previous|).
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.7
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
-void pcfich_channel_map(LIBLTE_PHY_STRUCT          *phy_struct,
-                        LIBLTE_PHY_PCFICH_STRUCT   *pcfich,
-                        uint32                      N_id_cell,
-                        uint8                       N_ant,
-                        LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+void llr_demap_scalar(float  *d_re,
+                      float  *d_im,
+                      uint32  M_symb,
+                      uint32  Q_m,
+                      float  *T,
+                      float   gain,
+                      int8   *bits)
 {
-    uint32 N_bits;
-    uint32 M_symb;
-    uint32 M_layer_symb;
-    uint32 M_ap_symb;
-    uint32 c_init;
-    uint32 k_hat;
+    float  f_re;
+    float  f_im;
     uint32 i;
-    uint32 j;
-    uint32 p;
-    uint32 idx;
+    uint32 k;
 
-    // Encode, 3GPP TS 36.211 v10.1.0 section 6.7
-    cfi_channel_encode(phy_struct,
-                       pcfich->cfi,
-                       phy_struct->pdcch_encode_bits,
-                       &N_bits);
-    c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
-    generate_prs_c(c_init, N_bits, phy_struct->pdcch_c);
-    for(i=0; i<N_bits; i++)
+    for(i=0; i<M_symb; i++)
     {
-        phy_struct->pdcch_scramb_bits[i] = phy_struct->pdcch_encode_bits[i] ^ phy_struct->pdcch_c[i];
+        f_re = d_re[i];
+        f_im = d_im[i];
+        for(k=0; k<Q_m/2; k++)
+        {
+            if(k > 0)
+            {
+                f_re = T[k-1] - fabsf(f_re);
+                f_im = T[k-1] - fabsf(f_im);
+            }
+            bits[i*Q_m+2*k]   = llr_quantize(gain*f_re);
+            bits[i*Q_m+2*k+1] = llr_quantize(gain*f_im);
+        }
     }
-    modulation_mapper(phy_struct->pdcch_scramb_bits,
-                      N_bits,
-                      LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                      phy_struct->pdcch_d_re,
-                      phy_struct->pdcch_d_im,
-                      &M_symb);
-    layer_mapper_dl(phy_struct->pdcch_d_re,
-                    phy_struct->pdcch_d_im,
-                    M_symb,
-                    N_ant,
-                    1,
-                    LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                    phy_struct->pdcch_x_re,
-                    phy_struct->pdcch_x_im,
-                    &M_layer_symb);
-    pre_coder_dl(phy_struct->pdcch_x_re,
-                 phy_struct->pdcch_x_im,
-                 M_layer_symb,
-                 N_ant,
-                 LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                 phy_struct->pdcch_y_re[0],
-                 phy_struct->pdcch_y_im[0],
-                 576,
-                 &M_ap_symb);
-    // Map the symbols to resource elements, 3GPP TS 36.211 v10.1.0 section 6.7.4
-    pcfich->N_reg = 4;
-    k_hat         = (phy_struct->N_sc_rb_dl/2)*(N_id_cell % (2*phy_struct->N_rb_dl));
-    for(i=0; i<pcfich->N_reg; i++)
+}
+
+/*********************************************************************
+    Name: llr_quantize
+
+    Description: Saturates an LLR to +/-127 and rounds it to the
+                 nearest integer
+
+    Document Reference: N/A
+*********************************************************************/
+int8 llr_quantize(float llr)
+{
+    if(llr > 127)
     {
-        pcfich->k[i] = (k_hat + (i*phy_struct->N_rb_dl/2)*phy_struct->N_sc_rb_dl/2) % (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl);
-        pcfich->n[i] = (pcfich->k[i]/6) - 0.5;
-        for(p=0; p<N_ant; p++)
+        llr = 127;
+    }else if(llr < -127){
+        llr = -127;
+    }
+
+    return((int8)lrintf(llr));
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/*********************************************************************
+    Name: llr_demap_sse4_1
+
+    Description: SSE4.1 version of llr_demap_scalar, 4 symbols at a
+                 time
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+*********************************************************************/
+__attribute__((target("sse4.1")))
+void llr_demap_sse4_1(float  *d_re,
+                      float  *d_im,
+                      uint32  M_symb,
+                      uint32  Q_m,
+                      float  *T,
+                      float   gain,
+                      int8   *bits)
+{
+    __m128  g     = _mm_set1_ps(gain);
+    __m128  max_v = _mm_set1_ps(127);
+    __m128  min_v = _mm_set1_ps(-127);
+    __m128  abs_m = _mm_set1_ps(-0.0f);
+    __m128  f_re;
+    __m128  f_im;
+    __m128i q_re;
+    __m128i q_im;
+    __m128i pair[3];
+    uint16  tmp[3][4];
+    uint32  i;
+    uint32  j;
+    uint32  k;
+
+    for(i=0; i+4<=M_symb; i+=4)
+    {
+        f_re = _mm_loadu_ps(&d_re[i]);
+        f_im = _mm_loadu_ps(&d_im[i]);
+        for(k=0; k<Q_m/2; k++)
         {
-            idx = 0;
-            for(j=0; j<6; j++)
+            if(k > 0)
+            {
+                f_re = _mm_sub_ps(_mm_set1_ps(T[k-1]), _mm_andnot_ps(abs_m, f_re));
+                f_im = _mm_sub_ps(_mm_set1_ps(T[k-1]), _mm_andnot_ps(abs_m, f_im));
+            }
+            q_re    = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(g, f_re), min_v), max_v));
+            q_im    = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(g, f_im), min_v), max_v));
+            q_re    = _mm_packs_epi32(q_re, q_re);
+            q_im    = _mm_packs_epi32(q_im, q_im);
+            pair[k] = _mm_unpacklo_epi16(q_re, q_im);
+            pair[k] = _mm_packs_epi16(pair[k], pair[k]);
+        }
+
+        // Each I/Q pair is 16 bits, interleave them per symbol
+        if(2 == Q_m)
+        {
+            _mm_storel_epi64((__m128i *)&bits[i*2], pair[0]);
+        }else if(4 == Q_m){
+            _mm_storeu_si128((__m128i *)&bits[i*4], _mm_unpacklo_epi16(pair[0], pair[1]));
+        }else{
+            for(k=0; k<3; k++)
             {
-                if((N_id_cell % 3) != (j % 3))
+                _mm_storel_epi64((__m128i *)tmp[k], pair[k]);
+            }
+            for(j=0; j<4; j++)
+            {
+                for(k=0; k<3; k++)
                 {
-                    subframe->tx_symb_re[p][0][pcfich->k[i]+j] = phy_struct->pdcch_y_re[p][idx+(i*4)];
-                    subframe->tx_symb_im[p][0][pcfich->k[i]+j] = phy_struct->pdcch_y_im[p][idx+(i*4)];
-                    idx++;
+                    memcpy(&bits[(i+j)*6+2*k], &tmp[k][j], 2);
                 }
             }
         }
     }
+
+    llr_demap_scalar(&d_re[i], &d_im[i], M_symb-i, Q_m, T, gain, &bits[i*Q_m]);
 }
 
 /*********************************************************************
-    Name: pcfich_channel_demap
+    Name: llr_demap_avx2
 
-    Description: Channel demaps the PCFICH
+    Description: AVX2 version of llr_demap_scalar, 8 symbols at a
+                 time
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.7
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
 *********************************************************************/
-void pcfich_channel_demap(LIBLTE_PHY_STRUCT          *phy_struct,
-                          LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
-                          uint32                      N_id_cell,
-                          uint8                       N_ant,
-                          LIBLTE_PHY_PCFICH_STRUCT   *pcfich,
-                          uint32                     *N_bits)
+__attribute__((target("avx2")))
+void llr_demap_avx2(float  *d_re,
+                    float  *d_im,
+                    uint32  M_symb,
+                    uint32  Q_m,
+                    float  *T,
+                    float   gain,
+                    int8   *bits)
 {
-    uint32 M_layer_symb;
-    uint32 M_symb;
-    uint32 c_init;
-    uint32 k_hat;
-    uint32 i;
-    uint32 j;
-    uint32 p;
-    uint32 idx;
+    __m256  g     = _mm256_set1_ps(gain);
+    __m256  max_v = _mm256_set1_ps(127);
+    __m256  min_v = _mm256_set1_ps(-127);
+    __m256  abs_m = _mm256_set1_ps(-0.0f);
+    __m256  f_re;
+    __m256  f_im;
+    __m256i q_re;
+    __m256i q_im;
+    __m128i r16;
+    __m128i i16;
+    __m128i pair[3];
+    uint16  tmp[3][8];
+    uint32  i;
+    uint32  j;
+    uint32  k;
 
-    // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.7.4
-    pcfich->N_reg = 4;
-    k_hat         = (phy_struct->N_sc_rb_dl/2)*(N_id_cell % (2*phy_struct->N_rb_dl));
-    for(i=0; i<pcfich->N_reg; i++)
+    for(i=0; i+8<=M_symb; i+=8)
     {
-        pcfich->k[i] = (k_hat + (i*phy_struct->N_rb_dl/2)*phy_struct->N_sc_rb_dl/2) % (phy_struct->N_rb_dl*phy_struct->N_sc_rb_dl);
-        pcfich->n[i] = (pcfich->k[i]/6) - 0.5;
+        f_re = _mm256_loadu_ps(&d_re[i]);
+        f_im = _mm256_loadu_ps(&d_im[i]);
+        for(k=0; k<Q_m/2; k++)
+        {
+            if(k > 0)
+            {
+                f_re = _mm256_sub_ps(_mm256_set1_ps(T[k-1]), _mm256_andnot_ps(abs_m, f_re));
+                f_im = _mm256_sub_ps(_mm256_set1_ps(T[k-1]), _mm256_andnot_ps(abs_m, f_im));
+            }
+            q_re    = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(g, f_re), min_v), max_v));
+            q_im    = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(g, f_im), min_v), max_v));
+            r16     = _mm_packs_epi32(_mm256_castsi256_si128(q_re), _mm256_extracti128_si256(q_re, 1));
+            i16     = _mm_packs_epi32(_mm256_castsi256_si128(q_im), _mm256_extracti128_si256(q_im, 1));
+            pair[k] = _mm_packs_epi16(_mm_unpacklo_epi16(r16, i16), _mm_unpackhi_epi16(r16, i16));
+        }
 
-        // Extract resource elements and channel estimate
-        idx = 0;
-        for(j=0; j<6; j++)
+        // Each I/Q pair is 16 bits, interleave them per symbol
+        if(2 == Q_m)
         {
-            if((N_id_cell % 3) != (j % 3))
+            _mm_storeu_si128((__m128i *)&bits[i*2], pair[0]);
+        }else if(4 == Q_m){
+            _mm_storeu_si128((__m128i *)&bits[i*4],    _mm_unpacklo_epi16(pair[0], pair[1]));
+            _mm_storeu_si128((__m128i *)&bits[i*4+16], _mm_unpackhi_epi16(pair[0], pair[1]));
+        }else{
+            for(k=0; k<3; k++)
             {
-                phy_struct->pdcch_y_est_re[idx+(i*4)] = subframe->rx_symb_re[0][pcfich->k[i]+j];
-                phy_struct->pdcch_y_est_im[idx+(i*4)] = subframe->rx_symb_im[0][pcfich->k[i]+j];
-                for(p=0; p<N_ant; p++)
+                _mm_storeu_si128((__m128i *)tmp[k], pair[k]);
+            }
+            for(j=0; j<8; j++)
+            {
+                for(k=0; k<3; k++)
                 {
-                    phy_struct->pdcch_c_est_re[p][idx+(i*4)] = subframe->rx_ce_re[p][0][pcfich->k[i]+j];
-                    phy_struct->pdcch_c_est_im[p][idx+(i*4)] = subframe->rx_ce_im[p][0][pcfich->k[i]+j];
+                    memcpy(&bits[(i+j)*6+2*k], &tmp[k][j], 2);
                 }
-                idx++;
             }
         }
     }
-    // Decode, 3GPP TS 36.211 v10.1.0 section 6.7
-    c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
-    generate_prs_c(c_init, 32, phy_struct->pdcch_c);
-    pre_decoder_and_matched_filter_dl(phy_struct->pdcch_y_est_re,
-                                      phy_struct->pdcch_y_est_im,
-                                      phy_struct->pdcch_c_est_re[0],
-                                      phy_struct->pdcch_c_est_im[0],
-                                      576,
-                                      16,
-                                      N_ant,
-                                      LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                                      phy_struct->pdcch_x_re,
-                                      phy_struct->pdcch_x_im,
-                                      &M_layer_symb);
-    layer_demapper_dl(phy_struct->pdcch_x_re,
-                      phy_struct->pdcch_x_im,
-                      M_layer_symb,
-                      N_ant,
-                      1,
-                      LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                      phy_struct->pdcch_d_re,
-                      phy_struct->pdcch_d_im,
-                      &M_symb);
-    modulation_demapper(phy_struct->pdcch_d_re,
-                        phy_struct->pdcch_d_im,
-                        M_symb,
-                        LIBLTE_PHY_MODULATION_TYPE_QPSK,
-                        phy_struct->pdcch_soft_bits,
-                        N_bits);
-    for(i=0; i<*N_bits; i++)
-    {
-        phy_struct->pdcch_descramb_bits[i] = (float)phy_struct->pdcch_soft_bits[i]*(1-2*(float)phy_struct->pdcch_c[i]);
-    }
+
+    llr_demap_scalar(&d_re[i], &d_im[i], M_symb-i, Q_m, T, gain, &bits[i*Q_m]);
 }
+#endif
 
 /*********************************************************************
-    Name: pdcch_permute_pre_calc
+    Name: generate_prs_c
 
-    Description: Pre calculates the PDCCH REG permutation.
+    Description: Generates the psuedo random sequence c
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.8.5
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
 *********************************************************************/
-void pdcch_permute_pre_calc(LIBLTE_PHY_STRUCT *phy_struct,
-                            uint32             N_ant,
-                            float              phich_res)
+void generate_prs_c(uint32  c_init,
+                    uint32  len,
+                    uint32 *c)
 {
     uint32 i;
     uint32 j;
-    uint32 k;
-    uint32 p;
-    uint32 idx;
-    uint32 C_cc_sb;
-    uint32 R_cc_sb;
-    uint32 N_dummy;
-    uint32 K_pi;
-    uint32 N_reg_rb = 3;
-    uint32 N_reg_pdcch;
-    uint32 N_symbs;
-    uint32 N_reg_pcfich = 4;
-    uint32 N_reg_phich;
+    uint32 N_bits;
+    uint32 x1;
+    uint32 x2;
+    uint32 word;
 
-    N_reg_phich = phy_struct->N_group_phich*3;
+    prs_c_init(c_init, &x1, &x2);
 
-    for(N_symbs=1; N_symbs<=3; N_symbs++)
+    // Generate c, 32 bits at a time
+    for(i=0; i<len; i+=32)
     {
-        N_reg_pdcch = N_symbs*(phy_struct->N_rb_dl*N_reg_rb) - phy_struct->N_rb_dl - N_reg_pcfich - N_reg_phich;
-        for(i=0; i<N_reg_pdcch; i++)
-        {
-            phy_struct->pdcch_reg_vec[i] = i;
-        }
-        // Sub block interleaving
-        // Step 1
-        C_cc_sb = 32;
-        // Step 2
-        R_cc_sb = 0;
-        while(N_reg_pdcch > (C_cc_sb*R_cc_sb))
-        {
-            R_cc_sb++;
-        }
-        // Step 3
-        if(N_reg_pdcch < (C_cc_sb*R_cc_sb))
-        {
-            N_dummy = C_cc_sb*R_cc_sb - N_reg_pdcch;
-        }else{
-            N_dummy = 0;
-        }
-        for(i=0; i<N_dummy; i++)
-        {
-            phy_struct->ruc_tmp[i] = RX_NULL_BIT;
-        }
-        idx = 0;
-        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
-        {
-            phy_struct->ruc_tmp[i] = phy_struct->pdcch_reg_vec[idx++];
-        }
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
+        word   = prs_c_word(&x1, &x2);
+        N_bits = ((len - i) < 32) ? (len - i) : 32;
+        for(j=0; j<N_bits; j++)
         {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_mat[i][j] = phy_struct->ruc_tmp[idx++];
-            }
+            c[i+j] = (word >> j) & 0x1;
         }
-        // Step 4
-        for(i=0; i<R_cc_sb; i++)
+    }
+}
+
+/*********************************************************************
+    Name: generate_prs_c_packed
+
+    Description: Generates the psuedo random sequence c as packed
+                 bits, most significant bit first
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+*********************************************************************/
+void generate_prs_c_packed(uint32  c_init,
+                           uint32  len,
+                           uint8  *c_bytes)
+{
+    PRS_C_TABLES_STRUCT *tables = prs_c_tables();
+    uint32               i;
+    uint32               j;
+    uint32               N_bytes = (len+7)/8;
+    uint32               x1;
+    uint32               x2;
+    uint32               word;
+
+    prs_c_init(c_init, &x1, &x2);
+
+    // Generate c, 32 bits at a time
+    for(i=0; i<N_bytes; i+=4)
+    {
+        word = prs_c_word(&x1, &x2);
+        for(j=0; j<4 && (i+j)<N_bytes; j++)
         {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]];
-            }
+            c_bytes[i+j] = tables->bit_reverse[(word >> (8*j)) & 0xFF];
         }
-        // Step 5
-        idx = 0;
-        for(j=0; j<C_cc_sb; j++)
+    }
+    if(0 != (len % 8))
+    {
+        c_bytes[len/8] &= 0xFF << (8 - (len % 8));
+    }
+}
+
+/*********************************************************************
+    Name: prs_c_init
+
+    Description: Initializes both m-sequences of the psuedo random
+                 sequence c, advanced by N_c
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+*********************************************************************/
+void prs_c_init(uint32  c_init,
+                uint32 *x1,
+                uint32 *x2)
+{
+    PRS_C_TABLES_STRUCT *tables = prs_c_tables();
+    uint32               i;
+
+    // Initialize the 1st m-sequence
+    *x1 = 0x54D21B24; // This is the result of advancing the initial value of 0x00000001
+
+    // Initialize and advance the 2nd m-sequence, which is linear in c_init
+    *x2 = 0;
+    for(i=0; i<31; i++)
+    {
+        if((c_init >> i) & 0x1)
         {
-            for(i=0; i<R_cc_sb; i++)
-            {
-                phy_struct->ruc_w[idx++] = phy_struct->ruc_sb_perm_mat[i][j];
-            }
+            *x2 ^= tables->x2_jump[i];
         }
-        K_pi = R_cc_sb*C_cc_sb;
-        k    = 0;
-        j    = 0;
-        while(k < N_reg_pdcch)
+    }
+}
+
+/*********************************************************************
+    Name: prs_c_word
+
+    Description: Generates the next 32 bits of the psuedo random
+                 sequence c, first bit in the least significant bit
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+*********************************************************************/
+uint32 prs_c_word(uint32 *x1,
+                  uint32 *x2)
+{
+    uint64 s1 = *x1;
+    uint64 s2 = *x2;
+
+    // Bits 0-30 hold x(n) to x(n+30).  The first 28 new bits only
+    // depend on the current state, the last 4 depend on the first 4
+    // new bits.
+    s1 |= ((s1 ^ (s1 >> 3)) & 0x0FFFFFFF) << 31;
+    s1 |= (((s1 >> 28) ^ (s1 >> 31)) & 0xF) << 59;
+    s2 |= ((s2 ^ (s2 >> 1) ^ (s2 >> 2) ^ (s2 >> 3)) & 0x0FFFFFFF) << 31;
+    s2 |= (((s2 >> 28) ^ (s2 >> 29) ^ (s2 >> 30) ^ (s2 >> 31)) & 0xF) << 59;
+
+    *x1 = (s1 >> 32) & 0x7FFFFFFF;
+    *x2 = (s2 >> 32) & 0x7FFFFFFF;
+
+    return((uint32)((s1 ^ s2) >> 31));
+}
+
+/*********************************************************************
+    Name: prs_c_tables
+
+    Description: Returns the psuedo random sequence c tables,
+                 calculating them on first use
+
+    Document Reference: N/A
+*********************************************************************/
+PRS_C_TABLES_STRUCT* prs_c_tables(void)
+{
+    // Function scope statics are initialized exactly once, even with
+    // multiple threads
+    static PRS_C_TABLES_STRUCT tables;
+    static bool                tables_ready = prs_c_tables_pre_calc(&tables);
+
+    (void)tables_ready;
+
+    return(&tables);
+}
+
+/*********************************************************************
+    Name: prs_c_tables_pre_calc
+
+    Description: Calculates the jump table that advances the 2nd
+                 m-sequence by N_c for each bit of c_init, and the
+                 byte bit reversal table used for packed output
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+*********************************************************************/
+bool prs_c_tables_pre_calc(PRS_C_TABLES_STRUCT *tables)
+{
+    uint32 i;
+    uint32 j;
+    uint32 x2;
+    uint8  new_bit2;
+    uint8  rev;
+
+    for(i=0; i<31; i++)
+    {
+        x2 = 1 << i;
+        for(j=0; j<(1600-31); j++)
         {
-            if(phy_struct->ruc_w[j%K_pi] != RX_NULL_BIT)
-            {
-                phy_struct->pdcch_reg_perm_vec[k++] = phy_struct->ruc_w[j%K_pi];
-            }
-            j++;
+            new_bit2 = ((x2 >> 3) ^ (x2 >> 2) ^ (x2 >> 1) ^ x2) & 0x1;
+
+            x2 = (x2 >> 1) | (new_bit2 << 30);
         }
-        for(p=0; p<N_ant; p++)
+        tables->x2_jump[i] = x2;
+    }
+
+    for(i=0; i<256; i++)
+    {
+        rev = 0;
+        for(j=0; j<8; j++)
         {
-            for(i=0; i<N_reg_pdcch; i++)
-            {
-                phy_struct->pdcch_permute_map[N_reg_pdcch][i] = phy_struct->pdcch_reg_perm_vec[i];
-            }
+            rev |= ((i >> j) & 0x1) << (7-j);
         }
+        tables->bit_reverse[i] = rev;
+    }
+
+    return(true);
+}
+
+/*********************************************************************
+    Name: calc_crc
+
+    Description: Calculates one of the LTE CRCs
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+*********************************************************************/
+void calc_crc(uint8  *a_bits,
+              uint32  N_a_bits,
+              uint32  crc,
+              uint8  *p_bits,
+              uint32  N_p_bits)
+{
+    CRC_STATE_STRUCT state;
+
+    crc_init(&state, crc, N_p_bits);
+    crc_update_bits(&state, a_bits, N_a_bits);
+    crc_final(&state, p_bits);
+}
+
+/*********************************************************************
+    Name: check_crc
+
+    Description: Checks the trailing CRC bits of a bit array
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+*********************************************************************/
+bool check_crc(uint8  *c_bits,
+               uint32  N_c_bits,
+               uint32  crc,
+               uint32  N_p_bits)
+{
+    CRC_STATE_STRUCT state;
+
+    if(N_c_bits <= N_p_bits)
+    {
+        return(false);
     }
+
+    // The remainder of a valid code word, including its parity bits,
+    // is 0
+    crc_init(&state, crc, N_p_bits);
+    crc_update_bits(&state, c_bits, N_c_bits);
+
+    return(0 == crc_value(&state));
 }
 
 /*********************************************************************
-    Name: phich_channel_map
+    Name: crc_init
 
-    Description: Channel maps the PHICH
+    Description: Initializes an incremental CRC calculation
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.9
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
-void phich_channel_map(LIBLTE_PHY_STRUCT              *phy_struct,
-                       LIBLTE_PHY_PHICH_STRUCT        *phich,
-                       LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
-                       uint32                          N_id_cell,
-                       uint8                           N_ant,
-                       float                           phich_res,
-                       LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
-                       LIBLTE_PHY_SUBFRAME_STRUCT     *subframe)
+void crc_init(CRC_STATE_STRUCT *state,
+              uint32            crc,
+              uint32            N_p_bits)
 {
-    uint32  m_prime;
-    uint32  l_prime;
-    uint32  n_l_prime;
-    uint32  n_hat[3];
-    uint32  M_symb;
-    uint32  M_layer_symb;
-    uint32  M_ap_symb;
-    uint32  c_init;
-    uint32  seq;
-    uint32  i;
-    uint32  j;
-    uint32  p;
-    uint32  idx;
-    uint32  w_idx;
-    uint32  y_idx;
-    uint32  z_idx;
-    uint8  *bit_seq;
-    uint8   ack_seq[3]  = {1, 1, 1};
-    uint8   nack_seq[3] = {0, 0, 0};
+    CRC_TABLES_STRUCT *tables = crc_tables();
 
-    // Determine the number of REGs
-    phich->N_reg = phy_struct->N_group_phich*3;
+    // The remainder is kept left aligned in 32 bits
+    state->poly     = crc << (32 - N_p_bits);
+    state->N_p_bits = N_p_bits;
+    state->rem      = 0;
+    switch(crc)
+    {
+    case CRC24A:
+        state->table = tables->table[0];
+        break;
+    case CRC24B:
+        state->table = tables->table[1];
+        break;
+    case CRC16:
+        state->table = tables->table[2];
+        break;
+    case CRC8:
+        state->table = tables->table[3];
+        break;
+    default:
+        state->table = NULL;
+        break;
+    }
+}
 
-    c_init = (((subframe->num + 1)*(2*N_id_cell + 1)) << 9) + N_id_cell;
-    generate_prs_c(c_init, 12, phy_struct->pdcch_c);
-    idx = 0;
-    for(m_prime=0; m_prime<phy_struct->N_group_phich; m_prime++)
+/*********************************************************************
+    Name: crc_update_bits
+
+    Description: Adds an array of unpacked bits to an incremental CRC
+                 calculation.  Only the least significant bit of each
+                 entry is used, so filler bits (TX_NULL_SYMB) are
+                 included as 0.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+*********************************************************************/
+void crc_update_bits(CRC_STATE_STRUCT *state,
+                     uint8            *bits,
+                     uint32            N_bits)
+{
+    uint32 i;
+    uint32 j;
+    uint32 N_bytes = N_bits/8;
+    uint8  bytes[64];
+
+    // Pack whole bytes and process them through the tables
+    for(i=0; i<N_bytes; i+=64)
     {
-        for(i=0; i<12; i++)
+        for(j=0; j<64 && (i+j)<N_bytes; j++)
         {
-            phy_struct->pdcch_d_re[i] = 0;
-            phy_struct->pdcch_d_im[i] = 0;
+            bytes[j] = (((bits[0] & 1) << 7) |
+                        ((bits[1] & 1) << 6) |
+                        ((bits[2] & 1) << 5) |
+                        ((bits[3] & 1) << 4) |
+                        ((bits[4] & 1) << 3) |
+                        ((bits[5] & 1) << 2) |
+                        ((bits[6] & 1) << 1) |
+                        (bits[7] & 1));
+            bits += 8;
         }
-        for(seq=0; seq<8; seq++) // FIXME: Only handling normal CP
+        crc_update_bytes(state, bytes, j);
+    }
+
+    // Process the remaining bits one at a time
+    for(i=N_bytes*8; i<N_bits; i++)
+    {
+        state->rem ^= (uint32)(*bits++ & 1) << 31;
+        if(state->rem & 0x80000000)
         {
-            if(phich->present[m_prime][seq])
-            {
-                if(phich->b[m_prime][seq])
-                {
-                    bit_seq = ack_seq;
-                }else{
-                    bit_seq = nack_seq;
-                }
-                modulation_mapper(bit_seq,
-                                  3,
-                                  LIBLTE_PHY_MODULATION_TYPE_BPSK,
-                                  phich->z_re,
-                                  phich->z_im,
-                                  &M_symb);
-                for(i=0; i<(3 * phy_struct->N_sf_phich); i++)
-                {
-                    w_idx = i % phy_struct->N_sf_phich;
-                    z_idx = i / phy_struct->N_sf_phich;
-                    if(phy_struct->pdcch_c[i] == 1)
-                    {
-                        phy_struct->pdcch_d_re[i] += PHICH_w_re_normal_cp_6_9_1_2[seq][w_idx]*(-phich->z_re[z_idx]) - PHICH_w_im_normal_cp_6_9_1_2[seq][w_idx]*(-phich->z_im[z_idx]);
-                        phy_struct->pdcch_d_im[i] += PHICH_w_re_normal_cp_6_9_1_2[seq][w_idx]*(-phich->z_im[z_idx]) + PHICH_w_im_normal_cp_6_9_1_2[seq][w_idx]*(-phich->z_re[z_idx]);
-                    }else{
-                        phy_struct->pdcch_d_re[i] += PHICH_w_re_normal_cp_6_9_1_2[seq][w_idx]*phich->z_re[z_idx] - PHICH_w_im_normal_cp_6_9_1_2[seq][w_idx]*phich->z_im[z_idx];
-                        phy_struct->pdcch_d_im[i] += PHICH_w_re_normal_cp_6_9_1_2[seq][w_idx]*phich->z_im[z_idx] + PHICH_w_im_normal_cp_6_9_1_2[seq][w_idx]*phich->z_re[z_idx];
-                    }
-                }
-            }
+            state->rem = (state->rem << 1) ^ state->poly;
+        }else{
+            state->rem <<= 1;
         }
-        layer_mapper_dl(phy_struct->pdcch_d_re,
-                        phy_struct->pdcch_d_im,
-                        3 * phy_struct->N_sf_phich,
-                        N_ant,
-                        1,
-                        LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                        phy_struct->pdcch_x_re,
-                        phy_struct->pdcch_x_im,
-                        &M_layer_symb);
-        // FIXME: Pre coder for 4 antennas is not correct
-        pre_coder_dl(phy_struct->pdcch_x_re,
-                     phy_struct->pdcch_x_im,
-                     M_layer_symb,
-                     N_ant,
-                     LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY,
-                     phy_struct->pdcch_y_re[0],
-                     phy_struct->pdcch_y_im[0],
-                     576,
-                     &M_ap_symb);
+    }
+}
 
-        // Map the group
-        if(LIBLTE_RRC_PHICH_DURATION_NORMAL == phich_dur)
+/*********************************************************************
+    Name: crc_update_bytes
+
+    Description: Adds an array of packed bytes, most significant bit
+                 first, to an incremental CRC calculation
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+*********************************************************************/
+void crc_update_bytes(CRC_STATE_STRUCT *state,
+                      uint8            *bytes,
+                      uint32            N_bytes)
+{
+    uint32   (*t)[256] = state->table;
+    uint32     rem     = state->rem;
+    uint32     i;
+    uint32     j;
+
+    if(NULL == t)
+    {
+        // No tables for this polynomial, fall back to bit by bit
+        for(i=0; i<N_bytes; i++)
         {
-            // Step 7
-            l_prime = 0;
-            // Step 1, 2, and 3
-            n_l_prime = phy_struct->N_rb_dl*2 - pcfich->N_reg;
-            // Step 8
-            for(i=0; i<3; i++)
-            {
-                n_hat[i] = (N_id_cell + m_prime + i*n_l_prime/3) % n_l_prime;
-            }
-            // Avoid PCFICH
-            for(i=0; i<pcfich->N_reg; i++)
-            {
-                for(j=0; j<3; j++)
-                {
-                    if(n_hat[j] > pcfich->n[i])
-                    {
-                        n_hat[j]++;
-                    }
-                }
-            }
-            // Step 5
-            y_idx = 0;
-            for(i=0; i<3; i++)
+            rem ^= (uint32)bytes[i] << 24;
+            for(j=0; j<8; j++)
             {
-                phich->k[idx+i] = n_hat[i]*6;
-                for(p=0; p<N_ant; p++)
+                if(rem & 0x80000000)
                 {
-                    for(j=0; j<6; j++)
-                    {
-                        if((N_id_cell % 3) != (j % 3))
-                        {
-                            subframe->tx_symb_re[p][0][phich->k[idx+i]+j] = phy_struct->pdcch_y_re[p][y_idx];
-                            subframe->tx_symb_im[p][0][phich->k[idx+i]+j] = phy_struct->pdcch_y_im[p][y_idx];
-                            y_idx++;
-                        }
-                    }
+                    rem = (rem << 1) ^ state->poly;
+                }else{
+                    rem <<= 1;
                 }
             }
-        }else{
-            // FIXME: Not handling extended PHICH duration
         }
-        idx += 3;
+        state->rem = rem;
+        return;
+    }
+
+    // Slicing-by-8
+    for(i=0; i+8<=N_bytes; i+=8)
+    {
+        rem ^= (((uint32)bytes[i+0] << 24) |
+                ((uint32)bytes[i+1] << 16) |
+                ((uint32)bytes[i+2] << 8)  |
+                (uint32)bytes[i+3]);
+        rem  = (t[7][rem >> 24]          ^
+                t[6][(rem >> 16) & 0xFF] ^
+                t[5][(rem >> 8) & 0xFF]  ^
+                t[4][rem & 0xFF]         ^
+                t[3][bytes[i+4]]         ^
+                t[2][bytes[i+5]]         ^
+                t[1][bytes[i+6]]         ^
+                t[0][bytes[i+7]]);
     }
+
+    // Byte at a time for the rest
+    for(; i<N_bytes; i++)
+    {
+        rem = (rem << 8) ^ t[0][(rem >> 24) ^ bytes[i]];
+    }
+
+    state->rem = rem;
 }
 
 /*********************************************************************
-    Name: phich_channel_demap
+    Name: bit_copy
 
-    Description: Channel demaps the PHICH
+    Description: Copies packed bits between arbitrary bit offsets
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.9
+    Document Reference: N/A
 *********************************************************************/
-void phich_channel_demap(LIBLTE_PHY_STRUCT              *phy_struct,
-                         LIBLTE_PHY_PCFICH_STRUCT       *pcfich,
-                         LIBLTE_PHY_SUBFRAME_STRUCT     *subframe,
-                         uint32                          N_id_cell,
-                         uint8                           N_ant,
-                         float                           phich_res,
-                         LIBLTE_RRC_PHICH_DURATION_ENUM  phich_dur,
-                         LIBLTE_PHY_PHICH_STRUCT        *phich)
+void bit_copy(uint8  *src,
+              uint32  src_offset,
+              uint8  *dst,
+              uint32  dst_offset,
+              uint32  N_bits)
 {
-    uint32 m_prime;
-    uint32 l_prime;
-    uint32 n_l_prime;
-    uint32 n_hat[3];
     uint32 i;
-    uint32 j;
-    uint32 idx;
+    uint32 s;
+    uint32 d;
 
-    // Calculate resources, 3GPP TS 36.211 v10.1.0 section 6.9
-    if(LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP == phy_struct->N_sc_rb_dl)
+    if(0 == (src_offset % 8) &&
+       0 == (dst_offset % 8))
     {
-        phy_struct->N_group_phich = (uint32)ceilf((float)phich_res*((float)phy_struct->N_rb_dl/(float)8));
+        memcpy(&dst[dst_offset/8], &src[src_offset/8], N_bits/8);
+        i = N_bits - (N_bits % 8);
     }else{
-        phy_struct->N_group_phich = 2*(uint32)ceilf((float)phich_res*((float)phy_struct->N_rb_dl/(float)8));
+        i = 0;
     }
-    phich->N_reg = phy_struct->N_group_phich*3;
-    // Step 4
-    m_prime = 0;
-    idx     = 0;
-    // Step 10
-    while(m_prime < phy_struct->N_group_phich)
+    for(; i<N_bits; i++)
     {
-        if(phich_dur == LIBLTE_RRC_PHICH_DURATION_NORMAL)
-        {
-            // Step 7
-            l_prime = 0;
-            // Step 1, 2, and 3
-            n_l_prime = phy_struct->N_rb_dl*2 - pcfich->N_reg;
-            // Step 8
-            for(i=0; i<3; i++)
-            {
-                n_hat[i] = (N_id_cell + m_prime + i*n_l_prime/3) % n_l_prime;
-            }
-            // Avoid PCFICH
-            for(i=0; i<pcfich->N_reg; i++)
-            {
-                for(j=0; j<3; j++)
-                {
-                    if(n_hat[j] > pcfich->n[i])
-                    {
-                        n_hat[j]++;
-                    }
-                }
-            }
-            // Step 5
-            for(i=0; i<3; i++)
-            {
-                phich->k[idx+i] = n_hat[i]*6;
-                // FIXME: Not currently implementing step 6
-            }
-            idx += 3;
-        }else{
-            // FIXME: Not handling extended PHICH duration
-            printf("ERROR: Not handling extended PHICH duration\n");
-        }
-        // Step 9
-        m_prime++;
+        s = src_offset + i;
+        d = dst_offset + i;
+        dst[d/8] = ((dst[d/8] & ~(0x80 >> (d%8))) |
+                    (((src[s/8] >> (7-(s%8))) & 1) << (7-(d%8))));
+    }
+}
+
+/*********************************************************************
+    Name: bit_write
+
+    Description: Writes the N_bits least significant bits of a value,
+                 most significant bit first, into packed bits
+
+    Document Reference: N/A
+*********************************************************************/
+void bit_write(uint8  *dst,
+               uint32  dst_offset,
+               uint32  value,
+               uint32  N_bits)
+{
+    uint32 i;
+    uint32 d;
+
+    for(i=0; i<N_bits; i++)
+    {
+        d        = dst_offset + i;
+        dst[d/8] = ((dst[d/8] & ~(0x80 >> (d%8))) |
+                    (((value >> (N_bits-1-i)) & 1) << (7-(d%8))));
+    }
+}
+
+/*********************************************************************
+    Name: crc_update_packed_bits
+
+    Description: Adds a number of packed bits, most significant bit
+                 first, to an incremental CRC calculation
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+*********************************************************************/
+void crc_update_packed_bits(CRC_STATE_STRUCT *state,
+                            uint8            *bytes,
+                            uint32            N_bits)
+{
+    uint32 i;
+    uint8  bits[8];
+
+    crc_update_bytes(state, bytes, N_bits/8);
+    for(i=0; i<(N_bits % 8); i++)
+    {
+        bits[i] = (bytes[N_bits/8] >> (7-i)) & 1;
     }
+    crc_update_bits(state, bits, N_bits % 8);
 }
 
 /*********************************************************************
-    Name: generate_crs
+    Name: crc_update_zeros
 
-    Description: Generates LTE cell specific reference signals
+    Description: Adds a number of 0 bits to an incremental CRC
+                 calculation
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.10.1.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
-void generate_crs(uint32  N_s,
-                  uint32  L,
-                  uint32  N_id_cell,
-                  uint32  N_sc_rb_dl,
-                  float  *crs_re,
-                  float  *crs_im)
+void crc_update_zeros(CRC_STATE_STRUCT *state,
+                      uint32            N_bits)
 {
-    float  one_over_sqrt_2 = 1/sqrt(2);
-    uint32 N_cp;
-    uint32 c_init;
-    uint32 len = 2*LIBLTE_PHY_N_RB_DL_MAX;
-    uint32 c[2*len];
     uint32 i;
+    uint8  zeros[64];
 
-    if(LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP == N_sc_rb_dl)
+    memset(zeros, 0, sizeof(zeros));
+    for(i=0; i+512<=N_bits; i+=512)
     {
-        N_cp = 1;
-    }else{
-        N_cp = 0;
+        crc_update_bytes(state, zeros, 64);
+    }
+    crc_update_bytes(state, zeros, (N_bits-i)/8);
+    for(i+=((N_bits-i)/8)*8; i<N_bits; i++)
+    {
+        if(state->rem & 0x80000000)
+        {
+            state->rem = (state->rem << 1) ^ state->poly;
+        }else{
+            state->rem <<= 1;
+        }
     }
+}
 
-    // Calculate c_init
-    c_init = 1024 * (7 * (N_s+1) + L + 1) * (2 * N_id_cell + 1) + 2*N_id_cell + N_cp;
+/*********************************************************************
+    Name: crc_value
 
-    // Generate the psuedo random sequence c
-    generate_prs_c(c_init, 2*len, c);
+    Description: Returns the current CRC remainder of an incremental
+                 CRC calculation, most significant bit first
 
-    // Construct the reference signals
-    for(i=0; i<len; i++)
-    {
-        crs_re[i] = one_over_sqrt_2*(1 - 2*(float)c[2*i]);
-        crs_im[i] = one_over_sqrt_2*(1 - 2*(float)c[2*i+1]);
-    }
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+*********************************************************************/
+uint32 crc_value(CRC_STATE_STRUCT *state)
+{
+    return(state->rem >> (32 - state->N_p_bits));
 }
 
 /*********************************************************************
-    Name: generate_pss
+    Name: crc_final
 
-    Description: Generates an LTE primary synchronization signal
+    Description: Converts the current CRC remainder of an incremental
+                 CRC calculation into an array of parity bits
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.1.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
 *********************************************************************/
-void generate_pss(uint32  N_id_2,
-                  float  *pss_re,
-                  float  *pss_im)
+void crc_final(CRC_STATE_STRUCT *state,
+               uint8            *p_bits)
 {
-    float  root_idx;
     uint32 i;
 
-    if(N_id_2 == 0)
+    for(i=0; i<state->N_p_bits; i++)
     {
-        root_idx = 25;
-    }else if(N_id_2 == 1){
-        root_idx = 29;
-    }else{
-        root_idx = 34;
+        p_bits[i] = (state->rem >> (31-i)) & 1;
     }
+}
 
-    for(i=0; i<31; i++)
-    {
-        pss_re[i] = cosf(-M_PI*root_idx*i*(i+1)/63);
-        pss_im[i] = sinf(-M_PI*root_idx*i*(i+1)/63);
-    }
-    for(i=31; i<62; i++)
-    {
-        pss_re[i] = cosf(-M_PI*root_idx*(i+1)*(i+2)/63);
-        pss_im[i] = sinf(-M_PI*root_idx*(i+1)*(i+2)/63);
-    }
+/*********************************************************************
+    Name: crc_tables
+
+    Description: Returns the slicing-by-8 CRC tables, calculating them
+                 on first use
+
+    Document Reference: N/A
+*********************************************************************/
+CRC_TABLES_STRUCT* crc_tables(void)
+{
+    // Function scope statics are initialized exactly once, even with
+    // multiple threads
+    static CRC_TABLES_STRUCT tables;
+    static bool              tables_ready = crc_tables_pre_calc(&tables);
+
+    (void)tables_ready;
+
+    return(&tables);
 }
 
 /*********************************************************************
-    Name: generate_sss
+    Name: crc_tables_pre_calc
 
-    Description: Generates LTE secondary synchronization signals
+    Description: Calculates the slicing-by-8 CRC tables for all of the
+                 LTE CRC polynomials
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.11.2.1
+    Document Reference: N/A
 *********************************************************************/
-void generate_sss(LIBLTE_PHY_STRUCT *phy_struct,
-                  uint32             N_id_1,
-                  uint32             N_id_2,
-                  float             *sss_re_0,
-                  float             *sss_im_0,
-                  float             *sss_re_5,
-                  float             *sss_im_5)
+bool crc_tables_pre_calc(CRC_TABLES_STRUCT *tables)
 {
+    uint32 polys[CRC_N_POLYS]    = {CRC24A, CRC24B, CRC16, CRC8};
+    uint32 N_p_bits[CRC_N_POLYS] = {24, 24, 16, 8};
+    uint32 poly;
+    uint32 rem;
+    uint32 p;
     uint32 i;
-    uint32 q_prime;
-    uint32 q;
-    uint32 m_prime;
-    uint32 m0;
-    uint32 m1;
-
-    // Generate m0 and m1
-    q_prime = N_id_1/30;
-    q       = (N_id_1 + (q_prime*(q_prime+1)/2))/30;
-    m_prime = N_id_1 + (q*(q+1)/2);
-    m0      = m_prime % 31;
-    m1      = (m0 + (m_prime/31) + 1) % 31;
+    uint32 j;
+    uint32 k;
 
-    // Generate s_tilda
-    memset(phy_struct->sss_x_s_tilda, 0, sizeof(uint8)*31);
-    phy_struct->sss_x_s_tilda[4] = 1;
-    for(i=0; i<26; i++)
-    {
-        phy_struct->sss_x_s_tilda[i+5] = (phy_struct->sss_x_s_tilda[i+2] +
-                                          phy_struct->sss_x_s_tilda[i]) % 2;
-    }
-    for(i=0; i<31; i++)
+    for(p=0; p<CRC_N_POLYS; p++)
     {
-        phy_struct->sss_s_tilda[i] = 1 - 2*phy_struct->sss_x_s_tilda[i];
-    }
+        poly = polys[p] << (32 - N_p_bits[p]);
 
-    // Generate c_tilda
-    memset(phy_struct->sss_x_c_tilda, 0, sizeof(uint8)*31);
-    phy_struct->sss_x_c_tilda[4] = 1;
-    for(i=0; i<26; i++)
-    {
-        phy_struct->sss_x_c_tilda[i+5] = (phy_struct->sss_x_c_tilda[i+3] +
-                                          phy_struct->sss_x_c_tilda[i]) % 2;
-    }
-    for(i=0; i<31; i++)
-    {
-        phy_struct->sss_c_tilda[i] = 1 - 2*phy_struct->sss_x_c_tilda[i];
+        // Remainder of each byte value
+        for(i=0; i<256; i++)
+        {
+            rem = i << 24;
+            for(j=0; j<8; j++)
+            {
+                if(rem & 0x80000000)
+                {
+                    rem = (rem << 1) ^ poly;
+                }else{
+                    rem <<= 1;
+                }
+            }
+            tables->table[p][0][i] = rem;
+        }
+
+        // Remainder of each byte value followed by k zero bytes
+        for(k=1; k<8; k++)
+        {
+            for(i=0; i<256; i++)
+            {
+                rem                    = tables->table[p][k-1][i];
+                tables->table[p][k][i] = (rem << 8) ^ tables->table[p][0][rem >> 24];
+            }
+        }
     }
 
-    // Generate z_tilda
-    memset(phy_struct->sss_x_z_tilda, 0, sizeof(uint8)*31);
-    phy_struct->sss_x_z_tilda[4] = 1;
-    for(i=0; i<26; i++)
+    return(true);
+}
+
+/*********************************************************************
+    Name: code_block_segmentation_sizes
+
+    Description: Determines the code block sizes for turbo coded
+                 channels
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+*********************************************************************/
+void code_block_segmentation_sizes(uint32  N_b_bits,
+                                   uint32 *L,
+                                   uint32 *C,
+                                   uint32 *F,
+                                   uint32 *K_plus,
+                                   uint32 *K_minus,
+                                   uint32 *C_minus)
+{
+    uint32 Z = 6144;
+    uint32 B_prime;
+    uint32 K_delta;
+    uint32 C_plus;
+    int32  i;
+
+    *K_plus  = 0;
+    *K_minus = 0;
+    if(N_b_bits <= Z)
     {
-        phy_struct->sss_x_z_tilda[i+5] = (phy_struct->sss_x_z_tilda[i+4] +
-                                          phy_struct->sss_x_z_tilda[i+2] +
-                                          phy_struct->sss_x_z_tilda[i+1] +
-                                          phy_struct->sss_x_z_tilda[i]) % 2;
+        *L      = 0;
+        *C      = 1;
+        B_prime = N_b_bits;
+    }else{
+        *L      = 24;
+        *C      = (uint32)ceilf((float)N_b_bits/(float)(Z-*L));
+        B_prime = N_b_bits + (*C)*(*L);
     }
-    for(i=0; i<31; i++)
+    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
     {
-        phy_struct->sss_z_tilda[i] = 1 - 2*phy_struct->sss_x_z_tilda[i];
+        if((*C)*TURBO_INT_K_TABLE[i] >= B_prime)
+        {
+            *K_plus = TURBO_INT_K_TABLE[i];
+            break;
+        }
     }
-
-    // Generate s0_m0 and s1_m1
-    for(i=0; i<31; i++)
+    if(1 == *C)
     {
-        phy_struct->sss_s0_m0[i] = phy_struct->sss_s_tilda[(i + m0) % 31];
-        phy_struct->sss_s1_m1[i] = phy_struct->sss_s_tilda[(i + m1) % 31];
+        C_plus   = 1;
+        *C_minus = 0;
+    }else{
+        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
+        {
+            if(TURBO_INT_K_TABLE[i] < *K_plus)
+            {
+                *K_minus = TURBO_INT_K_TABLE[i];
+                break;
+            }
+        }
+        K_delta  = *K_plus - *K_minus;
+        *C_minus = ((*C)*(*K_plus) - B_prime)/K_delta;
+        C_plus   = *C - *C_minus;
     }
+    *F = C_plus*(*K_plus) + (*C_minus)*(*K_minus) - B_prime;
+}
 
-    // Generate c0 and c1
-    for(i=0; i<31; i++)
-    {
-        phy_struct->sss_c0[i] = phy_struct->sss_c_tilda[(i + N_id_2) % 31];
-        phy_struct->sss_c1[i] = phy_struct->sss_c_tilda[(i + N_id_2 + 3) % 31];
-    }
+/*********************************************************************
+    Name: liblte_phy_code_block_segmentation
 
-    // Generate z1_m0 and z1_m1
-    for(i=0; i<31; i++)
+    Description: Performs code block segmentation for turbo coded
+                 channels
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+*********************************************************************/
+void liblte_phy_code_block_segmentation(uint8  *b_bits,
+                                        uint32  N_b_bits,
+                                        uint32 *N_codeblocks,
+                                        uint32 *N_filler_bits,
+                                        uint8  *c_bits,
+                                        uint32  N_c_bits_max,
+                                        uint32 *N_c_bits)
+{
+    uint32 L;
+    uint32 C;
+    uint32 F;
+    uint32 K_plus;
+    uint32 K_minus;
+    uint32 K_r;
+    uint32 C_minus;
+    uint32 k;
+    uint32 s;
+    uint32 r;
+    uint32 k_start;
+    uint32 s_start;
+    int32  i;
+    uint8  p_cb_bits[24];
+    CRC_STATE_STRUCT cb_crc;
+
+    // Determine L, C, K+, K-, C-, and the number of filler bits
+    code_block_segmentation_sizes(N_b_bits, &L, &C, &F, &K_plus, &K_minus, &C_minus);
+
+    // Add the filler bits
+    *N_codeblocks  = C;
+    *N_filler_bits = F;
+    for(i=0; i<(int32)F; i++)
     {
-        phy_struct->sss_z1_m0[i] = phy_struct->sss_z_tilda[(i + (m0 % 8)) % 31];
-        phy_struct->sss_z1_m1[i] = phy_struct->sss_z_tilda[(i + (m1 % 8)) % 31];
+        c_bits[i] = TX_NULL_SYMB;
     }
 
-    // Generate SSS
-    for(i=0; i<31; i++)
+    // Add the input bits
+    k = F;
+    s = 0;
+    for(r=0; r<C; r++)
     {
-        sss_re_0[2*i]   = phy_struct->sss_s0_m0[i]*phy_struct->sss_c0[i];
-        sss_im_0[2*i]   = 0;
-        sss_re_0[2*i+1] = phy_struct->sss_s1_m1[i]*phy_struct->sss_c1[i]*phy_struct->sss_z1_m0[i];
-        sss_im_0[2*i+1] = 0;
+        // Determine the K for this code block
+        if(r < C_minus)
+        {
+            K_r = K_minus;
+        }else{
+            K_r = K_plus;
+        }
+        N_c_bits[r] = K_r;
 
-        sss_re_5[2*i]   = phy_struct->sss_s1_m1[i]*phy_struct->sss_c0[i];
-        sss_im_5[2*i]   = 0;
-        sss_re_5[2*i+1] = phy_struct->sss_s0_m0[i]*phy_struct->sss_c1[i]*phy_struct->sss_z1_m1[i];
-        sss_im_5[2*i+1] = 0;
+        // Add the input bits
+        k_start = k;
+        s_start = s;
+        while(k < (K_r - L))
+        {
+            c_bits[r*N_c_bits_max+k] = b_bits[s++];
+            k++;
+        }
+
+        // Add CRC if more than 1 code block is needed, filler bits are
+        // included as 0
+        if(C > 1)
+        {
+            crc_init(&cb_crc, CRC24B, L);
+            crc_update_zeros(&cb_crc, k_start);
+            crc_update_bits(&cb_crc, &b_bits[s_start], s - s_start);
+            crc_final(&cb_crc, p_cb_bits);
+            while(k < K_r)
+            {
+                c_bits[r*N_c_bits_max+k] = p_cb_bits[k+L-K_r];
+                k++;
+            }
+        }
+        k = 0;
     }
 }
 
 /*********************************************************************
-    Name: symbols_to_samples_dl
+    Name: liblte_phy_pack_bits
 
-    Description: Converts subcarrier symbols to I/Q samples for the
-                 downlink
+    Description: Packs an array of unpacked bits into bytes, most
+                 significant bit first.  Unused bits in the last byte
+                 are set to 0.
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
+    Document Reference: N/A
 *********************************************************************/
-void symbols_to_samples_dl(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *symb_re,
-                           float             *symb_im,
-                           uint32             symbol_offset,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32            *N_samps)
+void liblte_phy_pack_bits(uint8  *bits,
+                          uint32  N_bits,
+                          uint8  *bytes)
 {
-    uint32 CP_len;
     uint32 i;
+    uint32 j;
+    uint8  byte;
 
-    // Calculate index and CP length
-    if((symbol_offset % 7) == 0)
+    for(i=0; i<N_bits/8; i++)
     {
-        CP_len = phy_struct->N_samps_cp_l_0;
-    }else{
-        CP_len = phy_struct->N_samps_cp_l_else;
+        bytes[i] = (((bits[0] & 1) << 7) |
+                    ((bits[1] & 1) << 6) |
+                    ((bits[2] & 1) << 5) |
+                    ((bits[3] & 1) << 4) |
+                    ((bits[4] & 1) << 3) |
+                    ((bits[5] & 1) << 2) |
+                    ((bits[6] & 1) << 1) |
+                    (bits[7] & 1));
+        bits += 8;
     }
-
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+    if(0 != (N_bits % 8))
     {
-        phy_struct->s2s_in[i][0] = 0;
-        phy_struct->s2s_in[i][1] = 0;
+        byte = 0;
+        for(j=0; j<(N_bits % 8); j++)
+        {
+            byte |= (bits[j] & 1) << (7-j);
+        }
+        bytes[i] = byte;
     }
-    for(i=0; i<(phy_struct->FFT_size/2)-phy_struct->FFT_pad_size; i++)
-    {
-        // Positive spectrum
-        phy_struct->s2s_in[i+1][0] = symb_re[i+((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)];
-        phy_struct->s2s_in[i+1][1] = symb_im[i+((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)];
+}
 
-        // Negative spectrum
-        phy_struct->s2s_in[phy_struct->N_samps_per_symb-i-1][0] = symb_re[((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)-i-1];
-        phy_struct->s2s_in[phy_struct->N_samps_per_symb-i-1][1] = symb_im[((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)-i-1];
-    }
-    fftwf_execute(phy_struct->symbs_to_samps_dl_plan);
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+/*********************************************************************
+    Name: liblte_phy_unpack_bits
+
+    Description: Unpacks an array of bytes, most significant bit
+                 first, into one bit per byte
+
+    Document Reference: N/A
+*********************************************************************/
+void liblte_phy_unpack_bits(uint8  *bytes,
+                            uint32  N_bits,
+                            uint8  *bits)
+{
+    uint32 i;
+
+    for(i=0; i<N_bits; i++)
     {
-        samps_re[CP_len+i] = phy_struct->s2s_out[i][0];
-        samps_im[CP_len+i] = phy_struct->s2s_out[i][1];
+        bits[i] = (bytes[i/8] >> (7-(i%8))) & 1;
     }
-    for(i=0; i<CP_len; i++)
+}
+
+/*********************************************************************
+    Name: liblte_phy_code_block_segmentation_packed
+
+    Description: Performs code block segmentation for turbo coded
+                 channels on packed bits.  Filler bits are set to 0.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+*********************************************************************/
+void liblte_phy_code_block_segmentation_packed(uint8  *b_bytes,
+                                               uint32  N_b_bits,
+                                               uint32 *N_codeblocks,
+                                               uint32 *N_filler_bits,
+                                               uint8  *c_bytes,
+                                               uint32  N_c_bytes_max,
+                                               uint32 *N_c_bits)
+{
+    CRC_STATE_STRUCT  cb_crc;
+    uint32            L;
+    uint32            C;
+    uint32            F;
+    uint32            K_plus;
+    uint32            K_minus;
+    uint32            C_minus;
+    uint32            K_r;
+    uint32            N_data_bits;
+    uint32            s;
+    uint32            r;
+    uint8            *cb_bytes;
+
+    code_block_segmentation_sizes(N_b_bits, &L, &C, &F, &K_plus, &K_minus, &C_minus);
+    *N_codeblocks  = C;
+    *N_filler_bits = F;
+
+    s = 0;
+    for(r=0; r<C; r++)
     {
-        samps_re[i] = samps_re[phy_struct->N_samps_per_symb+i];
-        samps_im[i] = samps_im[phy_struct->N_samps_per_symb+i];
+        // Determine the K for this code block
+        if(r < C_minus)
+        {
+            K_r = K_minus;
+        }else{
+            K_r = K_plus;
+        }
+        N_c_bits[r] = K_r;
+        cb_bytes    = &c_bytes[r*N_c_bytes_max];
+
+        // Add the filler and input bits
+        N_data_bits = K_r - L;
+        if(0 == r)
+        {
+            memset(cb_bytes, 0, (F+7)/8);
+            bit_copy(b_bytes, s, cb_bytes, F, N_data_bits - F);
+            s += N_data_bits - F;
+        }else{
+            bit_copy(b_bytes, s, cb_bytes, 0, N_data_bits);
+            s += N_data_bits;
+        }
+
+        // Add CRC if more than 1 code block is needed
+        if(C > 1)
+        {
+            crc_init(&cb_crc, CRC24B, L);
+            crc_update_packed_bits(&cb_crc, cb_bytes, N_data_bits);
+            bit_write(cb_bytes, N_data_bits, crc_value(&cb_crc), L);
+        }
     }
-    *N_samps = phy_struct->N_samps_per_symb + CP_len;
 }
 
 /*********************************************************************
-    Name: symbols_to_samples_ul
+    Name: liblte_phy_code_block_desegmentation
 
-    Description: Converts subcarrier symbols to I/Q samples for the
-                 uplink
+    Description: Performs code block desegmentation for turbo coded
+                 channels
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
 *********************************************************************/
-void symbols_to_samples_ul(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *symb_re,
-                           float             *symb_im,
-                           uint32             symbol_offset,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32            *N_samps)
+void liblte_phy_code_block_desegmentation(uint8  *c_bits,
+                                          uint32 *N_c_bits,
+                                          uint32  N_c_bits_max,
+                                          uint32  tbs,
+                                          uint8  *b_bits,
+                                          uint32  N_b_bits)
 {
-    uint32 CP_len;
-    uint32 i;
-    uint32 idx;
+    uint32  Z = 6144;
+    uint32  L;
+    uint32  B;
+    uint32  C;
+    uint32  F;
+    uint32  B_prime;
+    uint32  K_plus  = 0;
+    uint32  K_minus = 0;
+    uint32  K_delta;
+    uint32  K_r;
+    uint32  C_plus;
+    uint32  C_minus;
+    uint32  k;
+    uint32  s;
+    uint32  r;
+    uint32  ber;
+    int32   i;
+    uint8  *p_cb_bits;
+    uint8   calc_p_cb_bits[24];
 
-    // Calculate index and CP length
-    if((symbol_offset % 7) == 0)
+    // Determine L, C, B', K+, C+, K-, and C-
+    if(tbs+24 <= Z)
     {
-        CP_len = phy_struct->N_samps_cp_l_0;
+        L       = 0;
+        C       = 1;
+        B_prime = tbs+24;
+        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+        {
+            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
+            {
+                K_plus = TURBO_INT_K_TABLE[i];
+                break;
+            }
+        }
+        K_minus = 0;
+        C_plus  = 1;
+        C_minus = 0;
     }else{
-        CP_len = phy_struct->N_samps_cp_l_else;
+        B       = tbs+24;
+        L       = 24;
+        C       = (uint32)ceilf((float)B/(float)(Z-L));
+        B_prime = B + C*L;
+        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+        {
+            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
+            {
+                K_plus = TURBO_INT_K_TABLE[i];
+                break;
+            }
+        }
+        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
+        {
+            if(TURBO_INT_K_TABLE[i] < K_plus)
+            {
+                K_minus = TURBO_INT_K_TABLE[i];
+                break;
+            }
+        }
+        K_delta = K_plus - K_minus;
+        C_minus = (C*K_plus - B_prime)/K_delta;
+        C_plus  = C - C_minus;
     }
 
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
-    {
-        phy_struct->s2s_in[i][0] = 0;
-        phy_struct->s2s_in[i][1] = 0;
-    }
-    for(i=0; i<phy_struct->FFT_size-(phy_struct->FFT_pad_size/2); i++)
-    {
-        idx                        = ((i*phy_struct->FFT_pad_size+phy_struct->FFT_size/2)*2+1)%(phy_struct->FFT_size*2);
-        phy_struct->s2s_in[idx][0] = symb_re[i];
-        phy_struct->s2s_in[idx][1] = symb_im[i];
-    }
-    fftwf_execute(phy_struct->symbs_to_samps_ul_plan);
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
-    {
-        samps_re[CP_len+i] = phy_struct->s2s_out[i][0];
-        samps_im[CP_len+i] = phy_struct->s2s_out[i][1];
-    }
-    for(i=0; i<CP_len; i++)
+    // Determine the number of filler bits
+    F = C_plus*K_plus + C_minus*K_minus - B_prime;
+
+    // Determine the output bits
+    k = F;
+    s = 0;
+    for(r=0; r<C; r++)
     {
-        samps_re[i] = samps_re[phy_struct->N_samps_per_symb+i];
-        samps_im[i] = samps_im[phy_struct->N_samps_per_symb+i];
+        // Determine the K for this code block
+        if(r < C_minus)
+        {
+            K_r = K_minus;
+        }else{
+            K_r = K_plus;
+        }
+
+        // Check CRC if more than 1 code block is present
+        if(C > 1)
+        {
+            calc_crc(&c_bits[r*N_c_bits_max], N_c_bits[r]-L, CRC24B, calc_p_cb_bits, L);
+            p_cb_bits = &c_bits[r*N_c_bits_max+N_c_bits[r]-L];
+            ber       = 0;
+            for(i=0; i<(int32)L; i++)
+            {
+                ber += p_cb_bits[i] ^ calc_p_cb_bits[i];
+            }
+            if(ber == 0)
+            {
+                printf("CB CRC CORRECT\n");
+            }else{
+                printf("CB CRC INCORRECT\n");
+            }
+        }
+
+        // Create the output bits
+        while(k < (K_r - L))
+        {
+            b_bits[s++] = c_bits[r*N_c_bits_max+k];
+            k++;
+        }
+        k = 0;
     }
-    *N_samps = phy_struct->N_samps_per_symb + CP_len;
 }
 
 /*********************************************************************
-    Name: samples_to_symbols_dl
+    Name: conv_encode
 
-    Description: Converts I/Q samples to subcarrier symbols for the
-                 downlink
+    Description: Convolutionally encodes a bit array using the
+                 provided parameters
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 6.12
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
-void samples_to_symbols_dl(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32             slot_start_idx,
-                           uint32             symbol_offset,
-                           uint8              scale,
-                           float             *symb_re,
-                           float             *symb_im)
+void conv_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                 uint8             *c_bits,
+                 uint32             N_c_bits,
+                 uint32             constraint_len,
+                 uint32             rate,
+                 uint32            *g,
+                 bool               tail_bit,
+                 uint8             *d_bits,
+                 uint32            *N_d_bits)
 {
-    uint32 CP_len;
-    uint32 index;
     uint32 i;
+    uint32 j;
+    uint32 k;
+    uint8  s_reg[constraint_len];
+    uint8  g_array[3][constraint_len];
 
-    // Calculate index and CP length
-    if((symbol_offset % 7) == 0)
+    // Initialize the shift register
+    if(tail_bit)
     {
-        CP_len = phy_struct->N_samps_cp_l_0;
+        for(i=0; i<constraint_len; i++)
+        {
+            s_reg[i] = c_bits[N_c_bits-i-1];
+        }
     }else{
-        CP_len = phy_struct->N_samps_cp_l_else;
-    }
-    index = slot_start_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*symbol_offset;
-    if(symbol_offset > 0)
-    {
-        index += phy_struct->N_samps_cp_l_0 - phy_struct->N_samps_cp_l_else;
+        for(i=0; i<constraint_len; i++)
+        {
+            s_reg[i] = 0;
+        }
     }
 
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
-    {
-        phy_struct->s2s_in[i][0] = samps_re[index+CP_len-1+i];
-        phy_struct->s2s_in[i][1] = samps_im[index+CP_len-1+i];
-    }
-    fftwf_execute(phy_struct->samps_to_symbs_dl_plan);
-    for(i=0; i<(phy_struct->FFT_size/2)-phy_struct->FFT_pad_size; i++)
+    // Convert g from octal to binary array
+    for(i=0; i<rate; i++)
     {
-        // Positive spectrum
-        symb_re[i+((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)] = phy_struct->s2s_out[i+1][0];
-        symb_im[i+((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)] = phy_struct->s2s_out[i+1][1];
-
-        // Negative spectrum
-        symb_re[((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)-i-1] = phy_struct->s2s_out[phy_struct->N_samps_per_symb-i-1][0];
-        symb_im[((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size)-i-1] = phy_struct->s2s_out[phy_struct->N_samps_per_symb-i-1][1];
+        for(j=0; j<constraint_len; j++)
+        {
+            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
+        }
     }
 
-    if(scale == 1)
+    // Convolutionally encode input
+    for(i=0; i<N_c_bits; i++)
     {
-        for(i=0; i<2*((phy_struct->FFT_size/2)-phy_struct->FFT_pad_size); i++)
+        // Add next bit to shift register
+        for(j=constraint_len-1; j>0; j--)
+        {
+            s_reg[j] = s_reg[j-1];
+        }
+        s_reg[0] = c_bits[i];
+
+        // Determine the output bits
+        for(j=0; j<rate; j++)
         {
-            symb_re[i] = cosf(atan2f(symb_im[i], symb_re[i]));
-            symb_im[i] = sinf(atan2f(symb_im[i], symb_re[i]));
+            d_bits[i*rate + j] = 0;
+
+            for(k=0; k<constraint_len; k++)
+            {
+                d_bits[i*rate + j] += s_reg[k]*g_array[j][k];
+            }
+            d_bits[i*rate + j] %= 2;
         }
     }
+
+    *N_d_bits = N_c_bits*rate;
 }
 
 /*********************************************************************
-    Name: samples_to_symbols_ul
+    Name: conv_encode_soft
 
-    Description: Converts I/Q samples to subcarrier symbols for the
-                 uplink
+    Description: Convolutionally encodes a soft bit array using the
+                 provided parameters
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.6
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
-void samples_to_symbols_ul(LIBLTE_PHY_STRUCT *phy_struct,
-                           float             *samps_re,
-                           float             *samps_im,
-                           uint32             slot_start_idx,
-                           uint32             symbol_offset,
-                           float             *symb_re,
-                           float             *symb_im)
+void conv_encode_soft(LIBLTE_PHY_STRUCT *phy_struct,
+                      int8              *c_bits,
+                      uint32             N_c_bits,
+                      uint32             constraint_len,
+                      uint32             rate,
+                      uint32            *g,
+                      bool               tail_bit,
+                      int8              *d_bits,
+                      uint32            *N_d_bits)
 {
-    uint32 CP_len;
-    uint32 index;
     uint32 i;
-    uint32 idx;
+    uint32 j;
+    uint32 k;
+    uint32 tmp_sum;
+    uint32 tmp_sign;
+    int32  tmp_mag;
+    int8   s_reg[constraint_len];
+    uint8  g_array[3][constraint_len];
 
-    // Calculate index and CP length
-    if((symbol_offset % 7) == 0)
+    // Initialize the shift register
+    if(tail_bit)
     {
-        CP_len = phy_struct->N_samps_cp_l_0;
+        for(i=0; i<constraint_len; i++)
+        {
+            s_reg[i] = c_bits[N_c_bits-i-1];
+        }
     }else{
-        CP_len = phy_struct->N_samps_cp_l_else;
-    }
-    index = slot_start_idx + (phy_struct->N_samps_per_symb+phy_struct->N_samps_cp_l_else)*symbol_offset;
-    if(symbol_offset > 0)
-    {
-        index += phy_struct->N_samps_cp_l_0 - phy_struct->N_samps_cp_l_else;
+        for(i=0; i<constraint_len; i++)
+        {
+            s_reg[i] = 127;
+        }
     }
 
-    for(i=0; i<phy_struct->N_samps_per_symb; i++)
+    // Convert g from octal to binary array
+    for(i=0; i<rate; i++)
     {
-        phy_struct->s2s_in[i][0] = samps_re[index+CP_len-1+i];
-        phy_struct->s2s_in[i][1] = samps_im[index+CP_len-1+i];
+        for(j=0; j<constraint_len; j++)
+        {
+            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
+        }
     }
-    fftwf_execute(phy_struct->samps_to_symbs_ul_plan);
-    for(i=0; i<phy_struct->FFT_size-(phy_struct->FFT_pad_size*2); i++)
+
+    // Convolutionally encode input
+    for(i=0; i<N_c_bits; i++)
     {
-        idx        = ((i+phy_struct->FFT_pad_size+phy_struct->FFT_size/2)*2+1)%(phy_struct->FFT_size*2);
-        symb_re[i] = phy_struct->s2s_out[idx][0];
-        symb_im[i] = phy_struct->s2s_out[idx][1];
+        // Add next bit to shift register
+        for(j=constraint_len-1; j>0; j--)
+        {
+            s_reg[j] = s_reg[j-1];
+        }
+        s_reg[0] = c_bits[i];
+
+        // Determine the output bits
+        for(j=0; j<rate; j++)
+        {
+            tmp_sum  = 0;
+            tmp_mag  = 0;
+            tmp_sign = 0;
+            for(k=0; k<constraint_len; k++)
+            {
+                if(1 == g_array[j][k])
+                {
+                    if(s_reg[k] >= 0)
+                    {
+                        tmp_mag += s_reg[k];
+                    }else{
+                        tmp_mag  += -s_reg[k];
+                        tmp_sign += 1;
+                    }
+                    tmp_sum++;
+                }
+            }
+            d_bits[i*rate + j] = tmp_mag >> (tmp_sum-1);
+            if(1 == (tmp_sign % 2))
+            {
+                d_bits[i*rate + j] = -d_bits[i*rate + j];
+            }
+        }
     }
+
+    *N_d_bits = N_c_bits*rate;
 }
 
 /*********************************************************************
-    Name: modulation_mapper
-
-    Description: Maps binary digits to complex-valued modulation
-                 symbols
+    Name: viterbi_decode
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+    Description: Viterbi decodes a convolutionally coded input bit
+                 array using the provided parameters
 
-    NOTES: Currently only supports BPSK and QPSK
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
-void modulation_mapper(uint8                           *bits,
-                       uint32                           N_bits,
-                       LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
-                       float                           *d_re,
-                       float                           *d_im,
-                       uint32                          *M_symb)
+void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
+                    float             *d_bits,
+                    uint32             N_d_bits,
+                    uint32             constraint_len,
+                    uint32             rate,
+                    uint32            *g,
+                    uint8             *c_bits,
+                    uint32            *N_c_bits)
 {
-    float  one_over_sqrt_2  = 1/sqrt(2);
-    float  one_over_sqrt_10 = 1/sqrt(10);
-    float  one_over_sqrt_42 = 1/sqrt(42);
-    uint32 i;
-    uint32 input;
+    float  init_min;
+    float  tmp1;
+    float  tmp2;
+    int32  i;
+    uint32 j;
+    uint32 k;
+    uint32 o;
+    uint32 N_states = 1<<(constraint_len-1);
+    uint32 idx;
+    uint32 tb_state_len;
+    uint8  in_path;
+    uint8  prev_state;
+    uint8  in_bit;
+    uint8  prev_state_0;
+    uint8  prev_state_1;
+    uint8  s_reg[constraint_len];
+    uint8  g_array[3][constraint_len];
 
-    switch(type)
+    // BCH and DCI use a tail-biting K=7 rate 1/3 code, which has a
+    // dedicated decoder
+    if(7 == constraint_len &&
+       3 == rate           &&
+       (N_d_bits/rate)     <= LIBLTE_PHY_VITERBI_K7_MAX_BITS)
     {
-    case LIBLTE_PHY_MODULATION_TYPE_BPSK:
-        // 3GPP TS 36.211 v10.1.0 section 7.1.1
-        for(i=0; i<N_bits; i++)
+        viterbi_decode_k7(phy_struct, d_bits, N_d_bits, g, c_bits, N_c_bits);
+        return;
+    }
+
+    // Convert g to binary
+    for(i=0; i<(int32)rate; i++)
+    {
+        for(j=0; j<constraint_len; j++)
+        {
+            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
+        }
+    }
+
+    // Precalculate state transition outputs
+    for(i=0; i<(int32)N_states; i++)
+    {
+        // Determine the input path
+        if(i < (N_states/2))
+        {
+            in_path = 0;
+        }else{
+            in_path = 1;
+        }
+
+        // Determine the outputs based on the previous state and input path
+        for(j=0; j<2; j++)
         {
-            if(0 == bits[i])
+            prev_state = ((i << 1) + j) % N_states;
+            for(k=0; k<constraint_len; k++)
             {
-                d_re[i] = one_over_sqrt_2;
-                d_im[i] = one_over_sqrt_2;
-            }else{
-                d_re[i] = -one_over_sqrt_2;
-                d_im[i] = -one_over_sqrt_2;
+                s_reg[k] = (prev_state >> (constraint_len-k-1)) & 1;
+            }
+            s_reg[0] = in_path;
+            for(k=0; k<rate; k++)
+            {
+                phy_struct->vd_st_output[i][j][k] = 0;
+                for(o=0; o<constraint_len; o++)
+                {
+                    phy_struct->vd_st_output[i][j][k] += s_reg[o]*g_array[k][o];
+                }
+                phy_struct->vd_st_output[i][j][k] %= 2;
             }
         }
-        *M_symb = N_bits;
-        break;
-    case LIBLTE_PHY_MODULATION_TYPE_QPSK:
-        // 3GPP TS 36.211 v10.1.0 section 7.1.2
-        for(i=0; i<(N_bits/2); i++)
+    }
+
+    // Calculate branch and path metrics
+    for(i=0; i<(int32)N_states; i++)
+    {
+        for(j=0; j<(N_d_bits/rate)+10; j++)
+        {
+            phy_struct->vd_path_metric[i][j] = 0;
+        }
+    }
+    for(i=0; i<(int32)(N_d_bits/rate); i++)
+    {
+        for(j=0; j<N_states; j++)
         {
-            switch((bits[i*2] << 1) |
-                   bits[i*2+1])
+            phy_struct->vd_br_metric[j][0] = 0;
+            phy_struct->vd_br_metric[j][1] = 0;
+            phy_struct->vd_p_metric[j][0]  = 0;
+            phy_struct->vd_p_metric[j][1]  = 0;
+            phy_struct->vd_w_metric[j][0]  = 0;
+            phy_struct->vd_w_metric[j][1]  = 0;
+
+            // Calculate the accumulated branch metrics for each state
+            for(k=0; k<2; k++)
             {
-            case 0:
-                d_re[i] = +one_over_sqrt_2;
-                d_im[i] = +one_over_sqrt_2;
-                break;
-            case 1:
-                d_re[i] = +one_over_sqrt_2;
-                d_im[i] = -one_over_sqrt_2;
-                break;
-            case 2:
-                d_re[i] = -one_over_sqrt_2;
-                d_im[i] = +one_over_sqrt_2;
-                break;
-            case 3:
-                d_re[i] = -one_over_sqrt_2;
-                d_im[i] = -one_over_sqrt_2;
-                break;
+                prev_state                    = ((j<<1)+k) % N_states;
+                phy_struct->vd_p_metric[j][k] = phy_struct->vd_path_metric[prev_state][i];
+                for(o=0; o<rate; o++)
+                {
+                    if(d_bits[i*rate + o] >= 0)
+                    {
+                        in_bit = 0;
+                    }else{
+                        in_bit = 1;
+                    }
+                    phy_struct->vd_br_metric[j][k] += (phy_struct->vd_st_output[j][k][o]+in_bit)%2;
+                    phy_struct->vd_w_metric[j][k]  += fabs(d_bits[i*rate + o]);
+                }
             }
-        }
-        *M_symb = (N_bits/2);
-        if((N_bits % 2) != 0)
-        {
-            *M_symb = (N_bits/2) + 1;
-            // Add a trailing zero
-            if(0 == bits[N_bits-1])
+
+            // Keep the smallest branch metric as the path metric, weight the branch metric
+            tmp1 = phy_struct->vd_br_metric[j][0] + phy_struct->vd_p_metric[j][0];
+            tmp2 = phy_struct->vd_br_metric[j][1] + phy_struct->vd_p_metric[j][1];
+            if(tmp1 > tmp2)
             {
-                d_re[i] = +one_over_sqrt_2;
-                d_im[i] = +one_over_sqrt_2;
+                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][1] + phy_struct->vd_w_metric[j][1]*phy_struct->vd_br_metric[j][1];
             }else{
-                d_re[i] = -one_over_sqrt_2;
-                d_im[i] = +one_over_sqrt_2;
+                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][0] + phy_struct->vd_w_metric[j][0]*phy_struct->vd_br_metric[j][0];
             }
         }
-        break;
-    case LIBLTE_PHY_MODULATION_TYPE_16QAM:
-        // 3GPP TS 36.211 v10.1.0 section 7.1.3
-        for(i=0; i<(N_bits/4); i++)
+    }
+
+    // Find the minimum metric for the last iteration
+    init_min                     = 1000000;
+    idx                          = 0;
+    phy_struct->vd_tb_state[idx] = 1000000;
+    for(i=0; i<(int32)N_states; i++)
+    {
+        if(phy_struct->vd_path_metric[i][(N_d_bits/rate)] < init_min)
         {
-            switch((bits[i*4+0] << 3) |
-                   (bits[i*4+1] << 2) |
-                   (bits[i*4+2] << 1) |
-                   bits[i*4+3])
-            {
-            case 0:
-                d_re[i] = +1*one_over_sqrt_10;
-                d_im[i] = +1*one_over_sqrt_10;
-                break;
-            case 1:
-                d_re[i] = +1*one_over_sqrt_10;
-                d_im[i] = +3*one_over_sqrt_10;
-                break;
-            case 2:
-                d_re[i] = +3*one_over_sqrt_10;
-                d_im[i] = +1*one_over_sqrt_10;
-                break;
-            case 3:
-                d_re[i] = +3*one_over_sqrt_10;
-                d_im[i] = +3*one_over_sqrt_10;
-                break;
-            case 4:
-                d_re[i] = +1*one_over_sqrt_10;
-                d_im[i] = -1*one_over_sqrt_10;
-                break;
-            case 5:
-                d_re[i] = +1*one_over_sqrt_10;
-                d_im[i] = -3*one_over_sqrt_10;
-                break;
-            case 6:
-                d_re[i] = +3*one_over_sqrt_10;
-                d_im[i] = -1*one_over_sqrt_10;
-                break;
-            case 7:
-                d_re[i] = +3*one_over_sqrt_10;
-                d_im[i] = -3*one_over_sqrt_10;
-                break;
-            case 8:
-                d_re[i] = -1*one_over_sqrt_10;
-                d_im[i] = +1*one_over_sqrt_10;
-                break;
-            case 9:
-                d_re[i] = -1*one_over_sqrt_10;
-                d_im[i] = +3*one_over_sqrt_10;
-                break;
-            case 10:
-                d_re[i] = -3*one_over_sqrt_10;
-                d_im[i] = +1*one_over_sqrt_10;
-                break;
-            case 11:
-                d_re[i] = -3*one_over_sqrt_10;
-                d_im[i] = +3*one_over_sqrt_10;
-                break;
-            case 12:
-                d_re[i] = -1*one_over_sqrt_10;
-                d_im[i] = -1*one_over_sqrt_10;
-                break;
-            case 13:
-                d_re[i] = -1*one_over_sqrt_10;
-                d_im[i] = -3*one_over_sqrt_10;
-                break;
-            case 14:
-                d_re[i] = -3*one_over_sqrt_10;
-                d_im[i] = -1*one_over_sqrt_10;
-                break;
-            case 15:
-                d_re[i] = -3*one_over_sqrt_10;
-                d_im[i] = -3*one_over_sqrt_10;
-                break;
-            }
+            init_min                       = phy_struct->vd_path_metric[i][(N_d_bits/rate)];
+            phy_struct->vd_tb_state[idx++] = i;
         }
-        *M_symb = (N_bits/4);
-        if((N_bits % 4) != 0)
+    }
+
+    // Traceback to find the minimum path metrics at each iteration
+    for(i=(N_d_bits/rate)-1; i>=0; i--)
+    {
+        prev_state_0 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 0) % N_states;
+        prev_state_1 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 1) % N_states;
+
+        // Keep the smallest state
+        if(phy_struct->vd_path_metric[prev_state_0][i] > phy_struct->vd_path_metric[prev_state_1][i])
         {
-            *M_symb = (N_bits/4) + 1;
-            if((N_bits % 4) == 1)
-            {
-                input = bits[N_bits-1] << 3;
-            }else if((N_bits % 4) == 2){
-                input = ((bits[N_bits-2] << 3) |
-                        (bits[N_bits-1] << 2));
-            }else if((N_bits % 4) == 3){
-                input = ((bits[N_bits-3] << 3) |
-                         (bits[N_bits-2] << 2) |
-                         (bits[N_bits-1] << 1));
-            }
-            switch(input)
-            {
-            case 0:
-                d_re[N_bits/4] = +1*one_over_sqrt_10;
-                d_im[N_bits/4] = +1*one_over_sqrt_10;
-                break;
-            case 1:
-                d_re[N_bits/4] = +1*one_over_sqrt_10;
-                d_im[N_bits/4] = +3*one_over_sqrt_10;
-                break;
-            case 2:
-                d_re[N_bits/4] = +3*one_over_sqrt_10;
-                d_im[N_bits/4] = +1*one_over_sqrt_10;
-                break;
-            case 3:
-                d_re[N_bits/4] = +3*one_over_sqrt_10;
-                d_im[N_bits/4] = +3*one_over_sqrt_10;
-                break;
-            case 4:
-                d_re[N_bits/4] = +1*one_over_sqrt_10;
-                d_im[N_bits/4] = -1*one_over_sqrt_10;
-                break;
-            case 5:
-                d_re[N_bits/4] = +1*one_over_sqrt_10;
-                d_im[N_bits/4] = -3*one_over_sqrt_10;
-                break;
-            case 6:
-                d_re[N_bits/4] = +3*one_over_sqrt_10;
-                d_im[N_bits/4] = -1*one_over_sqrt_10;
-                break;
-            case 7:
-                d_re[N_bits/4] = +3*one_over_sqrt_10;
-                d_im[N_bits/4] = -3*one_over_sqrt_10;
-                break;
-            case 8:
-                d_re[N_bits/4] = -1*one_over_sqrt_10;
-                d_im[N_bits/4] = +1*one_over_sqrt_10;
-                break;
-            case 9:
-                d_re[N_bits/4] = -1*one_over_sqrt_10;
-                d_im[N_bits/4] = +3*one_over_sqrt_10;
-                break;
-            case 10:
-                d_re[N_bits/4] = -3*one_over_sqrt_10;
-                d_im[N_bits/4] = +1*one_over_sqrt_10;
-                break;
-            case 11:
-                d_re[N_bits/4] = -3*one_over_sqrt_10;
-                d_im[N_bits/4] = +3*one_over_sqrt_10;
-                break;
-            case 12:
-                d_re[N_bits/4] = -1*one_over_sqrt_10;
-                d_im[N_bits/4] = -1*one_over_sqrt_10;
-                break;
-            case 13:
-                d_re[N_bits/4] = -1*one_over_sqrt_10;
-                d_im[N_bits/4] = -3*one_over_sqrt_10;
-                break;
-            case 14:
-                d_re[N_bits/4] = -3*one_over_sqrt_10;
-                d_im[N_bits/4] = -1*one_over_sqrt_10;
-                break;
-            case 15:
-                d_re[N_bits/4] = -3*one_over_sqrt_10;
-                d_im[N_bits/4] = -3*one_over_sqrt_10;
-                break;
-            }
-        }
-        break;
-    case LIBLTE_PHY_MODULATION_TYPE_64QAM:
-        // 3GPP TS 36.211 v10.1.0 section 7.1.4
-        for(i=0; i<(N_bits/6); i++)
-        {
-            switch((bits[i*6+0] << 5) |
-                   (bits[i*6+1] << 4) |
-                   (bits[i*6+2] << 3) |
-                   (bits[i*6+3] << 2) |
-                   (bits[i*6+4] << 1) |
-                   bits[i*6+5])
-            {
-            case 0:
-                d_re[i] = +3*one_over_sqrt_42;
-                d_im[i] = +3*one_over_sqrt_42;
-                break;
-            case 1:
-                d_re[i] = +3*one_over_sqrt_42;
-                d_im[i] = +1*one_over_sqrt_42;
-                break;
-            case 2:
-                d_re[i] = +1*one_over_sqrt_42;
-                d_im[i] = +3*one_over_sqrt_42;
-                break;
-            case 3:
-                d_re[i] = +1*one_over_sqrt_42;
-                d_im[i] = +1*one_over_sqrt_42;
-                break;
-            case 4:
-                d_re[i] = +3*one_over_sqrt_42;
-                d_im[i] = +5*one_over_sqrt_42;
-                break;
-            case 5:
-                d_re[i] = +3*one_over_sqrt_42;
-                d_im[i] = +7*one_over_sqrt_42;
-                break;
-            case 6:
-                d_re[i] = +1*one_over_sqrt_42;
-                d_im[i] = +5*one_over_sqrt_42;
-                break;
-            case 7:
-                d_re[i] = +1*one_over_sqrt_42;
-                d_im[i] = +7*one_over_sqrt_42;
-                break;
-            case 8:
-                d_re[i] = +5*one_over_sqrt_42;
-                d_im[i] = +3*one_over_sqrt_42;
-                break;
-            case 9:
-                d_re[i] = +5*one_over_sqrt_42;
-                d_im[i] = +1*one_over_sqrt_42;
-                break;
-            case 10:
-                d_re[i] = +7*one_over_sqrt_42;
-                d_im[i] = +3*one_over_sqrt_42;
-                break;
-            case 11:
-                d_re[i] = +7*one_over_sqrt_42;
-                d_im[i] = +1*one_over_sqrt_42;
-                break;
-            case 12:
-                d_re[i] = +5*one_over_sqrt_42;
-                d_im[i] = +5*one_over_sqrt_42;
-                break;
-            case 13:
-                d_re[i] = +5*one_over_sqrt_42;
-                d_im[i] = +7*one_over_sqrt_42;
-                break;
-            case 14:
-                d_re[i] = +7*one_over_sqrt_42;
-                d_im[i] = +5*one_over_sqrt_42;
-                break;
-            case 15:
-                d_re[i] = +7*one_over_sqrt_42;
-                d_im[i] = +7*one_over_sqrt_42;
-                break;
-            case 16:
-                d_re[i] = +3*one_over_sqrt_42;
-                d_im[i] = -3*one_over_sqrt_42;
-                break;
-            case 17:
-                d_re[i] = +3*one_over_sqrt_42;
-                d_im[i] = -1*one_over_sqrt_42;
-                break;
-            case 18:
-                d_re[i] = +1*one_over_sqrt_42;
-                d_im[i] = -3*one_over_sqrt_42;
-                break;
-            case 19:
-                d_re[i] = +1*one_over_sqrt_42;
-                d_im[i] = -1*one_over_sqrt_42;
-                break;
-            case 20:
-                d_re[i] = +3*one_over_sqrt_42;
-                d_im[i] = -5*one_over_sqrt_42;
-                break;
-            case 21:
-                d_re[i] = +3*one_over_sqrt_42;
-                d_im[i] = -7*one_over_sqrt_42;
-                break;
-            case 22:
-                d_re[i] = +1*one_over_sqrt_42;
-                d_im[i] = -5*one_over_sqrt_42;
-                break;
-            case 23:
-                d_re[i] = +1*one_over_sqrt_42;
-                d_im[i] = -7*one_over_sqrt_42;
-                break;
-            case 24:
-                d_re[i] = +5*one_over_sqrt_42;
-                d_im[i] = -3*one_over_sqrt_42;
-                break;
-            case 25:
-                d_re[i] = +5*one_over_sqrt_42;
-                d_im[i] = -1*one_over_sqrt_42;
-                break;
-            case 26:
-                d_re[i] = +7*one_over_sqrt_42;
-                d_im[i] = -3*one_over_sqrt_42;
-                break;
-            case 27:
-                d_re[i] = +7*one_over_sqrt_42;
-                d_im[i] = -1*one_over_sqrt_42;
-                break;
-            case 28:
-                d_re[i] = +5*one_over_sqrt_42;
-                d_im[i] = -5*one_over_sqrt_42;
-                break;
-            case 29:
-                d_re[i] = +5*one_over_sqrt_42;
-                d_im[i] = -7*one_over_sqrt_42;
-                break;
-            case 30:
-                d_re[i] = +7*one_over_sqrt_42;
-                d_im[i] = -5*one_over_sqrt_42;
-                break;
-            case 31:
-                d_re[i] = +7*one_over_sqrt_42;
-                d_im[i] = -7*one_over_sqrt_42;
-                break;
-            case 32:
-                d_re[i] = -3*one_over_sqrt_42;
-                d_im[i] = +3*one_over_sqrt_42;
-                break;
-            case 33:
-                d_re[i] = -3*one_over_sqrt_42;
-                d_im[i] = +1*one_over_sqrt_42;
-                break;
-            case 34:
-                d_re[i] = -1*one_over_sqrt_42;
-                d_im[i] = +3*one_over_sqrt_42;
-                break;
-            case 35:
-                d_re[i] = -1*one_over_sqrt_42;
-                d_im[i] = +1*one_over_sqrt_42;
-                break;
-            case 36:
-                d_re[i] = -3*one_over_sqrt_42;
-                d_im[i] = +5*one_over_sqrt_42;
-                break;
-            case 37:
-                d_re[i] = -3*one_over_sqrt_42;
-                d_im[i] = +7*one_over_sqrt_42;
-                break;
-            case 38:
-                d_re[i] = -1*one_over_sqrt_42;
-                d_im[i] = +5*one_over_sqrt_42;
-                break;
-            case 39:
-                d_re[i] = -1*one_over_sqrt_42;
-                d_im[i] = +7*one_over_sqrt_42;
-                break;
-            case 40:
-                d_re[i] = -5*one_over_sqrt_42;
-                d_im[i] = +3*one_over_sqrt_42;
-                break;
-            case 41:
-                d_re[i] = -5*one_over_sqrt_42;
-                d_im[i] = +1*one_over_sqrt_42;
-                break;
-            case 42:
-                d_re[i] = -7*one_over_sqrt_42;
-                d_im[i] = +3*one_over_sqrt_42;
-                break;
-            case 43:
-                d_re[i] = -7*one_over_sqrt_42;
-                d_im[i] = +1*one_over_sqrt_42;
-                break;
-            case 44:
-                d_re[i] = -5*one_over_sqrt_42;
-                d_im[i] = +5*one_over_sqrt_42;
-                break;
-            case 45:
-                d_re[i] = -5*one_over_sqrt_42;
-                d_im[i] = +7*one_over_sqrt_42;
-                break;
-            case 46:
-                d_re[i] = -7*one_over_sqrt_42;
-                d_im[i] = +5*one_over_sqrt_42;
-                break;
-            case 47:
-                d_re[i] = -7*one_over_sqrt_42;
-                d_im[i] = +7*one_over_sqrt_42;
-                break;
-            case 48:
-                d_re[i] = -3*one_over_sqrt_42;
-                d_im[i] = -3*one_over_sqrt_42;
-                break;
-            case 49:
-                d_re[i] = -3*one_over_sqrt_42;
-                d_im[i] = -1*one_over_sqrt_42;
-                break;
-            case 50:
-                d_re[i] = -1*one_over_sqrt_42;
-                d_im[i] = -3*one_over_sqrt_42;
-                break;
-            case 51:
-                d_re[i] = -1*one_over_sqrt_42;
-                d_im[i] = -1*one_over_sqrt_42;
-                break;
-            case 52:
-                d_re[i] = -3*one_over_sqrt_42;
-                d_im[i] = -5*one_over_sqrt_42;
-                break;
-            case 53:
-                d_re[i] = -3*one_over_sqrt_42;
-                d_im[i] = -7*one_over_sqrt_42;
-                break;
-            case 54:
-                d_re[i] = -1*one_over_sqrt_42;
-                d_im[i] = -5*one_over_sqrt_42;
-                break;
-            case 55:
-                d_re[i] = -1*one_over_sqrt_42;
-                d_im[i] = -7*one_over_sqrt_42;
-                break;
-            case 56:
-                d_re[i] = -5*one_over_sqrt_42;
-                d_im[i] = -3*one_over_sqrt_42;
-                break;
-            case 57:
-                d_re[i] = -5*one_over_sqrt_42;
-                d_im[i] = -1*one_over_sqrt_42;
-                break;
-            case 58:
-                d_re[i] = -7*one_over_sqrt_42;
-                d_im[i] = -3*one_over_sqrt_42;
-                break;
-            case 59:
-                d_re[i] = -7*one_over_sqrt_42;
-                d_im[i] = -1*one_over_sqrt_42;
-                break;
-            case 60:
-                d_re[i] = -5*one_over_sqrt_42;
-                d_im[i] = -5*one_over_sqrt_42;
-                break;
-            case 61:
-                d_re[i] = -5*one_over_sqrt_42;
-                d_im[i] = -7*one_over_sqrt_42;
-                break;
-            case 62:
-                d_re[i] = -7*one_over_sqrt_42;
-                d_im[i] = -5*one_over_sqrt_42;
-                break;
-            case 63:
-                d_re[i] = -7*one_over_sqrt_42;
-                d_im[i] = -7*one_over_sqrt_42;
-                break;
-            }
+            phy_struct->vd_tb_state[idx++] = prev_state_1;
+        }else{
+            phy_struct->vd_tb_state[idx++] = prev_state_0;
         }
-        *M_symb = (N_bits/6);
-        if((N_bits % 6) != 0)
-        {
-            *M_symb = (N_bits/6) + 1;
-            if((N_bits % 6) == 1)
-            {
-                input = bits[N_bits-1] << 5;
-            }else if((N_bits % 6) == 2){
-                input = ((bits[N_bits-2] << 5) |
-                         (bits[N_bits-1] << 4));
-            }else if((N_bits % 6) == 3){
-                input = ((bits[N_bits-3] << 5) |
-                         (bits[N_bits-2] << 4) |
-                         (bits[N_bits-1] << 3));
-            }else if((N_bits % 6) == 4){
-                input = ((bits[N_bits-4] << 5) |
-                         (bits[N_bits-3] << 4) |
-                         (bits[N_bits-2] << 3) |
-                         (bits[N_bits-1] << 2));
-            }else if((N_bits % 6) == 5){
-                input = ((bits[N_bits-5] << 5) |
-                         (bits[N_bits-4] << 4) |
-                         (bits[N_bits-3] << 3) |
-                         (bits[N_bits-2] << 2) |
-                         (bits[N_bits-1] << 1));
-            }
-            switch(input)
-            {
-            case 0:
-                d_re[N_bits/6] = +3*one_over_sqrt_42;
-                d_im[N_bits/6] = +3*one_over_sqrt_42;
-                break;
-            case 1:
-                d_re[N_bits/6] = +3*one_over_sqrt_42;
-                d_im[N_bits/6] = +1*one_over_sqrt_42;
-                break;
-            case 2:
-                d_re[N_bits/6] = +1*one_over_sqrt_42;
-                d_im[N_bits/6] = +3*one_over_sqrt_42;
-                break;
-            case 3:
-                d_re[N_bits/6] = +1*one_over_sqrt_42;
-                d_im[N_bits/6] = +1*one_over_sqrt_42;
-                break;
-            case 4:
-                d_re[N_bits/6] = +3*one_over_sqrt_42;
-                d_im[N_bits/6] = +5*one_over_sqrt_42;
-                break;
-            case 5:
-                d_re[N_bits/6] = +3*one_over_sqrt_42;
-                d_im[N_bits/6] = +7*one_over_sqrt_42;
-                break;
-            case 6:
-                d_re[N_bits/6] = +1*one_over_sqrt_42;
-                d_im[N_bits/6] = +5*one_over_sqrt_42;
-                break;
-            case 7:
-                d_re[N_bits/6] = +1*one_over_sqrt_42;
-                d_im[N_bits/6] = +7*one_over_sqrt_42;
-                break;
-            case 8:
-                d_re[N_bits/6] = +5*one_over_sqrt_42;
-                d_im[N_bits/6] = +3*one_over_sqrt_42;
-                break;
-            case 9:
-                d_re[N_bits/6] = +5*one_over_sqrt_42;
-                d_im[N_bits/6] = +1*one_over_sqrt_42;
-                break;
-            case 10:
-                d_re[N_bits/6] = +7*one_over_sqrt_42;
-                d_im[N_bits/6] = +3*one_over_sqrt_42;
-                break;
-            case 11:
-                d_re[N_bits/6] = +7*one_over_sqrt_42;
-                d_im[N_bits/6] = +1*one_over_sqrt_42;
-                break;
-            case 12:
-                d_re[N_bits/6] = +5*one_over_sqrt_42;
-                d_im[N_bits/6] = +5*one_over_sqrt_42;
-                break;
-            case 13:
-                d_re[N_bits/6] = +5*one_over_sqrt_42;
-                d_im[N_bits/6] = +7*one_over_sqrt_42;
-                break;
-            case 14:
-                d_re[N_bits/6] = +7*one_over_sqrt_42;
-                d_im[N_bits/6] = +5*one_over_sqrt_42;
-                break;
-            case 15:
-                d_re[N_bits/6] = +7*one_over_sqrt_42;
-                d_im[N_bits/6] = +7*one_over_sqrt_42;
-                break;
-            case 16:
-                d_re[N_bits/6] = +3*one_over_sqrt_42;
-                d_im[N_bits/6] = -3*one_over_sqrt_42;
-                break;
-            case 17:
-                d_re[N_bits/6] = +3*one_over_sqrt_42;
-                d_im[N_bits/6] = -1*one_over_sqrt_42;
-                break;
-            case 18:
-                d_re[N_bits/6] = +1*one_over_sqrt_42;
-                d_im[N_bits/6] = -3*one_over_sqrt_42;
-                break;
-            case 19:
-                d_re[N_bits/6] = +1*one_over_sqrt_42;
-                d_im[N_bits/6] = -1*one_over_sqrt_42;
-                break;
-            case 20:
-                d_re[N_bits/6] = +3*one_over_sqrt_42;
-                d_im[N_bits/6] = -5*one_over_sqrt_42;
-                break;
-            case 21:
-                d_re[N_bits/6] = +3*one_over_sqrt_42;
-                d_im[N_bits/6] = -7*one_over_sqrt_42;
-                break;
-            case 22:
-                d_re[N_bits/6] = +1*one_over_sqrt_42;
-                d_im[N_bits/6] = -5*one_over_sqrt_42;
-                break;
-            case 23:
-                d_re[N_bits/6] = +1*one_over_sqrt_42;
-                d_im[N_bits/6] = -7*one_over_sqrt_42;
-                break;
-            case 24:
-                d_re[N_bits/6] = +5*one_over_sqrt_42;
-                d_im[N_bits/6] = -3*one_over_sqrt_42;
-                break;
-            case 25:
-                d_re[N_bits/6] = +5*one_over_sqrt_42;
-                d_im[N_bits/6] = -1*one_over_sqrt_42;
-                break;
-            case 26:
-                d_re[N_bits/6] = +7*one_over_sqrt_42;
-                d_im[N_bits/6] = -3*one_over_sqrt_42;
-                break;
-            case 27:
-                d_re[N_bits/6] = +7*one_over_sqrt_42;
-                d_im[N_bits/6] = -1*one_over_sqrt_42;
-                break;
-            case 28:
-                d_re[N_bits/6] = +5*one_over_sqrt_42;
-                d_im[N_bits/6] = -5*one_over_sqrt_42;
-                break;
-            case 29:
-                d_re[N_bits/6] = +5*one_over_sqrt_42;
-                d_im[N_bits/6] = -7*one_over_sqrt_42;
-                break;
-            case 30:
-                d_re[N_bits/6] = +7*one_over_sqrt_42;
-                d_im[N_bits/6] = -5*one_over_sqrt_42;
-                break;
-            case 31:
-                d_re[N_bits/6] = +7*one_over_sqrt_42;
-                d_im[N_bits/6] = -7*one_over_sqrt_42;
-                break;
-            case 32:
-                d_re[N_bits/6] = -3*one_over_sqrt_42;
-                d_im[N_bits/6] = +3*one_over_sqrt_42;
-                break;
-            case 33:
-                d_re[N_bits/6] = -3*one_over_sqrt_42;
-                d_im[N_bits/6] = +1*one_over_sqrt_42;
-                break;
-            case 34:
-                d_re[N_bits/6] = -1*one_over_sqrt_42;
-                d_im[N_bits/6] = +3*one_over_sqrt_42;
-                break;
-            case 35:
-                d_re[N_bits/6] = -1*one_over_sqrt_42;
-                d_im[N_bits/6] = +1*one_over_sqrt_42;
-                break;
-            case 36:
-                d_re[N_bits/6] = -3*one_over_sqrt_42;
-                d_im[N_bits/6] = +5*one_over_sqrt_42;
-                break;
-            case 37:
-                d_re[N_bits/6] = -3*one_over_sqrt_42;
-                d_im[N_bits/6] = +7*one_over_sqrt_42;
-                break;
-            case 38:
-                d_re[N_bits/6] = -1*one_over_sqrt_42;
-                d_im[N_bits/6] = +5*one_over_sqrt_42;
-                break;
-            case 39:
-                d_re[N_bits/6] = -1*one_over_sqrt_42;
-                d_im[N_bits/6] = +7*one_over_sqrt_42;
-                break;
-            case 40:
-                d_re[N_bits/6] = -5*one_over_sqrt_42;
-                d_im[N_bits/6] = +3*one_over_sqrt_42;
-                break;
-            case 41:
-                d_re[N_bits/6] = -5*one_over_sqrt_42;
-                d_im[N_bits/6] = +1*one_over_sqrt_42;
-                break;
-            case 42:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = +3*one_over_sqrt_42;
-                break;
-            case 43:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = +1*one_over_sqrt_42;
-                break;
-            case 44:
-                d_re[N_bits/6] = -5*one_over_sqrt_42;
-                d_im[N_bits/6] = +5*one_over_sqrt_42;
-                break;
-            case 45:
-                d_re[N_bits/6] = -5*one_over_sqrt_42;
-                d_im[N_bits/6] = +7*one_over_sqrt_42;
-                break;
-            case 46:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = +5*one_over_sqrt_42;
-                break;
-            case 47:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = +7*one_over_sqrt_42;
-                break;
-            case 48:
-                d_re[N_bits/6] = -3*one_over_sqrt_42;
-                d_im[N_bits/6] = -3*one_over_sqrt_42;
-                break;
-            case 49:
-                d_re[N_bits/6] = -3*one_over_sqrt_42;
-                d_im[N_bits/6] = -1*one_over_sqrt_42;
-                break;
-            case 50:
-                d_re[N_bits/6] = -1*one_over_sqrt_42;
-                d_im[N_bits/6] = -3*one_over_sqrt_42;
-                break;
-            case 51:
-                d_re[N_bits/6] = -1*one_over_sqrt_42;
-                d_im[N_bits/6] = -1*one_over_sqrt_42;
-                break;
-            case 52:
-                d_re[N_bits/6] = -3*one_over_sqrt_42;
-                d_im[N_bits/6] = -5*one_over_sqrt_42;
-                break;
-            case 53:
-                d_re[N_bits/6] = -3*one_over_sqrt_42;
-                d_im[N_bits/6] = -7*one_over_sqrt_42;
-                break;
-            case 54:
-                d_re[N_bits/6] = -1*one_over_sqrt_42;
-                d_im[N_bits/6] = -5*one_over_sqrt_42;
-                break;
-            case 55:
-                d_re[N_bits/6] = -1*one_over_sqrt_42;
-                d_im[N_bits/6] = -7*one_over_sqrt_42;
-                break;
-            case 56:
-                d_re[N_bits/6] = -5*one_over_sqrt_42;
-                d_im[N_bits/6] = -3*one_over_sqrt_42;
-                break;
-            case 57:
-                d_re[N_bits/6] = -5*one_over_sqrt_42;
-                d_im[N_bits/6] = -1*one_over_sqrt_42;
-                break;
-            case 58:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = -3*one_over_sqrt_42;
-                break;
-            case 59:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = -1*one_over_sqrt_42;
-                break;
-            case 60:
-                d_re[N_bits/6] = -5*one_over_sqrt_42;
-                d_im[N_bits/6] = -5*one_over_sqrt_42;
-                break;
-            case 61:
-                d_re[N_bits/6] = -5*one_over_sqrt_42;
-                d_im[N_bits/6] = -7*one_over_sqrt_42;
-                break;
-            case 62:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = -5*one_over_sqrt_42;
-                break;
-            case 63:
-                d_re[N_bits/6] = -7*one_over_sqrt_42;
-                d_im[N_bits/6] = -7*one_over_sqrt_42;
-                break;
+    }
+    tb_state_len = idx;
+
+    // Read through the traceback to determine the input bits
+    idx = 0;
+    for(i=tb_state_len-2; i>=0; i--)
+    {
+        // If transition has resulted in a lower valued state,
+        // the output is 0 and vice-versa
+        if(phy_struct->vd_tb_state[i] < phy_struct->vd_tb_state[i+1])
+        {
+            c_bits[idx++] = 0;
+        }else if(phy_struct->vd_tb_state[i] > phy_struct->vd_tb_state[i+1]){
+            c_bits[idx++] = 1;
+        }else{
+            // Check to see if the transition has resulted in the same state
+            // In this case, if state is 0 then output is 0
+            if(phy_struct->vd_tb_state[i] == 0)
+            {
+                c_bits[idx++] = 0;
+            }else{
+                c_bits[idx++] = 1;
             }
         }
-        break;
     }
+    *N_c_bits = idx;
 }
 
 /*********************************************************************
-    Name: modulation_demapper
-
-    Description: Maps complex-valued modulation symbols to binary
-                 digits
+    Name: viterbi_decode_siso
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.1
+    Description: Soft input soft output viterbi decodes a
+                 convolutionally coded input bit array using the
+                 provided parameters
 
-    NOTES: Currently only supports BPSK and QPSK
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
-void modulation_demapper(float                           *d_re,
-                         float                           *d_im,
-                         uint32                           M_symb,
-                         LIBLTE_PHY_MODULATION_TYPE_ENUM  type,
-                         int8                            *bits,
-                         uint32                          *N_bits)
+void viterbi_decode_siso(LIBLTE_PHY_STRUCT *phy_struct,
+                         int8              *d_bits,
+                         uint32             N_d_bits,
+                         uint32             constraint_len,
+                         uint32             rate,
+                         uint32            *g,
+                         int8              *c_bits,
+                         uint32            *N_c_bits)
 {
-    float  ang;
-    float  sd;
-    float  act_d_re;
-    float  act_d_im;
-    float  one_over_sqrt_2   = 1/sqrt(2);
-    float  two_over_sqrt_10  = 2/sqrt(10);
-    float  two_over_sqrt_42  = 2/sqrt(42);
-    float  four_over_sqrt_42 = 4/sqrt(42);
-    float  six_over_sqrt_42  = 6/sqrt(42);
-    uint32 i;
+    float  init_min;
+    float  tmp1;
+    float  tmp2;
+    float  max_weight = 0;
+    int32  i;
+    uint32 j;
+    uint32 k;
+    uint32 o;
+    uint32 N_states = 1<<(constraint_len-1);
+    uint32 idx;
+    uint32 tb_state_len;
+    uint8  in_path;
+    uint8  prev_state;
+    uint8  in_bit;
+    uint8  prev_state_0;
+    uint8  prev_state_1;
+    uint8  s_reg[constraint_len];
+    uint8  g_array[3][constraint_len];
 
-    if(LIBLTE_PHY_MODULATION_TYPE_BPSK == type)
+    // Convert g to binary
+    for(i=0; i<(int32)rate; i++)
     {
-        // 3GPP TS 36.211 v10.1.0 section 7.1.1
-        *N_bits = M_symb;
-        for(i=0; i<M_symb; i++)
+        for(j=0; j<constraint_len; j++)
         {
-            ang = atan2f(d_im[i], d_re[i]);
-            if((ang > -M_PI/4) && (ang < 3*M_PI/4))
-            {
-                act_d_re = +one_over_sqrt_2;
-                act_d_im = +one_over_sqrt_2;
-                sd       = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i]  = +(int8)(127*sd);
-            }else{
-                act_d_re = -one_over_sqrt_2;
-                act_d_im = -one_over_sqrt_2;
-                sd       = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i]  = -(int8)(127*sd);
-            }
+            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
         }
-    }else if(LIBLTE_PHY_MODULATION_TYPE_QPSK == type){
-        // 3GPP TS 36.211 v10.1.0 section 7.1.2
-        *N_bits = M_symb*2;
-        for(i=0; i<M_symb; i++)
+    }
+
+    // Precalculate state transition outputs
+    for(i=0; i<(int32)N_states; i++)
+    {
+        // Determine the input path
+        if(i < (N_states/2))
         {
-            ang = atan2f(d_im[i], d_re[i]);
-            if((ang >= 0) && (ang < M_PI/2))
-            {
-                act_d_re    = +one_over_sqrt_2;
-                act_d_im    = +one_over_sqrt_2;
-                sd          = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i*2+0] = +(int8)(127*sd);
-                bits[i*2+1] = +(int8)(127*sd);
-            }else if((ang >= -M_PI/2) && (ang < 0)){
-                act_d_re    = +one_over_sqrt_2;
-                act_d_im    = -one_over_sqrt_2;
-                sd          = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i*2+0] = +(int8)(127*sd);
-                bits[i*2+1] = -(int8)(127*sd);
-            }else if((ang >= M_PI/2) && (ang < M_PI)){
-                act_d_re    = -one_over_sqrt_2;
-                act_d_im    = +one_over_sqrt_2;
-                sd          = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i*2+0] = -(int8)(127*sd);
-                bits[i*2+1] = +(int8)(127*sd);
-            }else{
-                act_d_re    = -one_over_sqrt_2;
-                act_d_im    = -one_over_sqrt_2;
-                sd          = get_soft_decision(d_re[i], d_im[i], act_d_re, act_d_im, 1);
-                bits[i*2+0] = -(int8)(127*sd);
-                bits[i*2+1] = -(int8)(127*sd);
-            }
+            in_path = 0;
+        }else{
+            in_path = 1;
         }
-    }else if(LIBLTE_PHY_MODULATION_TYPE_16QAM == type){
-        // 3GPP TS 36.211 v10.1.0 section 7.1.3
-        *N_bits = M_symb*4;
-        // FIXME: Need to make soft decisions
-        for(i=0; i<M_symb; i++)
+
+        // Determine the outputs based on the previous state and input path
+        for(j=0; j<2; j++)
         {
-            if(d_re[i] > 0)
-            {
-                bits[i*4+0] = +127;
-            }else{
-                bits[i*4+0] = -127;
-            }
-            if(d_im[i] > 0)
-            {
-                bits[i*4+1] = +127;
-            }else{
-                bits[i*4+1] = -127;
-            }
-            if(fabs(d_re[i]) < two_over_sqrt_10)
+            prev_state = ((i << 1) + j) % N_states;
+            for(k=0; k<constraint_len; k++)
             {
-                bits[i*4+2] = +127;
-            }else{
-                bits[i*4+2] = -127;
+                s_reg[k] = (prev_state >> (constraint_len-k-1)) & 1;
             }
-            if(fabs(d_im[i]) < two_over_sqrt_10)
+            s_reg[0] = in_path;
+            for(k=0; k<rate; k++)
             {
-                bits[i*4+3] = +127;
-            }else{
-                bits[i*4+3] = -127;
+                phy_struct->vd_st_output[i][j][k] = 0;
+                for(o=0; o<constraint_len; o++)
+                {
+                    phy_struct->vd_st_output[i][j][k] += s_reg[o]*g_array[k][o];
+                }
+                phy_struct->vd_st_output[i][j][k] %= 2;
             }
         }
-    }else{ // LIBLTE_PHY_MODULATION_TYPE_64QAM == type
-        // 3GPP TS 36.211 v10.1.0 section 7.1.4
-        *N_bits = M_symb*6;
-        // FIXME: Need to make soft decisions
-        for(i=0; i<M_symb; i++)
+    }
+
+    // Calculate branch and path metrics
+    for(i=0; i<(int32)N_states; i++)
+    {
+        for(j=0; j<(N_d_bits/rate)+10; j++)
         {
-            if(d_re[i] > 0)
-            {
-                bits[i*6+0] = +127;
-            }else{
-                bits[i*6+0] = -127;
-            }
-            if(d_im[i] > 0)
-            {
-                bits[i*6+1] = +127;
-            }else{
-                bits[i*6+1] = -127;
-            }
-            if(fabs(d_re[i]) < four_over_sqrt_42)
+            phy_struct->vd_path_metric[i][j] = 0;
+            phy_struct->vd_w_metric[i][j]    = 0;
+        }
+    }
+    for(i=0; i<(int32)(N_d_bits/rate); i++)
+    {
+        for(j=0; j<N_states; j++)
+        {
+            phy_struct->vd_br_metric[j][0] = 0;
+            phy_struct->vd_br_metric[j][1] = 0;
+            phy_struct->vd_p_metric[j][0]  = 0;
+            phy_struct->vd_p_metric[j][1]  = 0;
+            phy_struct->vd_br_weight[j][0] = 0;
+            phy_struct->vd_br_weight[j][1] = 0;
+
+            // Calculate the accumulated branch metrics for each state
+            for(k=0; k<2; k++)
             {
-                bits[i*6+2] = +127;
-                if(fabs(d_re[i]) > two_over_sqrt_42)
+                prev_state                    = ((j<<1)+k) % N_states;
+                phy_struct->vd_p_metric[j][k] = phy_struct->vd_path_metric[prev_state][i];
+                for(o=0; o<rate; o++)
                 {
-                    bits[i*6+4] = +127;
-                }else{
-                    bits[i*6+4] = -127;
+                    if(d_bits[i*rate + o] >= 0)
+                    {
+                        in_bit = 0;
+                    }else{
+                        in_bit = 1;
+                    }
+                    if(phy_struct->vd_st_output[j][k][o] == in_bit)
+                    {
+                        phy_struct->vd_br_metric[j][k] += -1;
+                    }else{
+                        phy_struct->vd_br_metric[j][k] += 1;
+                    }
+                    phy_struct->vd_br_weight[j][k] += fabs(d_bits[i*rate + o]);
                 }
+            }
+
+            // Keep the smallest branch metric as the path metric, weight the branch metric
+            tmp1 = phy_struct->vd_br_metric[j][0] + phy_struct->vd_p_metric[j][0];
+            tmp2 = phy_struct->vd_br_metric[j][1] + phy_struct->vd_p_metric[j][1];
+            if(tmp1 > tmp2)
+            {
+                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][1] + phy_struct->vd_br_weight[j][1]*phy_struct->vd_br_metric[j][1];
+                phy_struct->vd_w_metric[j][i+1]    = phy_struct->vd_br_weight[j][1];
             }else{
-                bits[i*6+2] = -127;
-                if(fabs(d_re[i]) < six_over_sqrt_42)
-                {
-                    bits[i*6+4] = +127;
-                }else{
-                    bits[i*6+4] = -127;
-                }
+                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][0] + phy_struct->vd_br_weight[j][0]*phy_struct->vd_br_metric[j][0];
+                phy_struct->vd_w_metric[j][i+1]    = phy_struct->vd_br_weight[j][0];
             }
-            if(fabs(d_im[i]) < four_over_sqrt_42)
+        }
+    }
+
+    // Find the minimum metric for the last iteration
+    init_min                     = 1000000;
+    idx                          = 0;
+    phy_struct->vd_tb_state[idx] = 1000000;
+    for(i=0; i<(int32)N_states; i++)
+    {
+        if(phy_struct->vd_path_metric[i][(N_d_bits/rate)] < init_min)
+        {
+            init_min                      = phy_struct->vd_path_metric[i][(N_d_bits/rate)];
+            phy_struct->vd_tb_state[idx]  = i;
+            phy_struct->vd_tb_weight[idx] = phy_struct->vd_w_metric[i][(N_d_bits/rate)];
+            max_weight                    = phy_struct->vd_tb_weight[idx];
+            idx++;
+        }
+    }
+
+    // Traceback to find the minimum path metrics at each iteration
+    for(i=(N_d_bits/rate)-1; i>=0; i--)
+    {
+        prev_state_0 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 0) % N_states;
+        prev_state_1 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 1) % N_states;
+
+        // Keep the smallest state
+        if(phy_struct->vd_path_metric[prev_state_0][i] > phy_struct->vd_path_metric[prev_state_1][i])
+        {
+            phy_struct->vd_tb_state[idx]  = prev_state_1;
+            phy_struct->vd_tb_weight[idx] = phy_struct->vd_w_metric[prev_state_1][i];
+        }else{
+            phy_struct->vd_tb_state[idx]  = prev_state_0;
+            phy_struct->vd_tb_weight[idx] = phy_struct->vd_w_metric[prev_state_0][i];
+        }
+        if(phy_struct->vd_tb_weight[idx] > max_weight)
+        {
+            max_weight = phy_struct->vd_tb_weight[idx];
+        }
+        idx++;
+    }
+    tb_state_len = idx;
+
+    // Read through the traceback to determine the input bits
+    idx = 0;
+    for(i=tb_state_len-2; i>=0; i--)
+    {
+        // If transition has resulted in a lower valued state,
+        // the output is 0 and vice-versa
+        if(phy_struct->vd_tb_state[i] < phy_struct->vd_tb_state[i+1])
+        {
+            c_bits[idx++] = 127 * (phy_struct->vd_tb_weight[i]/max_weight);
+        }else if(phy_struct->vd_tb_state[i] > phy_struct->vd_tb_state[i+1]){
+            c_bits[idx++] = -127 * (phy_struct->vd_tb_weight[i]/max_weight);
+        }else{
+            // Check to see if the transition has resulted in the same state
+            // In this case, if state is 0 then output is 0
+            if(phy_struct->vd_tb_state[i] == 0)
             {
-                bits[i*6+3] = +127;
-                if(fabs(d_im[i]) > two_over_sqrt_42)
-                {
-                    bits[i*6+5] = +127;
-                }else{
-                    bits[i*6+5] = -127;
-                }
+                c_bits[idx++] = 127 * (phy_struct->vd_tb_weight[i]/max_weight);
             }else{
-                bits[i*6+3] = -127;
-                if(fabs(d_im[i]) < six_over_sqrt_42)
-                {
-                    bits[i*6+5] = +127;
-                }else{
-                    bits[i*6+5] = -127;
-                }
+                c_bits[idx++] = -127 * (phy_struct->vd_tb_weight[i]/max_weight);
             }
         }
     }
+    *N_c_bits = idx;
+}
+
+/*********************************************************************
+    Name: viterbi_decode_k7
+
+    Description: Viterbi decodes a tail-biting, constraint length 7,
+                 rate 1/3 convolutionally coded input bit array using
+                 16 bit path metrics.  The trellis is run around the
+                 circular input with LIBLTE_PHY_VITERBI_K7_WRAP_BITS
+                 extra steps on each side so that the start and end
+                 states converge without knowing them.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+*********************************************************************/
+void viterbi_decode_k7(LIBLTE_PHY_STRUCT *phy_struct,
+                       float             *d_bits,
+                       uint32             N_d_bits,
+                       uint32            *g,
+                       uint8             *c_bits,
+                       uint32            *N_c_bits)
+{
+    VITERBI_K7_ACS_FUNC  acs;
+    float                max_value = 0;
+    float                scale;
+    uint32               N_bits    = N_d_bits/3;
+    uint32               N_wrap;
+    uint32               N_steps;
+    uint32               i;
+    uint32               idx;
+    int32                t;
+    int16               *in        = phy_struct->vd_k7_in;
+    int16               *metric    = phy_struct->vd_k7_metric[0];
+    int16               *metric_next;
+    int16               *tmp;
+    int16                max_metric;
+    uint8                state;
+
+    // Calculate the trellis tables, if needed
+    if(g[0] != phy_struct->vd_k7_g[0] ||
+       g[1] != phy_struct->vd_k7_g[1] ||
+       g[2] != phy_struct->vd_k7_g[2])
+    {
+        viterbi_k7_tables(phy_struct, g);
+    }
+
+    // Select the ACS kernel
+    switch(phy_struct->td_kernel)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+    case LIBLTE_PHY_TURBO_KERNEL_AVX2:
+        acs = viterbi_k7_acs_avx2;
+        break;
+    case LIBLTE_PHY_TURBO_KERNEL_SSE4_1:
+        acs = viterbi_k7_acs_sse4_1;
+        break;
+#endif
+    default:
+        acs = viterbi_k7_acs;
+        break;
+    }
+
+    // Quantize the soft bits, bits that were not received carry no
+    // information
+    for(i=0; i<N_bits*3; i++)
+    {
+        if(RX_NULL_BIT != d_bits[i] &&
+           fabs(d_bits[i]) > max_value)
+        {
+            max_value = fabs(d_bits[i]);
+        }
+    }
+    scale = 0;
+    if(max_value > 0)
+    {
+        scale = VITERBI_K7_SOFT_MAX/max_value;
+    }
+    for(i=0; i<N_bits*3; i++)
+    {
+        if(RX_NULL_BIT == d_bits[i])
+        {
+            in[i] = 0;
+        }else{
+            in[i] = (int16)lrintf(d_bits[i]*scale);
+        }
+    }
+
+    // Run the trellis from N_wrap bits before the start of the input
+    // to N_wrap bits after the end of the input, all states are
+    // equally likely at the start
+    N_wrap = LIBLTE_PHY_VITERBI_K7_WRAP_BITS;
+    if(N_bits < N_wrap)
+    {
+        N_wrap = N_bits;
+    }
+    N_steps = N_bits + 2*N_wrap;
+    memset(metric, 0, sizeof(int16)*LIBLTE_PHY_VITERBI_K7_N_STATES);
+    metric_next = phy_struct->vd_k7_metric[1];
+    idx         = N_bits - N_wrap;
+    for(i=0; i<N_steps; i++)
+    {
+        phy_struct->vd_k7_dec[i] = acs(metric, &in[idx*3], phy_struct->vd_k7_sign, metric_next);
+        tmp                      = metric;
+        metric                   = metric_next;
+        metric_next              = tmp;
+        idx++;
+        if(idx == N_bits)
+        {
+            idx = 0;
+        }
+    }
+
+    // Traceback from the best state, keeping the bits of the middle
+    // pass
+    state      = 0;
+    max_metric = metric[0];
+    for(i=1; i<LIBLTE_PHY_VITERBI_K7_N_STATES; i++)
+    {
+        if(metric[i] > max_metric)
+        {
+            max_metric = metric[i];
+            state      = i;
+        }
+    }
+    for(t=N_steps-1; t>=(int32)N_wrap; t--)
+    {
+        if(t < (int32)(N_wrap + N_bits))
+        {
+            c_bits[t-N_wrap] = state >> 5;
+        }
+        state = ((state << 1) | ((phy_struct->vd_k7_dec[t] >> state) & 1)) & (LIBLTE_PHY_VITERBI_K7_N_STATES-1);
+    }
+    *N_c_bits = N_bits;
 }
 
 /*********************************************************************
-    Name: generate_prs_c
+    Name: viterbi_k7_tables
 
-    Description: Generates the psuedo random sequence c
+    Description: Calculates the branch output signs of the K=7, rate
+                 1/3 trellis for a set of generator polynomials
 
-    Document Reference: 3GPP TS 36.211 v10.1.0 section 7.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
 *********************************************************************/
-void generate_prs_c(uint32  c_init,
-                    uint32  len,
-                    uint32 *c)
+void viterbi_k7_tables(LIBLTE_PHY_STRUCT *phy_struct,
+                       uint32            *g)
 {
-    uint32 i;
-    uint32 x1;
-    uint32 x2;
-    uint8  new_bit1;
-    uint8  new_bit2;
-
-    // Initialize the 2nd m-sequence
-    x2 = c_init;
+    uint32 n;
+    uint32 k;
+    uint32 o;
+    uint32 s_reg;
+    uint32 parity;
 
-    // Advance the 2nd m-sequence
-    for(i=0; i<(1600-31); i++)
+    for(n=0; n<LIBLTE_PHY_VITERBI_K7_N_STATES; n++)
     {
-        new_bit2 = ((x2 >> 3) ^ (x2 >> 2) ^ (x2 >> 1) ^ x2) & 0x1;
-
-        x2 = (x2 >> 1) | (new_bit2 << 30);
+        for(k=0; k<2; k++)
+        {
+            // Input bit followed by the previous state
+            s_reg = ((n >> 5) << 6) | (((n << 1) + k) % LIBLTE_PHY_VITERBI_K7_N_STATES);
+            for(o=0; o<3; o++)
+            {
+                parity                          = __builtin_popcount(s_reg & g[o]) & 1;
+                phy_struct->vd_k7_sign[k][o][n] = 1 - 2*parity;
+            }
+        }
     }
-
-    // Initialize the 1st m-sequence
-    x1 = 0x54D21B24; // This is the result of advancing the initial value of 0x00000001
-
-    // Generate c
-    for(i=0; i<len; i++)
+    for(o=0; o<3; o++)
     {
-        new_bit1 = ((x1 >> 3) ^ x1) & 0x1;
-        new_bit2 = ((x2 >> 3) ^ (x2 >> 2) ^ (x2 >> 1) ^ x2) & 0x1;
-
-        x1 = (x1 >> 1) | (new_bit1 << 30);
-        x2 = (x2 >> 1) | (new_bit2 << 30);
-
-        c[i] = new_bit1 ^ new_bit2;
+        phy_struct->vd_k7_g[o] = g[o];
     }
 }
 
 /*********************************************************************
-    Name: calc_crc
+    Name: viterbi_k7_acs
 
-    Description: Calculates one of the LTE CRCs
+    Description: Performs one add-compare-select step of the K=7,
+                 rate 1/3 trellis, returning the decision bit of
+                 each state
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.1
+    Document Reference: N/A
+
+    Notes: State n is entered from states (2n)%64 (decision 0)
+           and (2n+1)%64 (decision 1) with an input bit of n>>5.
+           Signs are +1 for a coded 0 and -1 for a coded 1.
 *********************************************************************/
-void calc_crc(uint8  *a_bits,
-              uint32  N_a_bits,
-              uint32  crc,
-              uint8  *p_bits,
-              uint32  N_p_bits)
+uint64 viterbi_k7_acs(int16  *metric,
+                      int16  *d,
+                      int16 (*sign)[3][LIBLTE_PHY_VITERBI_K7_N_STATES],
+                      int16  *metric_next)
 {
-    uint32 i;
-    uint32 crc_rem   = 0;
-    uint32 crc_check = (1 << N_p_bits);
-    uint8  tmp_array[N_a_bits + N_p_bits];
-
-    // Initialize tmp_array
-    memset(tmp_array, 0, N_a_bits + N_p_bits);
-    memcpy(tmp_array, a_bits, N_a_bits);
+    uint64 dec = 0;
+    uint64 sel;
+    uint32 n;
+    int32  m_0;
+    int32  m_1;
+    int16  norm;
 
-    for(i=0; i<N_a_bits + N_p_bits; i++)
+    for(n=0; n<LIBLTE_PHY_VITERBI_K7_N_STATES; n++)
     {
-        crc_rem <<= 1;
-        crc_rem  |= tmp_array[i];
-
-        if(crc_rem & crc_check)
-        {
-            crc_rem ^= crc;
-        }
+        m_0             = metric[(2*n)%LIBLTE_PHY_VITERBI_K7_N_STATES] + sign[0][0][n]*d[0] + sign[0][1][n]*d[1] + sign[0][2][n]*d[2];
+        m_1             = metric[(2*n+1)%LIBLTE_PHY_VITERBI_K7_N_STATES] + sign[1][0][n]*d[0] + sign[1][1][n]*d[1] + sign[1][2][n]*d[2];
+        sel             = (m_1 > m_0);
+        metric_next[n]  = sel ? m_1 : m_0;
+        dec            |= sel << n;
     }
 
-    for(i=0; i<N_p_bits; i++)
+    // Keep the metrics relative to state 0
+    norm = metric_next[0];
+    for(n=0; n<LIBLTE_PHY_VITERBI_K7_N_STATES; n++)
     {
-        p_bits[i] = (crc_rem >> (N_p_bits-1-i)) & 1;
+        metric_next[n] -= norm;
     }
+
+    return(dec);
 }
 
+#if defined(__x86_64__) || defined(__i386__)
 /*********************************************************************
-    Name: liblte_phy_code_block_segmentation
+    Name: viterbi_k7_acs_sse4_1
 
-    Description: Performs code block segmentation for turbo coded
-                 channels
+    Description: SSE4.1 version of viterbi_k7_acs, each vector holds
+                 8 butterflies
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+    Document Reference: N/A
 *********************************************************************/
-void liblte_phy_code_block_segmentation(uint8  *b_bits,
-                                        uint32  N_b_bits,
-                                        uint32 *N_codeblocks,
-                                        uint32 *N_filler_bits,
-                                        uint8  *c_bits,
-                                        uint32  N_c_bits_max,
-                                        uint32 *N_c_bits)
+__attribute__((target("sse4.1")))
+uint64 viterbi_k7_acs_sse4_1(int16  *metric,
+                             int16  *d,
+                             int16 (*sign)[3][LIBLTE_PHY_VITERBI_K7_N_STATES],
+                             int16  *metric_next)
 {
-    uint32 Z = 6144;
-    uint32 L;
-    uint32 B;
-    uint32 C;
-    uint32 F;
-    uint32 B_prime;
-    uint32 K_plus  = 0;
-    uint32 K_minus = 0;
-    uint32 K_delta;
-    uint32 K_r;
-    uint32 C_plus;
-    uint32 C_minus;
-    uint32 k;
-    uint32 s;
-    uint32 r;
-    int32  i;
-    uint8  p_cb_bits[24];
+    __m128i deint = _mm_loadu_si128((__m128i *)VITERBI_SIMD_DEINTERLEAVE);
+    __m128i d_0   = _mm_set1_epi16(d[0]);
+    __m128i d_1   = _mm_set1_epi16(d[1]);
+    __m128i d_2   = _mm_set1_epi16(d[2]);
+    __m128i next[8];
+    __m128i a;
+    __m128i b;
+    __m128i p_0;
+    __m128i p_1;
+    __m128i m_0;
+    __m128i m_1;
+    __m128i norm;
+    uint64  dec = 0;
+    uint32  blk;
+    uint32  h;
+    uint32  n;
+
+    for(blk=0; blk<4; blk++)
+    {
+        // Predecessors 2m and 2m+1 of states m and m+32, m=8*blk..8*blk+7
+        a   = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)&metric[16*blk]), deint);
+        b   = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)&metric[16*blk+8]), deint);
+        p_0 = _mm_unpacklo_epi64(a, b);
+        p_1 = _mm_unpackhi_epi64(a, b);
+        for(h=0; h<2; h++)
+        {
+            n   = 8*blk + 32*h;
+            m_0 = _mm_adds_epi16(p_0, _mm_adds_epi16(_mm_adds_epi16(_mm_sign_epi16(d_0, _mm_loadu_si128((__m128i *)&sign[0][0][n])),
+                                                                    _mm_sign_epi16(d_1, _mm_loadu_si128((__m128i *)&sign[0][1][n]))),
+                                                     _mm_sign_epi16(d_2, _mm_loadu_si128((__m128i *)&sign[0][2][n]))));
+            m_1 = _mm_adds_epi16(p_1, _mm_adds_epi16(_mm_adds_epi16(_mm_sign_epi16(d_0, _mm_loadu_si128((__m128i *)&sign[1][0][n])),
+                                                                    _mm_sign_epi16(d_1, _mm_loadu_si128((__m128i *)&sign[1][1][n]))),
+                                                     _mm_sign_epi16(d_2, _mm_loadu_si128((__m128i *)&sign[1][2][n]))));
+            a            = _mm_cmpgt_epi16(m_1, m_0);
+            dec         |= (uint64)(_mm_movemask_epi8(_mm_packs_epi16(a, a)) & 0xFF) << n;
+            next[n/8]    = _mm_max_epi16(m_0, m_1);
+        }
+    }
+
+    // Keep the metrics relative to state 0
+    norm = _mm_shuffle_epi32(_mm_shufflelo_epi16(next[0], 0), 0);
+    for(n=0; n<8; n++)
+    {
+        _mm_storeu_si128((__m128i *)&metric_next[8*n], _mm_subs_epi16(next[n], norm));
+    }
+
+    return(dec);
+}
 
-    // Determine L, C, B', K+, C+, K-, and C-
-    if(N_b_bits <= Z)
-    {
-        L       = 0;
-        C       = 1;
-        B_prime = N_b_bits;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        K_minus = 0;
-        C_plus  = 1;
-        C_minus = 0;
-    }else{
-        B       = N_b_bits;
-        L       = 24;
-        C       = (uint32)ceilf((float)B/(float)(Z-L));
-        B_prime = B + C*L;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
-        {
-            if(TURBO_INT_K_TABLE[i] < K_plus)
-            {
-                K_minus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        K_delta = K_plus - K_minus;
-        C_minus = (C*K_plus - B_prime)/K_delta;
-        C_plus  = C - C_minus;
-    }
+/*********************************************************************
+    Name: viterbi_k7_acs_avx2
 
-    // Determine the number of filler bits and add them
-    *N_codeblocks  = C;
-    F              = C_plus*K_plus + C_minus*K_minus - B_prime;
-    *N_filler_bits = F;
-    for(i=0; i<(int32)F; i++)
-    {
-        c_bits[i] = TX_NULL_SYMB;
-    }
+    Description: AVX2 version of viterbi_k7_acs, each vector holds
+                 16 butterflies
 
-    // Add the input bits
-    k = F;
-    s = 0;
-    for(r=0; r<C; r++)
-    {
-        // Determine the K for this code block
-        if(r < C_minus)
-        {
-            K_r = K_minus;
-        }else{
-            K_r = K_plus;
-        }
-        N_c_bits[r] = K_r;
+    Document Reference: N/A
+*********************************************************************/
+__attribute__((target("avx2")))
+uint64 viterbi_k7_acs_avx2(int16  *metric,
+                           int16  *d,
+                           int16 (*sign)[3][LIBLTE_PHY_VITERBI_K7_N_STATES],
+                           int16  *metric_next)
+{
+    __m256i deint = _mm256_loadu_si256((__m256i *)VITERBI_SIMD_DEINTERLEAVE);
+    __m256i d_0   = _mm256_set1_epi16(d[0]);
+    __m256i d_1   = _mm256_set1_epi16(d[1]);
+    __m256i d_2   = _mm256_set1_epi16(d[2]);
+    __m256i next[4];
+    __m256i a;
+    __m256i b;
+    __m256i p_0;
+    __m256i p_1;
+    __m256i m_0;
+    __m256i m_1;
+    __m256i c[2];
+    __m256i norm;
+    uint64  dec = 0;
+    uint32  blk;
+    uint32  h;
+    uint32  n;
+
+    for(blk=0; blk<2; blk++)
+    {
+        // Predecessors 2m and 2m+1 of states m and m+32, m=16*blk..16*blk+15
+        a   = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(_mm256_loadu_si256((__m256i *)&metric[32*blk]), deint), 0xD8);
+        b   = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(_mm256_loadu_si256((__m256i *)&metric[32*blk+16]), deint), 0xD8);
+        p_0 = _mm256_permute2x128_si256(a, b, 0x20);
+        p_1 = _mm256_permute2x128_si256(a, b, 0x31);
+        for(h=0; h<2; h++)
+        {
+            n   = 16*blk + 32*h;
+            m_0 = _mm256_adds_epi16(p_0, _mm256_adds_epi16(_mm256_adds_epi16(_mm256_sign_epi16(d_0, _mm256_loadu_si256((__m256i *)&sign[0][0][n])),
+                                                                             _mm256_sign_epi16(d_1, _mm256_loadu_si256((__m256i *)&sign[0][1][n]))),
+                                                           _mm256_sign_epi16(d_2, _mm256_loadu_si256((__m256i *)&sign[0][2][n]))));
+            m_1 = _mm256_adds_epi16(p_1, _mm256_adds_epi16(_mm256_adds_epi16(_mm256_sign_epi16(d_0, _mm256_loadu_si256((__m256i *)&sign[1][0][n])),
+                                                                             _mm256_sign_epi16(d_1, _mm256_loadu_si256((__m256i *)&sign[1][1][n]))),
+                                                           _mm256_sign_epi16(d_2, _mm256_loadu_si256((__m256i *)&sign[1][2][n]))));
+            c[h]       = _mm256_cmpgt_epi16(m_1, m_0);
+            next[n/16] = _mm256_max_epi16(m_0, m_1);
+        }
+
+        // Low 16 bits are the decisions of states m, high 16 bits of
+        // states m+32
+        a    = _mm256_permute4x64_epi64(_mm256_packs_epi16(c[0], c[1]), 0xD8);
+        n    = (uint32)_mm256_movemask_epi8(a);
+        dec |= ((uint64)(n & 0xFFFF) << (16*blk)) | ((uint64)(n >> 16) << (16*blk + 32));
+    }
+
+    // Keep the metrics relative to state 0
+    norm = _mm256_broadcastw_epi16(_mm256_castsi256_si128(next[0]));
+    for(n=0; n<4; n++)
+    {
+        _mm256_storeu_si256((__m256i *)&metric_next[16*n], _mm256_subs_epi16(next[n], norm));
+    }
+
+    return(dec);
+}
+#endif
 
-        // Add the input bits
-        while(k < (K_r - L))
-        {
-            c_bits[r*N_c_bits_max+k] = b_bits[s++];
-            k++;
-        }
+/*********************************************************************
+    Name: turbo_encode
 
-        // Add CRC if more than 1 code block is needed
-        if(C > 1)
-        {
-            calc_crc(&c_bits[r*N_c_bits_max], N_c_bits[r], CRC24B, p_cb_bits, L);
-            N_c_bits[r] += L;
-            while(k < K_r)
-            {
-                c_bits[r*N_c_bits_max+k] = p_cb_bits[k+L-K_r];
-                k++;
-            }
-        }
-        k = 0;
+    Description: Turbo encodes a bit array using the LTE Parallel
+                 Concatenated Convolutional Code
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+
+    Notes: Currently not handling filler bits
+*********************************************************************/
+void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
+                  uint8             *c_bits,
+                  uint32             N_c_bits,
+                  uint32             N_fill_bits,
+                  uint8             *d_bits,
+                  uint32            *N_d_bits)
+{
+    uint32 i;
+    uint32 N_branch_bits = N_c_bits + 4;
+
+    // Construct z
+    turbo_constituent_encoder(c_bits,
+                              N_c_bits,
+                              phy_struct->te_z,
+                              phy_struct->te_fb1);
+
+    // Construct c_prime
+    turbo_internal_interleaver(c_bits,
+                               N_c_bits,
+                               phy_struct->te_c_prime);
+
+    // Construct z_prime
+    turbo_constituent_encoder(phy_struct->te_c_prime,
+                              N_c_bits,
+                              phy_struct->te_z_prime,
+                              phy_struct->te_x_prime);
+
+    // Construct d_bits
+    for(i=0; i<N_c_bits; i++)
+    {
+        d_bits[i]                 = c_bits[i];
+        d_bits[N_branch_bits+i]   = phy_struct->te_z[i];
+        d_bits[2*N_branch_bits+i] = phy_struct->te_z_prime[i];
     }
+    d_bits[N_c_bits]                   = phy_struct->te_fb1[N_c_bits];
+    d_bits[N_c_bits+1]                 = phy_struct->te_z[N_c_bits+1];
+    d_bits[N_c_bits+2]                 = phy_struct->te_x_prime[N_c_bits];
+    d_bits[N_c_bits+3]                 = phy_struct->te_z_prime[N_c_bits+1];
+    d_bits[N_branch_bits+N_c_bits]     = phy_struct->te_z[N_c_bits];
+    d_bits[N_branch_bits+N_c_bits+1]   = phy_struct->te_fb1[N_c_bits+2];
+    d_bits[N_branch_bits+N_c_bits+2]   = phy_struct->te_z_prime[N_c_bits];
+    d_bits[N_branch_bits+N_c_bits+3]   = phy_struct->te_x_prime[N_c_bits+2];
+    d_bits[2*N_branch_bits+N_c_bits]   = phy_struct->te_fb1[N_c_bits+1];
+    d_bits[2*N_branch_bits+N_c_bits+1] = phy_struct->te_z[N_c_bits+2];
+    d_bits[2*N_branch_bits+N_c_bits+2] = phy_struct->te_x_prime[N_c_bits+1];
+    d_bits[2*N_branch_bits+N_c_bits+3] = phy_struct->te_z_prime[N_c_bits+2];
+
+    *N_d_bits = N_branch_bits*3;
 }
 
 /*********************************************************************
-    Name: liblte_phy_code_block_desegmentation
+    Name: turbo_encode_packed
 
-    Description: Performs code block desegmentation for turbo coded
-                 channels
+    Description: Turbo encodes packed bits using the LTE Parallel
+                 Concatenated Convolutional Code.  The three output
+                 streams are each (N_c_bits+11)/8 bytes long and are
+                 stored one after the other.  Filler bits must be 0.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
-void liblte_phy_code_block_desegmentation(uint8  *c_bits,
-                                          uint32 *N_c_bits,
-                                          uint32  N_c_bits_max,
-                                          uint32  tbs,
-                                          uint8  *b_bits,
-                                          uint32  N_b_bits)
+void turbo_encode_packed(LIBLTE_PHY_STRUCT *phy_struct,
+                         uint8             *c_bytes,
+                         uint32             N_c_bits,
+                         uint8             *d_bytes,
+                         uint32            *N_d_bits)
 {
-    uint32  Z = 6144;
-    uint32  L;
-    uint32  B;
-    uint32  C;
-    uint32  F;
-    uint32  B_prime;
-    uint32  K_plus  = 0;
-    uint32  K_minus = 0;
-    uint32  K_delta;
-    uint32  K_r;
-    uint32  C_plus;
-    uint32  C_minus;
-    uint32  k;
-    uint32  s;
-    uint32  r;
-    uint32  ber;
-    int32   i;
-    uint8  *p_cb_bits;
-    uint8   calc_p_cb_bits[24];
+    uint16 (*table)[256] = turbo_encoder_tables();
+    uint32   K           = N_c_bits;
+    uint32   stride      = (K+4+7)/8;
+    uint32   i;
+    uint32   idx;
+    uint16   entry;
+    uint8    state_1;
+    uint8    state_2;
+    uint8    x[6];
+    uint8    z[6];
+    uint8   *c_prime = phy_struct->te_c_prime_bytes;
+    uint8   *d_0     = &d_bytes[0];
+    uint8   *d_1     = &d_bytes[stride];
+    uint8   *d_2     = &d_bytes[2*stride];
+    uint16  *pi      = phy_struct->te_pi;
+
+    // Calculate the internal interleaver, if needed
+    if(K != phy_struct->te_pi_K)
+    {
+        turbo_internal_interleaver_pre_calc(K, pi);
+        phy_struct->te_pi_K = K;
+    }
+
+    // Construct c_prime
+    memset(c_prime, 0, K/8);
+    for(i=0; i<K; i++)
+    {
+        idx         = pi[i];
+        c_prime[i/8] |= ((c_bytes[idx/8] >> (7-(idx%8))) & 1) << (7-(i%8));
+    }
+
+    // Systematic bits and both constituent encoders, a byte at a time
+    state_1 = 0;
+    state_2 = 0;
+    for(i=0; i<K/8; i++)
+    {
+        d_0[i]  = c_bytes[i];
+        entry   = table[state_1][c_bytes[i]];
+        d_1[i]  = entry & 0xFF;
+        state_1 = entry >> 8;
+        entry   = table[state_2][c_prime[i]];
+        d_2[i]  = entry & 0xFF;
+        state_2 = entry >> 8;
+    }
+
+    // Trellis termination, x[0:2]/z[0:2] for the first encoder and
+    // x[3:5]/z[3:5] for the second
+    for(i=0; i<3; i++)
+    {
+        x[i]    = ((state_1 >> 1) ^ (state_1 >> 2)) & 1;
+        z[i]    = (state_1 ^ (state_1 >> 2)) & 1;
+        state_1 = (state_1 << 1) & 7;
+        x[3+i]  = ((state_2 >> 1) ^ (state_2 >> 2)) & 1;
+        z[3+i]  = (state_2 ^ (state_2 >> 2)) & 1;
+        state_2 = (state_2 << 1) & 7;
+    }
+    d_0[K/8] = 0;
+    d_1[K/8] = 0;
+    d_2[K/8] = 0;
+    bit_write(d_0, K, (x[0] << 3) | (z[1] << 2) | (x[3] << 1) | z[4], 4);
+    bit_write(d_1, K, (z[0] << 3) | (x[2] << 2) | (z[3] << 1) | x[5], 4);
+    bit_write(d_2, K, (x[1] << 3) | (z[2] << 2) | (x[4] << 1) | z[5], 4);
+
+    *N_d_bits = (K+4)*3;
+}
+
+/*********************************************************************
+    Name: turbo_encoder_tables
 
-    // Determine L, C, B', K+, C+, K-, and C-
-    if(tbs+24 <= Z)
+    Description: Returns the byte at a time turbo constituent encoder
+                 tables, calculating them on first use.  Each entry
+                 holds the 8 parity bits in the low byte and the next
+                 state in the high byte.
+
+    Document Reference: N/A
+*********************************************************************/
+uint16 (*turbo_encoder_tables(void))[256]
+{
+    // Function scope statics are initialized exactly once, even with
+    // multiple threads
+    static uint16 table[LIBLTE_PHY_TURBO_N_STATES][256];
+    static bool   table_ready = turbo_encoder_tables_pre_calc(table);
+
+    (void)table_ready;
+
+    return(table);
+}
+
+/*********************************************************************
+    Name: turbo_encoder_tables_pre_calc
+
+    Description: Calculates the byte at a time turbo constituent
+                 encoder tables
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
+*********************************************************************/
+bool turbo_encoder_tables_pre_calc(uint16 (*table)[256])
+{
+    uint32 s;
+    uint32 b;
+    uint32 i;
+    uint8  state;
+    uint8  par;
+    uint8  in;
+
+    for(s=0; s<LIBLTE_PHY_TURBO_N_STATES; s++)
     {
-        L       = 0;
-        C       = 1;
-        B_prime = tbs+24;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        K_minus = 0;
-        C_plus  = 1;
-        C_minus = 0;
-    }else{
-        B       = tbs+24;
-        L       = 24;
-        C       = (uint32)ceilf((float)B/(float)(Z-L));
-        B_prime = B + C*L;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
+        for(b=0; b<256; b++)
         {
-            if(TURBO_INT_K_TABLE[i] < K_plus)
+            state = s;
+            par   = 0;
+            for(i=0; i<8; i++)
             {
-                K_minus = TURBO_INT_K_TABLE[i];
-                break;
+                in    = (b >> (7-i)) & 1;
+                par   = (par << 1) | TURBO_TRELLIS_PAR_BIT[state][in ^ TURBO_TRELLIS_SYS_BIT[state][0]];
+                state = TURBO_TRELLIS_NEXT_STATE[state][in ^ TURBO_TRELLIS_SYS_BIT[state][0]];
             }
+            table[s][b] = (state << 8) | par;
         }
-        K_delta = K_plus - K_minus;
-        C_minus = (C*K_plus - B_prime)/K_delta;
-        C_plus  = C - C_minus;
     }
 
-    // Determine the number of filler bits
-    F = C_plus*K_plus + C_minus*K_minus - B_prime;
+    return(true);
+}
 
-    // Determine the output bits
-    k = F;
-    s = 0;
-    for(r=0; r<C; r++)
-    {
-        // Determine the K for this code block
-        if(r < C_minus)
-        {
-            K_r = K_minus;
-        }else{
-            K_r = K_plus;
-        }
+/*********************************************************************
+    Name: turbo_decode
 
-        // Check CRC if more than 1 code block is present
-        if(C > 1)
-        {
-            calc_crc(&c_bits[r*N_c_bits_max], N_c_bits[r]-L, CRC24B, calc_p_cb_bits, L);
-            p_cb_bits = &c_bits[r*N_c_bits_max+N_c_bits[r]-L];
-            ber       = 0;
-            for(i=0; i<(int32)L; i++)
-            {
-                ber += p_cb_bits[i] ^ calc_p_cb_bits[i];
-            }
-            if(ber == 0)
-            {
-                printf("CB CRC CORRECT\n");
-            }else{
-                printf("CB CRC INCORRECT\n");
-            }
-        }
+    Description: Turbo decodes data according to the LTE Parallel
+                 Concatenated Convolutional Code using the decoder
+                 selected in phy_struct.  If crc is non-zero the last
+                 24 decoded bits are checked as a CRC of that type.
 
-        // Create the output bits
-        while(k < (K_r - L))
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+*********************************************************************/
+LIBLTE_ERROR_ENUM turbo_decode(LIBLTE_PHY_STRUCT                  *phy_struct,
+                               LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT *ctx,
+                               float                              *d_bits,
+                               uint32                              N_d_bits,
+                               uint32                              N_fill_bits,
+                               uint32                              crc,
+                               uint8                              *c_bits,
+                               uint32                             *N_c_bits,
+                               uint32                             *N_iterations)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_SUCCESS;
+
+    if(LIBLTE_PHY_TURBO_DECODER_MAX_LOG_MAP == phy_struct->td_type)
+    {
+        err = turbo_decode_max_log_map(phy_struct,
+                                       ctx,
+                                       d_bits,
+                                       N_d_bits,
+                                       N_fill_bits,
+                                       crc,
+                                       c_bits,
+                                       N_c_bits,
+                                       N_iterations);
+    }else{
+        turbo_decode_viterbi_siso(phy_struct,
+                                  d_bits,
+                                  N_d_bits,
+                                  N_fill_bits,
+                                  c_bits,
+                                  N_c_bits);
+        *N_iterations = 1;
+        if(0 != crc &&
+           !check_crc(c_bits, N_d_bits/3 - 4, crc, 24))
         {
-            b_bits[s++] = c_bits[r*N_c_bits_max+k];
-            k++;
+            err = LIBLTE_ERROR_INVALID_CRC;
         }
-        k = 0;
     }
+
+    return(err);
 }
 
 /*********************************************************************
-    Name: conv_encode
+    Name: turbo_decode_max_log_map
 
-    Description: Convolutionally encodes a bit array using the
-                 provided parameters
+    Description: Turbo decodes data according to the LTE Parallel
+                 Concatenated Convolutional Code using two fixed point
+                 Max-Log-MAP constituent decoders exchanging extrinsic
+                 information through the internal interleaver.
+                 Iterations stop as soon as the decoded bits pass the
+                 CRC check.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
 *********************************************************************/
-void conv_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                 uint8             *c_bits,
-                 uint32             N_c_bits,
-                 uint32             constraint_len,
-                 uint32             rate,
-                 uint32            *g,
-                 bool               tail_bit,
-                 uint8             *d_bits,
-                 uint32            *N_d_bits)
+LIBLTE_ERROR_ENUM turbo_decode_max_log_map(LIBLTE_PHY_STRUCT                  *phy_struct,
+                                           LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT *ctx,
+                                           float                              *d_bits,
+                                           uint32                              N_d_bits,
+                                           uint32                              N_fill_bits,
+                                           uint32                              crc,
+                                           uint8                              *c_bits,
+                                           uint32                             *N_c_bits,
+                                           uint32                             *N_iterations)
 {
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint8  s_reg[constraint_len];
-    uint8  g_array[3][constraint_len];
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
+    float              max_value = 0;
+    float              scale;
+    int32              tmp;
+    uint32             i;
+    uint32             iter;
+    uint32             K   = N_d_bits/3 - 4;
+    int16             *sys = ctx->sys;
+    int16             *apr = ctx->apriori;
+    int16             *ext = ctx->extrinsic;
+    int16             *llr = ctx->llr;
+    uint16            *pi  = ctx->pi;
 
-    // Initialize the shift register
-    if(tail_bit)
+    // Calculate the internal interleaver, if needed
+    if(K != ctx->pi_K)
     {
-        for(i=0; i<constraint_len; i++)
+        turbo_internal_interleaver_pre_calc(K, pi);
+        ctx->pi_K = K;
+    }
+
+    // Quantize the soft bits, punctured bits carry no information
+    for(i=0; i<N_d_bits; i++)
+    {
+        if(RX_NULL_BIT != d_bits[i] &&
+           fabs(d_bits[i]) > max_value)
         {
-            s_reg[i] = c_bits[N_c_bits-i-1];
+            max_value = fabs(d_bits[i]);
         }
-    }else{
-        for(i=0; i<constraint_len; i++)
+    }
+    scale = 0;
+    if(max_value > 0)
+    {
+        scale = TURBO_LLR_CHANNEL_MAX/max_value;
+    }
+    for(i=0; i<N_d_bits; i++)
+    {
+        if(RX_NULL_BIT == d_bits[i])
         {
-            s_reg[i] = 0;
+            llr[i] = 0;
+        }else{
+            llr[i] = (int16)(d_bits[i]*scale);
         }
     }
 
-    // Convert g from octal to binary array
-    for(i=0; i<rate; i++)
+    // Split the streams, filler bits are known to be 0
+    for(i=0; i<K; i++)
     {
-        for(j=0; j<constraint_len; j++)
-        {
-            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
-        }
+        sys[i]        = llr[i*3+0];
+        ctx->par_1[i] = llr[i*3+1];
+        ctx->par_2[i] = llr[i*3+2];
+    }
+    for(i=0; i<N_fill_bits && i<K; i++)
+    {
+        sys[i] = TURBO_LLR_CHANNEL_MAX;
+    }
+    for(i=0; i<K; i++)
+    {
+        ctx->sys_int[i] = sys[pi[i]];
     }
 
-    // Convolutionally encode input
-    for(i=0; i<N_c_bits; i++)
+    // Trellis termination bits
+    sys[K]            = llr[K*3+0];
+    ctx->par_1[K]     = llr[K*3+1];
+    sys[K+1]          = llr[K*3+2];
+    ctx->par_1[K+1]   = llr[(K+1)*3+0];
+    sys[K+2]          = llr[(K+1)*3+1];
+    ctx->par_1[K+2]   = llr[(K+1)*3+2];
+    ctx->sys_int[K]   = llr[(K+2)*3+0];
+    ctx->par_2[K]     = llr[(K+2)*3+1];
+    ctx->sys_int[K+1] = llr[(K+2)*3+2];
+    ctx->par_2[K+1]   = llr[(K+3)*3+0];
+    ctx->sys_int[K+2] = llr[(K+3)*3+1];
+    ctx->par_2[K+2]   = llr[(K+3)*3+2];
+
+    memset(apr, 0, sizeof(int16)*K);
+    for(iter=0; iter<phy_struct->td_max_iterations; iter++)
     {
-        // Add next bit to shift register
-        for(j=constraint_len-1; j>0; j--)
+        // First constituent decoder
+        turbo_max_log_map_siso(phy_struct,
+                               ctx,
+                               sys,
+                               ctx->par_1,
+                               apr,
+                               K,
+                               ext);
+        for(i=0; i<K; i++)
         {
-            s_reg[j] = s_reg[j-1];
+            apr[i] = (ext[pi[i]]*3) >> 2;
         }
-        s_reg[0] = c_bits[i];
 
-        // Determine the output bits
-        for(j=0; j<rate; j++)
-        {
-            d_bits[i*rate + j] = 0;
+        // Second constituent decoder
+        turbo_max_log_map_siso(phy_struct,
+                               ctx,
+                               ctx->sys_int,
+                               ctx->par_2,
+                               apr,
+                               K,
+                               ext);
 
-            for(k=0; k<constraint_len; k++)
+        // Hard decision on the a posteriori values
+        for(i=0; i<K; i++)
+        {
+            tmp = ctx->sys_int[i] + apr[i] + ext[i];
+            if(tmp >= 0)
             {
-                d_bits[i*rate + j] += s_reg[k]*g_array[j][k];
+                c_bits[pi[i]] = 0;
+            }else{
+                c_bits[pi[i]] = 1;
             }
-            d_bits[i*rate + j] %= 2;
+        }
+        for(i=0; i<K; i++)
+        {
+            apr[pi[i]] = (ext[i]*3) >> 2;
+        }
+
+        // Stop early if the CRC passes
+        if(0 != crc &&
+           check_crc(c_bits, K, crc, 24))
+        {
+            err = LIBLTE_SUCCESS;
+            iter++;
+            break;
         }
     }
+    if(0 == crc)
+    {
+        err = LIBLTE_SUCCESS;
+    }
 
-    *N_d_bits = N_c_bits*rate;
+    *N_c_bits     = K;
+    *N_iterations = iter;
+
+    return(err);
 }
 
 /*********************************************************************
-    Name: conv_encode_soft
+    Name: turbo_max_log_map_siso
 
-    Description: Convolutionally encodes a soft bit array using the
-                 provided parameters
+    Description: Soft input soft output Max-Log-MAP decoder for one
+                 of the LTE turbo constituent codes.  The backward
+                 recursion is run over windows of
+                 LIBLTE_PHY_TURBO_WINDOW_SIZE trellis steps, each
+                 preceded by an acquisition run over the next window.
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.1
 *********************************************************************/
-void conv_encode_soft(LIBLTE_PHY_STRUCT *phy_struct,
-                      int8              *c_bits,
-                      uint32             N_c_bits,
-                      uint32             constraint_len,
-                      uint32             rate,
-                      uint32            *g,
-                      bool               tail_bit,
-                      int8              *d_bits,
-                      uint32            *N_d_bits)
+void turbo_max_log_map_siso(LIBLTE_PHY_STRUCT                  *phy_struct,
+                            LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT *ctx,
+                            int16                              *sys,
+                            int16                              *par,
+                            int16                              *apriori,
+                            uint32                              K,
+                            int16                              *extrinsic)
 {
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 tmp_sum;
-    uint32 tmp_sign;
-    int32  tmp_mag;
-    int8   s_reg[constraint_len];
-    uint8  g_array[3][constraint_len];
+    TURBO_TRELLIS_STEP_FUNC       forward_step;
+    TURBO_TRELLIS_STEP_FUNC       backward_step;
+    TURBO_TRELLIS_EXTRINSIC_FUNC  extrinsic_step;
+    TURBO_TRELLIS_DUAL_STEP_FUNC  dual_step = NULL;
+    int32                         L_sys;
+    int32                         L_sys_b;
+    uint32                        i;
+    uint32                        s;
+    uint32                        t;
+    uint32                        t_b;
+    uint32                        n;
+    uint32                        w_start;
+    uint32                        w_end;
+    uint32                        acq_end;
+    uint32                        N_steps = K + LIBLTE_PHY_TURBO_N_TAIL_BITS;
+    int16                         beta[2][LIBLTE_PHY_TURBO_N_STATES];
+    uint32                        b_idx;
+    int16                       (*alpha)[LIBLTE_PHY_TURBO_N_STATES] = ctx->alpha;
+
+    // Select the trellis kernels
+    switch(phy_struct->td_kernel)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+    case LIBLTE_PHY_TURBO_KERNEL_AVX2:
+        forward_step   = turbo_trellis_forward_step_avx2;
+        backward_step  = turbo_trellis_backward_step_avx2;
+        extrinsic_step = turbo_trellis_extrinsic_avx2;
+        dual_step      = turbo_trellis_dual_step_avx2;
+        break;
+    case LIBLTE_PHY_TURBO_KERNEL_SSE4_1:
+        forward_step   = turbo_trellis_forward_step_sse4_1;
+        backward_step  = turbo_trellis_backward_step_sse4_1;
+        extrinsic_step = turbo_trellis_extrinsic_sse4_1;
+        break;
+#endif
+    default:
+        forward_step   = turbo_trellis_forward_step;
+        backward_step  = turbo_trellis_backward_step;
+        extrinsic_step = turbo_trellis_extrinsic;
+        break;
+    }
 
-    // Initialize the shift register
-    if(tail_bit)
+    // Trellis starts in state 0
+    for(s=0; s<LIBLTE_PHY_TURBO_N_STATES; s++)
     {
-        for(i=0; i<constraint_len; i++)
-        {
-            s_reg[i] = c_bits[N_c_bits-i-1];
-        }
-    }else{
-        for(i=0; i<constraint_len; i++)
-        {
-            s_reg[i] = 127;
-        }
+        alpha[0][s] = TURBO_METRIC_NEG_INF;
     }
+    alpha[0][0] = 0;
 
-    // Convert g from octal to binary array
-    for(i=0; i<rate; i++)
+    for(w_start=0; w_start<N_steps; w_start+=LIBLTE_PHY_TURBO_WINDOW_SIZE)
     {
-        for(j=0; j<constraint_len; j++)
+        w_end = w_start + LIBLTE_PHY_TURBO_WINDOW_SIZE;
+        if(w_end > N_steps)
         {
-            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
+            w_end = N_steps;
         }
-    }
 
-    // Convolutionally encode input
-    for(i=0; i<N_c_bits; i++)
-    {
-        // Add next bit to shift register
-        for(j=constraint_len-1; j>0; j--)
+        // Initialize the backward recursion, from the terminated
+        // trellis state when reachable, otherwise from equiprobable
+        // states followed by an acquisition run
+        b_idx   = 0;
+        acq_end = w_end + LIBLTE_PHY_TURBO_WINDOW_SIZE;
+        if(acq_end >= N_steps)
         {
-            s_reg[j] = s_reg[j-1];
+            acq_end = N_steps;
+            for(s=0; s<LIBLTE_PHY_TURBO_N_STATES; s++)
+            {
+                beta[b_idx][s] = TURBO_METRIC_NEG_INF;
+            }
+            beta[b_idx][0] = 0;
+        }else{
+            memset(beta[b_idx], 0, sizeof(int16)*LIBLTE_PHY_TURBO_N_STATES);
         }
-        s_reg[0] = c_bits[i];
 
-        // Determine the output bits
-        for(j=0; j<rate; j++)
+        // Forward recursion across the window and backward acquisition
+        // across the next window, these are independent so they are
+        // run together when the kernel supports it
+        for(n=0; n<(w_end-w_start) || n<(acq_end-w_end); n++)
         {
-            tmp_sum  = 0;
-            tmp_mag  = 0;
-            tmp_sign = 0;
-            for(k=0; k<constraint_len; k++)
+            t     = w_start + n;
+            t_b   = acq_end - 1 - n;
+            L_sys = 0;
+            if(t < K)
             {
-                if(1 == g_array[j][k])
+                L_sys = sys[t] + apriori[t];
+            }else if(t < w_end){
+                L_sys = sys[t];
+            }
+            L_sys_b = 0;
+            if(t_b < K)
+            {
+                L_sys_b = sys[t_b] + apriori[t_b];
+            }else if(t_b >= w_end){
+                L_sys_b = sys[t_b];
+            }
+
+            if(NULL != dual_step &&
+               t    < K         &&
+               t    < w_end     &&
+               t_b  < K         &&
+               t_b  >= w_end)
+            {
+                dual_step(alpha[n], L_sys, par[t], alpha[n+1],
+                          beta[b_idx], L_sys_b, par[t_b], beta[b_idx^1]);
+                b_idx ^= 1;
+            }else{
+                if(t < w_end)
                 {
-                    if(s_reg[k] >= 0)
-                    {
-                        tmp_mag += s_reg[k];
-                    }else{
-                        tmp_mag  += -s_reg[k];
-                        tmp_sign += 1;
-                    }
-                    tmp_sum++;
+                    forward_step(alpha[n], L_sys, par[t], t >= K, alpha[n+1]);
+                }
+                if(n < (acq_end-w_end))
+                {
+                    backward_step(beta[b_idx], L_sys_b, par[t_b], t_b >= K, beta[b_idx^1]);
+                    b_idx ^= 1;
                 }
             }
-            d_bits[i*rate + j] = tmp_mag >> (tmp_sum-1);
-            if(1 == (tmp_sign % 2))
+        }
+
+        // Backward recursion across the window and extrinsic output
+        for(t=w_end; t>w_start; t--)
+        {
+            i     = t-1;
+            L_sys = sys[i];
+            if(i < K)
             {
-                d_bits[i*rate + j] = -d_bits[i*rate + j];
+                extrinsic[i]  = extrinsic_step(alpha[i-w_start], beta[b_idx], par[i]);
+                L_sys        += apriori[i];
             }
+            backward_step(beta[b_idx], L_sys, par[i], i >= K, beta[b_idx^1]);
+            b_idx ^= 1;
         }
-    }
 
-    *N_d_bits = N_c_bits*rate;
+        // Carry the forward state metrics into the next window
+        memcpy(alpha[0], alpha[w_end-w_start], sizeof(int16)*LIBLTE_PHY_TURBO_N_STATES);
+    }
 }
 
 /*********************************************************************
-    Name: viterbi_decode
+    Name: turbo_trellis_forward_step
 
-    Description: Viterbi decodes a convolutionally coded input bit
-                 array using the provided parameters
+    Description: Performs one step of the Max-Log-MAP forward state
+                 metric recursion
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: N/A
 *********************************************************************/
-void viterbi_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                    float             *d_bits,
-                    uint32             N_d_bits,
-                    uint32             constraint_len,
-                    uint32             rate,
-                    uint32            *g,
-                    uint8             *c_bits,
-                    uint32            *N_c_bits)
+void turbo_trellis_forward_step(int16 *alpha,
+                                int32  L_sys,
+                                int32  L_par,
+                                bool   tail,
+                                int16 *alpha_next)
 {
-    float  init_min;
-    float  tmp1;
-    float  tmp2;
-    int32  i;
-    uint32 j;
-    uint32 k;
-    uint32 o;
-    uint32 N_states = 1<<(constraint_len-1);
-    uint32 idx;
-    uint32 tb_state_len;
-    uint8  in_path;
-    uint8  prev_state;
-    uint8  in_bit;
-    uint8  prev_state_0;
-    uint8  prev_state_1;
-    uint8  s_reg[constraint_len];
-    uint8  g_array[3][constraint_len];
+    int32  metric[LIBLTE_PHY_TURBO_N_STATES];
+    int32  gamma;
+    int32  norm;
+    uint32 s;
+    uint32 a;
+    uint32 N_branches = tail ? 1 : 2;
+    uint8  next;
 
-    // Convert g to binary
-    for(i=0; i<(int32)rate; i++)
+    for(s=0; s<LIBLTE_PHY_TURBO_N_STATES; s++)
     {
-        for(j=0; j<constraint_len; j++)
+        metric[s] = 2*TURBO_METRIC_NEG_INF;
+    }
+    for(s=0; s<LIBLTE_PHY_TURBO_N_STATES; s++)
+    {
+        for(a=0; a<N_branches; a++)
         {
-            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
+            gamma = TURBO_TRELLIS_SYS_BIT[s][a] ? -L_sys : L_sys;
+            gamma += TURBO_TRELLIS_PAR_BIT[s][a] ? -L_par : L_par;
+            next   = TURBO_TRELLIS_NEXT_STATE[s][a];
+            if(alpha[s] + gamma > metric[next])
+            {
+                metric[next] = alpha[s] + gamma;
+            }
         }
     }
 
-    // Precalculate state transition outputs
-    for(i=0; i<(int32)N_states; i++)
+    // Normalize to state 0 and saturate
+    norm = metric[0];
+    for(s=0; s<LIBLTE_PHY_TURBO_N_STATES; s++)
     {
-        // Determine the input path
-        if(i < (N_states/2))
+        metric[s] -= norm;
+        if(metric[s] < TURBO_METRIC_NEG_INF)
         {
-            in_path = 0;
-        }else{
-            in_path = 1;
+            metric[s] = TURBO_METRIC_NEG_INF;
+        }else if(metric[s] > -TURBO_METRIC_NEG_INF){
+            metric[s] = -TURBO_METRIC_NEG_INF;
         }
+        alpha_next[s] = (int16)metric[s];
+    }
+}
 
-        // Determine the outputs based on the previous state and input path
-        for(j=0; j<2; j++)
+/*********************************************************************
+    Name: turbo_trellis_backward_step
+
+    Description: Performs one step of the Max-Log-MAP backward state
+                 metric recursion
+
+    Document Reference: N/A
+*********************************************************************/
+void turbo_trellis_backward_step(int16 *beta,
+                                 int32  L_sys,
+                                 int32  L_par,
+                                 bool   tail,
+                                 int16 *beta_prev)
+{
+    int32  metric[LIBLTE_PHY_TURBO_N_STATES];
+    int32  gamma;
+    int32  tmp;
+    int32  norm;
+    uint32 s;
+    uint32 a;
+    uint32 N_branches = tail ? 1 : 2;
+
+    for(s=0; s<LIBLTE_PHY_TURBO_N_STATES; s++)
+    {
+        metric[s] = 2*TURBO_METRIC_NEG_INF;
+        for(a=0; a<N_branches; a++)
         {
-            prev_state = ((i << 1) + j) % N_states;
-            for(k=0; k<constraint_len; k++)
-            {
-                s_reg[k] = (prev_state >> (constraint_len-k-1)) & 1;
-            }
-            s_reg[0] = in_path;
-            for(k=0; k<rate; k++)
+            gamma  = TURBO_TRELLIS_SYS_BIT[s][a] ? -L_sys : L_sys;
+            gamma += TURBO_TRELLIS_PAR_BIT[s][a] ? -L_par : L_par;
+            tmp    = beta[TURBO_TRELLIS_NEXT_STATE[s][a]] + gamma;
+            if(tmp > metric[s])
             {
-                phy_struct->vd_st_output[i][j][k] = 0;
-                for(o=0; o<constraint_len; o++)
-                {
-                    phy_struct->vd_st_output[i][j][k] += s_reg[o]*g_array[k][o];
-                }
-                phy_struct->vd_st_output[i][j][k] %= 2;
+                metric[s] = tmp;
             }
         }
     }
 
-    // Calculate branch and path metrics
-    for(i=0; i<(int32)N_states; i++)
+    // Normalize to state 0 and saturate
+    norm = metric[0];
+    for(s=0; s<LIBLTE_PHY_TURBO_N_STATES; s++)
     {
-        for(j=0; j<(N_d_bits/rate)+10; j++)
+        metric[s] -= norm;
+        if(metric[s] < TURBO_METRIC_NEG_INF)
         {
-            phy_struct->vd_path_metric[i][j] = 0;
+            metric[s] = TURBO_METRIC_NEG_INF;
+        }else if(metric[s] > -TURBO_METRIC_NEG_INF){
+            metric[s] = -TURBO_METRIC_NEG_INF;
         }
+        beta_prev[s] = (int16)metric[s];
     }
-    for(i=0; i<(int32)(N_d_bits/rate); i++)
+}
+
+/*********************************************************************
+    Name: turbo_trellis_extrinsic
+
+    Description: Calculates the Max-Log-MAP extrinsic information for
+                 one trellis step
+
+    Document Reference: N/A
+*********************************************************************/
+int16 turbo_trellis_extrinsic(int16 *alpha,
+                              int16 *beta,
+                              int32  L_par)
+{
+    int32  max_0 = 2*TURBO_METRIC_NEG_INF;
+    int32  max_1 = 2*TURBO_METRIC_NEG_INF;
+    int32  metric;
+    uint32 s;
+    uint32 a;
+
+    for(s=0; s<LIBLTE_PHY_TURBO_N_STATES; s++)
     {
-        for(j=0; j<N_states; j++)
+        for(a=0; a<2; a++)
         {
-            phy_struct->vd_br_metric[j][0] = 0;
-            phy_struct->vd_br_metric[j][1] = 0;
-            phy_struct->vd_p_metric[j][0]  = 0;
-            phy_struct->vd_p_metric[j][1]  = 0;
-            phy_struct->vd_w_metric[j][0]  = 0;
-            phy_struct->vd_w_metric[j][1]  = 0;
-
-            // Calculate the accumulated branch metrics for each state
-            for(k=0; k<2; k++)
+            metric  = alpha[s] + beta[TURBO_TRELLIS_NEXT_STATE[s][a]];
+            metric += TURBO_TRELLIS_PAR_BIT[s][a] ? -L_par : L_par;
+            if(TURBO_TRELLIS_SYS_BIT[s][a])
             {
-                prev_state                    = ((j<<1)+k) % N_states;
-                phy_struct->vd_p_metric[j][k] = phy_struct->vd_path_metric[prev_state][i];
-                for(o=0; o<rate; o++)
+                if(metric > max_1)
                 {
-                    if(d_bits[i*rate + o] >= 0)
-                    {
-                        in_bit = 0;
-                    }else{
-                        in_bit = 1;
-                    }
-                    phy_struct->vd_br_metric[j][k] += (phy_struct->vd_st_output[j][k][o]+in_bit)%2;
-                    phy_struct->vd_w_metric[j][k]  += fabs(d_bits[i*rate + o]);
+                    max_1 = metric;
                 }
-            }
-
-            // Keep the smallest branch metric as the path metric, weight the branch metric
-            tmp1 = phy_struct->vd_br_metric[j][0] + phy_struct->vd_p_metric[j][0];
-            tmp2 = phy_struct->vd_br_metric[j][1] + phy_struct->vd_p_metric[j][1];
-            if(tmp1 > tmp2)
-            {
-                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][1] + phy_struct->vd_w_metric[j][1]*phy_struct->vd_br_metric[j][1];
             }else{
-                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][0] + phy_struct->vd_w_metric[j][0]*phy_struct->vd_br_metric[j][0];
+                if(metric > max_0)
+                {
+                    max_0 = metric;
+                }
             }
         }
     }
 
-    // Find the minimum metric for the last iteration
-    init_min                     = 1000000;
-    idx                          = 0;
-    phy_struct->vd_tb_state[idx] = 1000000;
-    for(i=0; i<(int32)N_states; i++)
+    return(turbo_extrinsic_clamp(max_0, max_1));
+}
+
+/*********************************************************************
+    Name: turbo_extrinsic_clamp
+
+    Description: Converts the best path metrics for systematic bits
+                 of 0 and 1 into a clamped extrinsic value
+
+    Document Reference: N/A
+*********************************************************************/
+int16 turbo_extrinsic_clamp(int32 max_0,
+                            int32 max_1)
+{
+    int32 ext = (max_0 - max_1)/2;
+
+    if(ext > TURBO_LLR_EXTRINSIC_MAX)
     {
-        if(phy_struct->vd_path_metric[i][(N_d_bits/rate)] < init_min)
-        {
-            init_min                       = phy_struct->vd_path_metric[i][(N_d_bits/rate)];
-            phy_struct->vd_tb_state[idx++] = i;
-        }
+        ext = TURBO_LLR_EXTRINSIC_MAX;
+    }else if(ext < -TURBO_LLR_EXTRINSIC_MAX){
+        ext = -TURBO_LLR_EXTRINSIC_MAX;
     }
 
-    // Traceback to find the minimum path metrics at each iteration
-    for(i=(N_d_bits/rate)-1; i>=0; i--)
-    {
-        prev_state_0 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 0) % N_states;
-        prev_state_1 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 1) % N_states;
+    return((int16)ext);
+}
 
-        // Keep the smallest state
-        if(phy_struct->vd_path_metric[prev_state_0][i] > phy_struct->vd_path_metric[prev_state_1][i])
-        {
-            phy_struct->vd_tb_state[idx++] = prev_state_1;
-        }else{
-            phy_struct->vd_tb_state[idx++] = prev_state_0;
-        }
+#if defined(__x86_64__) || defined(__i386__)
+/*********************************************************************
+    Name: turbo_trellis_forward_step_sse4_1
+
+    Description: SSE4.1 version of turbo_trellis_forward_step, all 8
+                 trellis states are held in one vector
+
+    Document Reference: N/A
+*********************************************************************/
+__attribute__((target("sse4.1")))
+void turbo_trellis_forward_step_sse4_1(int16 *alpha,
+                                       int32  L_sys,
+                                       int32  L_par,
+                                       bool   tail,
+                                       int16 *alpha_next)
+{
+    __m128i a_vec  = _mm_loadu_si128((__m128i *)alpha);
+    __m128i ls_vec = _mm_set1_epi16((int16)L_sys);
+    __m128i lp_vec = _mm_set1_epi16((int16)L_par);
+    __m128i g_0;
+    __m128i g_1;
+    __m128i m_0;
+    __m128i m_1;
+
+    g_0 = _mm_adds_epi16(_mm_sign_epi16(ls_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_FWD_SYS_SIGN[0])),
+                         _mm_sign_epi16(lp_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_FWD_PAR_SIGN[0])));
+    g_1 = _mm_adds_epi16(_mm_sign_epi16(ls_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_FWD_SYS_SIGN[1])),
+                         _mm_sign_epi16(lp_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_FWD_PAR_SIGN[1])));
+    m_0 = _mm_adds_epi16(_mm_shuffle_epi8(a_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_FWD_SHUFFLE[0])), g_0);
+    m_1 = _mm_adds_epi16(_mm_shuffle_epi8(a_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_FWD_SHUFFLE[1])), g_1);
+    m_0 = _mm_max_epi16(m_0, m_1);
+    if(tail)
+    {
+        // Odd states are only reachable with an input of 1
+        m_0 = _mm_blend_epi16(m_0, _mm_set1_epi16(2*TURBO_METRIC_NEG_INF), 0xAA);
+    }
+
+    _mm_storeu_si128((__m128i *)alpha_next, turbo_metric_normalize_sse4_1(m_0));
+}
+
+/*********************************************************************
+    Name: turbo_trellis_backward_step_sse4_1
+
+    Description: SSE4.1 version of turbo_trellis_backward_step, all 8
+                 trellis states are held in one vector
+
+    Document Reference: N/A
+*********************************************************************/
+__attribute__((target("sse4.1")))
+void turbo_trellis_backward_step_sse4_1(int16 *beta,
+                                        int32  L_sys,
+                                        int32  L_par,
+                                        bool   tail,
+                                        int16 *beta_prev)
+{
+    __m128i b_vec  = _mm_loadu_si128((__m128i *)beta);
+    __m128i ls_vec = _mm_set1_epi16((int16)L_sys);
+    __m128i lp_vec = _mm_set1_epi16((int16)L_par);
+    __m128i g_0;
+    __m128i g_1;
+    __m128i m_0;
+    __m128i m_1;
+
+    g_0 = _mm_adds_epi16(_mm_sign_epi16(ls_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_BWD_SYS_SIGN[0])),
+                         _mm_sign_epi16(lp_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_BWD_PAR_SIGN[0])));
+    m_0 = _mm_adds_epi16(_mm_shuffle_epi8(b_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_BWD_SHUFFLE[0])), g_0);
+    if(!tail)
+    {
+        g_1 = _mm_adds_epi16(_mm_sign_epi16(ls_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_BWD_SYS_SIGN[1])),
+                             _mm_sign_epi16(lp_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_BWD_PAR_SIGN[1])));
+        m_1 = _mm_adds_epi16(_mm_shuffle_epi8(b_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_BWD_SHUFFLE[1])), g_1);
+        m_0 = _mm_max_epi16(m_0, m_1);
+    }
+
+    _mm_storeu_si128((__m128i *)beta_prev, turbo_metric_normalize_sse4_1(m_0));
+}
+
+/*********************************************************************
+    Name: turbo_trellis_extrinsic_sse4_1
+
+    Description: SSE4.1 version of turbo_trellis_extrinsic
+
+    Document Reference: N/A
+*********************************************************************/
+__attribute__((target("sse4.1")))
+int16 turbo_trellis_extrinsic_sse4_1(int16 *alpha,
+                                     int16 *beta,
+                                     int32  L_par)
+{
+    __m128i a_vec  = _mm_loadu_si128((__m128i *)alpha);
+    __m128i b_vec  = _mm_loadu_si128((__m128i *)beta);
+    __m128i lp_vec = _mm_set1_epi16((int16)L_par);
+    __m128i m_0;
+    __m128i m_1;
+    __m128i u_0;
+    __m128i u_1;
+
+    m_0 = _mm_adds_epi16(_mm_adds_epi16(a_vec, _mm_shuffle_epi8(b_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_BWD_SHUFFLE[0]))),
+                         _mm_sign_epi16(lp_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_BWD_PAR_SIGN[0])));
+    m_1 = _mm_adds_epi16(_mm_adds_epi16(a_vec, _mm_shuffle_epi8(b_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_BWD_SHUFFLE[1]))),
+                         _mm_sign_epi16(lp_vec, _mm_loadu_si128((__m128i *)TURBO_SIMD_BWD_PAR_SIGN[1])));
+
+    // States 2 through 5 output a systematic 1 for an input of 0
+    u_0 = _mm_blend_epi16(m_0, m_1, 0x3C);
+    u_1 = _mm_blend_epi16(m_1, m_0, 0x3C);
+
+    return(turbo_extrinsic_clamp(turbo_hmax_sse4_1(u_0), turbo_hmax_sse4_1(u_1)));
+}
+
+/*********************************************************************
+    Name: turbo_trellis_forward_step_avx2
+
+    Description: AVX2 version of turbo_trellis_forward_step, both
+                 branches into each of the 8 trellis states are held
+                 in one vector
+
+    Document Reference: N/A
+*********************************************************************/
+__attribute__((target("avx2")))
+void turbo_trellis_forward_step_avx2(int16 *alpha,
+                                     int32  L_sys,
+                                     int32  L_par,
+                                     bool   tail,
+                                     int16 *alpha_next)
+{
+    __m256i a_vec = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)alpha));
+    __m256i g;
+    __m256i m;
+    __m128i m_0;
+
+    g   = _mm256_adds_epi16(_mm256_sign_epi16(_mm256_set1_epi16((int16)L_sys), _mm256_loadu_si256((__m256i *)TURBO_SIMD_FWD_SYS_SIGN)),
+                            _mm256_sign_epi16(_mm256_set1_epi16((int16)L_par), _mm256_loadu_si256((__m256i *)TURBO_SIMD_FWD_PAR_SIGN)));
+    m   = _mm256_adds_epi16(_mm256_shuffle_epi8(a_vec, _mm256_loadu_si256((__m256i *)TURBO_SIMD_FWD_SHUFFLE)), g);
+    m_0 = _mm_max_epi16(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1));
+    if(tail)
+    {
+        // Odd states are only reachable with an input of 1
+        m_0 = _mm_blend_epi16(m_0, _mm_set1_epi16(2*TURBO_METRIC_NEG_INF), 0xAA);
     }
-    tb_state_len = idx;
 
-    // Read through the traceback to determine the input bits
-    idx = 0;
-    for(i=tb_state_len-2; i>=0; i--)
+    _mm_storeu_si128((__m128i *)alpha_next, turbo_metric_normalize_sse4_1(m_0));
+}
+
+/*********************************************************************
+    Name: turbo_trellis_backward_step_avx2
+
+    Description: AVX2 version of turbo_trellis_backward_step, both
+                 branches out of each of the 8 trellis states are held
+                 in one vector
+
+    Document Reference: N/A
+*********************************************************************/
+__attribute__((target("avx2")))
+void turbo_trellis_backward_step_avx2(int16 *beta,
+                                      int32  L_sys,
+                                      int32  L_par,
+                                      bool   tail,
+                                      int16 *beta_prev)
+{
+    __m256i b_vec = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)beta));
+    __m256i g;
+    __m256i m;
+    __m128i m_0;
+
+    g   = _mm256_adds_epi16(_mm256_sign_epi16(_mm256_set1_epi16((int16)L_sys), _mm256_loadu_si256((__m256i *)TURBO_SIMD_BWD_SYS_SIGN)),
+                            _mm256_sign_epi16(_mm256_set1_epi16((int16)L_par), _mm256_loadu_si256((__m256i *)TURBO_SIMD_BWD_PAR_SIGN)));
+    m   = _mm256_adds_epi16(_mm256_shuffle_epi8(b_vec, _mm256_loadu_si256((__m256i *)TURBO_SIMD_BWD_SHUFFLE)), g);
+    m_0 = _mm256_castsi256_si128(m);
+    if(!tail)
     {
-        // If transition has resulted in a lower valued state,
-        // the output is 0 and vice-versa
-        if(phy_struct->vd_tb_state[i] < phy_struct->vd_tb_state[i+1])
-        {
-            c_bits[idx++] = 0;
-        }else if(phy_struct->vd_tb_state[i] > phy_struct->vd_tb_state[i+1]){
-            c_bits[idx++] = 1;
-        }else{
-            // Check to see if the transition has resulted in the same state
-            // In this case, if state is 0 then output is 0
-            if(phy_struct->vd_tb_state[i] == 0)
-            {
-                c_bits[idx++] = 0;
-            }else{
-                c_bits[idx++] = 1;
-            }
-        }
+        m_0 = _mm_max_epi16(m_0, _mm256_extracti128_si256(m, 1));
     }
-    *N_c_bits = idx;
+
+    _mm_storeu_si128((__m128i *)beta_prev, turbo_metric_normalize_sse4_1(m_0));
+}
+
+/*********************************************************************
+    Name: turbo_trellis_extrinsic_avx2
+
+    Description: AVX2 version of turbo_trellis_extrinsic
+
+    Document Reference: N/A
+*********************************************************************/
+__attribute__((target("avx2")))
+int16 turbo_trellis_extrinsic_avx2(int16 *alpha,
+                                   int16 *beta,
+                                   int32  L_par)
+{
+    __m256i a_vec = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)alpha));
+    __m256i b_vec = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)beta));
+    __m256i m;
+    __m256i u;
+
+    m = _mm256_adds_epi16(_mm256_adds_epi16(a_vec, _mm256_shuffle_epi8(b_vec, _mm256_loadu_si256((__m256i *)TURBO_SIMD_BWD_SHUFFLE))),
+                          _mm256_sign_epi16(_mm256_set1_epi16((int16)L_par), _mm256_loadu_si256((__m256i *)TURBO_SIMD_BWD_PAR_SIGN)));
+
+    // Swap the branches of states 2 through 5 so that the low half
+    // holds systematic 0 and the high half systematic 1
+    u = _mm256_blend_epi16(m, _mm256_permute2x128_si256(m, m, 0x01), 0x3C);
+
+    return(turbo_extrinsic_clamp(turbo_hmax_sse4_1(_mm256_castsi256_si128(u)),
+                                 turbo_hmax_sse4_1(_mm256_extracti128_si256(u, 1))));
+}
+
+/*********************************************************************
+    Name: turbo_trellis_dual_step_avx2
+
+    Description: Performs one step of the forward state metric
+                 recursion and one independent step of the backward
+                 state metric recursion, neither of which may be in
+                 the trellis termination
+
+    Document Reference: N/A
+*********************************************************************/
+__attribute__((target("avx2")))
+void turbo_trellis_dual_step_avx2(int16 *alpha,
+                                  int32  L_sys_f,
+                                  int32  L_par_f,
+                                  int16 *alpha_next,
+                                  int16 *beta,
+                                  int32  L_sys_b,
+                                  int32  L_par_b,
+                                  int16 *beta_prev)
+{
+    __m256i ab_vec;
+    __m256i ls_vec;
+    __m256i lp_vec;
+    __m256i m_0;
+    __m256i m_1;
+
+    ab_vec = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)alpha)),
+                                     _mm_loadu_si128((__m128i *)beta), 1);
+    ls_vec = _mm256_inserti128_si256(_mm256_set1_epi16((int16)L_sys_f), _mm_set1_epi16((int16)L_sys_b), 1);
+    lp_vec = _mm256_inserti128_si256(_mm256_set1_epi16((int16)L_par_f), _mm_set1_epi16((int16)L_par_b), 1);
+
+    m_0 = _mm256_adds_epi16(_mm256_sign_epi16(ls_vec, _mm256_loadu_si256((__m256i *)TURBO_SIMD_DUAL_SYS_SIGN[0])),
+                            _mm256_sign_epi16(lp_vec, _mm256_loadu_si256((__m256i *)TURBO_SIMD_DUAL_PAR_SIGN[0])));
+    m_1 = _mm256_adds_epi16(_mm256_sign_epi16(ls_vec, _mm256_loadu_si256((__m256i *)TURBO_SIMD_DUAL_SYS_SIGN[1])),
+                            _mm256_sign_epi16(lp_vec, _mm256_loadu_si256((__m256i *)TURBO_SIMD_DUAL_PAR_SIGN[1])));
+    m_0 = _mm256_adds_epi16(_mm256_shuffle_epi8(ab_vec, _mm256_loadu_si256((__m256i *)TURBO_SIMD_DUAL_SHUFFLE[0])), m_0);
+    m_1 = _mm256_adds_epi16(_mm256_shuffle_epi8(ab_vec, _mm256_loadu_si256((__m256i *)TURBO_SIMD_DUAL_SHUFFLE[1])), m_1);
+    m_0 = _mm256_max_epi16(m_0, m_1);
+
+    // Normalize each half to its state 0 and saturate
+    m_0 = _mm256_subs_epi16(m_0, _mm256_shuffle_epi8(m_0, _mm256_set1_epi16(0x0100)));
+    m_0 = _mm256_max_epi16(m_0, _mm256_set1_epi16(TURBO_METRIC_NEG_INF));
+    m_0 = _mm256_min_epi16(m_0, _mm256_set1_epi16(-TURBO_METRIC_NEG_INF));
+
+    _mm_storeu_si128((__m128i *)alpha_next, _mm256_castsi256_si128(m_0));
+    _mm_storeu_si128((__m128i *)beta_prev, _mm256_extracti128_si256(m_0, 1));
+}
+
+/*********************************************************************
+    Name: turbo_metric_normalize_sse4_1
+
+    Description: Normalizes a vector of state metrics to state 0 and
+                 saturates them to the metric range
+
+    Document Reference: N/A
+*********************************************************************/
+__attribute__((target("sse4.1")))
+__m128i turbo_metric_normalize_sse4_1(__m128i metric)
+{
+    metric = _mm_subs_epi16(metric, _mm_shuffle_epi8(metric, _mm_set1_epi16(0x0100)));
+    metric = _mm_max_epi16(metric, _mm_set1_epi16(TURBO_METRIC_NEG_INF));
+    metric = _mm_min_epi16(metric, _mm_set1_epi16(-TURBO_METRIC_NEG_INF));
+
+    return(metric);
+}
+
+/*********************************************************************
+    Name: turbo_hmax_sse4_1
+
+    Description: Finds the maximum of 8 signed 16 bit values
+
+    Document Reference: N/A
+*********************************************************************/
+__attribute__((target("sse4.1")))
+int32 turbo_hmax_sse4_1(__m128i in)
+{
+    in = _mm_max_epi16(in, _mm_shuffle_epi32(in, 0x4E));
+    in = _mm_max_epi16(in, _mm_shuffle_epi32(in, 0xB1));
+    in = _mm_max_epi16(in, _mm_shufflelo_epi16(in, 0xB1));
+
+    return((int16)_mm_extract_epi16(in, 0));
 }
+#endif
 
 /*********************************************************************
-    Name: viterbi_decode_siso
+    Name: fftw_wisdom_file_name
 
-    Description: Soft input soft output viterbi decodes a
-                 convolutionally coded input bit array using the
-                 provided parameters
+    Description: Returns the process wide FFTW wisdom file name, empty
+                 when no wisdom file is set
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.1
+    Document Reference: N/A
 *********************************************************************/
-void viterbi_decode_siso(LIBLTE_PHY_STRUCT *phy_struct,
-                         int8              *d_bits,
-                         uint32             N_d_bits,
-                         uint32             constraint_len,
-                         uint32             rate,
-                         uint32            *g,
-                         int8              *c_bits,
-                         uint32            *N_c_bits)
+char* fftw_wisdom_file_name(void)
 {
-    float  init_min;
-    float  tmp1;
-    float  tmp2;
-    float  max_weight = 0;
-    int32  i;
-    uint32 j;
-    uint32 k;
-    uint32 o;
-    uint32 N_states = 1<<(constraint_len-1);
-    uint32 idx;
-    uint32 tb_state_len;
-    uint8  in_path;
-    uint8  prev_state;
-    uint8  in_bit;
-    uint8  prev_state_0;
-    uint8  prev_state_1;
-    uint8  s_reg[constraint_len];
-    uint8  g_array[3][constraint_len];
-
-    // Convert g to binary
-    for(i=0; i<(int32)rate; i++)
-    {
-        for(j=0; j<constraint_len; j++)
-        {
-            g_array[i][j] = (g[i] >> (constraint_len-j-1)) & 1;
-        }
-    }
+    // FFTW wisdom is process wide, so the file name is as well
+    static char file_name[LIBLTE_PHY_FFTW_WISDOM_FILE_NAME_MAX] = "";
 
-    // Precalculate state transition outputs
-    for(i=0; i<(int32)N_states; i++)
-    {
-        // Determine the input path
-        if(i < (N_states/2))
-        {
-            in_path = 0;
-        }else{
-            in_path = 1;
-        }
+    return(file_name);
+}
 
-        // Determine the outputs based on the previous state and input path
-        for(j=0; j<2; j++)
-        {
-            prev_state = ((i << 1) + j) % N_states;
-            for(k=0; k<constraint_len; k++)
-            {
-                s_reg[k] = (prev_state >> (constraint_len-k-1)) & 1;
-            }
-            s_reg[0] = in_path;
-            for(k=0; k<rate; k++)
-            {
-                phy_struct->vd_st_output[i][j][k] = 0;
-                for(o=0; o<constraint_len; o++)
-                {
-                    phy_struct->vd_st_output[i][j][k] += s_reg[o]*g_array[k][o];
-                }
-                phy_struct->vd_st_output[i][j][k] %= 2;
-            }
-        }
-    }
+/*********************************************************************
+    Name: fftw_wisdom_save
 
-    // Calculate branch and path metrics
-    for(i=0; i<(int32)N_states; i++)
-    {
-        for(j=0; j<(N_d_bits/rate)+10; j++)
-        {
-            phy_struct->vd_path_metric[i][j] = 0;
-            phy_struct->vd_w_metric[i][j]    = 0;
-        }
-    }
-    for(i=0; i<(int32)(N_d_bits/rate); i++)
-    {
-        for(j=0; j<N_states; j++)
-        {
-            phy_struct->vd_br_metric[j][0] = 0;
-            phy_struct->vd_br_metric[j][1] = 0;
-            phy_struct->vd_p_metric[j][0]  = 0;
-            phy_struct->vd_p_metric[j][1]  = 0;
-            phy_struct->vd_br_weight[j][0] = 0;
-            phy_struct->vd_br_weight[j][1] = 0;
+    Description: Saves the accumulated FFTW wisdom to the wisdom file
 
-            // Calculate the accumulated branch metrics for each state
-            for(k=0; k<2; k++)
+    Document Reference: N/A
+*********************************************************************/
+void fftw_wisdom_save(void)
+{
+    FILE *tmp_file;
+    char *file_name = fftw_wisdom_file_name();
+    char  tmp_name[LIBLTE_PHY_FFTW_WISDOM_FILE_NAME_MAX+8];
+    int   fd;
+    bool  saved;
+
+    if('\0' != file_name[0])
+    {
+        // Write to a new, uniquely named file next to the wisdom file
+        // and rename it, so that a reader never imports partially
+        // written wisdom and an existing file or link is never
+        // written through
+        snprintf(tmp_name, sizeof(tmp_name), "%s.XXXXXX", file_name);
+        fd = mkstemp(tmp_name);
+        if(-1 != fd)
+        {
+            tmp_file = fdopen(fd, "w");
+            if(NULL != tmp_file)
             {
-                prev_state                    = ((j<<1)+k) % N_states;
-                phy_struct->vd_p_metric[j][k] = phy_struct->vd_path_metric[prev_state][i];
-                for(o=0; o<rate; o++)
+                saved = fftwf_export_wisdom_to_file(tmp_file);
+                if(0 != fclose(tmp_file))
                 {
-                    if(d_bits[i*rate + o] >= 0)
-                    {
-                        in_bit = 0;
-                    }else{
-                        in_bit = 1;
-                    }
-                    if(phy_struct->vd_st_output[j][k][o] == in_bit)
-                    {
-                        phy_struct->vd_br_metric[j][k] += -1;
-                    }else{
-                        phy_struct->vd_br_metric[j][k] += 1;
-                    }
-                    phy_struct->vd_br_weight[j][k] += fabs(d_bits[i*rate + o]);
+                    saved = false;
                 }
+            }else{
+                close(fd);
+                saved = false;
             }
-
-            // Keep the smallest branch metric as the path metric, weight the branch metric
-            tmp1 = phy_struct->vd_br_metric[j][0] + phy_struct->vd_p_metric[j][0];
-            tmp2 = phy_struct->vd_br_metric[j][1] + phy_struct->vd_p_metric[j][1];
-            if(tmp1 > tmp2)
+            if(!saved ||
+               0 != rename(tmp_name, file_name))
             {
-                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][1] + phy_struct->vd_br_weight[j][1]*phy_struct->vd_br_metric[j][1];
-                phy_struct->vd_w_metric[j][i+1]    = phy_struct->vd_br_weight[j][1];
-            }else{
-                phy_struct->vd_path_metric[j][i+1] = phy_struct->vd_p_metric[j][0] + phy_struct->vd_br_weight[j][0]*phy_struct->vd_br_metric[j][0];
-                phy_struct->vd_w_metric[j][i+1]    = phy_struct->vd_br_weight[j][0];
+                unlink(tmp_name);
             }
         }
     }
+}
 
-    // Find the minimum metric for the last iteration
-    init_min                     = 1000000;
-    idx                          = 0;
-    phy_struct->vd_tb_state[idx] = 1000000;
-    for(i=0; i<(int32)N_states; i++)
+/*********************************************************************
+    Name: phy_huge_pages
+
+    Description: Returns the process wide huge page selection
+
+    Document Reference: N/A
+*********************************************************************/
+bool* phy_huge_pages(void)
+{
+    static bool huge_pages = false;
+
+    return(&huge_pages);
+}
+
+/*********************************************************************
+    Name: phy_mem_alloc
+
+    Description: Allocates LIBLTE_PHY_MEM_ALIGN aligned memory, from
+                 huge pages if selected
+
+    Document Reference: N/A
+*********************************************************************/
+void* phy_mem_alloc(uint32  size,
+                    bool   *huge_pages)
+{
+    void   *ptr     = NULL;
+    uint32  N_bytes = (size + LIBLTE_PHY_HUGE_PAGE_SIZE - 1) & ~(LIBLTE_PHY_HUGE_PAGE_SIZE - 1);
+
+    *huge_pages = false;
+    if(*phy_huge_pages())
     {
-        if(phy_struct->vd_path_metric[i][(N_d_bits/rate)] < init_min)
+#ifdef MAP_HUGETLB
+        ptr = mmap(NULL, N_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if(MAP_FAILED != ptr)
         {
-            init_min                      = phy_struct->vd_path_metric[i][(N_d_bits/rate)];
-            phy_struct->vd_tb_state[idx]  = i;
-            phy_struct->vd_tb_weight[idx] = phy_struct->vd_w_metric[i][(N_d_bits/rate)];
-            max_weight                    = phy_struct->vd_tb_weight[idx];
-            idx++;
+            *huge_pages = true;
+            return(ptr);
         }
-    }
-
-    // Traceback to find the minimum path metrics at each iteration
-    for(i=(N_d_bits/rate)-1; i>=0; i--)
-    {
-        prev_state_0 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 0) % N_states;
-        prev_state_1 = ((((uint8)phy_struct->vd_tb_state[idx-1])<<1) + 1) % N_states;
-
-        // Keep the smallest state
-        if(phy_struct->vd_path_metric[prev_state_0][i] > phy_struct->vd_path_metric[prev_state_1][i])
+#endif
+        // No huge pages reserved, ask for transparent huge pages
+        if(0 != posix_memalign(&ptr, LIBLTE_PHY_HUGE_PAGE_SIZE, N_bytes))
         {
-            phy_struct->vd_tb_state[idx]  = prev_state_1;
-            phy_struct->vd_tb_weight[idx] = phy_struct->vd_w_metric[prev_state_1][i];
-        }else{
-            phy_struct->vd_tb_state[idx]  = prev_state_0;
-            phy_struct->vd_tb_weight[idx] = phy_struct->vd_w_metric[prev_state_0][i];
+            return(NULL);
         }
-        if(phy_struct->vd_tb_weight[idx] > max_weight)
+#ifdef MADV_HUGEPAGE
+        madvise(ptr, N_bytes, MADV_HUGEPAGE);
+#endif
+    }else{
+        if(0 != posix_memalign(&ptr, LIBLTE_PHY_MEM_ALIGN, size))
         {
-            max_weight = phy_struct->vd_tb_weight[idx];
+            return(NULL);
         }
-        idx++;
     }
-    tb_state_len = idx;
 
-    // Read through the traceback to determine the input bits
-    idx = 0;
-    for(i=tb_state_len-2; i>=0; i--)
+    return(ptr);
+}
+
+/*********************************************************************
+    Name: phy_mem_free
+
+    Description: Frees memory allocated by phy_mem_alloc
+
+    Document Reference: N/A
+*********************************************************************/
+void phy_mem_free(void   *ptr,
+                  uint32  size,
+                  bool    huge_pages)
+{
+    if(huge_pages)
     {
-        // If transition has resulted in a lower valued state,
-        // the output is 0 and vice-versa
-        if(phy_struct->vd_tb_state[i] < phy_struct->vd_tb_state[i+1])
-        {
-            c_bits[idx++] = 127 * (phy_struct->vd_tb_weight[i]/max_weight);
-        }else if(phy_struct->vd_tb_state[i] > phy_struct->vd_tb_state[i+1]){
-            c_bits[idx++] = -127 * (phy_struct->vd_tb_weight[i]/max_weight);
-        }else{
-            // Check to see if the transition has resulted in the same state
-            // In this case, if state is 0 then output is 0
-            if(phy_struct->vd_tb_state[i] == 0)
-            {
-                c_bits[idx++] = 127 * (phy_struct->vd_tb_weight[i]/max_weight);
-            }else{
-                c_bits[idx++] = -127 * (phy_struct->vd_tb_weight[i]/max_weight);
-            }
-        }
+        munmap(ptr, (size + LIBLTE_PHY_HUGE_PAGE_SIZE - 1) & ~(LIBLTE_PHY_HUGE_PAGE_SIZE - 1));
+    }else{
+        free(ptr);
     }
-    *N_c_bits = idx;
 }
 
 /*********************************************************************
-    Name: turbo_encode
+    Name: phy_arena_init
 
-    Description: Turbo encodes a bit array using the LTE Parallel
-                 Concatenated Convolutional Code
+    Description: Allocates an arena of size bytes, which is then
+                 handed out in aligned pieces by phy_arena_get
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2
+    Document Reference: N/A
+*********************************************************************/
+void phy_arena_init(LIBLTE_PHY_ARENA_STRUCT *arena,
+                    uint32                   size)
+{
+    arena->base = (uint8 *)phy_mem_alloc(size, &arena->huge_pages);
+    arena->size = (NULL != arena->base) ? size : 0;
+    arena->used = 0;
+}
 
-    Notes: Currently not handling filler bits
+/*********************************************************************
+    Name: phy_arena_get
+
+    Description: Returns the next LIBLTE_PHY_MEM_ALIGN aligned piece
+                 of an arena
+
+    Document Reference: N/A
 *********************************************************************/
-void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
-                  uint8             *c_bits,
-                  uint32             N_c_bits,
-                  uint32             N_fill_bits,
-                  uint8             *d_bits,
-                  uint32            *N_d_bits)
+void* phy_arena_get(LIBLTE_PHY_ARENA_STRUCT *arena,
+                    uint32                   size)
 {
-    uint32 i;
-    uint32 N_branch_bits = N_c_bits + 4;
+    void *ptr = NULL;
 
-    // Construct z
-    turbo_constituent_encoder(c_bits,
-                              N_c_bits,
-                              phy_struct->te_z,
-                              phy_struct->te_fb1);
+    if(arena->used + PHY_ARENA_ROUND(size) <= arena->size)
+    {
+        ptr          = &arena->base[arena->used];
+        arena->used += PHY_ARENA_ROUND(size);
+    }
 
-    // Construct c_prime
-    turbo_internal_interleaver(c_bits,
-                               N_c_bits,
-                               phy_struct->te_c_prime);
+    return(ptr);
+}
 
-    // Construct z_prime
-    turbo_constituent_encoder(phy_struct->te_c_prime,
-                              N_c_bits,
-                              phy_struct->te_z_prime,
-                              phy_struct->te_x_prime);
+/*********************************************************************
+    Name: phy_arena_free
+
+    Description: Frees an arena
+
+    Document Reference: N/A
+*********************************************************************/
+void phy_arena_free(LIBLTE_PHY_ARENA_STRUCT *arena)
+{
+    if(NULL != arena->base)
+    {
+        phy_mem_free(arena->base, arena->size, arena->huge_pages);
+    }
+    arena->base = NULL;
+    arena->size = 0;
+    arena->used = 0;
+}
+
+/*********************************************************************
+    Name: turbo_kernel_detect
+
+    Description: Determines the fastest turbo decoder trellis kernel
+                 supported by the CPU
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_PHY_TURBO_KERNEL_ENUM turbo_kernel_detect(void)
+{
+    LIBLTE_PHY_TURBO_KERNEL_ENUM kernel = LIBLTE_PHY_TURBO_KERNEL_SCALAR;
 
-    // Construct d_bits
-    for(i=0; i<N_c_bits; i++)
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
     {
-        d_bits[i]                 = c_bits[i];
-        d_bits[N_branch_bits+i]   = phy_struct->te_z[i];
-        d_bits[2*N_branch_bits+i] = phy_struct->te_z_prime[i];
+        kernel = LIBLTE_PHY_TURBO_KERNEL_AVX2;
+    }else if(__builtin_cpu_supports("sse4.1")){
+        kernel = LIBLTE_PHY_TURBO_KERNEL_SSE4_1;
     }
-    d_bits[N_c_bits]                   = phy_struct->te_fb1[N_c_bits];
-    d_bits[N_c_bits+1]                 = phy_struct->te_z[N_c_bits+1];
-    d_bits[N_c_bits+2]                 = phy_struct->te_x_prime[N_c_bits];
-    d_bits[N_c_bits+3]                 = phy_struct->te_z_prime[N_c_bits+1];
-    d_bits[N_branch_bits+N_c_bits]     = phy_struct->te_z[N_c_bits];
-    d_bits[N_branch_bits+N_c_bits+1]   = phy_struct->te_fb1[N_c_bits+2];
-    d_bits[N_branch_bits+N_c_bits+2]   = phy_struct->te_z_prime[N_c_bits];
-    d_bits[N_branch_bits+N_c_bits+3]   = phy_struct->te_x_prime[N_c_bits+2];
-    d_bits[2*N_branch_bits+N_c_bits]   = phy_struct->te_fb1[N_c_bits+1];
-    d_bits[2*N_branch_bits+N_c_bits+1] = phy_struct->te_z[N_c_bits+2];
-    d_bits[2*N_branch_bits+N_c_bits+2] = phy_struct->te_x_prime[N_c_bits+1];
-    d_bits[2*N_branch_bits+N_c_bits+3] = phy_struct->te_z_prime[N_c_bits+2];
+#endif
 
-    *N_d_bits = N_branch_bits*3;
+    return(kernel);
 }
 
 /*********************************************************************
-    Name: turbo_decode
+    Name: turbo_decode_viterbi_siso
 
     Description: Turbo decodes data according to the LTE Parallel
                  Concatenated Convolutional Code.  The design of this
@@ -10617,12 +15336,12 @@ void turbo_encode(LIBLTE_PHY_STRUCT *phy_struct,
 
     Notes: Currently not handling filler bits
 *********************************************************************/
-void turbo_decode(LIBLTE_PHY_STRUCT *phy_struct,
-                  float             *d_bits,
-                  uint32             N_d_bits,
-                  uint32             N_fill_bits,
-                  uint8             *c_bits,
-                  uint32            *N_c_bits)
+void turbo_decode_viterbi_siso(LIBLTE_PHY_STRUCT *phy_struct,
+                               float             *d_bits,
+                               uint32             N_d_bits,
+                               uint32             N_fill_bits,
+                               uint8             *c_bits,
+                               uint32            *N_c_bits)
 {
     float  tmp_s_bit;
     float  max_value = 0;
@@ -10923,6 +15642,45 @@ void turbo_constituent_encoder(uint8  *in_bits,
     }
 }
 
+/*********************************************************************
+    Name: turbo_internal_interleaver_pre_calc
+
+    Description: Calculates the internal interleaver permutation for
+                 the LTE Parallel Concatenated Convolutional Code
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.3.2.3
+*********************************************************************/
+void turbo_internal_interleaver_pre_calc(uint32  K,
+                                         uint16 *pi)
+{
+    uint32 i;
+    uint32 f1 = 0;
+    uint32 f2 = 0;
+    uint32 idx;
+    uint32 inc;
+
+    // Determine f1 and f2
+    for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+    {
+        if(K == TURBO_INT_K_TABLE[i])
+        {
+            f1 = TURBO_INT_F1_TABLE[i];
+            f2 = TURBO_INT_F2_TABLE[i];
+            break;
+        }
+    }
+
+    // pi(i+1) = pi(i) + f1 + f2*(2*i + 1) mod K
+    idx = 0;
+    inc = (f1 + f2) % K;
+    for(i=0; i<K; i++)
+    {
+        pi[i] = idx;
+        idx   = (idx + inc) % K;
+        inc   = (inc + 2*f2) % K;
+    }
+}
+
 /*********************************************************************
     Name: turbo_internal_interleaver
 
@@ -10953,7 +15711,7 @@ void turbo_internal_interleaver(uint8  *in_bits,
 
     for(i=0; i<N_in_bits; i++)
     {
-        idx         = (f1*i + f2*i*i) % N_in_bits;
+        idx         = (uint32)(((uint64)f1*i + (uint64)f2*i*i) % N_in_bits);
         out_bits[i] = in_bits[idx];
     }
 }
@@ -10979,7 +15737,7 @@ void turbo_internal_interleaver(int8   *in_bits,
 
     for(i=0; i<N_in_bits; i++)
     {
-        idx         = (f1*i + f2*i*i) % N_in_bits;
+        idx         = (uint32)(((uint64)f1*i + (uint64)f2*i*i) % N_in_bits);
         out_bits[i] = in_bits[idx];
     }
 }
@@ -11005,7 +15763,7 @@ void turbo_internal_interleaver(float  *in_bits,
 
     for(i=0; i<N_in_bits; i++)
     {
-        idx         = (f1*i + f2*i*i) % N_in_bits;
+        idx         = (uint32)(((uint64)f1*i + (uint64)f2*i*i) % N_in_bits);
         out_bits[i] = in_bits[idx];
     }
 }
@@ -11040,7 +15798,7 @@ void turbo_internal_deinterleaver(float  *in_bits,
 
     for(i=0; i<N_in_bits; i++)
     {
-        idx           = (f1*i + f2*i*i) % N_in_bits;
+        idx           = (uint32)(((uint64)f1*i + (uint64)f2*i*i) % N_in_bits);
         out_bits[idx] = in_bits[i];
     }
 }
@@ -11066,7 +15824,7 @@ void turbo_internal_deinterleaver(int8   *in_bits,
 
     for(i=0; i<N_in_bits; i++)
     {
-        idx           = (f1*i + f2*i*i) % N_in_bits;
+        idx           = (uint32)(((uint64)f1*i + (uint64)f2*i*i) % N_in_bits);
         out_bits[idx] = in_bits[i];
     }
 }
@@ -11090,149 +15848,97 @@ void liblte_phy_rate_match_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
                                  uint32                     N_e_bits,
                                  uint8                     *e_bits)
 {
-    uint32 C_tc_sb = 32; // Step 1: Assign C_tc_sb to 32
-    uint32 R_tc_sb;
-    uint32 w_idx = 0;
-    uint32 d_idx;
-    uint32 pi_idx;
-    uint32 N_dummy;
-    uint32 K_mimo;
-    uint32 N_ir;
-    uint32 N_cb;
-    uint32 idx;
-    uint32 K_pi;
-    uint32 K_w;
-    uint32 k_0;
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 x;
-
-    // Sub-block interleaving
-    // Step 2: Determine the number of rows
-    R_tc_sb = 0;
-    while((N_d_bits/3) > (C_tc_sb*R_tc_sb))
-    {
-        R_tc_sb++;
+    LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT *table;
+    uint32                              N_branch_bits = N_d_bits/3;
+    uint32                              N_cb;
+    uint32                              idx;
+    uint32                              w;
+    uint32                              k;
+
+    N_cb  = rate_match_turbo_n_cb(N_branch_bits,
+                                  N_codeblocks,
+                                  tx_mode,
+                                  N_soft,
+                                  M_dl_harq,
+                                  chan_type);
+    table = rate_match_table(phy_struct,
+                             true,
+                             N_branch_bits,
+                             turbo_n_fill_bits(d_bits, N_branch_bits),
+                             N_cb);
+
+    // Bit collection, selection, and transmission, the d_bits are
+    // stored one stream after the other
+    w = table->rv_start[rv_idx];
+    for(k=0; k<N_e_bits; k++)
+    {
+        idx       = table->d_idx[w];
+        e_bits[k] = d_bits[(idx%3)*N_branch_bits + idx/3];
+        if(++w == table->N_w_bits)
+        {
+            w = 0;
+        }
     }
+}
 
-    // Steps 3, 4, and 5
-    for(x=0; x<3; x++)
-    {
-        // Step 3: Pack data into matrix and pad with dummy
-        if((N_d_bits/3) < (C_tc_sb*R_tc_sb))
-        {
-            N_dummy = C_tc_sb*R_tc_sb - (N_d_bits/3);
-        }else{
-            N_dummy = 0;
-        }
-        for(i=0; i<N_dummy; i++)
-        {
-            phy_struct->rmt_tmp[i] = TX_NULL_BIT;
-        }
-        d_idx = 0;
-        for(i=N_dummy; i<C_tc_sb*R_tc_sb; i++)
-        {
-            phy_struct->rmt_tmp[i] = d_bits[(N_d_bits/3)*x+d_idx];
-            d_idx++;
-        }
-        idx = 0;
-        for(i=0; i<R_tc_sb; i++)
-        {
-            for(j=0; j<C_tc_sb; j++)
-            {
-                phy_struct->rmt_sb_mat[i][j] = phy_struct->rmt_tmp[idx++];
-            }
-        }
+/*********************************************************************
+    Name: liblte_phy_rate_match_turbo_packed
 
-        w_idx = 0;
-        if(x != 2)
-        {
-            // Step 4: Inter-column permutation
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rmt_sb_perm_mat[i][j] = phy_struct->rmt_sb_mat[i][IC_PERM_TC[j]];
-                }
-            }
+    Description: Rate matches packed turbo encoded data, writing the
+                 output bits starting at e_offset.  This makes code
+                 block concatenation a matter of advancing e_offset.
 
-            // Step 5: Read out the bits
-            idx  = 0;
-            K_pi = R_tc_sb*C_tc_sb;
-            for(j=0; j<C_tc_sb; j++)
-            {
-                for(i=0; i<R_tc_sb; i++)
-                {
-                    if(x == 0)
-                    {
-                        phy_struct->rmt_w[w_idx++] = phy_struct->rmt_sb_perm_mat[i][j];
-                    }else{
-                        phy_struct->rmt_w[K_pi+(2*w_idx)] = phy_struct->rmt_sb_perm_mat[i][j];
-                        w_idx++;
-                    }
-                }
-            }
-        }else{
-            // Step 4: Permutation for the last output
-            K_pi = R_tc_sb*C_tc_sb;
-            idx  = 0;
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rmt_y[idx++] = phy_struct->rmt_sb_mat[i][j];
-                }
-            }
-            for(i=0; i<K_pi; i++)
-            {
-                pi_idx                              = (IC_PERM_TC[i/R_tc_sb]+C_tc_sb*(i%R_tc_sb)+1) % K_pi;
-                phy_struct->rmt_w[K_pi+(2*w_idx)+1] = phy_struct->rmt_y[pi_idx];
-                w_idx++;
-            }
-        }
-    }
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.4.1 and
+                        5.1.5
+*********************************************************************/
+void liblte_phy_rate_match_turbo_packed(LIBLTE_PHY_STRUCT         *phy_struct,
+                                        uint8                     *d_bytes,
+                                        uint32                     N_d_bits,
+                                        uint32                     N_fill_bits,
+                                        uint32                     N_codeblocks,
+                                        uint32                     tx_mode,
+                                        uint32                     N_soft,
+                                        uint32                     M_dl_harq,
+                                        LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                                        uint32                     rv_idx,
+                                        uint32                     N_e_bits,
+                                        uint8                     *e_bytes,
+                                        uint32                     e_offset)
+{
+    LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT *table;
+    uint32                              N_branch_bits = N_d_bits/3;
+    uint32                              stride        = (N_branch_bits+7)/8;
+    uint32                              N_cb;
+    uint32                              idx;
+    uint32                              pos;
+    uint32                              w;
+    uint32                              k;
+    uint8                               bit;
+
+    N_cb  = rate_match_turbo_n_cb(N_branch_bits,
+                                  N_codeblocks,
+                                  tx_mode,
+                                  N_soft,
+                                  M_dl_harq,
+                                  chan_type);
+    table = rate_match_table(phy_struct,
+                             true,
+                             N_branch_bits,
+                             N_fill_bits,
+                             N_cb);
 
     // Bit collection, selection, and transmission
-    // Create circular buffer
-    K_w = 3*K_pi;
-    if(tx_mode == 3 ||
-       tx_mode == 4 ||
-       tx_mode == 8 ||
-       tx_mode == 9)
-    {
-        K_mimo = 2;
-    }else{
-        K_mimo = 1;
-    }
-    if(M_dl_harq < 8)
-    {
-        N_ir = N_soft/(K_mimo*M_dl_harq);
-    }else{
-        N_ir = N_soft/(K_mimo*8);
-    }
-    if(LIBLTE_PHY_CHAN_TYPE_DLSCH == chan_type ||
-       LIBLTE_PHY_CHAN_TYPE_PCH   == chan_type)
-    {
-        if((N_ir/N_codeblocks) < K_w)
-        {
-            N_cb = N_ir/N_codeblocks;
-        }else{
-            N_cb = K_w;
-        }
-    }else{
-        N_cb = K_w;
-    }
-    k_0 = R_tc_sb*(2*(uint32)ceilf((float)N_cb/(float)(8*R_tc_sb))*rv_idx+2);
-    k   = 0;
-    j   = 0;
-    while(k < N_e_bits)
+    w = table->rv_start[rv_idx];
+    for(k=0; k<N_e_bits; k++)
     {
-        if(phy_struct->rmt_w[(k_0+j)%N_cb] != TX_NULL_BIT)
+        idx            = table->d_idx[w];
+        bit            = (d_bytes[(idx%3)*stride + (idx/3)/8] >> (7-((idx/3)%8))) & 1;
+        pos            = e_offset + k;
+        e_bytes[pos/8] = (e_bytes[pos/8] & ~(0x80 >> (pos%8))) | (bit << (7-(pos%8)));
+        if(++w == table->N_w_bits)
         {
-            e_bits[k++] = phy_struct->rmt_w[(k_0+j)%N_cb];
+            w = 0;
         }
-        j++;
     }
 }
 
@@ -11257,118 +15963,132 @@ void liblte_phy_rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
                                    float                     *d_bits,
                                    uint32                    *N_d_bits)
 {
-    uint32 C_tc_sb = 32; // Step 1: Assign C_tc_sb to 32
-    uint32 R_tc_sb;
-    uint32 w_idx = 0;
-    uint32 d_idx;
-    uint32 pi_idx;
-    uint32 N_dummy;
-    uint32 K_mimo;
-    uint32 N_ir;
-    uint32 N_cb;
-    uint32 idx;
-    uint32 K_pi;
-    uint32 K_w;
-    uint32 k_0;
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 x;
+    // The dummy_bits are only needed for the positions of the
+    // filler bits
+    rate_unmatch_turbo(phy_struct,
+                       e_bits,
+                       N_e_bits,
+                       N_dummy_bits,
+                       turbo_n_fill_bits(dummy_bits, N_dummy_bits),
+                       rate_match_turbo_n_cb(N_dummy_bits,
+                                             N_codeblocks,
+                                             tx_mode,
+                                             N_soft,
+                                             M_dl_harq,
+                                             chan_type),
+                       rv_idx,
+                       false,
+                       d_bits,
+                       N_d_bits);
+}
 
-    // In order to undo bit collection, selection, and transmission
-    // a dummy block must be sub-block interleaved to determine
-    // where NULL bits are to be inserted
-    // Sub-block interleaving
-    // Step 2: Determine the number of rows
-    R_tc_sb = 0;
-    while(N_dummy_bits > (C_tc_sb*R_tc_sb))
-    {
-        R_tc_sb++;
-    }
+/*********************************************************************
+    Name: liblte_phy_rate_unmatch_turbo_combine
+
+    Description: Rate unmatches turbo encoded data, soft combining it
+                 with the d_bits of earlier transmissions of the same
+                 code block (HARQ chase combining or incremental
+                 redundancy)
 
-    // Steps 3, 4, and 5
-    for(x=0; x<3; x++)
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
+
+    Notes: d_bits must hold the output of liblte_phy_rate_unmatch_turbo
+           for the first transmission
+*********************************************************************/
+void liblte_phy_rate_unmatch_turbo_combine(LIBLTE_PHY_STRUCT         *phy_struct,
+                                           float                     *e_bits,
+                                           uint32                     N_e_bits,
+                                           uint8                     *dummy_bits,
+                                           uint32                     N_dummy_bits,
+                                           uint32                     N_codeblocks,
+                                           uint32                     tx_mode,
+                                           uint32                     N_soft,
+                                           uint32                     M_dl_harq,
+                                           LIBLTE_PHY_CHAN_TYPE_ENUM  chan_type,
+                                           uint32                     rv_idx,
+                                           float                     *d_bits,
+                                           uint32                    *N_d_bits)
+{
+    rate_unmatch_turbo(phy_struct,
+                       e_bits,
+                       N_e_bits,
+                       N_dummy_bits,
+                       turbo_n_fill_bits(dummy_bits, N_dummy_bits),
+                       rate_match_turbo_n_cb(N_dummy_bits,
+                                             N_codeblocks,
+                                             tx_mode,
+                                             N_soft,
+                                             M_dl_harq,
+                                             chan_type),
+                       rv_idx,
+                       true,
+                       d_bits,
+                       N_d_bits);
+}
+
+/*********************************************************************
+    Name: rate_unmatch_turbo
+
+    Description: Rate unmatches turbo encoded data, scattering and
+                 accumulating the e_bits into the d_bits
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1
+
+    Notes: If combine is false, the d_bits are cleared to <NULL>
+           first
+*********************************************************************/
+void rate_unmatch_turbo(LIBLTE_PHY_STRUCT *phy_struct,
+                        float             *e_bits,
+                        uint32             N_e_bits,
+                        uint32             N_branch_bits,
+                        uint32             N_fill_bits,
+                        uint32             N_cb,
+                        uint32             rv_idx,
+                        bool               combine,
+                        float             *d_bits,
+                        uint32            *N_d_bits)
+{
+    LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT *table;
+    uint32                              i;
+
+    table = rate_match_table(phy_struct,
+                             true,
+                             N_branch_bits,
+                             N_fill_bits,
+                             N_cb);
+
+    if(!combine)
     {
-        // Step 3: Pack data into matrix and pad with dummy
-        if(N_dummy_bits < (C_tc_sb*R_tc_sb))
-        {
-            N_dummy = C_tc_sb*R_tc_sb - N_dummy_bits;
-        }else{
-            N_dummy = 0;
-        }
-        for(i=0; i<N_dummy; i++)
-        {
-            phy_struct->rut_tmp[i] = RX_NULL_BIT;
-        }
-        d_idx = 0;
-        for(i=N_dummy; i<C_tc_sb*R_tc_sb; i++)
-        {
-            phy_struct->rut_tmp[i] = dummy_bits[d_idx*3+x];
-            d_idx++;
-        }
-        idx = 0;
-        for(i=0; i<R_tc_sb; i++)
+        for(i=0; i<N_branch_bits*3; i++)
         {
-            for(j=0; j<C_tc_sb; j++)
-            {
-                phy_struct->rut_sb_mat[i][j] = phy_struct->rut_tmp[idx++];
-            }
+            d_bits[i] = RX_NULL_BIT;
         }
+    }
+    rate_unmatch_scatter(table, e_bits, N_e_bits, rv_idx, d_bits);
+    *N_d_bits = N_branch_bits*3;
+}
 
-        w_idx = 0;
-        if(x != 2)
-        {
-            // Step 4: Inter-column permutation
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rut_sb_perm_mat[i][j] = phy_struct->rut_sb_mat[i][IC_PERM_TC[j]];
-                }
-            }
+/*********************************************************************
+    Name: rate_match_turbo_n_cb
 
-            // Step 5: Read out the bits
-            K_pi = R_tc_sb*C_tc_sb;
-            for(j=0; j<C_tc_sb; j++)
-            {
-                for(i=0; i<R_tc_sb; i++)
-                {
-                    if(x == 0)
-                    {
-                        phy_struct->rut_w_dum[w_idx] = phy_struct->rut_sb_perm_mat[i][j];
-                        phy_struct->rut_w[w_idx]     = RX_NULL_BIT;
-                        w_idx++;
-                    }else{
-                        phy_struct->rut_w_dum[K_pi+(2*w_idx)] = phy_struct->rut_sb_perm_mat[i][j];
-                        phy_struct->rut_w[K_pi+(2*w_idx)]     = RX_NULL_BIT;
-                        w_idx++;
-                    }
-                }
-            }
-        }else{
-            // Step 4: Permutation for the last output
-            K_pi = R_tc_sb*C_tc_sb;
-            idx  = 0;
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rut_y[idx++] = phy_struct->rut_sb_mat[i][j];
-                }
-            }
-            for(i=0; i<K_pi; i++)
-            {
-                pi_idx                                  = (IC_PERM_TC[i/R_tc_sb]+C_tc_sb*(i%R_tc_sb)+1)%K_pi;
-                phy_struct->rut_w_dum[K_pi+(2*w_idx)+1] = phy_struct->rut_y[pi_idx];
-                phy_struct->rut_w[K_pi+(2*w_idx)+1]     = RX_NULL_BIT;
-                w_idx++;
-            }
-        }
-    }
+    Description: Determines the soft buffer size of a turbo coded
+                 code block
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.4.1.2
+*********************************************************************/
+uint32 rate_match_turbo_n_cb(uint32                    N_branch_bits,
+                             uint32                    N_codeblocks,
+                             uint32                    tx_mode,
+                             uint32                    N_soft,
+                             uint32                    M_dl_harq,
+                             LIBLTE_PHY_CHAN_TYPE_ENUM chan_type)
+{
+    uint32 K_w;
+    uint32 K_mimo;
+    uint32 N_ir;
+    uint32 N_cb;
 
-    // Undo bit collection, selection, and transmission by
-    // recreating the circular buffer
-    K_w = 3*K_pi;
+    K_w = 3*LIBLTE_PHY_N_COLUMNS_RATE_MATCH*((N_branch_bits + LIBLTE_PHY_N_COLUMNS_RATE_MATCH - 1)/LIBLTE_PHY_N_COLUMNS_RATE_MATCH);
     if(tx_mode == 3 ||
        tx_mode == 4 ||
        tx_mode == 8 ||
@@ -11377,116 +16097,27 @@ void liblte_phy_rate_unmatch_turbo(LIBLTE_PHY_STRUCT         *phy_struct,
         K_mimo = 2;
     }else{
         K_mimo = 1;
-    }
-    if(M_dl_harq < 8)
-    {
-        N_ir = N_soft/(K_mimo*M_dl_harq);
-    }else{
-        N_ir = N_soft/(K_mimo*8);
-    }
-    if(LIBLTE_PHY_CHAN_TYPE_DLSCH == chan_type ||
-       LIBLTE_PHY_CHAN_TYPE_PCH   == chan_type)
-    {
-        if((N_ir/N_codeblocks) < K_w)
-        {
-            N_cb = N_ir/N_codeblocks;
-        }else{
-            N_cb = K_w;
-        }
-    }else{
-        N_cb = K_w;
-    }
-    k_0 = R_tc_sb*(2*ceilf((float)N_cb/(float)(8*R_tc_sb))*rv_idx+2);
-    k   = 0;
-    j   = 0;
-    while(k < N_e_bits)
-    {
-        if(phy_struct->rut_w_dum[(k_0+j)%N_cb] != RX_NULL_BIT)
-        {
-            // Soft combine the inputs
-            if(phy_struct->rut_w[(k_0+j)%N_cb] == RX_NULL_BIT)
-            {
-                phy_struct->rut_w[(k_0+j)%N_cb] = e_bits[k];
-            }else if(e_bits[k] != RX_NULL_BIT){
-                phy_struct->rut_w[(k_0+j)%N_cb] += e_bits[k];
-            }
-            k++;
-        }
-        j++;
-    }
-
-    // Recreate the sub-block interleaver output
-    for(i=0; i<K_pi; i++)
-    {
-        phy_struct->rut_v[0][i] = phy_struct->rut_w[i];
-        phy_struct->rut_v[1][i] = phy_struct->rut_w[K_pi+2*i];
-        phy_struct->rut_v[2][i] = phy_struct->rut_w[K_pi+2*i+1];
-    }
-
-    // Sub-block deinterleaving
-    // Steps 5, 4, and 3
-    for(x=0; x<3; x++)
-    {
-        if(x != 2)
-        {
-            // Step 5: Load the permuted matrix
-            idx = 0;
-            for(j=0; j<C_tc_sb; j++)
-            {
-                for(i=0; i<R_tc_sb; i++)
-                {
-                    phy_struct->rut_sb_perm_mat[i][j] = phy_struct->rut_v[x][idx++];
-                }
-            }
-
-            // Step 4: Undo permutation
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rut_sb_mat[i][IC_PERM_TC[j]] = phy_struct->rut_sb_perm_mat[i][j];
-                }
-            }
-        }else{
-            // Step 4: Permutation for the last output
-            for(i=0; i<K_pi; i++)
-            {
-                pi_idx                    = (IC_PERM_TC[i/R_tc_sb]+C_tc_sb*(i%R_tc_sb)+1) % K_pi;
-                phy_struct->rut_y[pi_idx] = phy_struct->rut_v[x][i];
-            }
-            idx = 0;
-            for(i=0; i<R_tc_sb; i++)
-            {
-                for(j=0; j<C_tc_sb; j++)
-                {
-                    phy_struct->rut_sb_mat[i][j] = phy_struct->rut_y[idx++];
-                }
-            }
-        }
-
-        // Step 3: Unpack the data and remove dummy
-        if(N_dummy_bits < (C_tc_sb*R_tc_sb))
+    }
+    if(M_dl_harq < 8)
+    {
+        N_ir = N_soft/(K_mimo*M_dl_harq);
+    }else{
+        N_ir = N_soft/(K_mimo*8);
+    }
+    if(LIBLTE_PHY_CHAN_TYPE_DLSCH == chan_type ||
+       LIBLTE_PHY_CHAN_TYPE_PCH   == chan_type)
+    {
+        if((N_ir/N_codeblocks) < K_w)
         {
-            N_dummy = C_tc_sb*R_tc_sb - N_dummy_bits;
+            N_cb = N_ir/N_codeblocks;
         }else{
-            N_dummy = 0;
-        }
-        idx = 0;
-        for(i=0; i<R_tc_sb; i++)
-        {
-            for(j=0; j<C_tc_sb; j++)
-            {
-                phy_struct->rut_tmp[idx++] = phy_struct->rut_sb_mat[i][j];
-            }
-        }
-        d_idx = 0;
-        for(i=N_dummy; i<C_tc_sb*R_tc_sb; i++)
-        {
-            d_bits[d_idx*3+x] = phy_struct->rut_tmp[i];
-            d_idx++;
+            N_cb = K_w;
         }
+    }else{
+        N_cb = K_w;
     }
-    *N_d_bits = d_idx*3;
+
+    return(N_cb);
 }
 
 /*********************************************************************
@@ -11502,88 +16133,21 @@ void rate_match_conv(LIBLTE_PHY_STRUCT *phy_struct,
                      uint32             N_e_bits,
                      uint8             *e_bits)
 {
-    uint32 C_cc_sb = 32; // Step 1: Assign C_cc_sb to 32
-    uint32 R_cc_sb;
-    uint32 w_idx = 0;
-    uint32 d_idx;
-    uint32 N_dummy;
-    uint32 idx;
-    uint32 K_pi;
-    uint32 K_w;
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 x;
+    LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT *table;
+    uint32                              w;
+    uint32                              k;
 
-    // Sub-block interleaving
-    // Step 2: Determine the number of rows
-    R_cc_sb = 0;
-    while((N_d_bits/3) > (C_cc_sb*R_cc_sb))
-    {
-        R_cc_sb++;
-    }
-
-    // Steps 3, 4, and 5
-    for(x=0; x<3; x++)
-    {
-        // Step 3: Pack data into matrix and pad with dummy
-        if((N_d_bits/3) < (C_cc_sb*R_cc_sb))
-        {
-            N_dummy = C_cc_sb*R_cc_sb - (N_d_bits/3);
-        }else{
-            N_dummy = 0;
-        }
-        for(i=0; i<N_dummy; i++)
-        {
-            phy_struct->rmc_tmp[i] = TX_NULL_BIT;
-        }
-        d_idx = 0;
-        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
-        {
-            phy_struct->rmc_tmp[i] = d_bits[d_idx*3+x];
-            d_idx++;
-        }
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->rmc_sb_mat[i][j] = phy_struct->rmc_tmp[idx++];
-            }
-        }
-
-        // Step 4: Inter-column permutation
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->rmc_sb_perm_mat[i][j] = phy_struct->rmc_sb_mat[i][IC_PERM_CC[j]];
-            }
-        }
-
-        // Step 5: Read out the bits
-        for(j=0; j<C_cc_sb; j++)
-        {
-            for(i=0; i<R_cc_sb; i++)
-            {
-                phy_struct->rmc_w[w_idx++] = phy_struct->rmc_sb_perm_mat[i][j];
-            }
-        }
-    }
-    K_pi = R_cc_sb*C_cc_sb;
+    table = rate_match_table(phy_struct, false, N_d_bits/3, 0, 0);
 
     // Bit collection, selection, and transmission
-    // Create circular buffer
-    K_w = 3*K_pi;
-    k   = 0;
-    j   = 0;
-    while(k < N_e_bits)
+    w = 0;
+    for(k=0; k<N_e_bits; k++)
     {
-        if(phy_struct->rmc_w[j%K_w] != TX_NULL_BIT)
+        e_bits[k] = d_bits[table->d_idx[w]];
+        if(++w == table->N_w_bits)
         {
-            e_bits[k++] = phy_struct->rmc_w[j%K_w];
+            w = 0;
         }
-        j++;
     }
 }
 
@@ -11601,154 +16165,197 @@ void rate_unmatch_conv(LIBLTE_PHY_STRUCT *phy_struct,
                        float             *d_bits,
                        uint32            *N_d_bits)
 {
-    uint32 C_cc_sb = 32; // Step 1: Assign C_cc_sb to 32
-    uint32 R_cc_sb;
-    uint32 w_idx = 0;
-    uint32 d_idx;
-    uint32 N_dummy;
-    uint32 idx;
-    uint32 K_pi;
-    uint32 K_w;
-    uint32 i;
-    uint32 j;
-    uint32 k;
-    uint32 x;
+    LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT *table;
+    uint32                              i;
 
-    // In order to undo bit collection, selection, and transmission
-    // a dummy block must be sub-block interleaved to determine
-    // where NULL bits are to be inserted
-    // Sub-block interleaving
-    // Step 2: Determine the number of rows
-    R_cc_sb = 0;
-    while(N_c_bits > (C_cc_sb*R_cc_sb))
+    table = rate_match_table(phy_struct, false, N_c_bits, 0, 0);
+
+    for(i=0; i<N_c_bits*3; i++)
     {
-        R_cc_sb++;
+        d_bits[i] = RX_NULL_BIT;
     }
+    rate_unmatch_scatter(table, e_bits, N_e_bits, 0, d_bits);
+    *N_d_bits = N_c_bits*3;
+}
+
+/*********************************************************************
+    Name: rate_match_table
+
+    Description: Finds or builds the sub-block interleaved circular
+                 buffer table of a code block, replacing the least
+                 recently used table when building a new one
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.4.1 and
+                        5.1.4.2
 
-    // Steps 3, 4, and 5
-    for(x=0; x<3; x++)
+    Notes: The number of rate matched bits and the redundancy
+           version only change how much of the circular buffer is
+           read and where from, so they are not part of the key.
+           N_fill_bits and N_cb are only used for turbo codes, the
+           systematic filler bits are <NULL> like the dummy bits.
+*********************************************************************/
+LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT* rate_match_table(LIBLTE_PHY_STRUCT *phy_struct,
+                                                     bool               turbo,
+                                                     uint32             N_branch_bits,
+                                                     uint32             N_fill_bits,
+                                                     uint32             N_cb)
+{
+    LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT *table   = NULL;
+    uint32                              C_sb    = LIBLTE_PHY_N_COLUMNS_RATE_MATCH;
+    uint32                              R_sb;
+    uint32                              K_pi;
+    uint32                              N_dummy;
+    uint32                              k_0[4];
+    uint32                              m;
+    uint32                              v;
+    uint32                              x;
+    uint32                              idx;
+    uint32                              i;
+
+    phy_struct->rm_use_count++;
+    for(i=0; i<LIBLTE_PHY_RATE_MATCH_N_TABLES; i++)
     {
-        // Step 3: Pack data into matrix and pad with dummy
-        if(N_c_bits < (C_cc_sb*R_cc_sb))
+        if(phy_struct->rm_table[i].valid                         &&
+           phy_struct->rm_table[i].turbo         == turbo         &&
+           phy_struct->rm_table[i].N_branch_bits == N_branch_bits &&
+           phy_struct->rm_table[i].N_fill_bits   == N_fill_bits   &&
+           phy_struct->rm_table[i].N_cb          == N_cb)
         {
-            N_dummy = C_cc_sb*R_cc_sb - N_c_bits;
-        }else{
-            N_dummy = 0;
+            phy_struct->rm_table[i].last_use = phy_struct->rm_use_count;
+            phy_struct->rm_N_table_hits++;
+            return(&phy_struct->rm_table[i]);
         }
-        for(i=0; i<N_dummy; i++)
+        if(NULL                      == table ||
+           !phy_struct->rm_table[i].valid     ||
+           (table->valid && phy_struct->rm_table[i].last_use < table->last_use))
         {
-            phy_struct->ruc_tmp[i] = RX_NULL_BIT;
+            table = &phy_struct->rm_table[i];
         }
-        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
+    }
+    phy_struct->rm_N_table_misses++;
+
+    // Sub-block interleaver dimensions
+    R_sb    = (N_branch_bits + C_sb - 1)/C_sb;
+    K_pi    = R_sb*C_sb;
+    N_dummy = K_pi - N_branch_bits;
+    if(!turbo)
+    {
+        N_cb = 3*K_pi;
+    }
+    for(i=0; i<4; i++)
+    {
+        k_0[i] = 0;
+        if(turbo)
         {
-            phy_struct->ruc_tmp[i] = 0;
+            k_0[i] = (R_sb*(2*((N_cb + 8*R_sb - 1)/(8*R_sb))*i + 2)) % N_cb;
         }
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
+    }
+
+    // Walk the circular buffer, mapping each position through the
+    // sub-block interleavers back to the d_bits
+    table->N_w_bits = 0;
+    for(m=0; m<N_cb; m++)
+    {
+        for(i=0; i<4; i++)
         {
-            for(j=0; j<C_cc_sb; j++)
+            if(m == k_0[i])
             {
-                phy_struct->ruc_sb_mat[i][j] = phy_struct->ruc_tmp[idx++];
+                table->rv_start[i] = table->N_w_bits;
             }
         }
-
-        // Step 4: Inter-column permutation
-        for(i=0; i<R_cc_sb; i++)
+        if(turbo)
         {
-            for(j=0; j<C_cc_sb; j++)
+            // Systematic bits followed by interlaced parity bits
+            if(m < K_pi)
             {
-                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]];
+                x = 0;
+                v = m;
+            }else{
+                x = 1 + ((m - K_pi) & 1);
+                v = (m - K_pi) >> 1;
             }
-        }
-
-        // Step 5: Read out the bits
-        for(j=0; j<C_cc_sb; j++)
-        {
-            for(i=0; i<R_cc_sb; i++)
+            if(x != 2)
             {
-                phy_struct->ruc_w_dum[w_idx] = phy_struct->ruc_sb_perm_mat[i][j];
-                phy_struct->ruc_w[w_idx]     = RX_NULL_BIT;
-                w_idx++;
+                idx = (v % R_sb)*C_sb + IC_PERM_TC[v / R_sb];
+            }else{
+                idx = (IC_PERM_TC[v / R_sb] + C_sb*(v % R_sb) + 1) % K_pi;
             }
+        }else{
+            x   = m / K_pi;
+            v   = m % K_pi;
+            idx = (v % R_sb)*C_sb + IC_PERM_CC[v / R_sb];
         }
-    }
-
-    // Undo bit collection, selection, and transmission by
-    // recreating the circular buffer
-    K_pi = R_cc_sb*C_cc_sb;
-    K_w  = 3*K_pi;
-    k    = 0;
-    j    = 0;
-    while(k < N_e_bits)
-    {
-        if(phy_struct->ruc_w_dum[j%K_w] != RX_NULL_BIT)
+        if(idx >= N_dummy &&
+           !(x == 0 && (idx - N_dummy) < N_fill_bits))
         {
-            // Soft combine the inputs
-            if(phy_struct->ruc_w[j%K_w] == RX_NULL_BIT)
-            {
-                phy_struct->ruc_w[j%K_w] = e_bits[k];
-            }else if(e_bits[k] != RX_NULL_BIT){
-                phy_struct->ruc_w[j%K_w] += e_bits[k];
-            }
-            k++;
+            table->d_idx[table->N_w_bits++] = (idx - N_dummy)*3 + x;
         }
-        j++;
     }
+    table->N_branch_bits = N_branch_bits;
+    table->N_fill_bits   = N_fill_bits;
+    table->N_cb          = N_cb;
+    table->turbo         = turbo;
+    table->valid         = true;
+    table->last_use      = phy_struct->rm_use_count;
 
-    // Recreate the sub-block interleaver output
-    for(i=0; i<K_pi; i++)
-    {
-        phy_struct->ruc_v[0][i] = phy_struct->ruc_w[i];
-        phy_struct->ruc_v[1][i] = phy_struct->ruc_w[i+K_pi];
-        phy_struct->ruc_v[2][i] = phy_struct->ruc_w[i+2*K_pi];
-    }
+    return(table);
+}
 
-    // Sub-block deinterleaving
-    // Steps 5, 4, and 3
-    for(x=0; x<3; x++)
-    {
-        // Step 5: Load the permuted matrix
-        idx = 0;
-        for(j=0; j<C_cc_sb; j++)
-        {
-            for(i=0; i<R_cc_sb; i++)
-            {
-                phy_struct->ruc_sb_perm_mat[i][j] = phy_struct->ruc_v[x][idx++];
-            }
-        }
+/*********************************************************************
+    Name: rate_unmatch_scatter
 
-        // Step 4: Undo permutation
-        for(i=0; i<R_cc_sb; i++)
-        {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_sb_mat[i][IC_PERM_CC[j]] = phy_struct->ruc_sb_perm_mat[i][j];
-            }
-        }
+    Description: Soft combines e_bits into the d_bits given by a rate
+                 matching table, starting at the redundancy version
 
-        // Step 3: Unpack the data and remove dummy
-        if(N_c_bits < (C_cc_sb*R_cc_sb))
-        {
-            N_dummy = C_cc_sb*R_cc_sb - N_c_bits;
-        }else{
-            N_dummy = 0;
-        }
-        idx = 0;
-        for(i=0; i<R_cc_sb; i++)
+    Document Reference: N/A
+*********************************************************************/
+void rate_unmatch_scatter(LIBLTE_PHY_RATE_MATCH_TABLE_STRUCT *table,
+                          float                              *e_bits,
+                          uint32                              N_e_bits,
+                          uint32                              rv_idx,
+                          float                              *d_bits)
+{
+    uint32 idx;
+    uint32 w;
+    uint32 k;
+
+    w = table->rv_start[rv_idx];
+    for(k=0; k<N_e_bits; k++)
+    {
+        idx = table->d_idx[w];
+        if(RX_NULL_BIT == d_bits[idx])
         {
-            for(j=0; j<C_cc_sb; j++)
-            {
-                phy_struct->ruc_tmp[idx++] = phy_struct->ruc_sb_mat[i][j];
-            }
+            d_bits[idx] = e_bits[k];
+        }else if(RX_NULL_BIT != e_bits[k]){
+            d_bits[idx] += e_bits[k];
         }
-        d_idx = 0;
-        for(i=N_dummy; i<C_cc_sb*R_cc_sb; i++)
+        if(++w == table->N_w_bits)
         {
-            d_bits[d_idx*3+x] = phy_struct->ruc_tmp[i];
-            d_idx++;
+            w = 0;
         }
     }
-    *N_d_bits = d_idx*3;
+}
+
+/*********************************************************************
+    Name: turbo_n_fill_bits
+
+    Description: Counts the filler bits at the start of the
+                 systematic stream of turbo encoded data
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.2
+*********************************************************************/
+uint32 turbo_n_fill_bits(uint8  *d_bits,
+                         uint32  N_branch_bits)
+{
+    uint32 N_fill_bits = 0;
+
+    while(N_fill_bits < N_branch_bits &&
+          TX_NULL_BIT == d_bits[N_fill_bits])
+    {
+        N_fill_bits++;
+    }
+
+    return(N_fill_bits);
 }
 
 /*********************************************************************
@@ -11776,117 +16383,268 @@ void code_block_concatenation(uint8  *e_bits,
         j = 0;
         while(j < N_e_bits[r])
         {
-            f_bits[k++] = e_bits[r*N_e_bits_max+j];
-            j++;
+            f_bits[k++] = e_bits[r*N_e_bits_max+j];
+            j++;
+        }
+        r++;
+    }
+    *N_f_bits = k;
+}
+
+/*********************************************************************
+    Name: code_block_deconcatenation
+
+    Description: Performs code block deconcatenation for turbo coded
+                 channels, determining the number of e_bits of each
+                 code block.  The e_bits of the code blocks follow
+                 each other in the f_bits.
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.4.1.2 and
+                        5.1.5
+*********************************************************************/
+void code_block_deconcatenation(uint32  N_f_bits,
+                                uint32  tbs,
+                                uint32  N_l,
+                                uint32  Q_m,
+                                uint32 *N_e_bits,
+                                uint32 *N_codeblocks)
+{
+    uint32 Z = 6144;
+    uint32 L = 24;
+    uint32 B = tbs + 24;
+    uint32 C;
+    uint32 G_prime;
+    uint32 gamma;
+    uint32 r;
+
+    // Determine C, 3GPP TS 36.212 v10.1.0 section 5.1.2
+    if(B <= Z)
+    {
+        C = 1;
+    }else{
+        C = (B + (Z-L) - 1)/(Z-L);
+    }
+    *N_codeblocks = C;
+
+    // Determine E for each code block, 3GPP TS 36.212 v10.1.0
+    // section 5.1.4.1.2
+    G_prime = N_f_bits/(N_l*Q_m);
+    gamma   = G_prime % C;
+    for(r=0; r<C; r++)
+    {
+        if(r <= (C - gamma - 1))
+        {
+            N_e_bits[r] = N_l*Q_m*(G_prime/C);
+        }else{
+            N_e_bits[r] = N_l*Q_m*((G_prime + C - 1)/C);
+        }
+    }
+}
+
+/*********************************************************************
+    Name: decode_code_blocks
+
+    Description: Rate unmatches and turbo decodes the code blocks
+                 described by the first N_tasks entries of cbd_task,
+                 spreading them across the calling thread and the
+                 code block decoding workers, and fills in td_stats
+
+    Document Reference: 3GPP TS 36.212 v10.1.0 sections 5.1.3.2 and
+                        5.1.4.1
+*********************************************************************/
+void decode_code_blocks(LIBLTE_PHY_STRUCT *phy_struct,
+                        uint32             N_tasks)
+{
+    uint64 round;
+    uint32 N_wake = 0;
+    uint32 N_spins;
+    uint32 i;
+
+    for(i=0; i<N_tasks; i++)
+    {
+        phy_struct->cbd_task[i].done = 0;
+    }
+
+    // Only the Max-Log-MAP decoder keeps its scratch in the decode
+    // context, the others are run by the calling thread alone
+    if(LIBLTE_PHY_TURBO_DECODER_MAX_LOG_MAP == phy_struct->td_type)
+    {
+        N_wake = N_tasks - 1;
+        if(N_wake > phy_struct->cbd_N_workers)
+        {
+            N_wake = phy_struct->cbd_N_workers;
+        }
+    }
+
+    // Publish the tasks as a new round, claims of the previous round
+    // fail from here on
+    round = (phy_struct->cbd_claim >> CB_DECODE_CLAIM_RND_SHIFT) + 1;
+    __atomic_store_n(&phy_struct->cbd_claim,
+                     (round << CB_DECODE_CLAIM_RND_SHIFT) | ((uint64)N_tasks << CB_DECODE_CLAIM_N_SHIFT),
+                     __ATOMIC_RELEASE);
+    for(i=0; i<N_wake; i++)
+    {
+        sem_post(&phy_struct->cbd_worker[i].start_sem);
+    }
+    decode_code_block_tasks(phy_struct, &phy_struct->cbd_ctx);
+
+    // Wait for the code blocks claimed by the workers
+    for(i=0; i<N_tasks; i++)
+    {
+        N_spins = 0;
+        while(0 == __atomic_load_n(&phy_struct->cbd_task[i].done, __ATOMIC_ACQUIRE))
+        {
+            if(N_spins++ < CB_DECODE_N_SPINS)
+            {
+#if defined(__x86_64__) || defined(__i386__)
+                _mm_pause();
+#endif
+            }else{
+                sched_yield();
+            }
+        }
+    }
+
+    for(i=0; i<N_tasks && i<LIBLTE_PHY_MAX_N_CODE_BLOCKS; i++)
+    {
+        phy_struct->td_stats.N_iterations[i]   = phy_struct->cbd_task[i].N_iterations;
+        phy_struct->td_stats.decode_time_us[i] = phy_struct->cbd_task[i].decode_time_us;
+        phy_struct->td_stats.crc_pass[i]       = (LIBLTE_SUCCESS == phy_struct->cbd_task[i].err);
+    }
+    phy_struct->td_stats.N_codeblocks = N_tasks;
+}
+
+/*********************************************************************
+    Name: decode_code_block_tasks
+
+    Description: Claims and decodes code block tasks until none are
+                 left in the current round
+
+    Document Reference: N/A
+*********************************************************************/
+void decode_code_block_tasks(LIBLTE_PHY_STRUCT                  *phy_struct,
+                             LIBLTE_PHY_TURBO_DECODE_CTX_STRUCT *ctx)
+{
+    LIBLTE_PHY_CB_DECODE_TASK_STRUCT *task;
+    struct timespec                   time_start;
+    struct timespec                   time_end;
+    uint64                            claim;
+    uint32                            N_d_bits;
+    uint32                            i;
+
+    claim = __atomic_load_n(&phy_struct->cbd_claim, __ATOMIC_ACQUIRE);
+    while((claim & CB_DECODE_CLAIM_IDX_MASK) < ((claim >> CB_DECODE_CLAIM_N_SHIFT) & CB_DECODE_CLAIM_IDX_MASK))
+    {
+        // A failed claim reloads the claim word and tries again
+        if(!__atomic_compare_exchange_n(&phy_struct->cbd_claim,
+                                        &claim,
+                                        claim + 1,
+                                        false,
+                                        __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE))
+        {
+            continue;
         }
-        r++;
+        task = &phy_struct->cbd_task[claim & CB_DECODE_CLAIM_IDX_MASK];
+
+        // Determine d_bits
+        clock_gettime(CLOCK_MONOTONIC, &time_start);
+        N_d_bits = task->table->N_branch_bits*3;
+        for(i=0; i<N_d_bits; i++)
+        {
+            ctx->d_bits[i] = RX_NULL_BIT;
+        }
+        rate_unmatch_scatter(task->table,
+                             task->e_bits,
+                             task->N_e_bits,
+                             task->rv_idx,
+                             ctx->d_bits);
+
+        // Determine c_bits
+        task->err = turbo_decode(phy_struct,
+                                 ctx,
+                                 ctx->d_bits,
+                                 N_d_bits,
+                                 task->N_fill_bits,
+                                 task->crc,
+                                 task->c_bits,
+                                 &task->N_c_bits,
+                                 &task->N_iterations);
+        clock_gettime(CLOCK_MONOTONIC, &time_end);
+        task->decode_time_us = ((time_end.tv_sec - time_start.tv_sec)*1000000 +
+                                (time_end.tv_nsec - time_start.tv_nsec)/1000);
+        __atomic_store_n(&task->done, 1, __ATOMIC_RELEASE);
+
+        claim = __atomic_load_n(&phy_struct->cbd_claim, __ATOMIC_ACQUIRE);
     }
-    *N_f_bits = k;
 }
 
 /*********************************************************************
-    Name: code_block_deconcatenation
+    Name: decode_code_block_worker
 
-    Description: Performs code block deconcatenation for turbo coded
-                 channels
+    Description: Code block decoding worker thread, waits to be woken
+                 for each transport block
 
-    Document Reference: 3GPP TS 36.212 v10.1.0 section 5.1.5
+    Document Reference: N/A
 *********************************************************************/
-void code_block_deconcatenation(float  *f_bits,
-                                uint32  N_f_bits,
-                                uint32  tbs,
-                                float  *e_bits,
-                                uint32 *N_e_bits,
-                                uint32  N_e_bits_max,
-                                uint32 *N_codeblocks)
+void* decode_code_block_worker(void *inputs)
 {
-    uint32 Z = 6144;
-    uint32 L;
-    uint32 B;
-    uint32 C;
-    uint32 F;
-    uint32 B_prime;
-    uint32 K_plus  = 0;
-    uint32 K_minus = 0;
-    uint32 K_delta;
-    uint32 C_plus;
-    uint32 C_minus;
-    uint32 j;
-    uint32 k;
-    uint32 r;
-    int32  i;
+    LIBLTE_PHY_CB_DECODE_WORKER_STRUCT *worker     = (LIBLTE_PHY_CB_DECODE_WORKER_STRUCT *)inputs;
+    LIBLTE_PHY_STRUCT                  *phy_struct = (LIBLTE_PHY_STRUCT *)worker->phy_struct;
+    cpu_set_t                           cpus;
 
-    // Determine L, C, B', K+, C+, K-, and C-, 3GPP TS 36.212 v10.1.0 section 5.1.2
-    if(tbs <= Z)
+    if(worker->cpu >= 0)
     {
-        L       = 0;
-        C       = 1;
-        B_prime = N_f_bits;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
-        {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
-        }
-        K_minus = 0;
-        C_plus  = 1;
-        C_minus = 0;
-    }else{
-        B       = tbs + 24;
-        L       = 24;
-        C       = (uint32)ceilf((float)B/(float)(Z-L));
-        B_prime = B + C*L;
-        for(i=0; i<TURBO_INT_K_TABLE_SIZE; i++)
+        CPU_ZERO(&cpus);
+        CPU_SET(worker->cpu, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+
+    while(1)
+    {
+        if(0 != sem_wait(&worker->start_sem))
         {
-            if(C*TURBO_INT_K_TABLE[i] >= B_prime)
-            {
-                K_plus = TURBO_INT_K_TABLE[i];
-                break;
-            }
+            continue;
         }
-        for(i=TURBO_INT_K_TABLE_SIZE-1; i>=0; i--)
+        if(__atomic_load_n(&phy_struct->cbd_shutdown, __ATOMIC_ACQUIRE))
         {
-            if(TURBO_INT_K_TABLE[i] < K_plus)
-            {
-                K_minus = TURBO_INT_K_TABLE[i];
-                break;
-            }
+            break;
         }
-        K_delta = K_plus - K_minus;
-        C_minus = (C*K_plus - B_prime)/K_delta;
-        C_plus  = C - C_minus;
+        decode_code_block_tasks(phy_struct, &worker->ctx);
     }
-    F             = C_plus*K_plus + C_minus*K_minus - B_prime;
-    *N_codeblocks = C;
 
-    // Deconcatenate code blocks
-    k = 0;
-    r = 0;
-    while(r < C)
+    return(NULL);
+}
+
+/*********************************************************************
+    Name: stop_code_block_workers
+
+    Description: Stops and frees the code block decoding workers
+
+    Document Reference: N/A
+*********************************************************************/
+void stop_code_block_workers(LIBLTE_PHY_STRUCT *phy_struct)
+{
+    uint32 i;
+
+    if(NULL != phy_struct->cbd_worker)
     {
-        // Determine the K for this code block
-        if(r < C_minus)
+        __atomic_store_n(&phy_struct->cbd_shutdown, true, __ATOMIC_RELEASE);
+        for(i=0; i<phy_struct->cbd_N_workers; i++)
         {
-            N_e_bits[r] = K_minus;
-        }else{
-            N_e_bits[r] = K_plus;
-        }
-        if(C > 1)
-        {
-            N_e_bits[r] += L;
+            sem_post(&phy_struct->cbd_worker[i].start_sem);
         }
-        // FIXME: Not handling filler bits currently
-        N_e_bits[r] -= F;
-
-        j = 0;
-        while(j < N_e_bits[r])
+        for(i=0; i<phy_struct->cbd_N_workers; i++)
         {
-            e_bits[r*N_e_bits_max+j] = f_bits[k++];
-            j++;
+            pthread_join(phy_struct->cbd_worker[i].thread, NULL);
+            sem_destroy(&phy_struct->cbd_worker[i].start_sem);
         }
-        r++;
+        phy_mem_free(phy_struct->cbd_worker,
+                     phy_struct->cbd_mem_size,
+                     phy_struct->cbd_huge_pages);
+        phy_struct->cbd_worker    = NULL;
+        phy_struct->cbd_N_workers = 0;
+        phy_struct->cbd_shutdown  = false;
     }
 }
 
@@ -12316,7 +17074,7 @@ void ulsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
                                     LIBLTE_PHY_CHAN_TYPE_ULSCH,
                                     rv_idx,
                                     phy_struct->ulsch_N_e_bits[cb],
-                                    phy_struct->ulsch_tx_e_bits[0]);
+                                    phy_struct->ulsch_tx_e_bits[cb]);
     }
 
     // Determine f_bits
@@ -12371,25 +17129,27 @@ LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
                                        uint8             *out_bits,
                                        uint32            *N_out_bits)
 {
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
-    uint32             i;
-    uint32             cb;
-    uint32             ber;
-    uint32             N_b_bits;
-    uint32             N_d_bits;
-    uint32             N_f_bits;
-    uint32             N_g_bits;
-    uint32             N_ri_bits  = 0;
-    uint32             N_ack_bits = 0;
-    uint32             N_cqi_bits = 0;
-    uint32             N_fill_bits;
-    uint32             N_codeblocks;
-    uint8              calc_p_bits[24];
-    uint8             *a_bits;
-    uint8             *p_bits;
-
-    // In order to decode an ULSCH message, the NULL bit pattern must be
-    // determined by encoding a sequence of zeros
+    LIBLTE_ERROR_ENUM                 err = LIBLTE_ERROR_INVALID_CRC;
+    LIBLTE_PHY_CB_DECODE_TASK_STRUCT *task;
+    uint32                            i;
+    uint32                            cb;
+    uint32                            ber;
+    uint32                            N_b_bits;
+    uint32                            N_branch_bits;
+    uint32                            N_f_bits;
+    uint32                            N_g_bits;
+    uint32                            N_ri_bits  = 0;
+    uint32                            N_ack_bits = 0;
+    uint32                            N_cqi_bits = 0;
+    uint32                            N_fill_bits;
+    uint32                            N_codeblocks;
+    uint32                            e_offset;
+    uint8                             calc_p_bits[24];
+    uint8                            *a_bits;
+    uint8                            *p_bits;
+
+    // In order to decode an ULSCH message, the code block sizes and
+    // filler bits must be determined by segmenting a sequence of zeros
     N_b_bits = tbs+24;
     memset(phy_struct->ulsch_b_bits, 0, sizeof(uint8)*N_b_bits);
     liblte_phy_code_block_segmentation(phy_struct->ulsch_b_bits,
@@ -12424,46 +17184,42 @@ LIBLTE_ERROR_ENUM ulsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
                                       NULL);
 
     // Determine e_bits
-    code_block_deconcatenation(phy_struct->ulsch_rx_f_bits,
-                               N_f_bits,
+    code_block_deconcatenation(N_f_bits,
                                tbs,
-                               phy_struct->ulsch_rx_e_bits[0],
+                               N_l,
+                               Q_m,
                                phy_struct->ulsch_N_e_bits,
-                               18432,
                                &N_codeblocks);
 
+    // Determine c_bits, the code blocks are decoded in parallel and
+    // their e_bits follow each other in the f_bits
+    e_offset = 0;
     for(cb=0; cb<N_codeblocks; cb++)
     {
-        // Construct dummy_d_bits
-        turbo_encode(phy_struct,
-                     phy_struct->ulsch_c_bits[cb],
-                     phy_struct->ulsch_N_c_bits[cb],
-                     N_fill_bits,
-                     phy_struct->ulsch_tx_d_bits,
-                     &N_d_bits);
-
-        // Determine d_bits
-        liblte_phy_rate_unmatch_turbo(phy_struct,
-                                      phy_struct->ulsch_rx_e_bits[cb],
-                                      phy_struct->ulsch_N_e_bits[cb],
-                                      phy_struct->ulsch_tx_d_bits,
-                                      N_d_bits/3,
-                                      N_codeblocks,
-                                      tx_mode,
-                                      1,
-                                      1,
-                                      LIBLTE_PHY_CHAN_TYPE_ULSCH,
-                                      rv_idx,
-                                      phy_struct->ulsch_rx_d_bits,
-                                      &N_d_bits);
-
-        // Determine c_bits
-        turbo_decode(phy_struct,
-                     phy_struct->ulsch_rx_d_bits,
-                     N_d_bits,
-                     N_fill_bits,
-                     phy_struct->ulsch_c_bits[cb],
-                     &phy_struct->ulsch_N_c_bits[cb]);
+        N_branch_bits = phy_struct->ulsch_N_c_bits[cb] + 4;
+        task          = &phy_struct->cbd_task[cb];
+        task->table   = rate_match_table(phy_struct,
+                                         true,
+                                         N_branch_bits,
+                                         (0 == cb) ? N_fill_bits : 0,
+                                         rate_match_turbo_n_cb(N_branch_bits,
+                                                               N_codeblocks,
+                                                               tx_mode,
+                                                               1,
+                                                               1,
+                                                               LIBLTE_PHY_CHAN_TYPE_ULSCH));
+        task->e_bits      = &phy_struct->ulsch_rx_f_bits[e_offset];
+        task->N_e_bits    = phy_struct->ulsch_N_e_bits[cb];
+        task->N_fill_bits = (0 == cb) ? N_fill_bits : 0;
+        task->rv_idx      = rv_idx;
+        task->crc         = (N_codeblocks > 1) ? CRC24B : CRC24A;
+        task->c_bits      = phy_struct->ulsch_c_bits[cb];
+        e_offset         += phy_struct->ulsch_N_e_bits[cb];
+    }
+    decode_code_blocks(phy_struct, N_codeblocks);
+    for(cb=0; cb<N_codeblocks; cb++)
+    {
+        phy_struct->ulsch_N_c_bits[cb] = phy_struct->cbd_task[cb].N_c_bits;
     }
 
     // Determine b_bits
@@ -12657,7 +17413,9 @@ LIBLTE_ERROR_ENUM bch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
 /*********************************************************************
     Name: dlsch_channel_encode
 
-    Description: Channel encodes the Downlink Shared Channel
+    Description: Channel encodes the Downlink Shared Channel.  All
+                 stages operate on packed bits and the output is
+                 packed, most significant bit first.
 
     Document Reference: 3GPP TS 36.212 v10.1.0 section 5.3.2
 *********************************************************************/
@@ -12672,57 +17430,46 @@ void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
                           uint32             Q_m,
                           uint32             M_dl_harq,
                           uint32             N_soft,
-                          uint8             *out_bits,
+                          uint8             *out_bytes,
                           uint32            *N_out_bits)
 {
-    uint32  i;
-    uint32  cb;
-    uint32  N_codeblocks;
-    uint32  N_fill_bits;
-    uint32  N_d_bits;
-    uint32  G_prime;
-    uint32  lambda;
-    uint8   p_bits[24];
-    uint8  *a_bits;
-
-    // Define a_bits
-    a_bits = in_bits;
+    CRC_STATE_STRUCT  tb_crc;
+    uint32            cb;
+    uint32            N_codeblocks;
+    uint32            N_fill_bits;
+    uint32            N_d_bits;
+    uint32            G_prime;
+    uint32            lambda;
+    uint32            e_offset;
 
     // Pad input up to tbs size, calculate p_bits, and construct b_bits
-    for(i=0; i<N_in_bits; i++)
-    {
-        phy_struct->dlsch_b_bits[i] = a_bits[i];
-    }
-    for(i=N_in_bits; i<tbs; i++)
-    {
-        phy_struct->dlsch_b_bits[i] = 0;
-    }
-    calc_crc(phy_struct->dlsch_b_bits, tbs, CRC24A, p_bits, 24);
-    for(i=0; i<24; i++)
-    {
-        phy_struct->dlsch_b_bits[tbs+i] = p_bits[i];
-    }
+    memset(phy_struct->dlsch_b_bytes, 0, (tbs+7)/8);
+    liblte_phy_pack_bits(in_bits, N_in_bits, phy_struct->dlsch_b_bytes);
+    crc_init(&tb_crc, CRC24A, 24);
+    crc_update_packed_bits(&tb_crc, phy_struct->dlsch_b_bytes, tbs);
+    bit_write(phy_struct->dlsch_b_bytes, tbs, crc_value(&tb_crc), 24);
 
     // Construct c_bits
-    liblte_phy_code_block_segmentation(phy_struct->dlsch_b_bits,
-                                       tbs+24,
-                                       &N_codeblocks,
-                                       &N_fill_bits,
-                                       phy_struct->dlsch_c_bits[0],
-                                       LIBLTE_PHY_MAX_CODE_BLOCK_SIZE,
-                                       phy_struct->dlsch_N_c_bits);
-
+    liblte_phy_code_block_segmentation_packed(phy_struct->dlsch_b_bytes,
+                                              tbs+24,
+                                              &N_codeblocks,
+                                              &N_fill_bits,
+                                              phy_struct->dlsch_c_bytes[0],
+                                              LIBLTE_PHY_MAX_CODE_BLOCK_SIZE/8,
+                                              phy_struct->dlsch_N_c_bits);
+
+    e_offset = 0;
     for(cb=0; cb<N_codeblocks; cb++)
     {
         // Construct d_bits
-        turbo_encode(phy_struct,
-                     phy_struct->dlsch_c_bits[cb],
-                     phy_struct->dlsch_N_c_bits[cb],
-                     N_fill_bits,
-                     phy_struct->dlsch_tx_d_bits,
-                     &N_d_bits);
-
-        // Determine e_bits and N_e_bits
+        turbo_encode_packed(phy_struct,
+                            phy_struct->dlsch_c_bytes[cb],
+                            phy_struct->dlsch_N_c_bits[cb],
+                            phy_struct->dlsch_tx_d_bytes,
+                            &N_d_bits);
+
+        // Determine e_bits and N_e_bits, concatenating code blocks
+        // directly in the output
         G_prime = G/(N_l*Q_m);
         lambda  = G_prime % N_codeblocks;
         if(cb <= (N_codeblocks - lambda - 1))
@@ -12731,25 +17478,22 @@ void dlsch_channel_encode(LIBLTE_PHY_STRUCT *phy_struct,
         }else{
             phy_struct->dlsch_N_e_bits[cb] = N_l*Q_m*(uint32)ceilf((float)G_prime/(float)N_codeblocks);
         }
-        liblte_phy_rate_match_turbo(phy_struct,
-                                    phy_struct->dlsch_tx_d_bits,
-                                    N_d_bits,
-                                    N_codeblocks,
-                                    tx_mode,
-                                    N_soft,
-                                    M_dl_harq,
-                                    LIBLTE_PHY_CHAN_TYPE_DLSCH,
-                                    rv_idx,
-                                    phy_struct->dlsch_N_e_bits[cb],
-                                    phy_struct->dlsch_tx_e_bits[0]);
-    }
-
-    code_block_concatenation(phy_struct->dlsch_tx_e_bits[0],
-                             phy_struct->dlsch_N_e_bits,
-                             18432,
-                             N_codeblocks,
-                             out_bits,
-                             N_out_bits);
+        liblte_phy_rate_match_turbo_packed(phy_struct,
+                                           phy_struct->dlsch_tx_d_bytes,
+                                           N_d_bits,
+                                           (0 == cb) ? N_fill_bits : 0,
+                                           N_codeblocks,
+                                           tx_mode,
+                                           N_soft,
+                                           M_dl_harq,
+                                           LIBLTE_PHY_CHAN_TYPE_DLSCH,
+                                           rv_idx,
+                                           phy_struct->dlsch_N_e_bits[cb],
+                                           out_bytes,
+                                           e_offset);
+        e_offset += phy_struct->dlsch_N_e_bits[cb];
+    }
+    *N_out_bits = e_offset;
 }
 
 /*********************************************************************
@@ -12765,25 +17509,29 @@ LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
                                        uint32             tbs,
                                        uint32             tx_mode,
                                        uint32             rv_idx,
+                                       uint32             N_l,
+                                       uint32             Q_m,
                                        uint32             M_dl_harq,
                                        uint32             N_soft,
                                        uint8             *out_bits,
                                        uint32            *N_out_bits)
 {
-    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
-    uint32             i;
-    uint32             cb;
-    uint32             ber;
-    uint32             N_b_bits;
-    uint32             N_d_bits;
-    uint32             N_fill_bits;
-    uint32             N_codeblocks;
-    uint8              calc_p_bits[24];
-    uint8             *a_bits;
-    uint8             *p_bits;
-
-    // In order to decode a DLSCH message, the NULL bit pattern must be
-    // determined by encoding a sequence of zeros
+    LIBLTE_ERROR_ENUM                 err = LIBLTE_ERROR_INVALID_CRC;
+    LIBLTE_PHY_CB_DECODE_TASK_STRUCT *task;
+    uint32                            i;
+    uint32                            cb;
+    uint32                            ber;
+    uint32                            N_b_bits;
+    uint32                            N_branch_bits;
+    uint32                            N_fill_bits;
+    uint32                            N_codeblocks;
+    uint32                            e_offset;
+    uint8                             calc_p_bits[24];
+    uint8                            *a_bits;
+    uint8                            *p_bits;
+
+    // In order to decode a DLSCH message, the code block sizes and
+    // filler bits must be determined by segmenting a sequence of zeros
     N_b_bits = tbs+24;
     memset(phy_struct->dlsch_b_bits, 0, sizeof(uint8)*N_b_bits);
     liblte_phy_code_block_segmentation(phy_struct->dlsch_b_bits,
@@ -12795,46 +17543,42 @@ LIBLTE_ERROR_ENUM dlsch_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
                                        phy_struct->dlsch_N_c_bits);
 
     // Determine e_bits
-    code_block_deconcatenation(in_bits,
-                               N_in_bits,
+    code_block_deconcatenation(N_in_bits,
                                tbs,
-                               phy_struct->dlsch_rx_e_bits[0],
+                               N_l,
+                               Q_m,
                                phy_struct->dlsch_N_e_bits,
-                               18432,
                                &N_codeblocks);
 
+    // Determine c_bits, the code blocks are decoded in parallel and
+    // their e_bits follow each other in the f_bits
+    e_offset = 0;
     for(cb=0; cb<N_codeblocks; cb++)
     {
-        // Construct dummy_d_bits
-        turbo_encode(phy_struct,
-                     phy_struct->dlsch_c_bits[cb],
-                     phy_struct->dlsch_N_c_bits[cb],
-                     N_fill_bits,
-                     phy_struct->dlsch_tx_d_bits,
-                     &N_d_bits);
-
-        // Determine d_bits
-        liblte_phy_rate_unmatch_turbo(phy_struct,
-                                      phy_struct->dlsch_rx_e_bits[cb],
-                                      phy_struct->dlsch_N_e_bits[cb],
-                                      phy_struct->dlsch_tx_d_bits,
-                                      N_d_bits/3,
-                                      N_codeblocks,
-                                      tx_mode,
-                                      N_soft,
-                                      M_dl_harq,
-                                      LIBLTE_PHY_CHAN_TYPE_DLSCH,
-                                      rv_idx,
-                                      phy_struct->dlsch_rx_d_bits,
-                                      &N_d_bits);
-
-        // Determine c_bits
-        turbo_decode(phy_struct,
-                     phy_struct->dlsch_rx_d_bits,
-                     N_d_bits,
-                     N_fill_bits,
-                     phy_struct->dlsch_c_bits[cb],
-                     &phy_struct->dlsch_N_c_bits[cb]);
+        N_branch_bits = phy_struct->dlsch_N_c_bits[cb] + 4;
+        task          = &phy_struct->cbd_task[cb];
+        task->table   = rate_match_table(phy_struct,
+                                         true,
+                                         N_branch_bits,
+                                         (0 == cb) ? N_fill_bits : 0,
+                                         rate_match_turbo_n_cb(N_branch_bits,
+                                                               N_codeblocks,
+                                                               tx_mode,
+                                                               N_soft,
+                                                               M_dl_harq,
+                                                               LIBLTE_PHY_CHAN_TYPE_DLSCH));
+        task->e_bits      = &in_bits[e_offset];
+        task->N_e_bits    = phy_struct->dlsch_N_e_bits[cb];
+        task->N_fill_bits = (0 == cb) ? N_fill_bits : 0;
+        task->rv_idx      = rv_idx;
+        task->crc         = (N_codeblocks > 1) ? CRC24B : CRC24A;
+        task->c_bits      = phy_struct->dlsch_c_bits[cb];
+        e_offset         += phy_struct->dlsch_N_e_bits[cb];
+    }
+    decode_code_blocks(phy_struct, N_codeblocks);
+    for(cb=0; cb<N_codeblocks; cb++)
+    {
+        phy_struct->dlsch_N_c_bits[cb] = phy_struct->cbd_task[cb].N_c_bits;
     }
 
     // Determine b_bits
@@ -12960,24 +17704,21 @@ LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
                                      uint16            *rnti_found)
 {
     LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_CRC;
+    CRC_STATE_STRUCT   crc;
     uint32             i;
-    uint32             j;
     uint32             N_d_bits;
     uint32             N_c_bits;
-    uint32             ber;
     uint32             g[3] = {0133, 0171, 0165}; // Numbers are in octal
     uint16             rnti;
-    uint8              x_rnti_bits[16];
-    uint8              x_as_bits[16];
+    uint16             x_p;
+    uint16             x_as = 0;
     uint8             *a_bits;
     uint8             *p_bits;
-    uint8              calc_p_bits[16];
 
     // Construct UE antenna mask
-    memset(x_as_bits, 0, sizeof(uint8)*16);
     if(ue_ant == 1)
     {
-        x_as_bits[15] = 1;
+        x_as = 1;
     }
 
     // Rate unmatch to get the d_bits
@@ -13001,38 +17742,27 @@ LIBLTE_ERROR_ENUM dci_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
     // Recover a_bits and p_bits
     a_bits = &phy_struct->dci_c_bits[0];
     p_bits = &phy_struct->dci_c_bits[N_out_bits];
+    x_p    = 0;
+    for(i=0; i<16; i++)
+    {
+        x_p = (x_p << 1) | p_bits[i];
+    }
 
-    // Calculate p_bits
-    calc_crc(a_bits, N_out_bits, CRC16, calc_p_bits, 16);
+    // The received p_bits are the calculated p_bits scrambled with
+    // the RNTI and antenna mask, so the RNTI can be recovered directly
+    crc_init(&crc, CRC16, 16);
+    crc_update_bits(&crc, a_bits, N_out_bits);
+    rnti = (uint16)crc_value(&crc) ^ x_p ^ x_as;
 
-    for(j=0; j<rnti_range; j++)
+    // Check RNTI
+    if((uint16)(rnti - rnti_start) < rnti_range)
     {
-        // Convert RNTI to bit array
-        for(i=0; i<16; i++)
-        {
-            rnti           = rnti_start + j;
-            x_rnti_bits[i] = (rnti >> (15-i)) & 1;
-        }
-
-        // Check CRC
-        ber = 0;
-        for(i=0; i<16; i++)
-        {
-            ber += p_bits[i] ^ (calc_p_bits[i] ^ x_rnti_bits[i] ^ x_as_bits[i]);
-        }
-        if(ber == 0)
-        {
-            for(i=0; i<N_out_bits; i++)
-            {
-                out_bits[i] = a_bits[i];
-            }
-            err = LIBLTE_SUCCESS;
-        }
-        if(LIBLTE_SUCCESS == err)
+        for(i=0; i<N_out_bits; i++)
         {
-            *rnti_found = rnti;
-            break;
+            out_bits[i] = a_bits[i];
         }
+        *rnti_found = rnti;
+        err         = LIBLTE_SUCCESS;
     }
 
     return(err);
@@ -13267,8 +17997,7 @@ void dci_1a_pack(LIBLTE_PHY_ALLOCATION_STRUCT    *alloc,
                         3GPP TS 36.213 v10.3.0 section 7.1.6.3
                         3GPP TS 36.213 v10.3.0 section 7.1.7
 
-    Notes: Currently only handles SI-RNTI, P-RNTI, or RA-RNTI and
-           localized virtual resource blocks
+    Notes: Currently only handles localized virtual resource blocks
 *********************************************************************/
 LIBLTE_ERROR_ENUM dci_1a_unpack(uint8                           *in_bits,
                                 uint32                           N_in_bits,
@@ -13367,7 +18096,65 @@ LIBLTE_ERROR_ENUM dci_1a_unpack(uint8                           *in_bits,
         }
         alloc->rnti = rnti;
     }else{
-        printf("ERROR: Not handling DCI 1As for C-RNTI\n");
+        // Determine if RIV uses local or distributed VRBs
+        loc_or_dist = liblte_bits_2_value(&dci, 1);
+
+        // Find the RIV that was sent 3GPP TS 36.213 v10.3.0 section 7.1.6.3
+        RIV_length   = (uint32)ceilf(logf(N_rb_dl*(N_rb_dl+1)/2)/logf(2));
+        RIV          = liblte_bits_2_value(&dci, RIV_length);
+        alloc->N_prb = RIV/N_rb_dl + 1;
+        RB_start     = RIV % N_rb_dl;
+        if((alloc->N_prb + RB_start) > N_rb_dl)
+        {
+            alloc->N_prb = N_rb_dl - alloc->N_prb + 2;
+            RB_start     = N_rb_dl - 1 - RB_start;
+        }
+
+        // Extract the rest of the fields
+        alloc->mcs    = liblte_bits_2_value(&dci, 5);
+        harq_process  = liblte_bits_2_value(&dci, 3);
+        alloc->ndi    = liblte_bits_2_value(&dci, 1);
+        alloc->rv_idx = liblte_bits_2_value(&dci, 2);
+        alloc->tpc    = liblte_bits_2_value(&dci, 2);
+
+        // Parse the data
+        if(DCI_VRB_TYPE_DISTRIBUTED == loc_or_dist)
+        {
+            // FIXME: Figure out gapping
+            // FIXME: Convert to localized blocks
+        }else{
+            // Convert allocation into array of prbs
+            for(i=0; i<alloc->N_prb; i++)
+            {
+                alloc->prb[0][i] = RB_start + i;
+                alloc->prb[1][i] = RB_start + i;
+            }
+        }
+
+        // Fill in the allocation structure 3GPP TS 36.213 v10.3.0 section 7.1.7
+        if(10 > alloc->mcs)
+        {
+            alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+        }else if(17 > alloc->mcs){
+            alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_16QAM;
+        }else{
+            alloc->mod_type = LIBLTE_PHY_MODULATION_TYPE_64QAM;
+        }
+        alloc->pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+        if(N_ant == 1)
+        {
+            alloc->tx_mode = 1;
+        }else{
+            alloc->tx_mode = 2;
+        }
+        alloc->N_codewords = 1;
+        if(27 > alloc->mcs)
+        {
+            alloc->tbs = TBS_71721[alloc->mcs][alloc->N_prb-1];
+        }else{
+            err = LIBLTE_ERROR_INVALID_CONTENTS;
+        }
+        alloc->rnti = rnti;
     }
 
     return(err);
@@ -13711,7 +18498,9 @@ LIBLTE_ERROR_ENUM cfi_channel_decode(LIBLTE_PHY_STRUCT *phy_struct,
     Name: get_ulsch_ce
 
     Description: Resolves channel estimates for the uplink shared
-                 channel
+                 channel and the noise variance of the equalized
+                 symbols.  The noise is estimated from the difference
+                 between adjacent subcarrier DMRS estimates.
 
     Document Reference: N/A
 *********************************************************************/
@@ -13723,7 +18512,8 @@ void get_ulsch_ce(LIBLTE_PHY_STRUCT *phy_struct,
                   uint32             N_prb,
                   uint32             N_subfr,
                   float             *c_est_re,
-                  float             *c_est_im)
+                  float             *c_est_im,
+                  float             *noise_var)
 {
     float  *dmrs_0_re;
     float  *dmrs_0_im;
@@ -13739,6 +18529,10 @@ void get_ulsch_ce(LIBLTE_PHY_STRUCT *phy_struct,
     float   frac_ang;
     float   ce_mag[12];
     float   ce_ang[12];
+    float   prev_re[2] = {0, 0};
+    float   prev_im[2] = {0, 0};
+    float   noise_sum  = 0;
+    float   inv_h_sum  = 0;
     uint32  i;
     uint32  L;
     uint32  M_pusch_sc = N_prb * phy_struct->N_sc_rb_ul;
@@ -13754,10 +18548,25 @@ void get_ulsch_ce(LIBLTE_PHY_STRUCT *phy_struct,
         tmp_im = c_est_0_im[i]*dmrs_0_re[i] - c_est_0_re[i]*dmrs_0_im[i];
         mag_0  = sqrt(tmp_re*tmp_re + tmp_im*tmp_im);
         ang_0  = atan2f(tmp_im, tmp_re);
+        if(i > 0)
+        {
+            noise_sum += ((tmp_re - prev_re[0])*(tmp_re - prev_re[0]) +
+                          (tmp_im - prev_im[0])*(tmp_im - prev_im[0]));
+        }
+        prev_re[0] = tmp_re;
+        prev_im[0] = tmp_im;
         tmp_re = c_est_1_re[i]*dmrs_1_re[i] + c_est_1_im[i]*dmrs_1_im[i];
         tmp_im = c_est_1_im[i]*dmrs_1_re[i] - c_est_1_re[i]*dmrs_1_im[i];
         mag_1  = sqrt(tmp_re*tmp_re + tmp_im*tmp_im);
         ang_1  = atan2f(tmp_im, tmp_re);
+        if(i > 0)
+        {
+            noise_sum += ((tmp_re - prev_re[1])*(tmp_re - prev_re[1]) +
+                          (tmp_im - prev_im[1])*(tmp_im - prev_im[1]));
+        }
+        prev_re[1] = tmp_re;
+        prev_im[1] = tmp_im;
+        inv_h_sum += 1/(mag_0*mag_0 + LLR_MIN_NOISE_VAR) + 1/(mag_1*mag_1 + LLR_MIN_NOISE_VAR);
 
         frac_mag = (mag_1 - mag_0)/7;
         frac_ang = (ang_1 - ang_0);
@@ -13786,6 +18595,15 @@ void get_ulsch_ce(LIBLTE_PHY_STRUCT *phy_struct,
             c_est_im[L*M_pusch_sc + i] = ce_mag[L]*sin(ce_ang[L]);
         }
     }
+
+    // Each difference holds twice the per subcarrier noise variance,
+    // which zero forcing scales by the average 1/|h|^2
+    if(M_pusch_sc > 1)
+    {
+        *noise_var = (noise_sum/(4*(M_pusch_sc-1))) * (inv_h_sum/(2*M_pusch_sc));
+    }else{
+        *noise_var = LLR_DEFAULT_NOISE_VAR;
+    }
 }
 
 /*********************************************************************
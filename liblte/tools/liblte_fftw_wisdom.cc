@@ -0,0 +1,80 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_fftw_wisdom.cc
+
+    Description: Plans the FFTs used by the LTE Physical Layer library for
+                 every sample rate and bandwidth and saves the FFTW wisdom,
+                 so that applications using the same wisdom file start
+                 without planning.  Run by "make fftw_wisdom" or at install
+                 time when PLAN_FFTW_WISDOM is enabled.
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_phy.h"
+#include <stdio.h>
+#include <time.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    time_t start;
+
+    if(argc != 2)
+    {
+        printf("Usage: %s <wisdom file>\n", argv[0]);
+        return(1);
+    }
+
+    if(LIBLTE_SUCCESS != liblte_phy_set_fftw_wisdom_file(argv[1]) ||
+       '\0'           == argv[1][0])
+    {
+        printf("Invalid wisdom file name %s\n", argv[1]);
+        return(1);
+    }
+
+    printf("Planning FFTs for all bandwidths, this can take several minutes\n");
+    start = time(NULL);
+    liblte_phy_plan_all_fftw_wisdom();
+    printf("Saved FFTW wisdom for %s in %u seconds\n", argv[1], (uint32)(time(NULL) - start));
+
+    return(0);
+}
@@ -41,6 +41,8 @@
                               DEFINES
 *******************************************************************************/
 
+// Samples between re-seeds of the freq_shift rotators
+#define LIBTOOLS_FREQ_SHIFT_RENORM_SAMPS 1024
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -97,4 +99,18 @@ void get_formatted_time(std::string &time_string);
 *********************************************************************/
 bool is_string_valid_as_number(std::string str, uint32 num_digits, uint8 base);
 
+/*********************************************************************
+    Name: freq_shift
+
+    Description: Multiplies samples in place by exp(j*phase), stepping
+                 phase by phase_inc radians per sample.  phase is left
+                 at the phase of the sample following the last one, so
+                 consecutive calls are phase continuous.
+*********************************************************************/
+void freq_shift(float  *i_samps,
+                float  *q_samps,
+                uint32  num_samps,
+                double  phase_inc,
+                double *phase);
+
 #endif /* __LIBTOOLS_HELPERS_H__ */
@@ -89,12 +89,18 @@ typedef struct{
     uint32 tti;
 }LIBTOOLS_IPC_MSGQ_UL_ALLOC_MSG_STRUCT;
 
+// With LIBLTE_PHY_INTERLEAVED_IQ the samples are kept in the layout
+// the radios use, so they can be handed over without conversion
 typedef struct{
-    float  i_buf[4][LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ];
-    float  q_buf[4][LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ];
-    uint32 N_samps_per_ant;
-    uint16 current_tti;
-    uint8  N_ant;
+#ifdef LIBLTE_PHY_INTERLEAVED_IQ
+    LIBLTE_PHY_CF_STRUCT samps[4][LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ];
+#else
+    float                i_buf[4][LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ];
+    float                q_buf[4][LIBLTE_PHY_N_SAMPS_PER_SUBFR_30_72MHZ];
+#endif
+    uint32               N_samps_per_ant;
+    uint16               current_tti;
+    uint8                N_ant;
 }LIBTOOLS_IPC_MSGQ_PHY_SAMPS_MSG_STRUCT;
 
 typedef union{
@@ -35,6 +35,10 @@
 #include <iomanip>
 #include <sstream>
 #include <sys/time.h>
+#include <math.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 /*******************************************************************************
                               DEFINES
@@ -51,6 +55,16 @@
 *******************************************************************************/
 
 
+/*******************************************************************************
+                              LOCAL FUNCTION PROTOTYPES
+*******************************************************************************/
+
+static void freq_shift_scalar(float *i_samps, float *q_samps, uint32 num_samps, float *r_re, float *r_im, float s_re, float s_im);
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx")))
+static void freq_shift_avx(float *i_samps, float *q_samps, uint32 num_samps, float *r_re, float *r_im, float s_re, float s_im);
+#endif
+
 /*******************************************************************************
                               FUNCTIONS
 *******************************************************************************/
@@ -302,3 +316,160 @@ bool is_string_valid_as_number(std::string str,
     return(valid);
 }
 
+
+/*********************************************************************
+    Name: freq_shift
+
+    Description: Multiplies samples in place by exp(j*phase), stepping
+                 phase by phase_inc radians per sample.  phase is left
+                 at the phase of the sample following the last one, so
+                 consecutive calls are phase continuous.
+
+                 Eight recursive rotators, one per lane, each step
+                 8*phase_inc per group of 8 samples.  The rotators are
+                 re-seeded from the double precision phase every
+                 LIBTOOLS_FREQ_SHIFT_RENORM_SAMPS samples, which bounds
+                 the amplitude and phase drift of the float recursion.
+*********************************************************************/
+void freq_shift(float  *i_samps,
+                float  *q_samps,
+                uint32  num_samps,
+                double  phase_inc,
+                double *phase)
+{
+    static int  use_avx = -1;
+    double      cur_phase = *phase;
+    float       r_re[8];
+    float       r_im[8];
+    float       s_re = cos(8*phase_inc);
+    float       s_im = sin(8*phase_inc);
+    uint32      i;
+    uint32      j;
+    uint32      N_blk;
+
+    if(-1 == use_avx)
+    {
+        use_avx = 0;
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx"))
+        {
+            use_avx = 1;
+        }
+#endif
+    }
+
+    for(i=0; i<num_samps; i+=LIBTOOLS_FREQ_SHIFT_RENORM_SAMPS)
+    {
+        N_blk = num_samps - i;
+        if(N_blk > LIBTOOLS_FREQ_SHIFT_RENORM_SAMPS)
+        {
+            N_blk = LIBTOOLS_FREQ_SHIFT_RENORM_SAMPS;
+        }
+        for(j=0; j<8; j++)
+        {
+            r_re[j] = cos(cur_phase + j*phase_inc);
+            r_im[j] = sin(cur_phase + j*phase_inc);
+        }
+#if defined(__x86_64__) || defined(__i386__)
+        if(1 == use_avx)
+        {
+            freq_shift_avx(&i_samps[i], &q_samps[i], N_blk, r_re, r_im, s_re, s_im);
+        }else{
+            freq_shift_scalar(&i_samps[i], &q_samps[i], N_blk, r_re, r_im, s_re, s_im);
+        }
+#else
+        freq_shift_scalar(&i_samps[i], &q_samps[i], N_blk, r_re, r_im, s_re, s_im);
+#endif
+        cur_phase = fmod(cur_phase + N_blk*phase_inc, 2*M_PI);
+    }
+
+    *phase = cur_phase;
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: freq_shift_scalar
+
+    Description: Rotates num_samps samples with the lane rotators
+                 r_re/r_im, advancing them by s_re/s_im per group of
+                 8 samples.
+*********************************************************************/
+static void freq_shift_scalar(float  *i_samps,
+                              float  *q_samps,
+                              uint32  num_samps,
+                              float  *r_re,
+                              float  *r_im,
+                              float   s_re,
+                              float   s_im)
+{
+    float  tmp_re;
+    float  tmp_im;
+    uint32 i;
+    uint32 j;
+
+    for(i=0; i+8<=num_samps; i+=8)
+    {
+        for(j=0; j<8; j++)
+        {
+            tmp_re       = i_samps[i+j];
+            tmp_im       = q_samps[i+j];
+            i_samps[i+j] = tmp_re*r_re[j] - tmp_im*r_im[j];
+            q_samps[i+j] = tmp_re*r_im[j] + tmp_im*r_re[j];
+            tmp_re       = r_re[j];
+            r_re[j]      = tmp_re*s_re - r_im[j]*s_im;
+            r_im[j]      = tmp_re*s_im + r_im[j]*s_re;
+        }
+    }
+    for(j=0; i<num_samps; i++, j++)
+    {
+        tmp_re     = i_samps[i];
+        tmp_im     = q_samps[i];
+        i_samps[i] = tmp_re*r_re[j] - tmp_im*r_im[j];
+        q_samps[i] = tmp_re*r_im[j] + tmp_im*r_re[j];
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/*********************************************************************
+    Name: freq_shift_avx
+
+    Description: AVX version of freq_shift_scalar, one rotator per
+                 lane.
+*********************************************************************/
+__attribute__((target("avx")))
+static void freq_shift_avx(float  *i_samps,
+                           float  *q_samps,
+                           uint32  num_samps,
+                           float  *r_re,
+                           float  *r_im,
+                           float   s_re,
+                           float   s_im)
+{
+    __m256 rr = _mm256_loadu_ps(r_re);
+    __m256 ri = _mm256_loadu_ps(r_im);
+    __m256 sr = _mm256_set1_ps(s_re);
+    __m256 si = _mm256_set1_ps(s_im);
+    __m256 xr;
+    __m256 xi;
+    __m256 tmp;
+    uint32 i;
+
+    for(i=0; i+8<=num_samps; i+=8)
+    {
+        xr  = _mm256_loadu_ps(&i_samps[i]);
+        xi  = _mm256_loadu_ps(&q_samps[i]);
+        _mm256_storeu_ps(&i_samps[i], _mm256_sub_ps(_mm256_mul_ps(xr, rr), _mm256_mul_ps(xi, ri)));
+        _mm256_storeu_ps(&q_samps[i], _mm256_add_ps(_mm256_mul_ps(xr, ri), _mm256_mul_ps(xi, rr)));
+        tmp = _mm256_sub_ps(_mm256_mul_ps(rr, sr), _mm256_mul_ps(ri, si));
+        ri  = _mm256_add_ps(_mm256_mul_ps(rr, si), _mm256_mul_ps(ri, sr));
+        rr  = tmp;
+    }
+    _mm256_storeu_ps(r_re, rr);
+    _mm256_storeu_ps(r_im, ri);
+    freq_shift_scalar(&i_samps[i], &q_samps[i], num_samps - i, r_re, r_im, s_re, s_im);
+}
+#endif
@@ -16,81 +16,71 @@
 %
 % Function:    lte_modulation_demapper
 % Description: Maps complex-valued modulation symbols to
-%              binary digits
-% Inputs:      symbs    - Complex-valued modulation symbols
-%              mod_type - Modulation type (bpsk, qpsk, 16qam,
-%                         or 64qam)
-% Outputs:     bits     - Binary digits
+%              max-log LLR soft bits, positive for a 0 bit,
+%              quantized the same way as liblte
+% Inputs:      symbs     - Complex-valued modulation symbols
+%              mod_type  - Modulation type (bpsk, qpsk, 16qam,
+%                          or 64qam)
+%              noise_var - Optional noise variance of the
+%                          symbols, defaults to 0.125
+% Outputs:     bits      - Soft bits, LLRs scaled by 8 and
+%                          saturated at +/-127
 % Spec:        3GPP TS 36.211 section 7.1 v10.1.0
 % Notes:       None
 % Rev History: Ben Wojtowicz 10/28/2011 Created
 %              Ben Wojtowicz 01/29/2012 Fixed license statement
 %              Ben Wojtowicz 02/19/2012 Added newline to EOF
 %
-function [bits] = lte_modulation_demapper(symbs, mod_type)
+function [bits] = lte_modulation_demapper(symbs, mod_type, noise_var)
+
+    if(nargin < 3)
+        noise_var = 0.125;
+    endif
+    noise_var = max(noise_var, 0.0001);
 
     N_symbs = length(symbs);
+    y_re    = real(symbs(:).');
+    y_im    = imag(symbs(:).');
 
     if(mod_type == "bpsk")
         % 36.211 Section 7.1.1 v10.1.0
-        for(n=0:N_symbs-1)
-            ang = angle(symbs(n+1));
-            if(ang > -pi/4 && ang < 3*pi/4)
-                act_symb  = +1/sqrt(2) + j/sqrt(2);
-                sd        = get_soft_decision(symbs(n+1), act_symb, 1);
-                bits(n+1) = +sd;
-            else
-                act_symb  = -1/sqrt(2) - j/sqrt(2);
-                sd        = get_soft_decision(symbs(n+1), act_symb, 1);
-                bits(n+1) = -sd;
+        s    = 1/sqrt(2);
+        bits = quantize_llr(8*4*s/noise_var*(y_re + y_im));
+    elseif(mod_type == "qpsk" || mod_type == "16qam" || mod_type == "64qam")
+        if(mod_type == "qpsk")
+            % 36.211 Section 7.1.2 v10.1.0
+            Q_m = 2;
+            s   = 1/sqrt(2);
+            T   = [];
+        elseif(mod_type == "16qam")
+            % 36.211 Section 7.1.3 v10.1.0
+            Q_m = 4;
+            s   = 1/sqrt(10);
+            T   = [2*s];
+        else
+            % 36.211 Section 7.1.4 v10.1.0
+            Q_m = 6;
+            s   = 1/sqrt(42);
+            T   = [4*s, 2*s];
+        endif
+        gain = 8*4*s/noise_var;
+        bits = zeros(1, N_symbs*Q_m);
+        f_re = y_re;
+        f_im = y_im;
+        for(k=0:(Q_m/2)-1)
+            if(k > 0)
+                f_re = T(k) - abs(f_re);
+                f_im = T(k) - abs(f_im);
             endif
+            bits(2*k+1:Q_m:end) = quantize_llr(gain*f_re);
+            bits(2*k+2:Q_m:end) = quantize_llr(gain*f_im);
         endfor
-    elseif(mod_type == "qpsk")
-        % 36.211 Section 7.1.2 v10.1.0
-        for(n=0:N_symbs-1)
-            ang = angle(symbs(n+1));
-            if(ang >= 0 && ang < pi/2)
-                act_symb      = +1/sqrt(2) + j/sqrt(2);
-                sd            = get_soft_decision(symbs(n+1), act_symb, 1);
-                bits(n*2+0+1) = +sd;
-                bits(n*2+1+1) = +sd;
-            elseif(ang >= -pi/2 && ang < 0)
-                act_symb      = +1/sqrt(2) - j/sqrt(2);
-                sd            = get_soft_decision(symbs(n+1), act_symb, 1);
-                bits(n*2+0+1) = +sd;
-                bits(n*2+1+1) = -sd;
-            elseif(ang >= pi/2 && ang < pi)
-                act_symb      = -1/sqrt(2) + j/sqrt(2);
-                sd            = get_soft_decision(symbs(n+1), act_symb, 1);
-                bits(n*2+0+1) = -sd;
-                bits(n*2+1+1) = +sd;
-            else
-                act_symb      = -1/sqrt(2) - j/sqrt(2);
-                sd            = get_soft_decision(symbs(n+1), act_symb, 1);
-                bits(n*2+0+1) = -sd;
-                bits(n*2+1+1) = -sd;
-            endif
-        endfor
-    elseif(mod_type == "16qam")
-        % 36.211 Section 7.1.3 v10.1.0
-        printf("ERROR: Not supporting 16qam at this time\n");
-        bits = 0;
-    elseif(mod_type == "64qam")
-        % 36.211 Section 7.1.4 v10.1.0
-        printf("ERROR: Not supporting 64qam at this time\n");
-        bits = 0;
     else
         printf("ERROR: Invalid mod_type (%s)\n", mod_type);
         bits = 0;
     endif
 endfunction
 
-function [sd] = get_soft_decision(p1, p2, max_dist)
-    dist = sqrt((real(p1)-real(p2))^2 + (imag(p1)-imag(p2))^2);
-
-    if(dist >= max_dist)
-        dist = max_dist - (max_dist/1000);
-    endif
-
-    sd = max_dist - dist;
+function [llr] = quantize_llr(llr)
+    llr = round(min(max(llr, -127), 127));
 endfunction